@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/StdLibExtras.h>
+#include <AK/Types.h>
+#include <AK/kmalloc.h>
+
+namespace AK {
+
+// A simple arena allocator. Allocations bump a pointer within large chunks
+// and cannot be freed individually; all chunks are released at once by
+// free_all() (or the destructor). Callers are responsible for running the
+// destructors of anything they placement-new into the arena.
+class BumpAllocator {
+public:
+    explicit BumpAllocator(size_t chunk_size = 64 * KiB)
+        : m_chunk_size(chunk_size)
+    {
+    }
+
+    ~BumpAllocator()
+    {
+        free_all();
+    }
+
+    BumpAllocator(const BumpAllocator&) = delete;
+    BumpAllocator& operator=(const BumpAllocator&) = delete;
+
+    void* allocate(size_t size, size_t alignment = alignof(FlatPtr))
+    {
+        u8* aligned = align_up(m_current, alignment);
+        if (!m_current || aligned + size > m_end) {
+            // Overly large allocations get their own dedicated chunk.
+            size_t chunk_size = max(m_chunk_size, sizeof(ChunkHeader) + size + alignment);
+            auto* chunk = (ChunkHeader*)kmalloc(chunk_size);
+            chunk->next = m_chunk_list;
+            m_chunk_list = chunk;
+            m_current = (u8*)chunk + sizeof(ChunkHeader);
+            m_end = (u8*)chunk + chunk_size;
+            aligned = align_up(m_current, alignment);
+        }
+        m_current = aligned + size;
+        return aligned;
+    }
+
+    template<typename T, typename... Args>
+    T* allocate(Args&&... args)
+    {
+        return new (allocate(sizeof(T), alignof(T))) T(forward<Args>(args)...);
+    }
+
+    void free_all()
+    {
+        for (auto* chunk = m_chunk_list; chunk;) {
+            auto* next = chunk->next;
+            kfree(chunk);
+            chunk = next;
+        }
+        m_chunk_list = nullptr;
+        m_current = nullptr;
+        m_end = nullptr;
+    }
+
+private:
+    struct ChunkHeader {
+        ChunkHeader* next;
+    };
+
+    static u8* align_up(u8* pointer, size_t alignment)
+    {
+        return (u8*)(((FlatPtr)pointer + alignment - 1) & ~(FlatPtr)(alignment - 1));
+    }
+
+    ChunkHeader* m_chunk_list { nullptr };
+    u8* m_current { nullptr };
+    u8* m_end { nullptr };
+    size_t m_chunk_size { 0 };
+};
+
+}
+
+using AK::BumpAllocator;
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Assertions.h>
+#include <AK/EnumBits.h>
+#include <AK/Types.h>
+#include <AK/Vector.h>
+
+namespace AK {
+
+// The features a userland program may want to branch on when picking a SIMD
+// kernel. This is intentionally separate from the kernel's CPUFeature enum in
+// Kernel/Arch/x86/CPU.h, which mostly tracks paging and syscall concerns;
+// kernel code is compiled with -mno-sse and must keep using
+// Processor::has_feature() instead of dispatching to SIMD paths.
+enum class CPUFeature : u32 {
+    None = 0,
+    SSE = 1 << 0,
+    SSE2 = 1 << 1,
+    SSE3 = 1 << 2,
+    SSSE3 = 1 << 3,
+    SSE4_1 = 1 << 4,
+    SSE4_2 = 1 << 5,
+    AVX = 1 << 6,
+    AVX2 = 1 << 7,
+    RDRAND = 1 << 8,
+};
+
+AK_ENUM_BITWISE_OPERATORS(CPUFeature)
+
+#if defined(__i386__) || defined(__x86_64__)
+
+namespace Detail {
+
+struct CPUIDResult {
+    u32 eax { 0 };
+    u32 ebx { 0 };
+    u32 ecx { 0 };
+    u32 edx { 0 };
+};
+
+inline CPUIDResult cpuid(u32 function, u32 sub_function = 0)
+{
+    CPUIDResult result;
+    asm volatile("cpuid"
+                 : "=a"(result.eax), "=b"(result.ebx), "=c"(result.ecx), "=d"(result.edx)
+                 : "a"(function), "c"(sub_function));
+    return result;
+}
+
+inline u64 xgetbv0()
+{
+    u32 eax = 0;
+    u32 edx = 0;
+    asm volatile("xgetbv"
+                 : "=a"(eax), "=d"(edx)
+                 : "c"(0));
+    return ((u64)edx << 32) | eax;
+}
+
+}
+
+inline CPUFeature detect_cpu_features()
+{
+    auto features = CPUFeature::None;
+
+    if (Detail::cpuid(0).eax < 1)
+        return features;
+
+    auto leaf1 = Detail::cpuid(1);
+    if (leaf1.edx & (1 << 25))
+        features |= CPUFeature::SSE;
+    if (leaf1.edx & (1 << 26))
+        features |= CPUFeature::SSE2;
+    if (leaf1.ecx & (1 << 0))
+        features |= CPUFeature::SSE3;
+    if (leaf1.ecx & (1 << 9))
+        features |= CPUFeature::SSSE3;
+    if (leaf1.ecx & (1 << 19))
+        features |= CPUFeature::SSE4_1;
+    if (leaf1.ecx & (1 << 20))
+        features |= CPUFeature::SSE4_2;
+    if (leaf1.ecx & (1 << 30))
+        features |= CPUFeature::RDRAND;
+
+    // AVX needs more than the CPUID bit: the kernel must have enabled XSAVE
+    // (CPUID reflects that through OSXSAVE) and opted the XMM and YMM state
+    // into XCR0, otherwise the upper register halves are not preserved
+    // across context switches.
+    bool osxsave = leaf1.ecx & (1 << 27);
+    if (osxsave && (Detail::xgetbv0() & 0x6) == 0x6) {
+        if (leaf1.ecx & (1 << 28))
+            features |= CPUFeature::AVX;
+        if (Detail::cpuid(0).eax >= 7 && (Detail::cpuid(7).ebx & (1 << 5)))
+            features |= CPUFeature::AVX2;
+    }
+
+    return features;
+}
+
+#else
+
+inline CPUFeature detect_cpu_features()
+{
+    return CPUFeature::None;
+}
+
+#endif
+
+class CPUFeatures {
+public:
+    static CPUFeature all()
+    {
+        static CPUFeature cached_features = detect_cpu_features();
+        return cached_features;
+    }
+
+    static bool has(CPUFeature features)
+    {
+        return (all() & features) == features;
+    }
+};
+
+// Picks between implementations of a function based on the CPU we are
+// running on. Candidates are listed best-first; the first one whose required
+// features are all present wins. Selection happens on the first call and is
+// cached in a plain function pointer, so later calls are a load and an
+// indirect call.
+//
+//     static void fill_avx2(u32*, size_t);
+//     static void fill_sse2(u32*, size_t);
+//     static void fill_scalar(u32*, size_t);
+//
+//     static MultiVersionFunction<void(u32*, size_t)> fill {
+//         { CPUFeature::AVX2, fill_avx2 },
+//         { CPUFeature::SSE2, fill_sse2 },
+//         { CPUFeature::None, fill_scalar },
+//     };
+//
+// Always list a CPUFeature::None fallback last, or selection will assert on
+// machines that support none of the candidates.
+template<typename Prototype>
+class MultiVersionFunction;
+
+template<typename ReturnType, typename... Args>
+class MultiVersionFunction<ReturnType(Args...)> {
+public:
+    struct Candidate {
+        CPUFeature required_features;
+        ReturnType (*implementation)(Args...);
+    };
+
+    MultiVersionFunction(std::initializer_list<Candidate> candidates)
+        : m_candidates(candidates)
+    {
+    }
+
+    ALWAYS_INLINE ReturnType operator()(Args... args)
+    {
+        if (m_selected == nullptr)
+            select();
+        return m_selected(args...);
+    }
+
+private:
+    void select()
+    {
+        for (auto& candidate : m_candidates) {
+            if (CPUFeatures::has(candidate.required_features)) {
+                m_selected = candidate.implementation;
+                return;
+            }
+        }
+        VERIFY_NOT_REACHED();
+    }
+
+    Vector<Candidate, 4> m_candidates;
+    ReturnType (*m_selected)(Args...) { nullptr };
+};
+
+}
+
+using AK::CPUFeature;
+using AK::CPUFeatures;
+using AK::detect_cpu_features;
+using AK::MultiVersionFunction;
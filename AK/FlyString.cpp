@@ -144,7 +144,7 @@ bool FlyString::operator==(const String& other) const
 
 bool FlyString::operator==(const StringView& string) const
 {
-    return *this == String(string);
+    return view() == string;
 }
 
 bool FlyString::operator==(const char* string) const
@@ -92,16 +92,15 @@ StringView FormatParser::consume_literal()
     const auto begin = tell();
 
     while (!is_eof()) {
-        if (consume_specific("{{"))
-            continue;
-
-        if (consume_specific("}}"))
-            continue;
-
-        if (next_is(is_any_of("{}")))
+        auto ch = peek();
+        if (ch == '{' || ch == '}') {
+            if (peek(1) == ch) {
+                ignore(2);
+                continue;
+            }
             return m_input.substring_view(begin, tell() - begin);
-
-        consume();
+        }
+        ignore();
     }
 
     return m_input.substring_view(begin);
@@ -175,15 +174,28 @@ bool FormatParser::consume_replacement_field(size_t& index)
 
 void FormatBuilder::put_padding(char fill, size_t amount)
 {
-    for (size_t i = 0; i < amount; ++i)
-        m_builder.append(fill);
+    char buffer[32];
+    __builtin_memset(buffer, fill, min(amount, sizeof(buffer)));
+    while (amount > 0) {
+        const auto chunk = min(amount, sizeof(buffer));
+        m_builder.append(StringView { buffer, chunk });
+        amount -= chunk;
+    }
 }
 void FormatBuilder::put_literal(StringView value)
 {
-    for (size_t i = 0; i < value.length(); ++i) {
-        m_builder.append(value[i]);
-        if (value[i] == '{' || value[i] == '}')
+    // Braces only appear in literals as escaped '{{' or '}}', so everything
+    // between them can be appended in bulk.
+    size_t i = 0;
+    while (i < value.length()) {
+        const auto run_start = i;
+        while (i < value.length() && value[i] != '{' && value[i] != '}')
             ++i;
+        m_builder.append(value.substring_view(run_start, i - run_start));
+        if (i < value.length()) {
+            m_builder.append(value[i]);
+            i += 2;
+        }
     }
 }
 void FormatBuilder::put_string(
@@ -280,8 +292,7 @@ void FormatBuilder::put_u64(
         }
     };
     const auto put_digits = [&]() {
-        for (size_t i = 0; i < used_by_digits; ++i)
-            m_builder.append(buffer[i]);
+        m_builder.append(StringView { reinterpret_cast<const char*>(buffer.data()), used_by_digits });
     };
 
     if (align == Align::Left) {
@@ -72,10 +72,10 @@ class CircularQueue;
 template<typename T>
 struct Traits;
 
-template<typename T, typename = Traits<T>>
+template<typename T, typename = Traits<T>, bool IsOrdered = false>
 class HashTable;
 
-template<typename K, typename V, typename = Traits<K>>
+template<typename K, typename V, typename = Traits<K>, bool IsOrdered = false>
 class HashMap;
 
 template<typename T>
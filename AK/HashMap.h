@@ -19,7 +19,7 @@
 
 namespace AK {
 
-template<typename K, typename V, typename KeyTraits>
+template<typename K, typename V, typename KeyTraits, bool IsOrdered>
 class HashMap {
 private:
     struct Entry {
@@ -68,7 +68,7 @@ public:
     }
     void remove_one_randomly() { m_table.remove(m_table.begin()); }
 
-    using HashTableType = HashTable<Entry, EntryTraits>;
+    using HashTableType = HashTable<Entry, EntryTraits, IsOrdered>;
     using IteratorType = typename HashTableType::Iterator;
     using ConstIteratorType = typename HashTableType::ConstIterator;
 
@@ -153,6 +153,10 @@ private:
     HashTableType m_table;
 };
 
+template<typename K, typename V, typename KeyTraits = Traits<K>>
+using OrderedHashMap = HashMap<K, V, KeyTraits, true>;
+
 }
 
 using AK::HashMap;
+using AK::OrderedHashMap;
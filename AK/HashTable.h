@@ -13,6 +13,9 @@
 
 namespace AK {
 
+template<typename T>
+struct Traits;
+
 enum class HashSetResult {
     InsertedNewEntry,
     ReplacedExistingEntry
@@ -51,7 +54,28 @@ private:
     BucketType* m_bucket { nullptr };
 };
 
-template<typename T, typename TraitsForT>
+template<typename OrderedHashTableType, typename T, typename BucketType>
+class OrderedHashTableIterator {
+    friend OrderedHashTableType;
+
+public:
+    bool operator==(const OrderedHashTableIterator& other) const { return m_bucket == other.m_bucket; }
+    bool operator!=(const OrderedHashTableIterator& other) const { return m_bucket != other.m_bucket; }
+    T& operator*() { return *m_bucket->slot(); }
+    T* operator->() { return m_bucket->slot(); }
+    void operator++() { m_bucket = m_bucket->next; }
+    void operator--() { m_bucket = m_bucket->previous; }
+
+private:
+    explicit OrderedHashTableIterator(BucketType* bucket)
+        : m_bucket(bucket)
+    {
+    }
+
+    BucketType* m_bucket { nullptr };
+};
+
+template<typename T, typename TraitsForT, bool IsOrdered>
 class HashTable {
     static constexpr size_t load_factor_in_percent = 60;
 
@@ -65,6 +89,30 @@ class HashTable {
         const T* slot() const { return reinterpret_cast<const T*>(storage); }
     };
 
+    struct OrderedBucket {
+        OrderedBucket* previous;
+        OrderedBucket* next;
+        bool used;
+        bool deleted;
+        bool end;
+        alignas(T) u8 storage[sizeof(T)];
+
+        T* slot() { return reinterpret_cast<T*>(storage); }
+        const T* slot() const { return reinterpret_cast<const T*>(storage); }
+    };
+
+    using BucketType = Conditional<IsOrdered, OrderedBucket, Bucket>;
+
+    struct CollectionData {
+    };
+
+    struct OrderedCollectionData {
+        BucketType* head { nullptr };
+        BucketType* tail { nullptr };
+    };
+
+    using CollectionDataType = Conditional<IsOrdered, OrderedCollectionData, CollectionData>;
+
 public:
     HashTable() = default;
     explicit HashTable(size_t capacity) { rehash(capacity); }
@@ -98,6 +146,7 @@ public:
 
     HashTable(HashTable&& other) noexcept
         : m_buckets(other.m_buckets)
+        , m_collection_data(other.m_collection_data)
         , m_size(other.m_size)
         , m_capacity(other.m_capacity)
         , m_deleted_count(other.m_deleted_count)
@@ -106,6 +155,8 @@ public:
         other.m_capacity = 0;
         other.m_deleted_count = 0;
         other.m_buckets = nullptr;
+        if constexpr (IsOrdered)
+            other.m_collection_data = { nullptr, nullptr };
     }
 
     HashTable& operator=(HashTable&& other) noexcept
@@ -117,6 +168,7 @@ public:
     friend void swap(HashTable& a, HashTable& b) noexcept
     {
         swap(a.m_buckets, b.m_buckets);
+        swap(a.m_collection_data, b.m_collection_data);
         swap(a.m_size, b.m_size);
         swap(a.m_capacity, b.m_capacity);
         swap(a.m_deleted_count, b.m_deleted_count);
@@ -145,10 +197,15 @@ public:
         return find(value) != end();
     }
 
-    using Iterator = HashTableIterator<HashTable, T, Bucket>;
+    using Iterator = Conditional<IsOrdered,
+        OrderedHashTableIterator<HashTable, T, BucketType>,
+        HashTableIterator<HashTable, T, BucketType>>;
 
     Iterator begin()
     {
+        if constexpr (IsOrdered)
+            return Iterator(m_collection_data.head);
+
         for (size_t i = 0; i < m_capacity; ++i) {
             if (m_buckets[i].used)
                 return Iterator(&m_buckets[i]);
@@ -161,10 +218,15 @@ public:
         return Iterator(nullptr);
     }
 
-    using ConstIterator = HashTableIterator<const HashTable, const T, const Bucket>;
+    using ConstIterator = Conditional<IsOrdered,
+        OrderedHashTableIterator<const HashTable, const T, const BucketType>,
+        HashTableIterator<const HashTable, const T, const BucketType>>;
 
     ConstIterator begin() const
     {
+        if constexpr (IsOrdered)
+            return ConstIterator(m_collection_data.head);
+
         for (size_t i = 0; i < m_capacity; ++i) {
             if (m_buckets[i].used)
                 return ConstIterator(&m_buckets[i]);
@@ -197,6 +259,10 @@ public:
             bucket.deleted = false;
             --m_deleted_count;
         }
+
+        if constexpr (IsOrdered)
+            append_bucket_to_collection(bucket);
+
         ++m_size;
         return HashSetResult::InsertedNewEntry;
     }
@@ -240,6 +306,20 @@ public:
         VERIFY(bucket.used);
         VERIFY(!bucket.end);
         VERIFY(!bucket.deleted);
+
+        if constexpr (IsOrdered) {
+            if (bucket.previous)
+                bucket.previous->next = bucket.next;
+            else
+                m_collection_data.head = bucket.next;
+            if (bucket.next)
+                bucket.next->previous = bucket.previous;
+            else
+                m_collection_data.tail = bucket.previous;
+            bucket.previous = nullptr;
+            bucket.next = nullptr;
+        }
+
         bucket.slot()->~T();
         bucket.used = false;
         bucket.deleted = true;
@@ -253,31 +333,61 @@ private:
         auto& bucket = lookup_for_writing(value);
         new (bucket.slot()) T(move(value));
         bucket.used = true;
+        if constexpr (IsOrdered)
+            append_bucket_to_collection(bucket);
+    }
+
+    void append_bucket_to_collection(BucketType& bucket)
+    {
+        if (!m_collection_data.head) {
+            m_collection_data.head = &bucket;
+        } else {
+            bucket.previous = m_collection_data.tail;
+            m_collection_data.tail->next = &bucket;
+        }
+        m_collection_data.tail = &bucket;
     }
 
     void rehash(size_t new_capacity)
     {
-        new_capacity = max(new_capacity, static_cast<size_t>(4));
-        new_capacity = kmalloc_good_size(new_capacity * sizeof(Bucket)) / sizeof(Bucket);
+        // Round the capacity up to a power of two so that probing can use
+        // masking instead of an integer division per probe.
+        size_t rounded_capacity = 4;
+        while (rounded_capacity < new_capacity)
+            rounded_capacity *= 2;
+        new_capacity = rounded_capacity;
 
         auto* old_buckets = m_buckets;
         auto old_capacity = m_capacity;
+        auto old_collection_data = m_collection_data;
 
-        m_buckets = (Bucket*)kmalloc(sizeof(Bucket) * (new_capacity + 1));
-        __builtin_memset(m_buckets, 0, sizeof(Bucket) * (new_capacity + 1));
+        m_buckets = (BucketType*)kmalloc(sizeof(BucketType) * (new_capacity + 1));
+        __builtin_memset(m_buckets, 0, sizeof(BucketType) * (new_capacity + 1));
         m_capacity = new_capacity;
         m_deleted_count = 0;
+        m_collection_data = {};
 
         m_buckets[m_capacity].end = true;
 
         if (!old_buckets)
             return;
 
-        for (size_t i = 0; i < old_capacity; ++i) {
-            auto& old_bucket = old_buckets[i];
-            if (old_bucket.used) {
-                insert_during_rehash(move(*old_bucket.slot()));
-                old_bucket.slot()->~T();
+        if constexpr (IsOrdered) {
+            // Reinsert by walking the insertion-order list so the new table
+            // preserves the old iteration order.
+            for (auto* bucket = old_collection_data.head; bucket;) {
+                auto* next_bucket = bucket->next;
+                insert_during_rehash(move(*bucket->slot()));
+                bucket->slot()->~T();
+                bucket = next_bucket;
+            }
+        } else {
+            for (size_t i = 0; i < old_capacity; ++i) {
+                auto& old_bucket = old_buckets[i];
+                if (old_bucket.used) {
+                    insert_during_rehash(move(*old_bucket.slot()));
+                    old_bucket.slot()->~T();
+                }
             }
         }
 
@@ -285,13 +395,13 @@ private:
     }
 
     template<typename Finder>
-    Bucket* lookup_with_hash(unsigned hash, Finder finder) const
+    BucketType* lookup_with_hash(unsigned hash, Finder finder) const
     {
         if (is_empty())
             return nullptr;
 
         for (;;) {
-            auto& bucket = m_buckets[hash % m_capacity];
+            auto& bucket = m_buckets[hash & (m_capacity - 1)];
 
             if (bucket.used && finder(*bucket.slot()))
                 return &bucket;
@@ -303,20 +413,27 @@ private:
         }
     }
 
-    const Bucket* lookup_for_reading(const T& value) const
+    const BucketType* lookup_for_reading(const T& value) const
     {
         return lookup_with_hash(TraitsForT::hash(value), [&value](auto& entry) { return TraitsForT::equals(entry, value); });
     }
 
-    Bucket& lookup_for_writing(const T& value)
+    BucketType& lookup_for_writing(const T& value)
     {
-        if (should_grow())
-            rehash(capacity() * 2);
+        if (should_grow()) {
+            // If at least half of the used buckets are tombstones, a rehash
+            // at the same capacity flushes them out without growing the
+            // table; churn-heavy tables would otherwise keep doubling.
+            if (m_deleted_count >= m_size)
+                rehash(capacity());
+            else
+                rehash(capacity() * 2);
+        }
 
         auto hash = TraitsForT::hash(value);
-        Bucket* first_empty_bucket = nullptr;
+        BucketType* first_empty_bucket = nullptr;
         for (;;) {
-            auto& bucket = m_buckets[hash % m_capacity];
+            auto& bucket = m_buckets[hash & (m_capacity - 1)];
 
             if (bucket.used && TraitsForT::equals(*bucket.slot(), value))
                 return bucket;
@@ -326,7 +443,7 @@ private:
                     first_empty_bucket = &bucket;
 
                 if (!bucket.deleted)
-                    return *const_cast<Bucket*>(first_empty_bucket);
+                    return *const_cast<BucketType*>(first_empty_bucket);
             }
 
             hash = double_hash(hash);
@@ -336,12 +453,17 @@ private:
     [[nodiscard]] size_t used_bucket_count() const { return m_size + m_deleted_count; }
     [[nodiscard]] bool should_grow() const { return ((used_bucket_count() + 1) * 100) >= (m_capacity * load_factor_in_percent); }
 
-    Bucket* m_buckets { nullptr };
+    BucketType* m_buckets { nullptr };
+    CollectionDataType m_collection_data;
     size_t m_size { 0 };
     size_t m_capacity { 0 };
     size_t m_deleted_count { 0 };
 };
 
+template<typename T, typename TraitsForT = Traits<T>>
+using OrderedHashTable = HashTable<T, TraitsForT, true>;
+
 }
 
 using AK::HashTable;
+using AK::OrderedHashTable;
@@ -20,32 +20,26 @@ public:
     ~JsonObject() = default;
 
     JsonObject(const JsonObject& other)
-        : m_order(other.m_order)
-        , m_members(other.m_members)
+        : m_members(other.m_members)
     {
     }
 
     JsonObject(JsonObject&& other)
-        : m_order(move(other.m_order))
-        , m_members(move(other.m_members))
+        : m_members(move(other.m_members))
     {
     }
 
     JsonObject& operator=(const JsonObject& other)
     {
-        if (this != &other) {
+        if (this != &other)
             m_members = other.m_members;
-            m_order = other.m_order;
-        }
         return *this;
     }
 
     JsonObject& operator=(JsonObject&& other)
     {
-        if (this != &other) {
+        if (this != &other)
             m_members = move(other.m_members);
-            m_order = move(other.m_order);
-        }
         return *this;
     }
 
@@ -79,27 +73,19 @@ public:
 
     void set(const String& key, JsonValue value)
     {
-        if (m_members.set(key, move(value)) == HashSetResult::ReplacedExistingEntry)
-            m_order.remove(m_order.find_first_index(key).value());
-        m_order.append(key);
+        m_members.set(key, move(value));
     }
 
     template<typename Callback>
     void for_each_member(Callback callback) const
     {
-        for (size_t i = 0; i < m_order.size(); ++i) {
-            auto property = m_order[i];
-            callback(property, m_members.get(property).value());
-        }
+        for (auto& member : m_members)
+            callback(member.key, member.value);
     }
 
     bool remove(const String& key)
     {
-        if (m_members.remove(key)) {
-            m_order.remove(m_order.find_first_index(key).value());
-            return true;
-        }
-        return false;
+        return m_members.remove(key);
     }
 
     template<typename Builder>
@@ -111,8 +97,7 @@ public:
     String to_string() const { return serialized<StringBuilder>(); }
 
 private:
-    Vector<String> m_order;
-    HashMap<String, JsonValue> m_members;
+    OrderedHashMap<String, JsonValue> m_members;
 };
 
 template<typename Builder>
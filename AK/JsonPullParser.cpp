@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonPullParser.h>
+#include <AK/StringBuilder.h>
+#include <AK/StringUtils.h>
+#include <ctype.h>
+
+namespace AK {
+
+JsonPullParser::Event JsonPullParser::error()
+{
+    m_failed = true;
+    return Event::Error;
+}
+
+JsonPullParser::Event JsonPullParser::next()
+{
+    if (m_failed)
+        return Event::Error;
+
+    ignore_while(isspace);
+
+    if (m_stack.is_empty()) {
+        if (m_seen_top_level_value)
+            return is_eof() ? Event::Eof : error();
+        m_seen_top_level_value = true;
+        return value_event();
+    }
+
+    auto& level = m_stack.last();
+
+    if (level.awaiting_value) {
+        level.awaiting_value = false;
+        return value_event();
+    }
+
+    if (level.is_object) {
+        if (peek() == '}') {
+            ignore();
+            m_stack.take_last();
+            return Event::ObjectEnd;
+        }
+        if (level.has_elements) {
+            if (!consume_specific(','))
+                return error();
+            ignore_while(isspace);
+            if (peek() == '}')
+                return error();
+        }
+        if (!consume_string_token())
+            return error();
+        ignore_while(isspace);
+        if (!consume_specific(':'))
+            return error();
+        level.has_elements = true;
+        level.awaiting_value = true;
+        return Event::Key;
+    }
+
+    if (peek() == ']') {
+        ignore();
+        m_stack.take_last();
+        return Event::ArrayEnd;
+    }
+    if (level.has_elements) {
+        if (!consume_specific(','))
+            return error();
+        ignore_while(isspace);
+        if (peek() == ']')
+            return error();
+    }
+    level.has_elements = true;
+    return value_event();
+}
+
+JsonPullParser::Event JsonPullParser::value_event()
+{
+    switch (peek()) {
+    case '{':
+        ignore();
+        m_stack.append({ .is_object = true });
+        return Event::ObjectStart;
+    case '[':
+        ignore();
+        m_stack.append({ .is_object = false });
+        return Event::ArrayStart;
+    case '"':
+        if (!consume_string_token())
+            return error();
+        return Event::String;
+    case 't':
+        if (!consume_specific("true"))
+            return error();
+        return Event::True;
+    case 'f':
+        if (!consume_specific("false"))
+            return error();
+        return Event::False;
+    case 'n':
+        if (!consume_specific("null"))
+            return error();
+        return Event::Null;
+    case '-':
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9': {
+        const auto begin = tell();
+        if (peek() == '-')
+            ignore();
+        bool saw_digit = false;
+        while (!is_eof()) {
+            auto ch = peek();
+            if (ch >= '0' && ch <= '9') {
+                saw_digit = true;
+                ignore();
+                continue;
+            }
+            if (ch == '.' || ch == 'e' || ch == 'E' || ch == '+' || ch == '-') {
+                ignore();
+                continue;
+            }
+            break;
+        }
+        if (!saw_digit)
+            return error();
+        m_token = m_input.substring_view(begin, tell() - begin);
+        return Event::Number;
+    }
+    default:
+        return error();
+    }
+}
+
+bool JsonPullParser::consume_string_token()
+{
+    if (!consume_specific('"'))
+        return false;
+
+    const auto begin = tell();
+    m_token_has_escapes = false;
+
+    while (!is_eof()) {
+        auto ch = peek();
+        if (ch == '"') {
+            m_token = m_input.substring_view(begin, tell() - begin);
+            ignore();
+            return true;
+        }
+        if (ch == '\\') {
+            m_token_has_escapes = true;
+            ignore();
+            if (is_eof())
+                return false;
+        }
+        ignore();
+    }
+    return false;
+}
+
+String JsonPullParser::decode_token() const
+{
+    if (!m_token_has_escapes)
+        return m_token;
+
+    StringBuilder builder { m_token.length() };
+    for (size_t i = 0; i < m_token.length(); ++i) {
+        auto ch = m_token[i];
+        if (ch != '\\') {
+            builder.append(ch);
+            continue;
+        }
+        auto escaped_ch = m_token[++i];
+        switch (escaped_ch) {
+        case 'n':
+            builder.append('\n');
+            break;
+        case 'r':
+            builder.append('\r');
+            break;
+        case 't':
+            builder.append('\t');
+            break;
+        case 'b':
+            builder.append('\b');
+            break;
+        case 'f':
+            builder.append('\f');
+            break;
+        case 'u': {
+            if (i + 4 >= m_token.length()) {
+                builder.append('?');
+                i = m_token.length();
+                break;
+            }
+            auto code_point = StringUtils::convert_to_uint_from_hex(m_token.substring_view(i + 1, 4));
+            if (code_point.has_value())
+                builder.append_code_point(code_point.value());
+            else
+                builder.append('?');
+            i += 4;
+        } break;
+        default:
+            builder.append(escaped_ch);
+            break;
+        }
+    }
+    return builder.to_string();
+}
+
+Optional<i64> JsonPullParser::token_as_integer() const
+{
+    return m_token.to_int<i64>();
+}
+
+#ifndef KERNEL
+Optional<double> JsonPullParser::token_as_double() const
+{
+    auto token = m_token;
+    bool is_negative = false;
+    if (token.starts_with('-')) {
+        is_negative = true;
+        token = token.substring_view(1);
+    }
+
+    auto mantissa = token;
+    i64 exponent = 0;
+    if (auto exponent_index = token.find_first_of("eE"); exponent_index.has_value()) {
+        mantissa = token.substring_view(0, exponent_index.value());
+        auto exponent_string = token.substring_view(exponent_index.value() + 1);
+        if (exponent_string.starts_with('+'))
+            exponent_string = exponent_string.substring_view(1);
+        auto parsed_exponent = exponent_string.to_int<i64>();
+        if (!parsed_exponent.has_value())
+            return {};
+        exponent = parsed_exponent.value();
+    }
+
+    auto whole_string = mantissa;
+    StringView fraction_string;
+    if (auto dot_index = mantissa.find_first_of('.'); dot_index.has_value()) {
+        whole_string = mantissa.substring_view(0, dot_index.value());
+        fraction_string = mantissa.substring_view(dot_index.value() + 1);
+    }
+
+    auto whole = whole_string.to_uint<u64>();
+    if (!whole.has_value())
+        return {};
+
+    double value = static_cast<double>(whole.value());
+    if (!fraction_string.is_empty()) {
+        auto fraction = fraction_string.to_uint<u64>();
+        if (!fraction.has_value())
+            return {};
+        double divider = 1;
+        for (size_t i = 0; i < fraction_string.length(); ++i)
+            divider *= 10;
+        value += static_cast<double>(fraction.value()) / divider;
+    }
+
+    for (i64 i = 0; i < exponent; ++i)
+        value *= 10;
+    for (i64 i = 0; i > exponent; --i)
+        value /= 10;
+
+    return is_negative ? -value : value;
+}
+#endif
+
+bool JsonPullParser::skip_value()
+{
+    size_t depth = 0;
+    do {
+        switch (next()) {
+        case Event::ObjectStart:
+        case Event::ArrayStart:
+            ++depth;
+            break;
+        case Event::ObjectEnd:
+        case Event::ArrayEnd:
+            --depth;
+            break;
+        case Event::Eof:
+        case Event::Error:
+            return false;
+        default:
+            break;
+        }
+    } while (depth > 0);
+    return true;
+}
+
+}
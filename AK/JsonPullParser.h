@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/GenericLexer.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+
+namespace AK {
+
+// A pull-style JSON parser that hands out one event at a time with StringView
+// tokens pointing into the source buffer, so walking a document allocates
+// nothing beyond the nesting stack. Use this instead of JsonParser when you
+// only need to visit the document once and don't want to materialize a
+// JsonValue DOM for it.
+//
+//     JsonPullParser parser { input };
+//     if (parser.next() != JsonPullParser::Event::ObjectStart)
+//         return;
+//     while (parser.next() == JsonPullParser::Event::Key) {
+//         if (parser.token() == "name")
+//             ...
+//         else
+//             parser.skip_value();
+//     }
+class JsonPullParser : private GenericLexer {
+public:
+    enum class Event {
+        ObjectStart,
+        ObjectEnd,
+        ArrayStart,
+        ArrayEnd,
+        Key,
+        String,
+        Number,
+        True,
+        False,
+        Null,
+        Eof,
+        Error,
+    };
+
+    explicit JsonPullParser(StringView input)
+        : GenericLexer(input)
+    {
+    }
+
+    Event next();
+
+    // Valid after a Key or String event (the raw characters between the
+    // quotes) and after a Number event (the number's characters).
+    StringView token() const { return m_token; }
+
+    // Key and String tokens alias the source buffer, so escape sequences in
+    // them are still encoded; decode_token() resolves them. When
+    // token_has_escapes() is false the token can be used as-is.
+    bool token_has_escapes() const { return m_token_has_escapes; }
+    String decode_token() const;
+
+    Optional<i64> token_as_integer() const;
+#ifndef KERNEL
+    Optional<double> token_as_double() const;
+#endif
+
+    // Consumes the value following a Key event (including whole nested
+    // containers) without reporting events for it. Returns false if the
+    // skipped value is malformed.
+    bool skip_value();
+
+private:
+    Event value_event();
+    Event error();
+    bool consume_string_token();
+
+    struct Level {
+        bool is_object { false };
+        bool has_elements { false };
+        bool awaiting_value { false };
+    };
+
+    Vector<Level, 16> m_stack;
+    StringView m_token;
+    bool m_token_has_escapes { false };
+    bool m_seen_top_level_value { false };
+    bool m_failed { false };
+};
+
+}
+
+using AK::JsonPullParser;
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Noncopyable.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Types.h>
+
+namespace AK {
+
+// A fixed-capacity lock-free queue safe for any number of producer and
+// consumer threads (Dmitry Vyukov's bounded MPMC design). Every slot carries
+// a sequence number: a producer may fill a slot whose sequence equals its
+// ticket, a consumer may empty one whose sequence is one past its ticket,
+// and publishing bumps the sequence so the slot becomes visible to the other
+// side. Threads claim tickets with a single compare-exchange on the shared
+// head or tail, so contention is one CAS per operation rather than a lock.
+template<typename T, size_t Capacity>
+class MPMCQueue {
+    AK_MAKE_NONCOPYABLE(MPMCQueue);
+    AK_MAKE_NONMOVABLE(MPMCQueue);
+
+    static_assert(Capacity >= 2 && !(Capacity & (Capacity - 1)), "Capacity must be a power of two");
+
+public:
+    MPMCQueue()
+    {
+        for (size_t i = 0; i < Capacity; ++i)
+            m_slots[i].sequence.store(i, AK::MemoryOrder::memory_order_relaxed);
+    }
+
+    ~MPMCQueue()
+    {
+        // Destruction must not race with any endpoint, so a plain walk over
+        // the remaining elements is fine here.
+        auto head = m_head.load(AK::MemoryOrder::memory_order_relaxed);
+        auto tail = m_tail.load(AK::MemoryOrder::memory_order_relaxed);
+        for (; head != tail; ++head)
+            m_slots[head % Capacity].element().~T();
+    }
+
+    constexpr size_t capacity() const { return Capacity; }
+
+    // Sizes are inherently approximate under concurrent use; treat these as
+    // hints only.
+    bool is_empty() const { return size() == 0; }
+    size_t size() const
+    {
+        auto tail = m_tail.load(AK::MemoryOrder::memory_order_relaxed);
+        auto head = m_head.load(AK::MemoryOrder::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+    // Returns false if the queue is full.
+    template<typename U = T>
+    [[nodiscard]] bool try_enqueue(U&& value)
+    {
+        auto ticket = m_tail.load(AK::MemoryOrder::memory_order_relaxed);
+        for (;;) {
+            auto& slot = m_slots[ticket % Capacity];
+            auto sequence = slot.sequence.load(AK::MemoryOrder::memory_order_acquire);
+            // Compare as a signed distance so that the counters may wrap.
+            auto distance = static_cast<ssize_t>(sequence - ticket);
+            if (distance == 0) {
+                if (m_tail.compare_exchange_strong(ticket, ticket + 1, AK::MemoryOrder::memory_order_relaxed)) {
+                    new (&slot.element()) T(forward<U>(value));
+                    slot.sequence.store(ticket + 1, AK::MemoryOrder::memory_order_release);
+                    return true;
+                }
+                // compare_exchange_strong reloaded ticket for us; try again.
+            } else if (distance < 0) {
+                // The slot still holds an element from one lap ago: full.
+                return false;
+            } else {
+                ticket = m_tail.load(AK::MemoryOrder::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Returns false if the queue is empty.
+    [[nodiscard]] bool try_dequeue(T& value)
+    {
+        auto ticket = m_head.load(AK::MemoryOrder::memory_order_relaxed);
+        for (;;) {
+            auto& slot = m_slots[ticket % Capacity];
+            auto sequence = slot.sequence.load(AK::MemoryOrder::memory_order_acquire);
+            auto distance = static_cast<ssize_t>(sequence - (ticket + 1));
+            if (distance == 0) {
+                if (m_head.compare_exchange_strong(ticket, ticket + 1, AK::MemoryOrder::memory_order_relaxed)) {
+                    auto& element = slot.element();
+                    value = move(element);
+                    element.~T();
+                    // Mark the slot writable for the producer one lap ahead.
+                    slot.sequence.store(ticket + Capacity, AK::MemoryOrder::memory_order_release);
+                    return true;
+                }
+            } else if (distance < 0) {
+                // The slot hasn't been filled for this lap yet: empty.
+                return false;
+            } else {
+                ticket = m_head.load(AK::MemoryOrder::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    // Each slot gets its own cache line so that threads working on adjacent
+    // tickets don't false-share, and so do the head and tail indices.
+    struct alignas(64) Slot {
+        T& element() { return *reinterpret_cast<T*>(storage); }
+
+        Atomic<size_t> sequence;
+        alignas(T) u8 storage[sizeof(T)];
+    };
+
+    Slot m_slots[Capacity];
+
+    alignas(64) Atomic<size_t> m_head { 0 };
+    alignas(64) Atomic<size_t> m_tail { 0 };
+};
+
+}
+
+using AK::MPMCQueue;
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Noncopyable.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Types.h>
+
+namespace AK {
+
+// A fixed-capacity wait-free queue for exactly one producer thread and one
+// consumer thread. The producer only writes the tail and the consumer only
+// writes the head; each side reads the other's index with acquire ordering
+// and publishes its own with release ordering, so no locks are needed.
+// The indices grow monotonically and are reduced modulo Capacity, which is
+// why Capacity must be a power of two.
+template<typename T, size_t Capacity>
+class SPSCQueue {
+    AK_MAKE_NONCOPYABLE(SPSCQueue);
+    AK_MAKE_NONMOVABLE(SPSCQueue);
+
+    static_assert(Capacity >= 2 && !(Capacity & (Capacity - 1)), "Capacity must be a power of two");
+
+public:
+    SPSCQueue() = default;
+
+    ~SPSCQueue()
+    {
+        // Destruction must not race with either endpoint, so plain walks
+        // over the remaining elements are fine here.
+        auto head = m_head.load(AK::MemoryOrder::memory_order_relaxed);
+        auto tail = m_tail.load(AK::MemoryOrder::memory_order_relaxed);
+        for (; head != tail; ++head)
+            slot(head).~T();
+    }
+
+    constexpr size_t capacity() const { return Capacity; }
+
+    // Note that each of these is only exact on its own thread: the producer
+    // may observe a stale head (under-reporting free space) and the consumer
+    // a stale tail (under-reporting available elements), never the reverse.
+    bool is_empty() const { return m_tail.load(AK::MemoryOrder::memory_order_relaxed) == m_head.load(AK::MemoryOrder::memory_order_relaxed); }
+    bool is_full() const { return m_tail.load(AK::MemoryOrder::memory_order_relaxed) - m_head.load(AK::MemoryOrder::memory_order_relaxed) >= Capacity; }
+    size_t size() const { return m_tail.load(AK::MemoryOrder::memory_order_relaxed) - m_head.load(AK::MemoryOrder::memory_order_relaxed); }
+
+    // Producer side. Returns false if the queue is full.
+    template<typename U = T>
+    [[nodiscard]] bool try_enqueue(U&& value)
+    {
+        auto tail = m_tail.load(AK::MemoryOrder::memory_order_relaxed);
+        if (tail - m_head.load(AK::MemoryOrder::memory_order_acquire) >= Capacity)
+            return false;
+        new (&slot(tail)) T(forward<U>(value));
+        m_tail.store(tail + 1, AK::MemoryOrder::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns false if the queue is empty.
+    [[nodiscard]] bool try_dequeue(T& value)
+    {
+        auto head = m_head.load(AK::MemoryOrder::memory_order_relaxed);
+        if (head == m_tail.load(AK::MemoryOrder::memory_order_acquire))
+            return false;
+        auto& element = slot(head);
+        value = move(element);
+        element.~T();
+        m_head.store(head + 1, AK::MemoryOrder::memory_order_release);
+        return true;
+    }
+
+private:
+    T& slot(size_t index) { return reinterpret_cast<T*>(m_storage)[index % Capacity]; }
+
+    alignas(T) u8 m_storage[sizeof(T) * Capacity];
+
+    // The indices live on separate cache lines so that the producer bumping
+    // the tail doesn't invalidate the line the consumer spins on.
+    alignas(64) Atomic<size_t> m_head { 0 };
+    alignas(64) Atomic<size_t> m_tail { 0 };
+};
+
+}
+
+using AK::SPSCQueue;
@@ -21,6 +21,20 @@ inline void StringBuilder::will_append(size_t size)
     Checked<size_t> needed_capacity = m_length;
     needed_capacity += size;
     VERIFY(!needed_capacity.has_overflow());
+    if (m_output_mode == OutputMode::Chunked) {
+        size_t used_in_current_chunk = m_length - m_chunk_offset;
+        if (used_in_current_chunk + size <= m_buffer.size())
+            return;
+        // Seal off the current chunk and start a fresh one; already-written
+        // data is never moved again.
+        if (used_in_current_chunk > 0) {
+            m_buffer.trim(used_in_current_chunk);
+            m_chunks.append(move(m_buffer));
+            m_chunk_offset = m_length;
+        }
+        m_buffer = decltype(m_buffer)::create_uninitialized(max(chunk_size, size));
+        return;
+    }
     Checked<size_t> expanded_capacity = needed_capacity;
     // Prefer to completely use the inline buffer first
     if (needed_capacity > inline_capacity)
@@ -34,12 +48,18 @@ StringBuilder::StringBuilder(size_t initial_capacity)
 {
 }
 
+StringBuilder::StringBuilder(OutputMode output_mode)
+    : m_buffer(decltype(m_buffer)::create_uninitialized(inline_capacity))
+    , m_output_mode(output_mode)
+{
+}
+
 void StringBuilder::append(const StringView& str)
 {
     if (str.is_empty())
         return;
     will_append(str.length());
-    memcpy(data() + m_length, str.characters_without_null_termination(), str.length());
+    memcpy(data() + m_length - m_chunk_offset, str.characters_without_null_termination(), str.length());
     m_length += str.length();
 }
 
@@ -51,7 +71,7 @@ void StringBuilder::append(const char* characters, size_t length)
 void StringBuilder::append(char ch)
 {
     will_append(1);
-    data()[m_length] = ch;
+    data()[m_length - m_chunk_offset] = ch;
     m_length += 1;
 }
 
@@ -65,6 +85,11 @@ void StringBuilder::appendvf(const char* fmt, va_list ap)
 
 ByteBuffer StringBuilder::to_byte_buffer() const
 {
+    if (m_output_mode == OutputMode::Chunked) {
+        auto buffer = ByteBuffer::create_uninitialized(m_length);
+        copy_into(buffer.data());
+        return buffer;
+    }
     return ByteBuffer::copy(data(), length());
 }
 
@@ -72,6 +97,12 @@ String StringBuilder::to_string() const
 {
     if (is_empty())
         return String::empty();
+    if (m_output_mode == OutputMode::Chunked) {
+        char* buffer;
+        auto impl = StringImpl::create_uninitialized(m_length, buffer);
+        copy_into((u8*)buffer);
+        return String(move(impl));
+    }
     return String((const char*)data(), length());
 }
 
@@ -80,15 +111,29 @@ String StringBuilder::build() const
     return to_string();
 }
 
+void StringBuilder::copy_into(u8* destination) const
+{
+    size_t offset = 0;
+    for (auto& chunk : m_chunks) {
+        memcpy(destination + offset, chunk.data(), chunk.size());
+        offset += chunk.size();
+    }
+    memcpy(destination + offset, data(), m_length - m_chunk_offset);
+}
+
 StringView StringBuilder::string_view() const
 {
+    // A chunked builder's data is not contiguous until build() assembles it.
+    VERIFY(m_output_mode == OutputMode::Contiguous);
     return StringView { data(), m_length };
 }
 
 void StringBuilder::clear()
 {
     m_buffer.clear();
+    m_chunks.clear();
     m_length = 0;
+    m_chunk_offset = 0;
 }
 
 void StringBuilder::append_code_point(u32 code_point)
@@ -10,6 +10,7 @@
 #include <AK/Format.h>
 #include <AK/Forward.h>
 #include <AK/StringView.h>
+#include <AK/Vector.h>
 #include <stdarg.h>
 
 namespace AK {
@@ -18,7 +19,19 @@ class StringBuilder {
 public:
     using OutputType = String;
 
+    enum class OutputMode {
+        // Everything is kept in one contiguous buffer, so string_view() is
+        // available at any time, but a large build may have to move the data
+        // every time the buffer grows.
+        Contiguous,
+        // Data is collected in fixed-size chunks and only assembled once, on
+        // build(). Appending never moves already-written data, which makes
+        // this the better fit for multi-megabyte outputs.
+        Chunked,
+    };
+
     explicit StringBuilder(size_t initial_capacity = inline_capacity);
+    explicit StringBuilder(OutputMode);
     ~StringBuilder() = default;
 
     void append(const StringView&);
@@ -46,7 +59,13 @@ public:
 
     [[nodiscard]] size_t length() const { return m_length; }
     [[nodiscard]] bool is_empty() const { return m_length == 0; }
-    void trim(size_t count) { m_length -= count; }
+    void trim(size_t count)
+    {
+        // In chunked mode we can only un-append data that's still in the
+        // current chunk; everything before that has been sealed off.
+        VERIFY(m_length - count >= m_chunk_offset);
+        m_length -= count;
+    }
 
     template<class SeparatorType, class CollectionType>
     void join(const SeparatorType& separator, const CollectionType& collection)
@@ -63,12 +82,19 @@ public:
 
 private:
     void will_append(size_t);
+    void copy_into(u8* destination) const;
     u8* data() { return m_buffer.data(); }
     const u8* data() const { return m_buffer.data(); }
 
     static constexpr size_t inline_capacity = 128;
+    static constexpr size_t chunk_size = 64 * KiB;
+
     AK::Detail::ByteBuffer<inline_capacity> m_buffer;
+    Vector<AK::Detail::ByteBuffer<inline_capacity>> m_chunks;
     size_t m_length { 0 };
+    // How much of m_length lives in completed chunks rather than in m_buffer.
+    size_t m_chunk_offset { 0 };
+    OutputMode m_output_mode { OutputMode::Contiguous };
 };
 
 }
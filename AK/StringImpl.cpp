@@ -16,6 +16,11 @@ namespace AK {
 
 static StringImpl* s_the_empty_stringimpl = nullptr;
 
+// Single-character strings are very common (JSON keys, CSS identifiers, path
+// components), so they all share one cached StringImpl per character instead
+// of each getting their own heap allocation.
+static StringImpl* s_single_character_stringimpls[256];
+
 StringImpl& StringImpl::the_empty_stringimpl()
 {
     if (!s_the_empty_stringimpl) {
@@ -25,6 +30,18 @@ StringImpl& StringImpl::the_empty_stringimpl()
     return *s_the_empty_stringimpl;
 }
 
+StringImpl& StringImpl::the_single_character_stringimpl(char character)
+{
+    auto& slot = s_single_character_stringimpls[static_cast<u8>(character)];
+    if (!slot) {
+        char* buffer;
+        auto impl = create_uninitialized(1, buffer);
+        buffer[0] = character;
+        slot = &impl.leak_ref();
+    }
+    return *slot;
+}
+
 StringImpl::StringImpl(ConstructWithInlineBufferTag, size_t length)
     : m_length(length)
 {
@@ -70,6 +87,9 @@ RefPtr<StringImpl> StringImpl::create(const char* cstring, size_t length, Should
     if (!length)
         return the_empty_stringimpl();
 
+    if (length == 1)
+        return the_single_character_stringimpl(*cstring);
+
     char* buffer;
     auto new_stringimpl = create_uninitialized(length, buffer);
     memcpy(buffer, cstring, length * sizeof(char));
@@ -60,12 +60,8 @@ public:
         , m_outline_buffer(other.m_outline_buffer)
     {
         if constexpr (inline_capacity > 0) {
-            if (!m_outline_buffer) {
-                for (size_t i = 0; i < m_size; ++i) {
-                    new (&inline_buffer()[i]) T(move(other.inline_buffer()[i]));
-                    other.inline_buffer()[i].~T();
-                }
-            }
+            if (!m_outline_buffer)
+                move_from_inline_buffer(other);
         }
         other.m_outline_buffer = nullptr;
         other.m_size = 0;
@@ -99,12 +95,8 @@ public:
             m_capacity = other.m_capacity;
             m_outline_buffer = other.m_outline_buffer;
             if constexpr (inline_capacity > 0) {
-                if (!m_outline_buffer) {
-                    for (size_t i = 0; i < m_size; ++i) {
-                        new (&inline_buffer()[i]) T(move(other.inline_buffer()[i]));
-                        other.inline_buffer()[i].~T();
-                    }
-                }
+                if (!m_outline_buffer)
+                    move_from_inline_buffer(other);
             }
             other.m_outline_buffer = nullptr;
             other.m_size = 0;
@@ -650,6 +642,48 @@ public:
         VERIFY(did_allocate);
     }
 
+    // Grows the vector without initializing the new elements, for callers
+    // that are about to overwrite them anyway. Only types Traits considers
+    // trivial skip initialization; everything else is value-initialized as
+    // in resize().
+    [[nodiscard]] bool try_resize_uninitialized(size_t new_size, bool keep_capacity = false)
+    {
+        if (new_size <= size()) {
+            shrink(new_size, keep_capacity);
+            return true;
+        }
+
+        if (!try_ensure_capacity(new_size))
+            return false;
+
+        if constexpr (!Traits<T>::is_trivial()) {
+            for (size_t i = size(); i < new_size; ++i)
+                new (slot(i)) T {};
+        }
+        m_size = new_size;
+        return true;
+    }
+
+    void resize_uninitialized(size_t new_size, bool keep_capacity = false)
+    {
+        auto did_allocate = try_resize_uninitialized(new_size, keep_capacity);
+        VERIFY(did_allocate);
+    }
+
+    // Makes room for count new elements at the end and returns a pointer to
+    // the first of them. Like resize_uninitialized(), trivial types are left
+    // uninitialized for the caller to fill in.
+    T* append_range_uninitialized(size_t count)
+    {
+        grow_capacity(size() + count);
+        if constexpr (!Traits<T>::is_trivial()) {
+            for (size_t i = 0; i < count; ++i)
+                new (slot(m_size + i)) T {};
+        }
+        m_size += count;
+        return slot(m_size - count);
+    }
+
     using ConstIterator = SimpleIterator<const Vector, const T>;
     using Iterator = SimpleIterator<Vector, T>;
 
@@ -691,6 +725,19 @@ public:
     }
 
 private:
+    // Takes over the contents of another vector's inline buffer. The storage
+    // itself is part of the object and can't be stolen, but TypedTransfer
+    // moves trivial types with a single memmove and their destructors are
+    // no-ops, so we only run the per-element teardown loop when needed.
+    void move_from_inline_buffer(Vector& other)
+    {
+        TypedTransfer<T>::move(inline_buffer(), other.inline_buffer(), m_size);
+        if constexpr (!Traits<T>::is_trivial()) {
+            for (size_t i = 0; i < m_size; ++i)
+                other.inline_buffer()[i].~T();
+        }
+    }
+
     void reset_capacity()
     {
         m_capacity = inline_capacity;
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+
+// The layout of the single shared page of an async I/O ring, as mapped by
+// both the kernel and userspace. Userspace appends submission entries at
+// sq_tail and reaps completion entries at cq_head; the kernel consumes
+// submissions at sq_head and posts completions at cq_tail. All indices
+// increase monotonically and are reduced modulo the entry counts on access.
+
+struct AsyncIORingSQE {
+    enum Opcode : u32 {
+        Invalid = 0,
+        Read,
+        Write,
+        Fsync,
+    };
+
+    u64 user_data { 0 };
+    u64 buffer { 0 };
+    u64 offset { 0 }; // (u64)-1 means "use (and advance) the fd's offset"
+    u32 length { 0 };
+    i32 fd { -1 };
+    u32 opcode { Invalid };
+    u32 padding { 0 };
+};
+
+struct AsyncIORingCQE {
+    u64 user_data { 0 };
+    i64 result { 0 };
+};
+
+struct AsyncIORingHeader {
+    u32 sq_head { 0 };
+    u32 sq_tail { 0 };
+    u32 cq_head { 0 };
+    u32 cq_tail { 0 };
+    u32 sq_entry_count { 0 };
+    u32 cq_entry_count { 0 };
+    u32 sqe_array_offset { 0 };
+    u32 cqe_array_offset { 0 };
+};
+
+static constexpr u64 async_io_ring_no_offset = (u64)-1;
@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+
+struct EventQueueEvent {
+    int fd { -1 };
+    u32 events { 0 };
+};
+
+// EventQueueEvent::events bits.
+#define EVENT_QUEUE_EVENT_READ 1u
+#define EVENT_QUEUE_EVENT_WRITE 2u
+#define EVENT_QUEUE_EVENT_EXCEPTION 4u
+
+// Operations for event_queue_ctl().
+#define EVENT_QUEUE_ADD 1
+#define EVENT_QUEUE_MODIFY 2
+#define EVENT_QUEUE_DELETE 3
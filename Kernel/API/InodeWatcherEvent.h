@@ -34,4 +34,10 @@ struct [[gnu::packed]] InodeWatcherEvent {
 
 AK_ENUM_BITWISE_OPERATORS(InodeWatcherEvent::Type);
 
+// May be OR'ed into the event mask passed to inode_watcher_add_watch() to
+// watch the entire directory tree below the given directory. This is a watch
+// modifier, not an event type; it is never reported back in events. Events
+// from subdirectories carry the path relative to the watch root in `name`.
+constexpr unsigned INODE_WATCHER_RECURSIVE = 1u << 31;
+
 constexpr unsigned MAXIMUM_EVENT_SIZE = sizeof(InodeWatcherEvent) + NAME_MAX + 1;
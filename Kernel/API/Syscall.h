@@ -18,6 +18,7 @@ constexpr int syscall_vector = 0x82;
 extern "C" {
 struct pollfd;
 struct timeval;
+struct EventQueueEvent;
 struct timespec;
 struct sockaddr;
 struct siginfo;
@@ -109,6 +110,7 @@ namespace Kernel {
     S(symlink)                    \
     S(sendmsg)                    \
     S(recvmsg)                    \
+    S(recvmmsg)                   \
     S(getsockopt)                 \
     S(setsockopt)                 \
     S(create_thread)              \
@@ -180,7 +182,16 @@ namespace Kernel {
     S(readv)                      \
     S(emuctl)                     \
     S(statvfs)                    \
-    S(fstatvfs)
+    S(fstatvfs)                   \
+    S(sendfile)                   \
+    S(async_io_create)            \
+    S(async_io_submit)            \
+    S(event_queue_create)         \
+    S(event_queue_ctl)            \
+    S(event_queue_wait)           \
+    S(splice)                     \
+    S(sched_setaffinity)          \
+    S(sched_getaffinity)
 
 namespace Syscall {
 
@@ -307,6 +318,13 @@ struct SC_getpeername_params {
     socklen_t* addrlen;
 };
 
+struct SC_recvmmsg_params {
+    int sockfd;
+    struct mmsghdr* msgvec;
+    unsigned vlen;
+    int flags;
+};
+
 struct SC_socketpair_params {
     int domain;
     int type;
@@ -466,6 +484,27 @@ struct SC_statvfs_params {
     struct statvfs* buf;
 };
 
+struct SC_sendfile_params {
+    int out_fd;
+    int in_fd;
+    i64* offset;
+    size_t count;
+};
+
+struct SC_event_queue_ctl_params {
+    int queue_fd;
+    int op;
+    int fd;
+    u32 events;
+};
+
+struct SC_event_queue_wait_params {
+    int queue_fd;
+    struct EventQueueEvent* events;
+    int max_events;
+    const struct timespec* timeout;
+};
+
 void initialize();
 int sync();
 
@@ -1844,6 +1844,16 @@ void Processor::check_invoke_scheduler()
 
 void Processor::flush_tlb_local(VirtualAddress vaddr, size_t page_count)
 {
+    // Above this threshold it's cheaper to throw away all non-global
+    // translations by reloading cr3 than to issue one invlpg per page.
+    // Kernel mappings are marked global, so this shortcut only works
+    // for userspace ranges.
+    static constexpr size_t full_flush_threshold = 64;
+    if (page_count >= full_flush_threshold && is_user_range(vaddr, page_count * PAGE_SIZE)) {
+        write_cr3(read_cr3());
+        return;
+    }
+
     auto ptr = vaddr.as_ptr();
     while (page_count > 0) {
         // clang-format off
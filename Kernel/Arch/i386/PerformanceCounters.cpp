@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <AK/Format.h>
+#include <AK/Vector.h>
+#include <Kernel/Arch/x86/CPU.h>
+#include <Kernel/Arch/x86/PerformanceCounters.h>
+
+namespace Kernel {
+
+static constexpr u32 msr_ia32_pmc0 = 0xc1;
+static constexpr u32 msr_ia32_perfevtsel0 = 0x186;
+static constexpr u32 msr_ia32_perf_global_ctrl = 0x38f;
+
+static constexpr u32 perfevtsel_usr = 1 << 16;
+static constexpr u32 perfevtsel_os = 1 << 17;
+static constexpr u32 perfevtsel_enable = 1 << 22;
+
+struct ArchitecturalEvent {
+    PerformanceCounterType type { PerformanceCounterType::None };
+    u8 event_select { 0 };
+    u8 umask { 0 };
+    // Bit index in CPUID.0AH:EBX; a set bit means the event is *not*
+    // available on this CPU.
+    u8 unavailable_bit { 0 };
+};
+
+// Listed in the order we want coverage: the data-layout events first, the
+// general ones after.
+static constexpr ArchitecturalEvent s_events[] = {
+    { PerformanceCounterType::CacheMisses, 0x2e, 0x41, 4 },
+    { PerformanceCounterType::BranchMispredicts, 0xc5, 0x00, 6 },
+    { PerformanceCounterType::Cycles, 0x3c, 0x00, 0 },
+    { PerformanceCounterType::Instructions, 0xc0, 0x00, 1 },
+};
+
+// Switch to the next event pair after this many profile ticks, so a profile
+// of any length sees every available event roughly equally often.
+static constexpr u32 rotation_period = 128;
+
+struct ProcessorCounterState {
+    // Compared against s_enable_generation to decide whether this CPU still
+    // has to (re)program its counters for the current profiling run.
+    u32 generation { 0 };
+    u32 first_event { 0 };
+    u32 ticks_until_rotation { 0 };
+    u8 programmed_events[PerformanceCounterSample::max_counters] {};
+    u64 last_value[PerformanceCounterSample::max_counters] {};
+};
+
+static constexpr size_t max_processors = 64;
+static ProcessorCounterState s_processor_state[max_processors];
+
+static Atomic<u32> s_enable_generation { 0 };
+static Atomic<u32> s_enable_count { 0 };
+static Atomic<bool> s_enabled { false };
+
+struct HostCounterInfo {
+    bool initialized { false };
+    bool supported { false };
+    u32 counter_count { 0 };
+    u64 counter_mask { 0 };
+    Vector<u8, 4> available_events;
+};
+
+static HostCounterInfo s_host_info;
+
+static HostCounterInfo& host_info()
+{
+    if (!s_host_info.initialized) {
+        s_host_info.initialized = true;
+        CPUID max_leaf(0);
+        if (max_leaf.eax() >= 0xa) {
+            CPUID leaf_a(0xa);
+            u32 version = leaf_a.eax() & 0xff;
+            u32 counter_count = (leaf_a.eax() >> 8) & 0xff;
+            u32 counter_width = (leaf_a.eax() >> 16) & 0xff;
+            if (version >= 1 && counter_count >= 1 && counter_width >= 32) {
+                for (size_t i = 0; i < array_size(s_events); ++i) {
+                    if (!(leaf_a.ebx() & (1u << s_events[i].unavailable_bit)))
+                        s_host_info.available_events.append(i);
+                }
+                if (!s_host_info.available_events.is_empty()) {
+                    s_host_info.supported = true;
+                    s_host_info.counter_count = min(counter_count, (u32)PerformanceCounterSample::max_counters);
+                    s_host_info.counter_mask = (1ull << counter_width) - 1;
+                }
+            }
+        }
+        if (!s_host_info.supported)
+            dmesgln("PerformanceCounters: No architectural performance monitoring on this CPU");
+    }
+    return s_host_info;
+}
+
+bool PerformanceCounters::is_supported()
+{
+    return host_info().supported;
+}
+
+void PerformanceCounters::enable()
+{
+    if (!is_supported())
+        return;
+    // Profiles can overlap (a per-process profile during a global one), so
+    // the counters stay on until the last one ends, like the profile timer.
+    if (s_enable_count.fetch_add(1, AK::MemoryOrder::memory_order_relaxed) == 0) {
+        s_enable_generation.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+        s_enabled.store(true, AK::MemoryOrder::memory_order_release);
+    }
+}
+
+void PerformanceCounters::disable()
+{
+    if (!is_supported())
+        return;
+    // The counters keep running until each processor reprograms them on the
+    // next profiling run; nothing reads them in the meantime, so there is no
+    // need for cross-CPU messaging here either.
+    if (s_enable_count.fetch_sub(1, AK::MemoryOrder::memory_order_relaxed) == 1)
+        s_enabled.store(false, AK::MemoryOrder::memory_order_release);
+}
+
+static void program_counters(ProcessorCounterState& state)
+{
+    auto& info = host_info();
+    for (u32 i = 0; i < info.counter_count; ++i) {
+        auto event_index = info.available_events[(state.first_event + i) % info.available_events.size()];
+        auto& event = s_events[event_index];
+        state.programmed_events[i] = event_index;
+        state.last_value[i] = 0;
+        MSR(msr_ia32_perfevtsel0 + i).set(0, 0);
+        MSR(msr_ia32_pmc0 + i).set(0, 0);
+        MSR(msr_ia32_perfevtsel0 + i).set(perfevtsel_enable | perfevtsel_os | perfevtsel_usr | ((u32)event.umask << 8) | event.event_select, 0);
+    }
+    // Architectural perfmon version 2 gates the counters behind a global
+    // enable register on top of the per-counter enable bits.
+    CPUID leaf_a(0xa);
+    if ((leaf_a.eax() & 0xff) >= 2)
+        MSR(msr_ia32_perf_global_ctrl).set((1u << info.counter_count) - 1, 0);
+    state.ticks_until_rotation = rotation_period;
+}
+
+void PerformanceCounters::read_sample_on_current_processor(PerformanceCounterSample& sample)
+{
+    if (!s_enabled.load(AK::MemoryOrder::memory_order_acquire))
+        return;
+    auto& info = host_info();
+    if (!info.supported)
+        return;
+
+    auto processor_id = Processor::id();
+    if (processor_id >= max_processors)
+        return;
+    auto& state = s_processor_state[processor_id];
+
+    auto generation = s_enable_generation.load(AK::MemoryOrder::memory_order_relaxed);
+    if (state.generation != generation) {
+        state.generation = generation;
+        state.first_event = 0;
+        program_counters(state);
+        // The counters were just zeroed; report the first tick as no delta.
+        return;
+    }
+
+    for (u32 i = 0; i < info.counter_count; ++i) {
+        u32 low = 0;
+        u32 high = 0;
+        MSR(msr_ia32_pmc0 + i).get(low, high);
+        u64 value = (((u64)high << 32) | low) & info.counter_mask;
+        sample.types[i] = (u8)s_events[state.programmed_events[i]].type;
+        sample.deltas[i] = (value - state.last_value[i]) & info.counter_mask;
+        state.last_value[i] = value;
+    }
+
+    if (info.available_events.size() > info.counter_count && --state.ticks_until_rotation == 0) {
+        state.first_event = (state.first_event + info.counter_count) % info.available_events.size();
+        program_counters(state);
+    }
+}
+
+}
@@ -716,6 +716,11 @@ public:
         s_idle_cpu_mask.fetch_and(~(1u << m_cpu), AK::MemoryOrder::memory_order_relaxed);
     }
 
+    bool is_marked_idle() const
+    {
+        return (s_idle_cpu_mask.load(AK::MemoryOrder::memory_order_relaxed) & (1u << m_cpu)) != 0;
+    }
+
     static u32 count()
     {
         // NOTE: because this value never changes once all APs are booted,
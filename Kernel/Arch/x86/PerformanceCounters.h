@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+
+namespace Kernel {
+
+// The architectural performance-monitoring events we know how to program
+// (Intel SDM vol. 3, "Pre-defined Architectural Performance Events").
+enum class PerformanceCounterType : u8 {
+    None = 0,
+    CacheMisses,
+    BranchMispredicts,
+    Cycles,
+    Instructions,
+};
+
+inline const char* performance_counter_type_to_string(PerformanceCounterType type)
+{
+    switch (type) {
+    case PerformanceCounterType::CacheMisses:
+        return "cache_misses";
+    case PerformanceCounterType::BranchMispredicts:
+        return "branch_misses";
+    case PerformanceCounterType::Cycles:
+        return "cycles";
+    case PerformanceCounterType::Instructions:
+        return "instructions";
+    default:
+        return "none";
+    }
+}
+
+// How far each programmed counter advanced since the previous profile tick
+// on the same processor.
+struct PerformanceCounterSample {
+    static constexpr size_t max_counters = 2;
+    u8 types[max_counters] {};
+    u64 deltas[max_counters] {};
+};
+
+// Drives the architectural performance-monitoring counters (CPUID leaf 0Ah,
+// the IA32_PERFEVTSELx / IA32_PMCx MSRs) while the profile timer is running.
+// With only two hardware counters in use and four interesting events, the
+// programmed event pair is rotated periodically so every event gets coverage
+// over the length of a profile.
+class PerformanceCounters {
+public:
+    static bool is_supported();
+
+    // Called when profiling starts and stops. Counters are (re)programmed
+    // lazily by each processor on its next profile tick, so no cross-CPU
+    // messaging is needed here.
+    static void enable();
+    static void disable();
+
+    // Reads the counter deltas accumulated on this processor since the last
+    // call and advances the multiplex rotation. Only called from the profile
+    // timer interrupt. Leaves the sample's types as None when the CPU has no
+    // architectural performance monitoring or profiling counters are off.
+    static void read_sample_on_current_processor(PerformanceCounterSample&);
+};
+
+}
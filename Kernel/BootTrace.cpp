@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Format.h>
+#include <Kernel/Arch/x86/CPU.h>
+#include <Kernel/BootTrace.h>
+
+namespace Kernel {
+
+static constexpr size_t max_boot_trace_events = 64;
+
+// NOTE: This deliberately lives in regular kernel data, not in any of the
+// *_AFTER_INIT sections, so that /proc/boot_trace can still read it long
+// after the init code itself has been unmapped.
+static BootTrace::Event s_events[max_boot_trace_events];
+static size_t s_event_count;
+
+// NOTE: mark() is also not UNMAP_AFTER_INIT: the final checkpoints in
+// init_stage2() are recorded after MM.unmap_memory_after_init().
+// Only the BSP records checkpoints during boot, so no locking is needed.
+void BootTrace::mark(const char* stage)
+{
+    if (s_event_count >= max_boot_trace_events)
+        return;
+    s_events[s_event_count++] = { stage, read_tsc() };
+}
+
+size_t BootTrace::event_count()
+{
+    return s_event_count;
+}
+
+const BootTrace::Event& BootTrace::event(size_t index)
+{
+    VERIFY(index < s_event_count);
+    return s_events[index];
+}
+
+void BootTrace::dump()
+{
+    dmesgln("BootTrace: {} checkpoints:", s_event_count);
+    for (size_t i = 0; i < s_event_count; ++i) {
+        u64 duration = (i + 1 < s_event_count) ? s_events[i + 1].timestamp - s_events[i].timestamp : 0;
+        dmesgln("BootTrace: {:>12} cycles ({:>12} elapsed) {}", duration, s_events[i].timestamp - s_events[0].timestamp, s_events[i].stage);
+    }
+}
+
+}
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+
+namespace Kernel {
+
+// A small fixed-size log of timestamped boot checkpoints. The first
+// checkpoints are recorded before kmalloc is up, so stage names must be
+// string literals and the storage is a static array. Timestamps are raw
+// TSC cycles since the early stages run before TimeManagement exists.
+// The span of a stage is the distance to the following checkpoint.
+class BootTrace {
+public:
+    struct Event {
+        const char* stage { nullptr };
+        u64 timestamp { 0 };
+    };
+
+    static void mark(const char* stage);
+
+    static size_t event_count();
+    static const Event& event(size_t index);
+
+    static void dump();
+};
+
+}
@@ -91,6 +91,11 @@ UNMAP_AFTER_INIT bool CommandLine::is_boot_profiling_enabled() const
     return contains("boot_prof");
 }
 
+UNMAP_AFTER_INIT bool CommandLine::is_boot_trace_dump_enabled() const
+{
+    return contains("boot_trace");
+}
+
 UNMAP_AFTER_INIT bool CommandLine::is_ide_enabled() const
 {
     return !contains("disable_ide");
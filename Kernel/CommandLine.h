@@ -54,6 +54,7 @@ public:
     [[nodiscard]] bool contains(const String& key) const;
 
     [[nodiscard]] bool is_boot_profiling_enabled() const;
+    [[nodiscard]] bool is_boot_trace_dump_enabled() const;
     [[nodiscard]] bool is_ide_enabled() const;
     [[nodiscard]] bool is_smp_enabled() const;
     [[nodiscard]] bool is_vmmouse_enabled() const;
@@ -13,15 +13,21 @@
 #include <Kernel/FileSystem/Custody.h>
 #include <Kernel/FileSystem/FileDescription.h>
 #include <Kernel/FileSystem/VirtualFileSystem.h>
+#include <Kernel/KBuffer.h>
 #include <Kernel/Process.h>
 #include <Kernel/RTC.h>
 #include <Kernel/SpinLock.h>
+#include <Kernel/StdLib.h>
+#include <Kernel/VM/MemoryManager.h>
 #include <Kernel/VM/ProcessPagingScope.h>
 #include <LibC/elf.h>
+#include <LibCompress/Lz4.h>
 #include <LibELF/CoreDump.h>
 
 namespace Kernel {
 
+static constexpr size_t coredump_staging_buffer_size = 256 * KiB;
+
 OwnPtr<CoreDump> CoreDump::create(NonnullRefPtr<Process> process, const String& output_path)
 {
     if (!process->is_dumpable()) {
@@ -32,13 +38,21 @@ OwnPtr<CoreDump> CoreDump::create(NonnullRefPtr<Process> process, const String&
     auto fd = create_target_file(process, output_path);
     if (!fd)
         return {};
-    return adopt_own(*new CoreDump(move(process), fd.release_nonnull()));
+
+    auto staging_buffer = KBuffer::try_create_with_size(coredump_staging_buffer_size, Region::Access::Read | Region::Access::Write, "CoreDump staging");
+    auto compression_buffer = KBuffer::try_create_with_size(Compress::Lz4::maximum_compressed_chunk_size(coredump_staging_buffer_size), Region::Access::Read | Region::Access::Write, "CoreDump compression");
+    if (!staging_buffer || !compression_buffer)
+        return {};
+
+    return adopt_own(*new CoreDump(move(process), fd.release_nonnull(), staging_buffer.release_nonnull(), compression_buffer.release_nonnull()));
 }
 
-CoreDump::CoreDump(NonnullRefPtr<Process> process, NonnullRefPtr<FileDescription>&& fd)
+CoreDump::CoreDump(NonnullRefPtr<Process> process, NonnullRefPtr<FileDescription>&& fd, NonnullOwnPtr<KBuffer> staging_buffer, NonnullOwnPtr<KBuffer> compression_buffer)
     : m_process(move(process))
     , m_fd(move(fd))
     , m_num_program_headers(m_process->space().region_count() + 1) // +1 for NOTE segment
+    , m_staging_buffer(move(staging_buffer))
+    , m_compression_buffer(move(compression_buffer))
 {
 }
 
@@ -71,6 +85,72 @@ RefPtr<FileDescription> CoreDump::create_target_file(const Process& process, con
     return fd_or_error.value();
 }
 
+KResult CoreDump::flush_staging_buffer()
+{
+    if (m_staging_size == 0)
+        return KSuccess;
+    auto compressed_size = Compress::Lz4::compress_chunk({ m_staging_buffer->data(), m_staging_size }, { m_compression_buffer->data(), m_compression_buffer->size() });
+    // The compression buffer is sized for the worst case, so this can only
+    // fail if the staging buffer outgrew it somehow.
+    VERIFY(compressed_size.has_value());
+    auto result = m_fd->write(UserOrKernelBuffer::for_kernel_buffer(m_compression_buffer->data()), compressed_size.value());
+    if (result.is_error())
+        return result.error();
+    m_staging_size = 0;
+    return KSuccess;
+}
+
+KResult CoreDump::append_bytes(const u8* data, size_t size)
+{
+    while (size > 0) {
+        if (m_staging_size == m_staging_buffer->size()) {
+            auto result = flush_staging_buffer();
+            if (result.is_error())
+                return result;
+        }
+        size_t nappended = min(size, m_staging_buffer->size() - m_staging_size);
+        memcpy(m_staging_buffer->data() + m_staging_size, data, nappended);
+        m_staging_size += nappended;
+        data += nappended;
+        size -= nappended;
+    }
+    return KSuccess;
+}
+
+KResult CoreDump::append_user_bytes(const u8* user_data, size_t size)
+{
+    while (size > 0) {
+        if (m_staging_size == m_staging_buffer->size()) {
+            auto result = flush_staging_buffer();
+            if (result.is_error())
+                return result;
+        }
+        size_t nappended = min(size, m_staging_buffer->size() - m_staging_size);
+        if (!copy_from_user(m_staging_buffer->data() + m_staging_size, user_data, nappended))
+            return EFAULT;
+        m_staging_size += nappended;
+        user_data += nappended;
+        size -= nappended;
+    }
+    return KSuccess;
+}
+
+KResult CoreDump::append_zero_bytes(size_t size)
+{
+    while (size > 0) {
+        if (m_staging_size == m_staging_buffer->size()) {
+            auto result = flush_staging_buffer();
+            if (result.is_error())
+                return result;
+        }
+        size_t nappended = min(size, m_staging_buffer->size() - m_staging_size);
+        memset(m_staging_buffer->data() + m_staging_size, 0, nappended);
+        m_staging_size += nappended;
+        size -= nappended;
+    }
+    return KSuccess;
+}
+
 KResult CoreDump::write_elf_header()
 {
     Elf32_Ehdr elf_file_header;
@@ -103,10 +183,7 @@ KResult CoreDump::write_elf_header()
     elf_file_header.e_shnum = 0;
     elf_file_header.e_shstrndx = SHN_UNDEF;
 
-    auto result = m_fd->write(UserOrKernelBuffer::for_kernel_buffer(reinterpret_cast<uint8_t*>(&elf_file_header)), sizeof(Elf32_Ehdr));
-    if (result.is_error())
-        return result.error();
-    return KSuccess;
+    return append_bytes(reinterpret_cast<const uint8_t*>(&elf_file_header), sizeof(Elf32_Ehdr));
 }
 
 KResult CoreDump::write_program_headers(size_t notes_size)
@@ -132,7 +209,9 @@ KResult CoreDump::write_program_headers(size_t notes_size)
 
         offset += phdr.p_filesz;
 
-        [[maybe_unused]] auto rc = m_fd->write(UserOrKernelBuffer::for_kernel_buffer(reinterpret_cast<uint8_t*>(&phdr)), sizeof(Elf32_Phdr));
+        auto result = append_bytes(reinterpret_cast<const uint8_t*>(&phdr), sizeof(Elf32_Phdr));
+        if (result.is_error())
+            return result;
     }
 
     Elf32_Phdr notes_pheader {};
@@ -145,10 +224,7 @@ KResult CoreDump::write_program_headers(size_t notes_size)
     notes_pheader.p_align = 0;
     notes_pheader.p_flags = 0;
 
-    auto result = m_fd->write(UserOrKernelBuffer::for_kernel_buffer(reinterpret_cast<uint8_t*>(&notes_pheader)), sizeof(Elf32_Phdr));
-    if (result.is_error())
-        return result.error();
-    return KSuccess;
+    return append_bytes(reinterpret_cast<const uint8_t*>(&notes_pheader), sizeof(Elf32_Phdr));
 }
 
 KResult CoreDump::write_regions()
@@ -163,20 +239,18 @@ KResult CoreDump::write_regions()
         for (size_t i = 0; i < region->page_count(); i++) {
             auto* page = region->physical_page(i);
 
-            uint8_t zero_buffer[PAGE_SIZE] = {};
-            Optional<UserOrKernelBuffer> src_buffer;
-
-            if (page) {
-                src_buffer = UserOrKernelBuffer::for_user_buffer(reinterpret_cast<uint8_t*>((region->vaddr().as_ptr() + (i * PAGE_SIZE))), PAGE_SIZE);
+            KResult result = KSuccess;
+            if (!page || page->is_shared_zero_page()) {
+                // Pages that have never been faulted in (or still map the
+                // shared zero page) contain only zeroes, and a run of
+                // zeroes compresses down to almost nothing, so untouched
+                // memory costs us close to no disk I/O.
+                result = append_zero_bytes(PAGE_SIZE);
             } else {
-                // If the current page is not backed by a physical page, we zero it in the coredump file.
-                // TODO: Do we want to include the contents of pages that have not been faulted-in in the coredump?
-                //       (A page may not be backed by a physical page because it has never been faulted in when the process ran).
-                src_buffer = UserOrKernelBuffer::for_kernel_buffer(zero_buffer);
+                result = append_user_bytes(region->vaddr().as_ptr() + (i * PAGE_SIZE), PAGE_SIZE);
             }
-            auto result = m_fd->write(src_buffer.value(), PAGE_SIZE);
             if (result.is_error())
-                return result.error();
+                return result;
         }
     }
     return KSuccess;
@@ -184,10 +258,7 @@ KResult CoreDump::write_regions()
 
 KResult CoreDump::write_notes_segment(ByteBuffer& notes_segment)
 {
-    auto result = m_fd->write(UserOrKernelBuffer::for_kernel_buffer(notes_segment.data()), notes_segment.size());
-    if (result.is_error())
-        return result.error();
-    return KSuccess;
+    return append_bytes(notes_segment.data(), notes_segment.size());
 }
 
 ByteBuffer CoreDump::create_notes_process_data() const
@@ -294,6 +365,14 @@ KResult CoreDump::write()
     ScopedSpinLock lock(m_process->space().get_lock());
     ProcessPagingScope scope(m_process);
 
+    // The dump is written as a chunked LZ4 container so CrashDaemon and
+    // LibCoreDump get a compressed file without having to rewrite it.
+    u8 chunked_header[8];
+    size_t chunked_header_size = Compress::Lz4::write_chunked_header({ chunked_header, sizeof(chunked_header) });
+    auto header_result = m_fd->write(UserOrKernelBuffer::for_kernel_buffer(chunked_header), chunked_header_size);
+    if (header_result.is_error())
+        return header_result.error();
+
     ByteBuffer notes_segment = create_notes_segment_data();
 
     auto result = write_elf_header();
@@ -306,6 +385,9 @@ KResult CoreDump::write()
     if (result.is_error())
         return result;
     result = write_notes_segment(notes_segment);
+    if (result.is_error())
+        return result;
+    result = flush_staging_buffer();
     if (result.is_error())
         return result;
 
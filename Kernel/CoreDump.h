@@ -8,6 +8,7 @@
 #pragma once
 
 #include <AK/LexicalPath.h>
+#include <AK/NonnullOwnPtr.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/OwnPtr.h>
 #include <Kernel/Forward.h>
@@ -24,7 +25,7 @@ public:
     [[nodiscard]] KResult write();
 
 private:
-    CoreDump(NonnullRefPtr<Process>, NonnullRefPtr<FileDescription>&&);
+    CoreDump(NonnullRefPtr<Process>, NonnullRefPtr<FileDescription>&&, NonnullOwnPtr<KBuffer> staging_buffer, NonnullOwnPtr<KBuffer> compression_buffer);
     static RefPtr<FileDescription> create_target_file(const Process&, const String& output_path);
 
     [[nodiscard]] KResult write_elf_header();
@@ -32,6 +33,11 @@ private:
     [[nodiscard]] KResult write_regions();
     [[nodiscard]] KResult write_notes_segment(ByteBuffer&);
 
+    [[nodiscard]] KResult append_bytes(const u8* data, size_t);
+    [[nodiscard]] KResult append_user_bytes(const u8* user_data, size_t);
+    [[nodiscard]] KResult append_zero_bytes(size_t);
+    [[nodiscard]] KResult flush_staging_buffer();
+
     ByteBuffer create_notes_segment_data() const;
     ByteBuffer create_notes_process_data() const;
     ByteBuffer create_notes_threads_data() const;
@@ -41,6 +47,14 @@ private:
     NonnullRefPtr<Process> m_process;
     NonnullRefPtr<FileDescription> m_fd;
     const size_t m_num_program_headers;
+
+    // The dump streams through a bounded staging buffer: everything is
+    // appended here and flushed to disk one LZ4-compressed chunk at a
+    // time, so memory usage stays constant no matter how large the
+    // crashed process was.
+    NonnullOwnPtr<KBuffer> m_staging_buffer;
+    NonnullOwnPtr<KBuffer> m_compression_buffer;
+    size_t m_staging_size { 0 };
 };
 
 }
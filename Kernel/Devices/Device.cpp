@@ -64,10 +64,32 @@ void Device::process_next_queued_request(Badge<AsyncDeviceRequest>, const AsyncD
 {
     ScopedSpinLock lock(m_requests_lock);
     VERIFY(!m_requests.is_empty());
-    VERIFY(m_requests.first().ptr() == &completed_request);
-    m_requests.remove(m_requests.begin());
-    if (!m_requests.is_empty()) {
-        auto* next_request = m_requests.first().ptr();
+    VERIFY(m_active_requests > 0);
+    // With a queue depth above 1, requests may complete out of order, so
+    // look the completed request up instead of assuming it's at the front.
+    bool found = false;
+    for (auto it = m_requests.begin(); it != m_requests.end(); ++it) {
+        if (it->ptr() == &completed_request) {
+            m_requests.remove(it);
+            found = true;
+            break;
+        }
+    }
+    VERIFY(found);
+    --m_active_requests;
+
+    // The first m_active_requests entries are in flight; anything after
+    // that is still waiting for a free slot.
+    AsyncDeviceRequest* next_request = nullptr;
+    size_t index = 0;
+    for (auto& request : m_requests) {
+        if (index++ == m_active_requests) {
+            next_request = request.ptr();
+            break;
+        }
+    }
+    if (next_request) {
+        ++m_active_requests;
         next_request->do_start(move(lock));
     }
 
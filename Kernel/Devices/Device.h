@@ -53,15 +53,21 @@ public:
     {
         auto request = adopt_ref(*new AsyncRequestType(*this, forward<Args>(args)...));
         ScopedSpinLock lock(m_requests_lock);
-        bool was_empty = m_requests.is_empty();
         m_requests.append(request);
-        if (was_empty)
+        if (m_active_requests < request_queue_depth()) {
+            ++m_active_requests;
             request->do_start(move(lock));
+        }
         return request;
     }
 
 protected:
     Device(unsigned major, unsigned minor);
+
+    // How many requests the device can have in flight at the same time.
+    // Devices with hardware command queueing override this to keep their
+    // command slots busy; everything else is serviced one at a time.
+    virtual size_t request_queue_depth() const { return 1; }
     void set_uid(uid_t uid) { m_uid = uid; }
     void set_gid(gid_t gid) { m_gid = gid; }
 
@@ -75,6 +81,7 @@ private:
 
     SpinLock<u8> m_requests_lock;
     DoublyLinkedList<RefPtr<AsyncDeviceRequest>> m_requests;
+    size_t m_active_requests { 0 };
 };
 
 }
@@ -29,6 +29,42 @@ DoubleBuffer::DoubleBuffer(size_t capacity)
     m_space_for_writing = capacity;
 }
 
+KResult DoubleBuffer::set_capacity(size_t capacity)
+{
+    Locker locker(m_lock);
+    if (m_storage.is_null())
+        return ENOBUFS;
+    if (capacity == m_capacity)
+        return KSuccess;
+    size_t buffered = (m_read_buffer->size - m_read_buffer_index) + m_write_buffer->size;
+    if (capacity < buffered)
+        return EBUSY;
+    auto new_storage = KBuffer::try_create_with_size(capacity * 2, Region::Access::Read | Region::Access::Write, "DoubleBuffer");
+    if (!new_storage)
+        return ENOMEM;
+
+    // Compact everything that's still buffered into the new read buffer so
+    // readers pick up exactly where they left off.
+    u8* new_data = new_storage->data();
+    size_t unread = m_read_buffer->size - m_read_buffer_index;
+    memcpy(new_data, m_read_buffer->data + m_read_buffer_index, unread);
+    memcpy(new_data + unread, m_write_buffer->data, m_write_buffer->size);
+
+    m_storage = move(*new_storage);
+    m_capacity = capacity;
+    m_buffer1.data = m_storage.data();
+    m_buffer1.size = buffered;
+    m_buffer2.data = m_storage.data() + capacity;
+    m_buffer2.size = 0;
+    m_read_buffer = &m_buffer1;
+    m_write_buffer = &m_buffer2;
+    m_read_buffer_index = 0;
+    compute_lockfree_metadata();
+    if (m_unblock_callback && m_space_for_writing > 0)
+        m_unblock_callback();
+    return KSuccess;
+}
+
 void DoubleBuffer::flip()
 {
     if (m_storage.is_null())
@@ -45,13 +81,23 @@ ssize_t DoubleBuffer::write(const UserOrKernelBuffer& data, size_t size)
     if (!size || m_storage.is_null())
         return 0;
     Locker locker(m_lock);
+    if (size > m_space_for_writing && m_capacity < m_maximum_capacity) {
+        // The writer is outrunning us; grow up to the cap rather than
+        // making it block once per capacity-sized chunk. Failure is fine,
+        // we just keep the current capacity.
+        size_t wanted_capacity = min(m_maximum_capacity, max(m_capacity * 2, m_write_buffer->size + size));
+        (void)set_capacity(wanted_capacity);
+    }
+    bool was_empty = m_empty;
     size_t bytes_to_write = min(size, m_space_for_writing);
     u8* write_ptr = m_write_buffer->data + m_write_buffer->size;
     if (!data.read(write_ptr, bytes_to_write))
         return -EFAULT;
     m_write_buffer->size += bytes_to_write;
     compute_lockfree_metadata();
-    if (m_unblock_callback && !m_empty)
+    // Readers only block on an empty buffer, so further writes to an
+    // already non-empty buffer have nobody to wake.
+    if (m_unblock_callback && was_empty && !m_empty)
         m_unblock_callback();
     return (ssize_t)bytes_to_write;
 }
@@ -61,6 +107,7 @@ ssize_t DoubleBuffer::read(UserOrKernelBuffer& data, size_t size)
     if (!size || m_storage.is_null())
         return 0;
     Locker locker(m_lock);
+    bool had_no_space = m_space_for_writing == 0;
     if (m_read_buffer_index >= m_read_buffer->size && m_write_buffer->size != 0)
         flip();
     if (m_read_buffer_index >= m_read_buffer->size)
@@ -70,7 +117,10 @@ ssize_t DoubleBuffer::read(UserOrKernelBuffer& data, size_t size)
         return -EFAULT;
     m_read_buffer_index += nread;
     compute_lockfree_metadata();
-    if (m_unblock_callback && m_space_for_writing > 0)
+    // Writers only block on a full buffer, and reading can only open up
+    // write space by flipping, so that's the only transition worth a
+    // wakeup.
+    if (m_unblock_callback && had_no_space && m_space_for_writing > 0)
         m_unblock_callback();
     return (ssize_t)nread;
 }
@@ -80,6 +130,7 @@ ssize_t DoubleBuffer::peek(UserOrKernelBuffer& data, size_t size)
     if (!size || m_storage.is_null())
         return 0;
     Locker locker(m_lock);
+    bool had_no_space = m_space_for_writing == 0;
     if (m_read_buffer_index >= m_read_buffer->size && m_write_buffer->size != 0) {
         flip();
     }
@@ -89,7 +140,7 @@ ssize_t DoubleBuffer::peek(UserOrKernelBuffer& data, size_t size)
     if (!data.write(m_read_buffer->data + m_read_buffer_index, nread))
         return -EFAULT;
     compute_lockfree_metadata();
-    if (m_unblock_callback && m_space_for_writing > 0)
+    if (m_unblock_callback && had_no_space && m_space_for_writing > 0)
         m_unblock_callback();
     return (ssize_t)nread;
 }
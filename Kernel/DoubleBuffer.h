@@ -8,6 +8,7 @@
 
 #include <AK/Types.h>
 #include <Kernel/KBuffer.h>
+#include <Kernel/KResult.h>
 #include <Kernel/Lock.h>
 #include <Kernel/Thread.h>
 #include <Kernel/UserOrKernelBuffer.h>
@@ -38,6 +39,14 @@ public:
 
     bool is_empty() const { return m_empty; }
 
+    size_t capacity() const { return m_capacity; }
+    KResult set_capacity(size_t);
+
+    // Lets write() grow the buffer (doubling, up to the given cap) when a
+    // writer outruns it, instead of splitting the stream into
+    // capacity-sized blocking round trips.
+    void set_maximum_capacity(size_t maximum_capacity) { m_maximum_capacity = maximum_capacity; }
+
     size_t space_for_writing() const { return m_space_for_writing; }
 
     void set_unblock_callback(Function<void()> callback)
@@ -63,6 +72,7 @@ private:
     KBuffer m_storage;
     Function<void()> m_unblock_callback;
     size_t m_capacity { 0 };
+    size_t m_maximum_capacity { 0 };
     size_t m_read_buffer_index { 0 };
     size_t m_space_for_writing { 0 };
     bool m_empty { true };
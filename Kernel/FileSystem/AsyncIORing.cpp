@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/AsyncIORing.h>
+#include <Kernel/FileSystem/FileDescription.h>
+#include <Kernel/FileSystem/VirtualFileSystem.h>
+#include <Kernel/Process.h>
+#include <Kernel/UserOrKernelBuffer.h>
+#include <Kernel/VM/MemoryManager.h>
+
+namespace Kernel {
+
+// Everything lives in a single shared page: the header, then the submission
+// entries, then the completion entries.
+static constexpr u32 ring_sq_entry_count = 64;
+static constexpr u32 ring_cq_entry_count = 64;
+static constexpr u32 ring_sqe_array_offset = 64;
+static constexpr u32 ring_cqe_array_offset = ring_sqe_array_offset + ring_sq_entry_count * sizeof(AsyncIORingSQE);
+
+static_assert(ring_cqe_array_offset + ring_cq_entry_count * sizeof(AsyncIORingCQE) <= PAGE_SIZE);
+
+KResultOr<NonnullRefPtr<AsyncIORing>> AsyncIORing::create()
+{
+    auto vmobject = AnonymousVMObject::create_with_size(PAGE_SIZE, AllocationStrategy::Reserve);
+    if (!vmobject)
+        return ENOMEM;
+
+    auto kernel_region = MM.allocate_kernel_region_with_vmobject(*vmobject, PAGE_SIZE, "AsyncIORing", Region::Access::Read | Region::Access::Write);
+    if (!kernel_region)
+        return ENOMEM;
+
+    auto ring = adopt_ref_if_nonnull(new AsyncIORing(vmobject.release_nonnull(), kernel_region.release_nonnull()));
+    if (!ring)
+        return ENOMEM;
+    return ring.release_nonnull();
+}
+
+AsyncIORing::AsyncIORing(NonnullRefPtr<AnonymousVMObject> vmobject, NonnullOwnPtr<Region> kernel_region)
+    : m_vmobject(move(vmobject))
+    , m_kernel_region(move(kernel_region))
+{
+    auto& header = this->header();
+    header.sq_entry_count = ring_sq_entry_count;
+    header.cq_entry_count = ring_cq_entry_count;
+    header.sqe_array_offset = ring_sqe_array_offset;
+    header.cqe_array_offset = ring_cqe_array_offset;
+}
+
+AsyncIORing::~AsyncIORing()
+{
+}
+
+AsyncIORingSQE const* AsyncIORing::sqe_array() const
+{
+    return reinterpret_cast<AsyncIORingSQE const*>(m_kernel_region->vaddr().offset(ring_sqe_array_offset).as_ptr());
+}
+
+AsyncIORingCQE* AsyncIORing::cqe_array()
+{
+    return reinterpret_cast<AsyncIORingCQE*>(m_kernel_region->vaddr().offset(ring_cqe_array_offset).as_ptr());
+}
+
+bool AsyncIORing::can_read(const FileDescription&, size_t) const
+{
+    return m_cq_tail != const_cast<AsyncIORing*>(this)->header().cq_head;
+}
+
+KResultOr<Region*> AsyncIORing::mmap(Process& process, FileDescription&, const Range& range, u64 offset, int prot, bool shared)
+{
+    if (offset != 0)
+        return EINVAL;
+    if (range.size() != m_vmobject->size())
+        return EINVAL;
+    return process.space().allocate_region_with_vmobject(range, m_vmobject, offset, "AsyncIORing", prot, shared);
+}
+
+KResultOr<i64> AsyncIORing::perform_operation(Process& process, AsyncIORingSQE const& sqe)
+{
+    switch (sqe.opcode) {
+    case AsyncIORingSQE::Read:
+    case AsyncIORingSQE::Write: {
+        auto description = process.file_description(sqe.fd);
+        if (!description)
+            return EBADF;
+        bool is_read = sqe.opcode == AsyncIORingSQE::Read;
+        if (is_read ? !description->is_readable() : !description->is_writable())
+            return EBADF;
+        if (sqe.offset != async_io_ring_no_offset) {
+            if (!description->file().is_seekable())
+                return EINVAL;
+            auto seek_result = description->seek(sqe.offset, SEEK_SET);
+            if (seek_result.is_error())
+                return seek_result.error();
+        }
+        auto buffer = UserOrKernelBuffer::for_user_buffer((u8*)(FlatPtr)sqe.buffer, sqe.length);
+        if (!buffer.has_value())
+            return EFAULT;
+        auto result = is_read
+            ? description->read(buffer.value(), sqe.length)
+            : description->write(buffer.value(), sqe.length);
+        if (result.is_error())
+            return result.error();
+        return (i64)result.value();
+    }
+    case AsyncIORingSQE::Fsync:
+        // There is no per-inode sync in this VFS (yet); writing everything
+        // back is the strongest thing we can offer.
+        VFS::the().sync();
+        return 0;
+    default:
+        return EINVAL;
+    }
+}
+
+KResultOr<size_t> AsyncIORing::process_submissions(Process& process, size_t count)
+{
+    auto& header = this->header();
+    auto const* sqes = sqe_array();
+    auto* cqes = cqe_array();
+
+    size_t processed = 0;
+    while (processed < count) {
+        if (m_sq_head == header.sq_tail)
+            break;
+        // Completions are only ever overwritten after userspace has reaped
+        // them; a full completion ring pauses submission processing.
+        if (m_cq_tail - header.cq_head >= ring_cq_entry_count)
+            break;
+
+        AsyncIORingSQE sqe = sqes[m_sq_head % ring_sq_entry_count];
+        ++m_sq_head;
+        header.sq_head = m_sq_head;
+
+        auto result = perform_operation(process, sqe);
+
+        auto& cqe = cqes[m_cq_tail % ring_cq_entry_count];
+        cqe.user_data = sqe.user_data;
+        cqe.result = result.is_error() ? result.error().error() : result.value();
+        ++m_cq_tail;
+        header.cq_tail = m_cq_tail;
+
+        ++processed;
+    }
+
+    if (processed > 0)
+        evaluate_block_conditions();
+
+    return processed;
+}
+
+}
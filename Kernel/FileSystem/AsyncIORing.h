@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <Kernel/API/AsyncIORing.h>
+#include <Kernel/FileSystem/File.h>
+#include <Kernel/VM/AnonymousVMObject.h>
+#include <Kernel/VM/Region.h>
+
+namespace Kernel {
+
+class AsyncIORing final : public File {
+public:
+    static KResultOr<NonnullRefPtr<AsyncIORing>> create();
+    virtual ~AsyncIORing() override;
+
+    KResultOr<size_t> process_submissions(Process&, size_t count);
+
+    // The ring becomes readable when unreaped completions are pending, so it
+    // can sit in a select() set like any other file descriptor.
+    virtual bool can_read(const FileDescription&, size_t) const override;
+    virtual bool can_write(const FileDescription&, size_t) const override { return false; }
+    virtual KResultOr<size_t> read(FileDescription&, u64, UserOrKernelBuffer&, size_t) override { return ENOTSUP; }
+    virtual KResultOr<size_t> write(FileDescription&, u64, const UserOrKernelBuffer&, size_t) override { return ENOTSUP; }
+    virtual KResultOr<Region*> mmap(Process&, FileDescription&, const Range&, u64 offset, int prot, bool shared) override;
+
+    virtual String absolute_path(const FileDescription&) const override { return ":async-io-ring:"; }
+    virtual const char* class_name() const override { return "AsyncIORing"; }
+    virtual bool is_async_io_ring() const override { return true; }
+
+private:
+    AsyncIORing(NonnullRefPtr<AnonymousVMObject>, NonnullOwnPtr<Region> kernel_region);
+
+    AsyncIORingHeader& header() { return *reinterpret_cast<AsyncIORingHeader*>(m_kernel_region->vaddr().as_ptr()); }
+    AsyncIORingSQE const* sqe_array() const;
+    AsyncIORingCQE* cqe_array();
+
+    KResultOr<i64> perform_operation(Process&, AsyncIORingSQE const&);
+
+    NonnullRefPtr<AnonymousVMObject> m_vmobject;
+    NonnullOwnPtr<Region> m_kernel_region;
+
+    // The kernel-side ring positions are authoritative; the copies in the
+    // shared header exist only so userspace can observe progress, and are
+    // never trusted when read back.
+    u32 m_sq_head { 0 };
+    u32 m_cq_tail { 0 };
+};
+
+}
@@ -5,9 +5,11 @@
  */
 
 #include <AK/IntrusiveList.h>
+#include <AK/QuickSort.h>
 #include <Kernel/Debug.h>
 #include <Kernel/FileSystem/BlockBasedFileSystem.h>
 #include <Kernel/Process.h>
+#include <Kernel/Time/TimeManagement.h>
 
 namespace Kernel {
 
@@ -16,6 +18,9 @@ struct CacheEntry {
     BlockBasedFS::BlockIndex block_index { 0 };
     u8* data { nullptr };
     bool has_data { false };
+    bool is_dirty { false };
+    // Monotonic time (in seconds) when this entry was first dirtied.
+    u64 dirtied_at { 0 };
 };
 
 class DiskCache {
@@ -33,24 +38,27 @@ public:
 
     ~DiskCache() = default;
 
-    bool is_dirty() const { return m_dirty; }
-    void set_dirty(bool b) { m_dirty = b; }
-
-    void mark_all_clean()
-    {
-        while (auto* entry = m_dirty_list.first())
-            m_clean_list.prepend(*entry);
-        m_dirty = false;
-    }
+    bool is_dirty() const { return m_dirty_count > 0; }
+    size_t dirty_count() const { return m_dirty_count; }
+    size_t entry_count() const { return m_entry_count; }
 
     void mark_dirty(CacheEntry& entry)
     {
+        if (!entry.is_dirty) {
+            entry.is_dirty = true;
+            entry.dirtied_at = TimeManagement::the().monotonic_time().to_truncated_seconds();
+            ++m_dirty_count;
+        }
         m_dirty_list.prepend(entry);
-        m_dirty = true;
     }
 
     void mark_clean(CacheEntry& entry)
     {
+        if (entry.is_dirty) {
+            entry.is_dirty = false;
+            VERIFY(m_dirty_count > 0);
+            --m_dirty_count;
+        }
         m_clean_list.prepend(entry);
     }
 
@@ -101,7 +109,7 @@ private:
     mutable IntrusiveList<CacheEntry, RawPtr<CacheEntry>, &CacheEntry::list_node> m_dirty_list;
     KBuffer m_cached_block_data;
     KBuffer m_entries;
-    bool m_dirty { false };
+    size_t m_dirty_count { 0 };
 };
 
 BlockBasedFS::BlockBasedFS(FileDescription& file_description)
@@ -110,6 +118,33 @@ BlockBasedFS::BlockBasedFS(FileDescription& file_description)
     VERIFY(file_description.file().is_seekable());
 }
 
+static size_t latency_bucket_index(const Time& duration)
+{
+    auto microseconds = duration.to_microseconds();
+    size_t bucket = 0;
+    while (microseconds > 1 && bucket < BlockBasedFS::IOStatistics::latency_bucket_count - 1) {
+        microseconds >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+void BlockBasedFS::did_read_from_device(size_t bytes, const Time& start) const
+{
+    auto duration = TimeManagement::the().monotonic_time(TimePrecision::Precise) - start;
+    ++m_io_statistics.read_ops;
+    m_io_statistics.bytes_read += bytes;
+    ++m_io_statistics.read_latency_buckets[latency_bucket_index(duration)];
+}
+
+void BlockBasedFS::did_write_to_device(size_t bytes, const Time& start) const
+{
+    auto duration = TimeManagement::the().monotonic_time(TimePrecision::Precise) - start;
+    ++m_io_statistics.write_ops;
+    m_io_statistics.bytes_written += bytes;
+    ++m_io_statistics.write_latency_buckets[latency_bucket_index(duration)];
+}
+
 BlockBasedFS::~BlockBasedFS()
 {
 }
@@ -127,10 +162,12 @@ KResult BlockBasedFS::write_block(BlockIndex index, const UserOrKernelBuffer& da
         auto seek_result = file_description().seek(base_offset, SEEK_SET);
         if (seek_result.is_error())
             return seek_result.error();
+        auto io_start = TimeManagement::the().monotonic_time(TimePrecision::Precise);
         auto nwritten = file_description().write(data, count);
         if (nwritten.is_error())
             return nwritten.error();
         VERIFY(nwritten.value() == count);
+        did_write_to_device(count, io_start);
         return KSuccess;
     }
 
@@ -155,9 +192,11 @@ bool BlockBasedFS::raw_read(BlockIndex index, UserOrKernelBuffer& buffer)
     u32 base_offset = index.value() * m_logical_block_size;
     auto seek_result = file_description().seek(base_offset, SEEK_SET);
     VERIFY(!seek_result.is_error());
+    auto io_start = TimeManagement::the().monotonic_time(TimePrecision::Precise);
     auto nread = file_description().read(buffer, m_logical_block_size);
     VERIFY(!nread.is_error());
     VERIFY(nread.value() == m_logical_block_size);
+    did_read_from_device(m_logical_block_size, io_start);
     return true;
 }
 
@@ -167,9 +206,11 @@ bool BlockBasedFS::raw_write(BlockIndex index, const UserOrKernelBuffer& buffer)
     size_t base_offset = index.value() * m_logical_block_size;
     auto seek_result = file_description().seek(base_offset, SEEK_SET);
     VERIFY(!seek_result.is_error());
+    auto io_start = TimeManagement::the().monotonic_time(TimePrecision::Precise);
     auto nwritten = file_description().write(buffer, m_logical_block_size);
     VERIFY(!nwritten.is_error());
     VERIFY(nwritten.value() == m_logical_block_size);
+    did_write_to_device(m_logical_block_size, io_start);
     return true;
 }
 
@@ -223,31 +264,86 @@ KResult BlockBasedFS::read_block(BlockIndex index, UserOrKernelBuffer* buffer, s
         auto seek_result = file_description().seek(base_offset, SEEK_SET);
         if (seek_result.is_error())
             return seek_result.error();
+        auto io_start = TimeManagement::the().monotonic_time(TimePrecision::Precise);
         auto nread = file_description().read(*buffer, count);
         if (nread.is_error())
             return nread.error();
         VERIFY(nread.value() == count);
+        did_read_from_device(count, io_start);
         return KSuccess;
     }
 
     auto& entry = cache().get(index);
-    if (!entry.has_data) {
+    bool was_cache_miss = !entry.has_data;
+    if (was_cache_miss) {
         auto base_offset = index.value() * block_size();
         auto seek_result = file_description().seek(base_offset, SEEK_SET);
         if (seek_result.is_error())
             return seek_result.error();
         auto entry_data_buffer = UserOrKernelBuffer::for_kernel_buffer(entry.data);
+        auto io_start = TimeManagement::the().monotonic_time(TimePrecision::Precise);
         auto nread = file_description().read(entry_data_buffer, block_size());
         if (nread.is_error())
             return nread.error();
         VERIFY(nread.value() == block_size());
+        did_read_from_device(block_size(), io_start);
         entry.has_data = true;
     }
     if (buffer && !buffer->write(entry.data + offset, count))
         return EFAULT;
+
+    // If this miss continued a sequential scan, the reader will almost
+    // certainly want the following blocks too, so pull a whole window into
+    // the cache with one large read.
+    // NOTE: Read-ahead evicts cache entries and may re-key the one we just
+    //       used, so it must not run until we're done with `entry`.
+    if (was_cache_miss && index.value() == m_last_read_block.value() + 1)
+        populate_read_ahead_window(BlockIndex { index.value() + 1 });
+    m_last_read_block = index;
     return KSuccess;
 }
 
+KBuffer& BlockBasedFS::cluster_io_buffer() const
+{
+    if (!m_cluster_io_buffer)
+        m_cluster_io_buffer = make<KBuffer>(KBuffer::create_with_size(max_io_cluster_blocks * block_size()));
+    return *m_cluster_io_buffer;
+}
+
+KBuffer& BlockBasedFS::read_ahead_buffer() const
+{
+    if (!m_read_ahead_buffer)
+        m_read_ahead_buffer = make<KBuffer>(KBuffer::create_with_size(read_ahead_window_blocks * block_size()));
+    return *m_read_ahead_buffer;
+}
+
+void BlockBasedFS::populate_read_ahead_window(BlockIndex first_block) const
+{
+    // NOTE: This must not share cluster_io_buffer(): the cache().get() below
+    //       can trigger a flush, and flush_entries() stages its write
+    //       clusters in that buffer while we're still copying out of ours.
+    auto& window = read_ahead_buffer();
+    auto base_offset = first_block.value() * block_size();
+    auto seek_result = file_description().seek(base_offset, SEEK_SET);
+    if (seek_result.is_error())
+        return;
+    auto window_buffer = UserOrKernelBuffer::for_kernel_buffer(window.data());
+    auto io_start = TimeManagement::the().monotonic_time(TimePrecision::Precise);
+    auto nread = file_description().read(window_buffer, read_ahead_window_blocks * block_size());
+    if (nread.is_error())
+        return;
+    did_read_from_device(nread.value(), io_start);
+    // A short read just means we ran into the end of the device.
+    size_t blocks_read = nread.value() / block_size();
+    for (size_t i = 0; i < blocks_read; ++i) {
+        auto& entry = cache().get(BlockIndex { first_block.value() + i });
+        if (entry.has_data)
+            continue;
+        memcpy(entry.data, window.data() + i * block_size(), block_size());
+        entry.has_data = true;
+    }
+}
+
 KResult BlockBasedFS::read_blocks(BlockIndex index, unsigned count, UserOrKernelBuffer& buffer, bool allow_cache) const
 {
     Locker locker(m_lock);
@@ -280,7 +376,9 @@ void BlockBasedFS::flush_specific_block_if_needed(BlockIndex index)
             VERIFY(!seek_result.is_error());
             // FIXME: Should this error path be surfaced somehow?
             auto entry_data_buffer = UserOrKernelBuffer::for_kernel_buffer(entry.data);
+            auto io_start = TimeManagement::the().monotonic_time(TimePrecision::Precise);
             [[maybe_unused]] auto rc = file_description().write(entry_data_buffer, block_size());
+            did_write_to_device(block_size(), io_start);
             cleaned_entries.append(&entry);
         }
     });
@@ -290,23 +388,54 @@ void BlockBasedFS::flush_specific_block_if_needed(BlockIndex index)
         cache().mark_clean(*entry);
 }
 
+void BlockBasedFS::flush_entries(Vector<CacheEntry*>& dirty_entries)
+{
+    // Cluster adjacent dirty blocks so the device sees a few large
+    // sequential writes instead of one request per block.
+    quick_sort(dirty_entries, [](auto* a, auto* b) { return a->block_index < b->block_index; });
+
+    u32 count = 0;
+    u32 cluster_count = 0;
+    size_t i = 0;
+    while (i < dirty_entries.size()) {
+        size_t run_length = 1;
+        while (i + run_length < dirty_entries.size()
+            && run_length < max_io_cluster_blocks
+            && dirty_entries[i + run_length]->block_index.value() == dirty_entries[i]->block_index.value() + run_length)
+            ++run_length;
+
+        auto& cluster = cluster_io_buffer();
+        for (size_t j = 0; j < run_length; ++j)
+            memcpy(cluster.data() + j * block_size(), dirty_entries[i + j]->data, block_size());
+
+        size_t base_offset = dirty_entries[i]->block_index.value() * block_size();
+        auto seek_result = file_description().seek(base_offset, SEEK_SET);
+        VERIFY(!seek_result.is_error());
+        // FIXME: Should this error path be surfaced somehow?
+        auto cluster_buffer = UserOrKernelBuffer::for_kernel_buffer(cluster.data());
+        auto io_start = TimeManagement::the().monotonic_time(TimePrecision::Precise);
+        [[maybe_unused]] auto rc = file_description().write(cluster_buffer, run_length * block_size());
+        did_write_to_device(run_length * block_size(), io_start);
+
+        count += run_length;
+        ++cluster_count;
+        i += run_length;
+    }
+    for (auto* entry : dirty_entries)
+        cache().mark_clean(*entry);
+    dbgln("{}: Flushed {} blocks to disk in {} clusters", class_name(), count, cluster_count);
+}
+
 void BlockBasedFS::flush_writes_impl()
 {
     Locker locker(m_lock);
     if (!cache().is_dirty())
         return;
-    u32 count = 0;
+    Vector<CacheEntry*> dirty_entries;
     cache().for_each_dirty_entry([&](CacheEntry& entry) {
-        u32 base_offset = entry.block_index.value() * block_size();
-        auto seek_result = file_description().seek(base_offset, SEEK_SET);
-        VERIFY(!seek_result.is_error());
-        // FIXME: Should this error path be surfaced somehow?
-        auto entry_data_buffer = UserOrKernelBuffer::for_kernel_buffer(entry.data);
-        [[maybe_unused]] auto rc = file_description().write(entry_data_buffer, block_size());
-        ++count;
+        dirty_entries.append(&entry);
     });
-    cache().mark_all_clean();
-    dbgln("{}: Flushed {} blocks to disk", class_name(), count);
+    flush_entries(dirty_entries);
 }
 
 void BlockBasedFS::flush_writes()
@@ -314,6 +443,33 @@ void BlockBasedFS::flush_writes()
     flush_writes_impl();
 }
 
+void BlockBasedFS::trickle_flush_writes()
+{
+    Locker locker(m_lock);
+    if (!cache().is_dirty())
+        return;
+
+    // If a sizable part of the cache has gone dirty, trickling would only
+    // fall behind; flush everything as one batch.
+    if (cache().dirty_count() * 4 >= cache().entry_count()) {
+        flush_writes_impl();
+        return;
+    }
+
+    // Otherwise only write back blocks that have been dirty for a while, so
+    // bursty writers coalesce their rewrites in the cache instead of hitting
+    // the device over and over.
+    u64 now = TimeManagement::the().monotonic_time().to_truncated_seconds();
+    Vector<CacheEntry*> old_entries;
+    cache().for_each_dirty_entry([&](CacheEntry& entry) {
+        if (now - entry.dirtied_at >= max_dirty_block_age_seconds)
+            old_entries.append(&entry);
+    });
+    if (old_entries.is_empty())
+        return;
+    flush_entries(old_entries);
+}
+
 DiskCache& BlockBasedFS::cache() const
 {
     if (!m_cache)
@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <AK/Time.h>
 #include <Kernel/FileSystem/FileBackedFileSystem.h>
+#include <Kernel/KBuffer.h>
 
 namespace Kernel {
 
@@ -18,9 +20,28 @@ public:
 
     size_t logical_block_size() const { return m_logical_block_size; };
 
+    virtual bool is_block_based() const override { return true; }
+
     virtual void flush_writes() override;
+    virtual void trickle_flush_writes() override;
     void flush_writes_impl();
 
+    // I/O accounting for this filesystem instance. Only actual device I/O is
+    // counted; cache hits never show up here. Latencies are kept as
+    // power-of-two microsecond histograms: bucket N counts operations that
+    // took [2^N, 2^(N+1)) microseconds, with the last bucket absorbing
+    // everything slower (>= ~32ms).
+    struct IOStatistics {
+        static constexpr size_t latency_bucket_count = 16;
+        u64 read_ops { 0 };
+        u64 write_ops { 0 };
+        u64 bytes_read { 0 };
+        u64 bytes_written { 0 };
+        u64 read_latency_buckets[latency_bucket_count] {};
+        u64 write_latency_buckets[latency_bucket_count] {};
+    };
+    const IOStatistics& io_statistics() const { return m_io_statistics; }
+
 protected:
     explicit BlockBasedFS(FileDescription&);
 
@@ -39,10 +60,30 @@ protected:
     size_t m_logical_block_size { 512 };
 
 private:
+    // Number of blocks we pull into the cache when a sequential scan is detected.
+    static constexpr size_t read_ahead_window_blocks = 8;
+    // Upper bound on how many adjacent dirty blocks we cluster into one write.
+    static constexpr size_t max_io_cluster_blocks = 32;
+    // How long a block may sit dirty in the cache before the trickle flush
+    // writes it back.
+    static constexpr u64 max_dirty_block_age_seconds = 5;
+
     DiskCache& cache() const;
+    void flush_entries(Vector<CacheEntry*>&);
     void flush_specific_block_if_needed(BlockIndex index);
 
+    KBuffer& cluster_io_buffer() const;
+    KBuffer& read_ahead_buffer() const;
+    void populate_read_ahead_window(BlockIndex first_block) const;
+
+    void did_read_from_device(size_t bytes, const Time& start) const;
+    void did_write_to_device(size_t bytes, const Time& start) const;
+
     mutable OwnPtr<DiskCache> m_cache;
+    mutable OwnPtr<KBuffer> m_cluster_io_buffer;
+    mutable OwnPtr<KBuffer> m_read_ahead_buffer;
+    mutable BlockIndex m_last_read_block { 0 };
+    mutable IOStatistics m_io_statistics;
 };
 
 }
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/EventQueue.h>
+#include <Kernel/FileSystem/FileDescription.h>
+#include <Kernel/Process.h>
+
+namespace Kernel {
+
+using BlockFlags = Thread::FileBlocker::BlockFlags;
+
+static BlockFlags block_flags_for_events(u32 events)
+{
+    auto block_flags = BlockFlags::None;
+    if (events & EVENT_QUEUE_EVENT_READ)
+        block_flags |= BlockFlags::Read;
+    if (events & EVENT_QUEUE_EVENT_WRITE)
+        block_flags |= BlockFlags::Write;
+    if (events & EVENT_QUEUE_EVENT_EXCEPTION)
+        block_flags |= BlockFlags::Exception;
+    return block_flags;
+}
+
+KResultOr<NonnullRefPtr<EventQueue>> EventQueue::create()
+{
+    auto queue = adopt_ref_if_nonnull(new EventQueue);
+    if (!queue)
+        return ENOMEM;
+    return queue.release_nonnull();
+}
+
+EventQueue::~EventQueue()
+{
+}
+
+KResult EventQueue::add(int fd, NonnullRefPtr<FileDescription> description, u32 events)
+{
+    if (!events)
+        return EINVAL;
+    Locker locker(m_lock);
+    if (m_interests.contains(fd))
+        return EEXIST;
+    m_interests.set(fd, { move(description), events });
+    return KSuccess;
+}
+
+KResult EventQueue::modify(int fd, u32 events)
+{
+    if (!events)
+        return EINVAL;
+    Locker locker(m_lock);
+    auto it = m_interests.find(fd);
+    if (it == m_interests.end())
+        return ENOENT;
+    it->value.events = events;
+    return KSuccess;
+}
+
+KResult EventQueue::remove(int fd)
+{
+    Locker locker(m_lock);
+    auto it = m_interests.find(fd);
+    if (it == m_interests.end())
+        return ENOENT;
+    m_interests.remove(it);
+    return KSuccess;
+}
+
+bool EventQueue::can_read(const FileDescription&, size_t) const
+{
+    Locker locker(m_lock);
+    for (auto& it : m_interests) {
+        if ((it.value.events & EVENT_QUEUE_EVENT_READ) && it.value.description->can_read())
+            return true;
+        if ((it.value.events & EVENT_QUEUE_EVENT_WRITE) && it.value.description->can_write())
+            return true;
+    }
+    return false;
+}
+
+KResultOr<int> EventQueue::wait(EventQueueEvent* user_events, int max_events, const Thread::BlockTimeout& timeout)
+{
+    // Snapshot the interest list; ctl() calls from other threads during the
+    // wait take effect on the next wait.
+    Thread::SelectBlocker::FDVector fds_info;
+    Vector<int, FD_SETSIZE> fds;
+    {
+        Locker locker(m_lock);
+        for (auto& it : m_interests) {
+            if (!fds_info.try_append({ it.value.description, block_flags_for_events(it.value.events), BlockFlags::None }))
+                return ENOMEM;
+            if (!fds.try_append(it.key))
+                return ENOMEM;
+        }
+    }
+
+    if (Thread::current()->block<Thread::SelectBlocker>(timeout, fds_info).was_interrupted())
+        return EINTR;
+
+    int event_count = 0;
+    for (size_t i = 0; i < fds_info.size(); ++i) {
+        if (event_count >= max_events)
+            break;
+        auto& fd_entry = fds_info[i];
+        if (fd_entry.unblocked_flags == BlockFlags::None)
+            continue;
+
+        EventQueueEvent event;
+        event.fd = fds[i];
+        if (has_flag(fd_entry.unblocked_flags, BlockFlags::Read))
+            event.events |= EVENT_QUEUE_EVENT_READ;
+        if (has_flag(fd_entry.unblocked_flags, BlockFlags::Write))
+            event.events |= EVENT_QUEUE_EVENT_WRITE;
+        if (has_flag(fd_entry.unblocked_flags, BlockFlags::Exception))
+            event.events |= EVENT_QUEUE_EVENT_EXCEPTION;
+
+        if (!copy_to_user(user_events + event_count, &event))
+            return EFAULT;
+        ++event_count;
+    }
+
+    return event_count;
+}
+
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/NonnullRefPtr.h>
+#include <Kernel/API/EventQueue.h>
+#include <Kernel/FileSystem/File.h>
+#include <Kernel/Thread.h>
+
+namespace Kernel {
+
+// A stateful set of file descriptors to wait on: the interest list is
+// registered once with event_queue_ctl() and then event_queue_wait() can be
+// called over and over without re-submitting it, unlike select()/poll()
+// which re-copy and re-validate every descriptor on every call.
+class EventQueue final : public File {
+public:
+    static KResultOr<NonnullRefPtr<EventQueue>> create();
+    virtual ~EventQueue() override;
+
+    KResult add(int fd, NonnullRefPtr<FileDescription>, u32 events);
+    KResult modify(int fd, u32 events);
+    KResult remove(int fd);
+
+    KResultOr<int> wait(EventQueueEvent* user_events, int max_events, const Thread::BlockTimeout&);
+
+    // An event queue is itself selectable, so queues can nest.
+    virtual bool can_read(const FileDescription&, size_t) const override;
+    virtual bool can_write(const FileDescription&, size_t) const override { return false; }
+    virtual KResultOr<size_t> read(FileDescription&, u64, UserOrKernelBuffer&, size_t) override { return ENOTSUP; }
+    virtual KResultOr<size_t> write(FileDescription&, u64, const UserOrKernelBuffer&, size_t) override { return ENOTSUP; }
+
+    virtual String absolute_path(const FileDescription&) const override { return ":event-queue:"; }
+    virtual const char* class_name() const override { return "EventQueue"; }
+    virtual bool is_event_queue() const override { return true; }
+
+private:
+    EventQueue() { }
+
+    struct Interest {
+        NonnullRefPtr<FileDescription> description;
+        u32 events { 0 };
+    };
+
+    mutable Lock m_lock;
+    HashMap<int, Interest> m_interests;
+};
+
+}
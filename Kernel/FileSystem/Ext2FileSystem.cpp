@@ -54,6 +54,196 @@ static unsigned divide_rounded_up(unsigned a, unsigned b)
     return (a / b) + (a % b != 0);
 }
 
+// Hashed directory index ("htree") support, read side only.
+//
+// Directories with EXT2_INDEX_FL set carry a hash tree built by mke2fs or
+// e2fsck: logical block 0 holds a root whose entry table maps hash ranges to
+// leaf blocks (optionally via one level of intermediate nodes), and each leaf
+// is a classic linear directory block. We only ever read the index; rewriting
+// a directory turns it back into a plain linear directory and clears the flag.
+
+struct [[gnu::packed]] ext2_dx_root_info {
+    u32 reserved_zero;
+    u8 hash_version;
+    u8 info_length;
+    u8 indirect_levels;
+    u8 unused_flags;
+};
+
+struct [[gnu::packed]] ext2_dx_entry {
+    u32 hash;
+    u32 block;
+};
+
+enum class DirectoryHashVersion : u8 {
+    Legacy = 0,
+    HalfMD4 = 1,
+    Tea = 2,
+    LegacyUnsigned = 3,
+    HalfMD4Unsigned = 4,
+    TeaUnsigned = 5,
+};
+
+// Names hash to even values; odd values mark hash-collision continuations
+// in the index, and the highest even value is reserved as an end marker.
+static constexpr u32 directory_hash_collision_bit = 1;
+static constexpr u32 directory_hash_end_marker = 0xfffffffe;
+
+template<typename CharType>
+static u32 legacy_directory_hash(const char* name, size_t length)
+{
+    u32 hash0 = 0x12a3fe2d;
+    u32 hash1 = 0x37abe8f9;
+    for (size_t i = 0; i < length; ++i) {
+        u32 hash = hash1 + (hash0 ^ (static_cast<u32>(static_cast<i32>(static_cast<CharType>(name[i]))) * 7152373u));
+        if (hash & 0x80000000)
+            hash -= 0x7fffffff;
+        hash1 = hash0;
+        hash0 = hash;
+    }
+    return hash0 << 1;
+}
+
+// Packs up to buffer_words * 4 name bytes into 32-bit words, padding with a
+// value derived from the name length. CharType determines whether bytes with
+// the high bit set are sign-extended, matching the signed/unsigned variants
+// of the on-disk hash.
+template<typename CharType>
+static void pack_name_for_directory_hash(const char* name, size_t length, u32* buffer, size_t buffer_words)
+{
+    u32 pad = static_cast<u32>(length) | (static_cast<u32>(length) << 8);
+    pad |= pad << 16;
+
+    if (length > buffer_words * sizeof(u32))
+        length = buffer_words * sizeof(u32);
+
+    u32 value = pad;
+    for (size_t i = 0; i < length; ++i) {
+        value = static_cast<u32>(static_cast<i32>(static_cast<CharType>(name[i]))) + (value << 8);
+        if (i % 4 == 3) {
+            *buffer++ = value;
+            value = pad;
+            --buffer_words;
+        }
+    }
+    if (buffer_words > 0) {
+        *buffer++ = value;
+        --buffer_words;
+    }
+    while (buffer_words > 0) {
+        *buffer++ = pad;
+        --buffer_words;
+    }
+}
+
+static void tea_transform(u32 buffer[4], const u32 in[4])
+{
+    u32 sum = 0;
+    u32 b0 = buffer[0];
+    u32 b1 = buffer[1];
+    for (int round = 0; round < 16; ++round) {
+        sum += 0x9e3779b9;
+        b0 += ((b1 << 4) + in[0]) ^ (b1 + sum) ^ ((b1 >> 5) + in[1]);
+        b1 += ((b0 << 4) + in[2]) ^ (b0 + sum) ^ ((b0 >> 5) + in[3]);
+    }
+    buffer[0] += b0;
+    buffer[1] += b1;
+}
+
+static void half_md4_transform(u32 buffer[4], const u32 in[8])
+{
+    static constexpr u32 k2 = 0x5a827999;
+    static constexpr u32 k3 = 0x6ed9eba1;
+
+    u32 a = buffer[0];
+    u32 b = buffer[1];
+    u32 c = buffer[2];
+    u32 d = buffer[3];
+
+    auto rotate_left = [](u32 value, int count) { return (value << count) | (value >> (32 - count)); };
+    auto f = [](u32 x, u32 y, u32 z) { return z ^ (x & (y ^ z)); };
+    auto g = [](u32 x, u32 y, u32 z) { return (x & y) + ((x ^ y) & z); };
+    auto h = [](u32 x, u32 y, u32 z) { return x ^ y ^ z; };
+
+    // Round 1
+    a = rotate_left(a + f(b, c, d) + in[0], 3);
+    d = rotate_left(d + f(a, b, c) + in[1], 7);
+    c = rotate_left(c + f(d, a, b) + in[2], 11);
+    b = rotate_left(b + f(c, d, a) + in[3], 19);
+    // Round 2
+    a = rotate_left(a + g(b, c, d) + in[1] + k2, 3);
+    d = rotate_left(d + g(a, b, c) + in[3] + k2, 5);
+    c = rotate_left(c + g(d, a, b) + in[5] + k2, 9);
+    b = rotate_left(b + g(c, d, a) + in[7] + k2, 13);
+    // Round 3
+    a = rotate_left(a + h(b, c, d) + in[3] + k3, 3);
+    d = rotate_left(d + h(a, b, c) + in[5] + k3, 9);
+    c = rotate_left(c + h(d, a, b) + in[7] + k3, 11);
+    b = rotate_left(b + h(c, d, a) + in[1] + k3, 15);
+
+    buffer[0] += a;
+    buffer[1] += b;
+    buffer[2] += c;
+    buffer[3] += d;
+}
+
+static Optional<u32> compute_directory_entry_hash(DirectoryHashVersion version, const u32 seed[4], const StringView& name)
+{
+    u32 buffer[4] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476 };
+    if (seed[0] || seed[1] || seed[2] || seed[3])
+        memcpy(buffer, seed, sizeof(buffer));
+
+    const char* characters = name.characters_without_null_termination();
+    ssize_t length = name.length();
+    u32 hash = 0;
+
+    switch (version) {
+    case DirectoryHashVersion::Legacy:
+        hash = legacy_directory_hash<signed char>(characters, length);
+        break;
+    case DirectoryHashVersion::LegacyUnsigned:
+        hash = legacy_directory_hash<unsigned char>(characters, length);
+        break;
+    case DirectoryHashVersion::HalfMD4:
+    case DirectoryHashVersion::HalfMD4Unsigned: {
+        u32 in[8];
+        while (length > 0) {
+            if (version == DirectoryHashVersion::HalfMD4)
+                pack_name_for_directory_hash<signed char>(characters, length, in, 8);
+            else
+                pack_name_for_directory_hash<unsigned char>(characters, length, in, 8);
+            half_md4_transform(buffer, in);
+            characters += 32;
+            length -= 32;
+        }
+        hash = buffer[1];
+        break;
+    }
+    case DirectoryHashVersion::Tea:
+    case DirectoryHashVersion::TeaUnsigned: {
+        u32 in[4];
+        while (length > 0) {
+            if (version == DirectoryHashVersion::Tea)
+                pack_name_for_directory_hash<signed char>(characters, length, in, 4);
+            else
+                pack_name_for_directory_hash<unsigned char>(characters, length, in, 4);
+            tea_transform(buffer, in);
+            characters += 16;
+            length -= 16;
+        }
+        hash = buffer[0];
+        break;
+    }
+    default:
+        return {};
+    }
+
+    hash &= ~directory_hash_collision_bit;
+    if (hash == directory_hash_end_marker)
+        hash = directory_hash_end_marker - 2;
+    return hash;
+}
+
 NonnullRefPtr<Ext2FS> Ext2FS::create(FileDescription& file_description)
 {
     return adopt_ref(*new Ext2FS(file_description));
@@ -406,7 +596,7 @@ KResult Ext2FSInode::flush_block_list()
 
     Vector<Ext2FS::BlockIndex> new_meta_blocks;
     if (new_shape.meta_blocks > old_shape.meta_blocks) {
-        auto blocks_or_error = fs().allocate_blocks(fs().group_index_from_inode(index()), new_shape.meta_blocks - old_shape.meta_blocks);
+        auto blocks_or_error = fs().allocate_blocks(fs().group_index_from_inode(index()), new_shape.meta_blocks - old_shape.meta_blocks, m_block_list.last());
         if (blocks_or_error.is_error())
             return blocks_or_error.error();
         new_meta_blocks = blocks_or_error.release_value();
@@ -642,6 +832,67 @@ Vector<Ext2FS::BlockIndex> Ext2FSInode::compute_block_list_impl_internal(const e
     return list;
 }
 
+void Ext2FSInode::rebuild_block_runs(const Vector<BlockBasedFS::BlockIndex>& block_list) const
+{
+    m_block_runs.clear_with_capacity();
+    m_block_run_cursor = 0;
+    for (size_t i = 0; i < block_list.size(); ++i) {
+        auto block = block_list[i];
+        if (!m_block_runs.is_empty()) {
+            auto& last_run = m_block_runs.last();
+            bool last_run_is_hole = last_run.physical_start.value() == 0;
+            if (block.value() == 0 && last_run_is_hole) {
+                ++last_run.block_count;
+                continue;
+            }
+            if (block.value() != 0 && !last_run_is_hole && block.value() == last_run.physical_start.value() + last_run.block_count) {
+                ++last_run.block_count;
+                continue;
+            }
+        }
+        m_block_runs.append({ BlockBasedFS::BlockIndex { i }, block, 1 });
+    }
+}
+
+void Ext2FSInode::ensure_block_runs() const
+{
+    if (!m_block_runs.is_empty())
+        return;
+    if (!m_block_list.is_empty()) {
+        rebuild_block_runs(m_block_list);
+        return;
+    }
+    // Compress the freshly traversed list right away instead of keeping one
+    // Vector entry per block resident; read-mostly inodes only ever hold
+    // the run list.
+    rebuild_block_runs(compute_block_list());
+}
+
+size_t Ext2FSInode::cached_logical_block_count() const
+{
+    if (m_block_runs.is_empty())
+        return 0;
+    auto& last_run = m_block_runs.last();
+    return last_run.logical_start.value() + last_run.block_count;
+}
+
+BlockBasedFS::BlockIndex Ext2FSInode::block_from_logical_index(BlockBasedFS::BlockIndex logical_index) const
+{
+    VERIFY(!m_block_runs.is_empty());
+    // Sequential access stays in (or steps to) the run under the cursor;
+    // seeking backwards rescans from the first run.
+    if (m_block_run_cursor >= m_block_runs.size() || m_block_runs[m_block_run_cursor].logical_start.value() > logical_index.value())
+        m_block_run_cursor = 0;
+    while (m_block_run_cursor + 1 < m_block_runs.size() && m_block_runs[m_block_run_cursor + 1].logical_start.value() <= logical_index.value())
+        ++m_block_run_cursor;
+    auto& run = m_block_runs[m_block_run_cursor];
+    VERIFY(logical_index.value() >= run.logical_start.value());
+    auto offset_in_run = logical_index.value() - run.logical_start.value();
+    if (offset_in_run >= run.block_count || run.physical_start.value() == 0)
+        return BlockBasedFS::BlockIndex { 0 };
+    return BlockBasedFS::BlockIndex { run.physical_start.value() + offset_in_run };
+}
+
 void Ext2FS::free_inode(Ext2FSInode& inode)
 {
     Locker locker(m_lock);
@@ -712,16 +963,30 @@ void Ext2FS::flush_writes()
 
     // Uncache Inodes that are only kept alive by the index-to-inode lookup cache.
     // We don't uncache Inodes that are being watched by at least one InodeWatcher.
-
-    // FIXME: It would be better to keep a capped number of Inodes around.
-    //        The problem is that they are quite heavy objects, and use a lot of heap memory
-    //        for their (child name lookup) and (block list) caches.
+    // Negative lookup entries are always dropped; they're cheap to rebuild and
+    // would otherwise accumulate without bound.
+
+    // We keep a capped number of unused Inodes around anyway: re-instantiating
+    // one means re-reading the inode table, and they're quite likely to be
+    // looked up again soon. The cap is small because they are heavy objects,
+    // using a lot of heap memory for their (child name lookup) and (block
+    // list) caches.
+    static constexpr size_t max_cached_unused_inodes = 64;
     Vector<InodeIndex> unused_inodes;
+    size_t retained_unused_inodes = 0;
     for (auto& it : m_inode_cache) {
+        if (!it.value) {
+            unused_inodes.append(it.key);
+            continue;
+        }
         if (it.value->ref_count() != 1)
             continue;
         if (it.value->has_watchers())
             continue;
+        if (retained_unused_inodes < max_cached_unused_inodes) {
+            ++retained_unused_inodes;
+            continue;
+        }
         unused_inodes.append(it.key);
     }
     for (auto index : unused_inodes)
@@ -749,6 +1014,8 @@ u64 Ext2FSInode::size() const
 InodeMetadata Ext2FSInode::metadata() const
 {
     Locker locker(m_lock);
+    if (m_cached_metadata.has_value())
+        return m_cached_metadata.value();
     InodeMetadata metadata;
     metadata.inode = identifier();
     metadata.size = size();
@@ -770,9 +1037,18 @@ InodeMetadata Ext2FSInode::metadata() const
         metadata.major_device = (dev & 0xfff00) >> 8;
         metadata.minor_device = (dev & 0xff) | ((dev >> 12) & 0xfff00);
     }
+    // Only cache while the inode is clean; mutations don't re-trigger the
+    // did_modify_metadata() hook as long as the inode is already dirty.
+    if (!is_metadata_dirty())
+        m_cached_metadata = metadata;
     return metadata;
 }
 
+void Ext2FSInode::did_modify_metadata()
+{
+    m_cached_metadata.clear();
+}
+
 void Ext2FSInode::flush_metadata()
 {
     Locker locker(m_lock);
@@ -843,10 +1119,9 @@ KResultOr<ssize_t> Ext2FSInode::read_bytes(off_t offset, ssize_t count, UserOrKe
         return nread;
     }
 
-    if (m_block_list.is_empty())
-        m_block_list = compute_block_list();
+    ensure_block_runs();
 
-    if (m_block_list.is_empty()) {
+    if (m_block_runs.is_empty()) {
         dmesgln("Ext2FSInode[{}]::read_bytes(): Empty block list", identifier());
         return EIO;
     }
@@ -857,8 +1132,8 @@ KResultOr<ssize_t> Ext2FSInode::read_bytes(off_t offset, ssize_t count, UserOrKe
 
     BlockBasedFS::BlockIndex first_block_logical_index = offset / block_size;
     BlockBasedFS::BlockIndex last_block_logical_index = (offset + count) / block_size;
-    if (last_block_logical_index >= m_block_list.size())
-        last_block_logical_index = m_block_list.size() - 1;
+    if (last_block_logical_index >= cached_logical_block_count())
+        last_block_logical_index = cached_logical_block_count() - 1;
 
     int offset_into_first_block = offset % block_size;
 
@@ -868,7 +1143,7 @@ KResultOr<ssize_t> Ext2FSInode::read_bytes(off_t offset, ssize_t count, UserOrKe
     dbgln_if(EXT2_VERY_DEBUG, "Ext2FSInode[{}]::read_bytes(): Reading up to {} bytes, {} bytes into inode to {}", identifier(), count, offset, buffer.user_or_kernel_ptr());
 
     for (auto bi = first_block_logical_index; remaining_count && bi <= last_block_logical_index; bi = bi.value() + 1) {
-        auto block_index = m_block_list[bi.value()];
+        auto block_index = block_from_logical_index(bi);
         size_t offset_into_block = (bi == first_block_logical_index) ? offset_into_first_block : 0;
         size_t num_bytes_to_copy = min((size_t)block_size - offset_into_block, (size_t)remaining_count);
         auto buffer_offset = buffer.offset(nread);
@@ -917,7 +1192,10 @@ KResult Ext2FSInode::resize(u64 new_size)
         m_block_list = this->compute_block_list();
 
     if (blocks_needed_after > blocks_needed_before) {
-        auto blocks_or_error = fs().allocate_blocks(fs().group_index_from_inode(index()), blocks_needed_after - blocks_needed_before);
+        // Continue allocating where the file currently ends, so repeated
+        // appends grow the file as one contiguous run when possible.
+        auto goal_block = m_block_list.is_empty() ? Ext2FS::BlockIndex { 0 } : m_block_list.last();
+        auto blocks_or_error = fs().allocate_blocks(fs().group_index_from_inode(index()), blocks_needed_after - blocks_needed_before, goal_block);
         if (blocks_or_error.is_error())
             return blocks_or_error.error();
         if (!m_block_list.try_append(blocks_or_error.release_value()))
@@ -940,6 +1218,9 @@ KResult Ext2FSInode::resize(u64 new_size)
         }
     }
 
+    // The mapping changed; rebuild the run cache from the updated list.
+    rebuild_block_runs(m_block_list);
+
     if (auto result = flush_block_list(); result.is_error())
         return result;
 
@@ -1002,18 +1283,17 @@ KResultOr<ssize_t> Ext2FSInode::write_bytes(off_t offset, ssize_t count, const U
     if (auto result = resize(new_size); result.is_error())
         return result;
 
-    if (m_block_list.is_empty())
-        m_block_list = compute_block_list();
+    ensure_block_runs();
 
-    if (m_block_list.is_empty()) {
+    if (m_block_runs.is_empty()) {
         dbgln("Ext2FSInode[{}]::write_bytes(): Empty block list", identifier());
         return EIO;
     }
 
     BlockBasedFS::BlockIndex first_block_logical_index = offset / block_size;
     BlockBasedFS::BlockIndex last_block_logical_index = (offset + count) / block_size;
-    if (last_block_logical_index >= m_block_list.size())
-        last_block_logical_index = m_block_list.size() - 1;
+    if (last_block_logical_index >= cached_logical_block_count())
+        last_block_logical_index = cached_logical_block_count() - 1;
 
     size_t offset_into_first_block = offset % block_size;
 
@@ -1025,9 +1305,10 @@ KResultOr<ssize_t> Ext2FSInode::write_bytes(off_t offset, ssize_t count, const U
     for (auto bi = first_block_logical_index; remaining_count && bi <= last_block_logical_index; bi = bi.value() + 1) {
         size_t offset_into_block = (bi == first_block_logical_index) ? offset_into_first_block : 0;
         size_t num_bytes_to_copy = min((size_t)block_size - offset_into_block, (size_t)remaining_count);
-        dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]::write_bytes(): Writing block {} (offset_into_block: {})", identifier(), m_block_list[bi.value()], offset_into_block);
-        if (auto result = fs().write_block(m_block_list[bi.value()], data.offset(nwritten), num_bytes_to_copy, offset_into_block, allow_cache); result.is_error()) {
-            dbgln("Ext2FSInode[{}]::write_bytes(): Failed to write block {} (index {})", identifier(), m_block_list[bi.value()], bi);
+        auto block_index = block_from_logical_index(bi);
+        dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]::write_bytes(): Writing block {} (offset_into_block: {})", identifier(), block_index, offset_into_block);
+        if (auto result = fs().write_block(block_index, data.offset(nwritten), num_bytes_to_copy, offset_into_block, allow_cache); result.is_error()) {
+            dbgln("Ext2FSInode[{}]::write_bytes(): Failed to write block {} (index {})", identifier(), block_index, bi);
             return result;
         }
         remaining_count -= num_bytes_to_copy;
@@ -1036,7 +1317,7 @@ KResultOr<ssize_t> Ext2FSInode::write_bytes(off_t offset, ssize_t count, const U
 
     did_modify_contents();
 
-    dbgln_if(EXT2_VERY_DEBUG, "Ext2FSInode[{}]::write_bytes(): After write, i_size={}, i_blocks={} ({} blocks in list)", identifier(), size(), m_raw_inode.i_blocks, m_block_list.size());
+    dbgln_if(EXT2_VERY_DEBUG, "Ext2FSInode[{}]::write_bytes(): After write, i_size={}, i_blocks={} ({} blocks in list)", identifier(), size(), m_raw_inode.i_blocks, cached_logical_block_count());
     return nwritten;
 }
 
@@ -1159,6 +1440,9 @@ KResult Ext2FSInode::write_directory(Vector<Ext2FSDirectoryEntry>& entries)
     auto result = write_bytes(0, stream.size(), buffer, nullptr);
     if (result.is_error())
         return result.error();
+    // We've just rewritten the directory as a classic linear directory,
+    // which invalidates any on-disk hash index it used to carry.
+    m_raw_inode.i_flags &= ~EXT2_INDEX_FL;
     set_metadata_dirty(true);
     if (static_cast<size_t>(result.value()) != directory_data.size())
         return EIO;
@@ -1221,6 +1505,10 @@ KResult Ext2FSInode::remove_child(const StringView& name)
     dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]::remove_child(): Removing '{}'", identifier(), name);
     VERIFY(is_directory());
 
+    // NOTE: Lookups on hash-indexed directories don't populate the cache.
+    if (!populate_lookup_cache())
+        return EIO;
+
     auto it = m_lookup_cache.find(name);
     if (it == m_lookup_cache.end())
         return ENOENT;
@@ -1281,10 +1569,10 @@ bool Ext2FS::write_ext2_inode(InodeIndex inode, const ext2_inode& e2inode)
     return write_block(block_index, buffer, inode_size(), offset) >= 0;
 }
 
-auto Ext2FS::allocate_blocks(GroupIndex preferred_group_index, size_t count) -> KResultOr<Vector<BlockIndex>>
+auto Ext2FS::allocate_blocks(GroupIndex preferred_group_index, size_t count, BlockIndex goal_block) -> KResultOr<Vector<BlockIndex>>
 {
     Locker locker(m_lock);
-    dbgln_if(EXT2_DEBUG, "Ext2FS: allocate_blocks(preferred group: {}, count {})", preferred_group_index, count);
+    dbgln_if(EXT2_DEBUG, "Ext2FS: allocate_blocks(preferred group: {}, count {}, goal block {})", preferred_group_index, count, goal_block);
     if (count == 0)
         return Vector<BlockIndex> {};
 
@@ -1292,6 +1580,14 @@ auto Ext2FS::allocate_blocks(GroupIndex preferred_group_index, size_t count) ->
     dbgln_if(EXT2_DEBUG, "Ext2FS: allocate_blocks:");
     blocks.ensure_capacity(count);
 
+    // When the caller gave us a goal (the last block it allocated), prefer
+    // that block's group so we have a chance of continuing the same run.
+    if (goal_block) {
+        auto goal_group = group_index_from_block_index(goal_block);
+        if (group_descriptor(goal_group).bg_free_blocks_count)
+            preferred_group_index = goal_group;
+    }
+
     auto group_index = preferred_group_index;
 
     if (!group_descriptor(preferred_group_index).bg_free_blocks_count) {
@@ -1326,9 +1622,31 @@ auto Ext2FS::allocate_blocks(GroupIndex preferred_group_index, size_t count) ->
         auto block_bitmap = cached_bitmap.bitmap(blocks_in_group);
 
         BlockIndex first_block_in_group = (group_index.value() - 1) * blocks_per_group() + first_block_index().value();
+
+        Optional<size_t> first_unset_bit_index;
         size_t free_region_size = 0;
-        auto first_unset_bit_index = block_bitmap.find_longest_range_of_unset_bits(count - blocks.size(), free_region_size);
-        VERIFY(first_unset_bit_index.has_value());
+
+        // Goal-based allocation: try to continue right behind the goal block
+        // first, so consecutive allocations for a growing file end up
+        // contiguous on disk instead of first-fit scattered across the group.
+        if (goal_block && group_index_from_block_index(goal_block) == group_index) {
+            size_t goal_bit = goal_block.value() + 1 - first_block_in_group.value();
+            if (goal_bit < block_bitmap.size() && !block_bitmap.get(goal_bit)) {
+                size_t run_size = 0;
+                while (goal_bit + run_size < block_bitmap.size() && run_size < count - blocks.size() && !block_bitmap.get(goal_bit + run_size))
+                    ++run_size;
+                first_unset_bit_index = goal_bit;
+                free_region_size = run_size;
+            }
+            // Whether or not that worked, we only try it once and fall back
+            // to the regular free-region search afterwards.
+            goal_block = 0;
+        }
+
+        if (!first_unset_bit_index.has_value()) {
+            first_unset_bit_index = block_bitmap.find_longest_range_of_unset_bits(count - blocks.size(), free_region_size);
+            VERIFY(first_unset_bit_index.has_value());
+        }
         dbgln_if(EXT2_DEBUG, "Ext2FS: allocating free region of size: {} [{}]", free_region_size, group_index);
         for (size_t i = 0; i < free_region_size; ++i) {
             BlockIndex block_index = (first_unset_bit_index.value() + i) + first_block_in_group.value();
@@ -1575,7 +1893,29 @@ KResultOr<NonnullRefPtr<Inode>> Ext2FS::create_inode(Ext2FSInode& parent_inode,
     else if (is_block_device(mode))
         e2inode.i_block[1] = dev;
 
-    auto inode_id = allocate_inode();
+    // Keep regular files in the same block group as their parent directory so
+    // related data stays close together on disk. Directories are instead
+    // spread out: pick a group with an above-average amount of free inodes and
+    // the most free blocks, so the files created inside them have room to
+    // grow nearby. (This is the classic ext2 find_group_dir policy.)
+    GroupIndex preferred_group;
+    if (is_directory(mode)) {
+        auto average_free_inodes = super_block().s_free_inodes_count / m_block_group_count;
+        u32 best_free_blocks = 0;
+        for (unsigned group = 1; group <= m_block_group_count; ++group) {
+            auto& bgd = group_descriptor(group);
+            if (!bgd.bg_free_inodes_count || bgd.bg_free_inodes_count < average_free_inodes)
+                continue;
+            if (!preferred_group || bgd.bg_free_blocks_count > best_free_blocks) {
+                preferred_group = group;
+                best_free_blocks = bgd.bg_free_blocks_count;
+            }
+        }
+    } else {
+        preferred_group = group_index_from_inode(parent_inode.index());
+    }
+
+    auto inode_id = allocate_inode(preferred_group);
     if (inode_id.is_error())
         return inode_id.error();
 
@@ -1613,10 +1953,153 @@ bool Ext2FSInode::populate_lookup_cache() const
     return true;
 }
 
+bool Ext2FSInode::is_hash_indexed_directory() const
+{
+    return (fs().super_block().s_feature_compat & EXT2_FEATURE_COMPAT_DIR_INDEX)
+        && (m_raw_inode.i_flags & EXT2_INDEX_FL);
+}
+
+// Walks the on-disk hash index of this directory looking for the given name.
+// Returns the inode index of the matching entry, ENOENT if the index proves
+// the name absent, or EINVAL if the index is unusable (unknown hash version,
+// inconsistent structure, hash collision chain crossing an index node); in
+// that last case the caller falls back to a linear scan.
+KResultOr<InodeIndex> Ext2FSInode::find_entry_in_hash_index(const StringView& name) const
+{
+    Locker locker(m_lock);
+    VERIFY(is_directory());
+
+    auto block_size = fs().block_size();
+
+    if (m_block_list.is_empty())
+        m_block_list = compute_block_list();
+    if (m_block_list.is_empty())
+        return EINVAL;
+
+    u8 buffer[max_block_size];
+    auto buf = UserOrKernelBuffer::for_kernel_buffer(buffer);
+
+    if (auto result = fs().read_block(m_block_list[0], &buf, block_size); result.is_error())
+        return result;
+
+    // The root block masquerades as a linear block containing just "." and
+    // ".." (8-byte entry headers plus 4 bytes of name space each), with the
+    // index information tucked in after the ".." entry.
+    static constexpr size_t directory_entry_header_size = 8;
+    auto* root_info = reinterpret_cast<const ext2_dx_root_info*>(buffer + 2 * (directory_entry_header_size + 4));
+    if (root_info->reserved_zero != 0 || root_info->info_length < sizeof(ext2_dx_root_info))
+        return EINVAL;
+    if (root_info->hash_version > static_cast<u8>(DirectoryHashVersion::TeaUnsigned))
+        return EINVAL;
+    if (root_info->indirect_levels > 1)
+        return EINVAL;
+
+    auto hash_or_none = compute_directory_entry_hash(static_cast<DirectoryHashVersion>(root_info->hash_version), fs().super_block().s_hash_seed, name);
+    if (!hash_or_none.has_value())
+        return EINVAL;
+    u32 hash = hash_or_none.value();
+
+    auto search_leaf_block = [&](u32 logical_block) -> KResultOr<u32> {
+        if (logical_block >= m_block_list.size())
+            return EINVAL;
+        if (auto result = fs().read_block(m_block_list[logical_block], &buf, block_size); result.is_error())
+            return result;
+        auto* entry = reinterpret_cast<ext2_dir_entry_2*>(buffer);
+        auto* entries_end = reinterpret_cast<ext2_dir_entry_2*>(buffer + block_size);
+        while (entry < entries_end) {
+            if (entry->rec_len == 0)
+                return EINVAL;
+            if (entry->inode != 0 && name == StringView { entry->name, entry->name_len })
+                return entry->inode;
+            entry = (ext2_dir_entry_2*)((char*)entry + entry->rec_len);
+        }
+        return 0u;
+    };
+
+    auto* entries = reinterpret_cast<const ext2_dx_entry*>(reinterpret_cast<const u8*>(root_info) + root_info->info_length);
+
+    for (u8 level = 0;; ++level) {
+        // The first slot of each entry table holds the table's limit and
+        // count rather than a hash; its block covers all hashes below the
+        // second slot's.
+        u16 count = (entries[0].hash >> 16) & 0xffff;
+        if (count == 0 || reinterpret_cast<const u8*>(entries + count) > buffer + block_size)
+            return EINVAL;
+
+        // Find the last entry whose hash is <= the one we're looking for.
+        size_t low = 1;
+        size_t high = count - 1;
+        size_t chosen = 0;
+        while (low <= high) {
+            size_t middle = low + (high - low) / 2;
+            if (entries[middle].hash > hash) {
+                high = middle - 1;
+            } else {
+                chosen = middle;
+                low = middle + 1;
+            }
+        }
+
+        if (level < root_info->indirect_levels) {
+            // Descend into an intermediate node; its entry table sits after
+            // a single empty directory entry spanning the whole block.
+            u32 logical_block = entries[chosen].block & 0x00ffffff;
+            if (logical_block >= m_block_list.size())
+                return EINVAL;
+            if (auto result = fs().read_block(m_block_list[logical_block], &buf, block_size); result.is_error())
+                return result;
+            entries = reinterpret_cast<const ext2_dx_entry*>(buffer + directory_entry_header_size);
+            continue;
+        }
+
+        // We're at the deepest level; scan the leaf the search chose, and
+        // keep scanning successor leaves as long as they might continue a
+        // hash collision chain for our hash value.
+        for (size_t leaf = chosen; leaf < count; ++leaf) {
+            if (leaf != chosen && (entries[leaf].hash & ~directory_hash_collision_bit) != hash)
+                return ENOENT;
+            // NOTE: Copy the entry before search_leaf_block() reuses the
+            //       block buffer the entry table lives in.
+            u32 logical_block = entries[leaf].block & 0x00ffffff;
+            u32 next_hash = leaf + 1 < count ? entries[leaf + 1].hash : directory_hash_end_marker;
+            auto result = search_leaf_block(logical_block);
+            if (result.is_error())
+                return result.error();
+            if (result.value() != 0)
+                return result.value();
+            if ((next_hash & ~directory_hash_collision_bit) != hash)
+                return ENOENT;
+            // The collision chain continues in the next leaf. We only handle
+            // chains within the root's entry table; crossing an intermediate
+            // node boundary is rare enough to punt to the linear scan.
+            if (level > 0)
+                return EINVAL;
+            // Our entry table was clobbered by the leaf read; re-read it.
+            if (auto read_result = fs().read_block(m_block_list[0], &buf, block_size); read_result.is_error())
+                return read_result;
+        }
+        return ENOENT;
+    }
+}
+
 RefPtr<Inode> Ext2FSInode::lookup(StringView name)
 {
     VERIFY(is_directory());
     dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]:lookup(): Looking up '{}'", identifier(), name);
+
+    if (m_lookup_cache.is_empty() && is_hash_indexed_directory()) {
+        // Use the on-disk hash index instead of slurping the entire
+        // directory into the lookup cache; if the index turns out to be
+        // unusable, fall through to the linear path below.
+        auto result = find_entry_in_hash_index(name);
+        if (!result.is_error())
+            return fs().get_inode({ fsid(), result.value() });
+        if (result.error() == -ENOENT) {
+            dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]:lookup(): '{}' not found in hash index", identifier(), name);
+            return {};
+        }
+    }
+
     if (!populate_lookup_cache())
         return {};
     Locker locker(m_lock);
@@ -1781,7 +2264,8 @@ KResult Ext2FS::prepare_to_unmount() const
     Locker locker(m_lock);
 
     for (auto& it : m_inode_cache) {
-        if (it.value->ref_count() > 1)
+        // NOTE: Negative lookup entries have no Inode object.
+        if (it.value && it.value->ref_count() > 1)
             return EBUSY;
     }
 
@@ -57,9 +57,12 @@ private:
     virtual KResult chown(uid_t, gid_t) override;
     virtual KResult truncate(u64) override;
     virtual KResultOr<int> get_block_address(int) override;
+    virtual void did_modify_metadata() override;
 
     KResult write_directory(Vector<Ext2FSDirectoryEntry>&);
     bool populate_lookup_cache() const;
+    bool is_hash_indexed_directory() const;
+    KResultOr<InodeIndex> find_entry_in_hash_index(const StringView& name) const;
     KResult resize(u64);
     KResult write_indirect_block(BlockBasedFS::BlockIndex, Span<BlockBasedFS::BlockIndex>);
     KResult grow_doubly_indirect_block(BlockBasedFS::BlockIndex, size_t, Span<BlockBasedFS::BlockIndex>, Vector<BlockBasedFS::BlockIndex>&, unsigned&);
@@ -72,12 +75,32 @@ private:
     Vector<BlockBasedFS::BlockIndex> compute_block_list_impl(bool include_block_list_blocks) const;
     Vector<BlockBasedFS::BlockIndex> compute_block_list_impl_internal(const ext2_inode& e2inode, bool include_block_list_blocks) const;
 
+    // An extent-style view of the block list: each run maps a contiguous
+    // range of logical blocks to a contiguous range of on-disk blocks (or
+    // to a hole when physical_start is zero). Since ext2 allocates blocks
+    // mostly contiguously, this is far more compact than one Vector entry
+    // per block, and sequential I/O resolves blocks through a cursor in
+    // O(1) per block.
+    struct BlockRun {
+        BlockBasedFS::BlockIndex logical_start { 0 };
+        BlockBasedFS::BlockIndex physical_start { 0 };
+        size_t block_count { 0 };
+    };
+
+    void ensure_block_runs() const;
+    void rebuild_block_runs(const Vector<BlockBasedFS::BlockIndex>&) const;
+    BlockBasedFS::BlockIndex block_from_logical_index(BlockBasedFS::BlockIndex) const;
+    size_t cached_logical_block_count() const;
+
     Ext2FS& fs();
     const Ext2FS& fs() const;
     Ext2FSInode(Ext2FS&, InodeIndex);
 
     mutable Vector<BlockBasedFS::BlockIndex> m_block_list;
+    mutable Vector<BlockRun> m_block_runs;
+    mutable size_t m_block_run_cursor { 0 };
     mutable HashMap<String, InodeIndex> m_lookup_cache;
+    mutable Optional<InodeMetadata> m_cached_metadata;
     ext2_inode m_raw_inode;
 };
 
@@ -104,6 +127,8 @@ public:
 
     virtual bool supports_watchers() const override { return true; }
 
+    virtual bool should_cache_name_lookups() const override { return true; }
+
     virtual u8 internal_file_type_to_directory_entry_type(const DirectoryEntryView& entry) const override;
 
     FeaturesReadOnly get_features_readonly() const;
@@ -137,7 +162,7 @@ private:
 
     BlockIndex first_block_index() const;
     KResultOr<InodeIndex> allocate_inode(GroupIndex preferred_group = 0);
-    KResultOr<Vector<BlockIndex>> allocate_blocks(GroupIndex preferred_group_index, size_t count);
+    KResultOr<Vector<BlockIndex>> allocate_blocks(GroupIndex preferred_group_index, size_t count, BlockIndex goal_block = 0);
     GroupIndex group_index_from_inode(InodeIndex) const;
     GroupIndex group_index_from_block_index(BlockIndex) const;
 
@@ -82,6 +82,10 @@ FIFO::FIFO(uid_t uid)
     m_buffer.set_unblock_callback([this]() {
         evaluate_block_conditions();
     });
+
+    // Pipelines like tar | gzip push megabytes through here; let the buffer
+    // grow under pressure so they aren't throttled to one wakeup per 64 KiB.
+    m_buffer.set_maximum_capacity(1 * MiB);
 }
 
 FIFO::~FIFO()
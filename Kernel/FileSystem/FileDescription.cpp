@@ -203,7 +203,7 @@ KResultOr<NonnullOwnPtr<KBuffer>> FileDescription::read_entire_file()
 
 KResultOr<ssize_t> FileDescription::get_dir_entries(UserOrKernelBuffer& output_buffer, ssize_t size)
 {
-    Locker locker(m_lock, Lock::Mode::Shared);
+    Locker locker(m_lock);
     if (!is_directory())
         return ENOTDIR;
 
@@ -214,8 +214,18 @@ KResultOr<ssize_t> FileDescription::get_dir_entries(UserOrKernelBuffer& output_b
     if (size < 0)
         return EINVAL;
 
+    // The file offset doubles as a cursor counting the entries we have already
+    // handed out, so userspace can stream a large directory in fixed-size
+    // batches instead of having to guess its total serialized size up front.
+    // Note that each call re-walks the directory up to the cursor; batches are
+    // large enough that this doesn't matter in practice.
+    size_t entries_to_skip = static_cast<size_t>(m_current_offset);
+    size_t entries_seen = 0;
+    size_t entries_written = 0;
     size_t remaining = size;
+    bool buffer_full = false;
     KResult error = KSuccess;
+
     u8 stack_buffer[PAGE_SIZE];
     Bytes temp_buffer(stack_buffer, sizeof(stack_buffer));
     OutputMemoryStream stream { temp_buffer };
@@ -225,10 +235,8 @@ KResultOr<ssize_t> FileDescription::get_dir_entries(UserOrKernelBuffer& output_b
             return false;
         if (stream.size() == 0)
             return true;
-        if (remaining < stream.size()) {
-            error = EINVAL;
-            return false;
-        } else if (!output_buffer.write(stream.bytes())) {
+        VERIFY(stream.size() <= remaining);
+        if (!output_buffer.write(stream.bytes())) {
             error = EFAULT;
             return false;
         }
@@ -238,17 +246,31 @@ KResultOr<ssize_t> FileDescription::get_dir_entries(UserOrKernelBuffer& output_b
         return true;
     };
 
-    KResult result = VFS::the().traverse_directory_inode(*m_inode, [&flush_stream_to_output_buffer, &error, &remaining, &output_buffer, &stream, this](auto& entry) {
-        size_t serialized_size = sizeof(ino_t) + sizeof(u8) + sizeof(size_t) + sizeof(char) * entry.name.length();
+    KResult result = VFS::the().traverse_directory_inode(*m_inode, [&](auto& entry) {
+        if (entries_seen++ < entries_to_skip)
+            return true;
+        size_t serialized_size = sizeof(ino_t) + sizeof(u8) + sizeof(off_t) + sizeof(size_t) + sizeof(char) * entry.name.length();
+        if (serialized_size > remaining - stream.size()) {
+            // The output buffer is full; the next call picks up from here.
+            buffer_full = true;
+            return false;
+        }
         if (serialized_size > stream.remaining()) {
             if (!flush_stream_to_output_buffer()) {
                 return false;
             }
         }
+        // Embed the file size so userspace doesn't have to stat() every entry
+        // just to list a directory.
+        off_t entry_size = 0;
+        if (auto entry_inode = m_inode->fs().get_inode(entry.inode))
+            entry_size = entry_inode->size();
         stream << (u32)entry.inode.index().value();
         stream << m_inode->fs().internal_file_type_to_directory_entry_type(entry);
+        stream << entry_size;
         stream << (u32)entry.name.length();
         stream << entry.name.bytes();
+        entries_written++;
         return true;
     });
     flush_stream_to_output_buffer();
@@ -264,6 +286,14 @@ KResultOr<ssize_t> FileDescription::get_dir_entries(UserOrKernelBuffer& output_b
     if (error) {
         return error;
     }
+
+    if (buffer_full && entries_written == 0) {
+        // Not even a single entry fit. Let userspace know its buffer is too
+        // small, as opposed to the directory being fully consumed.
+        return EINVAL;
+    }
+
+    m_current_offset = static_cast<off_t>(entries_to_skip + entries_written);
     return size - remaining;
 }
 
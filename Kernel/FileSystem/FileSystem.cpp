@@ -66,6 +66,21 @@ void FS::sync()
         fs.flush_writes();
 }
 
+void FS::trickle_sync()
+{
+    Inode::sync();
+
+    NonnullRefPtrVector<FS, 32> fses;
+    {
+        InterruptDisabler disabler;
+        for (auto& it : all_fses())
+            fses.append(*it.value);
+    }
+
+    for (auto& fs : fses)
+        fs.trickle_flush_writes();
+}
+
 void FS::lock_all()
 {
     for (auto& it : all_fses()) {
@@ -34,6 +34,7 @@ public:
     unsigned fsid() const { return m_fsid; }
     static FS* from_fsid(u32);
     static void sync();
+    static void trickle_sync();
     static void lock_all();
 
     virtual bool initialize() = 0;
@@ -41,6 +42,11 @@ public:
     virtual NonnullRefPtr<Inode> root_inode() const = 0;
     virtual bool supports_watchers() const { return false; }
 
+    // Whether name lookups in this filesystem may be cached by the VFS.
+    // Only safe for filesystems whose directories change exclusively
+    // through VFS operations (unlike e.g. ProcFS).
+    virtual bool should_cache_name_lookups() const { return false; }
+
     bool is_readonly() const { return m_readonly; }
 
     virtual unsigned total_block_count() const { return 0; }
@@ -60,10 +66,15 @@ public:
 
     virtual void flush_writes() { }
 
+    // Periodic writeback; filesystems that track dirty state can override
+    // this to write back only a portion of it. Defaults to a full flush.
+    virtual void trickle_flush_writes() { flush_writes(); }
+
     size_t block_size() const { return m_block_size; }
     size_t fragment_size() const { return m_fragment_size; }
 
     virtual bool is_file_backed() const { return false; }
+    virtual bool is_block_based() const { return false; }
 
     // Converts file types that are used internally by the filesystem to DT_* types
     virtual u8 internal_file_type_to_directory_entry_type(const DirectoryEntryView& entry) const { return entry.file_type; }
@@ -148,10 +148,15 @@ KResult Inode::decrement_link_count()
     return ENOTIMPL;
 }
 
-void Inode::set_shared_vmobject(SharedInodeVMObject& vmobject)
+RefPtr<SharedInodeVMObject> Inode::set_shared_vmobject(SharedInodeVMObject& vmobject)
 {
     Locker locker(m_lock);
+    // Only one SharedInodeVMObject may ever exist per inode; if another thread
+    // raced us here, hand its object back to the caller instead.
+    if (auto existing = m_shared_vmobject.strong_ref())
+        return existing;
     m_shared_vmobject = vmobject;
+    return nullptr;
 }
 
 bool Inode::bind_socket(LocalSocket& socket)
@@ -213,6 +218,7 @@ void Inode::set_metadata_dirty(bool metadata_dirty)
 
     m_metadata_dirty = metadata_dirty;
     if (m_metadata_dirty) {
+        did_modify_metadata();
         // FIXME: Maybe we should hook into modification events somewhere else, I'm not sure where.
         //        We don't always end up on this particular code path, for instance when writing to an ext2fs file.
         for (auto& watcher : m_watchers) {
@@ -221,16 +227,16 @@ void Inode::set_metadata_dirty(bool metadata_dirty)
     }
 }
 
-void Inode::did_add_child(InodeIdentifier const&, String const& name)
+void Inode::did_add_child(InodeIdentifier const& child_id, String const& name)
 {
     Locker locker(m_lock);
 
     for (auto& watcher : m_watchers) {
-        watcher->notify_inode_event({}, identifier(), InodeWatcherEvent::Type::ChildCreated, name);
+        watcher->notify_inode_event({}, identifier(), InodeWatcherEvent::Type::ChildCreated, name, child_id);
     }
 }
 
-void Inode::did_remove_child(InodeIdentifier const&, String const& name)
+void Inode::did_remove_child(InodeIdentifier const& child_id, String const& name)
 {
     Locker locker(m_lock);
 
@@ -240,7 +246,7 @@ void Inode::did_remove_child(InodeIdentifier const&, String const& name)
     }
 
     for (auto& watcher : m_watchers) {
-        watcher->notify_inode_event({}, identifier(), InodeWatcherEvent::Type::ChildDeleted, name);
+        watcher->notify_inode_event({}, identifier(), InodeWatcherEvent::Type::ChildDeleted, name, child_id);
     }
 }
 
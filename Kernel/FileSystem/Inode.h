@@ -87,7 +87,9 @@ public:
 
     void will_be_destroyed();
 
-    void set_shared_vmobject(SharedInodeVMObject&);
+    // Returns the previously installed VMObject if another thread won the
+    // race, in which case the caller must use that one instead.
+    RefPtr<SharedInodeVMObject> set_shared_vmobject(SharedInodeVMObject&);
     RefPtr<SharedInodeVMObject> shared_vmobject() const;
     bool is_shared_vmobject(const SharedInodeVMObject&) const;
 
@@ -117,6 +119,10 @@ protected:
     void did_modify_contents();
     void did_delete_self();
 
+    // Called when this inode becomes metadata-dirty, so subclasses can
+    // invalidate any cached InodeMetadata.
+    virtual void did_modify_metadata() { }
+
     mutable Lock m_lock { "Inode" };
 
 private:
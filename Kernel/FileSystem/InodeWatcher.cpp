@@ -28,59 +28,82 @@ InodeWatcher::~InodeWatcher()
 bool InodeWatcher::can_read(const FileDescription&, size_t) const
 {
     Locker locker(m_lock);
-    return !m_queue.is_empty();
+    return m_event_count > 0;
 }
 
 KResultOr<size_t> InodeWatcher::read(FileDescription&, u64, UserOrKernelBuffer& buffer, size_t buffer_size)
 {
     Locker locker(m_lock);
-    if (m_queue.is_empty())
+    if (m_event_count == 0)
         // can_read will catch the blocking case.
         return EAGAIN;
 
-    auto event = m_queue.dequeue();
-
-    size_t name_length = event.path.length() + 1;
-    size_t bytes_to_write = sizeof(InodeWatcherEvent);
-    if (!event.path.is_null())
-        bytes_to_write += name_length;
-
-    if (buffer_size < bytes_to_write)
-        return EINVAL;
-
-    auto result = buffer.write_buffered<MAXIMUM_EVENT_SIZE>(bytes_to_write, [&](u8* data, size_t data_bytes) {
-        size_t offset = 0;
-
-        memcpy(data + offset, &event.wd, sizeof(InodeWatcherEvent::watch_descriptor));
-        offset += sizeof(InodeWatcherEvent::watch_descriptor);
-        memcpy(data + offset, &event.type, sizeof(InodeWatcherEvent::type));
-        offset += sizeof(InodeWatcherEvent::type);
-
-        if (!event.path.is_null()) {
-            memcpy(data + offset, &name_length, sizeof(InodeWatcherEvent::name_length));
-            offset += sizeof(InodeWatcherEvent::name_length);
-            memcpy(data + offset, event.path.characters(), name_length);
-        } else {
-            memset(data + offset, 0, sizeof(InodeWatcherEvent::name_length));
+    // Batch as many events into the buffer as will fit.
+    size_t bytes_written = 0;
+    auto remaining_buffer = buffer;
+    while (m_event_count > 0) {
+        WatchDescription* watch = nullptr;
+        for (auto& entry : m_wd_to_watches) {
+            if (!entry.value->queue.is_empty()) {
+                watch = entry.value.ptr();
+                break;
+            }
+        }
+        VERIFY(watch);
+
+        auto const& event = watch->queue.first();
+        size_t name_length = event.path.length() + 1;
+        size_t event_size = sizeof(InodeWatcherEvent);
+        if (!event.path.is_null())
+            event_size += name_length;
+
+        if (buffer_size - bytes_written < event_size) {
+            if (bytes_written == 0)
+                return EINVAL;
+            break;
         }
 
-        return data_bytes;
-    });
+        auto result = remaining_buffer.write_buffered<MAXIMUM_EVENT_SIZE>(event_size, [&](u8* data, size_t data_bytes) {
+            size_t offset = 0;
+
+            memcpy(data + offset, &watch->wd, sizeof(InodeWatcherEvent::watch_descriptor));
+            offset += sizeof(InodeWatcherEvent::watch_descriptor);
+            memcpy(data + offset, &event.type, sizeof(InodeWatcherEvent::type));
+            offset += sizeof(InodeWatcherEvent::type);
+
+            if (!event.path.is_null()) {
+                memcpy(data + offset, &name_length, sizeof(InodeWatcherEvent::name_length));
+                offset += sizeof(InodeWatcherEvent::name_length);
+                memcpy(data + offset, event.path.characters(), name_length);
+            } else {
+                memset(data + offset, 0, sizeof(InodeWatcherEvent::name_length));
+            }
+
+            return data_bytes;
+        });
+        if (result.is_error())
+            return result.error();
+
+        watch->queue.dequeue();
+        m_event_count--;
+        bytes_written += event_size;
+        remaining_buffer = remaining_buffer.offset(event_size);
+    }
+
     evaluate_block_conditions();
-    return result;
+    return bytes_written;
 }
 
 KResult InodeWatcher::close()
 {
     Locker locker(m_lock);
 
-    for (auto& entry : m_wd_to_watches) {
-        auto& inode = const_cast<Inode&>(entry.value->inode);
-        inode.unregister_watcher({}, *this);
-    }
+    for (auto& entry : m_wd_to_watches)
+        unhook_watch(*entry.value);
 
     m_wd_to_watches.clear();
     m_inode_to_watches.clear();
+    m_event_count = 0;
     return KSuccess;
 }
 
@@ -89,7 +112,25 @@ String InodeWatcher::absolute_path(const FileDescription&) const
     return String::formatted("InodeWatcher:({})", m_wd_to_watches.size());
 }
 
-void InodeWatcher::notify_inode_event(Badge<Inode>, InodeIdentifier inode_id, InodeWatcherEvent::Type event_type, String const& name)
+void InodeWatcher::enqueue_event(WatchDescription& watch, InodeWatcherEvent::Type event_type, String const& path)
+{
+    // Coalesce identical back-to-back events. A build tool renaming files in
+    // a loop would otherwise flood the queue with duplicates faster than
+    // userspace can drain them.
+    if (!watch.queue.is_empty()) {
+        auto const& last = watch.queue.last();
+        if (last.type == event_type && last.path == path)
+            return;
+    }
+    if (watch.queue.size() == watch.queue.capacity()) {
+        // The queue will drop its oldest event to make room.
+        m_event_count--;
+    }
+    watch.queue.enqueue({ event_type, path });
+    m_event_count++;
+}
+
+void InodeWatcher::notify_inode_event(Badge<Inode>, InodeIdentifier inode_id, InodeWatcherEvent::Type event_type, String const& name, InodeIdentifier child_id)
 {
     Locker locker(m_lock);
 
@@ -97,18 +138,150 @@ void InodeWatcher::notify_inode_event(Badge<Inode>, InodeIdentifier inode_id, In
     if (it == m_inode_to_watches.end())
         return;
 
-    auto& watcher = *it->value;
-    if (!(watcher.event_mask & static_cast<unsigned>(event_type)))
+    auto& watch = *it->value;
+
+    // Events from covered subdirectories report their path relative to the
+    // watch root.
+    String path = name;
+    if (watch.recursive && !(watch.inode.identifier() == inode_id)) {
+        auto covered = watch.covered_directories.find(inode_id);
+        if (covered != watch.covered_directories.end()) {
+            if (name.is_null())
+                path = covered->value.relative_path;
+            else
+                path = String::formatted("{}/{}", covered->value.relative_path, name);
+        }
+    }
+
+    // Keep the coverage of a recursive watch up to date, regardless of which
+    // event types the watch actually subscribed to.
+    if (watch.recursive && child_id.is_valid()) {
+        if (event_type == InodeWatcherEvent::Type::ChildCreated)
+            hook_new_child(watch, inode_id, child_id, path);
+        else if (event_type == InodeWatcherEvent::Type::ChildDeleted)
+            unhook_deleted_child(watch, child_id);
+    }
+
+    if (!(watch.event_mask & static_cast<unsigned>(event_type)))
         return;
 
-    m_queue.enqueue({ watcher.wd, event_type, name });
+    enqueue_event(watch, event_type, path);
     evaluate_block_conditions();
 }
 
+void InodeWatcher::hook_directory_tree(WatchDescription& watch, Inode& root, String const& root_relative_path)
+{
+    struct WorkItem {
+        NonnullRefPtr<Inode> inode;
+        String relative_path;
+    };
+
+    // Walk the tree with an explicit worklist; deep trees must not eat
+    // through the kernel stack.
+    Vector<WorkItem> work;
+    work.append({ root, root_relative_path });
+
+    while (!work.is_empty()) {
+        auto item = work.take_last();
+        auto identifier = item.inode->identifier();
+        if (m_inode_to_watches.contains(identifier)) {
+            // Already covered, e.g. by another watch on this watcher.
+            continue;
+        }
+        m_inode_to_watches.set(identifier, &watch);
+        item.inode->register_watcher({}, *this);
+        watch.covered_directories.set(identifier, { item.inode, item.relative_path });
+
+        (void)item.inode->traverse_as_directory([&](auto& entry) {
+            if (entry.name == "." || entry.name == "..")
+                return true;
+            auto child = item.inode->fs().get_inode(entry.inode);
+            if (!child || !child->metadata().is_directory())
+                return true;
+            work.append({ child.release_nonnull(), String::formatted("{}/{}", item.relative_path, entry.name) });
+            return true;
+        });
+    }
+}
+
+void InodeWatcher::hook_child_directories(WatchDescription& watch, Inode& dir, String const& dir_relative_path)
+{
+    (void)dir.traverse_as_directory([&](auto& entry) {
+        if (entry.name == "." || entry.name == "..")
+            return true;
+        auto child = dir.fs().get_inode(entry.inode);
+        if (!child || !child->metadata().is_directory())
+            return true;
+        String relative_path = dir_relative_path.is_empty() ? String(entry.name) : String::formatted("{}/{}", dir_relative_path, entry.name);
+        hook_directory_tree(watch, *child, relative_path);
+        return true;
+    });
+}
+
+void InodeWatcher::hook_new_child(WatchDescription& watch, InodeIdentifier parent_id, InodeIdentifier child_id, String const& relative_path)
+{
+    Inode* parent = nullptr;
+    if (watch.inode.identifier() == parent_id) {
+        parent = &watch.inode;
+    } else {
+        auto covered = watch.covered_directories.find(parent_id);
+        if (covered == watch.covered_directories.end())
+            return;
+        parent = covered->value.inode.ptr();
+    }
+
+    auto child = parent->fs().get_inode(child_id);
+    if (!child || !child->metadata().is_directory())
+        return;
+
+    hook_directory_tree(watch, *child, relative_path);
+}
+
+void InodeWatcher::unhook_deleted_child(WatchDescription& watch, InodeIdentifier child_id)
+{
+    auto it = watch.covered_directories.find(child_id);
+    if (it == watch.covered_directories.end())
+        return;
+
+    // Drop the deleted directory and everything below it.
+    auto prefix = String::formatted("{}/", it->value.relative_path);
+    Vector<InodeIdentifier> to_remove;
+    to_remove.append(child_id);
+    for (auto& entry : watch.covered_directories) {
+        if (entry.value.relative_path.starts_with(prefix))
+            to_remove.append(entry.key);
+    }
+
+    for (auto& identifier : to_remove) {
+        auto covered = watch.covered_directories.find(identifier);
+        if (covered == watch.covered_directories.end())
+            continue;
+        covered->value.inode->unregister_watcher({}, *this);
+        m_inode_to_watches.remove(identifier);
+        watch.covered_directories.remove(identifier);
+    }
+}
+
+void InodeWatcher::unhook_watch(WatchDescription& watch)
+{
+    watch.inode.unregister_watcher({}, *this);
+    for (auto& entry : watch.covered_directories) {
+        entry.value.inode->unregister_watcher({}, *this);
+        m_inode_to_watches.remove(entry.key);
+    }
+    watch.covered_directories.clear();
+    m_event_count -= watch.queue.size();
+}
+
 KResultOr<int> InodeWatcher::register_inode(Inode& inode, unsigned event_mask)
 {
     Locker locker(m_lock);
 
+    bool recursive = event_mask & INODE_WATCHER_RECURSIVE;
+    event_mask &= ~INODE_WATCHER_RECURSIVE;
+    if (recursive && !inode.metadata().is_directory())
+        return EINVAL;
+
     if (m_inode_to_watches.find(inode.identifier()) != m_inode_to_watches.end())
         return EEXIST;
 
@@ -121,15 +294,21 @@ KResultOr<int> InodeWatcher::register_inode(Inode& inode, unsigned event_mask)
             m_wd_counter = 1;
     } while (m_wd_to_watches.find(wd) != m_wd_to_watches.end());
 
-    auto description_or_error = WatchDescription::create(wd, inode, event_mask);
+    auto description_or_error = WatchDescription::create(wd, inode, event_mask, recursive);
     if (description_or_error.is_error())
         return description_or_error.error();
 
     auto description = description_or_error.release_value();
-    m_inode_to_watches.set(inode.identifier(), description.ptr());
+    auto* watch = description.ptr();
+    m_inode_to_watches.set(inode.identifier(), watch);
     m_wd_to_watches.set(wd, move(description));
 
     inode.register_watcher({}, *this);
+
+    if (recursive) {
+        // Hook every subdirectory below the root under the same watch descriptor.
+        hook_child_directories(*watch, inode, {});
+    }
     return wd;
 }
 
@@ -141,10 +320,10 @@ KResult InodeWatcher::unregister_by_wd(int wd)
     if (it == m_wd_to_watches.end())
         return ENOENT;
 
-    auto& inode = it->value->inode;
-    inode.unregister_watcher({}, *this);
+    auto& watch = *it->value;
+    unhook_watch(watch);
 
-    m_inode_to_watches.remove(inode.identifier());
+    m_inode_to_watches.remove(watch.inode.identifier());
     m_wd_to_watches.remove(it);
 
     return KSuccess;
@@ -158,10 +337,25 @@ void InodeWatcher::unregister_by_inode(Badge<Inode>, InodeIdentifier identifier)
     if (it == m_inode_to_watches.end())
         return;
 
-    // NOTE: no need to call unregister_watcher here, the Inode calls us.
+    auto& watch = *it->value;
 
-    m_inode_to_watches.remove(identifier);
-    m_wd_to_watches.remove(it->value->wd);
+    // NOTE: no need to call unregister_watcher for this inode, the Inode calls us.
+
+    if (watch.inode.identifier() == identifier) {
+        // The watch root is going away; drop the whole watch.
+        for (auto& entry : watch.covered_directories) {
+            entry.value.inode->unregister_watcher({}, *this);
+            m_inode_to_watches.remove(entry.key);
+        }
+        m_event_count -= watch.queue.size();
+        int wd = watch.wd;
+        m_inode_to_watches.remove(identifier);
+        m_wd_to_watches.remove(wd);
+    } else {
+        // A directory covered by a recursive watch went away.
+        watch.covered_directories.remove(identifier);
+        m_inode_to_watches.remove(identifier);
+    }
 }
 
 }
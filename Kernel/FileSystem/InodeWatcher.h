@@ -12,6 +12,8 @@
 #include <AK/CircularQueue.h>
 #include <AK/HashMap.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/String.h>
 #include <Kernel/API/InodeWatcherEvent.h>
 #include <Kernel/FileSystem/File.h>
 
@@ -21,23 +23,44 @@ class Inode;
 
 // A specific description of a watch.
 struct WatchDescription {
+    struct Event {
+        InodeWatcherEvent::Type type { InodeWatcherEvent::Type::Invalid };
+        String path;
+    };
+
+    // A directory covered by a recursive watch, and its path relative to the
+    // watch root. We keep the inode alive so coverage can't silently lapse.
+    struct CoveredDirectory {
+        NonnullRefPtr<Inode> inode;
+        String relative_path;
+    };
+
     int wd;
     Inode& inode;
     unsigned event_mask;
+    bool recursive { false };
 
-    static KResultOr<NonnullOwnPtr<WatchDescription>> create(int wd, Inode& inode, unsigned event_mask)
+    // Events are queued per watch, and identical back-to-back events are
+    // coalesced, so bursts (e.g. rename storms during builds) collapse
+    // instead of flooding the watcher.
+    CircularQueue<Event, 64> queue;
+
+    HashMap<InodeIdentifier, CoveredDirectory> covered_directories;
+
+    static KResultOr<NonnullOwnPtr<WatchDescription>> create(int wd, Inode& inode, unsigned event_mask, bool recursive)
     {
-        auto description = adopt_own_if_nonnull(new WatchDescription(wd, inode, event_mask));
+        auto description = adopt_own_if_nonnull(new WatchDescription(wd, inode, event_mask, recursive));
         if (description)
             return description.release_nonnull();
         return ENOMEM;
     }
 
 private:
-    WatchDescription(int wd, Inode& inode, unsigned event_mask)
+    WatchDescription(int wd, Inode& inode, unsigned event_mask, bool recursive)
         : wd(wd)
         , inode(inode)
         , event_mask(event_mask)
+        , recursive(recursive)
     {
     }
 };
@@ -58,7 +81,7 @@ public:
     virtual const char* class_name() const override { return "InodeWatcher"; };
     virtual bool is_inode_watcher() const override { return true; }
 
-    void notify_inode_event(Badge<Inode>, InodeIdentifier, InodeWatcherEvent::Type, String const& name = {});
+    void notify_inode_event(Badge<Inode>, InodeIdentifier, InodeWatcherEvent::Type, String const& name = {}, InodeIdentifier child_id = {});
 
     KResultOr<int> register_inode(Inode&, unsigned event_mask);
     KResult unregister_by_wd(int);
@@ -67,18 +90,21 @@ public:
 private:
     explicit InodeWatcher() { }
 
+    void enqueue_event(WatchDescription&, InodeWatcherEvent::Type, String const& path);
+    void hook_directory_tree(WatchDescription&, Inode& root, String const& root_relative_path);
+    void hook_child_directories(WatchDescription&, Inode& dir, String const& dir_relative_path);
+    void hook_new_child(WatchDescription&, InodeIdentifier parent_id, InodeIdentifier child_id, String const& relative_path);
+    void unhook_deleted_child(WatchDescription&, InodeIdentifier child_id);
+    void unhook_watch(WatchDescription&);
+
     mutable Lock m_lock;
 
-    struct Event {
-        int wd { 0 };
-        InodeWatcherEvent::Type type { InodeWatcherEvent::Type::Invalid };
-        String path;
-    };
-    CircularQueue<Event, 32> m_queue;
     Checked<int> m_wd_counter { 1 };
+    size_t m_event_count { 0 };
 
     // NOTE: These two hashmaps provide two different ways of reaching the same
-    // watch description, so they will overlap.
+    // watch description, so they will overlap. For recursive watches, every
+    // covered directory maps to the watch as well.
     HashMap<int, NonnullOwnPtr<WatchDescription>> m_wd_to_watches;
     HashMap<InodeIdentifier, WatchDescription*> m_inode_to_watches;
 };
@@ -11,12 +11,14 @@
 #include <AK/ScopeGuard.h>
 #include <Kernel/Arch/x86/CPU.h>
 #include <Kernel/Arch/x86/ProcessorInfo.h>
+#include <Kernel/BootTrace.h>
 #include <Kernel/CommandLine.h>
 #include <Kernel/ConsoleDevice.h>
 #include <Kernel/DMI.h>
 #include <Kernel/Debug.h>
 #include <Kernel/Devices/BlockDevice.h>
 #include <Kernel/Devices/HID/HIDManagement.h>
+#include <Kernel/FileSystem/BlockBasedFileSystem.h>
 #include <Kernel/FileSystem/Custody.h>
 #include <Kernel/FileSystem/FileBackedFileSystem.h>
 #include <Kernel/FileSystem/FileDescription.h>
@@ -26,6 +28,7 @@
 #include <Kernel/Interrupts/GenericInterruptHandler.h>
 #include <Kernel/Interrupts/InterruptManagement.h>
 #include <Kernel/KBufferBuilder.h>
+#include <Kernel/LockContentionTracker.h>
 #include <Kernel/Module.h>
 #include <Kernel/Net/LocalSocket.h>
 #include <Kernel/Net/NetworkAdapter.h>
@@ -68,11 +71,14 @@ enum ProcFileType {
     FI_Root_cpuinfo,
     FI_Root_dmesg,
     FI_Root_interrupts,
+    FI_Root_lock_contention,
+    FI_Root_scheduler,
     FI_Root_dmi,
     FI_Root_smbios_entry_point,
     FI_Root_keymap,
     FI_Root_pci,
     FI_Root_devices,
+    FI_Root_boot_trace,
     FI_Root_uptime,
     FI_Root_cmdline,
     FI_Root_modules,
@@ -311,7 +317,9 @@ static bool procfs$pid_vm(InodeIdentifier identifier, KBufferBuilder& builder)
             region_object.add("syscall", region->is_syscall_region());
             region_object.add("purgeable", region->vmobject().is_anonymous());
             if (region->vmobject().is_anonymous()) {
-                region_object.add("volatile", static_cast<const AnonymousVMObject&>(region->vmobject()).is_any_volatile());
+                auto& vmobject = static_cast<const AnonymousVMObject&>(region->vmobject());
+                region_object.add("volatile", vmobject.is_any_volatile());
+                region_object.add("amount_compressed", vmobject.amount_compressed());
             }
             region_object.add("cacheable", region->is_cacheable());
             region_object.add("address", region->vaddr().get());
@@ -394,6 +402,55 @@ static bool procfs$interrupts(InodeIdentifier, KBufferBuilder& builder)
     return true;
 }
 
+static bool procfs$scheduler(InodeIdentifier, KBufferBuilder& builder)
+{
+    // Copy the counters out first; serializing can allocate, and we don't
+    // want to do that while the scheduler lock is held.
+    Vector<SchedulerCpuStatistics, 8> cpu_statistics;
+    Scheduler::for_each_cpu_statistics([&](u32, const SchedulerCpuStatistics& statistics) {
+        cpu_statistics.append(statistics);
+    });
+
+    JsonObjectSerializer<KBufferBuilder> json { builder };
+    {
+        auto cpus_array = json.add_array("cpus");
+        for (size_t cpu = 0; cpu < cpu_statistics.size(); ++cpu) {
+            auto& statistics = cpu_statistics[cpu];
+            auto obj = cpus_array.add_object();
+            obj.add("cpu", cpu);
+            obj.add("context_switches", statistics.context_switches);
+            obj.add("preemptions", statistics.preemptions);
+            obj.add("voluntary_switches", statistics.voluntary_switches);
+            obj.add("donations", statistics.donations);
+        }
+        cpus_array.finish();
+    }
+    {
+        auto threads_array = json.add_array("threads");
+        Thread::for_each([&](Thread& thread) {
+            auto obj = threads_array.add_object();
+            obj.add("pid", thread.pid().value());
+            obj.add("tid", thread.tid().value());
+            obj.add("name", thread.name());
+            obj.add("times_scheduled", thread.times_scheduled());
+            obj.add("max_latency_ns", thread.max_scheduling_latency_ns());
+            auto histogram = obj.add_array("latency_histogram");
+            for (auto count : thread.scheduling_latency_histogram())
+                histogram.add(count);
+            histogram.finish();
+        });
+        threads_array.finish();
+    }
+    json.finish();
+    return true;
+}
+
+static bool procfs$lock_contention(InodeIdentifier, KBufferBuilder& builder)
+{
+    LockContentionTracker::the().dump(builder);
+    return true;
+}
+
 static bool procfs$keymap(InodeIdentifier, KBufferBuilder& builder)
 {
     JsonObjectSerializer<KBufferBuilder> json { builder };
@@ -422,6 +479,21 @@ static bool procfs$devices(InodeIdentifier, KBufferBuilder& builder)
     return true;
 }
 
+static bool procfs$boot_trace(InodeIdentifier, KBufferBuilder& builder)
+{
+    JsonArraySerializer array { builder };
+    auto count = BootTrace::event_count();
+    for (size_t i = 0; i < count; ++i) {
+        auto& event = BootTrace::event(i);
+        auto obj = array.add_object();
+        obj.add("stage", event.stage);
+        obj.add("start_cycles", event.timestamp);
+        obj.add("duration_cycles", (i + 1 < count) ? BootTrace::event(i + 1).timestamp - event.timestamp : 0);
+    }
+    array.finish();
+    return true;
+}
+
 static bool procfs$uptime(InodeIdentifier, KBufferBuilder& builder)
 {
     builder.appendff("{}\n", TimeManagement::the().uptime_ms() / 1000);
@@ -528,6 +600,10 @@ static bool procfs$net_tcp(InodeIdentifier, KBufferBuilder& builder)
         obj.add("bytes_in", socket.bytes_in());
         obj.add("packets_out", socket.packets_out());
         obj.add("bytes_out", socket.bytes_out());
+        obj.add("congestion_window", socket.congestion_window());
+        obj.add("slow_start_threshold", socket.slow_start_threshold());
+        obj.add("fast_retransmits", socket.fast_retransmits());
+        obj.add("timeout_retransmits", socket.timeout_retransmits());
     });
     array.finish();
     return true;
@@ -679,6 +755,22 @@ static bool procfs$df(InodeIdentifier, KBufferBuilder& builder)
             fs_object.add("source", static_cast<const FileBackedFS&>(fs).file_description().absolute_path());
         else
             fs_object.add("source", "none");
+
+        if (fs.is_block_based()) {
+            auto& io = static_cast<const BlockBasedFS&>(fs).io_statistics();
+            fs_object.add("read_ops", io.read_ops);
+            fs_object.add("write_ops", io.write_ops);
+            fs_object.add("bytes_read", io.bytes_read);
+            fs_object.add("bytes_written", io.bytes_written);
+            auto read_latency = fs_object.add_array("read_latency_us_log2");
+            for (auto count : io.read_latency_buckets)
+                read_latency.add(count);
+            read_latency.finish();
+            auto write_latency = fs_object.add_array("write_latency_us_log2");
+            for (auto count : io.write_latency_buckets)
+                write_latency.add(count);
+            write_latency.finish();
+        }
     });
     array.finish();
     return true;
@@ -792,13 +884,14 @@ static bool procfs$all(InodeIdentifier, KBufferBuilder& builder)
         process_object.add("name", process.name());
         process_object.add("executable", process.executable() ? process.executable()->absolute_path() : "");
         process_object.add("tty", process.tty() ? process.tty()->tty_name() : "notty");
-        process_object.add("amount_virtual", process.space().amount_virtual());
-        process_object.add("amount_resident", process.space().amount_resident());
-        process_object.add("amount_dirty_private", process.space().amount_dirty_private());
-        process_object.add("amount_clean_inode", process.space().amount_clean_inode());
-        process_object.add("amount_shared", process.space().amount_shared());
-        process_object.add("amount_purgeable_volatile", process.space().amount_purgeable_volatile());
-        process_object.add("amount_purgeable_nonvolatile", process.space().amount_purgeable_nonvolatile());
+        auto memory_statistics = process.space().memory_statistics();
+        process_object.add("amount_virtual", memory_statistics.amount_virtual);
+        process_object.add("amount_resident", memory_statistics.amount_resident);
+        process_object.add("amount_dirty_private", memory_statistics.amount_dirty_private);
+        process_object.add("amount_clean_inode", memory_statistics.amount_clean_inode);
+        process_object.add("amount_shared", memory_statistics.amount_shared);
+        process_object.add("amount_purgeable_volatile", memory_statistics.amount_purgeable_volatile);
+        process_object.add("amount_purgeable_nonvolatile", memory_statistics.amount_purgeable_nonvolatile);
         process_object.add("dumpable", process.is_dumpable());
         process_object.add("kernel", process.is_kernel_process());
         auto thread_array = process_object.add_array("threads");
@@ -815,6 +908,7 @@ static bool procfs$all(InodeIdentifier, KBufferBuilder& builder)
             thread_object.add("state", thread.state_string());
             thread_object.add("cpu", thread.cpu());
             thread_object.add("priority", thread.priority());
+            thread_object.add("priority_boost", thread.priority_boost());
             thread_object.add("syscall_count", thread.syscall_count());
             thread_object.add("inode_faults", thread.inode_faults());
             thread_object.add("zero_faults", thread.zero_faults());
@@ -970,6 +1064,7 @@ bool ProcFS::initialize()
     static Lockable<bool>* kmalloc_stack_helper;
     static Lockable<bool>* ubsan_deadly_helper;
     static Lockable<bool>* caps_lock_to_ctrl_helper;
+    static Lockable<bool>* lock_contention_helper;
 
     if (kmalloc_stack_helper == nullptr) {
         kmalloc_stack_helper = new Lockable<bool>();
@@ -986,6 +1081,10 @@ bool ProcFS::initialize()
         ProcFS::add_sys_bool("caps_lock_to_ctrl", *caps_lock_to_ctrl_helper, [] {
             Kernel::g_caps_lock_remapped_to_ctrl.exchange(caps_lock_to_ctrl_helper->resource());
         });
+        lock_contention_helper = new Lockable<bool>();
+        ProcFS::add_sys_bool("lock_contention", *lock_contention_helper, [] {
+            LockContentionTracker::set_enabled(lock_contention_helper->resource());
+        });
     }
     return true;
 }
@@ -1109,13 +1208,13 @@ KResult ProcFSInode::refresh_data(FileDescription& description) const
         // ensures we don't accidentally leak previously written data.
         buffer->set_size(0);
     }
-    KBufferBuilder builder(buffer, true);
+    KBufferBuilder builder;
     if (!read_callback(identifier(), builder))
         return ENOENT;
-    // We don't use builder.build() here, which would steal our buffer
-    // and turn it into an OwnPtr. Instead, just flush to the buffer so
-    // that we can read all the data that was written.
-    if (!builder.flush())
+    // We don't use builder.build() here, which would give us an OwnPtr.
+    // Instead, materialize the chained chunks into our (possibly reused)
+    // flat buffer so that we can read all the data that was written.
+    if (!builder.flush_to(buffer))
         return ENOMEM;
     if (!buffer)
         return ENOMEM;
@@ -1692,10 +1791,13 @@ ProcFS::ProcFS()
     m_entries[FI_Root_self] = { "self", FI_Root_self, false, procfs$self };
     m_entries[FI_Root_pci] = { "pci", FI_Root_pci, false, procfs$pci };
     m_entries[FI_Root_interrupts] = { "interrupts", FI_Root_interrupts, false, procfs$interrupts };
+    m_entries[FI_Root_lock_contention] = { "lock_contention", FI_Root_lock_contention, false, procfs$lock_contention };
+    m_entries[FI_Root_scheduler] = { "scheduler", FI_Root_scheduler, false, procfs$scheduler };
     m_entries[FI_Root_dmi] = { "DMI", FI_Root_dmi, false, procfs$dmi };
     m_entries[FI_Root_smbios_entry_point] = { "smbios_entry_point", FI_Root_smbios_entry_point, false, procfs$smbios_entry_point };
     m_entries[FI_Root_keymap] = { "keymap", FI_Root_keymap, false, procfs$keymap };
     m_entries[FI_Root_devices] = { "devices", FI_Root_devices, false, procfs$devices };
+    m_entries[FI_Root_boot_trace] = { "boot_trace", FI_Root_boot_trace, false, procfs$boot_trace };
     m_entries[FI_Root_uptime] = { "uptime", FI_Root_uptime, false, procfs$uptime };
     m_entries[FI_Root_cmdline] = { "cmdline", FI_Root_cmdline, true, procfs$cmdline };
     m_entries[FI_Root_modules] = { "modules", FI_Root_modules, true, procfs$modules };
@@ -133,17 +133,28 @@ KResultOr<ssize_t> TmpFSInode::read_bytes(off_t offset, ssize_t size, UserOrKern
     VERIFY(size >= 0);
     VERIFY(offset >= 0);
 
-    if (!m_content)
-        return 0;
-
     if (offset >= m_metadata.size)
         return 0;
 
     if (static_cast<off_t>(size) > m_metadata.size - offset)
         size = m_metadata.size - offset;
 
-    if (!buffer.write(m_content->data() + offset, size))
-        return EFAULT;
+    size_t nread = 0;
+    while (nread < static_cast<size_t>(size)) {
+        size_t chunk_index = (offset + nread) / content_chunk_size;
+        size_t offset_in_chunk = (offset + nread) % content_chunk_size;
+        size_t to_copy = min(static_cast<size_t>(size) - nread, content_chunk_size - offset_in_chunk);
+        auto* chunk = chunk_index < m_content_chunks.size() ? m_content_chunks[chunk_index].ptr() : nullptr;
+        if (chunk) {
+            if (!buffer.write(chunk->data() + offset_in_chunk, nread, to_copy))
+                return EFAULT;
+        } else {
+            // Sparse hole; reads as zeroes.
+            if (!buffer.memset(0, nread, to_copy))
+                return EFAULT;
+        }
+        nread += to_copy;
+    }
     return size;
 }
 
@@ -157,42 +168,49 @@ KResultOr<ssize_t> TmpFSInode::write_bytes(off_t offset, ssize_t size, const Use
     if (result.is_error())
         return result;
 
-    off_t old_size = m_metadata.size;
     off_t new_size = m_metadata.size;
     if ((offset + size) > new_size)
         new_size = offset + size;
 
-    if (new_size > old_size) {
-        if (m_content && m_content->capacity() >= (size_t)new_size) {
-            m_content->set_size(new_size);
-        } else {
-            // Grow the content buffer 2x the new sizeto accommodate repeating write() calls.
-            // Note that we're not actually committing physical memory to the buffer
-            // until it's needed. We only grow VM here.
-
-            // FIXME: Fix this so that no memcpy() is necessary, and we can just grow the
-            //        KBuffer and it will add physical pages as needed while keeping the
-            //        existing ones.
-            auto tmp = KBuffer::try_create_with_size(new_size * 2);
-            if (!tmp)
-                return ENOMEM;
-            tmp->set_size(new_size);
-            if (m_content)
-                memcpy(tmp->data(), m_content->data(), old_size);
-            m_content = move(tmp);
-        }
+    size_t nwritten = 0;
+    while (nwritten < static_cast<size_t>(size)) {
+        size_t chunk_index = (offset + nwritten) / content_chunk_size;
+        size_t offset_in_chunk = (offset + nwritten) % content_chunk_size;
+        size_t to_copy = min(static_cast<size_t>(size) - nwritten, content_chunk_size - offset_in_chunk);
+        auto* chunk = ensure_content_chunk(chunk_index);
+        if (!chunk)
+            return ENOMEM;
+        if (!buffer.read(chunk->data() + offset_in_chunk, nwritten, to_copy)) // TODO: partial reads?
+            return EFAULT;
+        nwritten += to_copy;
+    }
+
+    if (new_size > m_metadata.size) {
         m_metadata.size = new_size;
         set_metadata_dirty(true);
         set_metadata_dirty(false);
     }
 
-    if (!buffer.read(m_content->data() + offset, size)) // TODO: partial reads?
-        return EFAULT;
-
     did_modify_contents();
     return size;
 }
 
+KBuffer* TmpFSInode::ensure_content_chunk(size_t chunk_index)
+{
+    if (m_content_chunks.size() <= chunk_index)
+        m_content_chunks.resize(chunk_index + 1);
+
+    auto& chunk = m_content_chunks[chunk_index];
+    if (!chunk) {
+        // Note that we're not actually committing physical memory to the
+        // chunk until it's faulted in; a fresh chunk reads as zeroes.
+        chunk = KBuffer::try_create_with_size(content_chunk_size, Region::Access::Read | Region::Access::Write, "TmpFSInode: Content chunk");
+        if (!chunk)
+            return nullptr;
+    }
+    return chunk.ptr();
+}
+
 RefPtr<Inode> TmpFSInode::lookup(StringView name)
 {
     Locker locker(m_lock, Lock::Mode::Shared);
@@ -313,24 +331,19 @@ KResult TmpFSInode::truncate(u64 size)
     Locker locker(m_lock);
     VERIFY(!is_directory());
 
-    if (size == 0)
-        m_content.clear();
-    else if (!m_content) {
-        m_content = KBuffer::try_create_with_size(size);
-        if (!m_content)
-            return ENOMEM;
-    } else if (static_cast<size_t>(size) < m_content->capacity()) {
-        size_t prev_size = m_metadata.size;
-        m_content->set_size(size);
-        if (prev_size < static_cast<size_t>(size))
-            memset(m_content->data() + prev_size, 0, size - prev_size);
-    } else {
-        size_t prev_size = m_metadata.size;
-        auto tmp = KBuffer::try_create_with_size(size);
-        if (!tmp)
-            return ENOMEM;
-        memcpy(tmp->data(), m_content->data(), prev_size);
-        m_content = move(tmp);
+    u64 old_size = m_metadata.size;
+    if (size < old_size) {
+        // Drop any chunks entirely past the new end, and zero out the tail
+        // of the last remaining chunk so growing the file again reads zeroes.
+        // Growing needs no work at all: the new range is a sparse hole.
+        size_t needed_chunks = (size + content_chunk_size - 1) / content_chunk_size;
+        if (m_content_chunks.size() > needed_chunks)
+            m_content_chunks.resize(needed_chunks);
+        size_t offset_in_chunk = size % content_chunk_size;
+        if (offset_in_chunk != 0 && size / content_chunk_size < m_content_chunks.size()) {
+            if (auto* chunk = m_content_chunks[size / content_chunk_size].ptr())
+                memset(chunk->data() + offset_in_chunk, 0, content_chunk_size - offset_in_chunk);
+        }
     }
 
     m_metadata.size = size;
@@ -8,6 +8,7 @@
 
 #include <AK/HashMap.h>
 #include <AK/Optional.h>
+#include <AK/Vector.h>
 #include <Kernel/FileSystem/FileSystem.h>
 #include <Kernel/FileSystem/Inode.h>
 #include <Kernel/KBuffer.h>
@@ -79,10 +80,16 @@ private:
 
     void notify_watchers();
 
+    KBuffer* ensure_content_chunk(size_t chunk_index);
+
     InodeMetadata m_metadata;
     InodeIdentifier m_parent;
 
-    OwnPtr<KBuffer> m_content;
+    // File contents are stored in fixed-size, lazily committed chunks, so
+    // growing a file only appends chunk slots instead of reallocating and
+    // copying everything. A null chunk is a sparse hole and reads as zeroes.
+    static constexpr size_t content_chunk_size = 64 * KiB;
+    Vector<OwnPtr<KBuffer>> m_content_chunks;
     struct Child {
         String name;
         NonnullRefPtr<TmpFSInode> inode;
@@ -7,6 +7,7 @@
 #include <AK/LexicalPath.h>
 #include <AK/Singleton.h>
 #include <AK/StringBuilder.h>
+#include <AK/StringHash.h>
 #include <Kernel/Debug.h>
 #include <Kernel/Devices/BlockDevice.h>
 #include <Kernel/FileSystem/Custody.h>
@@ -24,6 +25,11 @@ static AK::Singleton<VFS> s_the;
 static constexpr int symlink_recursion_limit { 5 }; // FIXME: increase?
 static constexpr int root_mount_flags = MS_NODEV | MS_NOSUID | MS_RDONLY;
 
+static u32 custody_cache_hash(const Custody& parent, const StringView& name)
+{
+    return pair_int_hash(ptr_hash(&parent), string_hash(name.characters_without_null_termination(), name.length()));
+}
+
 UNMAP_AFTER_INIT void VFS::initialize()
 {
     s_the.ensure_instance();
@@ -61,6 +67,7 @@ KResult VFS::mount(FS& file_system, Custody& mount_point, int flags)
     // FIXME: check that this is not already a mount point
     Mount mount { file_system, &mount_point, flags };
     m_mounts.append(move(mount));
+    clear_custody_cache();
     return KSuccess;
 }
 
@@ -72,6 +79,7 @@ KResult VFS::bind_mount(Custody& source, Custody& mount_point, int flags)
     // FIXME: check that this is not already a mount point
     Mount mount { source.inode(), mount_point, flags };
     m_mounts.append(move(mount));
+    clear_custody_cache();
     return KSuccess;
 }
 
@@ -86,6 +94,7 @@ KResult VFS::remount(Custody& mount_point, int new_flags)
         return ENODEV;
 
     mount->set_flags(new_flags);
+    clear_custody_cache();
     return KSuccess;
 }
 
@@ -103,6 +112,7 @@ KResult VFS::unmount(Inode& guest_inode)
             }
             dbgln("VFS: found fs {} at mount index {}! Unmounting...", mount.guest_fs().fsid(), i);
             m_mounts.unstable_take(i);
+            clear_custody_cache();
             return KSuccess;
         }
     }
@@ -355,7 +365,10 @@ KResult VFS::mknod(StringView path, mode_t mode, dev_t dev, Custody& base)
 
     LexicalPath p(path);
     dbgln("VFS::mknod: '{}' mode={} dev={} in {}", p.basename(), mode, dev, parent_inode.identifier());
-    return parent_inode.create_child(p.basename(), mode, dev, current_process->euid(), current_process->egid()).result();
+    auto result = parent_inode.create_child(p.basename(), mode, dev, current_process->euid(), current_process->egid()).result();
+    if (result.is_success())
+        invalidate_custody_cache(parent_inode.identifier(), p.basename());
+    return result;
 }
 
 KResultOr<NonnullRefPtr<FileDescription>> VFS::create(StringView path, int options, mode_t mode, Custody& parent_custody, Optional<UidAndGid> owner)
@@ -382,6 +395,7 @@ KResultOr<NonnullRefPtr<FileDescription>> VFS::create(StringView path, int optio
     auto inode_or_error = parent_inode.create_child(p.basename(), mode, 0, uid, gid);
     if (inode_or_error.is_error())
         return inode_or_error.error();
+    invalidate_custody_cache(parent_inode.identifier(), p.basename());
 
     auto new_custody = Custody::create(&parent_custody, p.basename(), inode_or_error.value(), parent_custody.mount_flags());
     if (new_custody.is_error())
@@ -420,7 +434,10 @@ KResult VFS::mkdir(StringView path, mode_t mode, Custody& base)
 
     LexicalPath p(path);
     dbgln_if(VFS_DEBUG, "VFS::mkdir: '{}' in {}", p.basename(), parent_inode.identifier());
-    return parent_inode.create_child(p.basename(), S_IFDIR | mode, 0, current_process->euid(), current_process->egid()).result();
+    auto result = parent_inode.create_child(p.basename(), S_IFDIR | mode, 0, current_process->euid(), current_process->egid()).result();
+    if (result.is_success())
+        invalidate_custody_cache(parent_inode.identifier(), p.basename());
+    return result;
 }
 
 KResult VFS::access(StringView path, int mode, Custody& base)
@@ -549,13 +566,17 @@ KResult VFS::rename(StringView old_path, StringView new_path, Custody& base)
             return EISDIR;
         if (auto result = new_parent_inode.remove_child(new_basename); result.is_error())
             return result;
+        invalidate_custody_cache(new_parent_inode.identifier(), new_basename);
     }
 
     if (auto result = new_parent_inode.add_child(old_inode, new_basename, old_inode.mode()); result.is_error())
         return result;
+    invalidate_custody_cache(new_parent_inode.identifier(), new_basename);
 
-    if (auto result = old_parent_inode.remove_child(LexicalPath(old_path).basename()); result.is_error())
+    auto old_basename = LexicalPath(old_path).basename();
+    if (auto result = old_parent_inode.remove_child(old_basename); result.is_error())
         return result;
+    invalidate_custody_cache(old_parent_inode.identifier(), old_basename);
 
     return KSuccess;
 }
@@ -656,7 +677,11 @@ KResult VFS::link(StringView old_path, StringView new_path, Custody& base)
     if (!hard_link_allowed(old_inode))
         return EPERM;
 
-    return parent_inode.add_child(old_inode, LexicalPath(new_path).basename(), old_inode.mode());
+    auto new_basename = LexicalPath(new_path).basename();
+    auto result = parent_inode.add_child(old_inode, new_basename, old_inode.mode());
+    if (result.is_success())
+        invalidate_custody_cache(parent_inode.identifier(), new_basename);
+    return result;
 }
 
 KResult VFS::unlink(StringView path, Custody& base)
@@ -689,8 +714,10 @@ KResult VFS::unlink(StringView path, Custody& base)
     if (parent_custody->is_readonly())
         return EROFS;
 
-    if (auto result = parent_inode.remove_child(LexicalPath(path).basename()); result.is_error())
+    auto basename = LexicalPath(path).basename();
+    if (auto result = parent_inode.remove_child(basename); result.is_error())
         return result;
+    invalidate_custody_cache(parent_inode.identifier(), basename);
 
     return KSuccess;
 }
@@ -717,6 +744,7 @@ KResult VFS::symlink(StringView target, StringView linkpath, Custody& base)
     auto inode_or_error = parent_inode.create_child(p.basename(), S_IFLNK | 0644, 0, current_process->euid(), current_process->egid());
     if (inode_or_error.is_error())
         return inode_or_error.error();
+    invalidate_custody_cache(parent_inode.identifier(), p.basename());
     auto& inode = inode_or_error.value();
     auto target_buffer = UserOrKernelBuffer::for_kernel_buffer(const_cast<u8*>((const u8*)target.characters_without_null_termination()));
     auto result = inode->write_bytes(0, target.length(), target_buffer, nullptr);
@@ -771,7 +799,11 @@ KResult VFS::rmdir(StringView path, Custody& base)
     if (auto result = inode.remove_child(".."); result.is_error())
         return result;
 
-    return parent_inode.remove_child(LexicalPath(path).basename());
+    auto basename = LexicalPath(path).basename();
+    auto result = parent_inode.remove_child(basename);
+    if (result.is_success())
+        invalidate_custody_cache(parent_inode.identifier(), basename);
+    return result;
 }
 
 VFS::Mount::Mount(FS& guest_fs, Custody* host_custody, int flags)
@@ -823,6 +855,11 @@ void VFS::sync()
     FS::sync();
 }
 
+void VFS::trickle_sync()
+{
+    FS::trickle_sync();
+}
+
 Custody& VFS::root_custody()
 {
     return *m_root_custody;
@@ -905,6 +942,91 @@ KResult VFS::validate_path_against_process_veil(StringView path, int options)
     return KSuccess;
 }
 
+VFS::CustodyCacheEntry::CustodyCacheEntry(Custody& parent, String name, RefPtr<Custody> child)
+    : parent(parent)
+    , name(move(name))
+    , child(move(child))
+{
+}
+
+Optional<RefPtr<Custody>> VFS::lookup_custody_cache(Custody& parent, const StringView& name)
+{
+    ScopedSpinLock lock(m_custody_cache_lock);
+    auto it = m_custody_cache.find(custody_cache_hash(parent, name));
+    if (it == m_custody_cache.end())
+        return {};
+    auto& entry = *it->value;
+    // The hash may collide, so make sure this entry is really for us.
+    if (entry.parent.ptr() != &parent || entry.name != name)
+        return {};
+    m_custody_cache_lru.prepend(entry);
+    return entry.child;
+}
+
+void VFS::add_to_custody_cache(Custody& parent, const StringView& name, RefPtr<Custody> child)
+{
+    if (!parent.inode().fs().should_cache_name_lookups())
+        return;
+
+    auto new_entry = make<CustodyCacheEntry>(parent, name, move(child));
+
+    // NOTE: Entries removed from the cache are destroyed after dropping the
+    //       spinlock, since releasing their custody references may sleep.
+    OwnPtr<CustodyCacheEntry> evicted_entry;
+    OwnPtr<CustodyCacheEntry> replaced_entry;
+    {
+        ScopedSpinLock lock(m_custody_cache_lock);
+        if (m_custody_cache.size() >= max_custody_cache_entries) {
+            auto* oldest_entry = m_custody_cache_lru.last();
+            VERIFY(oldest_entry);
+            m_custody_cache_lru.remove(*oldest_entry);
+            auto oldest_it = m_custody_cache.find(custody_cache_hash(oldest_entry->parent, oldest_entry->name));
+            VERIFY(oldest_it != m_custody_cache.end());
+            evicted_entry = move(oldest_it->value);
+            m_custody_cache.remove(oldest_it);
+        }
+        auto it = m_custody_cache.find(custody_cache_hash(parent, name));
+        if (it != m_custody_cache.end()) {
+            // A colliding entry gets replaced, effectively evicting it.
+            m_custody_cache_lru.remove(*it->value);
+            replaced_entry = move(it->value);
+            m_custody_cache.remove(it);
+        }
+        m_custody_cache_lru.prepend(*new_entry);
+        m_custody_cache.set(custody_cache_hash(parent, name), move(new_entry));
+    }
+}
+
+void VFS::invalidate_custody_cache(InodeIdentifier parent, const StringView& name)
+{
+    Vector<OwnPtr<CustodyCacheEntry>> removed_entries;
+    {
+        ScopedSpinLock lock(m_custody_cache_lock);
+        Vector<u32, 4> keys_to_remove;
+        for (auto& it : m_custody_cache) {
+            auto& entry = *it.value;
+            if (entry.name == name && entry.parent->inode().identifier() == parent)
+                keys_to_remove.append(it.key);
+        }
+        for (auto key : keys_to_remove) {
+            auto it = m_custody_cache.find(key);
+            m_custody_cache_lru.remove(*it->value);
+            removed_entries.append(move(it->value));
+            m_custody_cache.remove(it);
+        }
+    }
+}
+
+void VFS::clear_custody_cache()
+{
+    HashMap<u32, OwnPtr<CustodyCacheEntry>> removed_entries;
+    {
+        ScopedSpinLock lock(m_custody_cache_lock);
+        m_custody_cache_lru.clear();
+        removed_entries = move(m_custody_cache);
+    }
+}
+
 KResultOr<NonnullRefPtr<Custody>> VFS::resolve_path(StringView path, Custody& base, RefPtr<Custody>* out_parent, int options, int symlink_recursion_level)
 {
     auto custody_or_error = resolve_path_without_veil(path, base, out_parent, options, symlink_recursion_level);
@@ -974,8 +1096,31 @@ KResultOr<NonnullRefPtr<Custody>> VFS::resolve_path_without_veil(StringView path
         }
 
         // Okay, let's look up this part.
-        auto child_inode = parent.inode().lookup(part);
-        if (!child_inode) {
+        RefPtr<Custody> new_custody;
+        if (auto cached_custody = lookup_custody_cache(parent, part); cached_custody.has_value()) {
+            new_custody = cached_custody.release_value();
+        } else {
+            if (auto child_inode = parent.inode().lookup(part)) {
+                int mount_flags_for_child = parent.mount_flags();
+
+                // See if there's something mounted on the child; in that case
+                // we would need to return the guest inode, not the host inode.
+                if (auto mount = find_mount_for_host(*child_inode)) {
+                    child_inode = mount->guest();
+                    mount_flags_for_child = mount->flags();
+                }
+
+                auto new_custody_or_error = Custody::create(&parent, part, *child_inode, mount_flags_for_child);
+                if (new_custody_or_error.is_error())
+                    return new_custody_or_error.error();
+                new_custody = new_custody_or_error.release_value();
+            }
+            // Remember the result either way; a null custody is a negative
+            // entry that lets us skip the directory scan for missing names.
+            add_to_custody_cache(parent, part, new_custody);
+        }
+
+        if (!new_custody) {
             if (out_parent) {
                 // ENOENT with a non-null parent custody signals to caller that
                 // we found the immediate parent of the file, but the file itself
@@ -985,22 +1130,9 @@ KResultOr<NonnullRefPtr<Custody>> VFS::resolve_path_without_veil(StringView path
             return ENOENT;
         }
 
-        int mount_flags_for_child = parent.mount_flags();
-
-        // See if there's something mounted on the child; in that case
-        // we would need to return the guest inode, not the host inode.
-        if (auto mount = find_mount_for_host(*child_inode)) {
-            child_inode = mount->guest();
-            mount_flags_for_child = mount->flags();
-        }
-
-        auto new_custody = Custody::create(&parent, part, *child_inode, mount_flags_for_child);
-        if (new_custody.is_error())
-            return new_custody.error();
-
-        custody = new_custody.release_value();
+        custody = new_custody.release_nonnull();
 
-        if (child_inode->metadata().is_symlink()) {
+        if (custody->inode().metadata().is_symlink()) {
             if (!have_more_parts) {
                 if (options & O_NOFOLLOW)
                     return ELOOP;
@@ -1008,13 +1140,13 @@ KResultOr<NonnullRefPtr<Custody>> VFS::resolve_path_without_veil(StringView path
                     break;
             }
 
-            if (!safe_to_follow_symlink(*child_inode, parent_metadata))
+            if (!safe_to_follow_symlink(custody->inode(), parent_metadata))
                 return EACCES;
 
             if (auto result = validate_path_against_process_veil(custody->absolute_path(), options); result.is_error())
                 return result;
 
-            auto symlink_target = child_inode->resolve_as_link(parent, out_parent, options, symlink_recursion_level + 1);
+            auto symlink_target = custody->inode().resolve_as_link(parent, out_parent, options, symlink_recursion_level + 1);
             if (symlink_target.is_error() || !have_more_parts)
                 return symlink_target;
 
@@ -9,6 +9,7 @@
 #include <AK/Badge.h>
 #include <AK/Function.h>
 #include <AK/HashMap.h>
+#include <AK/IntrusiveList.h>
 #include <AK/NonnullOwnPtrVector.h>
 #include <AK/OwnPtr.h>
 #include <AK/RefPtr.h>
@@ -17,6 +18,7 @@
 #include <Kernel/FileSystem/InodeIdentifier.h>
 #include <Kernel/FileSystem/InodeMetadata.h>
 #include <Kernel/KResult.h>
+#include <Kernel/SpinLock.h>
 #include <Kernel/UnveilNode.h>
 
 namespace Kernel {
@@ -94,6 +96,7 @@ public:
     InodeIdentifier root_inode_id() const;
 
     void sync();
+    void trickle_sync();
 
     Custody& root_custody();
     KResultOr<NonnullRefPtr<Custody>> resolve_path(StringView path, Custody& base, RefPtr<Custody>* out_parent = nullptr, int options = 0, int symlink_recursion_level = 0);
@@ -114,8 +117,29 @@ private:
     Mount* find_mount_for_guest(Inode&);
     Mount* find_mount_for_guest(InodeIdentifier);
 
+    // Cache of recently resolved (parent directory, name) -> Custody mappings
+    // so repeated path resolutions skip Inode::lookup() and Custody creation.
+    // A null child custody is a negative entry: the name is known not to exist.
+    struct CustodyCacheEntry {
+        CustodyCacheEntry(Custody& parent, String name, RefPtr<Custody> child);
+        IntrusiveListNode<CustodyCacheEntry> list_node;
+        NonnullRefPtr<Custody> parent;
+        String name;
+        RefPtr<Custody> child;
+    };
+    static constexpr size_t max_custody_cache_entries = 256;
+
+    Optional<RefPtr<Custody>> lookup_custody_cache(Custody& parent, const StringView& name);
+    void add_to_custody_cache(Custody& parent, const StringView& name, RefPtr<Custody> child);
+    void invalidate_custody_cache(InodeIdentifier parent, const StringView& name);
+    void clear_custody_cache();
+
     Lock m_lock { "VFSLock" };
 
+    mutable SpinLock<u8> m_custody_cache_lock;
+    HashMap<u32, OwnPtr<CustodyCacheEntry>> m_custody_cache;
+    IntrusiveList<CustodyCacheEntry, RawPtr<CustodyCacheEntry>, &CustodyCacheEntry::list_node> m_custody_cache_lru;
+
     RefPtr<Inode> m_root_inode;
     Vector<Mount, 16> m_mounts;
     RefPtr<Custody> m_root_custody;
@@ -9,6 +9,7 @@
 namespace Kernel {
 
 class BlockDevice;
+struct CacheEntry;
 class CharacterDevice;
 class CoreDump;
 class Custody;
@@ -9,6 +9,7 @@
 #include <Kernel/Heap/SlabAllocator.h>
 #include <Kernel/Heap/kmalloc.h>
 #include <Kernel/SpinLock.h>
+#include <Kernel/Thread.h>
 #include <Kernel/VM/Region.h>
 
 #define SANITIZE_SLABS
@@ -39,6 +40,29 @@ public:
 
     void* alloc()
     {
+        // Fast path: grab a slab from this processor's magazine, which no
+        // other processor ever touches, so the global freelist cache line
+        // doesn't bounce between cores.
+        {
+            u32 prev_flags;
+            auto& processor = Processor::current();
+            processor.enter_critical(prev_flags);
+            auto cpu = processor.get_id();
+            if (cpu < max_processor_magazines) {
+                auto& magazine = m_magazines[cpu];
+                if (magazine.count > 0) {
+                    auto* free_slab = magazine.slabs[--magazine.count];
+                    processor.leave_critical(prev_flags);
+                    m_num_allocated++;
+#ifdef SANITIZE_SLABS
+                    memset(free_slab, SLAB_ALLOC_SCRUB_BYTE, slab_size());
+#endif
+                    return free_slab;
+                }
+            }
+            processor.leave_critical(prev_flags);
+        }
+
         FreeSlab* free_slab;
         {
             // We want to avoid being swapped out in the middle of this
@@ -77,6 +101,24 @@ public:
             memset(free_slab->padding, SLAB_DEALLOC_SCRUB_BYTE, sizeof(FreeSlab::padding));
 #endif
 
+        // Fast path: stash the slab in this processor's magazine.
+        {
+            u32 prev_flags;
+            auto& processor = Processor::current();
+            processor.enter_critical(prev_flags);
+            auto cpu = processor.get_id();
+            if (cpu < max_processor_magazines) {
+                auto& magazine = m_magazines[cpu];
+                if (magazine.count < max_magazine_slabs) {
+                    magazine.slabs[magazine.count++] = free_slab;
+                    processor.leave_critical(prev_flags);
+                    m_num_allocated--;
+                    return;
+                }
+            }
+            processor.leave_critical(prev_flags);
+        }
+
         // We want to avoid being swapped out in the middle of this
         ScopedCritical critical;
         FreeSlab* next_free = m_freelist.load(AK::memory_order_consume);
@@ -96,6 +138,17 @@ private:
         char padding[templated_slab_size - sizeof(FreeSlab*)];
     };
 
+    // Per-processor caches of recently freed slabs. Each magazine is only
+    // ever touched by its own processor (with interrupts off), so no locking
+    // is needed. Processors beyond the cap just use the shared freelist.
+    static constexpr size_t max_magazine_slabs = 32;
+    static constexpr size_t max_processor_magazines = 8;
+    struct alignas(64) ProcessorMagazine {
+        FreeSlab* slabs[max_magazine_slabs];
+        size_t count { 0 };
+    };
+    ProcessorMagazine m_magazines[max_processor_magazines];
+
     Atomic<FreeSlab*> m_freelist { nullptr };
     Atomic<ssize_t, AK::MemoryOrder::memory_order_relaxed> m_num_allocated;
     size_t m_slab_count;
@@ -109,9 +162,12 @@ static SlabAllocator<16> s_slab_allocator_16;
 static SlabAllocator<32> s_slab_allocator_32;
 static SlabAllocator<64> s_slab_allocator_64;
 static SlabAllocator<128> s_slab_allocator_128;
+static SlabAllocator<256> s_slab_allocator_256;
+static SlabAllocator<1024> s_slab_allocator_1024;
 
 #if ARCH(I386)
 static_assert(sizeof(Region) <= s_slab_allocator_128.slab_size());
+static_assert(sizeof(Thread) <= s_slab_allocator_1024.slab_size());
 #endif
 
 template<typename Callback>
@@ -121,6 +177,8 @@ void for_each_allocator(Callback callback)
     callback(s_slab_allocator_32);
     callback(s_slab_allocator_64);
     callback(s_slab_allocator_128);
+    callback(s_slab_allocator_256);
+    callback(s_slab_allocator_1024);
 }
 
 UNMAP_AFTER_INIT void slab_alloc_init()
@@ -129,6 +187,8 @@ UNMAP_AFTER_INIT void slab_alloc_init()
     s_slab_allocator_32.init(128 * KiB);
     s_slab_allocator_64.init(512 * KiB);
     s_slab_allocator_128.init(512 * KiB);
+    s_slab_allocator_256.init(128 * KiB);
+    s_slab_allocator_1024.init(512 * KiB);
 }
 
 void* slab_alloc(size_t slab_size)
@@ -141,6 +201,10 @@ void* slab_alloc(size_t slab_size)
         return s_slab_allocator_64.alloc();
     if (slab_size <= 128)
         return s_slab_allocator_128.alloc();
+    if (slab_size <= 256)
+        return s_slab_allocator_256.alloc();
+    if (slab_size <= 1024)
+        return s_slab_allocator_1024.alloc();
     VERIFY_NOT_REACHED();
 }
 
@@ -154,6 +218,10 @@ void slab_dealloc(void* ptr, size_t slab_size)
         return s_slab_allocator_64.dealloc(ptr);
     if (slab_size <= 128)
         return s_slab_allocator_128.dealloc(ptr);
+    if (slab_size <= 256)
+        return s_slab_allocator_256.dealloc(ptr);
+    if (slab_size <= 1024)
+        return s_slab_allocator_1024.dealloc(ptr);
     VERIFY_NOT_REACHED();
 }
 
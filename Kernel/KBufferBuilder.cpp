@@ -9,87 +9,90 @@
 
 namespace Kernel {
 
-inline bool KBufferBuilder::check_expand(size_t size)
+KBufferImpl* KBufferBuilder::current_chunk()
 {
-    if (!m_buffer)
-        return false;
-    if ((m_size + size) < m_buffer->capacity())
-        return true;
-    if (!m_can_expand)
-        return false;
-    if (Checked<size_t>::addition_would_overflow(m_size, size))
-        return false;
-    size_t new_buffer_size = m_size + size;
-    if (Checked<size_t>::addition_would_overflow(new_buffer_size, 1 * MiB))
-        return false;
-    new_buffer_size = page_round_up(new_buffer_size + 1 * MiB);
-    return m_buffer->expand(new_buffer_size);
-}
+    if (!m_chunks.is_empty() && m_chunks.last().size() < chunk_size)
+        return &m_chunks.last();
 
-bool KBufferBuilder::flush()
-{
-    if (!m_buffer)
-        return false;
-    m_buffer->set_size(m_size);
-    return true;
+    auto chunk = KBufferImpl::try_create_with_size(chunk_size, Region::Access::Read | Region::Access::Write, "KBufferBuilder chunk");
+    if (!chunk)
+        return nullptr;
+    // A chunk's size() is its fill level; try_create_with_size() sets it to the capacity.
+    chunk->set_size(0);
+    m_chunks.append(chunk.release_nonnull());
+    return &m_chunks.last();
 }
 
-OwnPtr<KBuffer> KBufferBuilder::build()
+bool KBufferBuilder::flush_to(RefPtr<KBufferImpl>& impl)
 {
-    if (!flush())
-        return {};
+    // If everything fits in a single chunk and the caller has no buffer yet,
+    // we can simply hand over the chunk without copying anything.
+    if (m_chunks.size() == 1 && !impl) {
+        impl = m_chunks.take_last();
+        m_total_size = 0;
+        return true;
+    }
 
-    return adopt_own_if_nonnull(new KBuffer(move(m_buffer)));
-}
+    if (!impl || impl->capacity() < m_total_size) {
+        auto new_impl = KBufferImpl::try_create_with_size(max(m_total_size, chunk_size), Region::Access::Read | Region::Access::Write);
+        if (!new_impl)
+            return false;
+        impl = new_impl.release_nonnull();
+    }
 
-KBufferBuilder::KBufferBuilder(bool can_expand)
-    : m_buffer(KBufferImpl::try_create_with_size(4 * MiB, Region::Access::Read | Region::Access::Write))
-    , m_can_expand(can_expand)
-{
+    size_t offset = 0;
+    for (auto& chunk : m_chunks) {
+        memcpy(impl->data() + offset, chunk.data(), chunk.size());
+        offset += chunk.size();
+    }
+    impl->set_size(offset);
+    m_chunks.clear();
+    m_total_size = 0;
+    return true;
 }
 
-KBufferBuilder::KBufferBuilder(RefPtr<KBufferImpl>& buffer, bool can_expand)
-    : m_buffer(buffer)
-    , m_can_expand(can_expand)
+OwnPtr<KBuffer> KBufferBuilder::build()
 {
-    if (!m_buffer)
-        m_buffer = buffer = KBufferImpl::try_create_with_size(4 * MiB, Region::Access::Read | Region::Access::Write);
+    RefPtr<KBufferImpl> impl;
+    if (!flush_to(impl))
+        return {};
+    return adopt_own_if_nonnull(new KBuffer(move(impl)));
 }
 
 void KBufferBuilder::append_bytes(ReadonlyBytes bytes)
 {
-    if (!check_expand(bytes.size()))
-        return;
-    memcpy(insertion_ptr(), bytes.data(), bytes.size());
-    m_size += bytes.size();
+    const u8* data = bytes.data();
+    size_t size = bytes.size();
+    while (size > 0) {
+        auto* chunk = current_chunk();
+        if (!chunk)
+            return;
+        size_t bytes_to_copy = min(size, chunk_size - chunk->size());
+        memcpy(chunk->data() + chunk->size(), data, bytes_to_copy);
+        chunk->set_size(chunk->size() + bytes_to_copy);
+        m_total_size += bytes_to_copy;
+        data += bytes_to_copy;
+        size -= bytes_to_copy;
+    }
 }
 
 void KBufferBuilder::append(const StringView& str)
 {
     if (str.is_empty())
         return;
-    if (!check_expand(str.length()))
-        return;
-    memcpy(insertion_ptr(), str.characters_without_null_termination(), str.length());
-    m_size += str.length();
+    append_bytes(str.bytes());
 }
 
 void KBufferBuilder::append(const char* characters, int length)
 {
     if (!length)
         return;
-    if (!check_expand(length))
-        return;
-    memcpy(insertion_ptr(), characters, length);
-    m_size += length;
+    append_bytes({ (const u8*)characters, (size_t)length });
 }
 
 void KBufferBuilder::append(char ch)
 {
-    if (!check_expand(1))
-        return;
-    insertion_ptr()[0] = ch;
-    m_size += 1;
+    append_bytes({ (const u8*)&ch, 1 });
 }
 
 void KBufferBuilder::append_escaped_for_json(const StringView& string)
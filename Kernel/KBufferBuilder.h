@@ -6,18 +6,22 @@
 
 #pragma once
 
+#include <AK/NonnullRefPtrVector.h>
 #include <AK/String.h>
 #include <Kernel/KBuffer.h>
 #include <stdarg.h>
 
 namespace Kernel {
 
+// KBufferBuilder appends into a chain of fixed-size KBufferImpl chunks
+// instead of growing (and copying) one large buffer. The chunks are only
+// materialized into a single flat buffer when build() or flush_to() is
+// called, so building a large ProcFS document copies each byte once.
 class KBufferBuilder {
 public:
     using OutputType = KBuffer;
 
-    explicit KBufferBuilder(bool can_expand = false);
-    explicit KBufferBuilder(RefPtr<KBufferImpl>&, bool can_expand = false);
+    KBufferBuilder() = default;
     KBufferBuilder(KBufferBuilder&&) = default;
     ~KBufferBuilder() = default;
 
@@ -38,21 +42,18 @@ public:
         append_bytes(builder.string_view().bytes());
     }
 
-    bool flush();
+    bool flush_to(RefPtr<KBufferImpl>&);
     OwnPtr<KBuffer> build();
 
+    size_t length() const { return m_total_size; }
+
 private:
-    bool check_expand(size_t);
-    u8* insertion_ptr()
-    {
-        if (!m_buffer)
-            return nullptr;
-        return m_buffer->data() + m_size;
-    }
+    static constexpr size_t chunk_size = 64 * KiB;
+
+    KBufferImpl* current_chunk();
 
-    RefPtr<KBufferImpl> m_buffer;
-    size_t m_size { 0 };
-    bool m_can_expand { false };
+    NonnullRefPtrVector<KBufferImpl, 4> m_chunks;
+    size_t m_total_size { 0 };
 };
 
 }
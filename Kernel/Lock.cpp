@@ -9,6 +9,8 @@
 #include <Kernel/Debug.h>
 #include <Kernel/KSyms.h>
 #include <Kernel/Lock.h>
+#include <Kernel/LockContentionTracker.h>
+#include <Kernel/Time/TimeManagement.h>
 #include <Kernel/Thread.h>
 
 namespace Kernel {
@@ -106,9 +108,19 @@ void Lock::lock(Mode mode)
         default:
             VERIFY_NOT_REACHED();
         }
+        bool track_contention = LockContentionTracker::is_enabled();
+        u32 holder_tid = 0;
+        if (track_contention && m_holder)
+            holder_tid = m_holder->tid().value();
         m_lock.store(false, AK::memory_order_release);
         dbgln_if(LOCK_TRACE_DEBUG, "Lock::lock @ {} ({}) waiting...", this, m_name);
-        m_queue.wait_forever(m_name);
+        if (!track_contention) {
+            m_queue.wait_forever(m_name);
+        } else {
+            auto wait_start = TimeManagement::the().monotonic_time();
+            m_queue.wait_forever(m_name);
+            LockContentionTracker::the().record(m_name, holder_tid, TimeManagement::the().monotonic_time() - wait_start);
+        }
         dbgln_if(LOCK_TRACE_DEBUG, "Lock::lock @ {} ({}) waited", this, m_name);
     }
 }
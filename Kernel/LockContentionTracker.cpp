@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonArraySerializer.h>
+#include <AK/JsonObjectSerializer.h>
+#include <AK/Singleton.h>
+#include <Kernel/KBufferBuilder.h>
+#include <Kernel/LockContentionTracker.h>
+
+namespace Kernel {
+
+Atomic<bool> LockContentionTracker::s_enabled;
+
+static AK::Singleton<LockContentionTracker> s_the;
+
+LockContentionTracker& LockContentionTracker::the()
+{
+    return *s_the;
+}
+
+void LockContentionTracker::record(const char* lock_name, u32 holder_tid, const Time& wait_time)
+{
+    if (!lock_name)
+        lock_name = "(unnamed)";
+    u64 wait_ns = (u64)wait_time.to_nanoseconds();
+
+    ScopedSpinLock lock(m_lock);
+    Entry* entry = nullptr;
+    for (size_t i = 0; i < m_entry_count; ++i) {
+        if (m_entries[i].name == lock_name) {
+            entry = &m_entries[i];
+            break;
+        }
+    }
+    if (!entry) {
+        if (m_entry_count == max_entries) {
+            ++m_dropped_records;
+            return;
+        }
+        entry = &m_entries[m_entry_count++];
+        entry->name = lock_name;
+    }
+
+    ++entry->contentions;
+    entry->total_wait_ns += wait_ns;
+    if (wait_ns > entry->longest_wait_ns)
+        entry->longest_wait_ns = wait_ns;
+    entry->last_holder_tid = holder_tid;
+
+    u64 wait_us = wait_ns / 1000;
+    size_t bucket = 0;
+    while (wait_us > 1 && bucket < bucket_count - 1) {
+        wait_us >>= 1;
+        ++bucket;
+    }
+    ++entry->wait_histogram[bucket];
+}
+
+void LockContentionTracker::dump(KBufferBuilder& builder)
+{
+    ScopedSpinLock lock(m_lock);
+    JsonArraySerializer array { builder };
+    for (size_t i = 0; i < m_entry_count; ++i) {
+        auto& entry = m_entries[i];
+        auto obj = array.add_object();
+        obj.add("name", entry.name);
+        obj.add("contentions", entry.contentions);
+        obj.add("total_wait_ns", entry.total_wait_ns);
+        obj.add("longest_wait_ns", entry.longest_wait_ns);
+        obj.add("last_holder_tid", entry.last_holder_tid);
+        auto histogram = obj.add_array("wait_histogram_us");
+        for (size_t bucket = 0; bucket < bucket_count; ++bucket)
+            histogram.add(entry.wait_histogram[bucket]);
+        histogram.finish();
+    }
+    array.finish();
+}
+
+}
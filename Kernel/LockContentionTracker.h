@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Time.h>
+#include <AK/Types.h>
+#include <Kernel/SpinLock.h>
+
+namespace Kernel {
+
+class KBufferBuilder;
+
+// Optional bookkeeping for Lock: when enabled (via /proc/sys/lock_contention),
+// every time a thread has to sleep on a Lock we record who held it and for
+// how long the sleeper waited, aggregated per lock name into a power-of-two
+// microsecond histogram. /proc/lock_contention dumps the table as JSON.
+// When disabled the only cost on the contended path is one relaxed load.
+class LockContentionTracker {
+public:
+    static LockContentionTracker& the();
+
+    static bool is_enabled() { return s_enabled.load(AK::MemoryOrder::memory_order_relaxed); }
+    static void set_enabled(bool enabled) { s_enabled.store(enabled, AK::MemoryOrder::memory_order_relaxed); }
+
+    void record(const char* lock_name, u32 holder_tid, const Time& wait_time);
+    void dump(KBufferBuilder&);
+
+    // Buckets are [2^i, 2^(i+1)) microseconds; the last one collects the rest.
+    static constexpr size_t bucket_count = 16;
+
+private:
+    struct Entry {
+        const char* name { nullptr };
+        u64 contentions { 0 };
+        u64 total_wait_ns { 0 };
+        u64 longest_wait_ns { 0 };
+        u32 last_holder_tid { 0 };
+        u64 wait_histogram[bucket_count] {};
+    };
+
+    // Locks are keyed by their name literal; anonymous locks aggregate into
+    // one "(unnamed)" entry. A fixed table keeps record() allocation-free.
+    static constexpr size_t max_entries = 64;
+    Entry m_entries[max_entries];
+    size_t m_entry_count { 0 };
+    u64 m_dropped_records { 0 };
+    mutable SpinLock<u8> m_lock;
+
+    static Atomic<bool> s_enabled;
+};
+
+}
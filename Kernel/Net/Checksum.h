@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Assertions.h>
+#include <AK/Endian.h>
+#include <AK/Types.h>
+
+namespace Kernel {
+
+// Ones-complement checksum (RFC 1071) over one or more buffers.
+// Words are accumulated 32 bits at a time into a 64-bit sum and only
+// folded at the end, so the hot loop is a handful of adds per 16 bytes
+// instead of a compare-and-fold per 16-bit word. The sum is kept in raw
+// (network) byte order and converted once in finish().
+class InternetChecksum {
+public:
+    void add(const void* ptr, size_t count)
+    {
+        // An odd-length chunk is padded to a word boundary, so only the
+        // final chunk may have an odd length.
+        VERIFY(!m_saw_odd_chunk);
+
+        auto* data = (const u8*)ptr;
+        u64 sum = m_sum;
+        while (count >= 16) {
+            u32 w0, w1, w2, w3;
+            __builtin_memcpy(&w0, data, 4);
+            __builtin_memcpy(&w1, data + 4, 4);
+            __builtin_memcpy(&w2, data + 8, 4);
+            __builtin_memcpy(&w3, data + 12, 4);
+            sum += (u64)w0 + w1 + w2 + w3;
+            data += 16;
+            count -= 16;
+        }
+        while (count >= 4) {
+            u32 w;
+            __builtin_memcpy(&w, data, 4);
+            sum += w;
+            data += 4;
+            count -= 4;
+        }
+        if (count >= 2) {
+            u16 w;
+            __builtin_memcpy(&w, data, 2);
+            sum += w;
+            data += 2;
+            count -= 2;
+        }
+        if (count) {
+            u16 w = 0;
+            __builtin_memcpy(&w, data, 1);
+            sum += w;
+            m_saw_odd_chunk = true;
+        }
+        m_sum = sum;
+    }
+
+    NetworkOrdered<u16> finish()
+    {
+        u64 sum = m_sum;
+        sum = (sum & 0xffffffff) + (sum >> 32);
+        while (sum >> 16)
+            sum = (sum & 0xffff) + (sum >> 16);
+        return ~AK::convert_between_host_and_network_endian((u16)sum) & 0xffff;
+    }
+
+private:
+    u64 m_sum { 0 };
+    bool m_saw_odd_chunk { false };
+};
+
+inline NetworkOrdered<u16> internet_checksum(const void* ptr, size_t count)
+{
+    InternetChecksum checksum;
+    checksum.add(ptr, count);
+    return checksum.finish();
+}
+
+}
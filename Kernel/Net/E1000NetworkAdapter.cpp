@@ -7,6 +7,7 @@
 #include <AK/MACAddress.h>
 #include <Kernel/Debug.h>
 #include <Kernel/Net/E1000NetworkAdapter.h>
+#include <Kernel/Net/EthernetFrameHeader.h>
 #include <Kernel/PCI/IDs.h>
 
 namespace Kernel {
@@ -35,6 +36,7 @@ namespace Kernel {
 #define REG_RXDCTL 0x3828           // RX Descriptor Control
 #define REG_RADV 0x282C             // RX Int. Absolute Delay Timer
 #define REG_RSRPD 0x2C00            // RX Small Packet Detect Interrupt
+#define REG_RXCSUM 0x5000           // RX Checksum Control
 #define REG_TIPG 0x0410             // Transmit Inter Packet Gap
 #define ECTRL_SLU 0x40              //set link up
 #define RCTL_EN (1 << 1)            // Receiver Enable
@@ -58,6 +60,9 @@ namespace Kernel {
 #define RCTL_DPF (1 << 22)          // Discard Pause Frames
 #define RCTL_PMCF (1 << 23)         // Pass MAC Control Frames
 #define RCTL_SECRC (1 << 26)        // Strip Ethernet CRC
+#define RXCSUM_PCSS_SHIFT 0    // Packet Checksum Start (byte offset)
+#define RXCSUM_IPOFL (1 << 8)  // IP Checksum Offload Enable
+#define RXCSUM_TUOFL (1 << 9)  // TCP/UDP Checksum Offload Enable
 
 // Buffer Sizes
 #define RCTL_BSIZE_256 (3 << 16)
@@ -118,6 +123,14 @@ namespace Kernel {
 #define INTERRUPT_TXD_LOW (1 << 15)
 #define INTERRUPT_SRPD (1 << 16)
 
+// RX descriptor status/error bits
+
+#define RXD_STATUS_DD (1 << 0)   // Descriptor Done
+#define RXD_STATUS_IXSM (1 << 2) // Ignore Checksum Indication
+#define RXD_ERROR_TCPE (1 << 5)  // TCP/UDP Checksum Error
+#define RXD_ERROR_IPE (1 << 6)   // IP Checksum Error
+#define RXD_ERROR_RXE (1 << 7)   // RX Data Error
+
 // https://www.intel.com/content/dam/doc/manual/pci-pci-x-family-gbe-controllers-software-dev-manual.pdf Section 5.2
 static bool is_valid_device_id(u16 device_id)
 {
@@ -296,7 +309,7 @@ bool E1000NetworkAdapter::link_up()
 
 UNMAP_AFTER_INIT void E1000NetworkAdapter::initialize_rx_descriptors()
 {
-    auto* rx_descriptors = (e1000_tx_desc*)m_rx_descriptors_region->vaddr().as_ptr();
+    auto* rx_descriptors = (e1000_rx_desc*)m_rx_descriptors_region->vaddr().as_ptr();
     for (size_t i = 0; i < number_of_rx_descriptors; ++i) {
         auto& descriptor = rx_descriptors[i];
         auto region = MM.allocate_contiguous_kernel_region(8192, "E1000 RX buffer", Region::Access::Read | Region::Access::Write);
@@ -313,6 +326,11 @@ UNMAP_AFTER_INIT void E1000NetworkAdapter::initialize_rx_descriptors()
     out32(REG_RXDESCTAIL, number_of_rx_descriptors - 1);
 
     out32(REG_RCTRL, RCTL_EN | RCTL_SBP | RCTL_UPE | RCTL_MPE | RCTL_LBM_NONE | RTCL_RDMTS_HALF | RCTL_BAM | RCTL_SECRC | RCTL_BSIZE_8192);
+
+    // Have the hardware verify IP and TCP/UDP checksums as frames come in,
+    // starting past the 14-byte Ethernet header. Frames that fail are
+    // dropped in receive() so the stack never sees them.
+    out32(REG_RXCSUM, (sizeof(EthernetFrameHeader) << RXCSUM_PCSS_SHIFT) | RXCSUM_IPOFL | RXCSUM_TUOFL);
 }
 
 UNMAP_AFTER_INIT void E1000NetworkAdapter::initialize_tx_descriptors()
@@ -395,16 +413,32 @@ u32 E1000NetworkAdapter::in32(u16 address)
 }
 
 void E1000NetworkAdapter::send_raw(ReadonlyBytes payload)
+{
+    [[maybe_unused]] auto result = do_send(payload, nullptr, 0);
+}
+
+KResult E1000NetworkAdapter::send_scattered(ReadonlyBytes header, const UserOrKernelBuffer& payload, size_t payload_size)
+{
+    return do_send(header, &payload, payload_size);
+}
+
+KResult E1000NetworkAdapter::do_send(ReadonlyBytes header, const UserOrKernelBuffer* payload, size_t payload_size)
 {
     disable_irq();
+    size_t frame_size = header.size() + payload_size;
     size_t tx_current = in32(REG_TXDESCTAIL) % number_of_tx_descriptors;
-    dbgln_if(E1000_DEBUG, "E1000: Sending packet ({} bytes)", payload.size());
+    dbgln_if(E1000_DEBUG, "E1000: Sending packet ({} bytes)", frame_size);
     auto* tx_descriptors = (e1000_tx_desc*)m_tx_descriptors_region->vaddr().as_ptr();
     auto& descriptor = tx_descriptors[tx_current];
-    VERIFY(payload.size() <= 8192);
-    auto* vptr = (void*)m_tx_buffers_regions[tx_current].vaddr().as_ptr();
-    memcpy(vptr, payload.data(), payload.size());
-    descriptor.length = payload.size();
+    VERIFY(frame_size <= 8192);
+    auto* vptr = (u8*)m_tx_buffers_regions[tx_current].vaddr().as_ptr();
+    // Gather the header and payload straight into the transmit buffer.
+    memcpy(vptr, header.data(), header.size());
+    if (payload && !payload->read(vptr + header.size(), payload_size)) {
+        enable_irq();
+        return EFAULT;
+    }
+    descriptor.length = frame_size;
     descriptor.status = 0;
     descriptor.cmd = CMD_EOP | CMD_IFCS | CMD_RS;
     dbgln_if(E1000_DEBUG, "E1000: Using tx descriptor {} (head is at {})", tx_current, in32(REG_TXDESCHEAD));
@@ -420,23 +454,34 @@ void E1000NetworkAdapter::send_raw(ReadonlyBytes payload)
         m_wait_queue.wait_forever("E1000NetworkAdapter");
     }
     dbgln_if(E1000_DEBUG, "E1000: Sent packet, status is now {:#02x}!", (u8)descriptor.status);
+    return KSuccess;
 }
 
 void E1000NetworkAdapter::receive()
 {
-    auto* rx_descriptors = (e1000_tx_desc*)m_rx_descriptors_region->vaddr().as_ptr();
+    auto* rx_descriptors = (e1000_rx_desc*)m_rx_descriptors_region->vaddr().as_ptr();
     u32 rx_current;
     for (;;) {
         rx_current = in32(REG_RXDESCTAIL) % number_of_rx_descriptors;
         rx_current = (rx_current + 1) % number_of_rx_descriptors;
-        if (!(rx_descriptors[rx_current].status & 1))
+        auto& descriptor = rx_descriptors[rx_current];
+        if (!(descriptor.status & RXD_STATUS_DD))
             break;
+        u8 status = descriptor.status;
+        u8 errors = descriptor.errors;
         auto* buffer = m_rx_buffers_regions[rx_current].vaddr().as_ptr();
-        u16 length = rx_descriptors[rx_current].length;
+        u16 length = descriptor.length;
         VERIFY(length <= 8192);
-        dbgln_if(E1000_DEBUG, "E1000: Received 1 packet @ {:p} ({} bytes)", buffer, length);
-        did_receive({ buffer, length });
-        rx_descriptors[rx_current].status = 0;
+        // The hardware has already verified the IP and TCP/UDP checksums
+        // (unless it tells us to ignore its verdict, e.g. for fragments).
+        bool bad_checksum = !(status & RXD_STATUS_IXSM) && (errors & (RXD_ERROR_IPE | RXD_ERROR_TCPE));
+        if (bad_checksum || (errors & RXD_ERROR_RXE)) {
+            dbgln_if(E1000_DEBUG, "E1000: Dropping bad packet ({} bytes, errors {:#02x})", length, errors);
+        } else {
+            dbgln_if(E1000_DEBUG, "E1000: Received 1 packet @ {:p} ({} bytes)", buffer, length);
+            did_receive({ buffer, length });
+        }
+        descriptor.status = 0;
         out32(REG_RXDESCTAIL, rx_current);
     }
 }
@@ -26,6 +26,7 @@ public:
     virtual ~E1000NetworkAdapter() override;
 
     virtual void send_raw(ReadonlyBytes) override;
+    virtual KResult send_scattered(ReadonlyBytes header, const UserOrKernelBuffer& payload, size_t payload_size) override;
     virtual bool link_up() override;
 
     virtual const char* purpose() const override { return class_name(); }
@@ -53,6 +54,8 @@ private:
         volatile uint16_t special { 0 };
     };
 
+    KResult do_send(ReadonlyBytes header, const UserOrKernelBuffer* payload, size_t payload_size);
+
     void detect_eeprom();
     u32 read_eeprom(u8 address);
     void read_mac_address();
@@ -11,6 +11,7 @@
 #include <AK/IPv4Address.h>
 #include <AK/String.h>
 #include <AK/Types.h>
+#include <Kernel/Net/Checksum.h>
 
 namespace Kernel {
 
@@ -25,8 +26,6 @@ enum class IPv4PacketFlags : u16 {
     MoreFragments = 0x2000,
 };
 
-NetworkOrdered<u16> internet_checksum(const void*, size_t);
-
 class [[gnu::packed]] IPv4Packet {
 public:
     u8 version() const { return (m_version_and_ihl >> 4) & 0xf; }
@@ -104,19 +103,4 @@ private:
 
 static_assert(sizeof(IPv4Packet) == 20);
 
-inline NetworkOrdered<u16> internet_checksum(const void* ptr, size_t count)
-{
-    u32 checksum = 0;
-    auto* w = (const u16*)ptr;
-    while (count > 1) {
-        checksum += AK::convert_between_host_and_network_endian(*w++);
-        if (checksum & 0x80000000)
-            checksum = (checksum & 0xffff) | (checksum >> 16);
-        count -= 2;
-    }
-    while (checksum >> 16)
-        checksum = (checksum & 0xffff) + (checksum >> 16);
-    return ~checksum & 0xffff;
-}
-
 }
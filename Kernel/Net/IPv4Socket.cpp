@@ -62,9 +62,6 @@ IPv4Socket::IPv4Socket(int type, int protocol)
 {
     dbgln_if(IPV4_SOCKET_DEBUG, "IPv4Socket({}) created with type={}, protocol={}", this, type, protocol);
     m_buffer_mode = type == SOCK_STREAM ? BufferMode::Bytes : BufferMode::Packets;
-    if (m_buffer_mode == BufferMode::Bytes) {
-        m_scratch_buffer = KBuffer::create_with_size(65536);
-    }
     Locker locker(all_sockets().lock());
     all_sockets().resource().set(this);
 }
@@ -400,11 +397,12 @@ bool IPv4Socket::did_receive(const IPv4Address& source_address, u16 source_port,
             VERIFY(m_can_read);
             return false;
         }
-        auto scratch_buffer = UserOrKernelBuffer::for_kernel_buffer(m_scratch_buffer.value().data());
-        auto nreceived_or_error = protocol_receive(ReadonlyBytes { packet.data(), packet.size() }, scratch_buffer, m_scratch_buffer.value().size(), 0);
-        if (nreceived_or_error.is_error())
-            return false;
-        ssize_t nwritten = m_receive_buffer.write(scratch_buffer, nreceived_or_error.value());
+        // Copy the payload directly out of the packet instead of bouncing it
+        // through a scratch buffer; at tens of MB/s that intermediate copy
+        // costs real throughput.
+        auto payload = protocol_payload(packet);
+        auto payload_buffer = UserOrKernelBuffer::for_kernel_buffer(const_cast<u8*>(payload.data()));
+        ssize_t nwritten = m_receive_buffer.write(payload_buffer, payload.size());
         if (nwritten < 0)
             return false;
         set_can_read(!m_receive_buffer.is_empty());
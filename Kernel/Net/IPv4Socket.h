@@ -77,6 +77,10 @@ protected:
     virtual KResult protocol_bind() { return KSuccess; }
     virtual KResult protocol_listen() { return KSuccess; }
     virtual KResultOr<size_t> protocol_receive(ReadonlyBytes /* raw_ipv4_packet */, UserOrKernelBuffer&, size_t, int) { return ENOTIMPL; }
+    // Returns the protocol payload inside a raw IPv4 packet, so the buffered
+    // receive path can copy it straight into the receive buffer without
+    // bouncing it through a scratch buffer first.
+    virtual ReadonlyBytes protocol_payload(ReadonlyBytes raw_ipv4_packet) const { return raw_ipv4_packet; }
     virtual KResultOr<size_t> protocol_send(const UserOrKernelBuffer&, size_t) { return ENOTIMPL; }
     virtual KResult protocol_connect(FileDescription&, ShouldBlock) { return KSuccess; }
     virtual KResultOr<u16> protocol_allocate_local_port() { return ENOPROTOOPT; }
@@ -123,7 +127,6 @@ private:
 
     BufferMode m_buffer_mode { BufferMode::Packets };
 
-    Optional<KBuffer> m_scratch_buffer;
 };
 
 }
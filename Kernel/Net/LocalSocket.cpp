@@ -374,6 +374,33 @@ String LocalSocket::absolute_path(const FileDescription& description) const
     return builder.to_string();
 }
 
+KResult LocalSocket::setsockopt(int level, int option, Userspace<const void*> user_value, socklen_t user_value_size)
+{
+    if (level != SOL_SOCKET)
+        return Socket::setsockopt(level, option, user_value, user_value_size);
+
+    switch (option) {
+    case SO_SNDBUF:
+    case SO_RCVBUF: {
+        if (user_value_size != sizeof(int))
+            return EINVAL;
+        int requested_capacity;
+        if (!copy_from_user(&requested_capacity, static_ptr_cast<const int*>(user_value)))
+            return EFAULT;
+        if (requested_capacity < (int)minimum_buffer_capacity || (size_t)requested_capacity > maximum_buffer_capacity)
+            return EINVAL;
+        // One LocalSocket object carries both directions and there's no way
+        // to tell which end is asking here, so the new capacity applies to
+        // both buffers.
+        if (auto result = m_for_client.set_capacity(requested_capacity); result.is_error())
+            return result;
+        return m_for_server.set_capacity(requested_capacity);
+    }
+    default:
+        return Socket::setsockopt(level, option, user_value, user_value_size);
+    }
+}
+
 KResult LocalSocket::getsockopt(FileDescription& description, int level, int option, Userspace<void*> value, Userspace<socklen_t*> value_size)
 {
     if (level != SOL_SOCKET)
@@ -385,9 +412,20 @@ KResult LocalSocket::getsockopt(FileDescription& description, int level, int opt
 
     switch (option) {
     case SO_SNDBUF:
-        TODO();
-    case SO_RCVBUF:
-        TODO();
+    case SO_RCVBUF: {
+        if (size < sizeof(int))
+            return EINVAL;
+        auto* buffer = option == SO_SNDBUF ? send_buffer_for(description) : receive_buffer_for(description);
+        if (!buffer)
+            return EINVAL;
+        int capacity = buffer->capacity();
+        if (!copy_to_user(static_ptr_cast<int*>(value), &capacity))
+            return EFAULT;
+        size = sizeof(int);
+        if (!copy_to_user(value_size, &size))
+            return EFAULT;
+        return KSuccess;
+    }
     case SO_PEERCRED: {
         if (size < sizeof(ucred))
             return EINVAL;
@@ -70,12 +70,22 @@ void NetworkAdapter::send(const MACAddress& destination, const ARPPacket& packet
     eth->set_source(mac_address());
     eth->set_destination(destination);
     eth->set_ether_type(EtherType::ARP);
-    m_packets_out++;
-    m_bytes_out += size_in_bytes;
+    m_packets_out.increment();
+    m_bytes_out.add(size_in_bytes);
     memcpy(eth->payload(), &packet, sizeof(ARPPacket));
     send_raw({ (const u8*)eth, size_in_bytes });
 }
 
+KResult NetworkAdapter::send_scattered(ReadonlyBytes header, const UserOrKernelBuffer& payload, size_t payload_size)
+{
+    auto buffer = NetworkByteBuffer::create_zeroed(header.size() + payload_size);
+    memcpy(buffer.data(), header.data(), header.size());
+    if (!payload.read(buffer.data() + header.size(), payload_size))
+        return EFAULT;
+    send_raw({ buffer.data(), header.size() + payload_size });
+    return KSuccess;
+}
+
 KResult NetworkAdapter::send_ipv4(const IPv4Address& source_ipv4, const MACAddress& destination_mac, const IPv4Address& destination_ipv4, IPv4Protocol protocol, const UserOrKernelBuffer& payload, size_t payload_size, u8 ttl)
 {
     size_t ipv4_packet_size = sizeof(IPv4Packet) + payload_size;
@@ -83,12 +93,19 @@ KResult NetworkAdapter::send_ipv4(const IPv4Address& source_ipv4, const MACAddre
         return send_ipv4_fragmented(source_ipv4, destination_mac, destination_ipv4, protocol, payload, payload_size, ttl);
 
     size_t ethernet_frame_size = sizeof(EthernetFrameHeader) + sizeof(IPv4Packet) + payload_size;
-    auto buffer = NetworkByteBuffer::create_zeroed(ethernet_frame_size);
-    auto& eth = *(EthernetFrameHeader*)buffer.data();
+
+    // Only the headers need assembling here; the adapter gathers the payload
+    // into the frame itself, so there's no per-packet frame allocation.
+    struct [[gnu::packed]] {
+        EthernetFrameHeader eth;
+        IPv4Packet ipv4;
+    } header;
+    memset(&header, 0, sizeof(header));
+    auto& eth = header.eth;
     eth.set_source(mac_address());
     eth.set_destination(destination_mac);
     eth.set_ether_type(EtherType::IPv4);
-    auto& ipv4 = *(IPv4Packet*)eth.payload();
+    auto& ipv4 = header.ipv4;
     ipv4.set_version(4);
     ipv4.set_internet_header_length(5);
     ipv4.set_source(source_ipv4);
@@ -98,13 +115,10 @@ KResult NetworkAdapter::send_ipv4(const IPv4Address& source_ipv4, const MACAddre
     ipv4.set_ident(1);
     ipv4.set_ttl(ttl);
     ipv4.set_checksum(ipv4.compute_checksum());
-    m_packets_out++;
-    m_bytes_out += ethernet_frame_size;
+    m_packets_out.increment();
+    m_bytes_out.add(ethernet_frame_size);
 
-    if (!payload.read(ipv4.payload(), payload_size))
-        return EFAULT;
-    send_raw({ (const u8*)&eth, ethernet_frame_size });
-    return KSuccess;
+    return send_scattered({ (const u8*)&header, sizeof(header) }, payload, payload_size);
 }
 
 KResult NetworkAdapter::send_ipv4_fragmented(const IPv4Address& source_ipv4, const MACAddress& destination_mac, const IPv4Address& destination_ipv4, IPv4Protocol protocol, const UserOrKernelBuffer& payload, size_t payload_size, u8 ttl)
@@ -138,8 +152,8 @@ KResult NetworkAdapter::send_ipv4_fragmented(const IPv4Address& source_ipv4, con
         ipv4.set_ttl(ttl);
         ipv4.set_fragment_offset(packet_index * number_of_blocks_in_fragment);
         ipv4.set_checksum(ipv4.compute_checksum());
-        m_packets_out++;
-        m_bytes_out += ethernet_frame_size;
+        m_packets_out.increment();
+        m_bytes_out.add(ethernet_frame_size);
         if (!payload.read(ipv4.payload(), packet_index * packet_boundary_size, packet_payload_size))
             return EFAULT;
         send_raw({ (const u8*)&eth, ethernet_frame_size });
@@ -150,8 +164,8 @@ KResult NetworkAdapter::send_ipv4_fragmented(const IPv4Address& source_ipv4, con
 void NetworkAdapter::did_receive(ReadonlyBytes payload)
 {
     InterruptDisabler disabler;
-    m_packets_in++;
-    m_bytes_in += payload.size();
+    m_packets_in.increment();
+    m_bytes_in.add(payload.size());
 
     if (m_packet_queue_size == max_packet_buffers) {
         // FIXME: Keep track of the number of dropped packets
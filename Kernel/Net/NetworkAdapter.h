@@ -18,6 +18,7 @@
 #include <Kernel/Net/ICMP.h>
 #include <Kernel/Net/IPv4.h>
 #include <Kernel/PCI/Definitions.h>
+#include <Kernel/PerProcessorCounter.h>
 #include <Kernel/UserOrKernelBuffer.h>
 
 namespace Kernel {
@@ -55,6 +56,11 @@ public:
     void set_ipv4_gateway(const IPv4Address&);
 
     void send(const MACAddress&, const ARPPacket&);
+    // Scatter-gather transmit: emits one frame consisting of header followed
+    // by payload_size bytes of payload. Adapters that copy frames into a
+    // transmit ring override this to write both pieces straight into the ring
+    // buffer; the default assembles the frame and hands it to send_raw().
+    virtual KResult send_scattered(ReadonlyBytes header, const UserOrKernelBuffer& payload, size_t payload_size);
     KResult send_ipv4(const IPv4Address& source_ipv4, const MACAddress&, const IPv4Address&, IPv4Protocol, const UserOrKernelBuffer& payload, size_t payload_size, u8 ttl);
     KResult send_ipv4_fragmented(const IPv4Address& source_ipv4, const MACAddress&, const IPv4Address&, IPv4Protocol, const UserOrKernelBuffer& payload, size_t payload_size, u8 ttl);
 
@@ -65,10 +71,10 @@ public:
     u32 mtu() const { return m_mtu; }
     void set_mtu(u32 mtu) { m_mtu = mtu; }
 
-    u32 packets_in() const { return m_packets_in; }
-    u32 bytes_in() const { return m_bytes_in; }
-    u32 packets_out() const { return m_packets_out; }
-    u32 bytes_out() const { return m_bytes_out; }
+    u64 packets_in() const { return m_packets_in.sum(); }
+    u64 bytes_in() const { return m_bytes_in.sum(); }
+    u64 packets_out() const { return m_packets_out.sum(); }
+    u64 bytes_out() const { return m_bytes_out.sum(); }
 
     Function<void()> on_receive;
 
@@ -110,10 +116,10 @@ private:
     size_t m_packet_queue_size { 0 };
     PacketList m_unused_packets;
     String m_name;
-    u32 m_packets_in { 0 };
-    u32 m_bytes_in { 0 };
-    u32 m_packets_out { 0 };
-    u32 m_bytes_out { 0 };
+    PerProcessorCounter m_packets_in;
+    PerProcessorCounter m_bytes_in;
+    PerProcessorCounter m_packets_out;
+    PerProcessorCounter m_bytes_out;
     u32 m_mtu { 1500 };
 };
 
@@ -41,6 +41,10 @@ void NetworkTask::spawn()
 {
     RefPtr<Thread> thread;
     Process::create_kernel_process(thread, "NetworkTask", NetworkTask_main, nullptr);
+    // Keep packet processing off the bootstrap processor, which already
+    // handles most interrupts and the system tick.
+    if (Processor::count() > 1)
+        thread->set_affinity(~1u);
     network_task = thread;
 }
 
@@ -54,7 +58,7 @@ void NetworkTask_main(void*)
     delayed_ack_sockets = new HashTable<RefPtr<TCPSocket>>;
 
     WaitQueue packet_wait_queue;
-    int pending_packets = 0;
+    NonnullRefPtrVector<NetworkAdapter> adapters;
     NetworkAdapter::for_each([&](auto& adapter) {
         dmesgln("NetworkTask: {} network adapter found: hw={}", adapter.class_name(), adapter.mac_address().to_string());
 
@@ -65,43 +69,20 @@ void NetworkTask_main(void*)
         }
 
         adapter.on_receive = [&]() {
-            pending_packets++;
             packet_wait_queue.wake_all();
         };
+        adapters.append(adapter);
     });
 
-    auto dequeue_packet = [&pending_packets](u8* buffer, size_t buffer_size, Time& packet_timestamp) -> size_t {
-        if (pending_packets == 0)
-            return 0;
-        size_t packet_size = 0;
-        NetworkAdapter::for_each([&](auto& adapter) {
-            if (packet_size || !adapter.has_queued_packets())
-                return;
-            packet_size = adapter.dequeue_packet(buffer, buffer_size, packet_timestamp);
-            pending_packets--;
-            dbgln_if(NETWORK_TASK_DEBUG, "NetworkTask: Dequeued packet from {} ({} bytes)", adapter.name(), packet_size);
-        });
-        return packet_size;
-    };
-
     size_t buffer_size = 64 * KiB;
     auto buffer_region = MM.allocate_kernel_region(buffer_size, "Kernel Packet Buffer", Region::Access::Read | Region::Access::Write);
     auto buffer = (u8*)buffer_region->vaddr().get();
     Time packet_timestamp;
 
-    for (;;) {
-        flush_delayed_tcp_acks();
-        retransmit_tcp_packets();
-        size_t packet_size = dequeue_packet(buffer, buffer_size, packet_timestamp);
-        if (!packet_size) {
-            auto timeout_time = Time::from_milliseconds(500);
-            auto timeout = Thread::BlockTimeout { false, &timeout_time };
-            [[maybe_unused]] auto result = packet_wait_queue.wait_on(timeout, "NetworkTask");
-            continue;
-        }
+    auto process_packet = [&](size_t packet_size) {
         if (packet_size < sizeof(EthernetFrameHeader)) {
             dbgln("NetworkTask: Packet is too small to be an Ethernet packet! ({})", packet_size);
-            continue;
+            return;
         }
         auto& eth = *(const EthernetFrameHeader*)buffer;
         dbgln_if(ETHERNET_DEBUG, "NetworkTask: From {} to {}, ether_type={:#04x}, packet_size={}", eth.source().to_string(), eth.destination().to_string(), eth.ether_type(), packet_size);
@@ -119,6 +100,38 @@ void NetworkTask_main(void*)
         default:
             dbgln_if(ETHERNET_DEBUG, "NetworkTask: Unknown ethernet type {:#04x}", eth.ether_type());
         }
+    };
+
+    // How many packets to take from one adapter before moving on to the
+    // next. Draining the queues round-robin with a budget keeps a flood
+    // on one interface from starving the others and bounds the time
+    // between delayed-ack flushes and retransmit checks.
+    static constexpr int max_packets_per_round = 64;
+
+    size_t round_robin_start = 0;
+    for (;;) {
+        flush_delayed_tcp_acks();
+        retransmit_tcp_packets();
+
+        bool processed_any = false;
+        for (size_t i = 0; i < adapters.size(); ++i) {
+            auto& adapter = adapters[(round_robin_start + i) % adapters.size()];
+            for (int budget = max_packets_per_round; budget > 0; --budget) {
+                size_t packet_size = adapter.dequeue_packet(buffer, buffer_size, packet_timestamp);
+                if (!packet_size)
+                    break;
+                dbgln_if(NETWORK_TASK_DEBUG, "NetworkTask: Dequeued packet from {} ({} bytes)", adapter.name(), packet_size);
+                processed_any = true;
+                process_packet(packet_size);
+            }
+        }
+        ++round_robin_start;
+
+        if (!processed_any) {
+            auto timeout_time = Time::from_milliseconds(500);
+            auto timeout = Thread::BlockTimeout { false, &timeout_time };
+            [[maybe_unused]] auto result = packet_wait_queue.wait_on(timeout, "NetworkTask");
+        }
     }
 }
 
@@ -116,6 +116,8 @@ public:
 
     bool wants_timestamp() const { return m_timestamp; }
 
+    bool reuse_port() const { return m_reuse_port; }
+
 protected:
     Socket(int domain, int type, int protocol);
 
@@ -154,6 +156,7 @@ private:
     Time m_receive_timeout {};
     Time m_send_timeout {};
     int m_timestamp { 0 };
+    bool m_reuse_port { false };
 
     NonnullRefPtrVector<Socket> m_pending;
 };
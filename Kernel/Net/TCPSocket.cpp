@@ -65,6 +65,13 @@ Lockable<HashMap<IPv4SocketTuple, TCPSocket*>>& TCPSocket::sockets_by_tuple()
     return *s_socket_tuples;
 }
 
+static AK::Singleton<Lockable<HashMap<IPv4SocketTuple, TCPSocket::ReusePortGroup>>> s_reuse_port_groups;
+
+Lockable<HashMap<IPv4SocketTuple, TCPSocket::ReusePortGroup>>& TCPSocket::reuse_port_groups()
+{
+    return *s_reuse_port_groups;
+}
+
 RefPtr<TCPSocket> TCPSocket::from_tuple(const IPv4SocketTuple& tuple)
 {
     Locker locker(sockets_by_tuple().lock(), Lock::Mode::Shared);
@@ -73,15 +80,26 @@ RefPtr<TCPSocket> TCPSocket::from_tuple(const IPv4SocketTuple& tuple)
     if (exact_match.has_value())
         return { *exact_match.value() };
 
+    // When the match is a listener that's part of a SO_REUSEPORT group,
+    // rotate through the group members instead of always waking the first.
+    auto select_listener = [](TCPSocket& socket, const IPv4SocketTuple& listen_tuple) -> RefPtr<TCPSocket> {
+        Locker group_locker(reuse_port_groups().lock());
+        auto it = reuse_port_groups().resource().find(listen_tuple);
+        if (it == reuse_port_groups().resource().end() || it->value.listeners.is_empty())
+            return { socket };
+        auto& group = it->value;
+        return { *group.listeners[group.next_index++ % group.listeners.size()] };
+    };
+
     auto address_tuple = IPv4SocketTuple(tuple.local_address(), tuple.local_port(), IPv4Address(), 0);
     auto address_match = sockets_by_tuple().resource().get(address_tuple);
     if (address_match.has_value())
-        return { *address_match.value() };
+        return select_listener(*address_match.value(), address_tuple);
 
     auto wildcard_tuple = IPv4SocketTuple(IPv4Address(), tuple.local_port(), IPv4Address(), 0);
     auto wildcard_match = sockets_by_tuple().resource().get(wildcard_tuple);
     if (wildcard_match.has_value())
-        return { *wildcard_match.value() };
+        return select_listener(*wildcard_match.value(), wildcard_tuple);
 
     return {};
 }
@@ -139,7 +157,26 @@ TCPSocket::TCPSocket(int protocol)
 TCPSocket::~TCPSocket()
 {
     Locker locker(sockets_by_tuple().lock());
-    sockets_by_tuple().resource().remove(tuple());
+
+    bool was_registered = false;
+    auto it = sockets_by_tuple().resource().find(tuple());
+    if (it != sockets_by_tuple().resource().end() && it->value == this) {
+        was_registered = true;
+        sockets_by_tuple().resource().remove(tuple());
+    }
+
+    {
+        Locker group_locker(reuse_port_groups().lock());
+        auto group_it = reuse_port_groups().resource().find(tuple());
+        if (group_it != reuse_port_groups().resource().end()) {
+            auto& group = group_it->value;
+            group.listeners.remove_first_matching([this](auto* listener) { return listener == this; });
+            if (group.listeners.is_empty())
+                reuse_port_groups().resource().remove(tuple());
+            else if (was_registered)
+                sockets_by_tuple().resource().set(tuple(), group.listeners.first());
+        }
+    }
 
     dequeue_for_retransmit();
 
@@ -166,17 +203,43 @@ KResultOr<size_t> TCPSocket::protocol_receive(ReadonlyBytes raw_ipv4_packet, Use
     return payload_size;
 }
 
+ReadonlyBytes TCPSocket::protocol_payload(ReadonlyBytes raw_ipv4_packet) const
+{
+    auto& ipv4_packet = *reinterpret_cast<const IPv4Packet*>(raw_ipv4_packet.data());
+    auto& tcp_packet = *static_cast<const TCPPacket*>(ipv4_packet.payload());
+    size_t payload_size = raw_ipv4_packet.size() - sizeof(IPv4Packet) - tcp_packet.header_size();
+    return { static_cast<const u8*>(tcp_packet.payload()), payload_size };
+}
+
 KResultOr<size_t> TCPSocket::protocol_send(const UserOrKernelBuffer& data, size_t data_length)
 {
     RoutingDecision routing_decision = route_to(peer_address(), local_address(), bound_interface());
     if (routing_decision.is_zero())
         return EHOSTUNREACH;
     size_t mss = routing_decision.adapter->mtu() - sizeof(IPv4Packet) - sizeof(TCPPacket);
-    data_length = min(data_length, mss);
-    int err = send_tcp_packet(TCPFlags::PUSH | TCPFlags::ACK, &data, data_length, &routing_decision);
-    if (err < 0)
-        return KResult((ErrnoCode)-err);
-    return data_length;
+    m_send_mss = mss;
+    // Chop the whole logical payload into MSS-sized segments here instead of
+    // sending one segment per syscall; the routing decision is reused across
+    // the entire train.
+    size_t total_sent = 0;
+    while (total_sent < data_length) {
+        // Cap the burst at whatever the congestion window and the peer's
+        // advertised window allow. The first segment always goes out so a
+        // write makes progress even with a full window; after that the
+        // syscall simply returns a short count.
+        if (total_sent > 0 && m_bytes_not_acked >= min(m_congestion_window, m_send_window_size))
+            break;
+        size_t segment_length = min(data_length - total_sent, mss);
+        auto segment_buffer = data.offset(total_sent);
+        int err = send_tcp_packet(TCPFlags::PUSH | TCPFlags::ACK, &segment_buffer, segment_length, &routing_decision);
+        if (err < 0) {
+            if (total_sent > 0)
+                break;
+            return KResult((ErrnoCode)-err);
+        }
+        total_sent += segment_length;
+    }
+    return total_sent;
 }
 
 KResult TCPSocket::send_ack(bool allow_duplicate)
@@ -241,7 +304,8 @@ KResult TCPSocket::send_tcp_packet(u16 flags, const UserOrKernelBuffer* payload,
     m_bytes_out += buffer_size;
     if (tcp_packet.has_syn() || payload_size > 0) {
         Locker locker(m_not_acked_lock);
-        m_not_acked.append({ m_sequence_number, move(buffer) });
+        m_not_acked.append({ m_sequence_number, payload_size, move(buffer) });
+        m_bytes_not_acked += payload_size;
         enqueue_for_retransmit();
     }
 
@@ -255,14 +319,19 @@ void TCPSocket::receive_tcp_packet(const TCPPacket& packet, u16 size)
 
         dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: receive_tcp_packet: {}", ack_number);
 
+        m_send_window_size = packet.window_size();
+
+        u32 acked_bytes = 0;
         int removed = 0;
         Locker locker(m_not_acked_lock);
         while (!m_not_acked.is_empty()) {
-            auto& packet = m_not_acked.first();
+            auto& unacked_packet = m_not_acked.first();
 
-            dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: iterate: {}", packet.ack_number);
+            dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: iterate: {}", unacked_packet.ack_number);
 
-            if (packet.ack_number <= ack_number) {
+            if (unacked_packet.ack_number <= ack_number) {
+                acked_bytes += unacked_packet.payload_size;
+                m_bytes_not_acked -= unacked_packet.payload_size;
                 m_not_acked.take_first();
                 removed++;
             } else {
@@ -270,6 +339,45 @@ void TCPSocket::receive_tcp_packet(const TCPPacket& packet, u16 size)
             }
         }
 
+        if (removed > 0) {
+            // Forward progress: reset loss bookkeeping and open the
+            // congestion window, in slow start below the threshold and
+            // by roughly one MSS per RTT above it.
+            m_duplicate_ack_count = 0;
+            m_retransmit_attempts = 0;
+            if (m_in_fast_recovery) {
+                if (ack_number >= m_recovery_point || m_not_acked.is_empty()) {
+                    m_in_fast_recovery = false;
+                    m_congestion_window = m_slow_start_threshold;
+                } else {
+                    // NewReno partial ACK: the very next segment was lost
+                    // as well, resend it right away.
+                    retransmit_first_unacked_packet();
+                }
+            } else if (m_congestion_window < m_slow_start_threshold) {
+                m_congestion_window += min(acked_bytes, (u32)m_send_mss);
+            } else {
+                m_congestion_window += max((u32)1, (u32)m_send_mss * m_send_mss / m_congestion_window);
+            }
+        } else if (ack_number == m_last_ack_number_received && size == 0 && !m_not_acked.is_empty()) {
+            // A duplicate ACK; three of them mean the segment after
+            // ack_number got lost (RFC 5681 fast retransmit).
+            m_duplicate_ack_count++;
+            if (m_duplicate_ack_count == 3 && !m_in_fast_recovery) {
+                m_slow_start_threshold = max(m_bytes_not_acked / 2, 2 * (u32)m_send_mss);
+                m_congestion_window = m_slow_start_threshold + 3 * m_send_mss;
+                m_in_fast_recovery = true;
+                m_recovery_point = m_sequence_number;
+                m_fast_retransmits++;
+                retransmit_first_unacked_packet();
+            } else if (m_in_fast_recovery) {
+                // Each further duplicate ACK means another segment left
+                // the network.
+                m_congestion_window += m_send_mss;
+            }
+        }
+        m_last_ack_number_received = ack_number;
+
         if (m_not_acked.is_empty()) {
             m_retransmit_attempts = 0;
             dequeue_for_retransmit();
@@ -310,33 +418,13 @@ NetworkOrdered<u16> TCPSocket::compute_tcp_checksum(const IPv4Address& source, c
 
     PseudoHeader pseudo_header { source, destination, 0, (u8)IPv4Protocol::TCP, packet.header_size() + payload_size };
 
-    u32 checksum = 0;
-    auto* w = (const NetworkOrdered<u16>*)&pseudo_header;
-    for (size_t i = 0; i < sizeof(pseudo_header) / sizeof(u16); ++i) {
-        checksum += w[i];
-        if (checksum > 0xffff)
-            checksum = (checksum >> 16) + (checksum & 0xffff);
-    }
-    w = (const NetworkOrdered<u16>*)&packet;
-    for (size_t i = 0; i < packet.header_size() / sizeof(u16); ++i) {
-        checksum += w[i];
-        if (checksum > 0xffff)
-            checksum = (checksum >> 16) + (checksum & 0xffff);
-    }
     VERIFY(packet.data_offset() * 4 == packet.header_size());
-    w = (const NetworkOrdered<u16>*)packet.payload();
-    for (size_t i = 0; i < payload_size / sizeof(u16); ++i) {
-        checksum += w[i];
-        if (checksum > 0xffff)
-            checksum = (checksum >> 16) + (checksum & 0xffff);
-    }
-    if (payload_size & 1) {
-        u16 expanded_byte = ((const u8*)packet.payload())[payload_size - 1] << 8;
-        checksum += expanded_byte;
-        if (checksum > 0xffff)
-            checksum = (checksum >> 16) + (checksum & 0xffff);
-    }
-    return ~(checksum & 0xffff);
+
+    InternetChecksum checksum;
+    checksum.add(&pseudo_header, sizeof(pseudo_header));
+    checksum.add(&packet, packet.header_size());
+    checksum.add(packet.payload(), payload_size);
+    return checksum.finish();
 }
 
 KResult TCPSocket::protocol_bind()
@@ -353,9 +441,18 @@ KResult TCPSocket::protocol_bind()
 KResult TCPSocket::protocol_listen()
 {
     Locker locker(sockets_by_tuple().lock());
-    if (sockets_by_tuple().resource().contains(tuple()))
-        return EADDRINUSE;
-    sockets_by_tuple().resource().set(tuple(), this);
+    auto existing = sockets_by_tuple().resource().get(tuple());
+    if (existing.has_value()) {
+        // Sharing a listen tuple is only allowed when both sides asked for it.
+        if (!reuse_port() || !existing.value()->reuse_port())
+            return EADDRINUSE;
+    } else {
+        sockets_by_tuple().resource().set(tuple(), this);
+    }
+    if (reuse_port()) {
+        Locker group_locker(reuse_port_groups().lock());
+        reuse_port_groups().resource().ensure(tuple()).listeners.append(this);
+    }
     set_direction(Direction::Passive);
     set_state(State::Listen);
     set_setup_state(SetupState::Completed);
@@ -522,51 +619,68 @@ void TCPSocket::retransmit_packets()
         return;
     }
 
+    // A timeout means the network is in bad shape: collapse the congestion
+    // window back to one segment (RFC 5681) and retransmit only the oldest
+    // unacked segment instead of blasting the entire queue again; the
+    // cumulative ACK for it tells us how much of the rest also made it.
+    m_slow_start_threshold = max(m_bytes_not_acked / 2, 2 * (u32)m_send_mss);
+    m_congestion_window = m_send_mss;
+    m_in_fast_recovery = false;
+    m_duplicate_ack_count = 0;
+    m_timeout_retransmits++;
+
+    Locker locker(m_not_acked_lock);
+    retransmit_first_unacked_packet();
+}
+
+void TCPSocket::retransmit_first_unacked_packet()
+{
+    if (m_not_acked.is_empty())
+        return;
+
     auto routing_decision = route_to(peer_address(), local_address(), bound_interface());
     if (routing_decision.is_zero())
         return;
 
-    Locker locker(m_not_acked_lock, Lock::Mode::Shared);
-    for (auto& packet : m_not_acked) {
-        packet.tx_counter++;
-
-        if constexpr (TCP_SOCKET_DEBUG) {
-            auto& tcp_packet = *(const TCPPacket*)(packet.buffer.data());
-            dbgln("Sending TCP packet from {}:{} to {}:{} with ({}{}{}{}) seq_no={}, ack_no={}, tx_counter={}",
-                local_address(), local_port(),
-                peer_address(), peer_port(),
-                (tcp_packet.has_syn() ? "SYN " : ""),
-                (tcp_packet.has_ack() ? "ACK " : ""),
-                (tcp_packet.has_fin() ? "FIN " : ""),
-                (tcp_packet.has_rst() ? "RST " : ""),
-                tcp_packet.sequence_number(),
-                tcp_packet.ack_number(),
-                packet.tx_counter);
-        }
+    auto& packet = m_not_acked.first();
+    packet.tx_counter++;
+
+    if constexpr (TCP_SOCKET_DEBUG) {
+        auto& tcp_packet = *(const TCPPacket*)(packet.buffer.data());
+        dbgln("Sending TCP packet from {}:{} to {}:{} with ({}{}{}{}) seq_no={}, ack_no={}, tx_counter={}",
+            local_address(), local_port(),
+            peer_address(), peer_port(),
+            (tcp_packet.has_syn() ? "SYN " : ""),
+            (tcp_packet.has_ack() ? "ACK " : ""),
+            (tcp_packet.has_fin() ? "FIN " : ""),
+            (tcp_packet.has_rst() ? "RST " : ""),
+            tcp_packet.sequence_number(),
+            tcp_packet.ack_number(),
+            packet.tx_counter);
+    }
 
-        auto packet_buffer = UserOrKernelBuffer::for_kernel_buffer(packet.buffer.data());
-        int err = routing_decision.adapter->send_ipv4(
-            local_address(), routing_decision.next_hop, peer_address(),
-            IPv4Protocol::TCP, packet_buffer, packet.buffer.size(), ttl());
-        if (err < 0) {
-            auto& tcp_packet = *(const TCPPacket*)(packet.buffer.data());
-            dmesgln("Error ({}) sending TCP packet from {}:{} to {}:{} with ({}{}{}{}) seq_no={}, ack_no={}, tx_counter={}",
-                err,
-                local_address(),
-                local_port(),
-                peer_address(),
-                peer_port(),
-                (tcp_packet.has_syn() ? "SYN " : ""),
-                (tcp_packet.has_ack() ? "ACK " : ""),
-                (tcp_packet.has_fin() ? "FIN " : ""),
-                (tcp_packet.has_rst() ? "RST " : ""),
-                tcp_packet.sequence_number(),
-                tcp_packet.ack_number(),
-                packet.tx_counter);
-        } else {
-            m_packets_out++;
-            m_bytes_out += packet.buffer.size();
-        }
+    auto packet_buffer = UserOrKernelBuffer::for_kernel_buffer(packet.buffer.data());
+    int err = routing_decision.adapter->send_ipv4(
+        local_address(), routing_decision.next_hop, peer_address(),
+        IPv4Protocol::TCP, packet_buffer, packet.buffer.size(), ttl());
+    if (err < 0) {
+        auto& tcp_packet = *(const TCPPacket*)(packet.buffer.data());
+        dmesgln("Error ({}) sending TCP packet from {}:{} to {}:{} with ({}{}{}{}) seq_no={}, ack_no={}, tx_counter={}",
+            err,
+            local_address(),
+            local_port(),
+            peer_address(),
+            peer_port(),
+            (tcp_packet.has_syn() ? "SYN " : ""),
+            (tcp_packet.has_ack() ? "ACK " : ""),
+            (tcp_packet.has_fin() ? "FIN " : ""),
+            (tcp_packet.has_rst() ? "RST " : ""),
+            tcp_packet.sequence_number(),
+            tcp_packet.ack_number(),
+            packet.tx_counter);
+    } else {
+        m_packets_out++;
+        m_bytes_out += packet.buffer.size();
     }
 }
 
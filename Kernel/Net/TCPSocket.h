@@ -8,6 +8,7 @@
 
 #include <AK/Function.h>
 #include <AK/HashMap.h>
+#include <AK/NumericLimits.h>
 #include <AK/SinglyLinkedList.h>
 #include <AK/WeakPtr.h>
 #include <Kernel/KResult.h>
@@ -129,6 +130,10 @@ public:
     u32 bytes_in() const { return m_bytes_in; }
     u32 packets_out() const { return m_packets_out; }
     u32 bytes_out() const { return m_bytes_out; }
+    u32 congestion_window() const { return m_congestion_window; }
+    u32 slow_start_threshold() const { return m_slow_start_threshold; }
+    u32 fast_retransmits() const { return m_fast_retransmits; }
+    u32 timeout_retransmits() const { return m_timeout_retransmits; }
 
     // FIXME: Make this configurable?
     static constexpr u32 maximum_duplicate_acks = 5;
@@ -144,6 +149,15 @@ public:
     static Lockable<HashMap<IPv4SocketTuple, TCPSocket*>>& sockets_by_tuple();
     static RefPtr<TCPSocket> from_tuple(const IPv4SocketTuple& tuple);
 
+    // Listening sockets bound to the same tuple with SO_REUSEPORT form a
+    // group; incoming connections are handed out round-robin over its
+    // members so several processes can share one listen port.
+    struct ReusePortGroup {
+        Vector<TCPSocket*> listeners;
+        size_t next_index { 0 };
+    };
+    static Lockable<HashMap<IPv4SocketTuple, ReusePortGroup>>& reuse_port_groups();
+
     static Lockable<HashMap<IPv4SocketTuple, RefPtr<TCPSocket>>>& closing_sockets();
 
     RefPtr<TCPSocket> create_client(const IPv4Address& local_address, u16 local_port, const IPv4Address& peer_address, u16 peer_port);
@@ -169,6 +183,7 @@ private:
     virtual void shut_down_for_writing() override;
 
     virtual KResultOr<size_t> protocol_receive(ReadonlyBytes raw_ipv4_packet, UserOrKernelBuffer& buffer, size_t buffer_size, int flags) override;
+    virtual ReadonlyBytes protocol_payload(ReadonlyBytes raw_ipv4_packet) const override;
     virtual KResultOr<size_t> protocol_send(const UserOrKernelBuffer&, size_t) override;
     virtual KResult protocol_connect(FileDescription&, ShouldBlock) override;
     virtual KResultOr<u16> protocol_allocate_local_port() override;
@@ -194,15 +209,34 @@ private:
 
     struct OutgoingPacket {
         u32 ack_number { 0 };
+        size_t payload_size { 0 };
         NetworkByteBuffer buffer;
         int tx_counter { 0 };
     };
 
+    // Retransmits the oldest unacked segment. The caller must hold
+    // m_not_acked_lock.
+    void retransmit_first_unacked_packet();
+
     Lock m_not_acked_lock { "TCPSocket unacked packets" };
     SinglyLinkedList<OutgoingPacket> m_not_acked;
+    u32 m_bytes_not_acked { 0 };
 
     u32 m_duplicate_acks { 0 };
 
+    // Sender-side congestion control (RFC 5681 with NewReno-style
+    // recovery, RFC 6582). All sizes are in bytes.
+    u16 m_send_mss { 1460 };
+    u32 m_send_window_size { 64 * KiB };
+    u32 m_congestion_window { 3 * 1460 };
+    u32 m_slow_start_threshold { NumericLimits<u32>::max() };
+    u32 m_last_ack_number_received { 0 };
+    u32 m_duplicate_ack_count { 0 };
+    bool m_in_fast_recovery { false };
+    u32 m_recovery_point { 0 };
+    u32 m_fast_retransmits { 0 };
+    u32 m_timeout_retransmits { 0 };
+
     u32 m_last_ack_number_sent { 0 };
     Time m_last_ack_sent_time;
 
@@ -6,6 +6,7 @@
 
 #include <AK/Singleton.h>
 #include <Kernel/Devices/RandomDevice.h>
+#include <Kernel/Net/LoopbackAdapter.h>
 #include <Kernel/Net/NetworkAdapter.h>
 #include <Kernel/Net/Routing.h>
 #include <Kernel/Net/UDP.h>
@@ -78,6 +79,9 @@ KResultOr<size_t> UDPSocket::protocol_send(const UserOrKernelBuffer& data, size_
     auto routing_decision = route_to(peer_address(), local_address(), bound_interface());
     if (routing_decision.is_zero())
         return EHOSTUNREACH;
+
+    if (routing_decision.adapter.ptr() == &LoopbackAdapter::the())
+        return send_to_local_peer(data, data_length);
     const size_t buffer_size = sizeof(UDPPacket) + data_length;
     auto buffer = ByteBuffer::create_zeroed(buffer_size);
     auto& udp_packet = *reinterpret_cast<UDPPacket*>(buffer.data());
@@ -94,6 +98,41 @@ KResultOr<size_t> UDPSocket::protocol_send(const UserOrKernelBuffer& data, size_
     return data_length;
 }
 
+KResultOr<size_t> UDPSocket::send_to_local_peer(const UserOrKernelBuffer& data, size_t data_length)
+{
+    // Datagrams between local sockets skip ethernet framing, checksums and
+    // the NetworkTask round trip entirely: assemble the IPv4+UDP packet the
+    // receive queue expects and append it to the peer socket directly. The
+    // checksum fields stay zero; nothing verifies them on this path.
+    size_t packet_size = sizeof(IPv4Packet) + sizeof(UDPPacket) + data_length;
+    auto buffer = ByteBuffer::create_zeroed(packet_size);
+    auto& ipv4_packet = *reinterpret_cast<IPv4Packet*>(buffer.data());
+    ipv4_packet.set_version(4);
+    ipv4_packet.set_internet_header_length(5);
+    ipv4_packet.set_source(local_address());
+    ipv4_packet.set_destination(peer_address());
+    ipv4_packet.set_protocol((u8)IPv4Protocol::UDP);
+    ipv4_packet.set_length(packet_size);
+    ipv4_packet.set_ident(1);
+    ipv4_packet.set_ttl(ttl());
+    auto& udp_packet = *static_cast<UDPPacket*>(ipv4_packet.payload());
+    udp_packet.set_source_port(local_port());
+    udp_packet.set_destination_port(peer_port());
+    udp_packet.set_length(sizeof(UDPPacket) + data_length);
+    if (!data.read(udp_packet.payload(), data_length))
+        return EFAULT;
+
+    // Drop our own lock before taking the peer's; two sockets sending to
+    // each other at the same time would otherwise deadlock.
+    ScopedLockRelease release(lock());
+    auto peer = UDPSocket::from_port(udp_packet.destination_port());
+    if (peer)
+        peer->did_receive(ipv4_packet.source(), udp_packet.source_port(), buffer.bytes(), kgettimeofday());
+    // No socket on that port behaves like the wire: the datagram is
+    // silently dropped.
+    return data_length;
+}
+
 KResult UDPSocket::protocol_connect(FileDescription&, ShouldBlock)
 {
     m_role = Role::Connected;
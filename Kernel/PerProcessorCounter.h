@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Types.h>
+#include <Kernel/Arch/x86/CPU.h>
+
+namespace Kernel {
+
+// A statistics counter that spreads its updates over cache-line-padded
+// per-processor slots, so hot-path increments never bounce a shared cache
+// line between processors. Readers sum all slots, which is only meant for
+// infrequent consumers such as ProcFS.
+//
+// Individual slots may go negative when a value is incremented on one
+// processor and decremented on another; only the sum is meaningful.
+class PerProcessorCounter {
+public:
+    ALWAYS_INLINE void add(i64 delta)
+    {
+        slot_for_current_processor().fetch_add(delta);
+    }
+
+    ALWAYS_INLINE void increment() { add(1); }
+    ALWAYS_INLINE void decrement() { add(-1); }
+
+    u64 sum() const
+    {
+        i64 total = 0;
+        for (auto& slot : m_slots)
+            total += slot.value.load();
+        return (u64)total;
+    }
+
+private:
+    static constexpr size_t max_processor_slots = 8;
+
+    struct alignas(64) Slot {
+        Atomic<i64, AK::MemoryOrder::memory_order_relaxed> value { 0 };
+    };
+
+    ALWAYS_INLINE Atomic<i64, AK::MemoryOrder::memory_order_relaxed>& slot_for_current_processor()
+    {
+        return m_slots[Processor::id() % max_processor_slots].value;
+    }
+
+    Slot m_slots[max_processor_slots];
+};
+
+}
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/HashFunctions.h>
+#include <AK/HashMap.h>
 #include <AK/JsonArraySerializer.h>
 #include <AK/JsonObject.h>
 #include <AK/JsonObjectSerializer.h>
@@ -56,11 +58,9 @@ static Vector<FlatPtr, PerformanceEvent::max_stack_frame_count> raw_backtrace(Fl
 }
 
 KResult PerformanceEventBuffer::append_with_eip_and_ebp(ProcessID pid, ThreadID tid,
-    u32 eip, u32 ebp, int type, u32 lost_samples, FlatPtr arg1, FlatPtr arg2, const StringView& arg3)
+    u32 eip, u32 ebp, int type, u32 lost_samples, FlatPtr arg1, FlatPtr arg2, const StringView& arg3,
+    const PerformanceCounterSample* counters)
 {
-    if (count() >= capacity())
-        return ENOBUFS;
-
     if ((g_profiling_event_mask & type) == 0)
         return EINVAL;
 
@@ -81,6 +81,13 @@ KResult PerformanceEventBuffer::append_with_eip_and_ebp(ProcessID pid, ThreadID
 
     switch (type) {
     case PERF_EVENT_SAMPLE:
+        memset(&event.data.sample, 0, sizeof(event.data.sample));
+        if (counters) {
+            for (size_t i = 0; i < PerformanceCounterSample::max_counters; ++i) {
+                event.data.sample.counter_types[i] = counters->types[i];
+                event.data.sample.counter_deltas[i] = counters->deltas[i];
+            }
+        }
         break;
     case PERF_EVENT_MALLOC:
         event.data.malloc.size = arg1;
@@ -136,6 +143,11 @@ KResult PerformanceEventBuffer::append_with_eip_and_ebp(ProcessID pid, ThreadID
         break;
     case PERF_EVENT_PAGE_FAULT:
         break;
+    case PERF_EVENT_SPAN_BEGIN:
+    case PERF_EVENT_SPAN_END:
+        event.data.span.cookie = arg1;
+        event.data.span.kind = arg2;
+        break;
     default:
         return EINVAL;
     }
@@ -147,7 +159,8 @@ KResult PerformanceEventBuffer::append_with_eip_and_ebp(ProcessID pid, ThreadID
     event.pid = pid.value();
     event.tid = tid.value();
     event.timestamp = TimeManagement::the().uptime_ms();
-    at(m_count++) = event;
+    auto sequence = m_sequence.fetch_add(1, AK::MemoryOrder::memory_order_acq_rel);
+    at(sequence % capacity()) = event;
     return KSuccess;
 }
 
@@ -161,14 +174,64 @@ PerformanceEvent& PerformanceEventBuffer::at(size_t index)
 template<typename Serializer>
 bool PerformanceEventBuffer::to_json_impl(Serializer& object) const
 {
+    // If the ring has wrapped around, the oldest surviving event lives right
+    // after the most recently written slot; emit events in insertion order.
+    auto sequence = m_sequence.load(AK::MemoryOrder::memory_order_relaxed);
+    size_t event_count = min(sequence, capacity());
+    size_t first_event_index = sequence > capacity() ? sequence % capacity() : 0;
+
+    // Identical stacks are emitted once, into a shared "stacks" table, and
+    // each event refers to its stack by index. Samples from a hot spot all
+    // share a handful of stacks, so this shrinks long profiles dramatically.
+    Vector<const PerformanceEvent*> unique_stacks;
+    Vector<u32> event_stack_ids;
+    event_stack_ids.ensure_capacity(event_count);
+    HashMap<u32, Vector<u32>> stack_ids_by_hash;
+    for (size_t i = 0; i < event_count; ++i) {
+        auto& event = at((first_event_index + i) % capacity());
+        u32 hash = 0;
+        for (size_t j = 0; j < event.stack_size; ++j)
+            hash = pair_int_hash(hash, ptr_hash(event.stack[j]));
+        auto& candidate_ids = stack_ids_by_hash.ensure(hash);
+        Optional<u32> stack_id;
+        for (auto candidate_id : candidate_ids) {
+            auto& candidate = *unique_stacks[candidate_id];
+            if (candidate.stack_size == event.stack_size && !memcmp(candidate.stack, event.stack, event.stack_size * sizeof(FlatPtr))) {
+                stack_id = candidate_id;
+                break;
+            }
+        }
+        if (!stack_id.has_value()) {
+            stack_id = static_cast<u32>(unique_stacks.size());
+            unique_stacks.append(&event);
+            candidate_ids.append(stack_id.value());
+        }
+        event_stack_ids.append(stack_id.value());
+    }
+
+    auto stacks_array = object.add_array("stacks");
+    for (auto* stack_event : unique_stacks) {
+        auto stack = stacks_array.add_array();
+        for (size_t j = 0; j < stack_event->stack_size; ++j)
+            stack.add(stack_event->stack[j]);
+        stack.finish();
+    }
+    stacks_array.finish();
+
     auto array = object.add_array("events");
     bool seen_first_sample = false;
-    for (size_t i = 0; i < m_count; ++i) {
-        auto& event = at(i);
+    for (size_t i = 0; i < event_count; ++i) {
+        auto& event = at((first_event_index + i) % capacity());
         auto event_object = array.add_object();
         switch (event.type) {
         case PERF_EVENT_SAMPLE:
             event_object.add("type", "sample");
+            for (size_t j = 0; j < PerformanceCounterSample::max_counters; ++j) {
+                auto counter_type = (PerformanceCounterType)event.data.sample.counter_types[j];
+                if (counter_type == PerformanceCounterType::None)
+                    continue;
+                event_object.add(performance_counter_type_to_string(counter_type), event.data.sample.counter_deltas[j]);
+            }
             break;
         case PERF_EVENT_MALLOC:
             event_object.add("type", "malloc");
@@ -227,6 +290,15 @@ bool PerformanceEventBuffer::to_json_impl(Serializer& object) const
         case PERF_EVENT_PAGE_FAULT:
             event_object.add("type", "page_fault");
             break;
+        case PERF_EVENT_SPAN_BEGIN:
+            event_object.add("type", "span_begin");
+            event_object.add("id", static_cast<u64>(event.data.span.cookie));
+            event_object.add("kind", static_cast<u64>(event.data.span.kind));
+            break;
+        case PERF_EVENT_SPAN_END:
+            event_object.add("type", "span_end");
+            event_object.add("id", static_cast<u64>(event.data.span.cookie));
+            break;
         }
         event_object.add("pid", event.pid);
         event_object.add("tid", event.tid);
@@ -234,11 +306,7 @@ bool PerformanceEventBuffer::to_json_impl(Serializer& object) const
         event_object.add("lost_samples", seen_first_sample ? event.lost_samples : 0);
         if (event.type == PERF_EVENT_SAMPLE)
             seen_first_sample = true;
-        auto stack_array = event_object.add_array("stack");
-        for (size_t j = 0; j < event.stack_size; ++j) {
-            stack_array.add(event.stack[j]);
-        }
-        stack_array.finish();
+        event_object.add("stack_id", event_stack_ids[i]);
         event_object.finish();
     }
     array.finish();
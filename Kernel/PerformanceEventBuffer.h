@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
+#include <Kernel/Arch/x86/PerformanceCounters.h>
 #include <Kernel/KBuffer.h>
 #include <Kernel/KResult.h>
 
@@ -13,6 +15,11 @@ namespace Kernel {
 
 class KBufferBuilder;
 
+struct [[gnu::packed]] SamplePerformanceEvent {
+    u8 counter_types[PerformanceCounterSample::max_counters];
+    u64 counter_deltas[PerformanceCounterSample::max_counters];
+};
+
 struct [[gnu::packed]] MallocPerformanceEvent {
     size_t size;
     FlatPtr ptr;
@@ -62,6 +69,14 @@ struct [[gnu::packed]] KFreePerformanceEvent {
     FlatPtr ptr;
 };
 
+// Userspace trace spans (see sys$perf_event and LibCore/Tracing.h.)
+// The cookie pairs a begin with its end; the kind is an application-defined
+// label for the kind of work the span covers.
+struct [[gnu::packed]] SpanPerformanceEvent {
+    FlatPtr cookie;
+    FlatPtr kind;
+};
+
 struct [[gnu::packed]] PerformanceEvent {
     u16 type { 0 };
     u8 stack_size { 0 };
@@ -70,6 +85,7 @@ struct [[gnu::packed]] PerformanceEvent {
     u64 timestamp;
     u32 lost_samples;
     union {
+        SamplePerformanceEvent sample;
         MallocPerformanceEvent malloc;
         FreePerformanceEvent free;
         MmapPerformanceEvent mmap;
@@ -80,6 +96,7 @@ struct [[gnu::packed]] PerformanceEvent {
         ContextSwitchPerformanceEvent context_switch;
         KMallocPerformanceEvent kmalloc;
         KFreePerformanceEvent kfree;
+        SpanPerformanceEvent span;
     } data;
     static constexpr size_t max_stack_frame_count = 64;
     FlatPtr stack[max_stack_frame_count];
@@ -96,15 +113,16 @@ public:
 
     KResult append(int type, FlatPtr arg1, FlatPtr arg2, const StringView& arg3, Thread* current_thread = Thread::current());
     KResult append_with_eip_and_ebp(ProcessID pid, ThreadID tid, u32 eip, u32 ebp,
-        int type, u32 lost_samples, FlatPtr arg1, FlatPtr arg2, const StringView& arg3);
+        int type, u32 lost_samples, FlatPtr arg1, FlatPtr arg2, const StringView& arg3,
+        const PerformanceCounterSample* counters = nullptr);
 
     void clear()
     {
-        m_count = 0;
+        m_sequence.store(0, AK::MemoryOrder::memory_order_relaxed);
     }
 
     size_t capacity() const { return m_buffer->size() / sizeof(PerformanceEvent); }
-    size_t count() const { return m_count; }
+    size_t count() const { return min(m_sequence.load(AK::MemoryOrder::memory_order_relaxed), capacity()); }
     const PerformanceEvent& at(size_t index) const
     {
         return const_cast<PerformanceEventBuffer&>(*this).at(index);
@@ -122,7 +140,12 @@ private:
 
     PerformanceEvent& at(size_t index);
 
-    size_t m_count { 0 };
+    // The buffer is a ring: each event is appended at a monotonically
+    // increasing sequence number, wrapping around once the buffer is full
+    // and overwriting the oldest events. Reserving a slot is a single
+    // atomic increment, so events can be logged from interrupt context on
+    // any processor without taking a lock.
+    Atomic<size_t> m_sequence { 0 };
     NonnullOwnPtr<KBuffer> m_buffer;
 };
 
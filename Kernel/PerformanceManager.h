@@ -55,9 +55,14 @@ public:
     inline static void add_cpu_sample_event(Thread& current_thread, const RegisterState& regs, u32 lost_time)
     {
         if (auto* event_buffer = current_thread.process().current_perf_events_buffer()) {
+            // The deltas cover everything that ran on this processor since
+            // its previous tick, which at sampling rates is almost always
+            // the sampled thread itself.
+            PerformanceCounterSample counters;
+            PerformanceCounters::read_sample_on_current_processor(counters);
             [[maybe_unused]] auto rc = event_buffer->append_with_eip_and_ebp(
                 current_thread.pid(), current_thread.tid(),
-                regs.eip, regs.ebp, PERF_EVENT_SAMPLE, lost_time, 0, 0, nullptr);
+                regs.eip, regs.ebp, PERF_EVENT_SAMPLE, lost_time, 0, 0, nullptr, &counters);
         }
     }
 
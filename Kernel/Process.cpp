@@ -153,9 +153,12 @@ RefPtr<Process> Process::create_user_process(RefPtr<Thread>& first_thread, const
     }
     auto& device_to_use_as_tty = tty ? (CharacterDevice&)*tty : NullDevice::the();
     auto description = device_to_use_as_tty.open(O_RDWR).value();
-    process->m_fds[0].set(*description);
-    process->m_fds[1].set(*description);
-    process->m_fds[2].set(*description);
+    {
+        ScopedSpinLock lock(process->m_fds_lock);
+        process->m_fds[0].set(*description);
+        process->m_fds[1].set(*description);
+        process->m_fds[2].set(*description);
+    }
 
     error = process->exec(path, move(arguments), move(environment));
     if (error != 0) {
@@ -372,6 +375,7 @@ RefPtr<FileDescription> Process::file_description(int fd) const
 {
     if (fd < 0)
         return nullptr;
+    ScopedSpinLock lock(m_fds_lock);
     if (static_cast<size_t>(fd) < m_fds.size())
         return m_fds[fd].description();
     return nullptr;
@@ -381,6 +385,7 @@ int Process::fd_flags(int fd) const
 {
     if (fd < 0)
         return -1;
+    ScopedSpinLock lock(m_fds_lock);
     if (static_cast<size_t>(fd) < m_fds.size())
         return m_fds[fd].flags();
     return -1;
@@ -388,6 +393,7 @@ int Process::fd_flags(int fd) const
 
 int Process::number_of_open_file_descriptors() const
 {
+    ScopedSpinLock lock(m_fds_lock);
     int count = 0;
     for (auto& description : m_fds) {
         if (description)
@@ -398,6 +404,7 @@ int Process::number_of_open_file_descriptors() const
 
 int Process::alloc_fd(int first_candidate_fd)
 {
+    ScopedSpinLock lock(m_fds_lock);
     for (int i = first_candidate_fd; i < (int)m_max_open_file_descriptors; ++i) {
         if (!m_fds[i])
             return i;
@@ -505,7 +512,13 @@ void Process::finalize()
 
     if (m_alarm_timer)
         TimerQueue::the().cancel_timer(m_alarm_timer.release_nonnull());
-    m_fds.clear();
+    {
+        // Take the table contents out under the lock, but let the
+        // descriptions (and any blocking close work) drop outside it.
+        Vector<FileDescriptionAndFlags> fds;
+        ScopedSpinLock lock(m_fds_lock);
+        fds = move(m_fds);
+    }
     m_tty = nullptr;
     m_executable = nullptr;
     m_cwd = nullptr;
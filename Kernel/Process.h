@@ -294,6 +294,13 @@ public:
     KResultOr<ssize_t> sys$readv(int fd, Userspace<const struct iovec*> iov, int iov_count);
     KResultOr<ssize_t> sys$write(int fd, Userspace<const u8*>, ssize_t);
     KResultOr<ssize_t> sys$writev(int fd, Userspace<const struct iovec*> iov, int iov_count);
+    KResultOr<ssize_t> sys$sendfile(Userspace<const Syscall::SC_sendfile_params*>);
+    KResultOr<ssize_t> sys$splice(int in_fd, int out_fd, size_t count);
+    KResultOr<int> sys$async_io_create();
+    KResultOr<ssize_t> sys$async_io_submit(int ring_fd, size_t count);
+    KResultOr<int> sys$event_queue_create();
+    KResultOr<int> sys$event_queue_ctl(Userspace<const Syscall::SC_event_queue_ctl_params*>);
+    KResultOr<int> sys$event_queue_wait(Userspace<const Syscall::SC_event_queue_wait_params*>);
     KResultOr<int> sys$fstat(int fd, Userspace<stat*>);
     KResultOr<int> sys$stat(Userspace<const Syscall::SC_stat_params*>);
     KResultOr<int> sys$lseek(int fd, Userspace<off_t*>, int whence);
@@ -369,6 +376,7 @@ public:
     KResultOr<int> sys$shutdown(int sockfd, int how);
     KResultOr<ssize_t> sys$sendmsg(int sockfd, Userspace<const struct msghdr*>, int flags);
     KResultOr<ssize_t> sys$recvmsg(int sockfd, Userspace<struct msghdr*>, int flags);
+    KResultOr<ssize_t> sys$recvmmsg(Userspace<const Syscall::SC_recvmmsg_params*>);
     KResultOr<int> sys$getsockopt(Userspace<const Syscall::SC_getsockopt_params*>);
     KResultOr<int> sys$setsockopt(Userspace<const Syscall::SC_setsockopt_params*>);
     KResultOr<int> sys$getsockname(Userspace<const Syscall::SC_getsockname_params*>);
@@ -376,6 +384,8 @@ public:
     KResultOr<int> sys$socketpair(Userspace<const Syscall::SC_socketpair_params*>);
     KResultOr<int> sys$sched_setparam(pid_t pid, Userspace<const struct sched_param*>);
     KResultOr<int> sys$sched_getparam(pid_t pid, Userspace<struct sched_param*>);
+    KResultOr<int> sys$sched_setaffinity(pid_t tid, Userspace<const u32*>);
+    KResultOr<int> sys$sched_getaffinity(pid_t tid, Userspace<u32*>);
     KResultOr<int> sys$create_thread(void* (*)(void*), Userspace<const Syscall::SC_create_thread_params*>);
     [[noreturn]] void sys$exit_thread(Userspace<void*>);
     KResultOr<int> sys$join_thread(pid_t tid, Userspace<void**> exit_value);
@@ -600,6 +610,13 @@ private:
         RefPtr<FileDescription> m_description;
         u32 m_flags { 0 };
     };
+    // Protects m_fds so that fd lookup on the syscall fast path doesn't
+    // depend on the big process lock. Allocating a fresh fd and installing
+    // a description into it are still serialized by the big lock; this
+    // lock only makes individual reads and writes of the table safe on
+    // their own. Never destroy a FileDescription while holding it, as
+    // ~FileDescription can block.
+    mutable RecursiveSpinLock m_fds_lock;
     Vector<FileDescriptionAndFlags> m_fds;
 
     mutable RecursiveSpinLock m_thread_list_lock;
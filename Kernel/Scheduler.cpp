@@ -9,6 +9,7 @@
 #include <AK/TemporaryChange.h>
 #include <AK/Time.h>
 #include <Kernel/Debug.h>
+#include <Kernel/Interrupts/APIC.h>
 #include <Kernel/Panic.h>
 #include <Kernel/PerformanceManager.h>
 #include <Kernel/Process.h>
@@ -52,34 +53,49 @@ READONLY_AFTER_INIT static Process* s_colonel_process;
 struct ThreadReadyQueue {
     IntrusiveList<Thread, RawPtr<Thread>, &Thread::m_ready_queue_node> thread_list;
 };
-static SpinLock<u8> g_ready_queues_lock;
-static u32 g_ready_queues_mask;
-static constexpr u32 g_ready_queue_buckets = sizeof(g_ready_queues_mask) * 8;
-READONLY_AFTER_INIT static ThreadReadyQueue* g_ready_queues; // g_ready_queue_buckets entries
+
+static constexpr u32 g_ready_queue_buckets = sizeof(u32) * 8;
+
+// Each processor has its own set of ready queues so that enqueuing and
+// picking threads doesn't serialize all cores on one spinlock. Idle
+// processors steal runnable threads from their siblings in pull_next_runnable_thread().
+struct ThreadReadyQueues {
+    SpinLock<u8> lock;
+    u32 mask { 0 };
+    ThreadReadyQueue queues[g_ready_queue_buckets];
+};
+READONLY_AFTER_INIT static u32 g_ready_queues_count;
+READONLY_AFTER_INIT static ThreadReadyQueues* g_ready_queues; // g_ready_queues_count entries, one per processor
+READONLY_AFTER_INIT static SchedulerCpuStatistics* g_cpu_statistics; // g_ready_queues_count entries, one per processor
 static void dump_thread_list();
 
+static inline ThreadReadyQueues& ready_queues_for_cpu(u32 cpu)
+{
+    VERIFY(cpu < g_ready_queues_count);
+    return g_ready_queues[cpu];
+}
+
 static inline u32 thread_priority_to_priority_index(u32 thread_priority)
 {
     // Converts the priority in the range of THREAD_PRIORITY_MIN...THREAD_PRIORITY_MAX
     // to a index into g_ready_queues where 0 is the highest priority bucket
     VERIFY(thread_priority >= THREAD_PRIORITY_MIN && thread_priority <= THREAD_PRIORITY_MAX);
     constexpr u32 thread_priority_count = THREAD_PRIORITY_MAX - THREAD_PRIORITY_MIN + 1;
-    static_assert(thread_priority_count > 0);
-    auto priority_bucket = ((thread_priority_count - (thread_priority - THREAD_PRIORITY_MIN)) / thread_priority_count) * (g_ready_queue_buckets - 1);
+    static_assert(thread_priority_count > 1);
+    auto priority_bucket = (g_ready_queue_buckets - 1) - ((thread_priority - THREAD_PRIORITY_MIN) * (g_ready_queue_buckets - 1) / (thread_priority_count - 1));
     VERIFY(priority_bucket < g_ready_queue_buckets);
     return priority_bucket;
 }
 
-Thread& Scheduler::pull_next_runnable_thread()
+static Thread* pull_next_runnable_thread_from_cpu(u32 cpu, u32 affinity_mask)
 {
-    auto affinity_mask = 1u << Processor::current().id();
-
-    ScopedSpinLock lock(g_ready_queues_lock);
-    auto priority_mask = g_ready_queues_mask;
+    auto& ready_queues = ready_queues_for_cpu(cpu);
+    ScopedSpinLock lock(ready_queues.lock);
+    auto priority_mask = ready_queues.mask;
     while (priority_mask != 0) {
         auto priority = __builtin_ffsl(priority_mask);
         VERIFY(priority > 0);
-        auto& ready_queue = g_ready_queues[--priority];
+        auto& ready_queue = ready_queues.queues[--priority];
         for (auto& thread : ready_queue.thread_list) {
             VERIFY(thread.m_runnable_priority == (int)priority);
             if (thread.is_active())
@@ -89,7 +105,7 @@ Thread& Scheduler::pull_next_runnable_thread()
             thread.m_runnable_priority = -1;
             ready_queue.thread_list.remove(thread);
             if (ready_queue.thread_list.is_empty())
-                g_ready_queues_mask &= ~(1u << priority);
+                ready_queues.mask &= ~(1u << priority);
             // Mark it as active because we are using this thread. This is similar
             // to comparing it with Processor::current_thread, but when there are
             // multiple processors there's no easy way to check whether the thread
@@ -101,10 +117,28 @@ Thread& Scheduler::pull_next_runnable_thread()
             // switching to it.
             // FIXME: Figure out a better way maybe?
             thread.set_active(true);
-            return thread;
+            return &thread;
         }
         priority_mask &= ~(1u << priority);
     }
+    return nullptr;
+}
+
+Thread& Scheduler::pull_next_runnable_thread()
+{
+    auto cpu = Processor::current().id();
+    auto affinity_mask = 1u << cpu;
+
+    if (auto* thread = pull_next_runnable_thread_from_cpu(cpu, affinity_mask))
+        return *thread;
+
+    // Our own queues are drained, try to steal work from a sibling processor.
+    for (u32 victim = (cpu + 1) % g_ready_queues_count; victim != cpu; victim = (victim + 1) % g_ready_queues_count) {
+        if (auto* thread = pull_next_runnable_thread_from_cpu(victim, affinity_mask)) {
+            dbgln_if(SCHEDULER_DEBUG, "Scheduler[{}]: Stole thread {} from processor {}", cpu, *thread, victim);
+            return *thread;
+        }
+    }
     return *Processor::idle_thread();
 }
 
@@ -112,7 +146,8 @@ bool Scheduler::dequeue_runnable_thread(Thread& thread, bool check_affinity)
 {
     if (thread.is_idle_thread())
         return true;
-    ScopedSpinLock lock(g_ready_queues_lock);
+    auto& ready_queues = ready_queues_for_cpu(thread.m_ready_queue_cpu);
+    ScopedSpinLock lock(ready_queues.lock);
     auto priority = thread.m_runnable_priority;
     if (priority < 0) {
         VERIFY(!thread.m_ready_queue_node.is_in_list());
@@ -122,12 +157,12 @@ bool Scheduler::dequeue_runnable_thread(Thread& thread, bool check_affinity)
     if (check_affinity && !(thread.affinity() & (1 << Processor::current().id())))
         return false;
 
-    VERIFY(g_ready_queues_mask & (1u << priority));
-    auto& ready_queue = g_ready_queues[priority];
+    VERIFY(ready_queues.mask & (1u << priority));
+    auto& ready_queue = ready_queues.queues[priority];
     thread.m_runnable_priority = -1;
     ready_queue.thread_list.remove(thread);
     if (ready_queue.thread_list.is_empty())
-        g_ready_queues_mask &= ~(1u << priority);
+        ready_queues.mask &= ~(1u << priority);
     return true;
 }
 
@@ -136,17 +171,30 @@ void Scheduler::queue_runnable_thread(Thread& thread)
     VERIFY(g_scheduler_lock.own_lock());
     if (thread.is_idle_thread())
         return;
-    auto priority = thread_priority_to_priority_index(thread.priority());
+    auto priority = thread_priority_to_priority_index(thread.effective_priority());
+
+    // Prefer the current processor's queue so a freshly woken thread runs
+    // where its wake-up happened. If our affinity doesn't allow that, put it
+    // on the first processor it may run on and let that one pick it up.
+    auto cpu = Processor::current().id();
+    if (!(thread.affinity() & (1u << cpu))) {
+        auto first_allowed = __builtin_ffsl(thread.affinity());
+        VERIFY(first_allowed > 0);
+        if ((u32)(first_allowed - 1) < g_ready_queues_count)
+            cpu = first_allowed - 1;
+    }
 
-    ScopedSpinLock lock(g_ready_queues_lock);
+    auto& ready_queues = ready_queues_for_cpu(cpu);
+    ScopedSpinLock lock(ready_queues.lock);
     VERIFY(thread.m_runnable_priority < 0);
     thread.m_runnable_priority = (int)priority;
+    thread.m_ready_queue_cpu = cpu;
     VERIFY(!thread.m_ready_queue_node.is_in_list());
-    auto& ready_queue = g_ready_queues[priority];
+    auto& ready_queue = ready_queues.queues[priority];
     bool was_empty = ready_queue.thread_list.is_empty();
     ready_queue.thread_list.append(thread);
     if (was_empty)
-        g_ready_queues_mask |= (1u << priority);
+        ready_queues.mask |= (1u << priority);
 }
 
 UNMAP_AFTER_INIT void Scheduler::start()
@@ -295,6 +343,7 @@ bool Scheduler::donate_to_and_switch(Thread* beneficiary, [[maybe_unused]] const
     dbgln_if(SCHEDULER_DEBUG, "Scheduler[{}]: Donating {} ticks to {}, reason={}", proc.get_id(), ticks_to_donate, *beneficiary, reason);
     beneficiary->set_ticks_left(ticks_to_donate);
 
+    ++g_cpu_statistics[proc.id()].donations;
     return Scheduler::context_switch(beneficiary);
 }
 
@@ -353,6 +402,13 @@ bool Scheduler::context_switch(Thread* thread)
         return false;
 
     if (from_thread) {
+        auto& statistics = g_cpu_statistics[Processor::id()];
+        ++statistics.context_switches;
+        if (from_thread->state() == Thread::Running)
+            ++statistics.preemptions;
+        else
+            ++statistics.voluntary_switches;
+
         // If the last process hasn't blocked (still marked as running),
         // mark it as runnable for the next round.
         if (from_thread->state() == Thread::Running)
@@ -463,7 +519,9 @@ UNMAP_AFTER_INIT void Scheduler::initialize()
 
     RefPtr<Thread> idle_thread;
     g_finalizer_wait_queue = new WaitQueue;
-    g_ready_queues = new ThreadReadyQueue[g_ready_queue_buckets];
+    g_ready_queues_count = APIC::initialized() ? APIC::the().enabled_processor_count() : 1;
+    g_ready_queues = new ThreadReadyQueues[g_ready_queues_count];
+    g_cpu_statistics = new SchedulerCpuStatistics[g_ready_queues_count];
 
     g_finalizer_has_work.store(false, AK::MemoryOrder::memory_order_release);
     s_colonel_process = Process::create_kernel_process(idle_thread, "colonel", idle_loop, nullptr, 1).leak_ref();
@@ -515,6 +573,10 @@ void Scheduler::timer_tick(const RegisterState& regs)
     if (current_thread->tick())
         return;
 
+    // The thread burned through a whole time slice without blocking; let any
+    // interactivity boost it earned decay.
+    current_thread->decay_priority_boost();
+
     VERIFY_INTERRUPTS_DISABLED();
     VERIFY(Processor::current().in_irq());
     Processor::current().invoke_scheduler_async();
@@ -562,7 +624,16 @@ void Scheduler::idle_loop(void*)
 
     for (;;) {
         proc.idle_begin();
-        asm("hlt");
+        bool tickless = TimeManagement::the().enter_tickless_idle();
+        // Between idle_begin() and the hlt below another processor may have
+        // marked us busy and sent a wake IPI that arrives before we halt.
+        // With the periodic tick running that only costs a short stall, but
+        // with a long one-shot programmed it would delay the wakeup until
+        // the next timer deadline, so re-check before going to sleep.
+        if (!tickless || proc.is_marked_idle())
+            asm("hlt");
+        if (tickless)
+            TimeManagement::the().exit_tickless_idle();
 
         proc.idle_end();
         VERIFY_INTERRUPTS_ENABLED();
@@ -575,6 +646,14 @@ void Scheduler::idle_loop(void*)
     }
 }
 
+void Scheduler::for_each_cpu_statistics(Function<void(u32, const SchedulerCpuStatistics&)> callback)
+{
+    // The counters are only ever written with the scheduler lock held.
+    ScopedSpinLock lock(g_scheduler_lock);
+    for (u32 cpu = 0; cpu < g_ready_queues_count; ++cpu)
+        callback(cpu, g_cpu_statistics[cpu]);
+}
+
 void Scheduler::dump_scheduler_state()
 {
     dump_thread_list();
@@ -608,9 +687,10 @@ void dump_thread_list()
                 thread.times_scheduled());
             break;
         default:
-            dmesgln("  {:14} Pr:{:2} {:30} @ {:04x}:{:08x} (nsched: {})",
+            dmesgln("  {:14} Pr:{:2}+{} {:30} @ {:04x}:{:08x} (nsched: {})",
                 thread.state_string(),
                 thread.priority(),
+                thread.priority_boost(),
                 thread,
                 get_cs(thread),
                 get_eip(thread),
@@ -26,6 +26,17 @@ extern WaitQueue* g_finalizer_wait_queue;
 extern Atomic<bool> g_finalizer_has_work;
 extern RecursiveSpinLock g_scheduler_lock;
 
+struct SchedulerCpuStatistics {
+    u32 context_switches { 0 };
+    // A switch is a preemption if the outgoing thread was still Running
+    // (end of time slice or higher-priority wakeup), and voluntary if it
+    // blocked, stopped or died. Donations additionally count switches
+    // caused by an explicit priority donation.
+    u32 preemptions { 0 };
+    u32 voluntary_switches { 0 };
+    u32 donations { 0 };
+};
+
 class Scheduler {
 public:
     static void initialize();
@@ -51,6 +62,7 @@ public:
     static Thread& pull_next_runnable_thread();
     static bool dequeue_runnable_thread(Thread&, bool = false);
     static void queue_runnable_thread(Thread&);
+    static void for_each_cpu_statistics(Function<void(u32 cpu, const SchedulerCpuStatistics&)>);
     static void dump_scheduler_state();
 };
 
@@ -169,15 +169,15 @@ Optional<u32> user_atomic_fetch_xor_relaxed(volatile u32* var, u32 val)
     return Kernel::safe_atomic_fetch_xor_relaxed(var, val);
 }
 
-extern "C" {
-
-bool copy_to_user(void* dest_ptr, const void* src_ptr, size_t n)
+// These do everything except toggle the SMAP window; the caller is
+// responsible for having it open, either per-call (the extern "C"
+// wrappers below) or once for a batch (Kernel::UserAccessBatch).
+static bool do_copy_to_user(void* dest_ptr, const void* src_ptr, size_t n)
 {
     bool is_user = Kernel::is_user_range(VirtualAddress(dest_ptr), n);
     if (!is_user)
         return false;
     VERIFY(!Kernel::is_user_range(VirtualAddress(src_ptr), n));
-    Kernel::SmapDisabler disabler;
     void* fault_at;
     if (!Kernel::safe_memcpy(dest_ptr, src_ptr, n, fault_at)) {
         VERIFY(VirtualAddress(fault_at) >= VirtualAddress(dest_ptr) && VirtualAddress(fault_at) <= VirtualAddress((FlatPtr)dest_ptr + n));
@@ -187,13 +187,12 @@ bool copy_to_user(void* dest_ptr, const void* src_ptr, size_t n)
     return true;
 }
 
-bool copy_from_user(void* dest_ptr, const void* src_ptr, size_t n)
+static bool do_copy_from_user(void* dest_ptr, const void* src_ptr, size_t n)
 {
     bool is_user = Kernel::is_user_range(VirtualAddress(src_ptr), n);
     if (!is_user)
         return false;
     VERIFY(!Kernel::is_user_range(VirtualAddress(dest_ptr), n));
-    Kernel::SmapDisabler disabler;
     void* fault_at;
     if (!Kernel::safe_memcpy(dest_ptr, src_ptr, n, fault_at)) {
         VERIFY(VirtualAddress(fault_at) >= VirtualAddress(src_ptr) && VirtualAddress(fault_at) <= VirtualAddress((FlatPtr)src_ptr + n));
@@ -203,6 +202,34 @@ bool copy_from_user(void* dest_ptr, const void* src_ptr, size_t n)
     return true;
 }
 
+namespace Kernel {
+
+bool UserAccessBatch::copy_to_user(void* dest_ptr, const void* src_ptr, size_t n)
+{
+    return do_copy_to_user(dest_ptr, src_ptr, n);
+}
+
+bool UserAccessBatch::copy_from_user(void* dest_ptr, const void* src_ptr, size_t n)
+{
+    return do_copy_from_user(dest_ptr, src_ptr, n);
+}
+
+}
+
+extern "C" {
+
+bool copy_to_user(void* dest_ptr, const void* src_ptr, size_t n)
+{
+    Kernel::SmapDisabler disabler;
+    return do_copy_to_user(dest_ptr, src_ptr, n);
+}
+
+bool copy_from_user(void* dest_ptr, const void* src_ptr, size_t n)
+{
+    Kernel::SmapDisabler disabler;
+    return do_copy_from_user(dest_ptr, src_ptr, n);
+}
+
 void* memcpy(void* dest_ptr, const void* src_ptr, size_t n)
 {
     size_t dest = (size_t)dest_ptr;
@@ -10,6 +10,7 @@
 #include <AK/Forward.h>
 #include <AK/Time.h>
 #include <AK/Userspace.h>
+#include <Kernel/Arch/x86/SmapDisabler.h>
 #include <Kernel/UnixTypes.h>
 
 namespace Syscall {
@@ -33,6 +34,26 @@ template<typename T>
 [[nodiscard]] Optional<u32> user_atomic_fetch_or_relaxed(volatile u32* var, u32 val);
 [[nodiscard]] Optional<u32> user_atomic_fetch_xor_relaxed(volatile u32* var, u32 val);
 
+namespace Kernel {
+
+// A scoped batch of user-memory copies. Constructing the batch opens the
+// SMAP window once and keeps it open until the batch goes out of scope,
+// instead of toggling stac/clac around every individual copy. Each copy
+// still validates its own range and faults are still caught inside
+// safe_memcpy, so only the window churn is hoisted, not any checking.
+// Use it for short, straight-line runs of copies; don't block while one
+// is alive.
+class UserAccessBatch {
+public:
+    [[nodiscard]] bool copy_to_user(void*, const void*, size_t);
+    [[nodiscard]] bool copy_from_user(void*, const void*, size_t);
+
+private:
+    SmapDisabler m_disabler;
+};
+
+}
+
 extern "C" {
 
 [[nodiscard]] bool copy_to_user(void*, const void*, size_t);
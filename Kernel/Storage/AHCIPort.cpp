@@ -42,10 +42,10 @@ AHCIPort::AHCIPort(const AHCIPortHandler& handler, volatile AHCI::PortRegisters&
     dbgln_if(AHCI_DEBUG, "AHCI Port {}: Command list page at {}", representative_port_index(), m_command_list_page->paddr());
     dbgln_if(AHCI_DEBUG, "AHCI Port {}: FIS receive page at {}", representative_port_index(), m_command_list_page->paddr());
 
-    for (size_t index = 0; index < 1; index++) {
+    for (size_t index = 0; index < command_slots_count; index++) {
         m_dma_buffers.append(MM.allocate_supervisor_physical_page().release_nonnull());
     }
-    for (size_t index = 0; index < 1; index++) {
+    for (size_t index = 0; index < command_slots_count; index++) {
         m_command_table_pages.append(MM.allocate_supervisor_physical_page().release_nonnull());
     }
     m_command_list_region = MM.allocate_kernel_region(m_command_list_page->paddr(), PAGE_SIZE, "AHCI Port Command List", Region::Access::Read | Region::Access::Write, Region::Cacheable::No);
@@ -85,28 +85,27 @@ void AHCIPort::handle_interrupt()
     if (m_interrupt_status.is_set(AHCI::PortInterruptFlag::DHR) || m_interrupt_status.is_set(AHCI::PortInterruptFlag::PS)) {
         m_wait_for_completion = false;
 
-        // Now schedule reading/writing the buffer as soon as we leave the irq handler.
-        // This is important so that we can safely access the buffers, which could
-        // trigger page faults
-        if (!m_current_request) {
+        // Commands may complete out of order; any slot whose bit in PxCI has
+        // cleared while we still track a request for it is done.
+        u32 commands_issued = m_port_registers.ci;
+        u32 completed_slots = 0;
+        for (size_t slot = 0; slot < command_slots_count; slot++) {
+            if (m_slot_requests[slot] && !(commands_issued & (1u << slot)))
+                completed_slots |= (1u << slot);
+        }
+
+        // Now schedule reading/writing the buffers as soon as we leave the irq
+        // handler. This is important so that we can safely access the buffers,
+        // which could trigger page faults
+        if (!completed_slots) {
             dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request handled, probably identify request", representative_port_index());
         } else {
-            g_io_work->queue([this]() {
-                dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request handled", representative_port_index());
-                Locker locker(m_lock);
-                VERIFY(m_current_request);
-                VERIFY(m_current_scatter_list);
-                if (m_current_request->request_type() == AsyncBlockDeviceRequest::Read) {
-                    if (!m_current_request->write_to_buffer(m_current_request->buffer(), m_current_scatter_list->dma_region().as_ptr(), m_connected_device->block_size() * m_current_request->block_count())) {
-                        dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request failure, memory fault occurred when reading in data.", representative_port_index());
-                        m_current_scatter_list = nullptr;
-                        complete_current_request(AsyncDeviceRequest::MemoryFault);
-                        return;
-                    }
+            g_io_work->queue([this, completed_slots]() {
+                dbgln_if(AHCI_DEBUG, "AHCI Port {}: Requests in slots {:#b} handled", representative_port_index(), completed_slots);
+                for (u8 slot = 0; slot < command_slots_count; slot++) {
+                    if (completed_slots & (1u << slot))
+                        finish_request_in_slot(slot);
                 }
-                m_current_scatter_list = nullptr;
-                dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request success", representative_port_index());
-                complete_current_request(AsyncDeviceRequest::Success);
             });
         }
     }
@@ -421,21 +420,21 @@ size_t AHCIPort::calculate_descriptors_count(size_t block_count) const
     return needed_dma_regions_count;
 }
 
-Optional<AsyncDeviceRequest::RequestResult> AHCIPort::prepare_and_set_scatter_list(AsyncBlockDeviceRequest& request)
+Optional<AsyncDeviceRequest::RequestResult> AHCIPort::prepare_and_set_scatter_list(AsyncBlockDeviceRequest& request, u8 slot)
 {
     VERIFY(m_lock.is_locked());
     VERIFY(request.block_count() > 0);
 
+    // Each command slot owns a single DMA bounce buffer page.
+    VERIFY(calculate_descriptors_count(request.block_count()) == 1);
     NonnullRefPtrVector<PhysicalPage> allocated_dma_regions;
-    for (size_t index = 0; index < calculate_descriptors_count(request.block_count()); index++) {
-        allocated_dma_regions.append(m_dma_buffers.at(index));
-    }
+    allocated_dma_regions.append(m_dma_buffers.at(slot));
 
-    m_current_scatter_list = ScatterGatherList::create(request, move(allocated_dma_regions), m_connected_device->block_size());
-    if (!m_current_scatter_list)
+    m_slot_scatter_lists[slot] = ScatterGatherList::create(request, move(allocated_dma_regions), m_connected_device->block_size());
+    if (!m_slot_scatter_lists[slot])
         return AsyncDeviceRequest::Failure;
     if (request.request_type() == AsyncBlockDeviceRequest::Write) {
-        if (!request.read_from_buffer(request.buffer(), m_current_scatter_list->dma_region().as_ptr(), m_connected_device->block_size() * request.block_count())) {
+        if (!request.read_from_buffer(request.buffer(), m_slot_scatter_lists[slot]->dma_region().as_ptr(), m_connected_device->block_size() * request.block_count())) {
             return AsyncDeviceRequest::MemoryFault;
         }
     }
@@ -446,34 +445,59 @@ void AHCIPort::start_request(AsyncBlockDeviceRequest& request)
 {
     Locker locker(m_lock);
     dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request start", representative_port_index());
-    VERIFY(!m_current_request);
-    VERIFY(!m_current_scatter_list);
+    auto slot = try_to_find_unused_command_header();
+    // The device's request queue depth never exceeds our slot count, so
+    // there's always a free slot when a request is started.
+    VERIFY(slot.has_value());
+    VERIFY(!m_slot_requests[slot.value()]);
+    VERIFY(!m_slot_scatter_lists[slot.value()]);
 
-    m_current_request = request;
+    m_slot_requests[slot.value()] = request;
 
-    auto result = prepare_and_set_scatter_list(request);
+    auto result = prepare_and_set_scatter_list(request, slot.value());
     if (result.has_value()) {
         dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request failure.", representative_port_index());
         locker.unlock();
-        complete_current_request(result.value());
+        complete_request_in_slot(slot.value(), result.value());
         return;
     }
 
-    auto success = access_device(request.request_type(), request.block_index(), request.block_count());
+    auto success = access_device(request.request_type(), request.block_index(), request.block_count(), slot.value());
     if (!success) {
         dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request failure.", representative_port_index());
         locker.unlock();
-        complete_current_request(AsyncDeviceRequest::Failure);
+        complete_request_in_slot(slot.value(), AsyncDeviceRequest::Failure);
         return;
     }
 }
 
-void AHCIPort::complete_current_request(AsyncDeviceRequest::RequestResult result)
+void AHCIPort::finish_request_in_slot(u8 slot)
+{
+    Locker locker(m_lock);
+    VERIFY(m_slot_requests[slot]);
+    VERIFY(m_slot_scatter_lists[slot]);
+    auto& request = *m_slot_requests[slot];
+    if (request.request_type() == AsyncBlockDeviceRequest::Read) {
+        if (!request.write_to_buffer(request.buffer(), m_slot_scatter_lists[slot]->dma_region().as_ptr(), m_connected_device->block_size() * request.block_count())) {
+            dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request failure, memory fault occurred when reading in data.", representative_port_index());
+            m_slot_scatter_lists[slot] = nullptr;
+            locker.unlock();
+            complete_request_in_slot(slot, AsyncDeviceRequest::MemoryFault);
+            return;
+        }
+    }
+    m_slot_scatter_lists[slot] = nullptr;
+    dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request success", representative_port_index());
+    locker.unlock();
+    complete_request_in_slot(slot, AsyncDeviceRequest::Success);
+}
+
+void AHCIPort::complete_request_in_slot(u8 slot, AsyncDeviceRequest::RequestResult result)
 {
-    VERIFY(m_current_request);
-    auto current_request = m_current_request;
-    m_current_request.clear();
-    current_request->complete(result);
+    VERIFY(m_slot_requests[slot]);
+    auto request = m_slot_requests[slot];
+    m_slot_requests[slot].clear();
+    request->complete(result);
 }
 
 bool AHCIPort::spin_until_ready() const
@@ -492,35 +516,33 @@ bool AHCIPort::spin_until_ready() const
     return true;
 }
 
-bool AHCIPort::access_device(AsyncBlockDeviceRequest::RequestType direction, u64 lba, u8 block_count)
+bool AHCIPort::access_device(AsyncBlockDeviceRequest::RequestType direction, u64 lba, u8 block_count, u8 slot)
 {
     VERIFY(m_connected_device);
     VERIFY(is_operable());
     VERIFY(m_lock.is_locked());
-    VERIFY(m_current_scatter_list);
+    VERIFY(m_slot_scatter_lists[slot]);
     ScopedSpinLock lock(m_hard_lock);
 
     dbgln_if(AHCI_DEBUG, "AHCI Port {}: Do a {}, lba {}, block count {}", representative_port_index(), direction == AsyncBlockDeviceRequest::RequestType::Write ? "write" : "read", lba, block_count);
     if (!spin_until_ready())
         return false;
 
-    auto unused_command_header = try_to_find_unused_command_header();
-    VERIFY(unused_command_header.has_value());
     auto* command_list_entries = (volatile AHCI::CommandHeader*)m_command_list_region->vaddr().as_ptr();
-    command_list_entries[unused_command_header.value()].ctba = m_command_table_pages[unused_command_header.value()].paddr().get();
-    command_list_entries[unused_command_header.value()].ctbau = 0;
-    command_list_entries[unused_command_header.value()].prdbc = 0;
-    command_list_entries[unused_command_header.value()].prdtl = m_current_scatter_list->scatters_count();
+    command_list_entries[slot].ctba = m_command_table_pages[slot].paddr().get();
+    command_list_entries[slot].ctbau = 0;
+    command_list_entries[slot].prdbc = 0;
+    command_list_entries[slot].prdtl = m_slot_scatter_lists[slot]->scatters_count();
 
     // Note: we must set the correct Dword count in this register. Real hardware
     // AHCI controllers do care about this field! QEMU doesn't care if we don't
     // set the correct CFL field in this register, real hardware will set an
     // handshake error bit in PxSERR register if CFL is incorrect.
-    command_list_entries[unused_command_header.value()].attributes = (size_t)FIS::DwordCount::RegisterHostToDevice | AHCI::CommandHeaderAttributes::P | AHCI::CommandHeaderAttributes::C | (is_atapi_attached() ? AHCI::CommandHeaderAttributes::A : 0) | (direction == AsyncBlockDeviceRequest::RequestType::Write ? AHCI::CommandHeaderAttributes::W : 0);
+    command_list_entries[slot].attributes = (size_t)FIS::DwordCount::RegisterHostToDevice | AHCI::CommandHeaderAttributes::P | AHCI::CommandHeaderAttributes::C | (is_atapi_attached() ? AHCI::CommandHeaderAttributes::A : 0) | (direction == AsyncBlockDeviceRequest::RequestType::Write ? AHCI::CommandHeaderAttributes::W : 0);
 
-    dbgln_if(AHCI_DEBUG, "AHCI Port {}: CLE: ctba=0x{:08x}, ctbau=0x{:08x}, prdbc=0x{:08x}, prdtl=0x{:04x}, attributes=0x{:04x}", representative_port_index(), (u32)command_list_entries[unused_command_header.value()].ctba, (u32)command_list_entries[unused_command_header.value()].ctbau, (u32)command_list_entries[unused_command_header.value()].prdbc, (u16)command_list_entries[unused_command_header.value()].prdtl, (u16)command_list_entries[unused_command_header.value()].attributes);
+    dbgln_if(AHCI_DEBUG, "AHCI Port {}: CLE: ctba=0x{:08x}, ctbau=0x{:08x}, prdbc=0x{:08x}, prdtl=0x{:04x}, attributes=0x{:04x}", representative_port_index(), (u32)command_list_entries[slot].ctba, (u32)command_list_entries[slot].ctbau, (u32)command_list_entries[slot].prdbc, (u16)command_list_entries[slot].prdtl, (u16)command_list_entries[slot].attributes);
 
-    auto command_table_region = MM.allocate_kernel_region(m_command_table_pages[unused_command_header.value()].paddr().page_base(), page_round_up(sizeof(AHCI::CommandTable)), "AHCI Command Table", Region::Access::Read | Region::Access::Write, Region::Cacheable::No);
+    auto command_table_region = MM.allocate_kernel_region(m_command_table_pages[slot].paddr().page_base(), page_round_up(sizeof(AHCI::CommandTable)), "AHCI Command Table", Region::Access::Read | Region::Access::Write, Region::Cacheable::No);
     auto& command_table = *(volatile AHCI::CommandTable*)command_table_region->vaddr().as_ptr();
 
     dbgln_if(AHCI_DEBUG, "AHCI Port {}: Allocated command table at {}", representative_port_index(), command_table_region->vaddr());
@@ -529,7 +551,7 @@ bool AHCIPort::access_device(AsyncBlockDeviceRequest::RequestType direction, u64
 
     size_t scatter_entry_index = 0;
     size_t data_transfer_count = (block_count * m_connected_device->block_size());
-    for (auto scatter_page : m_current_scatter_list->vmobject().physical_pages()) {
+    for (auto scatter_page : m_slot_scatter_lists[slot]->vmobject().physical_pages()) {
         VERIFY(data_transfer_count != 0);
         VERIFY(scatter_page);
         dbgln_if(AHCI_DEBUG, "AHCI Port {}: Add a transfer scatter entry @ {}", representative_port_index(), scatter_page->paddr());
@@ -578,7 +600,7 @@ bool AHCIPort::access_device(AsyncBlockDeviceRequest::RequestType direction, u64
         return false;
 
     full_memory_barrier();
-    mark_command_header_ready_to_process(unused_command_header.value());
+    mark_command_header_ready_to_process(slot);
     full_memory_barrier();
 
     dbgln_if(AHCI_DEBUG, "AHCI Port {}: Do a {}, lba {}, block count {} @ {}, ended", representative_port_index(), direction == AsyncBlockDeviceRequest::RequestType::Write ? "write" : "read", lba, block_count, m_dma_buffers[0].paddr());
@@ -658,8 +680,10 @@ Optional<u8> AHCIPort::try_to_find_unused_command_header()
 {
     VERIFY(m_lock.is_locked());
     u32 commands_issued = m_port_registers.ci;
-    for (size_t index = 0; index < 32; index++) {
-        if (!(commands_issued & 1)) {
+    for (size_t index = 0; index < command_slots_count; index++) {
+        // Note: A slot whose command has completed still counts as busy until
+        // its request has been finished off by the I/O work queue.
+        if (!(commands_issued & 1) && !m_slot_requests[index]) {
             dbgln_if(AHCI_DEBUG, "AHCI Port {}: unused command header at index {}", representative_port_index(), index);
             return index;
         }
@@ -682,7 +706,6 @@ void AHCIPort::mark_command_header_ready_to_process(u8 command_header_index) con
     VERIFY(m_lock.is_locked());
     VERIFY(m_hard_lock.is_locked());
     VERIFY(is_operable());
-    VERIFY(!m_wait_for_completion);
     m_wait_for_completion = true;
     dbgln_if(AHCI_DEBUG, "AHCI Port {}: Marking command header at index {} as ready to process.", representative_port_index(), command_header_index);
     m_port_registers.ci = 1 << command_header_index;
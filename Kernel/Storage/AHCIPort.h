@@ -34,6 +34,11 @@ class AHCIPort : public RefCounted<AHCIPort> {
     friend class SATADiskDevice;
 
 public:
+    // How many command slots we set up with their own command table and DMA
+    // bounce buffer. The HBA supports up to 32, but a handful is plenty to
+    // keep the device busy while completed requests are being finished off.
+    static constexpr size_t command_slots_count = 4;
+
     UNMAP_AFTER_INIT static NonnullRefPtr<AHCIPort> create(const AHCIPortHandler&, volatile AHCI::PortRegisters&, u32 port_index);
 
     u32 port_index() const { return m_port_index; }
@@ -69,10 +74,11 @@ private:
     ALWAYS_INLINE void power_on() const;
 
     void start_request(AsyncBlockDeviceRequest&);
-    void complete_current_request(AsyncDeviceRequest::RequestResult);
-    bool access_device(AsyncBlockDeviceRequest::RequestType, u64 lba, u8 block_count);
+    void finish_request_in_slot(u8 slot);
+    void complete_request_in_slot(u8 slot, AsyncDeviceRequest::RequestResult);
+    bool access_device(AsyncBlockDeviceRequest::RequestType, u64 lba, u8 block_count, u8 slot);
     size_t calculate_descriptors_count(size_t block_count) const;
-    [[nodiscard]] Optional<AsyncDeviceRequest::RequestResult> prepare_and_set_scatter_list(AsyncBlockDeviceRequest& request);
+    [[nodiscard]] Optional<AsyncDeviceRequest::RequestResult> prepare_and_set_scatter_list(AsyncBlockDeviceRequest& request, u8 slot);
 
     ALWAYS_INLINE bool is_interrupts_enabled() const;
 
@@ -99,7 +105,8 @@ private:
     // Data members
 
     EntropySource m_entropy_source;
-    RefPtr<AsyncBlockDeviceRequest> m_current_request;
+    // One entry per command slot, so several requests can be in flight at once.
+    RefPtr<AsyncBlockDeviceRequest> m_slot_requests[command_slots_count];
     SpinLock<u8> m_hard_lock;
     Lock m_lock { "AHCIPort" };
 
@@ -119,7 +126,7 @@ private:
     AHCI::PortInterruptStatusBitField m_interrupt_status;
     AHCI::PortInterruptEnableBitField m_interrupt_enable;
 
-    RefPtr<ScatterGatherList> m_current_scatter_list;
+    RefPtr<ScatterGatherList> m_slot_scatter_lists[command_slots_count];
     bool m_disabled_by_firmware { false };
 };
 }
@@ -35,6 +35,9 @@ public:
 private:
     SATADiskDevice(const AHCIController&, const AHCIPort&, size_t sector_size, u64 max_addressable_block);
 
+    // ^Device
+    virtual size_t request_queue_depth() const override { return AHCIPort::command_slots_count; }
+
     // ^DiskDevice
     virtual const char* class_name() const override;
     NonnullRefPtr<AHCIPort> m_port;
@@ -42,6 +42,7 @@ KResultOr<int> Process::sys$anon_create(size_t size, int options)
     if (options & O_CLOEXEC)
         fd_flags |= FD_CLOEXEC;
 
+    ScopedSpinLock lock(m_fds_lock);
     m_fds[new_fd].set(move(description), fd_flags);
     return new_fd;
 }
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/AsyncIORing.h>
+#include <Kernel/FileSystem/FileDescription.h>
+#include <Kernel/Process.h>
+
+namespace Kernel {
+
+KResultOr<int> Process::sys$async_io_create()
+{
+    REQUIRE_PROMISE(stdio);
+
+    int new_fd = alloc_fd();
+    if (new_fd < 0)
+        return new_fd;
+
+    auto ring_or_error = AsyncIORing::create();
+    if (ring_or_error.is_error())
+        return ring_or_error.error();
+
+    auto description_or_error = FileDescription::create(*ring_or_error.value());
+    if (description_or_error.is_error())
+        return description_or_error.error();
+
+    auto description = description_or_error.release_value();
+    description->set_readable(true);
+
+    ScopedSpinLock lock(m_fds_lock);
+    m_fds[new_fd].set(move(description), FD_CLOEXEC);
+    return new_fd;
+}
+
+KResultOr<ssize_t> Process::sys$async_io_submit(int ring_fd, size_t count)
+{
+    REQUIRE_PROMISE(stdio);
+
+    auto description = file_description(ring_fd);
+    if (!description)
+        return EBADF;
+    if (!description->file().is_async_io_ring())
+        return EINVAL;
+
+    auto result = static_cast<AsyncIORing&>(description->file()).process_submissions(*this, count);
+    if (result.is_error())
+        return result.error();
+    return (ssize_t)result.value();
+}
+
+}
@@ -19,7 +19,14 @@ KResultOr<int> Process::sys$dup2(int old_fd, int new_fd)
         return 0;
     if (new_fd < 0 || new_fd >= m_max_open_file_descriptors)
         return EINVAL;
-    m_fds[new_fd].set(*description);
+    RefPtr<FileDescription> description_to_drop;
+    {
+        // Hold a ref to whatever is being displaced so it isn't destroyed
+        // (and possibly blocks) while the lock is held.
+        ScopedSpinLock lock(m_fds_lock);
+        description_to_drop = m_fds[new_fd].description();
+        m_fds[new_fd].set(*description);
+    }
     return new_fd;
 }
 
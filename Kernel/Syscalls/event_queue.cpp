@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Time.h>
+#include <Kernel/FileSystem/EventQueue.h>
+#include <Kernel/FileSystem/FileDescription.h>
+#include <Kernel/Process.h>
+
+namespace Kernel {
+
+KResultOr<int> Process::sys$event_queue_create()
+{
+    REQUIRE_PROMISE(stdio);
+
+    int new_fd = alloc_fd();
+    if (new_fd < 0)
+        return new_fd;
+
+    auto queue_or_error = EventQueue::create();
+    if (queue_or_error.is_error())
+        return queue_or_error.error();
+
+    auto description_or_error = FileDescription::create(*queue_or_error.value());
+    if (description_or_error.is_error())
+        return description_or_error.error();
+
+    auto description = description_or_error.release_value();
+    description->set_readable(true);
+
+    ScopedSpinLock lock(m_fds_lock);
+    m_fds[new_fd].set(move(description), FD_CLOEXEC);
+    return new_fd;
+}
+
+KResultOr<int> Process::sys$event_queue_ctl(Userspace<const Syscall::SC_event_queue_ctl_params*> user_params)
+{
+    REQUIRE_PROMISE(stdio);
+
+    Syscall::SC_event_queue_ctl_params params;
+    if (!copy_from_user(&params, user_params))
+        return EFAULT;
+
+    auto queue_description = file_description(params.queue_fd);
+    if (!queue_description)
+        return EBADF;
+    if (!queue_description->file().is_event_queue())
+        return EINVAL;
+    auto& queue = static_cast<EventQueue&>(queue_description->file());
+
+    switch (params.op) {
+    case EVENT_QUEUE_ADD: {
+        auto description = file_description(params.fd);
+        if (!description)
+            return EBADF;
+        // Watching a queue with itself would deadlock its can_read().
+        if (description->file().is_event_queue() && &description->file() == &queue)
+            return EINVAL;
+        auto result = queue.add(params.fd, description.release_nonnull(), params.events);
+        if (result.is_error())
+            return result;
+        return 0;
+    }
+    case EVENT_QUEUE_MODIFY: {
+        auto result = queue.modify(params.fd, params.events);
+        if (result.is_error())
+            return result;
+        return 0;
+    }
+    case EVENT_QUEUE_DELETE: {
+        auto result = queue.remove(params.fd);
+        if (result.is_error())
+            return result;
+        return 0;
+    }
+    default:
+        return EINVAL;
+    }
+}
+
+KResultOr<int> Process::sys$event_queue_wait(Userspace<const Syscall::SC_event_queue_wait_params*> user_params)
+{
+    REQUIRE_PROMISE(stdio);
+
+    Syscall::SC_event_queue_wait_params params;
+    if (!copy_from_user(&params, user_params))
+        return EFAULT;
+
+    if (params.max_events < 1)
+        return EINVAL;
+
+    auto queue_description = file_description(params.queue_fd);
+    if (!queue_description)
+        return EBADF;
+    if (!queue_description->file().is_event_queue())
+        return EINVAL;
+    auto& queue = static_cast<EventQueue&>(queue_description->file());
+
+    Thread::BlockTimeout timeout;
+    if (params.timeout) {
+        Optional<Time> timeout_time = copy_time_from_user(params.timeout);
+        if (!timeout_time.has_value())
+            return EFAULT;
+        timeout = Thread::BlockTimeout(false, &timeout_time.value());
+    }
+
+    return queue.wait(params.events, params.max_events, timeout);
+}
+
+}
@@ -561,10 +561,18 @@ KResult Process::do_exec(NonnullRefPtr<FileDescription> main_program_description
 
     clear_futex_queues_on_exec();
 
-    for (size_t i = 0; i < m_fds.size(); ++i) {
-        auto& description_and_flags = m_fds[i];
-        if (description_and_flags.description() && description_and_flags.flags() & FD_CLOEXEC)
-            description_and_flags = {};
+    {
+        // Hold refs to the FD_CLOEXEC descriptions so they are destroyed
+        // after the lock is released; ~FileDescription can block.
+        NonnullRefPtrVector<FileDescription> fds_to_drop;
+        ScopedSpinLock lock(m_fds_lock);
+        for (size_t i = 0; i < m_fds.size(); ++i) {
+            auto& description_and_flags = m_fds[i];
+            if (description_and_flags.description() && description_and_flags.flags() & FD_CLOEXEC) {
+                fds_to_drop.append(*description_and_flags.description());
+                description_and_flags = {};
+            }
+        }
     }
 
     int main_program_fd = -1;
@@ -574,6 +582,7 @@ KResult Process::do_exec(NonnullRefPtr<FileDescription> main_program_description
         auto seek_result = main_program_description->seek(0, SEEK_SET);
         VERIFY(!seek_result.is_error());
         main_program_description->set_readable(true);
+        ScopedSpinLock lock(m_fds_lock);
         m_fds[main_program_fd].set(move(main_program_description), FD_CLOEXEC);
     }
 
@@ -27,14 +27,17 @@ KResultOr<int> Process::sys$fcntl(int fd, int cmd, u32 arg)
         int new_fd = alloc_fd(arg_fd);
         if (new_fd < 0)
             return new_fd;
+        ScopedSpinLock lock(m_fds_lock);
         m_fds[new_fd].set(*description);
         return new_fd;
     }
     case F_GETFD:
-        return m_fds[fd].flags();
-    case F_SETFD:
+        return fd_flags(fd);
+    case F_SETFD: {
+        ScopedSpinLock lock(m_fds_lock);
         m_fds[fd].set_flags(arg);
         break;
+    }
     case F_GETFL:
         return description->file_flags();
     case F_SETFL:
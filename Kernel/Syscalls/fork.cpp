@@ -24,7 +24,10 @@ KResultOr<pid_t> Process::sys$fork(RegisterState& regs)
     child->m_root_directory_relative_to_global_root = m_root_directory_relative_to_global_root;
     child->m_veil_state = m_veil_state;
     child->m_unveiled_paths = m_unveiled_paths.deep_copy();
-    child->m_fds = m_fds;
+    {
+        ScopedSpinLock lock(m_fds_lock);
+        child->m_fds = m_fds;
+    }
     child->m_pg = m_pg;
 
     {
@@ -75,7 +78,7 @@ KResultOr<pid_t> Process::sys$fork(RegisterState& regs)
             }
 
             auto& child_region = child->space().add_region(region_clone.release_nonnull());
-            child_region.map(child->space().page_directory(), ShouldFlushTLB::No);
+            child_region.map_lazily(child->space().page_directory());
 
             if (region == m_master_tls_region.unsafe_ptr())
                 child->m_master_tls_region = child_region;
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
+#include <AK/HashFunctions.h>
 #include <AK/Singleton.h>
 #include <Kernel/Debug.h>
 #include <Kernel/Process.h>
@@ -11,8 +13,21 @@
 
 namespace Kernel {
 
-static SpinLock<u8> g_global_futex_lock;
-static AK::Singleton<HashMap<VMObject*, FutexQueues>> g_global_futex_queues;
+// The global futex table is sharded by VMObject so that unrelated processes
+// hammering on shared-memory futexes don't all serialize on a single lock.
+// (Private futexes don't come through here at all; they use the per-Process
+// table under m_futex_lock.)
+static constexpr size_t global_futex_shard_count = 16; // Must be a power of two
+struct GlobalFutexShard {
+    SpinLock<u8> lock;
+    HashMap<VMObject*, FutexQueues> queues;
+};
+static AK::Singleton<Array<GlobalFutexShard, global_futex_shard_count>> g_global_futex_shards;
+
+static GlobalFutexShard& global_futex_shard_for(VMObject const& vmobject)
+{
+    return (*g_global_futex_shards)[ptr_hash(&vmobject) & (global_futex_shard_count - 1)];
+}
 
 FutexQueue::FutexQueue(FlatPtr user_address_or_offset, VMObject* vmobject)
     : m_user_address_or_offset(user_address_or_offset)
@@ -56,8 +71,9 @@ void FutexQueue::vmobject_deleted(VMObject& vmobject)
     m_vmobject = nullptr; // Just to be safe...
 
     {
-        ScopedSpinLock lock(g_global_futex_lock);
-        g_global_futex_queues->remove(&vmobject);
+        auto& shard = global_futex_shard_for(vmobject);
+        ScopedSpinLock lock(shard.lock);
+        shard.queues.remove(&vmobject);
     }
 
     bool did_wake_all;
@@ -120,7 +136,6 @@ KResultOr<int> Process::sys$futex(Userspace<const Syscall::SC_futex_params*> use
     }
 
     bool is_private = (params.futex_op & FUTEX_PRIVATE_FLAG) != 0;
-    auto& queue_lock = is_private ? m_futex_lock : g_global_futex_lock;
     auto user_address_or_offset = FlatPtr(params.userspace_address);
     auto user_address_or_offset2 = FlatPtr(params.userspace_address2);
 
@@ -148,8 +163,21 @@ KResultOr<int> Process::sys$futex(Userspace<const Syscall::SC_futex_params*> use
         }
     }
 
+    GlobalFutexShard* shard = nullptr;
+    GlobalFutexShard* shard2 = nullptr;
+    if (!is_private) {
+        shard = &global_futex_shard_for(*vmobject);
+        if (vmobject2 && vmobject2 != vmobject) {
+            auto& other_shard = global_futex_shard_for(*vmobject2);
+            if (&other_shard != shard)
+                shard2 = &other_shard;
+        }
+    }
+    auto& queue_lock = is_private ? m_futex_lock : shard->lock;
+
+    // NOTE: The caller must hold the shard lock for any vmobject passed here.
     auto find_global_futex_queues = [&](VMObject& vmobject, bool create_if_not_found) -> FutexQueues* {
-        auto& global_queues = *g_global_futex_queues;
+        auto& global_queues = global_futex_shard_for(vmobject).queues;
         auto it = global_queues.find(&vmobject);
         if (it != global_queues.end())
             return &it->value;
@@ -186,7 +214,7 @@ KResultOr<int> Process::sys$futex(Userspace<const Syscall::SC_futex_params*> use
         if (queues) {
             queues->remove(user_address_or_offset);
             if (!is_private && queues->is_empty())
-                g_global_futex_queues->remove(vmobject);
+                global_futex_shard_for(*vmobject).queues.remove(vmobject);
         }
     };
 
@@ -205,7 +233,15 @@ KResultOr<int> Process::sys$futex(Userspace<const Syscall::SC_futex_params*> use
         return (int)woke_count;
     };
 
+    // A requeue or wake-op may involve a second VMObject whose queues live in
+    // a different shard. Take the two shard locks in address order so that two
+    // such operations going in opposite directions cannot deadlock.
+    Optional<ScopedSpinLock<SpinLock<u8>>> shard2_lock;
+    if (shard2 && &shard2->lock < &queue_lock)
+        shard2_lock.emplace(shard2->lock);
     ScopedSpinLock lock(queue_lock);
+    if (shard2 && !shard2_lock.has_value())
+        shard2_lock.emplace(shard2->lock);
 
     auto do_wait = [&](u32 bitset) -> int {
         auto user_value = user_atomic_load_relaxed(params.userspace_address);
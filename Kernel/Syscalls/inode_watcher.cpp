@@ -29,11 +29,13 @@ KResultOr<int> Process::sys$create_inode_watcher(u32 flags)
     if (description_or_error.is_error())
         return description_or_error.error();
 
-    m_fds[fd].set(description_or_error.release_value());
-    m_fds[fd].description()->set_readable(true);
-
+    auto description = description_or_error.release_value();
+    description->set_readable(true);
     if (flags & static_cast<unsigned>(InodeWatcherFlags::Nonblock))
-        m_fds[fd].description()->set_blocking(false);
+        description->set_blocking(false);
+
+    ScopedSpinLock lock(m_fds_lock);
+    m_fds[fd].set(move(description));
     if (flags & static_cast<unsigned>(InodeWatcherFlags::CloseOnExec))
         m_fds[fd].set_flags(m_fds[fd].flags() | FD_CLOEXEC);
 
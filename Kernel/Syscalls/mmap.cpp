@@ -177,6 +177,7 @@ KResultOr<FlatPtr> Process::sys$mmap(Userspace<const Syscall::SC_mmap_params*> u
     bool map_fixed = flags & MAP_FIXED;
     bool map_noreserve = flags & MAP_NORESERVE;
     bool map_randomized = flags & MAP_RANDOMIZED;
+    bool map_huge = flags & MAP_HUGEPAGES;
 
     if (map_shared && map_private)
         return EINVAL;
@@ -193,6 +194,16 @@ KResultOr<FlatPtr> Process::sys$mmap(Userspace<const Syscall::SC_mmap_params*> u
     if (map_stack && (!map_private || !map_anonymous))
         return EINVAL;
 
+    if (map_huge && (!map_private || !map_anonymous || map_stack))
+        return EINVAL;
+
+    // MAP_HUGEPAGES is only a hint. Mappings smaller than one huge page
+    // can't use them, and the extra alignment would just waste VM.
+    if (map_huge && size < Region::huge_page_size)
+        map_huge = false;
+    if (map_huge && alignment < Region::huge_page_size)
+        alignment = Region::huge_page_size;
+
     Region* region = nullptr;
     Optional<Range> range;
 
@@ -212,11 +223,20 @@ KResultOr<FlatPtr> Process::sys$mmap(Userspace<const Syscall::SC_mmap_params*> u
         return ENOMEM;
 
     if (map_anonymous) {
-        auto strategy = map_noreserve ? AllocationStrategy::None : AllocationStrategy::Reserve;
-        auto region_or_error = space().allocate_region(range.value(), !name.is_null() ? name : "mmap", prot, strategy);
-        if (region_or_error.is_error())
-            return region_or_error.error().error();
-        region = region_or_error.value();
+        if (map_huge && range.value().base().get() % Region::huge_page_size == 0) {
+            auto region_or_error = space().allocate_region_with_huge_pages(range.value(), !name.is_null() ? name : "mmap", prot);
+            if (!region_or_error.is_error())
+                region = region_or_error.value();
+            // On failure (e.g. fragmented physical memory) fall through
+            // and back the mapping with regular 4KiB pages.
+        }
+        if (!region) {
+            auto strategy = map_noreserve ? AllocationStrategy::None : AllocationStrategy::Reserve;
+            auto region_or_error = space().allocate_region(range.value(), !name.is_null() ? name : "mmap", prot, strategy);
+            if (region_or_error.is_error())
+                return region_or_error.error().error();
+            region = region_or_error.value();
+        }
     } else {
         if (offset < 0)
             return EINVAL;
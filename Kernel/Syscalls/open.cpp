@@ -71,6 +71,7 @@ KResultOr<int> Process::sys$open(Userspace<const Syscall::SC_open_params*> user_
         return ENXIO;
 
     u32 fd_flags = (options & O_CLOEXEC) ? FD_CLOEXEC : 0;
+    ScopedSpinLock lock(m_fds_lock);
     m_fds[fd].set(move(description), fd_flags);
     return fd;
 }
@@ -83,7 +84,12 @@ KResultOr<int> Process::sys$close(int fd)
     if (!description)
         return EBADF;
     int rc = description->close();
-    m_fds[fd] = {};
+    {
+        // The local ref above keeps the description alive, so clearing the
+        // slot can't run ~FileDescription under the lock.
+        ScopedSpinLock lock(m_fds_lock);
+        m_fds[fd] = {};
+    }
     return rc;
 }
 
@@ -11,6 +11,11 @@ namespace Kernel {
 
 KResultOr<int> Process::sys$perf_event(int type, FlatPtr arg1, FlatPtr arg2)
 {
+    // Checking the event mask up front keeps always-on trace points cheap
+    // (and avoids allocating an event buffer) while nothing is profiling
+    // this process; append() would reject the event anyway.
+    if ((g_profiling_event_mask & type) == 0)
+        return EINVAL;
     auto events_buffer = current_perf_events_buffer();
     if (!events_buffer) {
         if (!create_perf_events_buffer_if_needed())
@@ -34,6 +34,7 @@ KResultOr<int> Process::sys$profiling_enable(pid_t pid, u64 event_mask)
         ScopedSpinLock lock(g_processes_lock);
         if (!TimeManagement::the().enable_profile_timer())
             return ENOTSUP;
+        PerformanceCounters::enable();
         g_profiling_all_threads = true;
         PerformanceManager::add_process_created_event(*Scheduler::colonel());
         Process::for_each([](auto& process) {
@@ -61,6 +62,7 @@ KResultOr<int> Process::sys$profiling_enable(pid_t pid, u64 event_mask)
         process->set_profiling(false);
         return ENOTSUP;
     }
+    PerformanceCounters::enable();
     return 0;
 }
 
@@ -74,6 +76,7 @@ KResultOr<int> Process::sys$profiling_disable(pid_t pid)
         ScopedCritical critical;
         if (!TimeManagement::the().disable_profile_timer())
             return ENOTSUP;
+        PerformanceCounters::disable();
         g_profiling_all_threads = false;
         return 0;
     }
@@ -89,6 +92,7 @@ KResultOr<int> Process::sys$profiling_disable(pid_t pid)
     // FIXME: If we enabled the profile timer and it's not supported, how do we disable it now?
     if (!TimeManagement::the().disable_profile_timer())
         return ENOTSUP;
+    PerformanceCounters::disable();
     process->set_profiling(false);
     return 0;
 }
@@ -84,4 +84,63 @@ KResultOr<int> Process::sys$sched_getparam(pid_t pid, Userspace<struct sched_par
     return 0;
 }
 
+static u32 all_processors_mask()
+{
+    auto count = Processor::count();
+    if (count >= 32)
+        return ~0u;
+    return (1u << count) - 1;
+}
+
+KResultOr<int> Process::sys$sched_setaffinity(pid_t tid, Userspace<const u32*> user_mask)
+{
+    REQUIRE_PROMISE(proc);
+    u32 affinity_mask;
+    if (!copy_from_user(&affinity_mask, user_mask))
+        return EFAULT;
+
+    // The thread must remain schedulable on at least one processor that
+    // actually exists.
+    if ((affinity_mask & all_processors_mask()) == 0)
+        return EINVAL;
+
+    auto* peer = Thread::current();
+    ScopedSpinLock lock(g_scheduler_lock);
+    if (tid != 0)
+        peer = Thread::from_tid(tid);
+
+    if (!peer)
+        return ESRCH;
+
+    if (!is_superuser() && euid() != peer->process().uid() && uid() != peer->process().uid())
+        return EPERM;
+
+    peer->set_affinity(affinity_mask);
+    return 0;
+}
+
+KResultOr<int> Process::sys$sched_getaffinity(pid_t tid, Userspace<u32*> user_mask)
+{
+    REQUIRE_PROMISE(proc);
+    u32 affinity_mask;
+    {
+        auto* peer = Thread::current();
+        ScopedSpinLock lock(g_scheduler_lock);
+        if (tid != 0)
+            peer = Thread::from_tid(tid);
+
+        if (!peer)
+            return ESRCH;
+
+        if (!is_superuser() && euid() != peer->process().uid() && uid() != peer->process().uid())
+            return EPERM;
+
+        affinity_mask = peer->affinity();
+    }
+
+    if (!copy_to_user(user_mask, &affinity_mask))
+        return EFAULT;
+    return 0;
+}
+
 }
@@ -53,12 +53,15 @@ KResultOr<int> Process::sys$select(Userspace<const Syscall::SC_select_params*> u
     if (bytes_used > sizeof(fds_read))
         return EINVAL;
 
-    if (params.readfds && !copy_from_user(&fds_read, params.readfds, bytes_used))
-        return EFAULT;
-    if (params.writefds && !copy_from_user(&fds_write, params.writefds, bytes_used))
-        return EFAULT;
-    if (params.exceptfds && !copy_from_user(&fds_except, params.exceptfds, bytes_used))
-        return EFAULT;
+    {
+        UserAccessBatch batch;
+        if (params.readfds && !batch.copy_from_user(&fds_read, params.readfds, bytes_used))
+            return EFAULT;
+        if (params.writefds && !batch.copy_from_user(&fds_write, params.writefds, bytes_used))
+            return EFAULT;
+        if (params.exceptfds && !batch.copy_from_user(&fds_except, params.exceptfds, bytes_used))
+            return EFAULT;
+    }
 
     Thread::SelectBlocker::FDVector fds_info;
     Vector<int, FD_SETSIZE> fds;
@@ -118,12 +121,15 @@ KResultOr<int> Process::sys$select(Userspace<const Syscall::SC_select_params*> u
         }
     }
 
-    if (params.readfds && !copy_to_user(params.readfds, &fds_read, bytes_used))
-        return EFAULT;
-    if (params.writefds && !copy_to_user(params.writefds, &fds_write, bytes_used))
-        return EFAULT;
-    if (params.exceptfds && !copy_to_user(params.exceptfds, &fds_except, bytes_used))
-        return EFAULT;
+    {
+        UserAccessBatch batch;
+        if (params.readfds && !batch.copy_to_user(params.readfds, &fds_read, bytes_used))
+            return EFAULT;
+        if (params.writefds && !batch.copy_to_user(params.writefds, &fds_write, bytes_used))
+            return EFAULT;
+        if (params.exceptfds && !batch.copy_to_user(params.exceptfds, &fds_except, bytes_used))
+            return EFAULT;
+    }
     return marked_fd_count;
 }
 
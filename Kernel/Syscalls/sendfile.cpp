@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/NumericLimits.h>
+#include <Kernel/FileSystem/FileDescription.h>
+#include <Kernel/KBuffer.h>
+#include <Kernel/Process.h>
+#include <Kernel/UserOrKernelBuffer.h>
+
+namespace Kernel {
+
+KResultOr<ssize_t> Process::sys$sendfile(Userspace<const Syscall::SC_sendfile_params*> user_params)
+{
+    REQUIRE_PROMISE(stdio);
+    Syscall::SC_sendfile_params params;
+    if (!copy_from_user(&params, user_params))
+        return EFAULT;
+
+    if (params.count > NumericLimits<i32>::max())
+        return EINVAL;
+
+    auto out_description = file_description(params.out_fd);
+    if (!out_description)
+        return EBADF;
+    if (!out_description->is_writable())
+        return EBADF;
+
+    auto in_description = file_description(params.in_fd);
+    if (!in_description)
+        return EBADF;
+    if (!in_description->is_readable())
+        return EBADF;
+    // The input must be seekable so that short writes can rewind it; this
+    // also rules out sockets and pipes, just like other systems do.
+    if (!in_description->file().is_seekable())
+        return EINVAL;
+
+    off_t original_offset = in_description->offset();
+    if (params.offset) {
+        off_t requested_offset = 0;
+        if (!copy_from_user(&requested_offset, params.offset))
+            return EFAULT;
+        auto seek_result = in_description->seek(requested_offset, SEEK_SET);
+        if (seek_result.is_error())
+            return seek_result.error();
+    }
+
+    // Stream via an in-kernel staging buffer so the file contents never make
+    // a round trip through userspace; one buffer serves the whole transfer.
+    auto chunk_buffer = KBuffer::try_create_with_size(64 * KiB, Region::Access::Read | Region::Access::Write, "sendfile");
+    if (!chunk_buffer)
+        return ENOMEM;
+    auto kernel_buffer = UserOrKernelBuffer::for_kernel_buffer(chunk_buffer->data());
+
+    auto finalize = [&](ssize_t total_sent) -> KResultOr<ssize_t> {
+        if (params.offset) {
+            off_t updated_offset = in_description->offset();
+            [[maybe_unused]] auto restore_result = in_description->seek(original_offset, SEEK_SET);
+            if (!copy_to_user(params.offset, &updated_offset))
+                return EFAULT;
+        }
+        return total_sent;
+    };
+
+    ssize_t total_sent = 0;
+    size_t remaining = params.count;
+    while (remaining > 0) {
+        size_t chunk_size = min(remaining, chunk_buffer->size());
+        auto nread_or_error = in_description->read(kernel_buffer, chunk_size);
+        if (nread_or_error.is_error()) {
+            if (total_sent > 0)
+                return finalize(total_sent);
+            return nread_or_error.error();
+        }
+        auto nread = nread_or_error.value();
+        if (nread == 0)
+            break;
+
+        auto nwritten_or_error = do_write(*out_description, kernel_buffer, nread);
+        if (nwritten_or_error.is_error()) {
+            if (total_sent > 0)
+                return finalize(total_sent);
+            return nwritten_or_error.error();
+        }
+        auto nwritten = nwritten_or_error.value();
+        total_sent += nwritten;
+        remaining -= nwritten;
+
+        if ((size_t)nwritten < nread) {
+            // Rewind past the part of the chunk the output didn't take.
+            auto seek_result = in_description->seek(nwritten - (off_t)nread, SEEK_CUR);
+            if (seek_result.is_error())
+                return seek_result.error();
+            break;
+        }
+    }
+
+    return finalize(total_sent);
+}
+
+}
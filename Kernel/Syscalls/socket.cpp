@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ScopeGuard.h>
 #include <Kernel/FileSystem/FileDescription.h>
 #include <Kernel/Net/IPv4Socket.h>
 #include <Kernel/Net/LocalSocket.h>
@@ -29,6 +30,7 @@ void Process::setup_socket_fd(int fd, NonnullRefPtr<FileDescription> description
         flags |= FD_CLOEXEC;
     if (type & SOCK_NONBLOCK)
         description->set_blocking(false);
+    ScopedSpinLock lock(m_fds_lock);
     m_fds[fd].set(*description, flags);
 }
 
@@ -139,7 +141,10 @@ KResultOr<int> Process::sys$accept4(Userspace<const Syscall::SC_accept4_params*>
     int fd_flags = 0;
     if (flags & SOCK_CLOEXEC)
         fd_flags |= FD_CLOEXEC;
-    m_fds[accepted_socket_fd].set(accepted_socket_description_result.release_value(), fd_flags);
+    {
+        ScopedSpinLock lock(m_fds_lock);
+        m_fds[accepted_socket_fd].set(accepted_socket_description_result.release_value(), fd_flags);
+    }
 
     // NOTE: Moving this state to Completed is what causes connect() to unblock on the client side.
     accepted_socket->set_setup_state(Socket::SetupState::Completed);
@@ -288,6 +293,114 @@ KResultOr<ssize_t> Process::sys$recvmsg(int sockfd, Userspace<struct msghdr*> us
     return result.value();
 }
 
+KResultOr<ssize_t> Process::sys$recvmmsg(Userspace<const Syscall::SC_recvmmsg_params*> user_params)
+{
+    REQUIRE_PROMISE(stdio);
+
+    Syscall::SC_recvmmsg_params params;
+    if (!copy_from_user(&params, user_params))
+        return EFAULT;
+
+    if (params.vlen == 0)
+        return EINVAL;
+
+    auto description = file_description(params.sockfd);
+    if (!description)
+        return EBADF;
+    if (!description->is_socket())
+        return ENOTSOCK;
+    auto& socket = *description->socket();
+
+    if (socket.is_shut_down_for_reading())
+        return 0;
+
+    bool original_blocking = description->is_blocking();
+    ScopeGuard restore_blocking([&] {
+        description->set_blocking(original_blocking);
+    });
+
+    ssize_t messages_received = 0;
+    for (unsigned i = 0; i < params.vlen; ++i) {
+        // Only the first datagram may block; once we have something to
+        // deliver, drain whatever else is already queued and return.
+        if (i > 0 || (params.flags & MSG_DONTWAIT))
+            description->set_blocking(false);
+
+        auto user_mmsg = &params.msgvec[i];
+        struct mmsghdr mmsg;
+        if (!copy_from_user(&mmsg, user_mmsg)) {
+            if (messages_received > 0)
+                return messages_received;
+            return EFAULT;
+        }
+        auto& msg = mmsg.msg_hdr;
+
+        if (msg.msg_iovlen != 1) {
+            if (messages_received > 0)
+                return messages_received;
+            return ENOTSUP; // FIXME: Support this :)
+        }
+        iovec iov;
+        if (!copy_from_user(&iov, msg.msg_iov)) {
+            if (messages_received > 0)
+                return messages_received;
+            return EFAULT;
+        }
+
+        Userspace<sockaddr*> user_addr((FlatPtr)msg.msg_name);
+        Userspace<socklen_t*> user_addr_length(msg.msg_name ? (FlatPtr)&user_mmsg->msg_hdr.msg_namelen : 0);
+
+        auto data_buffer = UserOrKernelBuffer::for_user_buffer((u8*)iov.iov_base, iov.iov_len);
+        if (!data_buffer.has_value()) {
+            if (messages_received > 0)
+                return messages_received;
+            return EFAULT;
+        }
+        Time timestamp {};
+        auto result = socket.recvfrom(*description, data_buffer.value(), iov.iov_len, params.flags, user_addr, user_addr_length, timestamp);
+        if (result.is_error()) {
+            // Anything already delivered trumps the error; the caller will
+            // run into it again on the next call.
+            if (messages_received > 0)
+                return messages_received;
+            return result.error();
+        }
+
+        int msg_flags = 0;
+        if (result.value() > iov.iov_len) {
+            VERIFY(socket.type() != SOCK_STREAM);
+            msg_flags |= MSG_TRUNC;
+        }
+
+        if (socket.wants_timestamp()) {
+            struct {
+                cmsghdr cmsg;
+                timeval timestamp;
+            } cmsg_timestamp;
+            socklen_t control_length = sizeof(cmsg_timestamp);
+            if (msg.msg_controllen < control_length) {
+                msg_flags |= MSG_CTRUNC;
+            } else {
+                cmsg_timestamp = { { control_length, SOL_SOCKET, SCM_TIMESTAMP }, timestamp.to_timeval() };
+                if (!copy_to_user(msg.msg_control, &cmsg_timestamp, control_length))
+                    return EFAULT;
+            }
+            if (!copy_to_user(&user_mmsg->msg_hdr.msg_controllen, &control_length))
+                return EFAULT;
+        }
+
+        if (!copy_to_user(&user_mmsg->msg_hdr.msg_flags, &msg_flags))
+            return EFAULT;
+        unsigned msg_len = result.value();
+        if (!copy_to_user(&user_mmsg->msg_len, &msg_len))
+            return EFAULT;
+
+        ++messages_received;
+    }
+
+    return messages_received;
+}
+
 template<bool sockname, typename Params>
 int Process::get_sock_or_peer_name(const Params& params)
 {
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/NumericLimits.h>
+#include <Kernel/FileSystem/FileDescription.h>
+#include <Kernel/KBuffer.h>
+#include <Kernel/Process.h>
+#include <Kernel/UserOrKernelBuffer.h>
+
+namespace Kernel {
+
+using BlockFlags = Thread::FileBlocker::BlockFlags;
+
+KResultOr<ssize_t> Process::sys$splice(int in_fd, int out_fd, size_t count)
+{
+    REQUIRE_PROMISE(stdio);
+    if (count > NumericLimits<i32>::max())
+        return EINVAL;
+    if (count == 0)
+        return 0;
+
+    auto in_description = file_description(in_fd);
+    if (!in_description)
+        return EBADF;
+    if (!in_description->is_readable())
+        return EBADF;
+    if (in_description->is_directory())
+        return EISDIR;
+
+    auto out_description = file_description(out_fd);
+    if (!out_description)
+        return EBADF;
+    if (!out_description->is_writable())
+        return EBADF;
+    if (out_description->is_directory())
+        return EISDIR;
+
+    // Like other systems, we require at least one end to be a pipe; copying
+    // between two regular files is sendfile()'s job.
+    if (!in_description->is_fifo() && !out_description->is_fifo())
+        return EINVAL;
+
+    // Move the data through an in-kernel staging buffer, so it never makes a
+    // round trip through userspace. This is "only" a copy saved (rather than
+    // the page references a fancier implementation would pass around), but
+    // the DoubleBuffer backing a FIFO is a plain byte buffer, so there are no
+    // pages to share in the first place.
+    auto chunk_buffer = KBuffer::try_create_with_size(64 * KiB, Region::Access::Read | Region::Access::Write, "splice");
+    if (!chunk_buffer)
+        return ENOMEM;
+    auto kernel_buffer = UserOrKernelBuffer::for_kernel_buffer(chunk_buffer->data());
+
+    ssize_t total_spliced = 0;
+    size_t remaining = count;
+    while (remaining > 0) {
+        if (in_description->is_blocking()) {
+            if (!in_description->can_read()) {
+                auto unblock_flags = BlockFlags::None;
+                if (Thread::current()->block<Thread::ReadBlocker>({}, *in_description, unblock_flags).was_interrupted()) {
+                    if (total_spliced > 0)
+                        return total_spliced;
+                    return EINTR;
+                }
+                if (!has_flag(unblock_flags, BlockFlags::Read)) {
+                    if (total_spliced > 0)
+                        return total_spliced;
+                    return EAGAIN;
+                }
+                // TODO: handle exceptions in unblock_flags
+            }
+        }
+
+        size_t chunk_size = min(remaining, chunk_buffer->size());
+        auto nread_or_error = in_description->read(kernel_buffer, chunk_size);
+        if (nread_or_error.is_error()) {
+            if (total_spliced > 0)
+                return total_spliced;
+            return nread_or_error.error();
+        }
+        auto nread = nread_or_error.value();
+        if (nread == 0)
+            break;
+
+        // NOTE: do_write() keeps going (blocking as needed) until the whole
+        // chunk is written, so data read from a pipe can't get lost here.
+        auto nwritten_or_error = do_write(*out_description, kernel_buffer, nread);
+        if (nwritten_or_error.is_error()) {
+            if (total_spliced > 0)
+                return total_spliced;
+            return nwritten_or_error.error();
+        }
+        auto nwritten = nwritten_or_error.value();
+        total_spliced += nwritten;
+        remaining -= nwritten;
+        if ((size_t)nwritten < nread)
+            break;
+
+        // A short read from a pipe just means that's all the data there was;
+        // report what we have instead of blocking for more.
+        if (nread < chunk_size && in_description->is_fifo())
+            break;
+    }
+
+    return total_spliced;
+}
+
+}
@@ -16,11 +16,20 @@ void SyncTask::spawn()
     RefPtr<Thread> syncd_thread;
     Process::create_kernel_process(syncd_thread, "SyncTask", [] {
         dbgln("SyncTask is running");
-        for (;;) {
-            VFS::the().sync();
+        for (unsigned iteration = 1;; ++iteration) {
+            // Trickle aged dirty blocks out every second so explicit syncs
+            // stay cheap, with a full sync every 10 seconds as a safety net.
+            if (iteration % 10 == 0)
+                VFS::the().sync();
+            else
+                VFS::the().trickle_sync();
             (void)Thread::current()->sleep(Time::from_seconds(1));
         }
     });
+    // Keep the periodic flushing off the bootstrap processor, which already
+    // handles most interrupts and the system tick.
+    if (Processor::count() > 1)
+        syncd_thread->set_affinity(~1u);
 }
 
 }
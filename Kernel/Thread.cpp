@@ -184,6 +184,12 @@ void Thread::unblock(u8 signal)
             return;
         m_blocker->set_interrupted_by_signal(signal);
     }
+    if (signal == 0 && m_blocker->blocker_type() == Blocker::Type::File) {
+        // Waking up because a file became ready is our cue that this thread
+        // is interactive: regular file I/O doesn't block, so a File block
+        // means we waited on something like the TTY, a socket or a pipe.
+        m_priority_boost = min(m_priority_boost + 2, max_priority_boost);
+    }
     m_blocker = nullptr;
     if (Thread::current() == this) {
         set_state(Thread::Running);
@@ -910,8 +916,22 @@ void Thread::set_state(State new_state, u8 stop_signal)
     }
 
     if (m_state == Runnable) {
+        if (!is_idle_thread())
+            m_became_runnable_at = TimeManagement::the().monotonic_time(TimePrecision::Precise);
         Scheduler::queue_runnable_thread(*this);
         Processor::smp_wake_n_idle_processors(1);
+    } else if (m_state == Running && previous_state == Runnable && !is_idle_thread()) {
+        // Record how long we sat in the ready queue, for the scheduling
+        // latency histogram exported through /proc/scheduler.
+        auto waited = TimeManagement::the().monotonic_time(TimePrecision::Precise) - m_became_runnable_at;
+        u64 waited_ns = (u64)waited.to_nanoseconds();
+        if (waited_ns > m_max_scheduling_latency_ns)
+            m_max_scheduling_latency_ns = waited_ns;
+        u64 waited_ms = waited_ns / 1'000'000;
+        size_t bucket = 0;
+        while (bucket < scheduling_latency_bucket_count - 1 && waited_ms >= (1u << bucket))
+            ++bucket;
+        ++m_scheduling_latency_histogram[bucket];
     } else if (m_state == Stopped) {
         // We don't want to restore to Running state, only Runnable!
         m_stop_state = previous_state != Running ? previous_state : Runnable;
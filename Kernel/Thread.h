@@ -23,6 +23,7 @@
 #include <Kernel/Arch/x86/SafeMem.h>
 #include <Kernel/Debug.h>
 #include <Kernel/Forward.h>
+#include <Kernel/Heap/SlabAllocator.h>
 #include <Kernel/KResult.h>
 #include <Kernel/LockMode.h>
 #include <Kernel/Scheduler.h>
@@ -66,6 +67,7 @@ class Thread
     , public Weakable<Thread> {
     AK_MAKE_NONCOPYABLE(Thread);
     AK_MAKE_NONMOVABLE(Thread);
+    MAKE_SLAB_ALLOCATED(Thread)
 
     friend class Process;
     friend class ProtectedProcessBase;
@@ -95,6 +97,20 @@ public:
     void set_priority(u32 p) { m_priority = p; }
     u32 priority() const { return m_priority; }
 
+    // Threads that block on I/O (the TTY, a socket, a pipe) earn a temporary
+    // priority boost when they wake up, so interactive work gets picked over
+    // CPU-bound work of the same static priority. The boost decays by one
+    // step each time the thread burns through a whole time slice, so CPU
+    // hogs quickly fall back to their static priority.
+    static constexpr u32 max_priority_boost = 8;
+    u32 priority_boost() const { return m_priority_boost; }
+    u32 effective_priority() const { return min(m_priority + m_priority_boost, (u32)THREAD_PRIORITY_MAX); }
+    void decay_priority_boost()
+    {
+        if (m_priority_boost > 0)
+            --m_priority_boost;
+    }
+
     void detach()
     {
         ScopedSpinLock lock(m_lock);
@@ -725,6 +741,13 @@ public:
     void did_schedule() { ++m_times_scheduled; }
     u32 times_scheduled() const { return m_times_scheduled; }
 
+    // Counts of observed runnable-to-running latencies, in power-of-two
+    // millisecond buckets: <1ms, <2ms, <4ms and so on; the last bucket
+    // counts everything that waited 64ms or longer.
+    static constexpr size_t scheduling_latency_bucket_count = 8;
+    Span<const u32> scheduling_latency_histogram() const { return { m_scheduling_latency_histogram, scheduling_latency_bucket_count }; }
+    u64 max_scheduling_latency_ns() const { return m_max_scheduling_latency_ns; }
+
     void resume_from_stopped();
 
     [[nodiscard]] bool should_be_stopped() const;
@@ -1135,6 +1158,7 @@ private:
 
     IntrusiveListNode<Thread> m_process_thread_list_node;
     int m_runnable_priority { -1 };
+    u32 m_ready_queue_cpu { 0 };
 
     friend class WaitQueue;
 
@@ -1212,6 +1236,9 @@ private:
     u32 m_cpu_affinity { THREAD_AFFINITY_DEFAULT };
     u32 m_ticks_left { 0 };
     u32 m_times_scheduled { 0 };
+    Time m_became_runnable_at {};
+    u32 m_scheduling_latency_histogram[scheduling_latency_bucket_count] {};
+    u64 m_max_scheduling_latency_ns { 0 };
     u32 m_ticks_in_user { 0 };
     u32 m_ticks_in_kernel { 0 };
     u32 m_pending_signals { 0 };
@@ -1258,6 +1285,7 @@ private:
     State m_state { Invalid };
     String m_name;
     u32 m_priority { THREAD_PRIORITY_NORMAL };
+    u32 m_priority_boost { 0 };
 
     State m_stop_state { Invalid };
 
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/NumericLimits.h>
 #include <Kernel/Arch/x86/CPU.h>
 #include <Kernel/IO.h>
 #include <Kernel/Interrupts/APIC.h>
@@ -139,6 +140,22 @@ void APICTimer::disable_local_timer()
     APIC::the().setup_local_timer(0, APIC::TimerMode::OneShot, false);
 }
 
+bool APICTimer::start_one_shot_on_current_processor(u64 ns)
+{
+    // m_timer_period APIC bus ticks per interrupt at m_frequency interrupts
+    // per second gives us the bus tick rate.
+    u64 ticks = (ns * m_timer_period * m_frequency) / 1000000000ull;
+    if (ticks == 0 || ticks > NumericLimits<u32>::max())
+        return false;
+    APIC::the().setup_local_timer((u32)ticks, APIC::TimerMode::OneShot, true);
+    return true;
+}
+
+void APICTimer::resume_periodic_on_current_processor()
+{
+    APIC::the().setup_local_timer(m_timer_period, m_timer_mode, true);
+}
+
 size_t APICTimer::ticks_per_second() const
 {
     return m_frequency;
@@ -35,6 +35,9 @@ public:
     void enable_local_timer();
     void disable_local_timer();
 
+    bool start_one_shot_on_current_processor(u64 ns);
+    void resume_periodic_on_current_processor();
+
 private:
     explicit APICTimer(u8, Function<void(const RegisterState&)>);
 
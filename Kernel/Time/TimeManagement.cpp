@@ -400,6 +400,31 @@ void TimeManagement::system_timer_tick(const RegisterState& regs)
     Scheduler::timer_tick(regs);
 }
 
+bool TimeManagement::enter_tickless_idle()
+{
+    // Stretching the tick must not affect timekeeping, so this is only
+    // safe when time is queried from the HPET main counter rather than
+    // accumulated tick by tick. We also need per-processor one-shot
+    // programming, which only the local APIC timer provides.
+    if (!m_can_query_precise_time || m_system_timer->timer_type() != HardwareTimerType::LocalAPICTimer)
+        return false;
+
+    u64 ns = TimerQueue::the().ns_until_next_timer(max_tickless_idle_ns);
+
+    // Reprogramming the timer isn't worth it if the next deadline is close
+    // enough that the periodic tick would get there on its own.
+    u64 tick_period_ns = 1000000000ull / m_system_timer->ticks_per_second();
+    if (ns <= 2 * tick_period_ns)
+        return false;
+
+    return static_cast<APICTimer*>(m_system_timer.ptr())->start_one_shot_on_current_processor(ns);
+}
+
+void TimeManagement::exit_tickless_idle()
+{
+    static_cast<APICTimer*>(m_system_timer.ptr())->resume_periodic_on_current_processor();
+}
+
 bool TimeManagement::enable_profile_timer()
 {
     if (!m_profile_timer)
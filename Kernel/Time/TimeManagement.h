@@ -71,7 +71,18 @@ public:
 
     bool can_query_precise_time() const { return m_can_query_precise_time; }
 
+    // When a processor goes idle it may stop its periodic tick and instead
+    // program a one-shot interrupt for the next TimerQueue deadline.
+    // Returns false if tickless idle is unavailable or not worthwhile, in
+    // which case the periodic tick keeps running.
+    bool enter_tickless_idle();
+    void exit_tickless_idle();
+
 private:
+    // Never sleep unboundedly; badly delayed wakeups are much harder to
+    // debug than a few residual ticks per second.
+    static constexpr u64 max_tickless_idle_ns = 250'000'000;
+
     bool probe_and_set_legacy_hardware_timers();
     bool probe_and_set_non_legacy_hardware_timers();
     Vector<HardwareTimerBase*> scan_and_initialize_periodic_timers();
@@ -55,6 +55,12 @@ TimerQueue& TimerQueue::the()
 UNMAP_AFTER_INIT TimerQueue::TimerQueue()
 {
     m_ticks_per_second = TimeManagement::the().ticks_per_second();
+    m_wheel_current_tick = wheel_ticks_for_time(TimeManagement::the().current_time(CLOCK_MONOTONIC_COARSE));
+}
+
+u64 TimerQueue::wheel_ticks_for_time(const Time& time)
+{
+    return (u64)time.to_nanoseconds() / ns_per_wheel_tick;
 }
 
 bool TimerQueue::add_timer_without_id(NonnullRefPtr<Timer> timer, clockid_t clock_id, const Time& deadline, Function<void()>&& callback)
@@ -87,11 +93,18 @@ TimerId TimerQueue::add_timer(NonnullRefPtr<Timer>&& timer)
 
 void TimerQueue::add_timer_locked(NonnullRefPtr<Timer> timer)
 {
-    Time timer_expiration = timer->m_expires;
-
     VERIFY(!timer->is_queued());
 
-    auto& queue = queue_for_timer(*timer);
+    if (is_wheel_timer(*timer)) {
+        // Round the expiration up to the next wheel tick so that the timer
+        // never fires before its deadline.
+        timer->m_wheel_key = ((u64)timer->m_expires.to_nanoseconds() + ns_per_wheel_tick - 1) / ns_per_wheel_tick;
+        wheel_insert_locked(timer.leak_ref());
+        return;
+    }
+
+    Time timer_expiration = timer->m_expires;
+    auto& queue = m_timer_queue_realtime;
     if (queue.list.is_empty()) {
         queue.list.append(&timer.leak_ref());
         queue.next_timer_due = timer_expiration;
@@ -115,6 +128,64 @@ void TimerQueue::add_timer_locked(NonnullRefPtr<Timer> timer)
     }
 }
 
+void TimerQueue::wheel_insert_locked(Timer& timer)
+{
+    VERIFY(!timer.m_wheel_bucket);
+
+    // Never place a timer into the slot the wheel is currently at; it has
+    // already been expired this revolution. Late timers go into the very
+    // next slot instead.
+    u64 effective_tick = max(timer.m_wheel_key, m_wheel_current_tick + 1);
+    u64 delta = effective_tick - m_wheel_current_tick;
+
+    InlineLinkedList<Timer>* bucket;
+    if (delta < wheel_slots)
+        bucket = &m_wheel[0][effective_tick & wheel_mask];
+    else if (delta < wheel_slots * wheel_slots)
+        bucket = &m_wheel[1][(effective_tick >> wheel_bits) & wheel_mask];
+    else if (delta < wheel_slots * wheel_slots * wheel_slots)
+        bucket = &m_wheel[2][(effective_tick >> (2 * wheel_bits)) & wheel_mask];
+    else
+        bucket = &m_wheel_overflow;
+
+    bucket->append(&timer);
+    timer.m_wheel_bucket = bucket;
+    m_wheel_timer_count++;
+}
+
+void TimerQueue::wheel_remove_locked(Timer& timer)
+{
+    VERIFY(timer.m_wheel_bucket);
+    timer.m_wheel_bucket->remove(&timer);
+    timer.m_wheel_bucket = nullptr;
+    VERIFY(m_wheel_timer_count > 0);
+    m_wheel_timer_count--;
+}
+
+void TimerQueue::wheel_cascade_locked()
+{
+    // The wheel just moved into a new level-1 slot; re-distribute its
+    // timers into level 0. When level 1 wraps, pull from level 2, and when
+    // level 2 wraps, re-scan the overflow list.
+    auto reinsert_all = [&](InlineLinkedList<Timer>& bucket) {
+        while (auto* timer = bucket.head()) {
+            bucket.remove(timer);
+            timer->m_wheel_bucket = nullptr;
+            m_wheel_timer_count--;
+            wheel_insert_locked(*timer);
+        }
+    };
+
+    size_t slot1 = (m_wheel_current_tick >> wheel_bits) & wheel_mask;
+    reinsert_all(m_wheel[1][slot1]);
+    if (slot1 == 0) {
+        size_t slot2 = (m_wheel_current_tick >> (2 * wheel_bits)) & wheel_mask;
+        reinsert_all(m_wheel[2][slot2]);
+        if (slot2 == 0)
+            reinsert_all(m_wheel_overflow);
+    }
+}
+
 TimerId TimerQueue::add_timer(clockid_t clock_id, const Time& deadline, Function<void()>&& callback)
 {
     auto expires = TimeManagement::the().current_time(clock_id);
@@ -128,26 +199,36 @@ TimerId TimerQueue::add_timer(clockid_t clock_id, const Time& deadline, Function
 bool TimerQueue::cancel_timer(TimerId id)
 {
     Timer* found_timer = nullptr;
-    Queue* timer_queue = nullptr;
+    bool found_in_wheel = false;
 
     ScopedSpinLock lock(g_timerqueue_lock);
-    if (m_timer_queue_monotonic.list.for_each([&](Timer& timer) {
-            if (timer.m_id == id) {
-                found_timer = &timer;
-                timer_queue = &m_timer_queue_monotonic;
-                return IterationDecision::Break;
-            }
-            return IterationDecision::Continue;
-        })
-        != IterationDecision::Break) {
-        m_timer_queue_realtime.list.for_each([&](Timer& timer) {
-            if (timer.m_id == id) {
-                found_timer = &timer;
-                timer_queue = &m_timer_queue_realtime;
-                return IterationDecision::Break;
+    m_timer_queue_realtime.list.for_each([&](Timer& timer) {
+        if (timer.m_id == id) {
+            found_timer = &timer;
+            return IterationDecision::Break;
+        }
+        return IterationDecision::Continue;
+    });
+
+    if (!found_timer) {
+        auto find_in_bucket = [&](InlineLinkedList<Timer>& bucket) {
+            return bucket.for_each([&](Timer& timer) {
+                if (timer.m_id == id) {
+                    found_timer = &timer;
+                    return IterationDecision::Break;
+                }
+                return IterationDecision::Continue;
+            });
+        };
+        for (size_t level = 0; !found_timer && level < wheel_levels; level++) {
+            for (size_t slot = 0; slot < wheel_slots; slot++) {
+                if (find_in_bucket(m_wheel[level][slot]) == IterationDecision::Break)
+                    break;
             }
-            return IterationDecision::Continue;
-        });
+        }
+        if (!found_timer)
+            find_in_bucket(m_wheel_overflow);
+        found_in_wheel = found_timer != nullptr;
     }
 
     if (!found_timer) {
@@ -173,17 +254,18 @@ bool TimerQueue::cancel_timer(TimerId id)
         return false;
     }
 
-    VERIFY(found_timer);
-    VERIFY(timer_queue);
-    remove_timer_locked(*timer_queue, *found_timer);
+    if (found_in_wheel)
+        remove_wheel_timer_locked(*found_timer);
+    else
+        remove_timer_locked(m_timer_queue_realtime, *found_timer);
     return true;
 }
 
 bool TimerQueue::cancel_timer(Timer& timer)
 {
-    auto& timer_queue = queue_for_timer(timer);
     ScopedSpinLock lock(g_timerqueue_lock);
-    if (!timer_queue.list.contains_slow(&timer)) {
+    bool is_queued = is_wheel_timer(timer) ? timer.m_wheel_bucket != nullptr : m_timer_queue_realtime.list.contains_slow(&timer);
+    if (!is_queued) {
         // The timer may be executing right now, if it is then it should
         // be in m_timers_executing. If it is then release the lock
         // briefly to allow it to finish by removing itself
@@ -203,10 +285,26 @@ bool TimerQueue::cancel_timer(Timer& timer)
     }
 
     VERIFY(timer.ref_count() > 1);
-    remove_timer_locked(timer_queue, timer);
+    if (is_wheel_timer(timer))
+        remove_wheel_timer_locked(timer);
+    else
+        remove_timer_locked(m_timer_queue_realtime, timer);
     return true;
 }
 
+void TimerQueue::remove_wheel_timer_locked(Timer& timer)
+{
+    wheel_remove_locked(timer);
+    timer.set_queued(false);
+    auto now = timer.now(false);
+    if (timer.m_expires > now)
+        timer.m_remaining = timer.m_expires - now;
+    // Whenever we remove a timer that was still queued (but hasn't been
+    // fired) we added a reference to it. So, when removing it from the
+    // queue we need to drop that reference.
+    timer.unref();
+}
+
 void TimerQueue::remove_timer_locked(Queue& queue, Timer& timer)
 {
     bool was_next_timer = (queue.list.head() == &timer);
@@ -228,6 +326,41 @@ void TimerQueue::fire()
 {
     ScopedSpinLock lock(g_timerqueue_lock);
 
+    auto defer_timer_callback = [&](Timer* timer) {
+        timer->set_queued(false);
+        m_timers_executing.append(timer);
+
+        lock.unlock();
+
+        // Defer executing the timer outside of the irq handler
+        Processor::current().deferred_call_queue([this, timer]() {
+            timer->m_callback();
+            ScopedSpinLock lock(g_timerqueue_lock);
+            m_timers_executing.remove(timer);
+            // Drop the reference we added when queueing the timer
+            timer->unref();
+        });
+
+        lock.lock();
+    };
+
+    u64 now_tick = wheel_ticks_for_time(TimeManagement::the().current_time(CLOCK_MONOTONIC_COARSE));
+    if (m_wheel_timer_count == 0) {
+        // Nothing on the wheel, no need to turn it slot by slot.
+        m_wheel_current_tick = now_tick;
+    } else {
+        while (m_wheel_current_tick < now_tick) {
+            ++m_wheel_current_tick;
+            if ((m_wheel_current_tick & wheel_mask) == 0)
+                wheel_cascade_locked();
+            auto& bucket = m_wheel[0][m_wheel_current_tick & wheel_mask];
+            while (auto* timer = bucket.head()) {
+                wheel_remove_locked(*timer);
+                defer_timer_callback(timer);
+            }
+        }
+    }
+
     auto fire_timers = [&](Queue& queue) {
         auto* timer = queue.list.head();
         VERIFY(timer);
@@ -235,34 +368,54 @@ void TimerQueue::fire()
 
         while (timer && timer->now(true) > timer->m_expires) {
             queue.list.remove(timer);
-            timer->set_queued(false);
-
-            m_timers_executing.append(timer);
 
             update_next_timer_due(queue);
 
-            lock.unlock();
-
-            // Defer executing the timer outside of the irq handler
-            Processor::current().deferred_call_queue([this, timer]() {
-                timer->m_callback();
-                ScopedSpinLock lock(g_timerqueue_lock);
-                m_timers_executing.remove(timer);
-                // Drop the reference we added when queueing the timer
-                timer->unref();
-            });
-
-            lock.lock();
+            defer_timer_callback(timer);
             timer = queue.list.head();
         }
     };
 
-    if (!m_timer_queue_monotonic.list.is_empty())
-        fire_timers(m_timer_queue_monotonic);
     if (!m_timer_queue_realtime.list.is_empty())
         fire_timers(m_timer_queue_realtime);
 }
 
+u64 TimerQueue::ns_until_next_timer(u64 max_ns)
+{
+    ScopedSpinLock lock(g_timerqueue_lock);
+
+    u64 ns = max_ns;
+
+    if (m_wheel_timer_count > 0) {
+        // Any timer due before the next cascade boundary must already sit
+        // in level 0, so scanning level 0 up to that boundary finds the
+        // earliest monotonic deadline. If the scan comes up empty, the next
+        // candidate only moves into level 0 at the cascade, so don't sleep
+        // past it.
+        u64 now_ns = (u64)TimeManagement::the().current_time(CLOCK_MONOTONIC_COARSE).to_nanoseconds();
+        u64 ticks_until_cascade = wheel_slots - (m_wheel_current_tick & wheel_mask);
+        u64 wheel_ns = ticks_until_cascade * ns_per_wheel_tick;
+        for (u64 delta = 1; delta <= ticks_until_cascade; delta++) {
+            if (!m_wheel[0][(m_wheel_current_tick + delta) & wheel_mask].is_empty()) {
+                u64 due_ns = (m_wheel_current_tick + delta) * ns_per_wheel_tick;
+                wheel_ns = due_ns > now_ns ? due_ns - now_ns : 0;
+                break;
+            }
+        }
+        ns = min(ns, wheel_ns);
+    }
+
+    if (!m_timer_queue_realtime.list.is_empty()) {
+        auto now = TimeManagement::the().current_time(CLOCK_REALTIME_COARSE);
+        auto due = m_timer_queue_realtime.next_timer_due;
+        if (due <= now)
+            return 0;
+        ns = min(ns, (u64)(due - now).to_nanoseconds());
+    }
+
+    return ns;
+}
+
 void TimerQueue::update_next_timer_due(Queue& queue)
 {
     VERIFY(g_timerqueue_lock.is_locked());
@@ -47,6 +47,11 @@ private:
     Function<void()> m_callback;
     Timer* m_next { nullptr };
     Timer* m_prev { nullptr };
+    // Absolute expiration in wheel ticks, and the wheel bucket the timer
+    // currently sits in (null when not on the wheel). Only used for timers
+    // on a monotonic clock.
+    u64 m_wheel_key { 0 };
+    InlineLinkedList<Timer>* m_wheel_bucket { nullptr };
     Atomic<bool, AK::MemoryOrder::memory_order_relaxed> m_queued { false };
 
     bool operator<(const Timer& rhs) const
@@ -83,6 +88,7 @@ public:
         return cancel_timer(*move(timer));
     }
     void fire();
+    u64 ns_until_next_timer(u64 max_ns);
 
 private:
     struct Queue {
@@ -90,27 +96,47 @@ private:
         Time next_timer_due {};
     };
     void remove_timer_locked(Queue&, Timer&);
+    void remove_wheel_timer_locked(Timer&);
     void update_next_timer_due(Queue&);
     void add_timer_locked(NonnullRefPtr<Timer>);
 
-    Queue& queue_for_timer(Timer& timer)
+    // Monotonic timers live in a hierarchical timer wheel: insertion and
+    // cancellation are O(1), and each tick only touches the bucket that
+    // just came due. Each level covers wheel_slots buckets of increasingly
+    // coarse granularity; timers beyond the last level collect in an
+    // overflow list that is only rescanned when the top level turns over.
+    static constexpr size_t wheel_bits = 8;
+    static constexpr size_t wheel_slots = 1 << wheel_bits;
+    static constexpr size_t wheel_mask = wheel_slots - 1;
+    static constexpr size_t wheel_levels = 3;
+    // One wheel tick is 1ms of monotonic time, independent of the hardware
+    // tick rate. Expirations are rounded up to the next wheel tick, so
+    // timers can fire up to 1ms late but never early.
+    static constexpr u64 ns_per_wheel_tick = 1'000'000;
+
+    static bool is_wheel_timer(const Timer& timer)
     {
         switch (timer.m_clock_id) {
         case CLOCK_MONOTONIC:
         case CLOCK_MONOTONIC_COARSE:
         case CLOCK_MONOTONIC_RAW:
-            return m_timer_queue_monotonic;
-        case CLOCK_REALTIME:
-        case CLOCK_REALTIME_COARSE:
-            return m_timer_queue_realtime;
+            return true;
         default:
-            VERIFY_NOT_REACHED();
+            return false;
         }
     }
 
+    static u64 wheel_ticks_for_time(const Time&);
+    void wheel_insert_locked(Timer&);
+    void wheel_remove_locked(Timer&);
+    void wheel_cascade_locked();
+
     u64 m_timer_id_count { 0 };
     u64 m_ticks_per_second { 0 };
-    Queue m_timer_queue_monotonic;
+    u64 m_wheel_current_tick { 0 };
+    size_t m_wheel_timer_count { 0 };
+    InlineLinkedList<Timer> m_wheel[wheel_levels][wheel_slots];
+    InlineLinkedList<Timer> m_wheel_overflow;
     Queue m_timer_queue_realtime;
     InlineLinkedList<Timer> m_timers_executing;
 };
@@ -61,6 +61,8 @@ enum {
     PERF_EVENT_KMALLOC = 2048,
     PERF_EVENT_KFREE = 4096,
     PERF_EVENT_PAGE_FAULT = 8192,
+    PERF_EVENT_SPAN_BEGIN = 16384,
+    PERF_EVENT_SPAN_END = 32768,
 };
 
 #define WNOHANG 1
@@ -91,6 +93,7 @@ enum {
 #define MAP_STACK 0x40
 #define MAP_NORESERVE 0x80
 #define MAP_RANDOMIZED 0x100
+#define MAP_HUGEPAGES 0x200
 
 #define PROT_READ 0x1
 #define PROT_WRITE 0x2
@@ -517,6 +520,8 @@ enum {
     SO_BINDTODEVICE,
     SO_KEEPALIVE,
     SO_TIMESTAMP,
+    SO_BROADCAST,
+    SO_REUSEPORT,
 };
 
 enum {
@@ -633,6 +638,11 @@ struct msghdr {
     int msg_flags;
 };
 
+struct mmsghdr {
+    struct msghdr msg_hdr;
+    unsigned msg_len;
+};
+
 struct sched_param {
     int sched_priority;
 };
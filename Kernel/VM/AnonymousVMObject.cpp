@@ -13,11 +13,57 @@
 
 namespace Kernel {
 
+// Rather than discarding volatile pages outright, purging stashes their
+// contents in a compressed in-RAM pool so that making the range non-volatile
+// again can restore them instead of reporting them as purged. Pages are
+// compressed with a simple word-oriented run-length encoding; anything that
+// doesn't shrink to half a page (or doesn't fit in the pool budget) is
+// discarded as before.
+static constexpr size_t max_compressed_page_size = PAGE_SIZE / 2;
+static constexpr size_t max_compressed_pool_size = 8 * MiB;
+static size_t s_compressed_pool_bytes { 0 };
+
+static size_t compress_page_contents(const u32* page_words, u32* out_pairs, size_t max_pairs)
+{
+    constexpr size_t words_per_page = PAGE_SIZE / sizeof(u32);
+    size_t pair_count = 0;
+    for (size_t i = 0; i < words_per_page;) {
+        u32 value = page_words[i];
+        size_t run_length = 1;
+        while (i + run_length < words_per_page && page_words[i + run_length] == value)
+            run_length++;
+        if (pair_count >= max_pairs)
+            return 0;
+        out_pairs[pair_count * 2] = run_length;
+        out_pairs[pair_count * 2 + 1] = value;
+        pair_count++;
+        i += run_length;
+    }
+    return pair_count;
+}
+
+static void decompress_page_contents(const u32* pairs, size_t pair_count, u32* page_words)
+{
+    size_t out_index = 0;
+    for (size_t i = 0; i < pair_count; i++) {
+        u32 run_length = pairs[i * 2];
+        u32 value = pairs[i * 2 + 1];
+        for (u32 j = 0; j < run_length; j++)
+            page_words[out_index++] = value;
+    }
+    VERIFY(out_index == PAGE_SIZE / sizeof(u32));
+}
+
 RefPtr<VMObject> AnonymousVMObject::clone()
 {
     // We need to acquire our lock so we copy a sane state
     ScopedSpinLock lock(m_lock);
 
+    // A clone would inherit volatile ranges without the compressed contents
+    // backing them, so drop what we retained and mark those pages as purged
+    // before the purgeable ranges get copied to the clone.
+    drop_all_compressed_pages();
+
     // We're the parent. Since we're about to become COW we need to
     // commit the number of pages that we need to potentially allocate
     // so that the parent is still guaranteed to be able to have all
@@ -155,6 +201,7 @@ AnonymousVMObject::~AnonymousVMObject()
     // Return any unused committed pages
     if (m_unused_committed_pages > 0)
         MM.uncommit_user_physical_pages(m_unused_committed_pages);
+    s_compressed_pool_bytes -= m_compressed_bytes;
 }
 
 int AnonymousVMObject::purge()
@@ -184,11 +231,19 @@ int AnonymousVMObject::purge_impl()
     ScopedSpinLock lock(m_lock);
     for_each_volatile_range([&](const auto& range) {
         int purged_in_range = 0;
+        int compressed_in_range = 0;
         auto range_end = range.base + range.count;
         for (size_t i = range.base; i < range_end; i++) {
             auto& phys_page = m_physical_pages[i];
             if (phys_page && !phys_page->is_shared_zero_page()) {
                 VERIFY(!phys_page->is_lazy_committed_page());
+                // Pages whose contents we manage to stash in the compressed
+                // pool are not marked as purged; restore_compressed_pages()
+                // will bring them back when the range becomes non-volatile.
+                if (try_compress_and_evict_page(i, *phys_page))
+                    ++compressed_in_range;
+                else
+                    set_was_purged({ i, 1 });
                 ++purged_in_range;
             }
             phys_page = MM.shared_zero_page();
@@ -196,20 +251,21 @@ int AnonymousVMObject::purge_impl()
 
         if (purged_in_range > 0) {
             purged_page_count += purged_in_range;
-            set_was_purged(range);
             for_each_region([&](auto& region) {
                 if (&region.vmobject() == this) {
                     if (auto owner = region.get_owner()) {
                         // we need to hold a reference the process here (if there is one) as we may not own this region
-                        dmesgln("Purged {} pages from region {} owned by {} at {} - {}",
+                        dmesgln("Purged {} pages ({} retained compressed) from region {} owned by {} at {} - {}",
                             purged_in_range,
+                            compressed_in_range,
                             region.name(),
                             *owner,
                             region.vaddr_from_page_index(range.base),
                             region.vaddr_from_page_index(range.base + range.count));
                     } else {
-                        dmesgln("Purged {} pages from region {} (no ownership) at {} - {}",
+                        dmesgln("Purged {} pages ({} retained compressed) from region {} (no ownership) at {} - {}",
                             purged_in_range,
+                            compressed_in_range,
                             region.name(),
                             region.vaddr_from_page_index(range.base),
                             region.vaddr_from_page_index(range.base + range.count));
@@ -222,6 +278,81 @@ int AnonymousVMObject::purge_impl()
     return purged_page_count;
 }
 
+bool AnonymousVMObject::try_compress_and_evict_page(size_t page_index, PhysicalPage& page)
+{
+    VERIFY(m_lock.is_locked());
+
+    // Drop any stale entry from an earlier purge of this page.
+    if (auto it = m_compressed_pages.find(page_index); it != m_compressed_pages.end()) {
+        m_compressed_bytes -= it->value.size();
+        s_compressed_pool_bytes -= it->value.size();
+        m_compressed_pages.remove(page_index);
+    }
+
+    // This is checked without synchronization between processors, so the
+    // pool may slightly overshoot its budget. That's fine, it's a budget,
+    // not a hard limit.
+    if (s_compressed_pool_bytes >= max_compressed_pool_size)
+        return false;
+
+    constexpr size_t max_pairs = max_compressed_page_size / (2 * sizeof(u32));
+    u32 pairs[2 * max_pairs];
+    auto* page_data = MM.quickmap_page(page);
+    size_t pair_count = compress_page_contents((const u32*)page_data, pairs, max_pairs);
+    MM.unquickmap_page();
+    if (pair_count == 0)
+        return false;
+
+    size_t compressed_size = pair_count * 2 * sizeof(u32);
+    m_compressed_pages.set(page_index, ByteBuffer::copy(pairs, compressed_size));
+    m_compressed_bytes += compressed_size;
+    s_compressed_pool_bytes += compressed_size;
+    return true;
+}
+
+bool AnonymousVMObject::restore_compressed_pages(const VolatilePageRange& range)
+{
+    VERIFY(m_lock.is_locked());
+
+    bool lost_any = false;
+    auto range_end = range.base + range.count;
+    for (size_t i = range.base; i < range_end; i++) {
+        auto it = m_compressed_pages.find(i);
+        if (it == m_compressed_pages.end())
+            continue;
+        auto& phys_page = m_physical_pages[i];
+        if (phys_page && phys_page->is_lazy_committed_page()) {
+            VERIFY(m_unused_committed_pages > 0);
+            --m_unused_committed_pages;
+            auto page = MM.allocate_committed_user_physical_page(MemoryManager::ShouldZeroFill::No);
+            auto* page_data = MM.quickmap_page(*page);
+            decompress_page_contents((const u32*)it->value.data(), it->value.size() / (2 * sizeof(u32)), (u32*)page_data);
+            MM.unquickmap_page();
+            phys_page = move(page);
+        } else {
+            // The slot didn't get marked for lazy-committed allocation, which
+            // happens when it's tracked by the COW map after a fork. We can't
+            // restore it safely, so the contents are lost just as if the page
+            // had been discarded outright.
+            lost_any = true;
+        }
+        m_compressed_bytes -= it->value.size();
+        s_compressed_pool_bytes -= it->value.size();
+        m_compressed_pages.remove(i);
+    }
+    return lost_any;
+}
+
+void AnonymousVMObject::drop_all_compressed_pages()
+{
+    VERIFY(m_lock.is_locked());
+    for (auto& it : m_compressed_pages)
+        set_was_purged({ it.key, 1 });
+    s_compressed_pool_bytes -= m_compressed_bytes;
+    m_compressed_bytes = 0;
+    m_compressed_pages.clear();
+}
+
 void AnonymousVMObject::register_purgeable_page_ranges(PurgeablePageRanges& purgeable_page_ranges)
 {
     ScopedSpinLock lock(m_lock);
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
+#include <AK/HashMap.h>
 #include <Kernel/PhysicalAddress.h>
 #include <Kernel/VM/AllocationStrategy.h>
 #include <Kernel/VM/PageFaultResponse.h>
@@ -40,6 +42,8 @@ public:
 
     bool is_any_volatile() const;
 
+    size_t amount_compressed() const { return m_compressed_bytes; }
+
     template<IteratorFunction<const VolatilePageRange&> F>
     IterationDecision for_each_volatile_range(F f) const
     {
@@ -132,6 +136,9 @@ private:
     size_t count_needed_commit_pages_for_nonvolatile_range(const VolatilePageRange&);
     size_t mark_committed_pages_for_nonvolatile_range(const VolatilePageRange&, size_t);
     bool is_nonvolatile(size_t page_index);
+    bool try_compress_and_evict_page(size_t page_index, PhysicalPage&);
+    bool restore_compressed_pages(const VolatilePageRange&);
+    void drop_all_compressed_pages();
 
     AnonymousVMObject& operator=(const AnonymousVMObject&) = delete;
     AnonymousVMObject& operator=(AnonymousVMObject&&) = delete;
@@ -149,6 +156,11 @@ private:
 
     Bitmap m_cow_map;
 
+    // Page contents that purging stashed in the compressed pool instead of
+    // discarding, keyed by page index. See purge_impl().
+    HashMap<size_t, ByteBuffer> m_compressed_pages;
+    size_t m_compressed_bytes { 0 };
+
     // We share a pool of committed cow-pages with clones
     RefPtr<CommittedCowPages> m_shared_committed_cow_pages;
 };
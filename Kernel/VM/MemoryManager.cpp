@@ -105,11 +105,13 @@ UNMAP_AFTER_INIT void MemoryManager::protect_readonly_after_init_memory()
     ScopedSpinLock mm_lock(s_mm_lock);
     ScopedSpinLock page_lock(kernel_page_directory().get_lock());
     // Disable writing to the .ro_after_init section
-    for (auto i = (FlatPtr)&start_of_ro_after_init; i < (FlatPtr)&end_of_ro_after_init; i += PAGE_SIZE) {
+    auto start = (FlatPtr)&start_of_ro_after_init;
+    auto end = (FlatPtr)&end_of_ro_after_init;
+    for (auto i = start; i < end; i += PAGE_SIZE) {
         auto& pte = *ensure_pte(kernel_page_directory(), VirtualAddress(i));
         pte.set_writable(false);
-        flush_tlb(&kernel_page_directory(), VirtualAddress(i));
     }
+    flush_tlb(&kernel_page_directory(), VirtualAddress(start), (end - start) / PAGE_SIZE);
 }
 
 void MemoryManager::unmap_memory_after_init()
@@ -124,8 +126,8 @@ void MemoryManager::unmap_memory_after_init()
     for (auto i = start; i < end; i += PAGE_SIZE) {
         auto& pte = *ensure_pte(kernel_page_directory(), VirtualAddress(i));
         pte.clear();
-        flush_tlb(&kernel_page_directory(), VirtualAddress(i));
     }
+    flush_tlb(&kernel_page_directory(), VirtualAddress(start), (end - start) / PAGE_SIZE);
 
     dmesgln("Unmapped {} KiB of kernel text after init! :^)", (end - start) / KiB);
     //Processor::halt();
@@ -296,6 +298,18 @@ UNMAP_AFTER_INIT void MemoryManager::parse_memory_map()
     }
 }
 
+PageDirectoryEntry* MemoryManager::pde(PageDirectory& page_directory, VirtualAddress vaddr)
+{
+    VERIFY_INTERRUPTS_DISABLED();
+    VERIFY(s_mm_lock.own_lock());
+    VERIFY(page_directory.get_lock().own_lock());
+    u32 page_directory_table_index = (vaddr.get() >> 30) & 0x3;
+    u32 page_directory_index = (vaddr.get() >> 21) & 0x1ff;
+
+    auto* pd = quickmap_pd(page_directory, page_directory_table_index);
+    return &pd[page_directory_index];
+}
+
 PageTableEntry* MemoryManager::pte(PageDirectory& page_directory, VirtualAddress vaddr)
 {
     VERIFY_INTERRUPTS_DISABLED();
@@ -309,6 +323,9 @@ PageTableEntry* MemoryManager::pte(PageDirectory& page_directory, VirtualAddress
     const PageDirectoryEntry& pde = pd[page_directory_index];
     if (!pde.is_present())
         return nullptr;
+    // A huge page mapping has no page table behind it.
+    if (pde.is_huge())
+        return nullptr;
 
     return &quickmap_pt(PhysicalAddress((FlatPtr)pde.page_table_base()))[page_table_index];
 }
@@ -324,6 +341,9 @@ PageTableEntry* MemoryManager::ensure_pte(PageDirectory& page_directory, Virtual
 
     auto* pd = quickmap_pd(page_directory, page_directory_table_index);
     PageDirectoryEntry& pde = pd[page_directory_index];
+    // Regions with huge page mappings must demote them before asking for
+    // individual PTEs within the same 2MiB range.
+    VERIFY(!pde.is_huge());
     if (!pde.is_present()) {
         bool did_purge = false;
         auto page_table = allocate_user_physical_page(ShouldZeroFill::Yes, &did_purge);
@@ -549,23 +569,60 @@ void MemoryManager::uncommit_user_physical_pages(size_t page_count)
 
 void MemoryManager::deallocate_user_physical_page(const PhysicalPage& page)
 {
+    InterruptDisabler disabler;
+    auto& data = get_data();
+    if (data.m_physical_page_cache_count == MemoryManagerData::physical_page_cache_capacity)
+        flush_physical_page_cache(data);
+    data.m_physical_page_cache[data.m_physical_page_cache_count++] = page.paddr();
+}
+
+void MemoryManager::refill_physical_page_cache(MemoryManagerData& data)
+{
+    VERIFY_INTERRUPTS_DISABLED();
     ScopedSpinLock lock(s_mm_lock);
-    for (auto& region : m_user_physical_regions) {
-        if (!region.contains(page))
-            continue;
+    while (data.m_physical_page_cache_count < MemoryManagerData::physical_page_cache_capacity / 2) {
+        // We need to make sure we don't touch pages that we have committed to
+        if (m_user_physical_pages_uncommitted == 0)
+            return;
+        Optional<PhysicalAddress> paddr;
+        for (auto& region : m_user_physical_regions) {
+            paddr = region.take_free_page_address();
+            if (paddr.has_value())
+                break;
+        }
+        if (!paddr.has_value())
+            return;
+        m_user_physical_pages_uncommitted--;
+        m_user_physical_pages_used.increment();
+        data.m_physical_page_cache[data.m_physical_page_cache_count++] = paddr.value();
+    }
+}
 
-        region.return_page(page);
-        --m_user_physical_pages_used;
+void MemoryManager::flush_physical_page_cache(MemoryManagerData& data)
+{
+    VERIFY_INTERRUPTS_DISABLED();
+    ScopedSpinLock lock(s_mm_lock);
+    while (data.m_physical_page_cache_count > MemoryManagerData::physical_page_cache_capacity / 2) {
+        auto paddr = data.m_physical_page_cache[--data.m_physical_page_cache_count];
+        bool found_region = false;
+        for (auto& region : m_user_physical_regions) {
+            if (!region.contains(paddr))
+                continue;
+            region.return_page(paddr);
+            found_region = true;
+            break;
+        }
+        if (!found_region) {
+            dmesgln("MM: flush_physical_page_cache couldn't figure out region for user page @ {}", paddr);
+            VERIFY_NOT_REACHED();
+        }
+        m_user_physical_pages_used.decrement();
 
         // Always return pages to the uncommitted pool. Pages that were
         // committed and allocated are only freed upon request. Once
         // returned there is no guarantee being able to get them back.
         ++m_user_physical_pages_uncommitted;
-        return;
     }
-
-    dmesgln("MM: deallocate_user_physical_page couldn't figure out region for user page @ {}", page.paddr());
-    VERIFY_NOT_REACHED();
 }
 
 RefPtr<PhysicalPage> MemoryManager::find_free_user_physical_page(bool committed)
@@ -585,7 +642,7 @@ RefPtr<PhysicalPage> MemoryManager::find_free_user_physical_page(bool committed)
     for (auto& region : m_user_physical_regions) {
         page = region.take_free_page(false);
         if (!page.is_null()) {
-            ++m_user_physical_pages_used;
+            m_user_physical_pages_used.increment();
             break;
         }
     }
@@ -607,13 +664,21 @@ NonnullRefPtr<PhysicalPage> MemoryManager::allocate_committed_user_physical_page
 
 RefPtr<PhysicalPage> MemoryManager::allocate_user_physical_page(ShouldZeroFill should_zero_fill, bool* did_purge)
 {
-    ScopedSpinLock lock(s_mm_lock);
-    auto page = find_free_user_physical_page(false);
+    InterruptDisabler disabler;
+    auto& data = get_data();
+    if (data.m_physical_page_cache_count == 0)
+        refill_physical_page_cache(data);
+
+    RefPtr<PhysicalPage> page;
     bool purged_pages = false;
 
-    if (!page) {
-        // We didn't have a single free physical page. Let's try to free something up!
+    if (data.m_physical_page_cache_count > 0) {
+        page = PhysicalPage::create(data.m_physical_page_cache[--data.m_physical_page_cache_count], false);
+    } else {
+        // The cache couldn't be refilled, so the uncommitted pool has run dry.
+        // Let's try to free something up!
         // First, we look for a purgeable VMObject in the volatile state.
+        ScopedSpinLock lock(s_mm_lock);
         for_each_vmobject([&](auto& vmobject) {
             if (!vmobject.is_anonymous())
                 return IterationDecision::Continue;
@@ -644,6 +709,37 @@ RefPtr<PhysicalPage> MemoryManager::allocate_user_physical_page(ShouldZeroFill s
     return page;
 }
 
+NonnullRefPtrVector<PhysicalPage> MemoryManager::allocate_contiguous_user_physical_pages(size_t size, size_t physical_alignment)
+{
+    VERIFY(!(size % PAGE_SIZE));
+    ScopedSpinLock lock(s_mm_lock);
+    size_t count = ceil_div(size, static_cast<size_t>(PAGE_SIZE));
+    NonnullRefPtrVector<PhysicalPage> physical_pages;
+
+    // We need to make sure we don't touch pages that we have committed to
+    if (m_user_physical_pages_uncommitted < count)
+        return physical_pages;
+
+    for (auto& region : m_user_physical_regions) {
+        physical_pages = region.take_contiguous_free_pages(count, false, physical_alignment);
+        if (!physical_pages.is_empty())
+            break;
+    }
+
+    if (physical_pages.is_empty())
+        return physical_pages;
+
+    m_user_physical_pages_uncommitted -= count;
+    m_user_physical_pages_used.add(count);
+
+    for (auto& page : physical_pages) {
+        auto* ptr = quickmap_page(page);
+        memset(ptr, 0, PAGE_SIZE);
+        unquickmap_page();
+    }
+    return physical_pages;
+}
+
 void MemoryManager::deallocate_supervisor_physical_page(const PhysicalPage& page)
 {
     ScopedSpinLock lock(s_mm_lock);
@@ -654,7 +750,7 @@ void MemoryManager::deallocate_supervisor_physical_page(const PhysicalPage& page
         }
 
         region.return_page(page);
-        --m_super_physical_pages_used;
+        m_super_physical_pages_used.decrement();
         return;
     }
 
@@ -672,7 +768,7 @@ NonnullRefPtrVector<PhysicalPage> MemoryManager::allocate_contiguous_supervisor_
     for (auto& region : m_super_physical_regions) {
         physical_pages = region.take_contiguous_free_pages(count, true, physical_alignment);
         if (!physical_pages.is_empty())
-            continue;
+            break;
     }
 
     if (physical_pages.is_empty()) {
@@ -687,7 +783,7 @@ NonnullRefPtrVector<PhysicalPage> MemoryManager::allocate_contiguous_supervisor_
 
     auto cleanup_region = MM.allocate_kernel_region(physical_pages[0].paddr(), PAGE_SIZE * count, "MemoryManager Allocation Sanitization", Region::Access::Read | Region::Access::Write);
     fast_u32_fill((u32*)cleanup_region->vaddr().as_ptr(), 0, (PAGE_SIZE * count) / sizeof(u32));
-    m_super_physical_pages_used += count;
+    m_super_physical_pages_used.add(count);
     return physical_pages;
 }
 
@@ -713,7 +809,7 @@ RefPtr<PhysicalPage> MemoryManager::allocate_supervisor_physical_page()
     }
 
     fast_u32_fill((u32*)page->paddr().offset(0xc0000000).as_ptr(), 0, PAGE_SIZE / sizeof(u32));
-    ++m_super_physical_pages_used;
+    m_super_physical_pages_used.increment();
     return page;
 }
 
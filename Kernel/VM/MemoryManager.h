@@ -12,6 +12,7 @@
 #include <AK/String.h>
 #include <Kernel/Arch/x86/CPU.h>
 #include <Kernel/Forward.h>
+#include <Kernel/PerProcessorCounter.h>
 #include <Kernel/SpinLock.h>
 #include <Kernel/VM/AllocationStrategy.h>
 #include <Kernel/VM/PhysicalPage.h>
@@ -89,11 +90,20 @@ struct PhysicalMemoryRange {
 #define MM Kernel::MemoryManager::the()
 
 struct MemoryManagerData {
+    static constexpr size_t physical_page_cache_capacity = 16;
+
     SpinLock<u8> m_quickmap_in_use;
     u32 m_quickmap_prev_flags;
 
     PhysicalAddress m_last_quickmap_pd;
     PhysicalAddress m_last_quickmap_pt;
+
+    // A small per-processor stash of free user physical pages, so the page
+    // fault hot path usually pops a page without taking the MM lock. The
+    // cache is refilled from (and overflows back to) the global pool in
+    // batches under the lock.
+    PhysicalAddress m_physical_page_cache[physical_page_cache_capacity];
+    size_t m_physical_page_cache_count { 0 };
 };
 
 extern RecursiveSpinLock s_mm_lock;
@@ -141,6 +151,7 @@ public:
     RefPtr<PhysicalPage> allocate_user_physical_page(ShouldZeroFill = ShouldZeroFill::Yes, bool* did_purge = nullptr);
     RefPtr<PhysicalPage> allocate_supervisor_physical_page();
     NonnullRefPtrVector<PhysicalPage> allocate_contiguous_supervisor_physical_pages(size_t size, size_t physical_alignment = PAGE_SIZE);
+    NonnullRefPtrVector<PhysicalPage> allocate_contiguous_user_physical_pages(size_t size, size_t physical_alignment = PAGE_SIZE);
     void deallocate_user_physical_page(const PhysicalPage&);
     void deallocate_supervisor_physical_page(const PhysicalPage&);
 
@@ -152,11 +163,11 @@ public:
     OwnPtr<Region> allocate_kernel_region_with_vmobject(const Range&, VMObject&, String name, Region::Access access, Region::Cacheable = Region::Cacheable::Yes);
 
     unsigned user_physical_pages() const { return m_user_physical_pages; }
-    unsigned user_physical_pages_used() const { return m_user_physical_pages_used; }
+    unsigned user_physical_pages_used() const { return m_user_physical_pages_used.sum(); }
     unsigned user_physical_pages_committed() const { return m_user_physical_pages_committed; }
     unsigned user_physical_pages_uncommitted() const { return m_user_physical_pages_uncommitted; }
     unsigned super_physical_pages() const { return m_super_physical_pages; }
-    unsigned super_physical_pages_used() const { return m_super_physical_pages_used; }
+    unsigned super_physical_pages_used() const { return m_super_physical_pages_used.sum(); }
 
     template<IteratorFunction<VMObject&> Callback>
     static void for_each_vmobject(Callback callback)
@@ -208,12 +219,15 @@ private:
     static Region* find_region_from_vaddr(VirtualAddress);
 
     RefPtr<PhysicalPage> find_free_user_physical_page(bool);
+    void refill_physical_page_cache(MemoryManagerData&);
+    void flush_physical_page_cache(MemoryManagerData&);
     u8* quickmap_page(PhysicalPage&);
     void unquickmap_page();
 
     PageDirectoryEntry* quickmap_pd(PageDirectory&, size_t pdpt_index);
     PageTableEntry* quickmap_pt(PhysicalAddress);
 
+    PageDirectoryEntry* pde(PageDirectory&, VirtualAddress);
     PageTableEntry* pte(PageDirectory&, VirtualAddress);
     PageTableEntry* ensure_pte(PageDirectory&, VirtualAddress);
     void release_pte(PageDirectory&, VirtualAddress, bool);
@@ -224,11 +238,16 @@ private:
     RefPtr<PhysicalPage> m_lazy_committed_page;
 
     Atomic<unsigned, AK::MemoryOrder::memory_order_relaxed> m_user_physical_pages { 0 };
-    Atomic<unsigned, AK::MemoryOrder::memory_order_relaxed> m_user_physical_pages_used { 0 };
+    // The "used" counters are pure statistics (only ProcFS reads them), so
+    // they're spread over per-processor slots to keep the allocation hot
+    // paths from contending on a shared cache line. The committed and
+    // uncommitted pools feed allocation decisions and need exact values, so
+    // they stay as plain atomics.
+    PerProcessorCounter m_user_physical_pages_used;
     Atomic<unsigned, AK::MemoryOrder::memory_order_relaxed> m_user_physical_pages_committed { 0 };
     Atomic<unsigned, AK::MemoryOrder::memory_order_relaxed> m_user_physical_pages_uncommitted { 0 };
     Atomic<unsigned, AK::MemoryOrder::memory_order_relaxed> m_super_physical_pages { 0 };
-    Atomic<unsigned, AK::MemoryOrder::memory_order_relaxed> m_super_physical_pages_used { 0 };
+    PerProcessorCounter m_super_physical_pages_used;
 
     NonnullRefPtrVector<PhysicalRegion> m_user_physical_regions;
     NonnullRefPtrVector<PhysicalRegion> m_super_physical_regions;
@@ -39,40 +39,129 @@ unsigned PhysicalRegion::finalize_capacity()
     VERIFY(!m_pages);
 
     m_pages = (m_upper.get() - m_lower.get()) / PAGE_SIZE;
-    m_bitmap.grow(m_pages, false);
+    for (size_t order = 0; order <= max_order; order++)
+        m_free_blocks[order].grow((m_pages + (1u << order) - 1) >> order, false);
+
+    // Start out with everything allocated, then free the whole region so it
+    // lands on the buddy free lists in maximal naturally aligned blocks.
+    m_used = m_pages;
+    free_range(0, m_pages);
 
     return size();
 }
 
+Optional<unsigned> PhysicalRegion::allocate_block(size_t order)
+{
+    auto free_index = m_free_blocks[order].find_one_anywhere_set(m_free_hint[order]);
+    if (free_index.has_value()) {
+        auto block = free_index.value();
+        m_free_blocks[order].set(block, false);
+        m_free_hint[order] = block;
+        m_used += 1u << order;
+        return (unsigned)(block << order);
+    }
+    if (order == max_order)
+        return {};
+    // No block at this order; split one from the order above. We keep the
+    // lower half and put the buddy back on the free list below.
+    auto split_block = allocate_block(order + 1);
+    if (!split_block.has_value())
+        return {};
+    auto page_index = split_block.value();
+    free_block(page_index + (1u << order), order);
+    return page_index;
+}
+
+void PhysicalRegion::free_block(unsigned page_index, size_t order)
+{
+    VERIFY((page_index & ((1u << order) - 1)) == 0);
+    VERIFY(m_used >= (1u << order));
+    m_used -= 1u << order;
+
+    // Coalesce with the buddy block as far up as possible, so contiguous
+    // runs become available again as soon as both halves are free.
+    auto block = page_index >> order;
+    while (order < max_order) {
+        auto buddy = block ^ 1;
+        if (buddy >= m_free_blocks[order].size() || !m_free_blocks[order].get(buddy))
+            break;
+        m_free_blocks[order].set(buddy, false);
+        block >>= 1;
+        order++;
+    }
+    m_free_blocks[order].set(block, true);
+    m_free_hint[order] = block;
+}
+
+void PhysicalRegion::free_range(unsigned page_index, unsigned page_count)
+{
+    // Free a run of pages in the largest naturally aligned blocks that fit.
+    while (page_count > 0) {
+        size_t order = __builtin_ctz(page_index | (1u << max_order));
+        while ((1u << order) > page_count)
+            order--;
+        free_block(page_index, order);
+        page_index += 1u << order;
+        page_count -= 1u << order;
+    }
+}
+
 NonnullRefPtrVector<PhysicalPage> PhysicalRegion::take_contiguous_free_pages(size_t count, bool supervisor, size_t physical_alignment)
 {
     VERIFY(m_pages);
-    VERIFY(m_used != m_pages);
 
     NonnullRefPtrVector<PhysicalPage> physical_pages;
-    physical_pages.ensure_capacity(count);
 
     auto first_contiguous_page = find_contiguous_free_pages(count, physical_alignment);
+    if (!first_contiguous_page.has_value())
+        return physical_pages;
 
+    physical_pages.ensure_capacity(count);
     for (size_t index = 0; index < count; index++)
-        physical_pages.append(PhysicalPage::create(m_lower.offset(PAGE_SIZE * (index + first_contiguous_page)), supervisor));
+        physical_pages.append(PhysicalPage::create(m_lower.offset(PAGE_SIZE * (index + first_contiguous_page.value())), supervisor));
     return physical_pages;
 }
 
-unsigned PhysicalRegion::find_contiguous_free_pages(size_t count, size_t physical_alignment)
+Optional<unsigned> PhysicalRegion::find_contiguous_free_pages(size_t count, size_t physical_alignment)
 {
     VERIFY(count != 0);
     VERIFY(physical_alignment % PAGE_SIZE == 0);
-    // search from the last page we allocated
-    auto range = find_and_allocate_contiguous_range(count, physical_alignment / PAGE_SIZE);
-    VERIFY(range.has_value());
-    return range.value();
+    size_t alignment_pages = physical_alignment / PAGE_SIZE;
+    VERIFY((alignment_pages & (alignment_pages - 1)) == 0);
+
+    // A buddy block of order n is naturally aligned to 2^n pages relative to
+    // the start of the region. If the region itself starts on a suitably
+    // aligned physical address, a large enough block is already aligned;
+    // otherwise we over-allocate by the alignment and trim both ends.
+    auto lower_page = m_lower.get() / PAGE_SIZE;
+    bool base_is_aligned = (lower_page % alignment_pages) == 0;
+    size_t needed_pages = base_is_aligned ? max(count, alignment_pages) : count + alignment_pages;
+
+    size_t order = 0;
+    while (order < max_order && (1u << order) < needed_pages)
+        order++;
+    if ((1u << order) < needed_pages)
+        return {};
+
+    auto block = allocate_block(order);
+    if (!block.has_value())
+        return {};
+
+    auto start = block.value();
+    auto aligned_start = start;
+    if (alignment_pages > 1)
+        aligned_start = (unsigned)((((lower_page + start + alignment_pages - 1) / alignment_pages) * alignment_pages) - lower_page);
+
+    // Give the slack on either side of the aligned range back to the buddy system.
+    free_range(start, aligned_start - start);
+    free_range(aligned_start + count, start + (1u << order) - (aligned_start + count));
+    return aligned_start;
 }
 
 Optional<unsigned> PhysicalRegion::find_one_free_page()
 {
     if (m_used == m_pages) {
-        // We know we don't have any free pages, no need to check the bitmap
+        // We know we don't have any free pages, no need to check the buddy bitmaps
         // Check if we can draw one from the return queue
         if (m_recently_returned.size() > 0) {
             u8 index = get_fast_random<u8>() % m_recently_returned.size();
@@ -85,53 +174,27 @@ Optional<unsigned> PhysicalRegion::find_one_free_page()
         }
         return {};
     }
-    auto free_index = m_bitmap.find_one_anywhere_unset(m_free_hint);
-    if (!free_index.has_value())
-        return {};
-
-    auto page_index = free_index.value();
-    m_bitmap.set(page_index, true);
-    m_used++;
-    m_free_hint = free_index.value() + 1; // Just a guess
-    if (m_free_hint >= m_bitmap.size())
-        m_free_hint = 0;
-    return page_index;
+    return allocate_block(0);
 }
 
-Optional<unsigned> PhysicalRegion::find_and_allocate_contiguous_range(size_t count, unsigned alignment)
+Optional<PhysicalAddress> PhysicalRegion::take_free_page_address()
 {
-    VERIFY(count != 0);
-    size_t found_pages_count = 0;
-    // TODO: Improve how we deal with alignment != 1
-    auto first_index = m_bitmap.find_longest_range_of_unset_bits(count + alignment - 1, found_pages_count);
-    if (!first_index.has_value())
+    VERIFY(m_pages);
+
+    auto free_index = find_one_free_page();
+    if (!free_index.has_value())
         return {};
 
-    auto page = first_index.value();
-    if (alignment != 1) {
-        auto lower_page = m_lower.get() / PAGE_SIZE;
-        page = ((lower_page + page + alignment - 1) & ~(alignment - 1)) - lower_page;
-    }
-    if (found_pages_count >= count) {
-        m_bitmap.set_range<true>(page, count);
-        m_used += count;
-        m_free_hint = first_index.value() + count + 1; // Just a guess
-        if (m_free_hint >= m_bitmap.size())
-            m_free_hint = 0;
-        return page;
-    }
-    return {};
+    return m_lower.offset(free_index.value() * PAGE_SIZE);
 }
 
 RefPtr<PhysicalPage> PhysicalRegion::take_free_page(bool supervisor)
 {
-    VERIFY(m_pages);
-
-    auto free_index = find_one_free_page();
-    if (!free_index.has_value())
+    auto paddr = take_free_page_address();
+    if (!paddr.has_value())
         return nullptr;
 
-    return PhysicalPage::create(m_lower.offset(free_index.value() * PAGE_SIZE), supervisor);
+    return PhysicalPage::create(paddr.value(), supervisor);
 }
 
 void PhysicalRegion::free_page_at(PhysicalAddress addr)
@@ -147,13 +210,10 @@ void PhysicalRegion::free_page_at(PhysicalAddress addr)
     VERIFY(!local_offset.has_overflow());
     VERIFY(local_offset.value() < (FlatPtr)(m_pages * PAGE_SIZE));
 
-    auto page = local_offset.value() / PAGE_SIZE;
-    m_bitmap.set(page, false);
-    m_free_hint = page; // We know we can find one here for sure
-    m_used--;
+    free_block(local_offset.value() / PAGE_SIZE, 0);
 }
 
-void PhysicalRegion::return_page(const PhysicalPage& page)
+void PhysicalRegion::return_page(PhysicalAddress paddr)
 {
     auto returned_count = m_recently_returned.size();
     if (returned_count >= m_recently_returned.capacity()) {
@@ -161,10 +221,10 @@ void PhysicalRegion::return_page(const PhysicalPage& page)
         // and replace the entry with this page
         auto& entry = m_recently_returned[get_fast_random<u8>()];
         free_page_at(entry);
-        entry = page.paddr();
+        entry = paddr;
     } else {
         // Still filling the return queue, just append it
-        m_recently_returned.append(page.paddr());
+        m_recently_returned.append(paddr);
     }
 }
 
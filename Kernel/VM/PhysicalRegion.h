@@ -18,6 +18,13 @@ class PhysicalRegion : public RefCounted<PhysicalRegion> {
     AK_MAKE_ETERNAL
 
 public:
+    // Free pages are kept in a binary buddy system: one bitmap of free
+    // blocks per order, where a block at order n covers 2^n pages. This
+    // makes single-page allocation a word-scan of the order-0 bitmap and
+    // keeps contiguous memory available as pages are freed, since freed
+    // blocks eagerly coalesce with their buddy.
+    static constexpr size_t max_order = 10; // 2^10 pages = 4 MiB blocks
+
     static NonnullRefPtr<PhysicalRegion> create(PhysicalAddress lower, PhysicalAddress upper);
     ~PhysicalRegion() = default;
 
@@ -29,16 +36,21 @@ public:
     unsigned size() const { return m_pages; }
     unsigned used() const { return m_used - m_recently_returned.size(); }
     unsigned free() const { return m_pages - m_used + m_recently_returned.size(); }
-    bool contains(const PhysicalPage& page) const { return page.paddr() >= m_lower && page.paddr() <= m_upper; }
+    bool contains(PhysicalAddress paddr) const { return paddr >= m_lower && paddr <= m_upper; }
+    bool contains(const PhysicalPage& page) const { return contains(page.paddr()); }
 
     RefPtr<PhysicalPage> take_free_page(bool supervisor);
+    Optional<PhysicalAddress> take_free_page_address();
     NonnullRefPtrVector<PhysicalPage> take_contiguous_free_pages(size_t count, bool supervisor, size_t physical_alignment = PAGE_SIZE);
-    void return_page(const PhysicalPage& page);
+    void return_page(PhysicalAddress);
+    void return_page(const PhysicalPage& page) { return_page(page.paddr()); }
 
 private:
-    unsigned find_contiguous_free_pages(size_t count, size_t physical_alignment = PAGE_SIZE);
-    Optional<unsigned> find_and_allocate_contiguous_range(size_t count, unsigned alignment = 1);
+    Optional<unsigned> allocate_block(size_t order);
+    void free_block(unsigned page_index, size_t order);
+    void free_range(unsigned page_index, unsigned page_count);
     Optional<unsigned> find_one_free_page();
+    Optional<unsigned> find_contiguous_free_pages(size_t count, size_t physical_alignment);
     void free_page_at(PhysicalAddress addr);
 
     PhysicalRegion(PhysicalAddress lower, PhysicalAddress upper);
@@ -47,8 +59,8 @@ private:
     PhysicalAddress m_upper;
     unsigned m_pages { 0 };
     unsigned m_used { 0 };
-    Bitmap m_bitmap;
-    size_t m_free_hint { 0 };
+    Bitmap m_free_blocks[max_order + 1];
+    size_t m_free_hint[max_order + 1] { 0 };
     Vector<PhysicalAddress, 256> m_recently_returned;
 };
 
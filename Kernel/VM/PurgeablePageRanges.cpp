@@ -238,6 +238,10 @@ auto PurgeablePageRanges::remove_volatile_range(const VolatilePageRange& range,
 
     // Now actually remove the range
     if (m_volatile_ranges.remove(range, was_purged)) {
+        // Restore any page contents that purging stashed in the compressed
+        // pool now that the pages are non-volatile again.
+        if (m_vmobject->restore_compressed_pages(range))
+            was_purged = true;
         m_vmobject->range_made_nonvolatile(range);
         return RemoveVolatileError::Success;
     }
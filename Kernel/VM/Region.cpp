@@ -96,6 +96,11 @@ OwnPtr<Region> Region::clone(Process& new_owner)
     if (vmobject().is_inode())
         VERIFY(vmobject().is_private_inode());
 
+    // CoW works on individual 4KiB pages, which a 2MiB mapping can't
+    // express, so fall back to regular page tables before becoming CoW.
+    if (m_huge_pages)
+        demote_huge_pages();
+
     auto vmobject_clone = vmobject().clone();
     if (!vmobject_clone)
         return {};
@@ -145,6 +150,11 @@ auto Region::set_volatile(VirtualAddress vaddr, size_t size, bool is_volatile, b
     if (!m_vmobject->is_anonymous())
         return SetVolatileError::NotPurgeable;
 
+    // Purging snatches individual pages out of the VMObject, which a 2MiB
+    // mapping can't express; fall back to regular page tables first.
+    if (m_huge_pages)
+        demote_huge_pages();
+
     auto offset_in_vmobject = vaddr.get() - (this->vaddr().get() - m_offset_in_vmobject);
     if (is_volatile) {
         // If marking pages as volatile, be prudent by not marking
@@ -266,6 +276,55 @@ bool Region::map_individual_page_impl(size_t page_index)
     return true;
 }
 
+void Region::map_individual_huge_page_impl(size_t chunk_index)
+{
+    VERIFY(m_page_directory->get_lock().own_lock());
+    auto page_vaddr = vaddr_from_page_index(chunk_index * pages_per_huge_page);
+
+    bool user_allowed = page_vaddr.get() >= 0x00800000 && is_user_address(page_vaddr);
+    if (is_mmap() && !user_allowed) {
+        PANIC("About to map mmap'ed page at a kernel address");
+    }
+
+    auto* pde = MM.pde(*m_page_directory, page_vaddr);
+    auto* page = physical_page(chunk_index * pages_per_huge_page);
+    if (!page || (!is_readable() && !is_writable())) {
+        pde->clear();
+    } else {
+        VERIFY(page->paddr().get() % huge_page_size == 0);
+        pde->set_page_table_base(page->paddr().get());
+        pde->set_huge(true);
+        pde->set_cache_disabled(!m_cacheable);
+        pde->set_present(true);
+        pde->set_writable(is_writable());
+        if (Processor::current().has_feature(CPUFeature::NX))
+            pde->set_execute_disabled(!is_executable());
+        pde->set_user_allowed(user_allowed);
+    }
+}
+
+void Region::demote_huge_pages()
+{
+    // Transparently replace the 2MiB mappings with regular 4KiB page
+    // tables. The VMObject tracks every page individually anyway, so this
+    // only rewrites the paging structures.
+    ScopedSpinLock lock(s_mm_lock);
+    if (!m_huge_pages)
+        return;
+    m_huge_pages = false;
+    if (!m_page_directory)
+        return;
+    ScopedSpinLock page_lock(m_page_directory->get_lock());
+    // Clear the huge PDEs first; ensure_pte() would otherwise mistake them
+    // for page table pointers.
+    size_t chunk_count = page_count() / pages_per_huge_page;
+    for (size_t chunk_index = 0; chunk_index < chunk_count; ++chunk_index)
+        MM.pde(*m_page_directory, vaddr_from_page_index(chunk_index * pages_per_huge_page))->clear();
+    for (size_t page_index = 0; page_index < page_count(); ++page_index)
+        map_individual_page_impl(page_index);
+    MM.flush_tlb(m_page_directory, vaddr(), page_count());
+}
+
 bool Region::do_remap_vmobject_page_range(size_t page_index, size_t page_count)
 {
     bool success = true;
@@ -344,7 +403,15 @@ void Region::unmap(ShouldDeallocateVirtualMemoryRange deallocate_range)
         return;
     ScopedSpinLock page_lock(m_page_directory->get_lock());
     size_t count = page_count();
-    for (size_t i = 0; i < count; ++i) {
+    size_t first_page_index = 0;
+    if (m_huge_pages) {
+        // Huge chunks have no page tables to release; just clear their PDEs.
+        size_t chunk_count = count / pages_per_huge_page;
+        for (size_t chunk_index = 0; chunk_index < chunk_count; ++chunk_index)
+            MM.pde(*m_page_directory, vaddr_from_page_index(chunk_index * pages_per_huge_page))->clear();
+        first_page_index = chunk_count * pages_per_huge_page;
+    }
+    for (size_t i = first_page_index; i < count; ++i) {
         auto vaddr = vaddr_from_page_index(i);
         MM.release_pte(*m_page_directory, vaddr, i == count - 1);
     }
@@ -377,6 +444,14 @@ bool Region::map(PageDirectory& page_directory, ShouldFlushTLB should_flush_tlb)
 
     set_page_directory(page_directory);
     size_t page_index = 0;
+    if (m_huge_pages) {
+        // Map whole 2MiB chunks directly in the page directory; a tail
+        // shorter than a huge page is mapped with regular pages below.
+        size_t chunk_count = page_count() / pages_per_huge_page;
+        for (size_t chunk_index = 0; chunk_index < chunk_count; ++chunk_index)
+            map_individual_huge_page_impl(chunk_index);
+        page_index = chunk_count * pages_per_huge_page;
+    }
     while (page_index < page_count()) {
         if (!map_individual_page_impl(page_index))
             break;
@@ -390,6 +465,22 @@ bool Region::map(PageDirectory& page_directory, ShouldFlushTLB should_flush_tlb)
     return false;
 }
 
+void Region::map_lazily(PageDirectory& page_directory)
+{
+    ScopedSpinLock lock(s_mm_lock);
+    ScopedSpinLock page_lock(page_directory.get_lock());
+
+    if (is_user() && !is_shared()) {
+        VERIFY(!vmobject().is_shared_inode());
+    }
+
+    // Attach the region to the page directory without writing any PTEs.
+    // Pages are materialized one at a time by handle_fault() on first
+    // access, so fork() pays for the pages the child actually touches
+    // instead of walking the parent's entire address space.
+    set_page_directory(page_directory);
+}
+
 void Region::remap()
 {
     VERIFY(m_page_directory);
@@ -420,6 +511,23 @@ PageFaultResponse Region::handle_fault(const PageFault& fault, ScopedSpinLock<Re
             remap_vmobject_page(page_index_in_vmobject);
             return PageFaultResponse::Continue;
         }
+        if (page_slot->is_shared_zero_page()) {
+            if (fault.is_read()) {
+                remap_vmobject_page(translate_to_vmobject_page(page_index_in_region));
+                return PageFaultResponse::Continue;
+            }
+            return handle_zero_fault(page_index_in_region);
+        }
+        if (!page_slot.is_null()) {
+            // The page is already backed but has no PTE yet; the region was
+            // attached with map_lazily() at fork() time. Materialize the
+            // mapping now. If this is a write to a CoW page, the read-only
+            // mapping we write here will immediately re-fault as a
+            // protection violation and take the CoW path.
+            dbgln_if(PAGE_FAULT_DEBUG, "NP(lazy) fault in Region({})[{}] at {}", this, page_index_in_region, fault.vaddr());
+            remap_vmobject_page(translate_to_vmobject_page(page_index_in_region));
+            return PageFaultResponse::Continue;
+        }
 #ifdef MAP_SHARED_ZERO_PAGE_LAZILY
         if (fault.is_read()) {
             page_slot = MM.shared_zero_page();
@@ -51,6 +51,12 @@ public:
         Yes,
     };
 
+    // Large anonymous mappings (MAP_HUGEPAGES) can be backed by 2MiB x86
+    // "huge" pages mapped directly in the page directory, cutting TLB
+    // pressure for multi-megabyte working sets.
+    static constexpr size_t huge_page_size = 2 * MiB;
+    static constexpr size_t pages_per_huge_page = huge_page_size / PAGE_SIZE;
+
     static NonnullOwnPtr<Region> create_user_accessible(Process*, const Range&, NonnullRefPtr<VMObject>, size_t offset_in_vmobject, String name, Region::Access access, Cacheable, bool shared);
     static NonnullOwnPtr<Region> create_kernel_only(const Range&, NonnullRefPtr<VMObject>, size_t offset_in_vmobject, String name, Region::Access access, Cacheable = Cacheable::Yes);
 
@@ -86,6 +92,18 @@ public:
     bool is_mmap() const { return m_mmap; }
     void set_mmap(bool mmap) { m_mmap = mmap; }
 
+    bool uses_huge_pages() const { return m_huge_pages; }
+    void set_uses_huge_pages(bool huge)
+    {
+        if (huge) {
+            VERIFY(vaddr().get() % huge_page_size == 0);
+            VERIFY(size() >= huge_page_size);
+            VERIFY(m_offset_in_vmobject == 0);
+        }
+        m_huge_pages = huge;
+    }
+    void demote_huge_pages();
+
     bool is_user() const { return !is_kernel(); }
     bool is_kernel() const { return vaddr().get() < 0x00800000 || vaddr().get() >= 0xc0000000; }
 
@@ -203,6 +221,7 @@ public:
 
     void set_page_directory(PageDirectory&);
     bool map(PageDirectory&, ShouldFlushTLB = ShouldFlushTLB::Yes);
+    void map_lazily(PageDirectory&);
     enum class ShouldDeallocateVirtualMemoryRange {
         No,
         Yes,
@@ -251,6 +270,7 @@ private:
     PageFaultResponse handle_zero_fault(size_t page_index);
 
     bool map_individual_page_impl(size_t page_index);
+    void map_individual_huge_page_impl(size_t chunk_index);
 
     void register_purgeable_page_ranges();
     void unregister_purgeable_page_ranges();
@@ -265,6 +285,7 @@ private:
     bool m_cacheable : 1 { false };
     bool m_stack : 1 { false };
     bool m_mmap : 1 { false };
+    bool m_huge_pages : 1 { false };
     bool m_syscall_region : 1 { false };
     WeakPtr<Process> m_owner;
 };
@@ -4,21 +4,76 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Memory.h>
+#include <AK/NonnullRefPtrVector.h>
+#include <AK/Singleton.h>
 #include <Kernel/FileSystem/Inode.h>
+#include <Kernel/VM/MemoryManager.h>
 #include <Kernel/VM/SharedInodeVMObject.h>
 
 namespace Kernel {
 
+static AK::Singleton<NonnullRefPtrVector<SharedInodeVMObject>> s_pinned_vmobjects;
+static SpinLock<u8> s_pinned_vmobjects_lock;
+
 NonnullRefPtr<SharedInodeVMObject> SharedInodeVMObject::create_with_inode(Inode& inode)
 {
     size_t size = inode.size();
     if (auto shared_vmobject = inode.shared_vmobject())
         return shared_vmobject.release_nonnull();
     auto vmobject = adopt_ref(*new SharedInodeVMObject(inode, size));
-    vmobject->inode().set_shared_vmobject(*vmobject);
+    if (auto existing = inode.set_shared_vmobject(*vmobject)) {
+        // Someone else beat us to it. Every mapping of an inode must share the
+        // same VMObject, so use theirs and let ours die.
+        return existing.release_nonnull();
+    }
     return vmobject;
 }
 
+void SharedInodeVMObject::pin(SharedInodeVMObject& vmobject)
+{
+    ScopedSpinLock lock(s_pinned_vmobjects_lock);
+    for (auto& pinned : *s_pinned_vmobjects) {
+        if (&pinned == &vmobject)
+            return;
+    }
+    s_pinned_vmobjects->append(vmobject);
+}
+
+KResult SharedInodeVMObject::populate_all_pages()
+{
+    Locker locker(m_paging_lock);
+
+    u8 page_buffer[PAGE_SIZE];
+    for (size_t page_index = 0; page_index < page_count(); ++page_index) {
+        if (!physical_pages()[page_index].is_null())
+            continue;
+
+        auto buffer = UserOrKernelBuffer::for_kernel_buffer(page_buffer);
+        auto result = inode().read_bytes(page_index * PAGE_SIZE, PAGE_SIZE, buffer, nullptr);
+        if (result.is_error())
+            return result.error();
+        auto nread = result.value();
+        if (nread < (ssize_t)PAGE_SIZE) {
+            // Zero out the tail to avoid leaking uninitialized data, just like
+            // the page fault path does.
+            memset(page_buffer + nread, 0, PAGE_SIZE - nread);
+        }
+
+        auto physical_page = MM.allocate_user_physical_page(MemoryManager::ShouldZeroFill::No);
+        if (!physical_page)
+            return ENOMEM;
+        {
+            InterruptDisabler disabler;
+            u8* dest_ptr = MM.quickmap_page(*physical_page);
+            memcpy(dest_ptr, page_buffer, PAGE_SIZE);
+            MM.unquickmap_page();
+        }
+        physical_pages()[page_index] = move(physical_page);
+    }
+    return KSuccess;
+}
+
 RefPtr<VMObject> SharedInodeVMObject::clone()
 {
     return adopt_ref(*new SharedInodeVMObject(*this));
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/Bitmap.h>
+#include <Kernel/KResult.h>
 #include <Kernel/UnixTypes.h>
 #include <Kernel/VM/InodeVMObject.h>
 
@@ -19,6 +20,15 @@ public:
     static NonnullRefPtr<SharedInodeVMObject> create_with_inode(Inode&);
     virtual RefPtr<VMObject> clone() override;
 
+    // A pinned VMObject is kept alive kernel-wide even when nothing maps it,
+    // so the pages of hot read-only assets survive between the processes that
+    // map them instead of dying with the last mapping.
+    static void pin(SharedInodeVMObject&);
+
+    // Reads the entire file into the VMObject up front, so later mappings
+    // never take a cold page fault.
+    KResult populate_all_pages();
+
 private:
     virtual bool is_shared_inode() const override { return true; }
 
@@ -71,6 +71,41 @@ KResultOr<Region*> Space::allocate_region(const Range& range, const String& name
     return &add_region(move(region));
 }
 
+KResultOr<Region*> Space::allocate_region_with_huge_pages(const Range& range, const String& name, int prot)
+{
+    VERIFY(range.is_valid());
+    VERIFY(range.base().get() % Region::huge_page_size == 0);
+    VERIFY(range.size() >= Region::huge_page_size);
+
+    // Eagerly allocate a physically contiguous, naturally aligned 2MiB
+    // chunk for each whole huge page. A tail shorter than a huge page gets
+    // regular pages; Region::map() maps it with 4KiB PTEs.
+    NonnullRefPtrVector<PhysicalPage> physical_pages;
+    size_t chunk_count = range.size() / Region::huge_page_size;
+    for (size_t chunk_index = 0; chunk_index < chunk_count; ++chunk_index) {
+        auto chunk = MM.allocate_contiguous_user_physical_pages(Region::huge_page_size, Region::huge_page_size);
+        if (chunk.is_empty())
+            return ENOMEM; // Physical memory is too fragmented; the caller falls back to 4KiB pages.
+        for (size_t i = 0; i < chunk.size(); ++i)
+            physical_pages.append(chunk.ptr_at(i));
+    }
+    for (size_t offset = chunk_count * Region::huge_page_size; offset < range.size(); offset += PAGE_SIZE) {
+        auto page = MM.allocate_user_physical_page();
+        if (!page)
+            return ENOMEM;
+        physical_pages.append(page.release_nonnull());
+    }
+
+    auto vmobject = AnonymousVMObject::create_with_physical_pages(move(physical_pages));
+    if (!vmobject)
+        return ENOMEM;
+    auto region = Region::create_user_accessible(m_process, range, vmobject.release_nonnull(), 0, name, prot_to_region_access_flags(prot), Region::Cacheable::Yes, false);
+    region->set_uses_huge_pages(true);
+    if (!region->map(page_directory()))
+        return ENOMEM;
+    return &add_region(move(region));
+}
+
 KResultOr<Region*> Space::allocate_region_with_vmobject(const Range& range, NonnullRefPtr<VMObject> vmobject, size_t offset_in_vmobject, const String& name, int prot, bool shared)
 {
     VERIFY(range.is_valid());
@@ -107,6 +142,8 @@ OwnPtr<Region> Space::take_region(Region& region)
 
     if (m_region_lookup_cache.region.unsafe_ptr() == &region)
         m_region_lookup_cache.region = nullptr;
+    if (m_last_containing_region.unsafe_ptr() == &region)
+        m_last_containing_region = nullptr;
     // FIXME: currently we traverse the RBTree twice, once to check if the region in the tree starting at region.vaddr()
     //  is the same region and once to actually remove it, maybe we can add some kind of remove_if()?
     auto found_region = m_regions.find(region.vaddr().get());
@@ -138,10 +175,13 @@ Region* Space::find_region_from_range(const Range& range)
 Region* Space::find_region_containing(const Range& range)
 {
     ScopedSpinLock lock(m_lock);
+    if (auto* cached = m_last_containing_region.unsafe_ptr(); cached && cached->range().contains(range))
+        return cached;
     auto candidate = m_regions.find_largest_not_above(range.base().get());
-    if (!candidate)
+    if (!candidate || !(*candidate)->range().contains(range))
         return nullptr;
-    return (*candidate)->range().contains(range) ? candidate->ptr() : nullptr;
+    m_last_containing_region = **candidate;
+    return candidate->ptr();
 }
 
 Vector<Region*> Space::find_regions_intersecting(const Range& range)
@@ -296,6 +336,49 @@ size_t Space::amount_purgeable_volatile() const
     return amount;
 }
 
+auto Space::memory_statistics() const -> MemoryStatistics
+{
+    MemoryStatistics statistics;
+    ScopedSpinLock lock(m_lock);
+    HashTable<const InodeVMObject*> inode_vmobjects;
+    for (auto& region : m_regions) {
+        statistics.amount_virtual += region->size();
+
+        auto& vmobject = region->vmobject();
+
+        // One walk over the pages stands in for the separate
+        // amount_resident() and amount_shared() walks. The per-amount
+        // FIXMEs about double counting and PhysicalPage ref counts apply
+        // here just the same.
+        size_t resident = 0;
+        size_t shared = 0;
+        for (size_t i = 0; i < region->page_count(); ++i) {
+            auto* page = region->physical_page(i);
+            if (!page || page->is_shared_zero_page() || page->is_lazy_committed_page())
+                continue;
+            resident += PAGE_SIZE;
+            if (page->ref_count() > 1)
+                shared += PAGE_SIZE;
+        }
+        statistics.amount_resident += resident;
+        statistics.amount_shared += shared;
+
+        if (!region->is_shared())
+            statistics.amount_dirty_private += vmobject.is_inode() ? static_cast<const InodeVMObject&>(vmobject).amount_dirty() : resident;
+        if (vmobject.is_inode())
+            inode_vmobjects.set(&static_cast<const InodeVMObject&>(vmobject));
+        if (vmobject.is_anonymous()) {
+            if (static_cast<const AnonymousVMObject&>(vmobject).is_any_volatile())
+                statistics.amount_purgeable_volatile += resident;
+            else
+                statistics.amount_purgeable_nonvolatile += resident;
+        }
+    }
+    for (auto& vmobject : inode_vmobjects)
+        statistics.amount_clean_inode += vmobject->amount_clean();
+    return statistics;
+}
+
 size_t Space::amount_purgeable_nonvolatile() const
 {
     ScopedSpinLock lock(m_lock);
@@ -37,6 +37,7 @@ public:
 
     KResultOr<Region*> allocate_region_with_vmobject(const Range&, NonnullRefPtr<VMObject>, size_t offset_in_vmobject, const String& name, int prot, bool shared);
     KResultOr<Region*> allocate_region(const Range&, const String& name, int prot = PROT_READ | PROT_WRITE, AllocationStrategy strategy = AllocationStrategy::Reserve);
+    KResultOr<Region*> allocate_region_with_huge_pages(const Range&, const String& name, int prot);
     bool deallocate_region(Region& region);
     OwnPtr<Region> take_region(Region& region);
 
@@ -63,6 +64,19 @@ public:
     size_t amount_purgeable_volatile() const;
     size_t amount_purgeable_nonvolatile() const;
 
+    struct MemoryStatistics {
+        size_t amount_virtual { 0 };
+        size_t amount_resident { 0 };
+        size_t amount_dirty_private { 0 };
+        size_t amount_clean_inode { 0 };
+        size_t amount_shared { 0 };
+        size_t amount_purgeable_volatile { 0 };
+        size_t amount_purgeable_nonvolatile { 0 };
+    };
+    // All of the amounts above in a single pass over the regions and their
+    // pages, for callers (/proc/all) that want the whole set at once.
+    MemoryStatistics memory_statistics() const;
+
 private:
     Space(Process&, NonnullRefPtr<PageDirectory>);
 
@@ -79,6 +93,11 @@ private:
     };
     RegionLookupCache m_region_lookup_cache;
 
+    // One-entry cache for find_region_containing(): page faults overwhelmingly
+    // hit the same region many times in a row (heap growth, GC sweeps), and
+    // remembering the last hit skips the tree descent entirely.
+    WeakPtr<Region> m_last_containing_region;
+
     bool m_enforces_syscall_regions { false };
 };
 
@@ -9,6 +9,7 @@
 #include <Kernel/ACPI/Initialize.h>
 #include <Kernel/ACPI/MultiProcessorParser.h>
 #include <Kernel/Arch/x86/CPU.h>
+#include <Kernel/BootTrace.h>
 #include <Kernel/CMOS.h>
 #include <Kernel/CommandLine.h>
 #include <Kernel/DMI.h>
@@ -24,6 +25,7 @@
 #include <Kernel/Devices/VMWareBackdoor.h>
 #include <Kernel/Devices/ZeroDevice.h>
 #include <Kernel/FileSystem/Ext2FileSystem.h>
+#include <Kernel/FileSystem/FileDescription.h>
 #include <Kernel/FileSystem/VirtualFileSystem.h>
 #include <Kernel/Graphics/GraphicsManagement.h>
 #include <Kernel/Heap/SlabAllocator.h>
@@ -53,6 +55,7 @@
 #include <Kernel/Tasks/SyncTask.h>
 #include <Kernel/Time/TimeManagement.h>
 #include <Kernel/VM/MemoryManager.h>
+#include <Kernel/VM/SharedInodeVMObject.h>
 #include <Kernel/VirtIO/VirtIO.h>
 #include <Kernel/WorkQueue.h>
 #include <Kernel/kstdio.h>
@@ -83,6 +86,7 @@ namespace Kernel {
 
 [[noreturn]] static void init_stage2(void*);
 static void setup_serial_debug();
+static void preheat_shared_assets();
 
 // boot.S expects these functions to exactly have the following signatures.
 // We declare them here to ensure their signatures don't accidentally change.
@@ -113,6 +117,8 @@ extern "C" UNMAP_AFTER_INIT [[noreturn]] void init()
 
     setup_serial_debug();
 
+    BootTrace::mark("early_init");
+
     // We need to copy the command line before kmalloc is initialized,
     // as it may overwrite parts of multiboot!
     CommandLine::early_initialize(kernel_cmdline);
@@ -126,6 +132,8 @@ extern "C" UNMAP_AFTER_INIT [[noreturn]] void init()
     kmalloc_init();
     slab_alloc_init();
 
+    BootTrace::mark("memory_management");
+
     ConsoleDevice::initialize();
     s_bsp_processor.initialize(0);
 
@@ -141,6 +149,8 @@ extern "C" UNMAP_AFTER_INIT [[noreturn]] void init()
     for (ctor_func_t* ctor = &start_ctors; ctor < &end_ctors; ctor++)
         (*ctor)();
 
+    BootTrace::mark("interrupts_and_acpi");
+
     APIC::initialize();
     InterruptManagement::initialize();
     ACPI::initialize();
@@ -149,6 +159,8 @@ extern "C" UNMAP_AFTER_INIT [[noreturn]] void init()
     PCI::initialize();
     PCISerialDevice::detect();
 
+    BootTrace::mark("vfs_and_time");
+
     VFS::initialize();
 
     dmesgln("Starting SerenityOS...");
@@ -157,6 +169,8 @@ extern "C" UNMAP_AFTER_INIT [[noreturn]] void init()
 
     __stack_chk_guard = get_fast_random<u32>();
 
+    BootTrace::mark("devices");
+
     NullDevice::initialize();
     if (!get_serial_debug())
         new SerialDevice(IOAddress(SERIAL_COM1_ADDR), 64);
@@ -170,6 +184,8 @@ extern "C" UNMAP_AFTER_INIT [[noreturn]] void init()
     GraphicsManagement::the().initialize();
     ConsoleManagement::the().initialize();
 
+    BootTrace::mark("scheduler");
+
     Thread::initialize();
     Process::initialize();
     Scheduler::initialize();
@@ -222,6 +238,8 @@ extern "C" UNMAP_AFTER_INIT void init_finished(u32 cpu)
 
 void init_stage2(void*)
 {
+    BootTrace::mark("init_stage2");
+
     if (APIC::initialized() && APIC::the().enabled_processor_count() > 1) {
         // We can't start the APs until we have a scheduler up and running.
         // We need to be able to process ICI messages, otherwise another
@@ -235,6 +253,12 @@ void init_stage2(void*)
 
     auto boot_profiling = kernel_command_line().is_boot_profiling_enabled();
 
+    // NOTE: We have to look this up now; the command line becomes inaccessible
+    // once UNMAP_AFTER_INIT memory is unmapped below.
+    auto boot_trace_dump = kernel_command_line().is_boot_trace_dump_enabled();
+
+    BootTrace::mark("device_detection");
+
     USB::UHCIController::detect();
 
     DMIExpose::initialize();
@@ -256,6 +280,8 @@ void init_stage2(void*)
     PTYMultiplexer::initialize();
     SB16::detect();
 
+    BootTrace::mark("mount_root");
+
     StorageManagement::initialize(kernel_command_line().root_device(), kernel_command_line().is_force_pio());
     if (!VFS::the().mount_root(StorageManagement::the().root_filesystem())) {
         PANIC("VFS::mount_root failed");
@@ -265,12 +291,18 @@ void init_stage2(void*)
 
     load_kernel_symbol_table();
 
+    preheat_shared_assets();
+
+    BootTrace::mark("seal_init_memory");
+
     // NOTE: Everything marked READONLY_AFTER_INIT becomes non-writable after this point.
     MM.protect_readonly_after_init_memory();
 
     // NOTE: Everything marked UNMAP_AFTER_INIT becomes inaccessible after this point.
     MM.unmap_memory_after_init();
 
+    BootTrace::mark("spawn_init");
+
     int error;
 
     // FIXME: It would be nicer to set the mode from userspace.
@@ -293,10 +325,54 @@ void init_stage2(void*)
 
     NetworkTask::spawn();
 
+    BootTrace::mark("boot_finished");
+
+    if (boot_trace_dump)
+        BootTrace::dump();
+
     Process::current()->sys$exit(0);
     VERIFY_NOT_REACHED();
 }
 
+static void preheat_shared_assets()
+{
+    // Files listed in /etc/preheat (one absolute path per line, '#' starts a
+    // comment) are read into pinned SharedInodeVMObjects now, so every process
+    // that maps them later shares the same warm pages and takes no cold-start
+    // page faults. The list is optional.
+    auto list_description_or_error = VFS::the().open("/etc/preheat", O_RDONLY, 0, VFS::the().root_custody());
+    if (list_description_or_error.is_error())
+        return;
+    auto list_or_error = list_description_or_error.value()->read_entire_file();
+    if (list_or_error.is_error())
+        return;
+    auto& list = *list_or_error.value();
+
+    size_t file_count = 0;
+    for (auto& line : StringView((const char*)list.data(), list.size()).split_view('\n')) {
+        auto path = line.trim_whitespace();
+        if (path.is_empty() || path.starts_with('#'))
+            continue;
+        auto description_or_error = VFS::the().open(path, O_RDONLY, 0, VFS::the().root_custody());
+        if (description_or_error.is_error()) {
+            dmesgln("preheat: Failed to open {}: {}", path, description_or_error.error());
+            continue;
+        }
+        auto* inode = description_or_error.value()->inode();
+        if (!inode)
+            continue;
+        auto vmobject = SharedInodeVMObject::create_with_inode(*inode);
+        if (auto result = vmobject->populate_all_pages(); result.is_error()) {
+            dmesgln("preheat: Failed to read {}: {}", path, result.error());
+            continue;
+        }
+        SharedInodeVMObject::pin(*vmobject);
+        ++file_count;
+    }
+    if (file_count)
+        dmesgln("preheat: Pinned {} shared asset file(s)", file_count);
+}
+
 UNMAP_AFTER_INIT void setup_serial_debug()
 {
     // serial_debug will output all the dbgln() data to COM1 at
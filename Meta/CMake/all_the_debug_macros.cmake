@@ -57,6 +57,7 @@ set(CRYPTO_DEBUG ON)
 set(DWARF_DEBUG ON)
 set(HUNKS_DEBUG ON)
 set(JOB_DEBUG ON)
+set(JS_BYTECODE_DEBUG ON)
 set(SHELL_JOB_DEBUG ON)
 set(GIF_DEBUG ON)
 set(JPG_DEBUG ON)
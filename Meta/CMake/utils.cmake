@@ -131,9 +131,9 @@ function(compile_gml source output string_name)
     set(source ${CMAKE_CURRENT_SOURCE_DIR}/${source})
     add_custom_command(
         OUTPUT ${output}
-        COMMAND ${write_if_different} ${output} ${CMAKE_SOURCE_DIR}/Meta/text-to-cpp-string.sh ${string_name} ${source}
+        COMMAND ${write_if_different} ${output} ${CMAKE_BINARY_DIR}/Userland/DevTools/GMLCompiler/GMLCompiler ${string_name} ${source}
         VERBATIM
-        DEPENDS ${CMAKE_SOURCE_DIR}/Meta/text-to-cpp-string.sh
+        DEPENDS GMLCompiler
         MAIN_DEPENDENCY ${source}
     )
     get_filename_component(output_name ${output} NAME)
@@ -10,7 +10,6 @@
 
 extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
 {
-    ByteBuffer font_data = ByteBuffer::copy(data, size);
-    TTF::Font::load_from_memory(font_data);
+    TTF::Font::load_from_memory({ data, size });
     return 0;
 }
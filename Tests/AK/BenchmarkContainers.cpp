@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+
+BENCHMARK_CASE(vector_of_int_append)
+{
+    Vector<int> ints;
+    for (int i = 0; i < 1'000'000; ++i)
+        ints.append(i);
+    EXPECT_EQ(ints.size(), 1'000'000u);
+}
+
+BENCHMARK_CASE(vector_of_int_iteration)
+{
+    Vector<int> ints;
+    ints.ensure_capacity(1'000'000);
+    for (int i = 0; i < 1'000'000; ++i)
+        ints.unchecked_append(i);
+
+    u64 sum = 0;
+    for (int value : ints)
+        sum += value;
+    EXPECT_EQ(sum, 499'999'500'000ull);
+}
+
+BENCHMARK_CASE(hash_table_of_int_set_and_contains)
+{
+    HashTable<int> table;
+    for (int i = 0; i < 100'000; ++i)
+        table.set(i * 7);
+
+    size_t hits = 0;
+    for (int i = 0; i < 700'000; ++i) {
+        if (table.contains(i))
+            ++hits;
+    }
+    EXPECT_EQ(hits, 100'000u);
+}
+
+BENCHMARK_CASE(hash_map_of_string_set_and_get)
+{
+    Vector<String> keys;
+    keys.ensure_capacity(10'000);
+    for (int i = 0; i < 10'000; ++i)
+        keys.unchecked_append(String::number(i));
+
+    HashMap<String, int> map;
+    for (int repeat = 0; repeat < 10; ++repeat) {
+        for (int i = 0; i < 10'000; ++i)
+            map.set(keys[i], i);
+    }
+
+    u64 sum = 0;
+    for (auto& key : keys)
+        sum += map.get(key).value();
+    EXPECT_EQ(sum, 49'995'000ull);
+}
+
+BENCHMARK_CASE(hash_map_of_int_iteration)
+{
+    HashMap<int, int> map;
+    for (int i = 0; i < 100'000; ++i)
+        map.set(i, i);
+
+    u64 sum = 0;
+    for (int repeat = 0; repeat < 20; ++repeat) {
+        for (auto& it : map)
+            sum += it.value;
+    }
+    EXPECT_EQ(sum, 20ull * 4'999'950'000ull);
+}
+
+BENCHMARK_CASE(ordered_hash_map_of_int_iteration)
+{
+    OrderedHashMap<int, int> map;
+    for (int i = 0; i < 100'000; ++i)
+        map.set(i, i);
+
+    u64 sum = 0;
+    for (int repeat = 0; repeat < 20; ++repeat) {
+        for (auto& it : map)
+            sum += it.value;
+    }
+    EXPECT_EQ(sum, 20ull * 4'999'950'000ull);
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/BumpAllocator.h>
+#include <AK/Vector.h>
+
+TEST_CASE(basic_allocation)
+{
+    BumpAllocator allocator;
+    auto* a = (int*)allocator.allocate(sizeof(int), alignof(int));
+    auto* b = (int*)allocator.allocate(sizeof(int), alignof(int));
+    EXPECT(a != nullptr);
+    EXPECT(b != nullptr);
+    EXPECT(a != b);
+    *a = 1;
+    *b = 2;
+    EXPECT_EQ(*a, 1);
+    EXPECT_EQ(*b, 2);
+}
+
+TEST_CASE(alignment)
+{
+    BumpAllocator allocator;
+    (void)allocator.allocate(1, 1);
+    auto* pointer = allocator.allocate(sizeof(u64), 64);
+    EXPECT_EQ((FlatPtr)pointer % 64, 0u);
+}
+
+TEST_CASE(many_allocations_span_chunks)
+{
+    BumpAllocator allocator(4 * KiB);
+    Vector<u32*> pointers;
+    for (u32 i = 0; i < 10000; ++i) {
+        auto* pointer = (u32*)allocator.allocate(sizeof(u32), alignof(u32));
+        *pointer = i;
+        pointers.append(pointer);
+    }
+    for (u32 i = 0; i < 10000; ++i)
+        EXPECT_EQ(*pointers[i], i);
+}
+
+TEST_CASE(oversized_allocation)
+{
+    BumpAllocator allocator(1 * KiB);
+    auto* pointer = (u8*)allocator.allocate(64 * KiB);
+    EXPECT(pointer != nullptr);
+    pointer[0] = 1;
+    pointer[64 * KiB - 1] = 2;
+    EXPECT_EQ(pointer[0], 1);
+    EXPECT_EQ(pointer[64 * KiB - 1], 2);
+}
+
+TEST_CASE(free_all_allows_reuse)
+{
+    BumpAllocator allocator;
+    (void)allocator.allocate(128);
+    allocator.free_all();
+    auto* pointer = (int*)allocator.allocate(sizeof(int), alignof(int));
+    *pointer = 123;
+    EXPECT_EQ(*pointer, 123);
+}
+
+TEST_CASE(typed_allocation)
+{
+    struct Point {
+        int x;
+        int y;
+    };
+    BumpAllocator allocator;
+    auto* point = allocator.allocate<Point>(3, 4);
+    EXPECT_EQ(point->x, 3);
+    EXPECT_EQ(point->y, 4);
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/CPUFeatures.h>
+
+TEST_CASE(detection_is_cached)
+{
+    // The first call probes CPUID; every later call must return the same set.
+    auto first = CPUFeatures::all();
+    auto second = CPUFeatures::all();
+    EXPECT(first == second);
+}
+
+TEST_CASE(has_none_is_always_true)
+{
+    EXPECT(CPUFeatures::has(CPUFeature::None));
+}
+
+TEST_CASE(feature_hierarchy_is_consistent)
+{
+    // Any x86 machine this test runs on that has SSE2 also has SSE, and
+    // AVX2 implies AVX; a detector that disagrees is misreading CPUID.
+    if (CPUFeatures::has(CPUFeature::SSE2))
+        EXPECT(CPUFeatures::has(CPUFeature::SSE));
+    if (CPUFeatures::has(CPUFeature::AVX2))
+        EXPECT(CPUFeatures::has(CPUFeature::AVX));
+}
+
+static int scalar_implementation(int value)
+{
+    return value + 1;
+}
+
+static int preferred_implementation(int value)
+{
+    return value + 2;
+}
+
+TEST_CASE(multiversion_picks_first_supported_candidate)
+{
+    MultiVersionFunction<int(int)> function {
+        { CPUFeature::None, preferred_implementation },
+        { CPUFeature::None, scalar_implementation },
+    };
+    EXPECT_EQ(function(1), 3);
+    EXPECT_EQ(function(5), 7);
+}
+
+TEST_CASE(multiversion_skips_unsupported_candidate)
+{
+    // No real CPU reports this made-up feature bit, so selection must fall
+    // through to the scalar candidate.
+    auto unsupported_feature = static_cast<CPUFeature>(1u << 31);
+    MultiVersionFunction<int(int)> function {
+        { unsupported_feature, preferred_implementation },
+        { CPUFeature::None, scalar_implementation },
+    };
+    EXPECT_EQ(function(1), 2);
+}
@@ -148,6 +148,55 @@ TEST_CASE(basic_remove)
     EXPECT_EQ(map.size(), 0u);
 }
 
+TEST_CASE(ordered_map_iteration_order)
+{
+    OrderedHashMap<String, int> map;
+    map.set("one", 1);
+    map.set("two", 2);
+    map.set("three", 3);
+
+    Vector<String> keys;
+    for (auto& it : map)
+        keys.append(it.key);
+    EXPECT_EQ(keys.size(), 3u);
+    EXPECT_EQ(keys[0], "one");
+    EXPECT_EQ(keys[1], "two");
+    EXPECT_EQ(keys[2], "three");
+
+    // Overwriting an entry keeps its original position.
+    EXPECT_EQ(map.set("two", 22), AK::HashSetResult::ReplacedExistingEntry);
+    keys.clear();
+    for (auto& it : map)
+        keys.append(it.key);
+    EXPECT_EQ(keys[1], "two");
+    EXPECT_EQ(map.get("two").value(), 22);
+
+    // Removal keeps the order of the remaining entries.
+    EXPECT_EQ(map.remove("two"), true);
+    keys.clear();
+    for (auto& it : map)
+        keys.append(it.key);
+    EXPECT_EQ(keys.size(), 2u);
+    EXPECT_EQ(keys[0], "one");
+    EXPECT_EQ(keys[1], "three");
+}
+
+TEST_CASE(ordered_map_rehash_preserves_order)
+{
+    OrderedHashMap<int, int> map;
+    for (int i = 0; i < 999; ++i)
+        map.set(i, i * 2);
+    EXPECT_EQ(map.size(), 999u);
+
+    int expected_key = 0;
+    for (auto& it : map) {
+        EXPECT_EQ(it.key, expected_key);
+        EXPECT_EQ(it.value, expected_key * 2);
+        ++expected_key;
+    }
+    EXPECT_EQ(expected_key, 999);
+}
+
 TEST_CASE(basic_contains)
 {
     HashMap<int, int> map;
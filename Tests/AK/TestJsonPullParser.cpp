@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/JsonPullParser.h>
+
+using Event = JsonPullParser::Event;
+
+TEST_CASE(scalars)
+{
+    {
+        JsonPullParser parser { "42" };
+        EXPECT_EQ(parser.next(), Event::Number);
+        EXPECT_EQ(parser.token_as_integer().value(), 42);
+        EXPECT_EQ(parser.next(), Event::Eof);
+    }
+    {
+        JsonPullParser parser { "\"hello\"" };
+        EXPECT_EQ(parser.next(), Event::String);
+        EXPECT_EQ(parser.token(), "hello");
+        EXPECT(!parser.token_has_escapes());
+        EXPECT_EQ(parser.next(), Event::Eof);
+    }
+    {
+        JsonPullParser parser { "true" };
+        EXPECT_EQ(parser.next(), Event::True);
+        EXPECT_EQ(parser.next(), Event::Eof);
+    }
+    {
+        JsonPullParser parser { "null" };
+        EXPECT_EQ(parser.next(), Event::Null);
+        EXPECT_EQ(parser.next(), Event::Eof);
+    }
+}
+
+TEST_CASE(object_events)
+{
+    JsonPullParser parser { "{ \"name\": \"anon\", \"uid\": 100, \"admin\": false }" };
+    EXPECT_EQ(parser.next(), Event::ObjectStart);
+
+    EXPECT_EQ(parser.next(), Event::Key);
+    EXPECT_EQ(parser.token(), "name");
+    EXPECT_EQ(parser.next(), Event::String);
+    EXPECT_EQ(parser.token(), "anon");
+
+    EXPECT_EQ(parser.next(), Event::Key);
+    EXPECT_EQ(parser.token(), "uid");
+    EXPECT_EQ(parser.next(), Event::Number);
+    EXPECT_EQ(parser.token_as_integer().value(), 100);
+
+    EXPECT_EQ(parser.next(), Event::Key);
+    EXPECT_EQ(parser.token(), "admin");
+    EXPECT_EQ(parser.next(), Event::False);
+
+    EXPECT_EQ(parser.next(), Event::ObjectEnd);
+    EXPECT_EQ(parser.next(), Event::Eof);
+}
+
+TEST_CASE(nested_containers)
+{
+    JsonPullParser parser { "[ { \"values\": [1, 2] }, [] ]" };
+    EXPECT_EQ(parser.next(), Event::ArrayStart);
+    EXPECT_EQ(parser.next(), Event::ObjectStart);
+    EXPECT_EQ(parser.next(), Event::Key);
+    EXPECT_EQ(parser.next(), Event::ArrayStart);
+    EXPECT_EQ(parser.next(), Event::Number);
+    EXPECT_EQ(parser.next(), Event::Number);
+    EXPECT_EQ(parser.next(), Event::ArrayEnd);
+    EXPECT_EQ(parser.next(), Event::ObjectEnd);
+    EXPECT_EQ(parser.next(), Event::ArrayStart);
+    EXPECT_EQ(parser.next(), Event::ArrayEnd);
+    EXPECT_EQ(parser.next(), Event::ArrayEnd);
+    EXPECT_EQ(parser.next(), Event::Eof);
+}
+
+TEST_CASE(string_escapes)
+{
+    JsonPullParser parser { "\"a\\nb\\u0041\"" };
+    EXPECT_EQ(parser.next(), Event::String);
+    EXPECT(parser.token_has_escapes());
+    EXPECT_EQ(parser.decode_token(), "a\nbA");
+}
+
+TEST_CASE(numbers)
+{
+    JsonPullParser parser { "[-17, 3.5, 2e3]" };
+    EXPECT_EQ(parser.next(), Event::ArrayStart);
+    EXPECT_EQ(parser.next(), Event::Number);
+    EXPECT_EQ(parser.token_as_integer().value(), -17);
+    EXPECT_EQ(parser.next(), Event::Number);
+    EXPECT(!parser.token_as_integer().has_value());
+    EXPECT_EQ(parser.token_as_double().value(), 3.5);
+    EXPECT_EQ(parser.next(), Event::Number);
+    EXPECT_EQ(parser.token_as_double().value(), 2000.0);
+    EXPECT_EQ(parser.next(), Event::ArrayEnd);
+}
+
+TEST_CASE(skip_value)
+{
+    JsonPullParser parser { "{ \"ignored\": { \"deep\": [1, {}] }, \"wanted\": 1 }" };
+    EXPECT_EQ(parser.next(), Event::ObjectStart);
+    EXPECT_EQ(parser.next(), Event::Key);
+    EXPECT_EQ(parser.token(), "ignored");
+    EXPECT(parser.skip_value());
+    EXPECT_EQ(parser.next(), Event::Key);
+    EXPECT_EQ(parser.token(), "wanted");
+    EXPECT_EQ(parser.next(), Event::Number);
+    EXPECT_EQ(parser.next(), Event::ObjectEnd);
+    EXPECT_EQ(parser.next(), Event::Eof);
+}
+
+TEST_CASE(malformed_documents)
+{
+    EXPECT_EQ((JsonPullParser { "{" }).next(), Event::ObjectStart);
+    {
+        JsonPullParser parser { "{ \"a\": }" };
+        EXPECT_EQ(parser.next(), Event::ObjectStart);
+        EXPECT_EQ(parser.next(), Event::Key);
+        EXPECT_EQ(parser.next(), Event::Error);
+        // The parser stays in the error state once it has failed.
+        EXPECT_EQ(parser.next(), Event::Error);
+    }
+    {
+        JsonPullParser parser { "[1, ]" };
+        EXPECT_EQ(parser.next(), Event::ArrayStart);
+        EXPECT_EQ(parser.next(), Event::Number);
+        EXPECT_EQ(parser.next(), Event::Error);
+    }
+    {
+        JsonPullParser parser { "1 2" };
+        EXPECT_EQ(parser.next(), Event::Number);
+        EXPECT_EQ(parser.next(), Event::Error);
+    }
+}
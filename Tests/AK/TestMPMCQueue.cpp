@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/MPMCQueue.h>
+#include <AK/String.h>
+
+TEST_CASE(basic)
+{
+    MPMCQueue<int, 4> ints;
+    EXPECT(ints.is_empty());
+
+    EXPECT(ints.try_enqueue(1));
+    EXPECT(ints.try_enqueue(2));
+    EXPECT(ints.try_enqueue(3));
+    EXPECT(ints.try_enqueue(4));
+    EXPECT(!ints.try_enqueue(5));
+    EXPECT_EQ(ints.size(), 4u);
+
+    int value = 0;
+    EXPECT(ints.try_dequeue(value));
+    EXPECT_EQ(value, 1);
+    EXPECT(ints.try_dequeue(value));
+    EXPECT_EQ(value, 2);
+
+    EXPECT(ints.try_enqueue(5));
+    EXPECT(ints.try_dequeue(value));
+    EXPECT_EQ(value, 3);
+    EXPECT(ints.try_dequeue(value));
+    EXPECT_EQ(value, 4);
+    EXPECT(ints.try_dequeue(value));
+    EXPECT_EQ(value, 5);
+    EXPECT(ints.is_empty());
+    EXPECT(!ints.try_dequeue(value));
+}
+
+TEST_CASE(many_laps)
+{
+    MPMCQueue<int, 2> ints;
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT(ints.try_enqueue(i));
+        int value = -1;
+        EXPECT(ints.try_dequeue(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT(ints.is_empty());
+}
+
+TEST_CASE(complex_type)
+{
+    MPMCQueue<String, 4> strings;
+    EXPECT(strings.try_enqueue("ABC"));
+    EXPECT(strings.try_enqueue("DEF"));
+
+    String value;
+    EXPECT(strings.try_dequeue(value));
+    EXPECT_EQ(value, "ABC");
+    EXPECT(strings.try_dequeue(value));
+    EXPECT_EQ(value, "DEF");
+    EXPECT(!strings.try_dequeue(value));
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/SPSCQueue.h>
+#include <AK/String.h>
+
+TEST_CASE(basic)
+{
+    SPSCQueue<int, 4> ints;
+    EXPECT(ints.is_empty());
+    EXPECT(!ints.is_full());
+
+    EXPECT(ints.try_enqueue(1));
+    EXPECT(ints.try_enqueue(2));
+    EXPECT(ints.try_enqueue(3));
+    EXPECT(ints.try_enqueue(4));
+    EXPECT(ints.is_full());
+    EXPECT(!ints.try_enqueue(5));
+
+    int value = 0;
+    EXPECT(ints.try_dequeue(value));
+    EXPECT_EQ(value, 1);
+    EXPECT(ints.try_dequeue(value));
+    EXPECT_EQ(value, 2);
+    EXPECT_EQ(ints.size(), 2u);
+
+    EXPECT(ints.try_enqueue(5));
+    EXPECT(ints.try_dequeue(value));
+    EXPECT_EQ(value, 3);
+    EXPECT(ints.try_dequeue(value));
+    EXPECT_EQ(value, 4);
+    EXPECT(ints.try_dequeue(value));
+    EXPECT_EQ(value, 5);
+    EXPECT(ints.is_empty());
+    EXPECT(!ints.try_dequeue(value));
+}
+
+TEST_CASE(wrap_around)
+{
+    SPSCQueue<int, 2> ints;
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT(ints.try_enqueue(i));
+        int value = -1;
+        EXPECT(ints.try_dequeue(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT(ints.is_empty());
+}
+
+TEST_CASE(complex_type)
+{
+    SPSCQueue<String, 4> strings;
+    EXPECT(strings.try_enqueue("ABC"));
+    EXPECT(strings.try_enqueue("DEF"));
+
+    String value;
+    EXPECT(strings.try_dequeue(value));
+    EXPECT_EQ(value, "ABC");
+    EXPECT(strings.try_dequeue(value));
+    EXPECT_EQ(value, "DEF");
+    EXPECT(!strings.try_dequeue(value));
+}
+
+TEST_CASE(destructor_destroys_undequeued_elements)
+{
+    struct Counter {
+        explicit Counter(unsigned& count)
+            : m_count(&count)
+        {
+        }
+        Counter(Counter&& other)
+            : m_count(exchange(other.m_count, nullptr))
+        {
+        }
+        Counter& operator=(Counter&& other)
+        {
+            if (this != &other)
+                m_count = exchange(other.m_count, nullptr);
+            return *this;
+        }
+        ~Counter()
+        {
+            if (m_count)
+                ++*m_count;
+        }
+        unsigned* m_count { nullptr };
+    };
+
+    unsigned destroyed = 0;
+    {
+        SPSCQueue<Counter, 4> queue;
+        EXPECT(queue.try_enqueue(Counter { destroyed }));
+        EXPECT(queue.try_enqueue(Counter { destroyed }));
+        EXPECT(queue.try_enqueue(Counter { destroyed }));
+    }
+    EXPECT_EQ(destroyed, 3u);
+}
@@ -39,6 +39,15 @@ TEST_CASE(construct_contents)
     EXPECT(test_string != "ABCDEFG");
 }
 
+TEST_CASE(single_character_strings_are_shared)
+{
+    String a = "x";
+    String b = String("x", 1);
+    EXPECT_EQ(a, "x");
+    EXPECT_EQ(a.length(), 1u);
+    EXPECT_EQ(a.impl(), b.impl());
+}
+
 TEST_CASE(compare)
 {
     String test_string = "ABCDEF";
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/String.h>
+#include <AK/StringBuilder.h>
+
+TEST_CASE(basic_append)
+{
+    StringBuilder builder;
+    builder.append("abc");
+    builder.append('d');
+    builder.append("efg", 3);
+    EXPECT_EQ(builder.length(), 7u);
+    EXPECT_EQ(builder.string_view(), "abcdefg");
+    EXPECT_EQ(builder.build(), "abcdefg");
+}
+
+TEST_CASE(chunked_append)
+{
+    StringBuilder builder(StringBuilder::OutputMode::Chunked);
+    builder.append("abc");
+    builder.append('d');
+    EXPECT_EQ(builder.length(), 4u);
+    EXPECT_EQ(builder.build(), "abcd");
+}
+
+TEST_CASE(chunked_append_large)
+{
+    // Enough data to span several chunks, with appends that straddle
+    // chunk boundaries.
+    StringBuilder builder(StringBuilder::OutputMode::Chunked);
+    StringBuilder expected;
+    for (size_t i = 0; i < 100000; ++i) {
+        auto piece = String::number(i);
+        builder.append(piece);
+        builder.append(',');
+        expected.append(piece);
+        expected.append(',');
+    }
+    EXPECT_EQ(builder.length(), expected.length());
+    EXPECT_EQ(builder.build(), expected.build());
+}
+
+TEST_CASE(chunked_trim)
+{
+    StringBuilder builder(StringBuilder::OutputMode::Chunked);
+    builder.append("abcdef");
+    builder.trim(2);
+    EXPECT_EQ(builder.build(), "abcd");
+}
+
+TEST_CASE(chunked_clear)
+{
+    StringBuilder builder(StringBuilder::OutputMode::Chunked);
+    builder.append("abc");
+    builder.clear();
+    EXPECT(builder.is_empty());
+    builder.append("def");
+    EXPECT_EQ(builder.build(), "def");
+}
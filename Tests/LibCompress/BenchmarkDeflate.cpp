@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/ByteBuffer.h>
+#include <LibCompress/Deflate.h>
+
+// Log-like data: lots of repeated words with some variation, so the
+// compressor gets realistic back-reference and literal mixes instead of
+// pure noise or pure repetition. Dividing the data size by the reported
+// benchmark time gives MB/s.
+static ByteBuffer make_compressible_data(size_t size)
+{
+    static constexpr StringView words[] {
+        "0x1234abcd, ",
+        "error, ",
+        "GET /index.html 200 OK, ",
+        "some less frequent filler text, ",
+        "WindowServer: ",
+        "127.0.0.1 - - [1/Jan/2021:00:00:00] ",
+    };
+
+    auto buffer = ByteBuffer::create_uninitialized(size);
+    u32 state = 0x12345678;
+    size_t offset = 0;
+    while (offset < size) {
+        state = state * 1664525 + 1013904223;
+        auto& word = words[(state >> 16) % (sizeof(words) / sizeof(words[0]))];
+        auto length = min(word.length(), size - offset);
+        __builtin_memcpy(buffer.data() + offset, word.characters_without_null_termination(), length);
+        offset += length;
+    }
+    return buffer;
+}
+
+BENCHMARK_CASE(deflate_fast_8mb)
+{
+    auto data = make_compressible_data(8 * MiB);
+    auto compressed = Compress::DeflateCompressor::compress_all(data, Compress::DeflateCompressor::CompressionLevel::FAST);
+    EXPECT(compressed.has_value());
+}
+
+BENCHMARK_CASE(deflate_good_8mb)
+{
+    auto data = make_compressible_data(8 * MiB);
+    auto compressed = Compress::DeflateCompressor::compress_all(data, Compress::DeflateCompressor::CompressionLevel::GOOD);
+    EXPECT(compressed.has_value());
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Array.h>
+#include <AK/ByteBuffer.h>
+#include <LibCompress/Lz4.h>
+
+static void roundtrip(ReadonlyBytes data)
+{
+    const auto compressed = Compress::Lz4::compress_all(data);
+    EXPECT(compressed.has_value());
+    const auto decompressed = Compress::Lz4::decompress_all(compressed.value());
+    EXPECT(decompressed.has_value());
+    EXPECT(decompressed.value().bytes() == data);
+}
+
+TEST_CASE(lz4_decompress_simple)
+{
+    // "LZ4B" container holding one block: 11 literals ("abcabcabcab"),
+    // a match of 12 at offset 3, then the final 5 literals.
+    const Array<u8, 28> compressed {
+        'L', 'Z', '4', 'B', 0x1c, 0x00, 0x00, 0x00, 0xb8, 'a', 'b', 'c',
+        'a', 'b', 'c', 'a', 'b', 'c', 'a', 'b', 0x03, 0x00, 0x50, 'c',
+        'a', 'b', 'c', 'a'
+    };
+
+    const u8 uncompressed[] = "abcabcabcabcabcabcabcabcabca";
+
+    const auto decompressed = Compress::Lz4::decompress_all(compressed);
+    EXPECT(decompressed.has_value());
+    EXPECT(decompressed.value().bytes() == (ReadonlyBytes { uncompressed, sizeof(uncompressed) - 1 }));
+}
+
+TEST_CASE(lz4_round_trip_repetitive)
+{
+    ByteBuffer data;
+    for (size_t i = 0; i < 1000; ++i)
+        data.append("well hello friends, ", 20);
+    roundtrip(data);
+}
+
+TEST_CASE(lz4_round_trip_incompressible)
+{
+    // Pseudo-random data has no 4-byte matches, so every byte comes out
+    // as a literal and the block must still round-trip.
+    ByteBuffer data = ByteBuffer::create_uninitialized(64 * KiB);
+    u32 state = 0x12345678;
+    for (size_t i = 0; i < data.size(); ++i) {
+        state = state * 1664525 + 1013904223;
+        data[i] = state >> 24;
+    }
+    roundtrip(data);
+}
+
+TEST_CASE(lz4_round_trip_tiny_inputs)
+{
+    // Inputs shorter than the 12-byte match limit are all-literal blocks.
+    roundtrip(ReadonlyBytes {});
+    roundtrip("a"sv.bytes());
+    roundtrip("hello friends"sv.bytes());
+}
+
+TEST_CASE(lz4_round_trip_chunked)
+{
+    // Compress in fixed-size chunks like a streaming producer would and
+    // check that decompress_all() reassembles the original data.
+    ByteBuffer data;
+    for (size_t i = 0; i < 10000; ++i)
+        data.append("streaming compression test data, ", 33);
+
+    constexpr size_t chunk_size = 64 * KiB;
+    ByteBuffer compressed = ByteBuffer::create_uninitialized(Compress::Lz4::maximum_compressed_chunk_size(chunk_size));
+    ByteBuffer container;
+
+    u8 magic[4];
+    container.append(magic, Compress::Lz4::write_chunked_header({ magic, sizeof(magic) }));
+    for (size_t offset = 0; offset < data.size(); offset += chunk_size) {
+        auto chunk = data.bytes().slice(offset, min(chunk_size, data.size() - offset));
+        auto chunk_output_size = Compress::Lz4::compress_chunk(chunk, compressed.bytes());
+        EXPECT(chunk_output_size.has_value());
+        container.append(compressed.data(), chunk_output_size.value());
+    }
+
+    EXPECT(Compress::Lz4::is_likely_compressed(container));
+    const auto decompressed = Compress::Lz4::decompress_all(container);
+    EXPECT(decompressed.has_value());
+    EXPECT(decompressed.value().bytes() == data.bytes());
+}
+
+BENCHMARK_CASE(lz4_round_trip_8mb)
+{
+    // Compare against the deflate benchmarks next door; LZ4 should be an
+    // order of magnitude faster in both directions.
+    ByteBuffer data = ByteBuffer::create_uninitialized(8 * MiB);
+    u32 state = 0x12345678;
+    for (size_t i = 0; i < data.size(); ++i) {
+        state = state * 1664525 + 1013904223;
+        data[i] = (state >> 16) & 0x3; // few distinct bytes, so there are matches to find
+    }
+    const auto compressed = Compress::Lz4::compress_all(data);
+    EXPECT(compressed.has_value());
+    const auto decompressed = Compress::Lz4::decompress_all(compressed.value());
+    EXPECT(decompressed.value().bytes() == data.bytes());
+}
+
+TEST_CASE(lz4_reject_malformed)
+{
+    // Offset pointing before the start of the output.
+    const Array<u8, 16> bad_offset {
+        'L', 'Z', '4', 'B', 0x0a, 0x00, 0x00, 0x00, 0x12, 'a', 0xff, 0x00,
+        0x00, 'b', 'c', 'd'
+    };
+    EXPECT(!Compress::Lz4::decompress_all(bad_offset).has_value());
+
+    // Declared uncompressed size doesn't match the block contents.
+    const Array<u8, 10> bad_size {
+        'L', 'Z', '4', 'B', 0xff, 0x00, 0x00, 0x00, 0x10, 'a'
+    };
+    EXPECT(!Compress::Lz4::decompress_all(bad_size).has_value());
+
+    EXPECT(!Compress::Lz4::decompress_all("not lz4 data"sv.bytes()).has_value());
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/ByteBuffer.h>
+#include <LibCrypto/Hash/MD5.h>
+#include <LibCrypto/Hash/SHA1.h>
+#include <LibCrypto/Hash/SHA2.h>
+
+static ByteBuffer make_data(size_t size)
+{
+    auto buffer = ByteBuffer::create_uninitialized(size);
+    u32 state = 0x12345678;
+    for (size_t i = 0; i < size; ++i) {
+        state = state * 1664525 + 1013904223;
+        buffer[i] = state >> 24;
+    }
+    return buffer;
+}
+
+// The bulk update() path hashes whole blocks straight out of the message,
+// so make sure feeding the data in awkward chunk sizes (smaller than,
+// equal to and straddling block boundaries) gives the same digest as one
+// big update.
+template<typename HashT>
+static void test_chunked_updates_match()
+{
+    const auto data = make_data(64 * KiB + 3);
+
+    HashT whole;
+    whole.update(data.data(), data.size());
+    const auto expected = whole.digest();
+
+    for (size_t chunk_size : { 1, 7, 63, 64, 65, 128, 1000 }) {
+        HashT chunked;
+        size_t offset = 0;
+        while (offset < data.size()) {
+            auto length = min(chunk_size, data.size() - offset);
+            chunked.update(data.data() + offset, length);
+            offset += length;
+        }
+        const auto digest = chunked.digest();
+        EXPECT(__builtin_memcmp(digest.immutable_data(), expected.immutable_data(), expected.data_length()) == 0);
+    }
+}
+
+TEST_CASE(chunked_updates_match_sha1)
+{
+    test_chunked_updates_match<Crypto::Hash::SHA1>();
+}
+
+TEST_CASE(chunked_updates_match_sha256)
+{
+    test_chunked_updates_match<Crypto::Hash::SHA256>();
+}
+
+TEST_CASE(chunked_updates_match_sha512)
+{
+    test_chunked_updates_match<Crypto::Hash::SHA512>();
+}
+
+TEST_CASE(chunked_updates_match_md5)
+{
+    test_chunked_updates_match<Crypto::Hash::MD5>();
+}
+
+// Dividing the data size by the reported benchmark time gives MB/s.
+BENCHMARK_CASE(sha1_8mb)
+{
+    const auto data = make_data(8 * MiB);
+    Crypto::Hash::SHA1 sha;
+    sha.update(data.data(), data.size());
+    (void)sha.digest();
+}
+
+BENCHMARK_CASE(sha256_8mb)
+{
+    const auto data = make_data(8 * MiB);
+    Crypto::Hash::SHA256 sha;
+    sha.update(data.data(), data.size());
+    (void)sha.digest();
+}
+
+BENCHMARK_CASE(sha512_8mb)
+{
+    const auto data = make_data(8 * MiB);
+    Crypto::Hash::SHA512 sha;
+    sha.update(data.data(), data.size());
+    (void)sha.digest();
+}
+
+BENCHMARK_CASE(md5_8mb)
+{
+    const auto data = make_data(8 * MiB);
+    Crypto::Hash::MD5 md5;
+    md5.update(data.data(), data.size());
+    (void)md5.digest();
+}
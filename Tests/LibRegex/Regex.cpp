@@ -442,6 +442,43 @@ TEST_CASE(a_star)
     EXPECT_EQ(result.matches.at(31).view.length(), 0u);
 }
 
+TEST_CASE(starting_char_prefilter)
+{
+    // Patterns that can only start with one specific character let the
+    // matcher skip ahead with memchr(); make sure that shortcut agrees
+    // with the bytecode interpreter.
+    {
+        Regex<PosixExtended> re("foo[0-9]+");
+        EXPECT_EQ(re.starting_char.has_value(), true);
+        EXPECT_EQ(re.starting_char.value(), (u32)'f');
+        RegexResult result;
+        EXPECT_EQ(re.search("ffffle foo1 fffoo23 barfoo456", result), true);
+        EXPECT_EQ(result.count, 3u);
+        EXPECT_EQ(result.matches.at(0).view, "foo1");
+        EXPECT_EQ(result.matches.at(2).view, "foo456");
+    }
+    {
+        Regex<PosixExtended> re("^banana");
+        EXPECT_EQ(re.starting_char.has_value(), true);
+        RegexResult result;
+        EXPECT_EQ(re.search("not a banana", result), false);
+        EXPECT_EQ(re.search("banana boat", result), true);
+    }
+    {
+        Regex<PosixExtended> re("cat", PosixFlags::Insensitive);
+        RegexResult result;
+        EXPECT_EQ(re.search("A dog, a CaT and a Catfish", result), true);
+        EXPECT_EQ(result.count, 2u);
+    }
+    {
+        // Alternations don't have a single starting character.
+        Regex<PosixExtended> re("cat|dog");
+        EXPECT_EQ(re.starting_char.has_value(), false);
+        RegexResult result;
+        EXPECT_EQ(re.search("hot dog", result), true);
+    }
+}
+
 TEST_CASE(simple_period_end_benchmark)
 {
     Regex<PosixExtended> re("hello.$");
@@ -735,3 +735,12 @@ TEST_CASE(common_table_expression)
     validate("WITH table (column1, column2) AS (SELECT * FROM table) DELETE FROM table;", { false, { { "table", { "column1", "column2" } } } });
     validate("WITH RECURSIVE table AS (SELECT * FROM table) DELETE FROM table;", { true, { { "table", {} } } });
 }
+
+BENCHMARK_CASE(parse_insert_statements)
+{
+    // A metrics-store-like workload: lots of small INSERTs.
+    for (size_t i = 0; i < 10'000; ++i) {
+        auto result = parse("INSERT INTO metrics (timestamp, name, value) VALUES (1620000000, 'cpu_usage', 42.5);");
+        EXPECT(!result.is_error());
+    }
+}
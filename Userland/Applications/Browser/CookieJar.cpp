@@ -6,13 +6,58 @@
 
 #include "CookieJar.h"
 #include <AK/IPv4Address.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
 #include <AK/StringBuilder.h>
 #include <AK/URL.h>
 #include <AK/Vector.h>
+#include <LibCore/File.h>
+#include <LibCore/StandardPaths.h>
+#include <LibCore/Timer.h>
 #include <LibWeb/Cookie/ParsedCookie.h>
 
 namespace Browser {
 
+static constexpr int cookie_save_delay_ms = 5'000;
+
+static String cookies_file_path()
+{
+    return String::formatted("{}/cookies.json", Core::StandardPaths::config_directory());
+}
+
+// A cookie can only ever match a request host that has the cookie's domain as
+// a suffix at a label boundary (or is that domain itself), so those suffixes
+// are the only index buckets worth looking at. IP addresses only ever match
+// exactly.
+template<typename Callback>
+static void for_each_domain_suffix(const String& canonicalized_domain, Callback callback)
+{
+    callback(canonicalized_domain);
+
+    if (AK::IPv4Address::from_string(canonicalized_domain).has_value())
+        return;
+
+    for (size_t i = 0; i < canonicalized_domain.length(); ++i) {
+        if (canonicalized_domain[i] == '.')
+            callback(canonicalized_domain.substring(i + 1));
+    }
+}
+
+CookieJar::CookieJar()
+{
+    load_cookies();
+    m_save_timer = Core::Timer::create_single_shot(cookie_save_delay_ms, [this] {
+        save_cookies();
+    });
+}
+
+CookieJar::~CookieJar()
+{
+    if (m_save_timer->is_active())
+        save_cookies();
+}
+
 String CookieJar::get_cookie(const URL& url, Web::Cookie::Source source)
 {
     purge_expired_cookies();
@@ -220,6 +265,7 @@ void CookieJar::store_cookie(const Web::Cookie::ParsedCookie& parsed_cookie, con
 
     // 11. If the cookie store contains a cookie with the same name, domain, and path as the newly created cookie:
     CookieStorageKey key { cookie.name, cookie.domain, cookie.path };
+    bool should_save = cookie.persistent;
 
     if (auto old_cookie = m_cookies.find(key); old_cookie != m_cookies.end()) {
         // If the newly created cookie was received from a "non-HTTP" API and the old-cookie's http-only-flag is set, abort these
@@ -231,11 +277,17 @@ void CookieJar::store_cookie(const Web::Cookie::ParsedCookie& parsed_cookie, con
         cookie.creation_time = old_cookie->value.creation_time;
 
         // Remove the old-cookie from the cookie store.
+        should_save |= old_cookie->value.persistent;
+        unindex_cookie(old_cookie->key);
         m_cookies.remove(old_cookie);
     }
 
     // 12. Insert the newly created cookie into the cookie store.
     m_cookies.set(key, move(cookie));
+    index_cookie(key);
+
+    if (should_save)
+        schedule_save();
 }
 
 Vector<Web::Cookie::Cookie*> CookieJar::get_matching_cookies(const URL& url, const String& canonicalized_domain, Web::Cookie::Source source)
@@ -247,42 +299,52 @@ Vector<Web::Cookie::Cookie*> CookieJar::get_matching_cookies(const URL& url, con
     // 1. Let cookie-list be the set of cookies from the cookie store that meets all of the following requirements:
     Vector<Web::Cookie::Cookie*> cookie_list;
 
-    for (auto& cookie : m_cookies) {
-        // Either: The cookie's host-only-flag is true and the canonicalized request-host is identical to the cookie's domain.
-        // Or: The cookie's host-only-flag is false and the canonicalized request-host domain-matches the cookie's domain.
-        bool is_host_only_and_has_identical_domain = cookie.value.host_only && (canonicalized_domain == cookie.value.domain);
-        bool is_not_host_only_and_domain_matches = !cookie.value.host_only && domain_matches(canonicalized_domain, cookie.value.domain);
-        if (!is_host_only_and_has_identical_domain && !is_not_host_only_and_domain_matches)
-            continue;
-
-        // The request-uri's path path-matches the cookie's path.
-        if (!path_matches(url.path(), cookie.value.path))
-            continue;
-
-        // If the cookie's secure-only-flag is true, then the request-uri's scheme must denote a "secure" protocol.
-        if (cookie.value.secure && (url.protocol() != "https"))
-            continue;
-
-        // If the cookie's http-only-flag is true, then exclude the cookie if the cookie-string is being generated for a "non-HTTP" API.
-        if (cookie.value.http_only && (source != Web::Cookie::Source::Http))
-            continue;
+    for_each_domain_suffix(canonicalized_domain, [&](String domain_suffix) {
+        auto bucket = m_cookies_by_domain.find(domain_suffix);
+        if (bucket == m_cookies_by_domain.end())
+            return;
 
-        // 2.  The user agent SHOULD sort the cookie-list in the following order:
-        //   - Cookies with longer paths are listed before cookies with shorter paths.
-        //   - Among cookies that have equal-length path fields, cookies with earlier creation-times are listed before cookies with later creation-times.
-        cookie_list.insert_before_matching(&cookie.value, [&cookie](auto* entry) {
-            if (cookie.value.path.length() > entry->path.length()) {
-                return true;
-            } else if (cookie.value.path.length() == entry->path.length()) {
-                if (cookie.value.creation_time.timestamp() < entry->creation_time.timestamp())
+        for (auto& key : bucket->value) {
+            auto it = m_cookies.find(key);
+            VERIFY(it != m_cookies.end());
+            auto& cookie = it->value;
+
+            // Either: The cookie's host-only-flag is true and the canonicalized request-host is identical to the cookie's domain.
+            // Or: The cookie's host-only-flag is false and the canonicalized request-host domain-matches the cookie's domain.
+            bool is_host_only_and_has_identical_domain = cookie.host_only && (canonicalized_domain == cookie.domain);
+            bool is_not_host_only_and_domain_matches = !cookie.host_only && domain_matches(canonicalized_domain, cookie.domain);
+            if (!is_host_only_and_has_identical_domain && !is_not_host_only_and_domain_matches)
+                continue;
+
+            // The request-uri's path path-matches the cookie's path.
+            if (!path_matches(url.path(), cookie.path))
+                continue;
+
+            // If the cookie's secure-only-flag is true, then the request-uri's scheme must denote a "secure" protocol.
+            if (cookie.secure && (url.protocol() != "https"))
+                continue;
+
+            // If the cookie's http-only-flag is true, then exclude the cookie if the cookie-string is being generated for a "non-HTTP" API.
+            if (cookie.http_only && (source != Web::Cookie::Source::Http))
+                continue;
+
+            // 2.  The user agent SHOULD sort the cookie-list in the following order:
+            //   - Cookies with longer paths are listed before cookies with shorter paths.
+            //   - Among cookies that have equal-length path fields, cookies with earlier creation-times are listed before cookies with later creation-times.
+            cookie_list.insert_before_matching(&cookie, [&cookie](auto* entry) {
+                if (cookie.path.length() > entry->path.length()) {
                     return true;
-            }
-            return false;
-        });
-
-        // 3. Update the last-access-time of each cookie in the cookie-list to the current date and time.
-        cookie.value.last_access_time = now;
-    }
+                } else if (cookie.path.length() == entry->path.length()) {
+                    if (cookie.creation_time.timestamp() < entry->creation_time.timestamp())
+                        return true;
+                }
+                return false;
+            });
+
+            // 3. Update the last-access-time of each cookie in the cookie-list to the current date and time.
+            cookie.last_access_time = now;
+        }
+    });
 
     return cookie_list;
 }
@@ -291,14 +353,113 @@ void CookieJar::purge_expired_cookies()
 {
     time_t now = Core::DateTime::now().timestamp();
     Vector<CookieStorageKey> keys_to_evict;
+    bool evicted_persistent_cookie = false;
 
     for (const auto& cookie : m_cookies) {
-        if (cookie.value.expiry_time.timestamp() < now)
+        if (cookie.value.expiry_time.timestamp() < now) {
             keys_to_evict.append(cookie.key);
+            evicted_persistent_cookie |= cookie.value.persistent;
+        }
     }
 
-    for (const auto& key : keys_to_evict)
+    for (const auto& key : keys_to_evict) {
+        unindex_cookie(key);
         m_cookies.remove(key);
+    }
+
+    if (evicted_persistent_cookie)
+        schedule_save();
+}
+
+void CookieJar::index_cookie(const CookieStorageKey& key)
+{
+    m_cookies_by_domain.ensure(key.domain).append(key);
+}
+
+void CookieJar::unindex_cookie(const CookieStorageKey& key)
+{
+    auto bucket = m_cookies_by_domain.find(key.domain);
+    if (bucket == m_cookies_by_domain.end())
+        return;
+    bucket->value.remove_first_matching([&](auto& entry) { return entry == key; });
+    if (bucket->value.is_empty())
+        m_cookies_by_domain.remove(bucket);
+}
+
+void CookieJar::load_cookies()
+{
+    auto file_or_error = Core::File::open(cookies_file_path(), Core::OpenMode::ReadOnly);
+    if (file_or_error.is_error())
+        return;
+
+    auto json = JsonValue::from_string(file_or_error.value()->read_all());
+    if (!json.has_value() || !json->is_array())
+        return;
+
+    time_t now = Core::DateTime::now().timestamp();
+
+    json->as_array().for_each([&](const auto& value) {
+        if (!value.is_object())
+            return;
+        const auto& object = value.as_object();
+
+        Web::Cookie::Cookie cookie { object.get("name").as_string_or({}), object.get("value").as_string_or({}) };
+        cookie.creation_time = Core::DateTime::from_timestamp(object.get("creation_time").to_i64());
+        cookie.last_access_time = Core::DateTime::from_timestamp(object.get("last_access_time").to_i64());
+        cookie.expiry_time = Core::DateTime::from_timestamp(object.get("expiry_time").to_i64());
+        cookie.domain = object.get("domain").as_string_or({});
+        cookie.path = object.get("path").as_string_or({});
+        cookie.secure = object.get("secure").to_bool();
+        cookie.http_only = object.get("http_only").to_bool();
+        cookie.host_only = object.get("host_only").to_bool();
+        cookie.persistent = true;
+
+        if (cookie.expiry_time.timestamp() < now)
+            return;
+
+        CookieStorageKey key { cookie.name, cookie.domain, cookie.path };
+        m_cookies.set(key, move(cookie));
+        index_cookie(key);
+    });
+}
+
+void CookieJar::save_cookies()
+{
+    JsonArray cookies;
+
+    for (const auto& it : m_cookies) {
+        const auto& cookie = it.value;
+        if (!cookie.persistent)
+            continue;
+
+        JsonObject object;
+        object.set("name", cookie.name);
+        object.set("value", cookie.value);
+        object.set("creation_time", (i64)cookie.creation_time.timestamp());
+        object.set("last_access_time", (i64)cookie.last_access_time.timestamp());
+        object.set("expiry_time", (i64)cookie.expiry_time.timestamp());
+        object.set("domain", cookie.domain);
+        object.set("path", cookie.path);
+        object.set("secure", cookie.secure);
+        object.set("http_only", cookie.http_only);
+        object.set("host_only", cookie.host_only);
+        cookies.append(move(object));
+    }
+
+    auto file_or_error = Core::File::open(cookies_file_path(), (Core::OpenMode)(Core::OpenMode::WriteOnly | Core::OpenMode::Truncate));
+    if (file_or_error.is_error()) {
+        dbgln("CookieJar: Failed to save cookies: {}", file_or_error.error());
+        return;
+    }
+    file_or_error.value()->write(cookies.to_string());
+}
+
+void CookieJar::schedule_save()
+{
+    // Coalesce bursts of cookie updates into a single write, well off the
+    // network path.
+    if (!m_save_timer->is_active())
+        m_save_timer->start();
 }
 
 }
@@ -8,9 +8,12 @@
 
 #include <AK/HashMap.h>
 #include <AK/Optional.h>
+#include <AK/RefPtr.h>
 #include <AK/String.h>
 #include <AK/Traits.h>
+#include <AK/Vector.h>
 #include <LibCore/DateTime.h>
+#include <LibCore/Forward.h>
 #include <LibWeb/Cookie/Cookie.h>
 #include <LibWeb/Forward.h>
 
@@ -26,6 +29,9 @@ struct CookieStorageKey {
 
 class CookieJar {
 public:
+    CookieJar();
+    ~CookieJar();
+
     String get_cookie(const URL& url, Web::Cookie::Source source);
     void set_cookie(const URL& url, const Web::Cookie::ParsedCookie& parsed_cookie, Web::Cookie::Source source);
     void dump_cookies() const;
@@ -40,7 +46,25 @@ private:
     Vector<Web::Cookie::Cookie*> get_matching_cookies(const URL& url, const String& canonicalized_domain, Web::Cookie::Source source);
     void purge_expired_cookies();
 
+    void index_cookie(const CookieStorageKey&);
+    void unindex_cookie(const CookieStorageKey&);
+
+    void load_cookies();
+    void save_cookies();
+    void schedule_save();
+
     HashMap<CookieStorageKey, Web::Cookie::Cookie> m_cookies;
+
+    // Cookies can only ever match a request whose host has the cookie's
+    // domain as a suffix, so they are also filed under that domain here. A
+    // lookup then only considers the buckets for the request host's own
+    // domain suffixes instead of scanning the whole store.
+    HashMap<String, Vector<CookieStorageKey>> m_cookies_by_domain;
+
+    // Persistent cookies are saved to disk on a short timer so that a burst
+    // of Set-Cookie headers results in a single write, and the network path
+    // never waits for storage.
+    RefPtr<Core::Timer> m_save_timer;
 };
 
 }
@@ -326,9 +326,9 @@ void Tab::load(const URL& url, LoadType load_type)
     m_is_history_navigation = (load_type == LoadType::HistoryNavigation);
 
     if (m_type == Type::InProcessWebView)
-        m_page_view->load(url);
+        m_page_view->load(url, m_is_history_navigation);
     else
-        m_web_content_view->load(url);
+        m_web_content_view->load(url, m_is_history_navigation);
 }
 
 URL Tab::url() const
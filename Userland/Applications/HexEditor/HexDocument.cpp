@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "HexDocument.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+bool MemoryHexDocument::write_to_file(const String& path)
+{
+    for (auto& change : m_changes)
+        m_buffer.data()[change.key] = change.value;
+
+    int fd = open(path.characters(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (fd < 0) {
+        perror("open");
+        return false;
+    }
+
+    ssize_t nwritten = write(fd, m_buffer.data(), m_buffer.size());
+    if (nwritten < 0) {
+        perror("write");
+        close(fd);
+        return false;
+    }
+
+    close(fd);
+
+    if (static_cast<size_t>(nwritten) == m_buffer.size())
+        clear_changes();
+    return true;
+}
+
+OwnPtr<FileHexDocument> FileHexDocument::create(const String& path)
+{
+    int fd = open(path.characters(), O_RDONLY);
+    if (fd < 0)
+        return {};
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return {};
+    }
+
+    return adopt_own(*new FileHexDocument(path, fd, st.st_size));
+}
+
+FileHexDocument::FileHexDocument(String path, int fd, size_t size)
+    : m_path(move(path))
+    , m_fd(fd)
+    , m_size(size)
+{
+}
+
+FileHexDocument::~FileHexDocument()
+{
+    unmap_segments();
+    close(m_fd);
+}
+
+void FileHexDocument::unmap_segments()
+{
+    for (auto& segment : m_segments)
+        munmap(segment.data, segment.length);
+    m_segments.clear();
+}
+
+const FileHexDocument::Segment& FileHexDocument::segment_for(size_t position) const
+{
+    auto index = position / segment_size;
+
+    for (size_t i = 0; i < m_segments.size(); ++i) {
+        if (m_segments[i].index == index) {
+            if (i != 0) {
+                auto segment = m_segments.take(i);
+                m_segments.prepend(segment);
+            }
+            return m_segments.first();
+        }
+    }
+
+    if (m_segments.size() >= max_resident_segments) {
+        auto& least_recently_used = m_segments.last();
+        munmap(least_recently_used.data, least_recently_used.length);
+        m_segments.take_last();
+    }
+
+    size_t offset = index * segment_size;
+    size_t length = min(segment_size, m_size - offset);
+    auto* data = mmap(nullptr, length, PROT_READ, MAP_SHARED, m_fd, offset);
+    VERIFY(data != MAP_FAILED);
+
+    m_segments.prepend({ index, static_cast<u8*>(data), length });
+    return m_segments.first();
+}
+
+u8 FileHexDocument::base_byte(size_t position) const
+{
+    auto& segment = segment_for(position);
+    return segment.data[position % segment_size];
+}
+
+bool FileHexDocument::write_to_file(const String& path)
+{
+    if (path == m_path) {
+        // Saving in place only has to touch the bytes that changed.
+        int fd = open(path.characters(), O_WRONLY);
+        if (fd < 0) {
+            perror("open");
+            return false;
+        }
+        for (auto& change : m_changes) {
+            if (pwrite(fd, &change.value, 1, change.key) != 1) {
+                perror("pwrite");
+                close(fd);
+                return false;
+            }
+        }
+        close(fd);
+
+        unmap_segments();
+        clear_changes();
+        return true;
+    }
+
+    int fd = open(path.characters(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (fd < 0) {
+        perror("open");
+        return false;
+    }
+
+    auto chunk = ByteBuffer::create_uninitialized(segment_size);
+    for (size_t offset = 0; offset < m_size; offset += chunk.size()) {
+        size_t length = min(static_cast<size_t>(chunk.size()), m_size - offset);
+        if (pread(m_fd, chunk.data(), length, offset) != static_cast<ssize_t>(length)) {
+            perror("pread");
+            close(fd);
+            return false;
+        }
+        if (write(fd, chunk.data(), length) != static_cast<ssize_t>(length)) {
+            perror("write");
+            close(fd);
+            return false;
+        }
+    }
+
+    for (auto& change : m_changes) {
+        if (pwrite(fd, &change.value, 1, change.key) != 1) {
+            perror("pwrite");
+            close(fd);
+            return false;
+        }
+    }
+    close(fd);
+
+    // The document is now backed by the file we just wrote.
+    int new_fd = open(path.characters(), O_RDONLY);
+    if (new_fd < 0) {
+        perror("open");
+        return false;
+    }
+    unmap_segments();
+    close(m_fd);
+    m_fd = new_fd;
+    m_path = path;
+    clear_changes();
+    return true;
+}
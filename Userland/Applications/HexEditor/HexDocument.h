@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/HashMap.h>
+#include <AK/OwnPtr.h>
+#include <AK/String.h>
+#include <AK/Types.h>
+#include <AK/Vector.h>
+
+class HexDocument {
+public:
+    virtual ~HexDocument() { }
+
+    virtual size_t size() const = 0;
+    virtual bool write_to_file(const String& path) = 0;
+
+    u8 get(size_t position) const
+    {
+        auto tracked_change = m_changes.get(position);
+        if (tracked_change.has_value())
+            return tracked_change.value();
+        return base_byte(position);
+    }
+
+    void set(size_t position, u8 value) { m_changes.set(position, value); }
+    bool is_changed(size_t position) const { return m_changes.contains(position); }
+    void clear_changes() { m_changes.clear(); }
+
+protected:
+    virtual u8 base_byte(size_t position) const = 0;
+
+    // Sparse overlay of edited bytes over the read-only base data, so the
+    // cost of editing is proportional to the number of changed bytes, not
+    // to the size of the file.
+    HashMap<size_t, u8> m_changes;
+};
+
+class MemoryHexDocument final : public HexDocument {
+public:
+    explicit MemoryHexDocument(ByteBuffer buffer)
+        : m_buffer(move(buffer))
+    {
+    }
+
+    virtual size_t size() const override { return m_buffer.size(); }
+    virtual bool write_to_file(const String& path) override;
+
+protected:
+    virtual u8 base_byte(size_t position) const override { return m_buffer[position]; }
+
+private:
+    ByteBuffer m_buffer;
+};
+
+class FileHexDocument final : public HexDocument {
+public:
+    static OwnPtr<FileHexDocument> create(const String& path);
+    virtual ~FileHexDocument() override;
+
+    virtual size_t size() const override { return m_size; }
+    virtual bool write_to_file(const String& path) override;
+
+protected:
+    virtual u8 base_byte(size_t position) const override;
+
+private:
+    FileHexDocument(String path, int fd, size_t size);
+
+    struct Segment {
+        size_t index { 0 };
+        u8* data { nullptr };
+        size_t length { 0 };
+    };
+
+    static constexpr size_t segment_size = 1 * MiB;
+    static constexpr size_t max_resident_segments = 8;
+
+    const Segment& segment_for(size_t position) const;
+    void unmap_segments();
+
+    String m_path;
+    int m_fd { -1 };
+    size_t m_size { 0 };
+    // Most-recently-used first; only a handful of segments of the file are
+    // ever mapped at once, so opening a huge file costs nothing up front.
+    mutable Vector<Segment> m_segments;
+};
@@ -43,11 +43,25 @@ void HexEditor::set_readonly(bool readonly)
     m_readonly = readonly;
 }
 
-void HexEditor::set_buffer(const ByteBuffer& buffer)
+void HexEditor::set_buffer(ByteBuffer buffer)
 {
-    m_buffer = buffer;
-    set_content_length(buffer.size());
-    m_tracked_changes.clear();
+    set_document(make<MemoryHexDocument>(move(buffer)));
+}
+
+bool HexEditor::open_file(const String& path)
+{
+    auto document = FileHexDocument::create(path);
+    if (!document)
+        return false;
+
+    set_document(document.release_nonnull());
+    return true;
+}
+
+void HexEditor::set_document(OwnPtr<HexDocument> document)
+{
+    m_document = move(document);
+    set_content_length(m_document->size());
     m_position = 0;
     m_byte_position = 0;
     update();
@@ -59,10 +73,8 @@ void HexEditor::fill_selection(u8 fill_byte)
     if (!has_selection())
         return;
 
-    for (int i = m_selection_start; i <= m_selection_end; i++) {
-        m_tracked_changes.set(i, m_buffer.data()[i]);
-        m_buffer.data()[i] = fill_byte;
-    }
+    for (int i = m_selection_start; i <= m_selection_end; i++)
+        m_document->set(i, fill_byte);
 
     update();
     did_change();
@@ -70,7 +82,7 @@ void HexEditor::fill_selection(u8 fill_byte)
 
 void HexEditor::set_position(int position)
 {
-    if (position > static_cast<int>(m_buffer.size()))
+    if (position > buffer_size())
         return;
 
     m_position = position;
@@ -81,34 +93,13 @@ void HexEditor::set_position(int position)
 
 bool HexEditor::write_to_file(const String& path)
 {
-    if (m_buffer.is_empty())
+    if (!m_document || m_document->size() == 0)
         return true;
 
-    int fd = open(path.characters(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
-    if (fd < 0) {
-        perror("open");
-        return false;
-    }
-
-    int rc = ftruncate(fd, m_buffer.size());
-    if (rc < 0) {
-        perror("ftruncate");
-        return false;
-    }
-
-    ssize_t nwritten = write(fd, m_buffer.data(), m_buffer.size());
-    if (nwritten < 0) {
-        perror("write");
-        close(fd);
+    if (!m_document->write_to_file(path))
         return false;
-    }
-
-    if (static_cast<size_t>(nwritten) == m_buffer.size()) {
-        m_tracked_changes.clear();
-        update();
-    }
 
-    close(fd);
+    update();
     return true;
 }
 
@@ -119,7 +110,7 @@ bool HexEditor::copy_selected_hex_to_clipboard()
 
     StringBuilder output_string_builder;
     for (int i = m_selection_start; i <= m_selection_end; i++)
-        output_string_builder.appendff("{:02X} ", m_buffer.data()[i]);
+        output_string_builder.appendff("{:02X} ", m_document->get(i));
 
     GUI::Clipboard::the().set_plain_text(output_string_builder.to_string());
     return true;
@@ -131,8 +122,10 @@ bool HexEditor::copy_selected_text_to_clipboard()
         return false;
 
     StringBuilder output_string_builder;
-    for (int i = m_selection_start; i <= m_selection_end; i++)
-        output_string_builder.append(isprint(m_buffer.data()[i]) ? m_buffer[i] : '.');
+    for (int i = m_selection_start; i <= m_selection_end; i++) {
+        auto byte = m_document->get(i);
+        output_string_builder.append(isprint(byte) ? byte : '.');
+    }
 
     GUI::Clipboard::the().set_plain_text(output_string_builder.to_string());
     return true;
@@ -147,7 +140,7 @@ bool HexEditor::copy_selected_hex_to_clipboard_as_c_code()
     output_string_builder.appendff("unsigned char raw_data[{}] = {{\n", (m_selection_end - m_selection_start) + 1);
     output_string_builder.append("    ");
     for (int i = m_selection_start, j = 1; i <= m_selection_end; i++, j++) {
-        output_string_builder.appendff("{:#02X}", m_buffer.data()[i]);
+        output_string_builder.appendff("{:#02X}", m_document->get(i));
         if (i != m_selection_end)
             output_string_builder.append(", ");
         if ((j % 12) == 0) {
@@ -200,7 +193,7 @@ void HexEditor::mousedown_event(GUI::MouseEvent& event)
         auto byte_y = (absolute_y - hex_start_y) / line_height();
         auto offset = (byte_y * m_bytes_per_row) + byte_x;
 
-        if (offset < 0 || offset >= static_cast<int>(m_buffer.size()))
+        if (offset < 0 || offset >= buffer_size())
             return;
 
         dbgln_if(HEX_DEBUG, "HexEditor::mousedown_event(hex): offset={}", offset);
@@ -220,7 +213,7 @@ void HexEditor::mousedown_event(GUI::MouseEvent& event)
         auto byte_y = (absolute_y - text_start_y) / line_height();
         auto offset = (byte_y * m_bytes_per_row) + byte_x;
 
-        if (offset < 0 || offset >= static_cast<int>(m_buffer.size()))
+        if (offset < 0 || offset >= buffer_size())
             return;
 
         dbgln_if(HEX_DEBUG, "HexEditor::mousedown_event(text): offset={}", offset);
@@ -266,7 +259,7 @@ void HexEditor::mousemove_event(GUI::MouseEvent& event)
             auto byte_y = (absolute_y - hex_start_y) / line_height();
             auto offset = (byte_y * m_bytes_per_row) + byte_x;
 
-            if (offset < 0 || offset > static_cast<int>(m_buffer.size()))
+            if (offset < 0 || offset > buffer_size())
                 return;
 
             m_selection_end = offset;
@@ -277,7 +270,7 @@ void HexEditor::mousemove_event(GUI::MouseEvent& event)
             auto byte_x = (absolute_x - text_start_x) / character_width();
             auto byte_y = (absolute_y - text_start_y) / line_height();
             auto offset = (byte_y * m_bytes_per_row) + byte_x;
-            if (offset < 0 || offset > static_cast<int>(m_buffer.size()))
+            if (offset < 0 || offset > buffer_size())
                 return;
 
             m_selection_end = offset;
@@ -335,7 +328,7 @@ void HexEditor::keydown_event(GUI::KeyEvent& event)
     }
 
     if (event.key() == KeyCode::Key_Down) {
-        if (m_position + bytes_per_row() < static_cast<int>(m_buffer.size())) {
+        if (m_position + bytes_per_row() < buffer_size()) {
             m_position += bytes_per_row();
             m_byte_position = 0;
             scroll_position_into_view(m_position);
@@ -357,7 +350,7 @@ void HexEditor::keydown_event(GUI::KeyEvent& event)
     }
 
     if (event.key() == KeyCode::Key_Right) {
-        if (m_position + 1 < static_cast<int>(m_buffer.size())) {
+        if (m_position + 1 < buffer_size()) {
             m_position++;
             m_byte_position = 0;
             scroll_position_into_view(m_position);
@@ -390,10 +383,10 @@ void HexEditor::keydown_event(GUI::KeyEvent& event)
 void HexEditor::hex_mode_keydown_event(GUI::KeyEvent& event)
 {
     if ((event.key() >= KeyCode::Key_0 && event.key() <= KeyCode::Key_9) || (event.key() >= KeyCode::Key_A && event.key() <= KeyCode::Key_F)) {
-        if (m_buffer.is_empty())
+        if (buffer_size() == 0)
             return;
         VERIFY(m_position >= 0);
-        VERIFY(m_position < static_cast<int>(m_buffer.size()));
+        VERIFY(m_position < buffer_size());
 
         // yes, this is terrible... but it works.
         auto value = (event.key() >= KeyCode::Key_0 && event.key() <= KeyCode::Key_9)
@@ -401,12 +394,11 @@ void HexEditor::hex_mode_keydown_event(GUI::KeyEvent& event)
             : (event.key() - KeyCode::Key_A) + 0xA;
 
         if (m_byte_position == 0) {
-            m_tracked_changes.set(m_position, m_buffer.data()[m_position]);
-            m_buffer.data()[m_position] = value << 4 | (m_buffer.data()[m_position] & 0xF); // shift new value left 4 bits, OR with existing last 4 bits
+            m_document->set(m_position, value << 4 | (m_document->get(m_position) & 0xF)); // shift new value left 4 bits, OR with existing last 4 bits
             m_byte_position++;
         } else {
-            m_buffer.data()[m_position] = (m_buffer.data()[m_position] & 0xF0) | value; // save the first 4 bits, OR the new value in the last 4
-            if (m_position + 1 < static_cast<int>(m_buffer.size()))
+            m_document->set(m_position, (m_document->get(m_position) & 0xF0) | value); // save the first 4 bits, OR the new value in the last 4
+            if (m_position + 1 < buffer_size())
                 m_position++;
             m_byte_position = 0;
         }
@@ -419,17 +411,16 @@ void HexEditor::hex_mode_keydown_event(GUI::KeyEvent& event)
 
 void HexEditor::text_mode_keydown_event(GUI::KeyEvent& event)
 {
-    if (m_buffer.is_empty())
+    if (buffer_size() == 0)
         return;
     VERIFY(m_position >= 0);
-    VERIFY(m_position < static_cast<int>(m_buffer.size()));
+    VERIFY(m_position < buffer_size());
 
     if (event.code_point() == 0) // This is a control key
         return;
 
-    m_tracked_changes.set(m_position, m_buffer.data()[m_position]);
-    m_buffer.data()[m_position] = event.code_point();
-    if (m_position + 1 < static_cast<int>(m_buffer.size()))
+    m_document->set(m_position, event.code_point());
+    if (m_position + 1 < buffer_size())
         m_position++;
     m_byte_position = 0;
 
@@ -459,7 +450,7 @@ void HexEditor::paint_event(GUI::PaintEvent& event)
     painter.add_clip_rect(event.rect());
     painter.fill_rect(event.rect(), palette().color(background_role()));
 
-    if (m_buffer.is_empty())
+    if (buffer_size() == 0)
         return;
 
     painter.translate(frame_thickness(), frame_thickness());
@@ -505,11 +496,11 @@ void HexEditor::paint_event(GUI::PaintEvent& event)
     for (int i = min_row; i < max_row; i++) {
         for (int j = 0; j < bytes_per_row(); j++) {
             auto byte_position = (i * bytes_per_row()) + j;
-            if (byte_position >= static_cast<int>(m_buffer.size()))
+            if (byte_position >= buffer_size())
                 return;
 
             Color text_color = palette().color(foreground_role());
-            if (m_tracked_changes.contains(byte_position)) {
+            if (m_document->is_changed(byte_position)) {
                 text_color = Color::Red;
             }
 
@@ -537,7 +528,8 @@ void HexEditor::paint_event(GUI::PaintEvent& event)
                 text_color = palette().inactive_selection_text();
             }
 
-            auto line = String::formatted("{:02X}", m_buffer[byte_position]);
+            auto byte = m_document->get(byte_position);
+            auto line = String::formatted("{:02X}", byte);
             painter.draw_text(hex_display_rect, line, Gfx::TextAlignment::TopLeft, text_color);
 
             Gfx::IntRect text_display_rect {
@@ -553,14 +545,14 @@ void HexEditor::paint_event(GUI::PaintEvent& event)
                 painter.fill_rect(text_display_rect, palette().inactive_selection());
             }
 
-            painter.draw_text(text_display_rect, String::formatted("{:c}", isprint(m_buffer[byte_position]) ? m_buffer[byte_position] : '.'), Gfx::TextAlignment::TopLeft, text_color);
+            painter.draw_text(text_display_rect, String::formatted("{:c}", isprint(byte) ? byte : '.'), Gfx::TextAlignment::TopLeft, text_color);
         }
     }
 }
 
 void HexEditor::select_all()
 {
-    highlight(0, m_buffer.size());
+    highlight(0, buffer_size());
     set_position(0);
 }
 
@@ -573,18 +565,22 @@ void HexEditor::highlight(int start, int end)
 
 int HexEditor::find_and_highlight(ByteBuffer& needle, int start)
 {
-    if (m_buffer.is_empty())
+    if (buffer_size() == 0 || needle.is_empty() || needle.size() > static_cast<size_t>(buffer_size()))
         return -1;
 
-    auto raw_offset = memmem(m_buffer.data() + start, m_buffer.size() - start, needle.data(), needle.size());
-    if (raw_offset == NULL)
-        return -1;
+    for (int offset = start; offset <= buffer_size() - static_cast<int>(needle.size()); ++offset) {
+        size_t matched = 0;
+        while (matched < needle.size() && m_document->get(offset + matched) == needle[matched])
+            ++matched;
+        if (matched != needle.size())
+            continue;
 
-    int relative_offset = static_cast<const u8*>(raw_offset) - m_buffer.data();
-    dbgln("find_and_highlight: start={} raw_offset={} relative_offset={}", start, raw_offset, relative_offset);
+        dbgln("find_and_highlight: start={} offset={}", start, offset);
 
-    auto end_of_match = relative_offset + needle.size();
-    highlight(relative_offset, end_of_match);
+        auto end_of_match = offset + needle.size();
+        highlight(offset, end_of_match);
+        return end_of_match;
+    }
 
-    return end_of_match;
+    return -1;
 }
@@ -6,9 +6,9 @@
 
 #pragma once
 
+#include "HexDocument.h"
 #include <AK/ByteBuffer.h>
 #include <AK/Function.h>
-#include <AK/HashMap.h>
 #include <AK/NonnullOwnPtrVector.h>
 #include <AK/NonnullRefPtrVector.h>
 #include <AK/StdLibExtras.h>
@@ -29,13 +29,14 @@ public:
     bool is_readonly() const { return m_readonly; }
     void set_readonly(bool);
 
-    int buffer_size() const { return m_buffer.size(); }
-    void set_buffer(const ByteBuffer&);
+    int buffer_size() const { return m_document ? m_document->size() : 0; }
+    void set_buffer(ByteBuffer);
+    bool open_file(const String& path);
     void fill_selection(u8 fill_byte);
     bool write_to_file(const String& path);
 
     void select_all();
-    bool has_selection() const { return !(m_selection_start == -1 || m_selection_end == -1 || (m_selection_end - m_selection_start) < 0 || m_buffer.is_empty()); }
+    bool has_selection() const { return !(m_selection_start == -1 || m_selection_end == -1 || (m_selection_end - m_selection_start) < 0 || buffer_size() == 0); }
     int selection_start_offset() const { return m_selection_start; }
     bool copy_selected_text_to_clipboard();
     bool copy_selected_hex_to_clipboard();
@@ -64,11 +65,10 @@ private:
     int m_line_spacing { 4 };
     int m_content_length { 0 };
     int m_bytes_per_row { 16 };
-    ByteBuffer m_buffer;
+    OwnPtr<HexDocument> m_document;
     bool m_in_drag_select { false };
     int m_selection_start { 0 };
     int m_selection_end { 0 };
-    HashMap<int, u8> m_tracked_changes;
     int m_position { 0 };
     int m_byte_position { 0 }; // 0 or 1
     EditMode m_edit_mode { Hex };
@@ -83,6 +83,7 @@ private:
     void hex_mode_keydown_event(GUI::KeyEvent&);
     void text_mode_keydown_event(GUI::KeyEvent&);
 
+    void set_document(OwnPtr<HexDocument>);
     void set_content_length(int); // I might make this public if I add fetching data on demand.
     void update_status();
     void did_change();
@@ -57,8 +57,7 @@ KnobsWidget::KnobsWidget(TrackManager& track_manager, MainWidget& main_widget)
     m_volume_knob->on_change = [this](int value) {
         int new_volume = volume_max - value;
         if (m_change_underlying)
-            m_track_manager.current_track().set_volume(new_volume);
-        VERIFY(new_volume == m_track_manager.current_track().volume());
+            m_track_manager.set_volume(new_volume);
         m_volume_value->set_text(String::number(new_volume));
     };
 
@@ -83,8 +82,7 @@ KnobsWidget::KnobsWidget(TrackManager& track_manager, MainWidget& main_widget)
     m_wave_knob->on_change = [this](int value) {
         int new_wave = last_wave - value;
         if (m_change_underlying)
-            m_track_manager.current_track().set_wave(new_wave);
-        VERIFY(new_wave == m_track_manager.current_track().wave());
+            m_track_manager.set_wave(new_wave);
         m_wave_value->set_text(wave_strings[new_wave]);
     };
 
@@ -96,8 +94,7 @@ KnobsWidget::KnobsWidget(TrackManager& track_manager, MainWidget& main_widget)
     m_attack_knob->on_change = [this](int value) {
         int new_attack = attack_max - value;
         if (m_change_underlying)
-            m_track_manager.current_track().set_attack(new_attack);
-        VERIFY(new_attack == m_track_manager.current_track().attack());
+            m_track_manager.set_attack(new_attack);
         m_attack_value->set_text(String::number(new_attack));
     };
 
@@ -109,8 +106,7 @@ KnobsWidget::KnobsWidget(TrackManager& track_manager, MainWidget& main_widget)
     m_decay_knob->on_change = [this](int value) {
         int new_decay = decay_max - value;
         if (m_change_underlying)
-            m_track_manager.current_track().set_decay(new_decay);
-        VERIFY(new_decay == m_track_manager.current_track().decay());
+            m_track_manager.set_decay(new_decay);
         m_decay_value->set_text(String::number(new_decay));
     };
 
@@ -122,8 +118,7 @@ KnobsWidget::KnobsWidget(TrackManager& track_manager, MainWidget& main_widget)
     m_sustain_knob->on_change = [this](int value) {
         int new_sustain = sustain_max - value;
         if (m_change_underlying)
-            m_track_manager.current_track().set_sustain(new_sustain);
-        VERIFY(new_sustain == m_track_manager.current_track().sustain());
+            m_track_manager.set_sustain(new_sustain);
         m_sustain_value->set_text(String::number(new_sustain));
     };
 
@@ -135,8 +130,7 @@ KnobsWidget::KnobsWidget(TrackManager& track_manager, MainWidget& main_widget)
     m_release_knob->on_change = [this](int value) {
         int new_release = release_max - value;
         if (m_change_underlying)
-            m_track_manager.current_track().set_release(new_release);
-        VERIFY(new_release == m_track_manager.current_track().release());
+            m_track_manager.set_release(new_release);
         m_release_value->set_text(String::number(new_release));
     };
 
@@ -148,8 +142,7 @@ KnobsWidget::KnobsWidget(TrackManager& track_manager, MainWidget& main_widget)
     m_delay_knob->on_change = [this](int value) {
         int new_delay = delay_max - value;
         if (m_change_underlying)
-            m_track_manager.current_track().set_delay(new_delay);
-        VERIFY(new_delay == m_track_manager.current_track().delay());
+            m_track_manager.set_delay(new_delay);
         m_delay_value->set_text(String::number(new_delay));
     };
 }
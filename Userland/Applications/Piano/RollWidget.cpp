@@ -204,7 +204,7 @@ void RollWidget::mousemove_event(GUI::MouseEvent& event)
 
     if (m_note_drag_location.has_value()) {
         // Clear previous note
-        m_track_manager.current_track().set_roll_note(m_drag_note, m_note_drag_location.value().on_sample, m_note_drag_location.value().off_sample);
+        m_track_manager.set_roll_note(m_drag_note, m_note_drag_location.value().on_sample, m_note_drag_location.value().off_sample);
     }
 
     auto get_note_x = [&](int x0) {
@@ -227,7 +227,7 @@ void RollWidget::mousemove_event(GUI::MouseEvent& event)
 
     u32 on_sample = roll_length * (static_cast<double>(min(x0, x1)) / m_num_notes);
     u32 off_sample = (roll_length * (static_cast<double>(max(x0, x1) + 1) / m_num_notes)) - 1;
-    m_track_manager.current_track().set_roll_note(m_drag_note, on_sample, off_sample);
+    m_track_manager.set_roll_note(m_drag_note, on_sample, off_sample);
     m_note_drag_location = RollNote({ on_sample, off_sample });
 
     update();
@@ -6,18 +6,75 @@
  */
 
 #include "TrackManager.h"
+#include <AK/Format.h>
 
 TrackManager::TrackManager()
 {
-    add_track();
+    // The audio thread isn't running yet, so the first track can be added
+    // directly rather than through the message queue.
+    m_tracks.append(make<Track>(m_time));
 }
 
 TrackManager::~TrackManager()
 {
 }
 
+void TrackManager::enqueue_message(AudioMessage message)
+{
+    if (!m_messages.try_enqueue(message))
+        dbgln("TrackManager: message queue is full, dropping a message");
+}
+
+void TrackManager::apply_pending_messages()
+{
+    AudioMessage message;
+    while (m_messages.try_dequeue(message)) {
+        switch (message.type) {
+        case AudioMessage::Type::SetNote:
+            current_track().set_note(message.note, static_cast<Switch>(message.value));
+            break;
+        case AudioMessage::Type::SetRollNote:
+            current_track().set_roll_note(message.note, message.on_sample, message.off_sample);
+            break;
+        case AudioMessage::Type::SetWave:
+            current_track().set_wave(message.value);
+            break;
+        case AudioMessage::Type::CycleWave:
+            current_track().set_wave(Up);
+            break;
+        case AudioMessage::Type::SetVolume:
+            current_track().set_volume(message.value);
+            break;
+        case AudioMessage::Type::SetAttack:
+            current_track().set_attack(message.value);
+            break;
+        case AudioMessage::Type::SetDecay:
+            current_track().set_decay(message.value);
+            break;
+        case AudioMessage::Type::SetSustain:
+            current_track().set_sustain(message.value);
+            break;
+        case AudioMessage::Type::SetRelease:
+            current_track().set_release(message.value);
+            break;
+        case AudioMessage::Type::SetDelay:
+            current_track().set_delay(message.value);
+            break;
+        case AudioMessage::Type::AddTrack:
+            m_tracks.append(make<Track>(m_time));
+            break;
+        case AudioMessage::Type::NextTrack:
+            if (++m_current_track >= m_tracks.size())
+                m_current_track = 0;
+            break;
+        }
+    }
+}
+
 void TrackManager::fill_buffer(Span<Sample> buffer)
 {
+    apply_pending_messages();
+
     memset(buffer.data(), 0, buffer_size);
 
     for (size_t i = 0; i < buffer.size(); ++i) {
@@ -51,7 +108,62 @@ void TrackManager::reset()
 
 void TrackManager::set_note_current_octave(int note, Switch switch_note)
 {
-    current_track().set_note(note + octave_base(), switch_note);
+    enqueue_message({ AudioMessage::Type::SetNote, note + octave_base(), switch_note, 0, 0 });
+}
+
+void TrackManager::set_roll_note(int note, u32 on_sample, u32 off_sample)
+{
+    enqueue_message({ AudioMessage::Type::SetRollNote, note, 0, on_sample, off_sample });
+}
+
+void TrackManager::set_wave(int wave)
+{
+    enqueue_message({ AudioMessage::Type::SetWave, 0, wave, 0, 0 });
+}
+
+void TrackManager::cycle_wave()
+{
+    enqueue_message({ AudioMessage::Type::CycleWave, 0, 0, 0, 0 });
+}
+
+void TrackManager::set_volume(int volume)
+{
+    enqueue_message({ AudioMessage::Type::SetVolume, 0, volume, 0, 0 });
+}
+
+void TrackManager::set_attack(int attack)
+{
+    enqueue_message({ AudioMessage::Type::SetAttack, 0, attack, 0, 0 });
+}
+
+void TrackManager::set_decay(int decay)
+{
+    enqueue_message({ AudioMessage::Type::SetDecay, 0, decay, 0, 0 });
+}
+
+void TrackManager::set_sustain(int sustain)
+{
+    enqueue_message({ AudioMessage::Type::SetSustain, 0, sustain, 0, 0 });
+}
+
+void TrackManager::set_release(int release)
+{
+    enqueue_message({ AudioMessage::Type::SetRelease, 0, release, 0, 0 });
+}
+
+void TrackManager::set_delay(int delay)
+{
+    enqueue_message({ AudioMessage::Type::SetDelay, 0, delay, 0, 0 });
+}
+
+void TrackManager::add_track()
+{
+    enqueue_message({ AudioMessage::Type::AddTrack, 0, 0, 0, 0 });
+}
+
+void TrackManager::next_track()
+{
+    enqueue_message({ AudioMessage::Type::NextTrack, 0, 0, 0, 0 });
 }
 
 void TrackManager::set_octave(Direction direction)
@@ -71,14 +183,3 @@ void TrackManager::set_octave(int octave)
         m_octave = octave;
     }
 }
-
-void TrackManager::add_track()
-{
-    m_tracks.append(make<Track>(m_time));
-}
-
-void TrackManager::next_track()
-{
-    if (++m_current_track >= m_tracks.size())
-        m_current_track = 0;
-}
@@ -12,8 +12,36 @@
 #include <AK/Array.h>
 #include <AK/Noncopyable.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/SPSCQueue.h>
 #include <AK/Vector.h>
 
+// A state change requested by the GUI thread. Changes travel through a
+// lock-free queue and are applied by the audio thread between buffer fills,
+// so synthesis never observes half-updated state and the GUI never blocks
+// on the audio device.
+struct AudioMessage {
+    enum class Type {
+        SetNote,
+        SetRollNote,
+        SetWave,
+        CycleWave,
+        SetVolume,
+        SetAttack,
+        SetDecay,
+        SetSustain,
+        SetRelease,
+        SetDelay,
+        AddTrack,
+        NextTrack,
+    };
+
+    Type type { Type::SetNote };
+    int note { 0 };
+    int value { 0 };
+    u32 on_sample { 0 };
+    u32 off_sample { 0 };
+};
+
 class TrackManager {
     AK_MAKE_NONCOPYABLE(TrackManager);
     AK_MAKE_NONMOVABLE(TrackManager);
@@ -22,25 +50,48 @@ public:
     TrackManager();
     ~TrackManager();
 
+    // Reads from the GUI thread may briefly see a track's previous settings
+    // while a queued change hasn't been applied yet; that's fine for
+    // painting knobs and notes.
     Track& current_track() { return *m_tracks[m_current_track]; }
     Span<const Sample> buffer() const { return m_current_front_buffer; }
     int octave() const { return m_octave; }
     int octave_base() const { return (m_octave - octave_min) * 12; }
     int time() const { return m_time; }
 
+    // Audio-thread side.
     void fill_buffer(Span<Sample>);
     void reset();
     void set_should_loop(bool b) { m_should_loop = b; }
+
+    // GUI-thread side: these enqueue a message for the audio thread.
     void set_note_current_octave(int note, Switch);
-    void set_octave(Direction);
-    void set_octave(int octave);
+    void set_roll_note(int note, u32 on_sample, u32 off_sample);
+    void set_wave(int wave);
+    void cycle_wave();
+    void set_volume(int volume);
+    void set_attack(int attack);
+    void set_decay(int decay);
+    void set_sustain(int sustain);
+    void set_release(int release);
+    void set_delay(int delay);
     void add_track();
     void next_track();
 
+    // The octave only affects which notes the GUI maps keys to, so it stays
+    // plain GUI-thread state.
+    void set_octave(Direction);
+    void set_octave(int octave);
+
 private:
+    void enqueue_message(AudioMessage);
+    void apply_pending_messages();
+
     Vector<NonnullOwnPtr<Track>> m_tracks;
     size_t m_current_track { 0 };
 
+    SPSCQueue<AudioMessage, 512> m_messages;
+
     Array<Sample, sample_count> m_front_buffer;
     Array<Sample, sample_count> m_back_buffer;
     Span<Sample> m_current_front_buffer { m_front_buffer.span() };
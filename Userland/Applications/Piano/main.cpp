@@ -9,6 +9,7 @@
 #include "MainWidget.h"
 #include "TrackManager.h"
 #include <AK/Array.h>
+#include <AK/SPSCQueue.h>
 #include <LibAudio/ClientConnection.h>
 #include <LibAudio/WavWriter.h>
 #include <LibCore/EventLoop.h>
@@ -48,17 +49,20 @@ int main(int argc, char** argv)
     Optional<String> save_path;
     bool need_to_write_wav = false;
 
-    auto audio_thread = Threading::Thread::construct([&] {
-        auto audio = Core::File::construct("/dev/audio");
-        if (!audio->open(Core::OpenMode::WriteOnly)) {
-            dbgln("Can't open audio device: {}", audio->error_string());
-            return 1;
-        }
+    // Rendered buffers travel to the playback thread through this ring, so
+    // synthesis can run ahead while a device write is blocked. Keeping the
+    // ring shallow bounds the extra latency it adds.
+    SPSCQueue<Array<Sample, sample_count>, 4> sample_ring;
 
+    auto render_thread = Threading::Thread::construct([&] {
         Array<Sample, sample_count> buffer;
         while (!Core::EventLoop::current().was_exit_requested()) {
             track_manager.fill_buffer(buffer);
-            audio->write(reinterpret_cast<u8*>(buffer.data()), buffer_size);
+            while (!sample_ring.try_enqueue(buffer)) {
+                if (Core::EventLoop::current().was_exit_requested())
+                    return 0;
+                usleep(1000);
+            }
             Core::EventLoop::wake();
 
             if (need_to_write_wav) {
@@ -76,7 +80,26 @@ int main(int argc, char** argv)
         }
         return 0;
     });
-    audio_thread->start();
+    render_thread->start();
+
+    auto playback_thread = Threading::Thread::construct([&] {
+        auto audio = Core::File::construct("/dev/audio");
+        if (!audio->open(Core::OpenMode::WriteOnly)) {
+            dbgln("Can't open audio device: {}", audio->error_string());
+            return 1;
+        }
+
+        Array<Sample, sample_count> buffer;
+        while (!Core::EventLoop::current().was_exit_requested()) {
+            if (!sample_ring.try_dequeue(buffer)) {
+                usleep(1000);
+                continue;
+            }
+            audio->write(reinterpret_cast<u8*>(buffer.data()), buffer_size);
+        }
+        return 0;
+    });
+    playback_thread->start();
 
     auto main_widget_updater = Core::Timer::construct(150, [&] {
         Core::EventLoop::current().post_event(main_widget, make<Core::CustomEvent>(0));
@@ -37,16 +37,82 @@ Image::Image(const Gfx::IntSize& size)
 
 void Image::paint_into(GUI::Painter& painter, const Gfx::IntRect& dest_rect)
 {
-    float scale = (float)dest_rect.width() / (float)rect().width();
+    recomposite_dirty_tiles();
     Gfx::PainterStateSaver saver(painter);
     painter.add_clip_rect(dest_rect);
-    for (auto& layer : m_layers) {
-        if (!layer.is_visible())
-            continue;
-        auto target = dest_rect.translated(layer.location().x() * scale, layer.location().y() * scale);
-        target.set_size(layer.size().width() * scale, layer.size().height() * scale);
-        painter.draw_scaled_bitmap(target, layer.bitmap(), layer.rect(), (float)layer.opacity_percent() / 100.0f);
+    if (dest_rect.size() == m_size)
+        painter.blit(dest_rect.location(), *m_composite_cache, rect());
+    else
+        painter.draw_scaled_bitmap(dest_rect, *m_composite_cache, rect());
+}
+
+void Image::invalidate_composite_rect(const Gfx::IntRect& a_rect)
+{
+    if (!m_composite_cache)
+        return;
+    auto rect = a_rect.intersected(this->rect());
+    if (rect.is_empty())
+        return;
+    int first_column = rect.left() / composite_tile_size;
+    int last_column = rect.right() / composite_tile_size;
+    int first_row = rect.top() / composite_tile_size;
+    int last_row = rect.bottom() / composite_tile_size;
+    for (int row = first_row; row <= last_row; ++row) {
+        for (int column = first_column; column <= last_column; ++column)
+            m_dirty_tiles[row * m_tile_columns + column] = true;
+    }
+    m_has_dirty_tiles = true;
+}
+
+void Image::invalidate_composite_cache()
+{
+    m_composite_cache = nullptr;
+    m_dirty_tiles.clear();
+    m_has_dirty_tiles = false;
+}
+
+void Image::recomposite_dirty_tiles()
+{
+    if (!m_composite_cache) {
+        m_composite_cache = Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, m_size);
+        VERIFY(m_composite_cache);
+        m_tile_columns = ceil_div(m_size.width(), composite_tile_size);
+        m_tile_rows = ceil_div(m_size.height(), composite_tile_size);
+        m_dirty_tiles.clear();
+        m_dirty_tiles.resize(m_tile_columns * m_tile_rows);
+        for (size_t i = 0; i < m_dirty_tiles.size(); ++i)
+            m_dirty_tiles[i] = true;
+        m_has_dirty_tiles = true;
+    }
+
+    if (!m_has_dirty_tiles)
+        return;
+
+    Gfx::Painter painter(*m_composite_cache);
+    for (int row = 0; row < m_tile_rows; ++row) {
+        for (int column = 0; column < m_tile_columns; ++column) {
+            if (!m_dirty_tiles[row * m_tile_columns + column])
+                continue;
+            m_dirty_tiles[row * m_tile_columns + column] = false;
+            auto tile_rect = Gfx::IntRect {
+                column * composite_tile_size,
+                row * composite_tile_size,
+                composite_tile_size,
+                composite_tile_size
+            }.intersected(rect());
+            Gfx::PainterStateSaver saver(painter);
+            painter.add_clip_rect(tile_rect);
+            painter.clear_rect(tile_rect, Color());
+            for (auto& layer : m_layers) {
+                if (!layer.is_visible())
+                    continue;
+                if (!layer.relative_rect().intersects(tile_rect))
+                    continue;
+                painter.blit(layer.location(), layer.bitmap(), layer.rect(), (float)layer.opacity_percent() / 100.0f);
+            }
+        }
     }
+    m_has_dirty_tiles = false;
 }
 
 RefPtr<Image> Image::create_from_file(const String& file_path)
@@ -244,6 +310,8 @@ void Image::change_layer_index(size_t old_index, size_t new_index)
 
 void Image::did_modify_layer_stack()
 {
+    invalidate_composite_cache();
+
     for (auto* client : m_clients)
         client->image_did_modify_layer_stack();
 
@@ -280,8 +348,10 @@ void Image::remove_client(ImageClient& client)
     m_clients.remove(&client);
 }
 
-void Image::layer_did_modify_bitmap(Badge<Layer>, const Layer& layer)
+void Image::layer_did_modify_bitmap(Badge<Layer>, const Layer& layer, const Gfx::IntRect& modified_layer_rect)
 {
+    invalidate_composite_rect(modified_layer_rect.translated(layer.location()));
+
     auto layer_index = index_of(layer);
     for (auto* client : m_clients)
         client->image_did_modify_layer(layer_index);
@@ -291,6 +361,8 @@ void Image::layer_did_modify_bitmap(Badge<Layer>, const Layer& layer)
 
 void Image::layer_did_modify_properties(Badge<Layer>, const Layer& layer)
 {
+    invalidate_composite_rect(layer.relative_rect());
+
     auto layer_index = index_of(layer);
     for (auto* client : m_clients)
         client->image_did_modify_layer(layer_index);
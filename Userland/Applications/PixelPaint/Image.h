@@ -13,6 +13,7 @@
 #include <AK/Vector.h>
 #include <LibGUI/Command.h>
 #include <LibGUI/Forward.h>
+#include <LibGfx/Bitmap.h>
 #include <LibGfx/Forward.h>
 #include <LibGfx/Rect.h>
 #include <LibGfx/Size.h>
@@ -51,6 +52,11 @@ public:
     void restore_snapshot(const Image&);
 
     void paint_into(GUI::Painter&, const Gfx::IntRect& dest_rect);
+
+    // The composited layer stack is cached in a bitmap with tiled dirty
+    // tracking, so a brush stroke only recomposites the tiles it touched.
+    void invalidate_composite_rect(const Gfx::IntRect&);
+    void invalidate_composite_cache();
     void save(const String& file_path) const;
     void export_bmp(const String& file_path);
     void export_png(const String& file_path);
@@ -66,21 +72,31 @@ public:
     void add_client(ImageClient&);
     void remove_client(ImageClient&);
 
-    void layer_did_modify_bitmap(Badge<Layer>, const Layer&);
+    void layer_did_modify_bitmap(Badge<Layer>, const Layer&, const Gfx::IntRect& modified_layer_rect);
     void layer_did_modify_properties(Badge<Layer>, const Layer&);
 
     size_t index_of(const Layer&) const;
 
 private:
+    static constexpr int composite_tile_size = 64;
+
     explicit Image(const Gfx::IntSize&);
 
     void did_change();
     void did_modify_layer_stack();
 
+    void recomposite_dirty_tiles();
+
     Gfx::IntSize m_size;
     NonnullRefPtrVector<Layer> m_layers;
 
     HashTable<ImageClient*> m_clients;
+
+    RefPtr<Gfx::Bitmap> m_composite_cache;
+    Vector<bool> m_dirty_tiles;
+    int m_tile_columns { 0 };
+    int m_tile_rows { 0 };
+    bool m_has_dirty_tiles { false };
 };
 
 class ImageUndoCommand : public GUI::Command {
@@ -297,6 +297,8 @@ void ImageEditor::set_active_tool(Tool* tool)
 
 void ImageEditor::layers_did_change()
 {
+    if (m_image)
+        m_image->invalidate_composite_cache();
     update();
 }
 
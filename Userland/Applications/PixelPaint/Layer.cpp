@@ -63,9 +63,9 @@ Layer::Layer(Image& image, const Gfx::Bitmap& bitmap, const String& name)
 {
 }
 
-void Layer::did_modify_bitmap(Image& image)
+void Layer::did_modify_bitmap(Image& image, const Gfx::IntRect& modified_layer_rect)
 {
-    image.layer_did_modify_bitmap({}, *this);
+    image.layer_did_modify_bitmap({}, *this, modified_layer_rect.is_empty() ? rect() : modified_layer_rect);
 }
 
 void Layer::set_visible(bool visible)
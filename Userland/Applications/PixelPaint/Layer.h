@@ -45,7 +45,8 @@ public:
 
     void set_bitmap(Gfx::Bitmap& bitmap) { m_bitmap = bitmap; }
 
-    void did_modify_bitmap(Image&);
+    // An empty modified rect invalidates the whole layer.
+    void did_modify_bitmap(Image&, const Gfx::IntRect& modified_layer_rect = {});
 
     void set_selected(bool selected) { m_selected = selected; }
     bool is_selected() const { return m_selected; }
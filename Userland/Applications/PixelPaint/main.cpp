@@ -58,6 +58,8 @@ int main(int argc, char** argv)
     window->set_title("Pixel Paint");
     window->resize(800, 480);
     window->set_icon(app_icon.bitmap_for_size(16));
+    // Freehand tools want every intermediate mouse position, not just the latest.
+    window->set_mouse_move_event_coalescing_enabled(false);
 
     auto& main_widget = window->set_main_widget<GUI::Widget>();
     main_widget.load_from_gml(pixel_paint_window_gml);
@@ -6,12 +6,13 @@
 
 #include "TreeMapWidget.h"
 #include <AK/LexicalPath.h>
-#include <AK/Queue.h>
+#include <AK/NonnullRefPtrVector.h>
 #include <AK/QuickSort.h>
 #include <AK/RefCounted.h>
 #include <AK/URL.h>
 #include <Applications/SpaceAnalyzer/SpaceAnalyzerGML.h>
 #include <LibCore/DirIterator.h>
+#include <LibCore/DirectoryWalker.h>
 #include <LibCore/File.h>
 #include <LibDesktop/Launcher.h>
 #include <LibGUI/AboutDialog.h>
@@ -23,6 +24,7 @@
 #include <LibGUI/Menubar.h>
 #include <LibGUI/MessageBox.h>
 #include <LibGUI/Statusbar.h>
+#include <LibThreading/ThreadPool.h>
 #include <fcntl.h>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -124,67 +126,103 @@ static long long int update_totals(TreeNode& node)
     return result;
 }
 
-struct QueueEntry {
-    QueueEntry(String path, TreeNode* node)
-        : path(move(path))
-        , node(node) {};
-    String path;
-    TreeNode* node { nullptr };
-};
-
 static void populate_filesize_tree(TreeNode& root, Vector<MountInfo>& mounts, HashMap<int, int>& error_accumulator)
 {
     VERIFY(!root.m_name.ends_with("/"));
 
-    Queue<QueueEntry> queue;
-    queue.enqueue(QueueEntry(root.m_name, &root));
-
-    StringBuilder builder = StringBuilder();
-    builder.append(root.m_name);
-    builder.append("/");
-    MountInfo* root_mount_info = find_mount_for_path(builder.to_string(), mounts);
+    MountInfo* root_mount_info = find_mount_for_path(String::formatted("{}/", root.m_name), mounts);
     if (!root_mount_info) {
         return;
     }
-    while (!queue.is_empty()) {
-        QueueEntry queue_entry = queue.dequeue();
 
-        builder.clear();
-        builder.append(queue_entry.path);
-        builder.append("/");
+    auto crosses_mount_boundary = [&](const String& path_with_slash) {
+        MountInfo* mount_info = find_mount_for_path(path_with_slash, mounts);
+        return !mount_info || (mount_info != root_mount_info && mount_info->source != root_mount_info->source);
+    };
 
-        MountInfo* mount_info = find_mount_for_path(builder.to_string(), mounts);
-        if (!mount_info || (mount_info != root_mount_info && mount_info->source != root_mount_info->source)) {
-            continue;
-        }
+    // List the root's immediate children, then scan each subdirectory's
+    // subtree on the thread pool. The subtrees are disjoint, so every task
+    // works on its own nodes and nothing needs locking.
+    struct SubtreeJob {
+        TreeNode* node { nullptr };
+        String path;
+    };
+    Vector<SubtreeJob> jobs;
 
-        Core::DirIterator dir_iterator(builder.to_string(), Core::DirIterator::SkipParentAndBaseDir);
-        if (dir_iterator.has_error()) {
-            int error_sum = error_accumulator.get(dir_iterator.error()).value_or(0);
-            error_accumulator.set(dir_iterator.error(), error_sum + 1);
-        } else {
-            queue_entry.node->m_children = make<Vector<TreeNode>>();
-            while (dir_iterator.has_next()) {
-                queue_entry.node->m_children->append(TreeNode(dir_iterator.next_path()));
+    root.m_children = make<Vector<TreeNode>>();
+    Core::DirIterator dir_iterator(String::formatted("{}/", root.m_name), Core::DirIterator::SkipParentAndBaseDir);
+    if (dir_iterator.has_error()) {
+        int error_sum = error_accumulator.get(dir_iterator.error()).value_or(0);
+        error_accumulator.set(dir_iterator.error(), error_sum + 1);
+        return;
+    }
+    Vector<Core::DirIterator::DirectoryEntry> root_entries;
+    for (auto dir_entry = dir_iterator.next_entry(); dir_entry.has_value(); dir_entry = dir_iterator.next_entry()) {
+        root_entries.append(dir_entry.release_value());
+    }
+    root.m_children->ensure_capacity(root_entries.size());
+    for (auto& dir_entry : root_entries) {
+        root.m_children->append(TreeNode(dir_entry.name));
+        TreeNode& child = root.m_children->last();
+        String child_path = String::formatted("{}/{}", root.m_name, dir_entry.name);
+        if (dir_entry.type == DT_DIR) {
+            if (!crosses_mount_boundary(String::formatted("{}/", child_path))) {
+                jobs.append({ &child, move(child_path) });
             }
-            for (auto& child : *queue_entry.node->m_children) {
-                String& name = child.m_name;
-                int name_len = name.length();
-                builder.append(name);
-                struct stat st;
-                int stat_result = fstatat(dir_iterator.fd(), name.characters(), &st, AT_SYMLINK_NOFOLLOW);
-                if (stat_result < 0) {
-                    int error_sum = error_accumulator.get(errno).value_or(0);
-                    error_accumulator.set(errno, error_sum + 1);
-                } else {
-                    if (S_ISDIR(st.st_mode)) {
-                        queue.enqueue(QueueEntry(builder.to_string(), &child));
-                    } else {
-                        child.m_area = st.st_size;
+        } else {
+            child.m_area = dir_entry.size;
+        }
+    }
+
+    auto& pool = Threading::ThreadPool::the();
+    NonnullRefPtrVector<Threading::ThreadPool::Task> tasks;
+    tasks.ensure_capacity(jobs.size());
+    Vector<HashMap<int, int>> error_maps;
+    error_maps.resize(jobs.size());
+
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        tasks.append(pool.submit([&, i] {
+            SubtreeJob& job = jobs[i];
+            job.node->m_children = make<Vector<TreeNode>>();
+
+            // parent_stack[depth] is the children vector that entries at
+            // that depth get appended to. The vectors live behind OwnPtrs,
+            // so the pointers stay valid while the vectors grow.
+            Vector<Vector<TreeNode>*> parent_stack;
+            parent_stack.append(job.node->m_children.ptr());
+
+            Core::DirectoryWalker walker(job.path);
+            walker.on_error = [&](const String&, int walker_error) {
+                int error_sum = error_maps[i].get(walker_error).value_or(0);
+                error_maps[i].set(walker_error, error_sum + 1);
+            };
+
+            for (auto entry = walker.next(); entry.has_value(); entry = walker.next()) {
+                parent_stack.shrink(entry->depth + 1);
+                Vector<TreeNode>& siblings = *parent_stack.last();
+                siblings.append(TreeNode(entry->name));
+                TreeNode& node = siblings.last();
+                if (entry->type == DT_DIR) {
+                    if (crosses_mount_boundary(String::formatted("{}/", entry->full_path))) {
+                        walker.skip_subtree();
+                        continue;
                     }
+                    node.m_children = make<Vector<TreeNode>>();
+                    parent_stack.append(node.m_children.ptr());
+                } else {
+                    node.m_area = entry->size;
                 }
-                builder.trim(name_len);
             }
+        }));
+    }
+
+    for (auto& task : tasks) {
+        task.wait();
+    }
+    for (auto& error_map : error_maps) {
+        for (auto& key : error_map.keys()) {
+            int error_sum = error_accumulator.get(key).value_or(0);
+            error_accumulator.set(key, error_sum + error_map.get(key).value());
         }
     }
 
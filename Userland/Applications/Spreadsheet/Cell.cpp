@@ -24,13 +24,13 @@ void Cell::set_data(String new_data)
     }
 
     m_data = move(new_data);
-    m_dirty = true;
+    mark_dirty();
     m_evaluated_externally = false;
 }
 
 void Cell::set_data(JS::Value new_data)
 {
-    m_dirty = true;
+    mark_dirty();
     m_evaluated_externally = true;
 
     StringBuilder builder;
@@ -56,6 +56,13 @@ void Cell::set_type(const StringView& name)
     VERIFY_NOT_REACHED();
 }
 
+void Cell::mark_dirty()
+{
+    m_dirty = true;
+    if (m_sheet)
+        m_sheet->mark_cell_dirty({}, *this);
+}
+
 void Cell::set_type_metadata(CellTypeMetadata&& metadata)
 {
     m_type_metadata = move(metadata);
@@ -94,6 +101,11 @@ void Cell::update_data(Badge<Sheet>)
 
     if (m_dirty) {
         m_dirty = false;
+
+        // The dependency edges are rediscovered below as the formula (and
+        // the conditional formats) read their inputs again.
+        clear_references();
+
         if (m_kind == Formula) {
             if (!m_evaluated_externally) {
                 auto [value, exception] = m_sheet->evaluate(m_data, this);
@@ -101,13 +113,6 @@ void Cell::update_data(Badge<Sheet>)
                 m_js_exception = move(exception);
             }
         }
-
-        for (auto& ref : m_referencing_cells) {
-            if (ref) {
-                ref->m_dirty = true;
-                ref->update();
-            }
-        }
     }
 
     m_evaluated_formats.background_color.clear();
@@ -171,11 +176,21 @@ void Cell::reference_from(Cell* other)
         return;
 
     m_referencing_cells.append(other->make_weak_ptr());
+    other->m_referenced_cells.append(make_weak_ptr());
+}
+
+void Cell::clear_references()
+{
+    for (auto& referenced : m_referenced_cells) {
+        if (referenced)
+            referenced->m_referencing_cells.remove_all_matching([this](const auto& ptr) { return ptr.ptr() == this; });
+    }
+    m_referenced_cells.clear();
 }
 
 void Cell::copy_from(const Cell& other)
 {
-    m_dirty = true;
+    mark_dirty();
     m_evaluated_externally = other.m_evaluated_externally;
     m_data = other.m_data;
     m_evaluated_data = other.m_evaluated_data;
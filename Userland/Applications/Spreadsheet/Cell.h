@@ -43,11 +43,13 @@ struct Cell : public Weakable<Cell> {
     }
 
     void reference_from(Cell*);
+    void clear_references();
 
     void set_data(String new_data);
     void set_data(JS::Value new_data);
     bool dirty() const { return m_dirty; }
     void clear_dirty() { m_dirty = false; }
+    void mark_dirty();
 
     void set_exception(JS::Exception* exc) { m_js_exception = exc; }
     JS::Exception* exception() const { return m_js_exception; }
@@ -56,6 +58,9 @@ struct Cell : public Weakable<Cell> {
     const JS::Value& evaluated_data() const { return m_evaluated_data; }
     Kind kind() const { return m_kind; }
     const Vector<WeakPtr<Cell>>& referencing_cells() const { return m_referencing_cells; }
+    Vector<WeakPtr<Cell>>& referencing_cells() { return m_referencing_cells; }
+    const Vector<WeakPtr<Cell>>& referenced_cells() const { return m_referenced_cells; }
+    Vector<WeakPtr<Cell>>& referenced_cells() { return m_referenced_cells; }
 
     void set_type(const StringView& name);
     void set_type(const CellType*);
@@ -65,7 +70,7 @@ struct Cell : public Weakable<Cell> {
     void set_position(Position position, Badge<Sheet>)
     {
         if (position != m_position) {
-            m_dirty = true;
+            mark_dirty();
             m_position = move(position);
         }
     }
@@ -75,7 +80,7 @@ struct Cell : public Weakable<Cell> {
     const Vector<ConditionalFormat>& conditional_formats() const { return m_conditional_formats; }
     void set_conditional_formats(Vector<ConditionalFormat>&& fmts)
     {
-        m_dirty = true;
+        mark_dirty();
         m_conditional_formats = move(fmts);
     }
 
@@ -106,7 +111,10 @@ private:
     JS::Exception* m_js_exception { nullptr };
     Kind m_kind { LiteralString };
     WeakPtr<Sheet> m_sheet;
+    // Cells whose formulas read this cell, and cells this cell's formula
+    // reads, respectively. Both edge sets are rebuilt on evaluation.
     Vector<WeakPtr<Cell>> m_referencing_cells;
+    Vector<WeakPtr<Cell>> m_referenced_cells;
     const CellType* m_type { nullptr };
     CellTypeMetadata m_type_metadata;
     Position m_position;
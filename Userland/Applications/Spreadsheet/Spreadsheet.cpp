@@ -115,18 +115,83 @@ void Sheet::update()
         return;
     }
     m_visited_cells_in_update.clear();
-    Vector<Cell*> cells_copy;
 
-    // Grab a copy as updates might insert cells into the table.
-    for (auto& it : m_cells) {
-        if (it.value->dirty()) {
-            cells_copy.append(it.value);
-            m_workbook.set_dirty(true);
+    // Evaluation can dirty further cells (e.g. a script that writes to
+    // another cell), which starts another round; the visited set makes sure
+    // no cell is evaluated more than once per update cycle.
+    while (!m_dirty_cells.is_empty()) {
+        Vector<Cell*> roots;
+        for (auto* cell : m_dirty_cells) {
+            if (cell->dirty())
+                roots.append(cell);
+        }
+        m_dirty_cells.clear();
+        if (roots.is_empty())
+            break;
+
+        m_workbook.set_dirty(true);
+
+        // Mark every transitive dependent of the changed cells dirty, and
+        // collect the set of cells this cycle will recalculate.
+        HashTable<Cell*> affected_cells;
+        Vector<Cell*> work = roots;
+        while (!work.is_empty()) {
+            auto* cell = work.take_last();
+            if (affected_cells.contains(cell))
+                continue;
+            affected_cells.set(cell);
+            for (auto& dependent : cell->referencing_cells()) {
+                if (!dependent)
+                    continue;
+                dependent->mark_dirty();
+                work.append(dependent.ptr());
+            }
+        }
+
+        // Order the affected cells so that every cell is evaluated after
+        // the cells its formula reads, and therefore only once.
+        HashMap<Cell*, size_t> remaining_dependency_counts;
+        for (auto* cell : affected_cells) {
+            size_t count = 0;
+            for (auto& dependency : cell->referenced_cells()) {
+                if (dependency && affected_cells.contains(dependency.ptr()))
+                    ++count;
+            }
+            remaining_dependency_counts.set(cell, count);
         }
-    }
 
-    for (auto& cell : cells_copy)
-        update(*cell);
+        Vector<Cell*> evaluation_order;
+        Vector<Cell*> ready;
+        for (auto& it : remaining_dependency_counts) {
+            if (it.value == 0)
+                ready.append(it.key);
+        }
+        while (!ready.is_empty()) {
+            auto* cell = ready.take_last();
+            evaluation_order.append(cell);
+            for (auto& dependent : cell->referencing_cells()) {
+                if (!dependent)
+                    continue;
+                auto it = remaining_dependency_counts.find(dependent.ptr());
+                if (it == remaining_dependency_counts.end() || it->value == 0)
+                    continue;
+                if (--it->value == 0)
+                    ready.append(dependent.ptr());
+            }
+        }
+
+        // Anything left over sits on a reference cycle; evaluate it in
+        // arbitrary order and let the visited set break the cycle.
+        if (evaluation_order.size() < affected_cells.size()) {
+            for (auto& it : remaining_dependency_counts) {
+                if (it.value > 0)
+                    evaluation_order.append(it.key);
+            }
+        }
+
+        for (auto* cell : evaluation_order)
+            update(*cell);
+    }
 
     m_visited_cells_in_update.clear();
 }
@@ -149,6 +214,11 @@ void Sheet::update(Cell& cell)
     }
 }
 
+void Sheet::mark_cell_dirty(Badge<Cell>, Cell& cell)
+{
+    m_dirty_cells.set(&cell);
+}
+
 Sheet::ValueAndException Sheet::evaluate(const StringView& source, Cell* on_behalf_of)
 {
     TemporaryChange cell_change { m_current_cell_being_evaluated, on_behalf_of };
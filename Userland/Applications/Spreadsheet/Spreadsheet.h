@@ -9,6 +9,7 @@
 #include "Cell.h"
 #include "Forward.h"
 #include "Readers/XSV.h"
+#include <AK/Badge.h>
 #include <AK/HashMap.h>
 #include <AK/HashTable.h>
 #include <AK/String.h>
@@ -97,6 +98,7 @@ public:
 
     void update();
     void update(Cell&);
+    void mark_cell_dirty(Badge<Cell>, Cell&);
     void disable_updates() { m_should_ignore_updates = true; }
     void enable_updates()
     {
@@ -150,6 +152,10 @@ private:
     Cell* m_current_cell_being_evaluated { nullptr };
 
     HashTable<Cell*> m_visited_cells_in_update;
+    // Cells that have been marked dirty since the last update cycle. This
+    // lets update() start from just the changed cells instead of scanning
+    // the whole sheet.
+    HashTable<Cell*> m_dirty_cells;
     bool m_should_ignore_updates { false };
     bool m_update_requested { false };
     mutable Optional<JsonObject> m_cached_documentation;
@@ -76,6 +76,8 @@ String ProcessModel::column_name(int column) const
         return "User";
     case Column::Priority:
         return "Pr";
+    case Column::PriorityBoost:
+        return "Boost";
     case Column::Virtual:
         return "Virtual";
     case Column::Physical:
@@ -147,6 +149,7 @@ GUI::Variant ProcessModel::data(const GUI::ModelIndex& index, GUI::ModelRole rol
         case Column::PGID:
         case Column::SID:
         case Column::Priority:
+        case Column::PriorityBoost:
         case Column::Virtual:
         case Column::Physical:
         case Column::DirtyPrivate:
@@ -194,6 +197,8 @@ GUI::Variant ProcessModel::data(const GUI::ModelIndex& index, GUI::ModelRole rol
             return thread.current_state.user;
         case Column::Priority:
             return thread.current_state.priority;
+        case Column::PriorityBoost:
+            return thread.current_state.priority_boost;
         case Column::Virtual:
             return (int)thread.current_state.amount_virtual;
         case Column::Physical:
@@ -263,6 +268,8 @@ GUI::Variant ProcessModel::data(const GUI::ModelIndex& index, GUI::ModelRole rol
             return thread.current_state.user;
         case Column::Priority:
             return thread.current_state.priority;
+        case Column::PriorityBoost:
+            return thread.current_state.priority_boost;
         case Column::Virtual:
             return pretty_byte_size(thread.current_state.amount_virtual);
         case Column::Physical:
@@ -365,6 +372,7 @@ void ProcessModel::update()
                 state.cpu = thread.cpu;
                 state.cpu_percent = 0;
                 state.priority = thread.priority;
+                state.priority_boost = thread.priority_boost;
                 state.state = thread.state;
                 sum_ticks_scheduled += thread.ticks_user + thread.ticks_kernel;
                 sum_ticks_scheduled_kernel += thread.ticks_kernel;
@@ -34,6 +34,7 @@ public:
         Veil,
         Processor,
         Priority,
+        PriorityBoost,
         TID,
         PPID,
         PGID,
@@ -99,6 +100,7 @@ private:
         String veil;
         u32 cpu;
         u32 priority;
+        u32 priority_boost;
         size_t amount_virtual;
         size_t amount_resident;
         size_t amount_dirty_private;
@@ -524,6 +524,22 @@ NonnullRefPtr<GUI::Widget> build_file_systems_tab()
             [](const JsonObject& object) {
                 return object.get("free_block_count").to_u32() * object.get("block_size").to_u32();
             });
+        df_fields.empend(
+            "Read", Gfx::TextAlignment::CenterRight,
+            [](const JsonObject& object) {
+                return String::formatted("{} ({} ops)", human_readable_size(object.get("bytes_read").to_u64()), object.get("read_ops").to_u64());
+            },
+            [](const JsonObject& object) {
+                return (int)object.get("bytes_read").to_u64();
+            });
+        df_fields.empend(
+            "Written", Gfx::TextAlignment::CenterRight,
+            [](const JsonObject& object) {
+                return String::formatted("{} ({} ops)", human_readable_size(object.get("bytes_written").to_u64()), object.get("write_ops").to_u64());
+            },
+            [](const JsonObject& object) {
+                return (int)object.get("bytes_written").to_u64();
+            });
         df_fields.empend("Access", Gfx::TextAlignment::CenterLeft, [](const JsonObject& object) {
             bool readonly = object.get("readonly").to_bool();
             int mount_flags = object.get("mount_flags").to_int();
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/StringBuilder.h>
+#include <LibCore/File.h>
+#include <LibGUI/GMLParser.h>
+
+int main(int argc, char** argv)
+{
+    if (argc != 3) {
+        outln("usage: {} <variable name> <gml file>", argv[0]);
+        return 1;
+    }
+
+    auto file = Core::File::construct(argv[2]);
+    if (!file->open(Core::OpenMode::ReadOnly)) {
+        warnln("Failed to open {}: {}", argv[2], file->error_string());
+        return 1;
+    }
+
+    auto file_contents = file->read_all();
+
+    // Drop '#'-prefixed lines, just like text-to-cpp-string.sh used to.
+    auto is_comment_line = [](const StringView& line) {
+        size_t i = 0;
+        while (i < line.length() && line[i] == ' ')
+            ++i;
+        return i < line.length() && line[i] == '#';
+    };
+    StringBuilder builder;
+    for (auto& line : StringView(file_contents).split_view('\n', true)) {
+        if (is_comment_line(line))
+            continue;
+        builder.append(line);
+        builder.append('\n');
+    }
+
+    auto root = GUI::parse_gml(builder.string_view());
+    if (!root.is_object()) {
+        warnln("Failed to parse {}", argv[2]);
+        return 1;
+    }
+
+    auto blob = GUI::compile_gml(root);
+
+    outln("#include <AK/StringView.h>");
+    outln("static const unsigned char {}_data[] = {{", argv[1]);
+    for (size_t i = 0; i < blob.size(); ++i) {
+        out("0x{:02x},", blob[i]);
+        if ((i + 1) % 16 == 0 || i == blob.size() - 1)
+            outln();
+        else
+            out(" ");
+    }
+    outln("}};");
+    outln("extern const StringView {};", argv[1]);
+    outln("const StringView {} {{ (const char*){}_data, sizeof({}_data) }};", argv[1], argv[1], argv[1]);
+    return 0;
+}
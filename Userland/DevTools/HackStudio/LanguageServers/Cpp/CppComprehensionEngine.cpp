@@ -391,7 +391,11 @@ String CppComprehensionEngine::document_path_from_include_path(const StringView&
 
 void CppComprehensionEngine::on_edit(const String& file)
 {
-    set_document_data(file, create_document_data_for(file));
+    // Re-parsing the whole document (and whatever headers it pulls in) on
+    // every keystroke makes typing lag, so just drop the cached parse here
+    // and rebuild it lazily when the next query for this document arrives.
+    // The cached parses of unchanged headers stay and are reused.
+    m_documents.remove(filedb().to_absolute_path(file));
 }
 
 void CppComprehensionEngine::file_opened([[maybe_unused]] const String& file)
@@ -156,7 +156,9 @@ Vector<GUI::AutocompleteProvider::Entry> ShellComprehensionEngine::get_suggestio
 
 void ShellComprehensionEngine::on_edit(const String& file)
 {
-    set_document_data(file, create_document_data_for(file));
+    // Drop the cached parse and rebuild it lazily on the next query
+    // instead of re-parsing on every keystroke.
+    m_documents.remove(filedb().to_absolute_path(file));
 }
 
 void ShellComprehensionEngine::file_opened([[maybe_unused]] const String& file)
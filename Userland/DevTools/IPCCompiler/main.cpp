@@ -68,6 +68,13 @@ static bool is_primitive_type(String const& type)
     return type.is_one_of("u8", "i8", "u16", "i16", "u32", "i32", "u64", "i64", "bool", "double", "float", "int", "unsigned", "unsigned int");
 }
 
+// Borrowed types decode as views into the receive buffer instead of copying
+// out of it. The generated message retains the buffer to keep them valid.
+static bool is_borrowed_type(String const& type)
+{
+    return type.is_one_of("StringView", "ReadonlyBytes");
+}
+
 static String message_name(String const& endpoint, String& message, bool is_response)
 {
     StringBuilder builder;
@@ -238,6 +245,19 @@ int main(int argc, char** argv)
     while (lexer.tell() < file_contents.size())
         parse_endpoint();
 
+    for (auto& endpoint : endpoints) {
+        for (auto& message : endpoint.messages) {
+            for (auto& parameter : message.outputs) {
+                if (is_borrowed_type(parameter.type)) {
+                    // A response's backing buffer dies with the response message, but
+                    // synchronous proxies return output values past that point.
+                    warnln("{}::{}: '{}' is not allowed as a response parameter type", endpoint.name, message.name, parameter.type);
+                    VERIFY_NOT_REACHED();
+                }
+            }
+        }
+    }
+
     StringBuilder builder;
     SourceGenerator generator { builder };
 
@@ -338,6 +358,11 @@ enum class MessageID : i32 {
         auto do_message = [&](const String& name, const Vector<Parameter>& parameters, const String& response_type = {}) {
             auto message_generator = endpoint_generator.fork();
             auto pascal_name = pascal_case(name);
+            bool has_borrowed_parameters = false;
+            for (auto& parameter : parameters) {
+                if (is_borrowed_type(parameter.type))
+                    has_borrowed_parameters = true;
+            }
             message_generator.set("message.name", name);
             message_generator.set("message.pascal_name", pascal_name);
             message_generator.set("message.response_type", response_type);
@@ -366,7 +391,7 @@ public:
     static i32 static_message_id() { return (int)MessageID::@message.pascal_name@; }
     virtual const char* message_name() const override { return "@endpoint.name@::@message.pascal_name@"; }
 
-    static OwnPtr<@message.pascal_name@> decode(InputMemoryStream& stream, int sockfd)
+    static OwnPtr<@message.pascal_name@> decode(InputMemoryStream& stream, [[maybe_unused]] RefPtr<IPC::MessageDataBuffer> const& backing, int sockfd)
     {
         IPC::Decoder decoder { stream, sockfd };
 )~~~");
@@ -408,10 +433,19 @@ public:
 
             message_generator.set("message.constructor_call_parameters", builder.build());
 
-            message_generator.append(R"~~~(
+            if (has_borrowed_parameters) {
+                message_generator.append(R"~~~(
+        auto message = make<@message.pascal_name@>(@message.constructor_call_parameters@);
+        message->m_ipc_buffer = backing;
+        return message;
+    }
+)~~~");
+            } else {
+                message_generator.append(R"~~~(
         return make<@message.pascal_name@>(@message.constructor_call_parameters@);
     }
 )~~~");
+            }
 
             message_generator.append(R"~~~(
     virtual bool valid() const { return m_ipc_message_valid; }
@@ -454,6 +488,12 @@ private:
     bool m_ipc_message_valid { true };
             )~~~");
 
+            if (has_borrowed_parameters) {
+                message_generator.append(R"~~~(
+    RefPtr<IPC::MessageDataBuffer> m_ipc_buffer;
+)~~~");
+            }
+
             for (auto& parameter : parameters) {
                 auto parameter_generator = message_generator.fork();
                 parameter_generator.set("parameter.type", parameter.type);
@@ -628,7 +668,7 @@ public:
 
     static u32 static_magic() { return @endpoint.magic@; }
 
-    static OwnPtr<IPC::Message> decode_message(ReadonlyBytes buffer, int sockfd)
+    static OwnPtr<IPC::Message> decode_message(ReadonlyBytes buffer, RefPtr<IPC::MessageDataBuffer> const& backing, int sockfd)
     {
         InputMemoryStream stream { buffer };
         u32 message_endpoint_magic = 0;
@@ -681,7 +721,7 @@ public:
 
                 message_generator.append(R"~~~(
         case (int)Messages::@endpoint.name@::MessageID::@message.pascal_name@:
-            message = Messages::@endpoint.name@::@message.pascal_name@::decode(stream, sockfd);
+            message = Messages::@endpoint.name@::@message.pascal_name@::decode(stream, backing, sockfd);
             break;
 )~~~");
             };
@@ -30,9 +30,10 @@ static void sort_profile_nodes(Vector<NonnullRefPtr<ProfileNode>>& nodes)
         child->sort_children();
 }
 
-Profile::Profile(Vector<Process> processes, Vector<Event> events)
+Profile::Profile(Vector<Process> processes, Vector<Event> events, Vector<Span> spans)
     : m_processes(move(processes))
     , m_events(move(events))
+    , m_spans(move(spans))
 {
     m_first_timestamp = m_events.first().timestamp;
     m_last_timestamp = m_events.last().timestamp;
@@ -86,6 +87,8 @@ void Profile::rebuild_tree()
     });
 
     m_filtered_event_indices.clear();
+    m_total_cache_misses = 0;
+    m_total_branch_misses = 0;
 
     for (size_t event_index = 0; event_index < m_events.size(); ++event_index) {
         auto& event = m_events.at(event_index);
@@ -107,6 +110,9 @@ void Profile::rebuild_tree()
         if (event.type == "free"sv)
             continue;
 
+        m_total_cache_misses += event.cache_misses;
+        m_total_branch_misses += event.branch_misses;
+
         auto for_each_frame = [&]<typename Callback>(Callback callback) {
             if (!m_inverted) {
                 for (size_t i = 0; i < event.frames.size(); ++i) {
@@ -125,6 +131,7 @@ void Profile::rebuild_tree()
             ProfileNode* node = nullptr;
             auto& process_node = find_or_create_process_node(event.pid, event.timestamp);
             process_node.increment_event_count();
+            process_node.add_performance_counters(event.cache_misses, event.branch_misses);
             for_each_frame([&](const Frame& frame, bool is_innermost_frame) {
                 auto& object_name = frame.object_name;
                 auto& symbol = frame.symbol;
@@ -140,6 +147,7 @@ void Profile::rebuild_tree()
                 node = &node->find_or_create_child(object_name, symbol, address, offset, event.timestamp, event.pid);
 
                 node->increment_event_count();
+                node->add_performance_counters(event.cache_misses, event.branch_misses);
                 if (is_innermost_frame) {
                     node->add_event_address(address);
                     node->increment_self_count();
@@ -149,6 +157,7 @@ void Profile::rebuild_tree()
         } else {
             auto& process_node = find_or_create_process_node(event.pid, event.timestamp);
             process_node.increment_event_count();
+            process_node.add_performance_counters(event.cache_misses, event.branch_misses);
             for (size_t i = 0; i < event.frames.size(); ++i) {
                 ProfileNode* node = nullptr;
                 ProfileNode* root = nullptr;
@@ -174,8 +183,10 @@ void Profile::rebuild_tree()
                     if (!root->has_seen_event(event_index)) {
                         root->did_see_event(event_index);
                         root->increment_event_count();
+                        root->add_performance_counters(event.cache_misses, event.branch_misses);
                     } else if (node != root) {
                         node->increment_event_count();
+                        node->add_performance_counters(event.cache_misses, event.branch_misses);
                     }
 
                     if (j == event.frames.size() - 1) {
@@ -216,9 +227,22 @@ Result<NonnullOwnPtr<Profile>, String> Profile::load_from_perfcore_file(const St
 
     auto& perf_events = events_value->as_array();
 
+    // Newer profiles deduplicate stacks into a shared table and events refer
+    // to them via "stack_id"; older profiles embed a "stack" in every event.
+    const JsonArray* stacks = nullptr;
+    if (auto stacks_value = object.get_ptr("stacks"); stacks_value && stacks_value->is_array())
+        stacks = &stacks_value->as_array();
+
     NonnullOwnPtrVector<Process> all_processes;
     HashMap<pid_t, Process*> current_processes;
     Vector<Event> events;
+    Vector<Span> spans;
+    // Span cookies are only unique within a process, so open spans are
+    // keyed on (pid, cookie) until their span_end shows up.
+    HashMap<u64, Span> open_spans;
+    auto open_span_key = [](pid_t pid, FlatPtr id) {
+        return ((u64)pid << 32) | (u32)id;
+    };
 
     for (auto& perf_event_value : perf_events.values()) {
         auto& perf_event = perf_event_value.as_object();
@@ -227,6 +251,8 @@ Result<NonnullOwnPtr<Profile>, String> Profile::load_from_perfcore_file(const St
 
         event.timestamp = perf_event.get("timestamp").to_number<u64>();
         event.lost_samples = perf_event.get("lost_samples").to_number<u32>();
+        event.cache_misses = perf_event.get("cache_misses").to_number<u64>();
+        event.branch_misses = perf_event.get("branch_misses").to_number<u64>();
         event.type = perf_event.get("type").to_string();
         event.pid = perf_event.get("pid").to_i32();
         event.tid = perf_event.get("tid").to_i32();
@@ -297,13 +323,34 @@ Result<NonnullOwnPtr<Profile>, String> Profile::load_from_perfcore_file(const St
             if (it != current_processes.end())
                 it->value->handle_thread_exit(event.tid, event.timestamp);
             continue;
+        } else if (event.type == "span_begin"sv) {
+            auto id = perf_event.get("id").to_number<FlatPtr>();
+            auto kind = perf_event.get("kind").to_number<FlatPtr>();
+            open_spans.set(open_span_key(event.pid, id), { id, kind, event.timestamp, 0, event.pid, event.tid });
+            continue;
+        } else if (event.type == "span_end"sv) {
+            auto id = perf_event.get("id").to_number<FlatPtr>();
+            auto it = open_spans.find(open_span_key(event.pid, id));
+            if (it != open_spans.end()) {
+                auto span = it->value;
+                span.end_timestamp = event.timestamp;
+                spans.append(span);
+                open_spans.remove(it);
+            }
+            continue;
         }
 
-        auto* stack = perf_event.get_ptr("stack");
-        VERIFY(stack);
-        auto& stack_array = stack->as_array();
-        for (ssize_t i = stack_array.values().size() - 1; i >= 0; --i) {
-            auto& frame = stack_array.at(i);
+        const JsonArray* stack_array = nullptr;
+        if (auto* stack = perf_event.get_ptr("stack")) {
+            stack_array = &stack->as_array();
+        } else {
+            auto stack_id = perf_event.get("stack_id").to_number<u32>();
+            if (!stacks || stack_id >= stacks->size())
+                return String { "Malformed profile (stack_id does not refer to a stack)" };
+            stack_array = &stacks->at(stack_id).as_array();
+        }
+        for (ssize_t i = stack_array->values().size() - 1; i >= 0; --i) {
+            auto& frame = stack_array->at(i);
             auto ptr = frame.to_number<u32>();
             u32 offset = 0;
             FlyString object_name;
@@ -344,6 +391,14 @@ Result<NonnullOwnPtr<Profile>, String> Profile::load_from_perfcore_file(const St
     if (events.is_empty())
         return String { "No events captured (targeted process was never on CPU)" };
 
+    // Spans that were still open when profiling stopped run to the end of
+    // the trace.
+    for (auto& it : open_spans) {
+        auto span = it.value;
+        span.end_timestamp = events.last().timestamp;
+        spans.append(span);
+    }
+
     quick_sort(all_processes, [](auto& a, auto& b) {
         if (a.pid == b.pid)
             return a.start_valid < b.start_valid;
@@ -355,7 +410,7 @@ Result<NonnullOwnPtr<Profile>, String> Profile::load_from_perfcore_file(const St
     for (auto& it : all_processes)
         processes.append(move(it));
 
-    return adopt_own(*new Profile(move(processes), move(events)));
+    return adopt_own(*new Profile(move(processes), move(events), move(spans)));
 }
 
 void ProfileNode::sort_children()
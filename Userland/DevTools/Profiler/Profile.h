@@ -87,6 +87,14 @@ public:
     void increment_event_count() { ++m_event_count; }
     void increment_self_count() { ++m_self_count; }
 
+    u64 cache_misses() const { return m_cache_misses; }
+    u64 branch_misses() const { return m_branch_misses; }
+    void add_performance_counters(u64 cache_misses, u64 branch_misses)
+    {
+        m_cache_misses += cache_misses;
+        m_branch_misses += branch_misses;
+    }
+
     void sort_children();
 
     const HashMap<FlatPtr, size_t>& events_per_address() const { return m_events_per_address; }
@@ -118,6 +126,8 @@ private:
     u32 m_offset { 0 };
     u32 m_event_count { 0 };
     u32 m_self_count { 0 };
+    u64 m_cache_misses { 0 };
+    u64 m_branch_misses { 0 };
     u64 m_timestamp { 0 };
     Vector<NonnullRefPtr<ProfileNode>> m_children;
     HashMap<FlatPtr, size_t> m_events_per_address;
@@ -174,11 +184,29 @@ public:
         int pid { 0 };
         int tid { 0 };
         u32 lost_samples { 0 };
+        // Hardware performance counter deltas attributed to this sample;
+        // zero when the kernel multiplexed other events onto the counters
+        // at the time, or when the CPU has no architectural perfmon.
+        u64 cache_misses { 0 };
+        u64 branch_misses { 0 };
         bool in_kernel { false };
         Vector<Frame> frames;
     };
 
+    // An application-level trace span (CORE_TRACE_SCOPE and friends),
+    // reassembled from span_begin/span_end event pairs. The kind is an
+    // application-defined label; spans of the same kind may overlap.
+    struct Span {
+        FlatPtr id { 0 };
+        FlatPtr kind { 0 };
+        u64 start_timestamp { 0 };
+        u64 end_timestamp { 0 };
+        pid_t pid { 0 };
+        int tid { 0 };
+    };
+
     const Vector<Event>& events() const { return m_events; }
+    const Vector<Span>& spans() const { return m_spans; }
     const Vector<size_t>& filtered_event_indices() const { return m_filtered_event_indices; }
 
     u64 length_in_ms() const { return m_last_timestamp - m_first_timestamp; }
@@ -186,6 +214,9 @@ public:
     u64 last_timestamp() const { return m_last_timestamp; }
     u32 deepest_stack_depth() const { return m_deepest_stack_depth; }
 
+    u64 total_cache_misses() const { return m_total_cache_misses; }
+    u64 total_branch_misses() const { return m_total_branch_misses; }
+
     void set_timestamp_filter_range(u64 start, u64 end);
     void clear_timestamp_filter_range();
     bool has_timestamp_filter_range() const { return m_has_timestamp_filter_range; }
@@ -220,7 +251,7 @@ public:
     }
 
 private:
-    Profile(Vector<Process>, Vector<Event>);
+    Profile(Vector<Process>, Vector<Event>, Vector<Span>);
 
     void rebuild_tree();
 
@@ -232,11 +263,14 @@ private:
 
     Vector<NonnullRefPtr<ProfileNode>> m_roots;
     Vector<size_t> m_filtered_event_indices;
+    u64 m_total_cache_misses { 0 };
+    u64 m_total_branch_misses { 0 };
     u64 m_first_timestamp { 0 };
     u64 m_last_timestamp { 0 };
 
     Vector<Process> m_processes;
     Vector<Event> m_events;
+    Vector<Span> m_spans;
 
     bool m_has_timestamp_filter_range { false };
     u64 m_timestamp_filter_range_start { 0 };
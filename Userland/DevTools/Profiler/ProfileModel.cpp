@@ -83,6 +83,10 @@ String ProfileModel::column_name(int column) const
         return m_profile.show_percentages() ? "% Samples" : "# Samples";
     case Column::SelfCount:
         return m_profile.show_percentages() ? "% Self" : "# Self";
+    case Column::CacheMisses:
+        return m_profile.show_percentages() ? "% Cache misses" : "# Cache misses";
+    case Column::BranchMisses:
+        return m_profile.show_percentages() ? "% Branch misses" : "# Branch misses";
     case Column::ObjectName:
         return "Object";
     case Column::StackFrame:
@@ -97,7 +101,8 @@ GUI::Variant ProfileModel::data(const GUI::ModelIndex& index, GUI::ModelRole rol
 {
     auto* node = static_cast<ProfileNode*>(index.internal_data());
     if (role == GUI::ModelRole::TextAlignment) {
-        if (index.column() == Column::SampleCount || index.column() == Column::SelfCount)
+        if (index.column() == Column::SampleCount || index.column() == Column::SelfCount
+            || index.column() == Column::CacheMisses || index.column() == Column::BranchMisses)
             return Gfx::TextAlignment::CenterRight;
     }
     if (role == GUI::ModelRole::Icon) {
@@ -122,6 +127,16 @@ GUI::Variant ProfileModel::data(const GUI::ModelIndex& index, GUI::ModelRole rol
                 return ((float)node->self_count() / (float)m_profile.filtered_event_indices().size()) * 100.0f;
             return node->self_count();
         }
+        if (index.column() == Column::CacheMisses) {
+            if (m_profile.show_percentages())
+                return m_profile.total_cache_misses() ? ((float)node->cache_misses() / (float)m_profile.total_cache_misses()) * 100.0f : 0.0f;
+            return (i64)node->cache_misses();
+        }
+        if (index.column() == Column::BranchMisses) {
+            if (m_profile.show_percentages())
+                return m_profile.total_branch_misses() ? ((float)node->branch_misses() / (float)m_profile.total_branch_misses()) * 100.0f : 0.0f;
+            return (i64)node->branch_misses();
+        }
         if (index.column() == Column::ObjectName)
             return node->object_name();
         if (index.column() == Column::StackFrame) {
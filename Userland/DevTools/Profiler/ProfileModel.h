@@ -22,6 +22,8 @@ public:
     enum Column {
         SampleCount,
         SelfCount,
+        CacheMisses,
+        BranchMisses,
         ObjectName,
         StackFrame,
         __Count
@@ -109,6 +109,26 @@ void TimelineTrack::paint_event(GUI::PaintEvent& event)
         painter.fill_rect({ x, frame_thickness() + kernel_column_height, cw, height() - frame_thickness() * 2 }, kernel_color);
     }
 
+    // Application trace spans are drawn as a thin strip of bars along the
+    // bottom edge, colored by span kind.
+    constexpr int span_strip_height = 4;
+    constexpr Color span_colors[] = {
+        Color::from_rgb(0x4fa368),
+        Color::from_rgb(0xc2a05a),
+        Color::from_rgb(0x5ac2b4),
+        Color::from_rgb(0xa35a9e),
+    };
+    for (auto& span : m_profile.spans()) {
+        if (span.pid != m_process.pid)
+            continue;
+        if (!m_process.valid_at(span.start_timestamp))
+            continue;
+        int span_start_x = (int)((float)(clamp_timestamp(span.start_timestamp) - start_of_trace) * column_width);
+        int span_end_x = (int)((float)(clamp_timestamp(span.end_timestamp) - start_of_trace) * column_width);
+        auto color = span_colors[span.kind % (sizeof(span_colors) / sizeof(span_colors[0]))];
+        painter.fill_rect({ span_start_x, height() - frame_thickness() - span_strip_height, max(1, span_end_x - span_start_x), span_strip_height }, color);
+    }
+
     u64 normalized_start_time = clamp_timestamp(min(m_view.select_start_time(), m_view.select_end_time()));
     u64 normalized_end_time = clamp_timestamp(max(m_view.select_start_time(), m_view.select_end_time()));
     u64 normalized_hover_time = clamp_timestamp(m_view.hover_time());
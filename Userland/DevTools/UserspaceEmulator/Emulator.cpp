@@ -206,6 +206,78 @@ bool Emulator::load_elf()
     return true;
 }
 
+// Maximum number of instructions decoded into one cached block. Blocks also
+// end early at region boundaries; control transfers are detected at execution
+// time, so a block may contain instructions that never run.
+static constexpr size_t max_cached_block_entries = 16;
+
+Emulator::CachedBlock const& Emulator::find_or_translate_block(u32 start_eip)
+{
+    if (auto it = m_block_cache.find(start_eip); it != m_block_cache.end())
+        return *it->value;
+
+    auto block = make<CachedBlock>();
+    block->start = start_eip;
+
+    // Stay clear of the end of the region so straight-line decoding can't run
+    // off the end of the text segment after a final jump or return. (15 bytes
+    // is the longest x86 instruction.)
+    auto* region = m_mmu.find_region({ 0x23, start_eip });
+    u32 region_end = region ? region->base() + region->size() : 0;
+
+    m_cpu.set_eip(start_eip);
+    do {
+        m_cpu.save_base_eip();
+        u32 insn_start = m_cpu.eip();
+        auto insn = X86::Instruction::from_stream(m_cpu, true, true);
+        block->entries.append({ move(insn), insn_start, m_cpu.eip() });
+    } while (block->entries.size() < max_cached_block_entries
+        && region && m_cpu.eip() + 15 <= region_end);
+    block->end = m_cpu.eip();
+
+    for (u32 page = block->start / PAGE_SIZE; page <= (block->end - 1) / PAGE_SIZE; ++page)
+        m_page_to_cached_blocks.ensure(page).append(start_eip);
+
+    auto& result = *block;
+    m_block_cache.set(start_eip, move(block));
+    return result;
+}
+
+void Emulator::invalidate_cached_blocks(FlatPtr address, size_t size)
+{
+    if (m_block_cache.is_empty() || !size)
+        return;
+
+    bool invalidated = false;
+    u32 first_page = address / PAGE_SIZE;
+    u32 last_page = (address + size - 1) / PAGE_SIZE;
+    for (u32 page = first_page; page <= last_page; ++page) {
+        auto it = m_page_to_cached_blocks.find(page);
+        if (it == m_page_to_cached_blocks.end())
+            continue;
+        auto block_starts = move(it->value);
+        m_page_to_cached_blocks.remove(page);
+        for (u32 block_start : block_starts) {
+            auto cached = m_block_cache.find(block_start);
+            if (cached == m_block_cache.end())
+                continue;
+            auto& block = *cached->value;
+            // Unhook the block from every other page it touches.
+            for (u32 block_page = block.start / PAGE_SIZE; block_page <= (block.end - 1) / PAGE_SIZE; ++block_page) {
+                if (block_page == page)
+                    continue;
+                if (auto page_it = m_page_to_cached_blocks.find(block_page); page_it != m_page_to_cached_blocks.end())
+                    page_it->value.remove_all_matching([&](u32 start) { return start == block_start; });
+            }
+            m_block_cache.remove(block_start);
+            invalidated = true;
+        }
+    }
+
+    if (invalidated)
+        ++m_block_cache_generation;
+}
+
 int Emulator::exec()
 {
     // X86::ELFSymbolProvider symbol_provider(*m_elf);
@@ -214,18 +286,39 @@ int Emulator::exec()
     constexpr bool trace = false;
 
     while (!m_shutdown) {
-        m_cpu.save_base_eip();
+        auto const& block = find_or_translate_block(m_cpu.eip());
+        u64 generation = m_block_cache_generation;
+        size_t entry_count = block.entries.size();
 
-        auto insn = X86::Instruction::from_stream(m_cpu, true, true);
+        for (size_t i = 0; i < entry_count; ++i) {
+            // Copy the entry out of the cache: if the instruction we're about
+            // to run modifies its own block, the handler must keep working on
+            // its operands after the block has been freed.
+            auto entry = block.entries[i];
 
-        if constexpr (trace) {
-            outln("{:p}  \033[33;1m{}\033[0m", m_cpu.base_eip(), insn.to_string(m_cpu.base_eip(), symbol_provider));
-        }
+            m_cpu.set_base_eip(entry.start);
+            m_cpu.set_eip(entry.end);
 
-        (m_cpu.*insn.handler())(insn);
+            if constexpr (trace) {
+                outln("{:p}  \033[33;1m{}\033[0m", entry.start, entry.instruction.to_string(entry.start, symbol_provider));
+            }
+
+            (m_cpu.*entry.instruction.handler())(entry.instruction);
+
+            if constexpr (trace) {
+                m_cpu.dump();
+            }
 
-        if constexpr (trace) {
-            m_cpu.dump();
+            if (m_block_cache_generation != generation) [[unlikely]] {
+                // Self-modifying code invalidated cached blocks (possibly the
+                // one we're executing); don't touch it again.
+                break;
+            }
+
+            if (m_cpu.eip() != entry.end) [[unlikely]] {
+                // Control transfer; resume from the dispatcher.
+                break;
+            }
         }
 
         if (m_pending_signals) [[unlikely]] {
@@ -12,7 +12,9 @@
 #include "Report.h"
 #include "SoftCPU.h"
 #include "SoftMMU.h"
+#include <AK/HashMap.h>
 #include <AK/MappedFile.h>
+#include <AK/NonnullOwnPtr.h>
 #include <AK/Types.h>
 #include <LibDebug/DebugInfo.h>
 #include <LibELF/AuxiliaryVector.h>
@@ -52,7 +54,27 @@ public:
 
     void dump_regions() const;
 
+    // Called whenever emulated memory that may contain code is written to or
+    // remapped, so cached decoded blocks can't go stale.
+    void invalidate_cached_blocks(FlatPtr address, size_t size);
+
 private:
+    // A decoded basic block: a straight-line run of instructions starting at
+    // `start`. Instructions are decoded once via LibX86 and re-executed from
+    // here, instead of being re-decoded on every visit.
+    struct CachedBlockEntry {
+        X86::Instruction instruction;
+        u32 start { 0 };
+        u32 end { 0 };
+    };
+    struct CachedBlock {
+        u32 start { 0 };
+        u32 end { 0 };
+        Vector<CachedBlockEntry, 16> entries;
+    };
+
+    CachedBlock const& find_or_translate_block(u32 start_eip);
+
     const String m_executable_path;
     const Vector<String> m_arguments;
     const Vector<String> m_environment;
@@ -202,6 +224,14 @@ private:
     sigset_t m_pending_signals { 0 };
     sigset_t m_signal_mask { 0 };
 
+    // Cached blocks keyed by their start address, plus an index of which
+    // blocks touch which pages so writes can invalidate them. The generation
+    // counter lets the execution loop notice when self-modifying code just
+    // invalidated the block it is running.
+    HashMap<u32, NonnullOwnPtr<CachedBlock>> m_block_cache;
+    HashMap<u32, Vector<u32>> m_page_to_cached_blocks;
+    u64 m_block_cache_generation { 0 };
+
     struct SignalHandlerInfo {
         FlatPtr handler { 0 };
         sigset_t mask { 0 };
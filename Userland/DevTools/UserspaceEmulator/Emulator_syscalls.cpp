@@ -961,6 +961,10 @@ u32 Emulator::virt$mprotect(FlatPtr base, size_t size, int prot)
     if (has_non_mmapped_region)
         return -EINVAL;
 
+    // Regions may have gained or lost execute permission; any cached blocks
+    // decoded from them can no longer be trusted.
+    invalidate_cached_blocks(base, size);
+
     return 0;
 }
 
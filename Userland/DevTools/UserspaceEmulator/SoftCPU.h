@@ -47,6 +47,7 @@ public:
 
     u32 base_eip() const { return m_base_eip; }
     void save_base_eip() { m_base_eip = m_eip; }
+    void set_base_eip(u32 eip) { m_base_eip = eip; }
 
     u32 eip() const { return m_eip; }
     void set_eip(u32 eip)
@@ -23,6 +23,8 @@ void SoftMMU::add_region(NonnullOwnPtr<Region> region)
 {
     VERIFY(!find_region({ 0x23, region->base() }));
 
+    m_emulator.invalidate_cached_blocks(region->base(), region->size());
+
     size_t first_page_in_region = region->base() / PAGE_SIZE;
     size_t last_page_in_region = (region->base() + region->size() - 1) / PAGE_SIZE;
     for (size_t page = first_page_in_region; page <= last_page_in_region; ++page) {
@@ -35,6 +37,8 @@ void SoftMMU::add_region(NonnullOwnPtr<Region> region)
 
 void SoftMMU::remove_region(Region& region)
 {
+    m_emulator.invalidate_cached_blocks(region.base(), region.size());
+
     size_t first_page_in_region = region.base() / PAGE_SIZE;
     for (size_t i = 0; i < ceil_div(region.size(), PAGE_SIZE); ++i) {
         m_page_to_region_map[first_page_in_region + i] = nullptr;
@@ -213,6 +217,9 @@ void SoftMMU::write8(X86::LogicalAddress address, ValueWithShadow<u8> value)
         m_emulator.dump_backtrace();
         TODO();
     }
+
+    if (region->is_executable()) [[unlikely]]
+        m_emulator.invalidate_cached_blocks(address.offset(), 1);
     region->write8(address.offset() - region->base(), value);
 }
 
@@ -231,6 +238,8 @@ void SoftMMU::write16(X86::LogicalAddress address, ValueWithShadow<u16> value)
         TODO();
     }
 
+    if (region->is_executable()) [[unlikely]]
+        m_emulator.invalidate_cached_blocks(address.offset(), 2);
     region->write16(address.offset() - region->base(), value);
 }
 
@@ -249,6 +258,8 @@ void SoftMMU::write32(X86::LogicalAddress address, ValueWithShadow<u32> value)
         TODO();
     }
 
+    if (region->is_executable()) [[unlikely]]
+        m_emulator.invalidate_cached_blocks(address.offset(), 4);
     region->write32(address.offset() - region->base(), value);
 }
 
@@ -267,6 +278,8 @@ void SoftMMU::write64(X86::LogicalAddress address, ValueWithShadow<u64> value)
         TODO();
     }
 
+    if (region->is_executable()) [[unlikely]]
+        m_emulator.invalidate_cached_blocks(address.offset(), 8);
     region->write64(address.offset() - region->base(), value);
 }
 
@@ -285,6 +298,8 @@ void SoftMMU::write128(X86::LogicalAddress address, ValueWithShadow<u128> value)
         TODO();
     }
 
+    if (region->is_executable()) [[unlikely]]
+        m_emulator.invalidate_cached_blocks(address.offset(), 16);
     region->write128(address.offset() - region->base(), value);
 }
 
@@ -303,6 +318,8 @@ void SoftMMU::write256(X86::LogicalAddress address, ValueWithShadow<u256> value)
         TODO();
     }
 
+    if (region->is_executable()) [[unlikely]]
+        m_emulator.invalidate_cached_blocks(address.offset(), 32);
     region->write256(address.offset() - region->base(), value);
 }
 
@@ -346,6 +363,9 @@ bool SoftMMU::fast_fill_memory8(X86::LogicalAddress address, size_t size, ValueW
         }
     }
 
+    if (region->is_executable()) [[unlikely]]
+        m_emulator.invalidate_cached_blocks(address.offset(), size);
+
     size_t offset_in_region = address.offset() - region->base();
     memset(region->data() + offset_in_region, value.value(), size);
     memset(region->shadow_data() + offset_in_region, value.shadow(), size);
@@ -371,6 +391,9 @@ bool SoftMMU::fast_fill_memory32(X86::LogicalAddress address, size_t count, Valu
         }
     }
 
+    if (region->is_executable()) [[unlikely]]
+        m_emulator.invalidate_cached_blocks(address.offset(), count * sizeof(u32));
+
     size_t offset_in_region = address.offset() - region->base();
     fast_u32_fill((u32*)(region->data() + offset_in_region), value.value(), count);
     fast_u32_fill((u32*)(region->shadow_data() + offset_in_region), value.shadow(), count);
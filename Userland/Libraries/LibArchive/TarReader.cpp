@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibArchive/TarReader.h>
+
+namespace Archive {
+
+static constexpr size_t block_ceiling(size_t offset)
+{
+    return block_size * (1 + ((offset - 1) / block_size));
+}
+
+TarReader::TarReader(ReadonlyBytes bytes)
+    : m_bytes(bytes)
+{
+    load_header();
+}
+
+void TarReader::load_header()
+{
+    if (m_offset + block_size > m_bytes.size()) {
+        m_header = nullptr;
+        m_finished = true;
+        return;
+    }
+
+    // Every field in the header is a character array, so reading it in place
+    // is fine regardless of alignment.
+    m_header = reinterpret_cast<const TarFileHeader*>(m_bytes.data() + m_offset);
+    if (!valid()) {
+        m_header = nullptr;
+        m_finished = true;
+    }
+}
+
+bool TarReader::valid() const
+{
+    if (!m_header)
+        return false;
+
+    auto& header_magic = m_header->magic();
+    auto& header_version = m_header->version();
+
+    if (!((header_magic == gnu_magic && header_version == gnu_version)
+            || (header_magic == ustar_magic && header_version == ustar_version)
+            || (header_magic == posix1_tar_magic && header_version == posix1_tar_version)))
+        return false;
+
+    // POSIX.1-1988 tar does not have magic numbers, so we also need to verify the header checksum.
+    return m_header->checksum() == m_header->expected_checksum();
+}
+
+ReadonlyBytes TarReader::contents() const
+{
+    VERIFY(!m_finished);
+    auto size = m_header->size();
+    VERIFY(m_offset + block_size + size <= m_bytes.size());
+    return m_bytes.slice(m_offset + block_size, size);
+}
+
+void TarReader::advance()
+{
+    if (m_finished)
+        return;
+
+    m_offset += block_size + block_ceiling(m_header->size());
+    load_header();
+}
+
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Span.h>
+#include <LibArchive/Tar.h>
+
+namespace Archive {
+
+// Iterates over an in-memory tar archive (typically an AK::MappedFile) and
+// hands out each entry's contents as a view into the archive, without ever
+// copying the data.
+class TarReader {
+public:
+    explicit TarReader(ReadonlyBytes);
+
+    bool finished() const { return m_finished; }
+    bool valid() const;
+    const TarFileHeader& header() const
+    {
+        VERIFY(m_header);
+        return *m_header;
+    }
+    ReadonlyBytes contents() const;
+    void advance();
+
+private:
+    void load_header();
+
+    ReadonlyBytes m_bytes;
+    const TarFileHeader* m_header { nullptr };
+    size_t m_offset { 0 };
+    bool m_finished { false };
+};
+
+}
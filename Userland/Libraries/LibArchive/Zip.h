@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/Function.h>
+#include <AK/HashMap.h>
 #include <AK/IterationDecision.h>
 #include <AK/Span.h>
 #include <AK/Stream.h>
@@ -209,13 +210,16 @@ class Zip {
 public:
     static Optional<Zip> try_create(const ReadonlyBytes& buffer);
     bool for_each_member(Function<IterationDecision(const ZipMember&)>);
+    const Vector<ZipMember>& members() const { return m_members; }
+    Optional<ZipMember> find_member(const StringView& name) const;
 
 private:
     static bool find_end_of_central_directory_offset(const ReadonlyBytes&, size_t& offset);
 
-    u16 member_count { 0 };
-    size_t members_start_offset { 0 };
-    ReadonlyBytes m_input_data;
+    // The central directory, parsed once up front; member data still points
+    // into the caller's buffer.
+    Vector<ZipMember> m_members;
+    HashMap<String, size_t> m_member_indices;
 };
 
 class ZipOutputStream {
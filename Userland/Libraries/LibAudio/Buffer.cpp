@@ -7,8 +7,10 @@
 
 #include <AK/Atomic.h>
 #include <AK/Debug.h>
+#include <AK/SIMD.h>
 #include <AK/String.h>
 #include <LibAudio/Buffer.h>
+#include <LibAudio/Resampler.h>
 
 namespace Audio {
 
@@ -42,38 +44,29 @@ i32 Buffer::allocate_id()
     return next_id++;
 }
 
+// Decodes frames at the source rate; rate conversion happens afterwards in
+// one batch through the Resampler.
 template<typename SampleReader>
-static void read_samples_from_stream(InputMemoryStream& stream, SampleReader read_sample, Vector<Frame>& samples, ResampleHelper& resampler, int num_channels)
+static void read_samples_from_stream(InputMemoryStream& stream, SampleReader read_sample, Vector<Frame>& samples, int num_channels)
 {
-    double norm_l = 0;
-    double norm_r = 0;
-
     switch (num_channels) {
     case 1:
         for (;;) {
-            while (resampler.read_sample(norm_l, norm_r)) {
-                samples.append(Frame(norm_l));
-            }
-            norm_l = read_sample(stream);
-
+            double sample = read_sample(stream);
             if (stream.handle_any_error()) {
                 break;
             }
-            resampler.process_sample(norm_l, norm_r);
+            samples.append(Frame(sample));
         }
         break;
     case 2:
         for (;;) {
-            while (resampler.read_sample(norm_l, norm_r)) {
-                samples.append(Frame(norm_l, norm_r));
-            }
-            norm_l = read_sample(stream);
-            norm_r = read_sample(stream);
-
+            double left = read_sample(stream);
+            double right = read_sample(stream);
             if (stream.handle_any_error()) {
                 break;
             }
-            resampler.process_sample(norm_l, norm_r);
+            samples.append(Frame(left, right));
         }
         break;
     default:
@@ -112,11 +105,36 @@ static double read_norm_sample_24(InputMemoryStream& stream)
     return double(value) / NumericLimits<i32>::max();
 }
 
-static double read_norm_sample_16(InputMemoryStream& stream)
+// Bulk path for the most common on-disk format: 16-bit PCM. Converting
+// straight out of the stream's buffer skips the per-sample stream
+// bookkeeping above, and normalizing both channels of a frame is a single
+// f64x2 operation.
+static void read_samples_bulk_int16(InputMemoryStream& stream, Vector<Frame>& samples, int num_channels)
 {
-    LittleEndian<i16> sample;
-    stream >> sample;
-    return double(sample) / NumericLimits<i16>::max();
+    using AK::SIMD::f64x2;
+    using AK::SIMD::i32x2;
+
+    auto const* data = stream.bytes().data() + stream.offset();
+    size_t frame_count = stream.remaining() / (sizeof(i16) * num_channels);
+    samples.ensure_capacity(samples.size() + frame_count);
+
+    if (num_channels == 1) {
+        for (size_t i = 0; i < frame_count; ++i) {
+            i16 sample;
+            __builtin_memcpy(&sample, data + i * sizeof(i16), sizeof(sample));
+            samples.unchecked_append(Frame(double(sample) / NumericLimits<i16>::max()));
+        }
+    } else {
+        f64x2 const sample_maximum = { NumericLimits<i16>::max(), NumericLimits<i16>::max() };
+        for (size_t i = 0; i < frame_count; ++i) {
+            i16 raw[2];
+            __builtin_memcpy(raw, data + i * sizeof(raw), sizeof(raw));
+            auto frame = __builtin_convertvector(i32x2 { raw[0], raw[1] }, f64x2) / sample_maximum;
+            samples.unchecked_append(Frame(frame[0], frame[1]));
+        }
+    }
+
+    stream.discard_or_error(frame_count * sizeof(i16) * num_channels);
 }
 
 static double read_norm_sample_8(InputMemoryStream& stream)
@@ -126,32 +144,32 @@ static double read_norm_sample_8(InputMemoryStream& stream)
     return double(sample) / NumericLimits<u8>::max();
 }
 
-RefPtr<Buffer> Buffer::from_pcm_data(ReadonlyBytes data, ResampleHelper& resampler, int num_channels, PcmSampleFormat sample_format)
+RefPtr<Buffer> Buffer::from_pcm_data(ReadonlyBytes data, Resampler& resampler, int num_channels, PcmSampleFormat sample_format)
 {
     InputMemoryStream stream { data };
     return from_pcm_stream(stream, resampler, num_channels, sample_format, data.size() / (pcm_bits_per_sample(sample_format) / 8));
 }
 
-RefPtr<Buffer> Buffer::from_pcm_stream(InputMemoryStream& stream, ResampleHelper& resampler, int num_channels, PcmSampleFormat sample_format, int num_samples)
+RefPtr<Buffer> Buffer::from_pcm_stream(InputMemoryStream& stream, Resampler& resampler, int num_channels, PcmSampleFormat sample_format, int num_samples)
 {
     Vector<Frame> fdata;
     fdata.ensure_capacity(num_samples);
 
     switch (sample_format) {
     case PcmSampleFormat::Uint8:
-        read_samples_from_stream(stream, read_norm_sample_8, fdata, resampler, num_channels);
+        read_samples_from_stream(stream, read_norm_sample_8, fdata, num_channels);
         break;
     case PcmSampleFormat::Int16:
-        read_samples_from_stream(stream, read_norm_sample_16, fdata, resampler, num_channels);
+        read_samples_bulk_int16(stream, fdata, num_channels);
         break;
     case PcmSampleFormat::Int24:
-        read_samples_from_stream(stream, read_norm_sample_24, fdata, resampler, num_channels);
+        read_samples_from_stream(stream, read_norm_sample_24, fdata, num_channels);
         break;
     case PcmSampleFormat::Float32:
-        read_samples_from_stream(stream, read_float_sample_32, fdata, resampler, num_channels);
+        read_samples_from_stream(stream, read_float_sample_32, fdata, num_channels);
         break;
     case PcmSampleFormat::Float64:
-        read_samples_from_stream(stream, read_float_sample_64, fdata, resampler, num_channels);
+        read_samples_from_stream(stream, read_float_sample_64, fdata, num_channels);
         break;
     default:
         VERIFY_NOT_REACHED();
@@ -162,7 +180,12 @@ RefPtr<Buffer> Buffer::from_pcm_stream(InputMemoryStream& stream, ResampleHelper
     // don't belong.
     VERIFY(!stream.handle_any_error());
 
-    return Buffer::create_with_samples(move(fdata));
+    if (resampler.is_passthrough())
+        return Buffer::create_with_samples(move(fdata));
+
+    Vector<Frame> resampled;
+    resampler.process(fdata, resampled);
+    return Buffer::create_with_samples(move(resampled));
 }
 
 }
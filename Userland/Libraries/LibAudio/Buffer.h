@@ -84,28 +84,14 @@ enum PcmSampleFormat : u8 {
 u16 pcm_bits_per_sample(PcmSampleFormat format);
 String sample_format_name(PcmSampleFormat format);
 
-// Small helper to resample from one playback rate to another
-// This isn't really "smart", in that we just insert (or drop) samples.
-// Should do better...
-class ResampleHelper {
-public:
-    ResampleHelper(double source, double target);
-
-    void process_sample(double sample_l, double sample_r);
-    bool read_sample(double& next_l, double& next_r);
-
-private:
-    const double m_ratio;
-    double m_current_ratio { 0 };
-    double m_last_sample_l { 0 };
-    double m_last_sample_r { 0 };
-};
+// See Resampler.h; forward-declared here because Resampler.h needs Frame.
+class Resampler;
 
 // A buffer of audio samples, normalized to 44100hz.
 class Buffer : public RefCounted<Buffer> {
 public:
-    static RefPtr<Buffer> from_pcm_data(ReadonlyBytes data, ResampleHelper& resampler, int num_channels, PcmSampleFormat sample_format);
-    static RefPtr<Buffer> from_pcm_stream(InputMemoryStream& stream, ResampleHelper& resampler, int num_channels, PcmSampleFormat sample_format, int num_samples);
+    static RefPtr<Buffer> from_pcm_data(ReadonlyBytes data, Resampler& resampler, int num_channels, PcmSampleFormat sample_format);
+    static RefPtr<Buffer> from_pcm_stream(InputMemoryStream& stream, Resampler& resampler, int num_channels, PcmSampleFormat sample_format, int num_samples);
     static NonnullRefPtr<Buffer> create_with_samples(Vector<Frame>&& samples)
     {
         return adopt_ref(*new Buffer(move(samples)));
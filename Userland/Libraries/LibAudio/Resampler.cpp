@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/SIMD.h>
+#include <LibAudio/Resampler.h>
+#include <math.h>
+
+namespace Audio {
+
+using AK::SIMD::f64x2;
+
+// An Audio::Frame is a pair of doubles, which is exactly one f64x2, so both
+// channels of a frame go through the interpolation and filter kernels as a
+// single vector.
+ALWAYS_INLINE static f64x2 load_frame(const Frame& frame)
+{
+    return f64x2 { frame.left, frame.right };
+}
+
+ALWAYS_INLINE static void store_frame(Frame& frame, f64x2 vector)
+{
+    frame.left = vector[0];
+    frame.right = vector[1];
+}
+
+Resampler::Resampler(u32 source_rate, u32 target_rate, Quality quality)
+    : m_source_rate(source_rate)
+    , m_target_rate(target_rate)
+    , m_quality(quality)
+    , m_step(double(source_rate) / double(target_rate))
+{
+    if (m_quality == Quality::WindowedSinc && !is_passthrough())
+        build_filter_table();
+}
+
+void Resampler::build_filter_table()
+{
+    // One row of sinc_taps coefficients per fractional phase. The sinc is
+    // cut off at the lower of the two Nyquist frequencies (so downsampling
+    // suppresses aliasing), Hann-windowed over the tap span, and each row is
+    // normalized to unity gain.
+    double cutoff = min(1.0, double(m_target_rate) / double(m_source_rate));
+
+    m_filter_table.resize(sinc_phases * sinc_taps);
+    for (int phase = 0; phase < sinc_phases; ++phase) {
+        double fraction = double(phase) / double(sinc_phases);
+        double row_sum = 0;
+        for (int tap = 0; tap < sinc_taps; ++tap) {
+            // Tap positions relative to the interpolation point, which lies
+            // between the two center taps.
+            double x = double(tap - sinc_taps / 2 + 1) - fraction;
+            double sinc = x == 0 ? cutoff : sin(M_PI * cutoff * x) / (M_PI * x);
+            double window = 0.5 + 0.5 * cos(M_PI * x / (sinc_taps / 2));
+            double coefficient = sinc * window;
+            m_filter_table[phase * sinc_taps + tap] = coefficient;
+            row_sum += coefficient;
+        }
+        for (int tap = 0; tap < sinc_taps; ++tap)
+            m_filter_table[phase * sinc_taps + tap] /= row_sum;
+    }
+}
+
+void Resampler::reset()
+{
+    m_phase = 0;
+    m_history.clear();
+}
+
+void Resampler::process(const Frame* input, size_t frame_count, Vector<Frame>& output)
+{
+    if (is_passthrough()) {
+        output.append(input, frame_count);
+        return;
+    }
+
+    if (m_quality == Quality::WindowedSinc)
+        process_windowed_sinc(input, frame_count, output);
+    else
+        process_linear(input, frame_count, output);
+}
+
+void Resampler::process_linear(const Frame* input, size_t frame_count, Vector<Frame>& output)
+{
+    // The carried-over frames and the new chunk form one contiguous signal.
+    Vector<Frame> signal;
+    signal.ensure_capacity(m_history.size() + frame_count);
+    signal.append(m_history.data(), m_history.size());
+    signal.append(input, frame_count);
+
+    if (signal.size() < 2)
+        return;
+
+    double position = m_phase;
+    output.ensure_capacity(output.size() + size_t(double(signal.size()) / m_step) + 1);
+    while (size_t(position) + 1 < signal.size()) {
+        size_t index = size_t(position);
+        double fraction = position - double(index);
+        f64x2 const t = { fraction, fraction };
+        auto a = load_frame(signal[index]);
+        auto b = load_frame(signal[index + 1]);
+        Frame frame;
+        store_frame(frame, a + (b - a) * t);
+        output.append(frame);
+        position += m_step;
+    }
+
+    // Keep everything from the frame the next output will interpolate from.
+    size_t keep_from = min(size_t(position), signal.size() - 1);
+    m_history.clear();
+    for (size_t i = keep_from; i < signal.size(); ++i)
+        m_history.append(signal[i]);
+    m_phase = position - double(keep_from);
+}
+
+void Resampler::process_windowed_sinc(const Frame* input, size_t frame_count, Vector<Frame>& output)
+{
+    constexpr int half_taps = sinc_taps / 2;
+
+    // Prime the history with silence so the first outputs have a full set of
+    // taps to read from.
+    if (m_history.is_empty()) {
+        m_history.resize(sinc_taps);
+        m_phase = half_taps;
+    }
+
+    Vector<Frame> signal;
+    signal.ensure_capacity(m_history.size() + frame_count);
+    signal.append(m_history.data(), m_history.size());
+    signal.append(input, frame_count);
+
+    double position = m_phase;
+    output.ensure_capacity(output.size() + size_t(double(signal.size()) / m_step) + 1);
+    while (size_t(position) + half_taps < signal.size()) {
+        size_t index = size_t(position);
+        double fraction = position - double(index);
+        int phase = int(fraction * sinc_phases);
+        const double* coefficients = &m_filter_table[phase * sinc_taps];
+
+        f64x2 accumulator = { 0, 0 };
+        const Frame* taps = &signal[index - half_taps + 1];
+        for (int tap = 0; tap < sinc_taps; ++tap) {
+            f64x2 const coefficient = { coefficients[tap], coefficients[tap] };
+            accumulator += load_frame(taps[tap]) * coefficient;
+        }
+        Frame frame;
+        store_frame(frame, accumulator);
+        frame.clip();
+        output.append(frame);
+        position += m_step;
+    }
+
+    // The next output still reads half_taps - 1 frames behind its position.
+    size_t keep_from = size_t(position) - (half_taps - 1);
+    m_history.clear();
+    for (size_t i = keep_from; i < signal.size(); ++i)
+        m_history.append(signal[i]);
+    m_phase = position - double(keep_from);
+}
+
+}
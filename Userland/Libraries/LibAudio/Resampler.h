@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+#include <AK/Vector.h>
+#include <LibAudio/Buffer.h>
+
+namespace Audio {
+
+// Converts a stream of frames from one sample rate to another.
+//
+// Two quality tiers are available: Linear interpolates between neighbouring
+// input frames and is cheap enough for realtime paths, WindowedSinc runs a
+// polyphase windowed-sinc filter whose coefficient table is precomputed in
+// the constructor.
+//
+// Phase and filter history carry over between process() calls, so keep one
+// Resampler per stream and feed it consecutive chunks.
+class Resampler {
+public:
+    enum class Quality {
+        Linear,
+        WindowedSinc,
+    };
+
+    Resampler(u32 source_rate, u32 target_rate, Quality = Quality::Linear);
+
+    u32 source_rate() const { return m_source_rate; }
+    u32 target_rate() const { return m_target_rate; }
+    Quality quality() const { return m_quality; }
+
+    // True when resampling would be a 1:1 copy; callers can skip the
+    // resampler entirely in that case.
+    bool is_passthrough() const { return m_source_rate == m_target_rate; }
+
+    // Appends the resampled frames to output. Input frames that are still
+    // needed as filter history for the next chunk are retained internally.
+    void process(const Frame* input, size_t frame_count, Vector<Frame>& output);
+    void process(const Vector<Frame>& input, Vector<Frame>& output)
+    {
+        process(input.data(), input.size(), output);
+    }
+
+    // Drops the carried-over phase and history, e.g. after a seek.
+    void reset();
+
+private:
+    static constexpr int sinc_taps = 16;
+    static constexpr int sinc_phases = 128;
+
+    void build_filter_table();
+    void process_linear(const Frame* input, size_t frame_count, Vector<Frame>& output);
+    void process_windowed_sinc(const Frame* input, size_t frame_count, Vector<Frame>& output);
+
+    u32 m_source_rate { 0 };
+    u32 m_target_rate { 0 };
+    Quality m_quality { Quality::Linear };
+
+    // Source frames consumed per output frame.
+    double m_step { 1.0 };
+    // Read position in source frames, relative to the start of m_history.
+    double m_phase { 0 };
+
+    // sinc_phases rows of sinc_taps coefficients, each row normalized to
+    // unity gain. Only built for the WindowedSinc tier.
+    Vector<double> m_filter_table;
+    Vector<Frame> m_history;
+};
+
+}
@@ -29,7 +29,9 @@ WavLoaderPlugin::WavLoaderPlugin(const StringView& path)
     if (!valid)
         return;
 
-    m_resampler = make<ResampleHelper>(m_sample_rate, 44100);
+    // Loading happens off the playback path, so spend the extra cycles on
+    // the windowed-sinc tier.
+    m_resampler = make<Resampler>(m_sample_rate, 44100, Resampler::Quality::WindowedSinc);
 }
 
 WavLoaderPlugin::WavLoaderPlugin(const ByteBuffer& buffer)
@@ -44,7 +46,7 @@ WavLoaderPlugin::WavLoaderPlugin(const ByteBuffer& buffer)
     if (!valid)
         return;
 
-    m_resampler = make<ResampleHelper>(m_sample_rate, 44100);
+    m_resampler = make<Resampler>(m_sample_rate, 44100, Resampler::Quality::WindowedSinc);
 }
 
 bool WavLoaderPlugin::sniff()
@@ -81,7 +83,15 @@ void WavLoaderPlugin::seek(const int position)
         return;
 
     m_loaded_samples = position;
-    size_t byte_position = position * m_num_channels * (pcm_bits_per_sample(m_sample_format) / 8);
+
+    // The frames buffered as filter history belong to the old position.
+    if (m_resampler)
+        m_resampler->reset();
+
+    // PCM frames have a fixed size, so any position maps straight to a byte
+    // offset; no index is needed. Note that sample 0 lives just past the
+    // header, not at byte 0.
+    size_t byte_position = m_byte_offset_of_data_samples + position * m_num_channels * (pcm_bits_per_sample(m_sample_format) / 8);
 
     if (m_file)
         m_file->seek(byte_position);
@@ -98,12 +108,14 @@ bool WavLoaderPlugin::parse_header()
 {
     OwnPtr<Core::IODeviceStreamReader> file_stream;
     bool ok = true;
+    size_t bytes_read = 0;
 
     if (m_file)
         file_stream = make<Core::IODeviceStreamReader>(*m_file);
 
     auto read_u8 = [&]() -> u8 {
         u8 value;
+        bytes_read += sizeof(value);
         if (m_file) {
             *file_stream >> value;
             if (file_stream->handle_read_failure())
@@ -118,6 +130,7 @@ bool WavLoaderPlugin::parse_header()
 
     auto read_u16 = [&]() -> u16 {
         u16 value;
+        bytes_read += sizeof(value);
         if (m_file) {
             *file_stream >> value;
             if (file_stream->handle_read_failure())
@@ -132,6 +145,7 @@ bool WavLoaderPlugin::parse_header()
 
     auto read_u32 = [&]() -> u32 {
         u32 value;
+        bytes_read += sizeof(value);
         if (m_file) {
             *file_stream >> value;
             if (file_stream->handle_read_failure())
@@ -253,31 +267,10 @@ bool WavLoaderPlugin::parse_header()
     int bytes_per_sample = (bits_per_sample / 8) * m_num_channels;
     m_total_samples = data_sz / bytes_per_sample;
 
-    return true;
-}
-
-ResampleHelper::ResampleHelper(double source, double target)
-    : m_ratio(source / target)
-{
-}
-
-void ResampleHelper::process_sample(double sample_l, double sample_r)
-{
-    m_last_sample_l = sample_l;
-    m_last_sample_r = sample_r;
-    m_current_ratio += 1;
-}
+    // Everything read so far is header; sample data starts right here.
+    m_byte_offset_of_data_samples = bytes_read;
 
-bool ResampleHelper::read_sample(double& next_l, double& next_r)
-{
-    if (m_current_ratio > 0) {
-        m_current_ratio -= m_ratio;
-        next_l = m_last_sample_l;
-        next_r = m_last_sample_r;
-        return true;
-    }
-
-    return false;
+    return true;
 }
 
 }
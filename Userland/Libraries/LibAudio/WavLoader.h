@@ -15,6 +15,7 @@
 #include <AK/StringView.h>
 #include <LibAudio/Buffer.h>
 #include <LibAudio/Loader.h>
+#include <LibAudio/Resampler.h>
 #include <LibCore/File.h>
 
 namespace Audio {
@@ -57,7 +58,7 @@ private:
     RefPtr<Core::File> m_file;
     OwnPtr<InputMemoryStream> m_stream;
     String m_error_string;
-    OwnPtr<ResampleHelper> m_resampler;
+    OwnPtr<Resampler> m_resampler;
 
     u32 m_sample_rate { 0 };
     u16 m_num_channels { 0 };
@@ -65,6 +66,7 @@ private:
 
     int m_loaded_samples { 0 };
     int m_total_samples { 0 };
+    size_t m_byte_offset_of_data_samples { 0 };
 };
 
 }
@@ -14,7 +14,6 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <sys/stat.h>
 #include <syscall.h>
 #include <unistd.h>
 
@@ -57,11 +56,12 @@ void rewinddir(DIR* dirp)
 struct [[gnu::packed]] sys_dirent {
     ino_t ino;
     u8 file_type;
+    off_t size;
     size_t namelen;
     char name[];
     size_t total_size()
     {
-        return sizeof(ino_t) + sizeof(u8) + sizeof(size_t) + sizeof(char) * namelen;
+        return sizeof(ino_t) + sizeof(u8) + sizeof(off_t) + sizeof(size_t) + sizeof(char) * namelen;
     }
 };
 
@@ -70,6 +70,7 @@ static void create_struct_dirent(sys_dirent* sys_ent, struct dirent* str_ent)
     str_ent->d_ino = sys_ent->ino;
     str_ent->d_type = sys_ent->file_type;
     str_ent->d_off = 0;
+    str_ent->d_size = sys_ent->size;
     str_ent->d_reclen = sizeof(struct dirent);
 
     VERIFY(sizeof(str_ent->d_name) > sys_ent->namelen);
@@ -81,47 +82,23 @@ static void create_struct_dirent(sys_dirent* sys_ent, struct dirent* str_ent)
     str_ent->d_name[sys_ent->namelen] = '\0';
 }
 
-static int allocate_dirp_buffer(DIR* dirp)
-{
-    if (dirp->buffer) {
-        return 0;
-    }
+static constexpr size_t DIRP_BUFFER_SIZE = 4096;
 
-    struct stat st;
-    // preserve errno since this could be a reentrant call
-    int old_errno = errno;
-    int rc = fstat(dirp->fd, &st);
-    if (rc < 0) {
-        int new_errno = errno;
-        errno = old_errno;
-        return new_errno;
-    }
-    size_t size_to_allocate = max(st.st_size, static_cast<off_t>(4096));
-    dirp->buffer = (char*)malloc(size_to_allocate);
-    if (!dirp->buffer)
-        return ENOMEM;
-    for (;;) {
-        ssize_t nread = syscall(SC_get_dir_entries, dirp->fd, dirp->buffer, size_to_allocate);
-        if (nread < 0) {
-            if (nread == -EINVAL) {
-                size_to_allocate *= 2;
-                char* new_buffer = (char*)realloc(dirp->buffer, size_to_allocate);
-                if (new_buffer) {
-                    dirp->buffer = new_buffer;
-                    continue;
-                } else {
-                    nread = -ENOMEM;
-                }
-            }
-            // uh-oh, the syscall returned an error
-            free(dirp->buffer);
-            dirp->buffer = nullptr;
-            return -nread;
-        }
-        dirp->buffer_size = nread;
-        dirp->nextptr = dirp->buffer;
-        break;
+static int fill_dirp_buffer(DIR* dirp)
+{
+    if (!dirp->buffer) {
+        dirp->buffer = (char*)malloc(DIRP_BUFFER_SIZE);
+        if (!dirp->buffer)
+            return ENOMEM;
     }
+    // The kernel keeps a cursor in the file offset and streams as many entries
+    // as fit into the buffer, so we don't have to guess the directory's total
+    // serialized size up front. A read of zero bytes means end-of-directory.
+    ssize_t nread = syscall(SC_get_dir_entries, dirp->fd, dirp->buffer, DIRP_BUFFER_SIZE);
+    if (nread < 0)
+        return -nread;
+    dirp->buffer_size = nread;
+    dirp->nextptr = dirp->buffer;
     return 0;
 }
 
@@ -132,15 +109,16 @@ dirent* readdir(DIR* dirp)
     if (dirp->fd == -1)
         return nullptr;
 
-    if (int new_errno = allocate_dirp_buffer(dirp)) {
-        // readdir is allowed to mutate errno
-        errno = new_errno;
-        return nullptr;
+    if (!dirp->buffer || dirp->nextptr >= (dirp->buffer + dirp->buffer_size)) {
+        if (int new_errno = fill_dirp_buffer(dirp)) {
+            // readdir is allowed to mutate errno
+            errno = new_errno;
+            return nullptr;
+        }
+        if (dirp->buffer_size == 0)
+            return nullptr;
     }
 
-    if (dirp->nextptr >= (dirp->buffer + dirp->buffer_size))
-        return nullptr;
-
     auto* sys_ent = (sys_dirent*)dirp->nextptr;
     create_struct_dirent(sys_ent, &dirp->cur_ent);
 
@@ -165,9 +143,11 @@ int readdir_r(DIR* dirp, struct dirent* entry, struct dirent** result)
         return EBADF;
     }
 
-    if (int new_errno = allocate_dirp_buffer(dirp)) {
-        *result = nullptr;
-        return new_errno;
+    if (!dirp->buffer) {
+        if (int new_errno = fill_dirp_buffer(dirp)) {
+            *result = nullptr;
+            return new_errno;
+        }
     }
 
     // This doesn't care about dirp state; seek until we find the entry.
@@ -184,10 +164,19 @@ int readdir_r(DIR* dirp, struct dirent* entry, struct dirent** result)
         sys_ent = (sys_dirent*)buffer;
     }
 
-    // If we found one, but hit end of buffer, then EOD
+    // If we found one, but hit end of buffer, stream in the next batch.
     if (found && buffer >= dirp->buffer + dirp->buffer_size) {
-        *result = nullptr;
-        return 0;
+        if (int new_errno = fill_dirp_buffer(dirp)) {
+            *result = nullptr;
+            return new_errno;
+        }
+        if (dirp->buffer_size == 0) {
+            // End of directory.
+            *result = nullptr;
+            return 0;
+        }
+        buffer = dirp->buffer;
+        sys_ent = (sys_dirent*)buffer;
     }
     // If we never found a match for entry in buffer, start from the beginning
     else if (!found) {
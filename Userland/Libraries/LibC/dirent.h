@@ -36,6 +36,9 @@ struct dirent {
     off_t d_off;
     unsigned short d_reclen;
     unsigned char d_type;
+    // Serenity extension: the file's size as reported by the inode, so
+    // listing a directory doesn't require a stat() per entry.
+    off_t d_size;
     char d_name[256];
 };
 
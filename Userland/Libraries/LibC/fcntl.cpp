@@ -23,6 +23,12 @@ int fcntl(int fd, int cmd, ...)
     __RETURN_WITH_ERRNO(rc, rc, -1);
 }
 
+ssize_t splice(int in_fd, int out_fd, size_t count)
+{
+    int rc = syscall(SC_splice, in_fd, out_fd, count);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
+
 int create_inode_watcher(unsigned flags)
 {
     int rc = syscall(SC_create_inode_watcher, flags);
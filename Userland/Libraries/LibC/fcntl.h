@@ -44,6 +44,7 @@ int open(const char* path, int options, ...);
 int openat(int dirfd, const char* path, int options, ...);
 
 int fcntl(int fd, int cmd, ...);
+ssize_t splice(int in_fd, int out_fd, size_t count);
 int create_inode_watcher(unsigned flags);
 int inode_watcher_add_watch(int fd, const char* path, size_t path_length, unsigned event_mask);
 int inode_watcher_remove_watch(int fd, int wd);
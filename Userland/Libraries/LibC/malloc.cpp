@@ -6,6 +6,7 @@
 
 #include <AK/Debug.h>
 #include <AK/InlineLinkedList.h>
+#include <AK/Optional.h>
 #include <AK/ScopedValueRollback.h>
 #include <AK/Vector.h>
 #include <LibELF/AuxiliaryVector.h>
@@ -34,8 +35,9 @@ static Threading::Lock& malloc_lock()
 }
 
 constexpr size_t number_of_hot_chunked_blocks_to_keep_around = 16;
-constexpr size_t number_of_cold_chunked_blocks_to_keep_around = 16;
+constexpr size_t number_of_cold_chunked_blocks_to_keep_around = 32;
 constexpr size_t number_of_big_blocks_to_keep_around_per_size_class = 8;
+constexpr size_t number_of_big_allocators = 3;
 
 static bool s_log_malloc = false;
 static bool s_scrub_malloc = true;
@@ -89,6 +91,9 @@ struct MallocStats {
     size_t number_of_hot_keeps;
     size_t number_of_cold_keeps;
     size_t number_of_frees;
+
+    size_t number_of_thread_cache_hits;
+    size_t number_of_thread_cache_puts;
 };
 static MallocStats g_malloc_stats = {};
 
@@ -115,17 +120,43 @@ struct BigAllocator {
 // them. We could have used AK::NeverDestoyed to prevent the latter,
 // but it would have not helped with the former.
 static u8 g_allocators_storage[sizeof(Allocator) * num_size_classes];
-static u8 g_big_allocators_storage[sizeof(BigAllocator)];
+static u8 g_big_allocators_storage[sizeof(BigAllocator) * number_of_big_allocators];
 
 static inline Allocator (&allocators())[num_size_classes]
 {
     return reinterpret_cast<Allocator(&)[num_size_classes]>(g_allocators_storage);
 }
 
-static inline BigAllocator (&big_allocators())[1]
+static inline BigAllocator (&big_allocators())[number_of_big_allocators]
 {
-    return reinterpret_cast<BigAllocator(&)[1]>(g_big_allocators_storage);
+    return reinterpret_cast<BigAllocator(&)[number_of_big_allocators]>(g_big_allocators_storage);
+}
+
+// The hot size classes (everything up to 128 bytes) additionally get a small
+// per-thread cache of chunks. Chunks in the cache still look allocated to the
+// central allocator, so cache hits and cache puts don't take the malloc lock
+// at all; the cache flushes half its entries back through the locked path
+// when it overflows, and everything on thread exit.
+static constexpr size_t number_of_cached_size_classes = 5;
+static_assert(size_classes[number_of_cached_size_classes - 1] == 128);
+static constexpr size_t number_of_chunks_to_cache_per_size_class = 32;
+
+#ifndef NO_TLS
+struct ThreadCache {
+    FreelistEntry* freelist[number_of_cached_size_classes];
+    size_t count[number_of_cached_size_classes];
+};
+static __thread ThreadCache t_thread_cache;
+
+static Optional<size_t> cached_size_class_index(size_t size)
+{
+    for (size_t i = 0; i < number_of_cached_size_classes; ++i) {
+        if (size <= size_classes[i])
+            return i;
+    }
+    return {};
 }
+#endif
 
 static Allocator* allocator_for_size(size_t size, size_t& good_size)
 {
@@ -142,8 +173,11 @@ static Allocator* allocator_for_size(size_t size, size_t& good_size)
 #ifdef RECYCLE_BIG_ALLOCATIONS
 static BigAllocator* big_allocator_for_size(size_t size)
 {
-    if (size == 65536)
-        return &big_allocators()[0];
+    // Big allocation sizes are multiples of the block size, so the recycled
+    // classes cover 64, 128 and 192 KiB allocations.
+    size_t class_index = size / ChunkedBlock::block_size - 1;
+    if (class_index < number_of_big_allocators)
+        return &big_allocators()[class_index];
     return nullptr;
 }
 #endif
@@ -170,8 +204,6 @@ enum class CallerWillInitializeMemory {
 
 static void* malloc_impl(size_t size, CallerWillInitializeMemory caller_will_initialize_memory)
 {
-    Threading::Locker locker(malloc_lock());
-
     if (s_log_malloc)
         dbgln("LibC: malloc({})", size);
 
@@ -183,6 +215,23 @@ static void* malloc_impl(size_t size, CallerWillInitializeMemory caller_will_ini
 
     g_malloc_stats.number_of_malloc_calls++;
 
+#ifndef NO_TLS
+    if (auto class_index = cached_size_class_index(size); class_index.has_value()) {
+        auto& cache = t_thread_cache;
+        if (auto* entry = cache.freelist[class_index.value()]) {
+            cache.freelist[class_index.value()] = entry->next;
+            --cache.count[class_index.value()];
+            g_malloc_stats.number_of_thread_cache_hits++;
+            if (s_scrub_malloc && caller_will_initialize_memory == CallerWillInitializeMemory::No)
+                memset(entry, MALLOC_SCRUB_BYTE, size_classes[class_index.value()]);
+            ue_notify_malloc(entry, size);
+            return entry;
+        }
+    }
+#endif
+
+    Threading::Locker locker(malloc_lock());
+
     size_t good_size;
     auto* allocator = allocator_for_size(size, good_size);
 
@@ -297,17 +346,8 @@ static void* malloc_impl(size_t size, CallerWillInitializeMemory caller_will_ini
     return ptr;
 }
 
-static void free_impl(void* ptr)
+static void free_locked(void* ptr)
 {
-    ScopedValueRollback rollback(errno);
-
-    if (!ptr)
-        return;
-
-    g_malloc_stats.number_of_free_calls++;
-
-    Threading::Locker locker(malloc_lock());
-
     void* block_base = (void*)((FlatPtr)ptr & ChunkedBlock::ChunkedBlock::block_mask);
     size_t magic = *(size_t*)block_base;
 
@@ -386,6 +426,57 @@ static void free_impl(void* ptr)
     }
 }
 
+#ifndef NO_TLS
+static void flush_thread_cache(size_t class_index, size_t target_count)
+{
+    auto& cache = t_thread_cache;
+    Threading::Locker locker(malloc_lock());
+    while (cache.count[class_index] > target_count) {
+        auto* entry = cache.freelist[class_index];
+        cache.freelist[class_index] = entry->next;
+        --cache.count[class_index];
+        free_locked(entry);
+    }
+}
+#endif
+
+static void free_impl(void* ptr)
+{
+    ScopedValueRollback rollback(errno);
+
+    if (!ptr)
+        return;
+
+    g_malloc_stats.number_of_free_calls++;
+
+#ifndef NO_TLS
+    // Fast path: put chunks from the hot size classes on the per-thread cache
+    // instead of handing them back to the central allocator. The block holding
+    // this chunk can't go away or change size class while one of its chunks is
+    // still allocated, so peeking at its header is safe without the lock.
+    void* block_base = (void*)((FlatPtr)ptr & ChunkedBlock::block_mask);
+    if (*(size_t*)block_base == MAGIC_PAGE_HEADER) {
+        auto* block = (ChunkedBlock*)block_base;
+        if (auto class_index = cached_size_class_index(block->m_size); class_index.has_value()) {
+            auto& cache = t_thread_cache;
+            if (cache.count[class_index.value()] >= number_of_chunks_to_cache_per_size_class)
+                flush_thread_cache(class_index.value(), number_of_chunks_to_cache_per_size_class / 2);
+            if (s_scrub_free)
+                memset(ptr, FREE_SCRUB_BYTE, block->m_size);
+            auto* entry = (FreelistEntry*)ptr;
+            entry->next = cache.freelist[class_index.value()];
+            cache.freelist[class_index.value()] = entry;
+            ++cache.count[class_index.value()];
+            g_malloc_stats.number_of_thread_cache_puts++;
+            return;
+        }
+    }
+#endif
+
+    Threading::Locker locker(malloc_lock());
+    free_locked(ptr);
+}
+
 [[gnu::flatten]] void* malloc(size_t size)
 {
     void* ptr = malloc_impl(size, CallerWillInitializeMemory::No);
@@ -481,7 +572,16 @@ void __malloc_init()
         allocators()[i].size = size_classes[i];
     }
 
-    new (&big_allocators()[0])(BigAllocator);
+    for (size_t i = 0; i < number_of_big_allocators; ++i)
+        new (&big_allocators()[i])(BigAllocator);
+}
+
+void __malloc_thread_cleanup()
+{
+#ifndef NO_TLS
+    for (size_t i = 0; i < number_of_cached_size_classes; ++i)
+        flush_thread_cache(i, 0);
+#endif
 }
 
 void serenity_dump_malloc_stats()
@@ -507,5 +607,8 @@ void serenity_dump_malloc_stats()
     dbgln("number of hot keeps: {}", g_malloc_stats.number_of_hot_keeps);
     dbgln("number of cold keeps: {}", g_malloc_stats.number_of_cold_keeps);
     dbgln("number of frees: {}", g_malloc_stats.number_of_frees);
+    dbgln();
+    dbgln("thread cache hits: {}", g_malloc_stats.number_of_thread_cache_hits);
+    dbgln("thread cache puts: {}", g_malloc_stats.number_of_thread_cache_puts);
 }
 }
@@ -10,10 +10,22 @@
 #include <bits/pthread_integration.h>
 #include <errno.h>
 #include <sched.h>
+#include <serenity.h>
 #include <unistd.h>
 
 namespace {
 
+// The mutex lock word cycles between these three states. Unlocking only has
+// to enter the kernel when the word says someone is waiting down there.
+constexpr u32 MUTEX_UNLOCKED = 0;
+constexpr u32 MUTEX_LOCKED_NO_NEED_TO_WAKE = 1;
+constexpr u32 MUTEX_LOCKED_NEED_TO_WAKE = 2;
+
+// How long to spin on a contended mutex before waiting in the kernel.
+// Short critical sections running on another core usually clear up well
+// within this, sparing us the futex syscall round trip.
+constexpr int mutex_spin_limit = 40;
+
 // Most programs don't need this, no need to incur an extra mutex lock/unlock on them
 static Atomic<bool> g_did_touch_atfork { false };
 static pthread_mutex_t g_atfork_list_mutex __PTHREAD_MUTEX_INITIALIZER;
@@ -95,20 +107,45 @@ int __pthread_mutex_lock(pthread_mutex_t* mutex)
 {
     auto& atomic = reinterpret_cast<Atomic<u32>&>(mutex->lock);
     pthread_t this_thread = __pthread_self();
-    for (;;) {
-        u32 expected = false;
-        if (!atomic.compare_exchange_strong(expected, true, AK::memory_order_acq_rel)) {
-            if (mutex->type == __PTHREAD_MUTEX_RECURSIVE && mutex->owner == this_thread) {
-                mutex->level++;
-                return 0;
-            }
-            sched_yield();
-            continue;
-        }
+
+    // Fast path: grab an uncontended mutex without involving the kernel.
+    u32 value = MUTEX_UNLOCKED;
+    if (atomic.compare_exchange_strong(value, MUTEX_LOCKED_NO_NEED_TO_WAKE, AK::memory_order_acquire)) {
         mutex->owner = this_thread;
         mutex->level = 0;
         return 0;
     }
+
+    if (mutex->type == __PTHREAD_MUTEX_RECURSIVE && mutex->owner == this_thread) {
+        mutex->level++;
+        return 0;
+    }
+
+    // Spin for a bit in the hope that the holder is mid-critical-section on
+    // another core and about to let go.
+    for (int i = 0; i < mutex_spin_limit; ++i) {
+        if (atomic.load(AK::memory_order_relaxed) == MUTEX_UNLOCKED) {
+            value = MUTEX_UNLOCKED;
+            if (atomic.compare_exchange_strong(value, MUTEX_LOCKED_NO_NEED_TO_WAKE, AK::memory_order_acquire)) {
+                mutex->owner = this_thread;
+                mutex->level = 0;
+                return 0;
+            }
+        }
+        asm volatile("pause");
+    }
+
+    // The holder is taking its time; flag the mutex as contended so whoever
+    // unlocks it knows to wake us, then wait in the kernel.
+    value = atomic.exchange(MUTEX_LOCKED_NEED_TO_WAKE, AK::memory_order_acquire);
+    while (value != MUTEX_UNLOCKED) {
+        futex(&mutex->lock, FUTEX_WAIT, MUTEX_LOCKED_NEED_TO_WAKE, nullptr, nullptr, 0);
+        value = atomic.exchange(MUTEX_LOCKED_NEED_TO_WAKE, AK::memory_order_acquire);
+    }
+
+    mutex->owner = this_thread;
+    mutex->level = 0;
+    return 0;
 }
 
 int pthread_mutex_lock(pthread_mutex_t*) __attribute__((weak, alias("__pthread_mutex_lock")));
@@ -120,7 +157,10 @@ int __pthread_mutex_unlock(pthread_mutex_t* mutex)
         return 0;
     }
     mutex->owner = 0;
-    mutex->lock = 0;
+    auto& atomic = reinterpret_cast<Atomic<u32>&>(mutex->lock);
+    u32 value = atomic.exchange(MUTEX_UNLOCKED, AK::memory_order_release);
+    if (value == MUTEX_LOCKED_NEED_TO_WAKE)
+        futex(&mutex->lock, FUTEX_WAKE, 1, nullptr, nullptr, 0);
     return 0;
 }
 
@@ -129,8 +169,8 @@ int pthread_mutex_unlock(pthread_mutex_t*) __attribute__((weak, alias("__pthread
 int __pthread_mutex_trylock(pthread_mutex_t* mutex)
 {
     auto& atomic = reinterpret_cast<Atomic<u32>&>(mutex->lock);
-    u32 expected = false;
-    if (!atomic.compare_exchange_strong(expected, true, AK::memory_order_acq_rel)) {
+    u32 expected = MUTEX_UNLOCKED;
+    if (!atomic.compare_exchange_strong(expected, MUTEX_LOCKED_NO_NEED_TO_WAKE, AK::memory_order_acquire)) {
         if (mutex->type == __PTHREAD_MUTEX_RECURSIVE && mutex->owner == pthread_self()) {
             mutex->level++;
             return 0;
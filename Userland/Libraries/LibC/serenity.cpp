@@ -107,6 +107,38 @@ int anon_create(size_t size, int options)
     __RETURN_WITH_ERRNO(rc, rc, -1);
 }
 
+int async_io_create(void)
+{
+    int rc = syscall(SC_async_io_create);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
+
+ssize_t async_io_submit(int ring_fd, size_t count)
+{
+    int rc = syscall(SC_async_io_submit, ring_fd, count);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
+
+int event_queue_create(void)
+{
+    int rc = syscall(SC_event_queue_create);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
+
+int event_queue_ctl(int queue_fd, int op, int fd, uint32_t events)
+{
+    Syscall::SC_event_queue_ctl_params params { queue_fd, op, fd, events };
+    int rc = syscall(SC_event_queue_ctl, &params);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
+
+int event_queue_wait(int queue_fd, struct EventQueueEvent* events, int max_events, const struct timespec* timeout)
+{
+    Syscall::SC_event_queue_wait_params params { queue_fd, events, max_events, timeout };
+    int rc = syscall(SC_event_queue_wait, &params);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
+
 int serenity_readlink(const char* path, size_t path_length, char* buffer, size_t buffer_size)
 {
     Syscall::SC_readlink_params small_params {
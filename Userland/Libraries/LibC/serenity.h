@@ -90,6 +90,8 @@ enum {
     PERF_EVENT_KMALLOC = 2048,
     PERF_EVENT_KFREE = 4096,
     PERF_EVENT_PAGE_FAULT = 8192,
+    PERF_EVENT_SPAN_BEGIN = 16384,
+    PERF_EVENT_SPAN_END = 32768,
 };
 
 #define PERF_EVENT_MASK_ALL (~0ull)
@@ -100,6 +102,15 @@ int get_stack_bounds(uintptr_t* user_stack_base, size_t* user_stack_size);
 
 int anon_create(size_t size, int options);
 
+int async_io_create(void);
+ssize_t async_io_submit(int ring_fd, size_t count);
+
+struct EventQueueEvent;
+struct timespec;
+int event_queue_create(void);
+int event_queue_ctl(int queue_fd, int op, int fd, uint32_t events);
+int event_queue_wait(int queue_fd, struct EventQueueEvent* events, int max_events, const struct timespec* timeout);
+
 int serenity_readlink(const char* path, size_t path_length, char* buffer, size_t buffer_size);
 
 int getkeymap(char* name_buffer, size_t name_buffer_size, uint32_t* map, uint32_t* shift_map, uint32_t* alt_map, uint32_t* altgr_map, uint32_t* shift_altgr_map);
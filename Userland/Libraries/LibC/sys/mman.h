@@ -18,6 +18,7 @@
 #define MAP_STACK 0x40
 #define MAP_NORESERVE 0x80
 #define MAP_RANDOMIZED 0x100
+#define MAP_HUGEPAGES 0x200
 
 #define PROT_READ 0x1
 #define PROT_WRITE 0x2
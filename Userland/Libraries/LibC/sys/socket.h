@@ -67,6 +67,11 @@ struct msghdr {
     int msg_flags;
 };
 
+struct mmsghdr {
+    struct msghdr msg_hdr;
+    unsigned msg_len;
+};
+
 struct sockaddr {
     sa_family_t sa_family;
     char sa_data[14];
@@ -94,6 +99,7 @@ enum {
     SO_KEEPALIVE,
     SO_TIMESTAMP,
     SO_BROADCAST,
+    SO_REUSEPORT,
 };
 #define SO_RCVTIMEO SO_RCVTIMEO
 #define SO_SNDTIMEO SO_SNDTIMEO
@@ -101,6 +107,7 @@ enum {
 #define SO_ERROR SO_ERROR
 #define SO_PEERCRED SO_PEERCRED
 #define SO_REUSEADDR SO_REUSEADDR
+#define SO_REUSEPORT SO_REUSEPORT
 #define SO_BINDTODEVICE SO_BINDTODEVICE
 #define SO_KEEPALIVE SO_KEEPALIVE
 #define SO_TIMESTAMP SO_TIMESTAMP
@@ -135,6 +142,7 @@ ssize_t sendmsg(int sockfd, const struct msghdr*, int flags);
 ssize_t sendto(int sockfd, const void*, size_t, int flags, const struct sockaddr*, socklen_t);
 ssize_t recv(int sockfd, void*, size_t, int flags);
 ssize_t recvmsg(int sockfd, struct msghdr*, int flags);
+int recvmmsg(int sockfd, struct mmsghdr*, unsigned vlen, int flags);
 ssize_t recvfrom(int sockfd, void*, size_t, int flags, struct sockaddr*, socklen_t*);
 int getsockopt(int sockfd, int level, int option, void*, socklen_t*);
 int setsockopt(int sockfd, int level, int option, const void*, socklen_t);
@@ -153,6 +153,11 @@ public:
     Color turn() const { return m_turn; }
     const Vector<Move>& moves() const { return m_moves; }
 
+    bool white_can_castle_kingside() const { return m_white_can_castle_kingside; }
+    bool white_can_castle_queenside() const { return m_white_can_castle_queenside; }
+    bool black_can_castle_kingside() const { return m_black_can_castle_kingside; }
+    bool black_can_castle_queenside() const { return m_black_can_castle_queenside; }
+
     bool operator==(const Board& other) const;
 
 private:
@@ -220,17 +220,12 @@ bool GzipDecompressor::handle_any_error()
     return Stream::handle_any_error() || handled_errors;
 }
 
-GzipCompressor::GzipCompressor(OutputStream& stream)
+GzipCompressor::GzipCompressor(OutputStream& stream, DeflateCompressor::CompressionLevel compression_level)
     : m_output_stream(stream)
+    , m_compressed_stream(stream, compression_level)
 {
-}
-
-GzipCompressor::~GzipCompressor()
-{
-}
-
-size_t GzipCompressor::write(ReadonlyBytes bytes)
-{
+    // The member header goes out before any deflate output; the deflate
+    // stream doesn't write anything until its first block is flushed.
     BlockHeader header;
     header.identification_1 = 0x1f;
     header.identification_2 = 0x8b;
@@ -240,14 +235,20 @@ size_t GzipCompressor::write(ReadonlyBytes bytes)
     header.extra_flags = 3;      // DEFLATE sets 2 for maximum compression and 4 for minimum compression
     header.operating_system = 3; // unix
     m_output_stream << Bytes { &header, sizeof(header) };
-    DeflateCompressor compressed_stream { m_output_stream };
-    VERIFY(compressed_stream.write_or_error(bytes));
-    compressed_stream.final_flush();
-    Crypto::Checksum::CRC32 crc32;
-    crc32.update(bytes);
-    LittleEndian<u32> digest = crc32.digest();
-    LittleEndian<u32> size = bytes.size();
-    m_output_stream << digest << size;
+}
+
+GzipCompressor::~GzipCompressor()
+{
+    VERIFY(m_finished);
+}
+
+size_t GzipCompressor::write(ReadonlyBytes bytes)
+{
+    VERIFY(!m_finished);
+    if (!m_compressed_stream.write_or_error(bytes))
+        return 0;
+    m_crc32.update(bytes);
+    m_total_bytes += bytes.size();
     return bytes.size();
 }
 
@@ -261,12 +262,23 @@ bool GzipCompressor::write_or_error(ReadonlyBytes bytes)
     return true;
 }
 
-Optional<ByteBuffer> GzipCompressor::compress_all(const ReadonlyBytes& bytes)
+void GzipCompressor::final_flush()
+{
+    VERIFY(!m_finished);
+    m_finished = true;
+    m_compressed_stream.final_flush();
+    LittleEndian<u32> digest = m_crc32.digest();
+    LittleEndian<u32> size = m_total_bytes;
+    m_output_stream << digest << size;
+}
+
+Optional<ByteBuffer> GzipCompressor::compress_all(const ReadonlyBytes& bytes, DeflateCompressor::CompressionLevel compression_level)
 {
     DuplexMemoryStream output_stream;
-    GzipCompressor gzip_stream { output_stream };
+    GzipCompressor gzip_stream { output_stream, compression_level };
 
     gzip_stream.write_or_error(bytes);
+    gzip_stream.final_flush();
 
     if (gzip_stream.handle_any_error())
         return {};
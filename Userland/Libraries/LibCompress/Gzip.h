@@ -81,16 +81,21 @@ private:
 
 class GzipCompressor final : public OutputStream {
 public:
-    GzipCompressor(OutputStream&);
+    GzipCompressor(OutputStream&, DeflateCompressor::CompressionLevel = DeflateCompressor::CompressionLevel::GOOD);
     ~GzipCompressor();
 
     size_t write(ReadonlyBytes) override;
     bool write_or_error(ReadonlyBytes) override;
+    void final_flush();
 
-    static Optional<ByteBuffer> compress_all(const ReadonlyBytes& bytes);
+    static Optional<ByteBuffer> compress_all(const ReadonlyBytes& bytes, DeflateCompressor::CompressionLevel = DeflateCompressor::CompressionLevel::GOOD);
 
 private:
+    bool m_finished { false };
     OutputStream& m_output_stream;
+    DeflateCompressor m_compressed_stream;
+    Crypto::Checksum::CRC32 m_crc32;
+    size_t m_total_bytes { 0 };
 };
 
 }
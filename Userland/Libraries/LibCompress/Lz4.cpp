@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Endian.h>
+#include <AK/NumericLimits.h>
+#include <LibCompress/Lz4.h>
+
+namespace Compress {
+
+// LZ4 block format constants.
+static constexpr size_t min_match_length = 4;     // back-references are at least 4 bytes
+static constexpr size_t last_literals = 5;        // the last 5 bytes of a block are always literals
+static constexpr size_t match_find_limit = 12;    // the last match must start at least 12 bytes before the end
+static constexpr size_t max_match_offset = 65535; // offsets are stored in 16 bits
+static constexpr size_t hash_bits = 12;           // 4096-entry hash table, as in the reference implementation
+
+static constexpr u8 lz4_container_magic[4] = { 'L', 'Z', '4', 'B' };
+static constexpr size_t container_header_size = sizeof(lz4_container_magic) + sizeof(u32);
+
+static constexpr u8 lz4_chunked_magic[4] = { 'L', 'Z', '4', 'S' };
+static constexpr size_t chunk_header_size = 2 * sizeof(u32);
+
+ALWAYS_INLINE static u32 read_sequence(const u8* data)
+{
+    u32 sequence;
+    __builtin_memcpy(&sequence, data, sizeof(sequence));
+    return sequence;
+}
+
+ALWAYS_INLINE static u32 hash_sequence(u32 sequence)
+{
+    // Knuth multiplicative hash, same recipe as the deflate compressor.
+    return (sequence * 2654435761u) >> (32 - hash_bits);
+}
+
+size_t Lz4::maximum_compressed_size(size_t input_size)
+{
+    return input_size + input_size / 255 + 16;
+}
+
+Optional<size_t> Lz4::compress_block(ReadonlyBytes input, Bytes output)
+{
+    u32 hash_table[1 << hash_bits] {};
+
+    const u8* in = input.data();
+    u8* out = output.data();
+    const size_t input_size = input.size();
+    size_t output_position = 0;
+    size_t anchor = 0;
+
+    auto emit_length = [&](size_t length) {
+        while (length >= 255) {
+            if (output_position >= output.size())
+                return false;
+            out[output_position++] = 255;
+            length -= 255;
+        }
+        if (output_position >= output.size())
+            return false;
+        out[output_position++] = (u8)length;
+        return true;
+    };
+
+    // Emits one sequence: literals from anchor onwards, then (unless this
+    // is the final literal-only sequence) a back-reference.
+    auto emit_sequence = [&](size_t literal_count, size_t match_length, size_t offset) {
+        if (output_position >= output.size())
+            return false;
+        u8 token = (u8)(min<size_t>(literal_count, 15) << 4);
+        if (match_length)
+            token |= (u8)min<size_t>(match_length - min_match_length, 15);
+        out[output_position++] = token;
+        if (literal_count >= 15 && !emit_length(literal_count - 15))
+            return false;
+        if (output_position + literal_count > output.size())
+            return false;
+        __builtin_memcpy(out + output_position, in + anchor, literal_count);
+        output_position += literal_count;
+        if (!match_length)
+            return true;
+        if (output_position + 2 > output.size())
+            return false;
+        out[output_position++] = (u8)(offset & 0xff);
+        out[output_position++] = (u8)(offset >> 8);
+        if (match_length - min_match_length >= 15 && !emit_length(match_length - min_match_length - 15))
+            return false;
+        return true;
+    };
+
+    if (input_size > match_find_limit) {
+        const size_t match_limit = input_size - last_literals;
+        size_t position = 0;
+        while (position + match_find_limit <= input_size) {
+            u32 sequence = read_sequence(in + position);
+            u32 hash = hash_sequence(sequence);
+            size_t candidate = hash_table[hash];
+            hash_table[hash] = (u32)position;
+
+            if (candidate >= position || position - candidate > max_match_offset || read_sequence(in + candidate) != sequence) {
+                ++position;
+                continue;
+            }
+
+            size_t match_length = min_match_length;
+            while (position + match_length < match_limit && in[candidate + match_length] == in[position + match_length])
+                ++match_length;
+
+            if (!emit_sequence(position - anchor, match_length, position - candidate))
+                return {};
+            position += match_length;
+            anchor = position;
+        }
+    }
+
+    // The final sequence contains only literals.
+    if (!emit_sequence(input_size - anchor, 0, 0))
+        return {};
+    return output_position;
+}
+
+Optional<size_t> Lz4::decompress_block(ReadonlyBytes input, Bytes output)
+{
+    const u8* in = input.data();
+    u8* out = output.data();
+    size_t input_position = 0;
+    size_t output_position = 0;
+
+    auto read_length = [&](size_t& length) {
+        u8 byte;
+        do {
+            if (input_position >= input.size())
+                return false;
+            byte = in[input_position++];
+            length += byte;
+        } while (byte == 255);
+        return true;
+    };
+
+    while (input_position < input.size()) {
+        u8 token = in[input_position++];
+
+        size_t literal_count = token >> 4;
+        if (literal_count == 15 && !read_length(literal_count))
+            return {};
+        if (input_position + literal_count > input.size() || output_position + literal_count > output.size())
+            return {};
+        __builtin_memcpy(out + output_position, in + input_position, literal_count);
+        input_position += literal_count;
+        output_position += literal_count;
+
+        if (input_position == input.size())
+            break; // the last sequence carries no back-reference
+
+        if (input_position + 2 > input.size())
+            return {};
+        size_t offset = in[input_position] | (in[input_position + 1] << 8);
+        input_position += 2;
+        if (offset == 0 || offset > output_position)
+            return {};
+
+        size_t match_length = token & 0xf;
+        if (match_length == 15 && !read_length(match_length))
+            return {};
+        match_length += min_match_length;
+        if (output_position + match_length > output.size())
+            return {};
+
+        // Matches may overlap their own output (offset 1 repeats the
+        // previous byte), so this must copy forwards one byte at a time.
+        for (size_t i = 0; i < match_length; ++i, ++output_position)
+            out[output_position] = out[output_position - offset];
+    }
+    return output_position;
+}
+
+static bool is_chunked_container(ReadonlyBytes bytes)
+{
+    return bytes.size() >= sizeof(lz4_chunked_magic) && __builtin_memcmp(bytes.data(), lz4_chunked_magic, sizeof(lz4_chunked_magic)) == 0;
+}
+
+bool Lz4::is_likely_compressed(ReadonlyBytes bytes)
+{
+    if (bytes.size() >= sizeof(lz4_container_magic) && __builtin_memcmp(bytes.data(), lz4_container_magic, sizeof(lz4_container_magic)) == 0)
+        return true;
+    return is_chunked_container(bytes);
+}
+
+Optional<ByteBuffer> Lz4::compress_all(const ReadonlyBytes& bytes)
+{
+    if (bytes.size() > NumericLimits<u32>::max())
+        return {};
+
+    auto output = ByteBuffer::create_uninitialized(container_header_size + maximum_compressed_size(bytes.size()));
+    __builtin_memcpy(output.data(), lz4_container_magic, sizeof(lz4_container_magic));
+    LittleEndian<u32> uncompressed_size = bytes.size();
+    __builtin_memcpy(output.data() + sizeof(lz4_container_magic), &uncompressed_size, sizeof(uncompressed_size));
+
+    auto compressed_size = compress_block(bytes, output.bytes().slice(container_header_size));
+    if (!compressed_size.has_value())
+        return {};
+    output.trim(container_header_size + compressed_size.value());
+    return output;
+}
+
+static Optional<ByteBuffer> decompress_all_chunked(ReadonlyBytes bytes)
+{
+    auto read_chunk_header = [&](size_t position, u32& uncompressed_size, u32& compressed_size) {
+        if (position + chunk_header_size > bytes.size())
+            return false;
+        LittleEndian<u32> value;
+        __builtin_memcpy(&value, bytes.data() + position, sizeof(value));
+        uncompressed_size = value;
+        __builtin_memcpy(&value, bytes.data() + position + sizeof(value), sizeof(value));
+        compressed_size = value;
+        return compressed_size <= bytes.size() - position - chunk_header_size;
+    };
+
+    // First pass: walk the chunk headers to size the output buffer.
+    size_t total_uncompressed_size = 0;
+    size_t position = sizeof(lz4_chunked_magic);
+    while (position < bytes.size()) {
+        u32 uncompressed_size, compressed_size;
+        if (!read_chunk_header(position, uncompressed_size, compressed_size))
+            return {};
+        total_uncompressed_size += uncompressed_size;
+        position += chunk_header_size + compressed_size;
+    }
+
+    auto output = ByteBuffer::create_uninitialized(total_uncompressed_size);
+    size_t output_position = 0;
+    position = sizeof(lz4_chunked_magic);
+    while (position < bytes.size()) {
+        u32 uncompressed_size, compressed_size;
+        if (!read_chunk_header(position, uncompressed_size, compressed_size))
+            return {};
+        auto block = bytes.slice(position + chunk_header_size, compressed_size);
+        auto decompressed_size = Lz4::decompress_block(block, output.bytes().slice(output_position, uncompressed_size));
+        if (!decompressed_size.has_value() || decompressed_size.value() != uncompressed_size)
+            return {};
+        output_position += uncompressed_size;
+        position += chunk_header_size + compressed_size;
+    }
+    return output;
+}
+
+Optional<ByteBuffer> Lz4::decompress_all(const ReadonlyBytes& bytes)
+{
+    if (is_chunked_container(bytes))
+        return decompress_all_chunked(bytes);
+
+    if (bytes.size() < container_header_size || !is_likely_compressed(bytes))
+        return {};
+
+    LittleEndian<u32> uncompressed_size;
+    __builtin_memcpy(&uncompressed_size, bytes.data() + sizeof(lz4_container_magic), sizeof(uncompressed_size));
+
+    auto output = ByteBuffer::create_uninitialized(uncompressed_size);
+    auto decompressed_size = decompress_block(bytes.slice(container_header_size), output.bytes());
+    if (!decompressed_size.has_value() || decompressed_size.value() != uncompressed_size)
+        return {};
+    return output;
+}
+
+size_t Lz4::maximum_compressed_chunk_size(size_t input_size)
+{
+    return chunk_header_size + maximum_compressed_size(input_size);
+}
+
+size_t Lz4::write_chunked_header(Bytes output)
+{
+    VERIFY(output.size() >= sizeof(lz4_chunked_magic));
+    __builtin_memcpy(output.data(), lz4_chunked_magic, sizeof(lz4_chunked_magic));
+    return sizeof(lz4_chunked_magic);
+}
+
+Optional<size_t> Lz4::compress_chunk(ReadonlyBytes input, Bytes output)
+{
+    if (input.size() > NumericLimits<u32>::max() || output.size() < chunk_header_size)
+        return {};
+    auto compressed_size = compress_block(input, output.slice(chunk_header_size));
+    if (!compressed_size.has_value())
+        return {};
+    LittleEndian<u32> uncompressed_size = input.size();
+    LittleEndian<u32> block_size = compressed_size.value();
+    __builtin_memcpy(output.data(), &uncompressed_size, sizeof(uncompressed_size));
+    __builtin_memcpy(output.data() + sizeof(uncompressed_size), &block_size, sizeof(block_size));
+    return chunk_header_size + compressed_size.value();
+}
+
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/Optional.h>
+#include <AK/Span.h>
+
+namespace Compress {
+
+// A fast byte-oriented codec implementing the LZ4 block format
+// (https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md).
+//
+// LZ4 trades compression ratio for speed: it emits raw literals and
+// 16-bit back-references with no entropy coding, so both directions run
+// an order of magnitude faster than deflate. Use it where compression
+// sits on a latency-sensitive path (coredumps, IPC payloads) and use
+// deflate/gzip where the output size matters more.
+//
+// The block format does not record the decompressed size, so the raw
+// compress_block()/decompress_block() primitives leave that to the
+// caller. compress_all()/decompress_all() wrap a single block in a tiny
+// container ("LZ4B" magic followed by the little-endian u32 uncompressed
+// size) for whole-buffer consumers that have nowhere else to keep it.
+class Lz4 {
+public:
+    // The worst case (incompressible input) expands by one length byte
+    // per 255 literals, plus a small constant for the final sequence.
+    static size_t maximum_compressed_size(size_t input_size);
+
+    // Returns the number of bytes written, or nothing if output is too
+    // small (size it with maximum_compressed_size()).
+    static Optional<size_t> compress_block(ReadonlyBytes input, Bytes output);
+
+    // Returns the number of bytes written, or nothing if the input is
+    // malformed or decompresses to more than output can hold.
+    static Optional<size_t> decompress_block(ReadonlyBytes input, Bytes output);
+
+    static Optional<ByteBuffer> compress_all(const ReadonlyBytes&);
+    static Optional<ByteBuffer> decompress_all(const ReadonlyBytes&);
+    static bool is_likely_compressed(ReadonlyBytes);
+
+    // Producers that cannot hold their whole output in memory (e.g. the
+    // kernel coredump writer) use the chunked container instead: the
+    // "LZ4S" magic followed by any number of chunks, each a pair of
+    // little-endian u32s (uncompressed size, compressed size) and an LZ4
+    // block. Write the magic once with write_chunked_header(), then one
+    // compress_chunk() per buffer-full; decompress_all() accepts both
+    // container flavors.
+    static size_t maximum_compressed_chunk_size(size_t input_size);
+    static size_t write_chunked_header(Bytes output);
+    static Optional<size_t> compress_chunk(ReadonlyBytes input, Bytes output);
+};
+
+}
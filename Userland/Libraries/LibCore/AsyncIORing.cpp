@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/AsyncIORing.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// Only supported in serenity mode because we use the async I/O ring syscalls.
+#ifdef __serenity__
+
+#    include <serenity.h>
+
+namespace Core {
+
+AsyncIORing::AsyncIORing(Object* parent)
+    : Object(parent)
+{
+    m_ring_fd = async_io_create();
+    VERIFY(m_ring_fd >= 0);
+
+    auto* shared_page = mmap(nullptr, PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, m_ring_fd, 0);
+    VERIFY(shared_page != MAP_FAILED);
+
+    m_header = reinterpret_cast<AsyncIORingHeader*>(shared_page);
+    m_sqes = reinterpret_cast<AsyncIORingSQE*>((u8*)shared_page + m_header->sqe_array_offset);
+    m_cqes = reinterpret_cast<AsyncIORingCQE*>((u8*)shared_page + m_header->cqe_array_offset);
+
+    m_notifier = Notifier::construct(m_ring_fd, Notifier::Event::Read, this);
+    m_notifier->on_ready_to_read = [this] {
+        drain_completions();
+    };
+}
+
+AsyncIORing::~AsyncIORing()
+{
+    munmap(m_header, PAGE_SIZE);
+    close(m_ring_fd);
+}
+
+bool AsyncIORing::enqueue(u32 opcode, int fd, u64 buffer, u32 length, u64 offset, OnComplete on_complete)
+{
+    if (m_header->sq_tail - m_header->sq_head >= m_header->sq_entry_count)
+        return false;
+
+    auto& sqe = m_sqes[m_header->sq_tail % m_header->sq_entry_count];
+    sqe.opcode = opcode;
+    sqe.fd = fd;
+    sqe.buffer = buffer;
+    sqe.length = length;
+    sqe.offset = offset;
+    sqe.user_data = m_next_user_data++;
+
+    m_pending.set(sqe.user_data, move(on_complete));
+    ++m_header->sq_tail;
+    ++m_unsubmitted_count;
+    return true;
+}
+
+bool AsyncIORing::enqueue_read(int fd, void* buffer, size_t length, u64 offset, OnComplete on_complete)
+{
+    return enqueue(AsyncIORingSQE::Read, fd, (FlatPtr)buffer, length, offset, move(on_complete));
+}
+
+bool AsyncIORing::enqueue_write(int fd, const void* buffer, size_t length, u64 offset, OnComplete on_complete)
+{
+    return enqueue(AsyncIORingSQE::Write, fd, (FlatPtr)buffer, length, offset, move(on_complete));
+}
+
+bool AsyncIORing::enqueue_fsync(int fd, OnComplete on_complete)
+{
+    return enqueue(AsyncIORingSQE::Fsync, fd, 0, 0, 0, move(on_complete));
+}
+
+size_t AsyncIORing::submit()
+{
+    if (!m_unsubmitted_count)
+        return 0;
+
+    auto rc = async_io_submit(m_ring_fd, m_unsubmitted_count);
+    if (rc < 0) {
+        perror("async_io_submit");
+        return 0;
+    }
+
+    m_unsubmitted_count -= rc;
+    return rc;
+}
+
+void AsyncIORing::drain_completions()
+{
+    while (m_header->cq_head != m_header->cq_tail) {
+        auto cqe = m_cqes[m_header->cq_head % m_header->cq_entry_count];
+        ++m_header->cq_head;
+
+        auto it = m_pending.find(cqe.user_data);
+        if (it == m_pending.end())
+            continue;
+        auto callback = move(it->value);
+        m_pending.remove(it);
+        if (callback)
+            callback(cqe.result);
+    }
+}
+
+}
+
+#endif
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/HashMap.h>
+#include <Kernel/API/AsyncIORing.h>
+#include <LibCore/Notifier.h>
+#include <LibCore/Object.h>
+
+namespace Core {
+
+// Wraps a kernel async I/O ring: operations are queued up, kicked into the
+// kernel in one batch by submit(), and each completion callback is invoked
+// from the event loop once the ring's fd signals pending completions.
+class AsyncIORing final : public Object {
+    C_OBJECT(AsyncIORing)
+public:
+    virtual ~AsyncIORing() override;
+
+    using OnComplete = Function<void(i64 result)>;
+
+    static constexpr u64 use_file_offset = async_io_ring_no_offset;
+
+    bool enqueue_read(int fd, void* buffer, size_t length, u64 offset, OnComplete);
+    bool enqueue_write(int fd, const void* buffer, size_t length, u64 offset, OnComplete);
+    bool enqueue_fsync(int fd, OnComplete);
+
+    // Returns the number of queued operations accepted by the kernel.
+    size_t submit();
+
+private:
+    explicit AsyncIORing(Object* parent = nullptr);
+
+    bool enqueue(u32 opcode, int fd, u64 buffer, u32 length, u64 offset, OnComplete);
+    void drain_completions();
+
+    int m_ring_fd { -1 };
+    AsyncIORingHeader* m_header { nullptr };
+    AsyncIORingSQE* m_sqes { nullptr };
+    AsyncIORingCQE* m_cqes { nullptr };
+
+    RefPtr<Notifier> m_notifier;
+    HashMap<u64, OnComplete> m_pending;
+    u64 m_next_user_data { 1 };
+    size_t m_unsubmitted_count { 0 };
+};
+
+}
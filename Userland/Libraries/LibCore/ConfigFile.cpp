@@ -5,16 +5,45 @@
  */
 
 #include <AK/ByteBuffer.h>
+#include <AK/MappedFile.h>
 #include <AK/StringBuilder.h>
 #include <LibCore/ConfigFile.h>
 #include <LibCore/File.h>
 #include <LibCore/StandardPaths.h>
+#include <fcntl.h>
 #include <pwd.h>
 #include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 namespace Core {
 
+// Parsed ini files are mirrored into a binary cache under ~/.cache/ini, so
+// that the next application start can load them with a single mmap() instead
+// of parsing text line by line. A cache entry is only valid while the mtime
+// and size of the source file it was built from are unchanged.
+struct [[gnu::packed]] ConfigFileCacheHeader {
+    u32 magic;
+    u32 version;
+    u64 source_mtime;
+    u64 source_size;
+    u32 group_count;
+};
+
+static constexpr u32 config_file_cache_magic = 0x494e4943; // 'INIC'
+static constexpr u32 config_file_cache_version = 1;
+
+static String config_file_cache_path(const String& filename)
+{
+    auto home = StandardPaths::home_directory();
+    if (home.is_empty())
+        return {};
+    auto escaped = filename;
+    escaped.replace("/", "_", true);
+    return String::formatted("{}/.cache/ini/{}.cache", home, escaped);
+}
+
 NonnullRefPtr<ConfigFile> ConfigFile::get_for_lib(const String& lib_name)
 {
     String directory = StandardPaths::config_directory();
@@ -52,10 +81,122 @@ ConfigFile::~ConfigFile()
     sync();
 }
 
+bool ConfigFile::try_load_cache(u64 source_mtime, u64 source_size)
+{
+    auto cache_path = config_file_cache_path(m_filename);
+    if (cache_path.is_null())
+        return false;
+
+    auto file_or_error = MappedFile::map(cache_path);
+    if (file_or_error.is_error())
+        return false;
+    auto file = file_or_error.release_value();
+
+    const u8* data = (const u8*)file->data();
+    size_t size = file->size();
+    if (size < sizeof(ConfigFileCacheHeader))
+        return false;
+
+    ConfigFileCacheHeader header;
+    memcpy(&header, data, sizeof(header));
+    if (header.magic != config_file_cache_magic || header.version != config_file_cache_version)
+        return false;
+    if (header.source_mtime != source_mtime || header.source_size != source_size)
+        return false;
+
+    size_t offset = sizeof(ConfigFileCacheHeader);
+    auto read_u32 = [&](u32& value) {
+        if (size - offset < sizeof(u32))
+            return false;
+        memcpy(&value, &data[offset], sizeof(u32));
+        offset += sizeof(u32);
+        return true;
+    };
+    auto read_string = [&](String& string) {
+        u32 length = 0;
+        if (!read_u32(length))
+            return false;
+        if (size - offset < length)
+            return false;
+        string = String((const char*)&data[offset], length);
+        offset += length;
+        return true;
+    };
+    auto cache_corrupt = [&] {
+        m_groups.clear();
+        return false;
+    };
+
+    for (u32 group_index = 0; group_index < header.group_count; ++group_index) {
+        String group_name;
+        u32 entry_count = 0;
+        if (!read_string(group_name) || !read_u32(entry_count))
+            return cache_corrupt();
+        auto& group = m_groups.ensure(group_name);
+        for (u32 entry_index = 0; entry_index < entry_count; ++entry_index) {
+            String key;
+            String value;
+            if (!read_string(key) || !read_string(value))
+                return cache_corrupt();
+            group.set(key, value);
+        }
+    }
+    return true;
+}
+
+void ConfigFile::write_cache(u64 source_mtime, u64 source_size) const
+{
+    auto cache_path = config_file_cache_path(m_filename);
+    if (cache_path.is_null())
+        return;
+
+    Vector<u8> buffer;
+    auto append_u32 = [&](u32 value) {
+        buffer.append((const u8*)&value, sizeof(value));
+    };
+    auto append_string = [&](const String& string) {
+        append_u32(string.length());
+        buffer.append((const u8*)string.characters(), string.length());
+    };
+
+    ConfigFileCacheHeader header { config_file_cache_magic, config_file_cache_version, source_mtime, source_size, (u32)m_groups.size() };
+    buffer.append((const u8*)&header, sizeof(header));
+    for (auto& group : m_groups) {
+        append_string(group.key);
+        append_u32(group.value.size());
+        for (auto& entry : group.value) {
+            append_string(entry.key);
+            append_string(entry.value);
+        }
+    }
+
+    // The cache is strictly best-effort: if any of this fails (e.g. because
+    // the caller has unveiled ~/.cache away), the next start simply parses
+    // the ini text again.
+    auto home = StandardPaths::home_directory();
+    if (home.is_empty())
+        return;
+    mkdir(String::formatted("{}/.cache", home).characters(), 0700);
+    mkdir(String::formatted("{}/.cache/ini", home).characters(), 0700);
+
+    auto temporary_path = String::formatted("{}.tmp", cache_path);
+    int fd = ::open(temporary_path.characters(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0)
+        return;
+    bool success = write(fd, buffer.data(), buffer.size()) == (ssize_t)buffer.size();
+    close(fd);
+    if (!success || rename(temporary_path.characters(), cache_path.characters()) < 0)
+        unlink(temporary_path.characters());
+}
+
 void ConfigFile::reparse()
 {
     m_groups.clear();
 
+    struct stat st;
+    if (stat(m_filename.characters(), &st) == 0 && try_load_cache(st.st_mtime, st.st_size))
+        return;
+
     auto file = File::construct(m_filename);
     if (!file->open(OpenMode::ReadOnly))
         return;
@@ -165,6 +306,14 @@ bool ConfigFile::sync()
     fclose(fp);
 
     m_dirty = false;
+
+    // Refresh the binary cache so the next start of this (or any other)
+    // application can skip the text parse. Doing this only on sync() keeps
+    // read-only consumers from ever needing write access.
+    struct stat st;
+    if (stat(m_filename.characters(), &st) == 0)
+        write_cache(st.st_mtime, st.st_size);
+
     return true;
 }
 
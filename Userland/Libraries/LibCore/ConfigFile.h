@@ -53,6 +53,8 @@ private:
     explicit ConfigFile(const String& filename);
 
     void reparse();
+    bool try_load_cache(u64 source_mtime, u64 source_size);
+    void write_cache(u64 source_mtime, u64 source_size) const;
 
     String m_filename;
     HashMap<String, HashMap<String, String>> m_groups;
@@ -44,6 +44,12 @@ bool DirIterator::advance_next()
         }
 
         m_next = de->d_name;
+        m_next_type = de->d_type;
+#ifdef __serenity__
+        m_next_size = de->d_size;
+#else
+        m_next_size = 0;
+#endif
         if (m_next.is_null())
             return false;
 
@@ -80,6 +86,19 @@ String DirIterator::next_full_path()
     return String::formatted("{}/{}", m_path, next_path());
 }
 
+Optional<DirIterator::DirectoryEntry> DirIterator::next_entry()
+{
+    if (m_next.is_null())
+        advance_next();
+
+    if (m_next.is_null())
+        return {};
+
+    DirectoryEntry entry { m_next, m_next_type, m_next_size };
+    m_next = String();
+    return entry;
+}
+
 String find_executable_in_path(String filename)
 {
     if (filename.starts_with('/')) {
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Optional.h>
 #include <AK/String.h>
 #include <dirent.h>
 #include <string.h>
@@ -20,6 +21,15 @@ public:
         SkipParentAndBaseDir = 0x2,
     };
 
+    // The file type (one of the DT_* constants) and size come straight from
+    // the directory stream, so callers that only need those can skip a stat()
+    // round-trip per entry.
+    struct DirectoryEntry {
+        String name;
+        unsigned char type { DT_UNKNOWN };
+        off_t size { 0 };
+    };
+
     explicit DirIterator(String path, Flags = Flags::NoFlags);
     ~DirIterator();
 
@@ -29,12 +39,15 @@ public:
     bool has_next();
     String next_path();
     String next_full_path();
+    Optional<DirectoryEntry> next_entry();
     int fd() const;
 
 private:
     DIR* m_dir = nullptr;
     int m_error = 0;
     String m_next;
+    unsigned char m_next_type { DT_UNKNOWN };
+    off_t m_next_size { 0 };
     String m_path;
     int m_flags;
 
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/DirectoryWalker.h>
+#include <sys/stat.h>
+
+namespace Core {
+
+DirectoryWalker::DirectoryWalker(String root_path, bool follow_symlinks)
+    : m_follow_symlinks(follow_symlinks)
+{
+    descend_into(root_path);
+}
+
+void DirectoryWalker::descend_into(const String& path)
+{
+    auto iterator = make<DirIterator>(path, DirIterator::SkipParentAndBaseDir);
+    if (iterator->has_error()) {
+        if (on_error)
+            on_error(path, iterator->error());
+        if (!m_stack.is_empty() && on_directory_exit)
+            on_directory_exit(path, m_stack.size() - 1);
+        return;
+    }
+    m_stack.append({ move(iterator), path });
+}
+
+void DirectoryWalker::skip_subtree()
+{
+    m_pending_directory.clear();
+}
+
+Optional<DirectoryWalker::Entry> DirectoryWalker::next()
+{
+    if (m_pending_directory.has_value()) {
+        auto directory = m_pending_directory.release_value();
+        descend_into(directory.full_path);
+    }
+
+    while (!m_stack.is_empty()) {
+        auto& level = m_stack.last();
+        auto dir_entry = level.iterator->next_entry();
+        if (!dir_entry.has_value()) {
+            if (level.iterator->has_error() && on_error)
+                on_error(level.path, level.iterator->error());
+            auto path = level.path;
+            m_stack.take_last();
+            if (!m_stack.is_empty() && on_directory_exit)
+                on_directory_exit(path, m_stack.size() - 1);
+            continue;
+        }
+
+        Entry entry;
+        entry.name = dir_entry->name;
+        entry.full_path = String::formatted("{}/{}", level.path, dir_entry->name);
+        entry.type = dir_entry->type;
+        entry.size = dir_entry->size;
+        entry.depth = m_stack.size() - 1;
+
+        // Not every filesystem fills in d_type, and a symlink only counts as
+        // a directory if we're following symlinks; fall back to stat() for
+        // those two cases.
+        if (entry.type == DT_UNKNOWN || (entry.type == DT_LNK && m_follow_symlinks)) {
+            struct stat st;
+            int rc = m_follow_symlinks ? ::stat(entry.full_path.characters(), &st) : ::lstat(entry.full_path.characters(), &st);
+            if (rc == 0 && S_ISDIR(st.st_mode))
+                entry.type = DT_DIR;
+        }
+
+        if (entry.type == DT_DIR)
+            m_pending_directory = entry;
+        return entry;
+    }
+
+    return {};
+}
+
+}
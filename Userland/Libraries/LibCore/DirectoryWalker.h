@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <LibCore/DirIterator.h>
+
+namespace Core {
+
+// Streams a directory tree depth-first. File type and size come straight
+// from the directory stream (see DirIterator::next_entry()), so a walk
+// doesn't cost a stat() per entry. The walker keeps one open directory
+// stream per level, so memory use is bounded by the depth of the tree, not
+// its size.
+class DirectoryWalker {
+public:
+    struct Entry {
+        String full_path;
+        String name;
+        unsigned char type { DT_UNKNOWN }; // One of the DT_* constants.
+        off_t size { 0 };
+        size_t depth { 0 }; // 0 for immediate children of the root.
+    };
+
+    explicit DirectoryWalker(String root_path, bool follow_symlinks = false);
+
+    // Returns entries in depth-first order, or an empty Optional once the
+    // walk is complete.
+    Optional<Entry> next();
+
+    // Call after next() returned a directory to avoid descending into it.
+    void skip_subtree();
+
+    // Called when a directory cannot be opened or read; the walk continues
+    // with its siblings.
+    Function<void(const String& path, int error)> on_error;
+
+    // Called once the walker is done with a directory it tried to descend
+    // into: after the last entry beneath it, or right away if it could not
+    // be opened. Not called for the root itself.
+    Function<void(const String& path, size_t depth)> on_directory_exit;
+
+private:
+    struct Level {
+        NonnullOwnPtr<DirIterator> iterator;
+        String path;
+    };
+
+    void descend_into(const String& path);
+
+    Vector<Level> m_stack;
+    Optional<Entry> m_pending_directory;
+    bool m_follow_symlinks { false };
+};
+
+}
@@ -35,6 +35,11 @@
 #include <time.h>
 #include <unistd.h>
 
+#ifdef __serenity__
+#    include <Kernel/API/EventQueue.h>
+#    include <serenity.h>
+#endif
+
 namespace Core {
 
 class InspectorServerConnection;
@@ -62,6 +67,12 @@ static Vector<EventLoop*>* s_event_loop_stack;
 static NeverDestroyed<IDAllocator> s_id_allocator;
 static HashMap<int, NonnullOwnPtr<EventLoopTimer>>* s_timers;
 static HashTable<Notifier*>* s_notifiers;
+#ifdef __serenity__
+// On Serenity the fds we're interested in live in a kernel-side event queue,
+// so waiting doesn't have to re-submit (or linearly re-scan) them every time.
+static HashMap<int, Notifier*>* s_notifiers_by_fd;
+static int s_event_queue_fd = -1;
+#endif
 int EventLoop::s_wake_pipe_fds[2];
 static RefPtr<InspectorServerConnection> s_inspector_server_connection;
 
@@ -260,6 +271,9 @@ EventLoop::EventLoop([[maybe_unused]] MakeInspectable make_inspectable)
         s_event_loop_stack = new Vector<EventLoop*>;
         s_timers = new HashMap<int, NonnullOwnPtr<EventLoopTimer>>;
         s_notifiers = new HashTable<Notifier*>;
+#ifdef __serenity__
+        s_notifiers_by_fd = new HashMap<int, Notifier*>;
+#endif
     }
 
     if (!s_main_event_loop) {
@@ -418,6 +432,20 @@ void EventLoop::post_event(Object& receiver, NonnullOwnPtr<Event>&& event)
 {
     Threading::Locker lock(m_private->lock);
     dbgln_if(EVENTLOOP_DEBUG, "Core::EventLoop::post_event: ({}) << receivier={}, event={}", m_queued_events.size(), receiver, event);
+
+    // Only the newest queued event for this receiver is a coalescing
+    // candidate, so the order of the surviving events never changes.
+    for (size_t i = m_queued_events.size(); i > 0; --i) {
+        auto& queued_event = m_queued_events.at(i - 1);
+        if (queued_event.receiver.ptr() != &receiver)
+            continue;
+        if (receiver.should_coalesce_event(*event, *queued_event.event)) {
+            queued_event.event = move(event);
+            return;
+        }
+        break;
+    }
+
     m_queued_events.empend(receiver, move(event));
 }
 
@@ -557,6 +585,13 @@ void EventLoop::notify_forked(ForkEvent event)
         s_event_loop_stack->clear();
         s_timers->clear();
         s_notifiers->clear();
+#ifdef __serenity__
+        s_notifiers_by_fd->clear();
+        if (s_event_queue_fd >= 0) {
+            close(s_event_queue_fd);
+            s_event_queue_fd = -1;
+        }
+#endif
         if (auto* info = signals_info<false>()) {
             info->signal_handlers.clear();
             info->next_signal_id = 0;
@@ -571,6 +606,166 @@ void EventLoop::notify_forked(ForkEvent event)
     VERIFY_NOT_REACHED();
 }
 
+#ifdef __serenity__
+
+static u32 event_queue_events_for(const Notifier& notifier)
+{
+    u32 events = 0;
+    if (notifier.event_mask() & Notifier::Read)
+        events |= EVENT_QUEUE_EVENT_READ;
+    if (notifier.event_mask() & Notifier::Write)
+        events |= EVENT_QUEUE_EVENT_WRITE;
+    if (notifier.event_mask() & Notifier::Exceptional)
+        VERIFY_NOT_REACHED();
+    return events;
+}
+
+static void update_kernel_interest(const Notifier& notifier, bool keep)
+{
+    if (s_event_queue_fd < 0)
+        return;
+    u32 events = keep ? event_queue_events_for(notifier) : 0;
+    if (!events) {
+        event_queue_ctl(s_event_queue_fd, EVENT_QUEUE_DELETE, notifier.fd(), 0);
+        return;
+    }
+    if (event_queue_ctl(s_event_queue_fd, EVENT_QUEUE_ADD, notifier.fd(), events) < 0 && errno == EEXIST) {
+        int rc = event_queue_ctl(s_event_queue_fd, EVENT_QUEUE_MODIFY, notifier.fd(), events);
+        VERIFY(rc == 0);
+    }
+}
+
+void EventLoop::wait_for_event(WaitMode mode)
+{
+    // The kernel keeps the interest list between calls; notifiers registered
+    // before the queue existed are submitted here once.
+    if (s_event_queue_fd < 0) {
+        s_event_queue_fd = event_queue_create();
+        VERIFY(s_event_queue_fd >= 0);
+        int rc = event_queue_ctl(s_event_queue_fd, EVENT_QUEUE_ADD, s_wake_pipe_fds[0], EVENT_QUEUE_EVENT_READ);
+        VERIFY(rc == 0);
+        for (auto& notifier : *s_notifiers)
+            update_kernel_interest(*notifier, true);
+    }
+
+retry:;
+    bool queued_events_is_empty;
+    {
+        Threading::Locker locker(m_private->lock);
+        queued_events_is_empty = m_queued_events.is_empty();
+    }
+
+    timeval now;
+    struct timeval timeout = { 0, 0 };
+    bool should_wait_forever = false;
+    if (mode == WaitMode::WaitForEvents && queued_events_is_empty) {
+        auto next_timer_expiration = get_next_timer_expiration();
+        if (next_timer_expiration.has_value()) {
+            timespec now_spec;
+            clock_gettime(CLOCK_MONOTONIC_COARSE, &now_spec);
+            now.tv_sec = now_spec.tv_sec;
+            now.tv_usec = now_spec.tv_nsec / 1000;
+            timeval_sub(next_timer_expiration.value(), now, timeout);
+            if (timeout.tv_sec < 0 || (timeout.tv_sec == 0 && timeout.tv_usec < 0)) {
+                timeout.tv_sec = 0;
+                timeout.tv_usec = 0;
+            }
+        } else {
+            should_wait_forever = true;
+        }
+    }
+
+    EventQueueEvent ready_events[64];
+try_wait_again:;
+    struct timespec timeout_spec = { timeout.tv_sec, timeout.tv_usec * 1000 };
+    int marked_fd_count = event_queue_wait(s_event_queue_fd, ready_events, 64, should_wait_forever ? nullptr : &timeout_spec);
+    if (marked_fd_count < 0) {
+        int saved_errno = errno;
+        if (saved_errno == EINTR) {
+            if (m_exit_requested)
+                return;
+            goto try_wait_again;
+        }
+        dbgln_if(EVENTLOOP_DEBUG, "Core::EventLoop::wait_for_event: {} ({}: {})", marked_fd_count, saved_errno, strerror(saved_errno));
+        VERIFY_NOT_REACHED();
+    }
+
+    bool wake_pipe_ready = false;
+    for (int i = 0; i < marked_fd_count; ++i) {
+        if (ready_events[i].fd == s_wake_pipe_fds[0])
+            wake_pipe_ready = true;
+    }
+
+    if (wake_pipe_ready) {
+        int wake_events[8];
+        auto nread = read(s_wake_pipe_fds[0], wake_events, sizeof(wake_events));
+        if (nread < 0) {
+            perror("read from wake pipe");
+            VERIFY_NOT_REACHED();
+        }
+        VERIFY(nread > 0);
+        bool wake_requested = false;
+        int event_count = nread / sizeof(wake_events[0]);
+        for (int i = 0; i < event_count; i++) {
+            if (wake_events[i] != 0)
+                dispatch_signal(wake_events[i]);
+            else
+                wake_requested = true;
+        }
+
+        if (!wake_requested && nread == sizeof(wake_events))
+            goto retry;
+    }
+
+    if (!s_timers->is_empty()) {
+        timespec now_spec;
+        clock_gettime(CLOCK_MONOTONIC_COARSE, &now_spec);
+        now.tv_sec = now_spec.tv_sec;
+        now.tv_usec = now_spec.tv_nsec / 1000;
+    }
+
+    for (auto& it : *s_timers) {
+        auto& timer = *it.value;
+        if (!timer.has_expired(now))
+            continue;
+        auto owner = timer.owner.strong_ref();
+        if (timer.fire_when_not_visible == TimerShouldFireWhenNotVisible::No
+            && owner && !owner->is_visible_for_timer_purposes()) {
+            continue;
+        }
+
+        dbgln_if(EVENTLOOP_DEBUG, "Core::EventLoop: Timer {} has expired, sending Core::TimerEvent to {}", timer.timer_id, *owner);
+
+        if (owner)
+            post_event(*owner, make<TimerEvent>(timer.timer_id));
+        if (timer.should_reload) {
+            timer.reload(now);
+        } else {
+            // FIXME: Support removing expired timers that don't want to reload.
+            VERIFY_NOT_REACHED();
+        }
+    }
+
+    if (!marked_fd_count)
+        return;
+
+    for (int i = 0; i < marked_fd_count; ++i) {
+        auto& ready_event = ready_events[i];
+        if (ready_event.fd == s_wake_pipe_fds[0])
+            continue;
+        auto it = s_notifiers_by_fd->find(ready_event.fd);
+        if (it == s_notifiers_by_fd->end())
+            continue;
+        auto& notifier = *it->value;
+        if ((ready_event.events & EVENT_QUEUE_EVENT_READ) && (notifier.event_mask() & Notifier::Event::Read))
+            post_event(notifier, make<NotifierReadEvent>(notifier.fd()));
+        if ((ready_event.events & EVENT_QUEUE_EVENT_WRITE) && (notifier.event_mask() & Notifier::Event::Write))
+            post_event(notifier, make<NotifierWriteEvent>(notifier.fd()));
+    }
+}
+
+#else
+
 void EventLoop::wait_for_event(WaitMode mode)
 {
     fd_set rfds;
@@ -701,6 +896,8 @@ try_select_again:
     }
 }
 
+#endif
+
 bool EventLoopTimer::has_expired(const timeval& now) const
 {
     return now.tv_sec > fire_time.tv_sec || (now.tv_sec == fire_time.tv_sec && now.tv_usec >= fire_time.tv_usec);
@@ -762,11 +959,30 @@ bool EventLoop::unregister_timer(int timer_id)
 void EventLoop::register_notifier(Badge<Notifier>, Notifier& notifier)
 {
     s_notifiers->set(&notifier);
+#ifdef __serenity__
+    s_notifiers_by_fd->set(notifier.fd(), &notifier);
+    update_kernel_interest(notifier, true);
+#endif
 }
 
 void EventLoop::unregister_notifier(Badge<Notifier>, Notifier& notifier)
 {
     s_notifiers->remove(&notifier);
+#ifdef __serenity__
+    auto it = s_notifiers_by_fd->find(notifier.fd());
+    if (it != s_notifiers_by_fd->end() && it->value == &notifier) {
+        s_notifiers_by_fd->remove(it);
+        update_kernel_interest(notifier, false);
+    }
+#endif
+}
+
+void EventLoop::notifier_event_mask_changed(Badge<Notifier>, [[maybe_unused]] Notifier& notifier)
+{
+#ifdef __serenity__
+    if (s_notifiers && s_notifiers->contains(&notifier))
+        update_kernel_interest(notifier, true);
+#endif
 }
 
 void EventLoop::wake()
@@ -7,6 +7,7 @@
 #ifdef __serenity__
 #    include <serenity.h>
 #endif
+#include <AK/ByteBuffer.h>
 #include <AK/LexicalPath.h>
 #include <AK/ScopeGuard.h>
 #include <LibCore/DirIterator.h>
@@ -16,6 +17,7 @@
 #include <libgen.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/sendfile.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -345,24 +347,41 @@ Result<void, File::CopyError> File::copy_file(const String& dst_path, const stru
             return CopyError { OSError(errno), false };
     }
 
+    // Fast path: sendfile() lets the kernel shuttle the data inode-to-inode
+    // without round-tripping every chunk through userspace.
+    bool sendfile_worked = false;
     for (;;) {
-        char buffer[32768];
-        ssize_t nread = ::read(source.fd(), buffer, sizeof(buffer));
-        if (nread < 0) {
+        auto nsent = sendfile(dst_fd, source.fd(), nullptr, 4 * MiB);
+        if (nsent < 0) {
+            if (!sendfile_worked && (errno == EINVAL || errno == ENOSYS))
+                break; // Fall back to the userspace copy loop below.
             return CopyError { OSError(errno), false };
         }
-        if (nread == 0)
+        sendfile_worked = true;
+        if (nsent == 0)
             break;
-        ssize_t remaining_to_write = nread;
-        char* bufptr = buffer;
-        while (remaining_to_write) {
-            ssize_t nwritten = ::write(dst_fd, bufptr, remaining_to_write);
-            if (nwritten < 0)
-                return CopyError { OSError(errno), false };
+    }
 
-            VERIFY(nwritten > 0);
-            remaining_to_write -= nwritten;
-            bufptr += nwritten;
+    if (!sendfile_worked) {
+        auto buffer = ByteBuffer::create_uninitialized(1 * MiB);
+        for (;;) {
+            ssize_t nread = ::read(source.fd(), buffer.data(), buffer.size());
+            if (nread < 0) {
+                return CopyError { OSError(errno), false };
+            }
+            if (nread == 0)
+                break;
+            ssize_t remaining_to_write = nread;
+            u8* bufptr = buffer.data();
+            while (remaining_to_write) {
+                ssize_t nwritten = ::write(dst_fd, bufptr, remaining_to_write);
+                if (nwritten < 0)
+                    return CopyError { OSError(errno), false };
+
+                VERIFY(nwritten > 0);
+                remaining_to_write -= nwritten;
+                bufptr += nwritten;
+            }
         }
     }
 
@@ -29,67 +29,75 @@ namespace Core {
 // Only supported in serenity mode because we use InodeWatcher syscalls
 #ifdef __serenity__
 
-static Optional<FileWatcherEvent> get_event_from_fd(int fd, HashMap<unsigned, String> const& wd_to_path)
+static Vector<FileWatcherEvent> read_events_from_fd(int fd, HashMap<unsigned, String> const& wd_to_path)
 {
-    u8 buffer[MAXIMUM_EVENT_SIZE];
-    int rc = read(fd, &buffer, MAXIMUM_EVENT_SIZE);
+    // The kernel batches as many events as fit into a single read.
+    u8 buffer[32 * MAXIMUM_EVENT_SIZE];
+    int rc = read(fd, &buffer, sizeof(buffer));
     if (rc == 0) {
         return {};
     } else if (rc < 0) {
-        dbgln_if(FILE_WATCHER_DEBUG, "get_event_from_fd: Reading from wd {} failed: {}", fd, strerror(errno));
+        dbgln_if(FILE_WATCHER_DEBUG, "read_events_from_fd: Reading from fd {} failed: {}", fd, strerror(errno));
         return {};
     }
 
-    InodeWatcherEvent* event = reinterpret_cast<InodeWatcherEvent*>(buffer);
-    FileWatcherEvent result;
+    Vector<FileWatcherEvent> events;
+    size_t offset = 0;
+    while (offset + sizeof(InodeWatcherEvent) <= static_cast<size_t>(rc)) {
+        auto* event = reinterpret_cast<InodeWatcherEvent*>(buffer + offset);
+        offset += sizeof(InodeWatcherEvent) + event->name_length;
 
-    auto it = wd_to_path.find(event->watch_descriptor);
-    if (it == wd_to_path.end()) {
-        dbgln_if(FILE_WATCHER_DEBUG, "get_event_from_fd: Got an event for a non-existent wd {}?!", event->watch_descriptor);
-        return {};
-    }
-    String const& path = it->value;
-
-    switch (event->type) {
-    case InodeWatcherEvent::Type::ChildCreated:
-        result.type = FileWatcherEvent::Type::ChildCreated;
-        break;
-    case InodeWatcherEvent::Type::ChildDeleted:
-        result.type = FileWatcherEvent::Type::ChildDeleted;
-        break;
-    case InodeWatcherEvent::Type::Deleted:
-        result.type = FileWatcherEvent::Type::Deleted;
-        break;
-    case InodeWatcherEvent::Type::ContentModified:
-        result.type = FileWatcherEvent::Type::ContentModified;
-        break;
-    case InodeWatcherEvent::Type::MetadataModified:
-        result.type = FileWatcherEvent::Type::MetadataModified;
-        break;
-    default:
-        warnln("Unknown event type {} returned by the watch_file descriptor for {}", static_cast<unsigned>(event->type), path);
-        return {};
-    }
+        auto it = wd_to_path.find(event->watch_descriptor);
+        if (it == wd_to_path.end()) {
+            dbgln_if(FILE_WATCHER_DEBUG, "read_events_from_fd: Got an event for a non-existent wd {}?!", event->watch_descriptor);
+            continue;
+        }
+        String const& path = it->value;
+
+        FileWatcherEvent result;
+        switch (event->type) {
+        case InodeWatcherEvent::Type::ChildCreated:
+            result.type = FileWatcherEvent::Type::ChildCreated;
+            break;
+        case InodeWatcherEvent::Type::ChildDeleted:
+            result.type = FileWatcherEvent::Type::ChildDeleted;
+            break;
+        case InodeWatcherEvent::Type::Deleted:
+            result.type = FileWatcherEvent::Type::Deleted;
+            break;
+        case InodeWatcherEvent::Type::ContentModified:
+            result.type = FileWatcherEvent::Type::ContentModified;
+            break;
+        case InodeWatcherEvent::Type::MetadataModified:
+            result.type = FileWatcherEvent::Type::MetadataModified;
+            break;
+        default:
+            warnln("Unknown event type {} returned by the watch_file descriptor for {}", static_cast<unsigned>(event->type), path);
+            continue;
+        }
 
-    // We trust that the kernel only sends the name when appropriate.
-    if (event->name_length > 0) {
-        String child_name { event->name, event->name_length - 1 };
-        auto lexical_path = LexicalPath::join(path, child_name);
-        if (!lexical_path.is_valid()) {
-            dbgln_if(FILE_WATCHER_DEBUG, "get_event_from_fd: Reading from wd {}: Invalid child name '{}'", fd, child_name);
-            return {};
+        // We trust that the kernel only sends the name when appropriate.
+        if (event->name_length > 0) {
+            String child_name { event->name, event->name_length - 1 };
+            auto lexical_path = LexicalPath::join(path, child_name);
+            if (!lexical_path.is_valid()) {
+                dbgln_if(FILE_WATCHER_DEBUG, "read_events_from_fd: Reading from fd {}: Invalid child name '{}'", fd, child_name);
+                continue;
+            }
+
+            result.event_path = lexical_path.string();
+        } else {
+            result.event_path = path;
         }
 
-        result.event_path = lexical_path.string();
-    } else {
-        result.event_path = path;
+        dbgln_if(FILE_WATCHER_DEBUG, "read_events_from_fd: got event from wd {} on '{}' type {}", event->watch_descriptor, result.event_path, result.type);
+        events.append(move(result));
     }
 
-    dbgln_if(FILE_WATCHER_DEBUG, "get_event_from_fd: got event from wd {} on '{}' type {}", fd, result.event_path, result.type);
-    return result;
+    return events;
 }
 
-Result<bool, String> FileWatcherBase::add_watch(String path, FileWatcherEvent::Type event_mask)
+Result<bool, String> FileWatcherBase::add_watch(String path, FileWatcherEvent::Type event_mask, bool recursive)
 {
     LexicalPath lexical_path;
     if (path.length() > 0 && path[0] == '/') {
@@ -123,7 +131,11 @@ Result<bool, String> FileWatcherBase::add_watch(String path, FileWatcherEvent::T
     if (has_flag(event_mask, FileWatcherEvent::Type::MetadataModified))
         kernel_mask |= InodeWatcherEvent::Type::MetadataModified;
 
-    int wd = inode_watcher_add_watch(m_watcher_fd, canonical_path.characters(), canonical_path.length(), static_cast<unsigned>(kernel_mask));
+    unsigned mask_bits = static_cast<unsigned>(kernel_mask);
+    if (recursive)
+        mask_bits |= INODE_WATCHER_RECURSIVE;
+
+    int wd = inode_watcher_add_watch(m_watcher_fd, canonical_path.characters(), canonical_path.length(), mask_bits);
     if (wd < 0)
         return String::formatted("Could not watch file '{}' : {}", canonical_path, strerror(errno));
 
@@ -185,11 +197,12 @@ Optional<FileWatcherEvent> BlockingFileWatcher::wait_for_event()
 {
     dbgln_if(FILE_WATCHER_DEBUG, "BlockingFileWatcher::wait_for_event()");
 
-    auto maybe_event = get_event_from_fd(m_watcher_fd, m_wd_to_path);
-    if (!maybe_event.has_value())
-        return maybe_event;
+    if (m_pending_events.is_empty())
+        m_pending_events = read_events_from_fd(m_watcher_fd, m_wd_to_path);
+    if (m_pending_events.is_empty())
+        return {};
 
-    auto event = maybe_event.release_value();
+    auto event = m_pending_events.take_first();
     if (event.type == FileWatcherEvent::Type::Deleted) {
         auto result = remove_watch(event.event_path);
         if (result.is_error()) {
@@ -216,11 +229,18 @@ FileWatcher::FileWatcher(int watcher_fd, NonnullRefPtr<Notifier> notifier)
     , m_notifier(move(notifier))
 {
     m_notifier->on_ready_to_read = [this] {
-        auto maybe_event = get_event_from_fd(m_notifier->fd(), m_wd_to_path);
-        if (maybe_event.has_value()) {
-            auto event = maybe_event.value();
-            on_change(event);
+        auto events = read_events_from_fd(m_notifier->fd(), m_wd_to_path);
+        if (events.is_empty())
+            return;
+
+        if (on_batch) {
+            on_batch(events);
+        } else if (on_change) {
+            for (auto& event : events)
+                on_change(event);
+        }
 
+        for (auto& event : events) {
             if (event.type == FileWatcherEvent::Type::Deleted) {
                 auto result = remove_watch(event.event_path);
                 if (result.is_error()) {
@@ -14,6 +14,7 @@
 #include <AK/RefCounted.h>
 #include <AK/Result.h>
 #include <AK/String.h>
+#include <AK/Vector.h>
 #include <Kernel/API/InodeWatcherEvent.h>
 #include <Kernel/API/InodeWatcherFlags.h>
 #include <LibCore/Notifier.h>
@@ -39,7 +40,9 @@ class FileWatcherBase {
 public:
     virtual ~FileWatcherBase() { }
 
-    Result<bool, String> add_watch(String path, FileWatcherEvent::Type event_mask);
+    // A recursive watch covers the whole directory tree below the given path;
+    // events from subdirectories carry the full path of the affected file.
+    Result<bool, String> add_watch(String path, FileWatcherEvent::Type event_mask, bool recursive = false);
     Result<bool, String> remove_watch(String path);
     bool is_watching(String const& path) const { return m_path_to_wd.find(path) != m_path_to_wd.end(); }
 
@@ -62,6 +65,9 @@ public:
     ~BlockingFileWatcher();
 
     Optional<FileWatcherEvent> wait_for_event();
+
+private:
+    Vector<FileWatcherEvent> m_pending_events;
 };
 
 class FileWatcher final : public FileWatcherBase
@@ -72,6 +78,9 @@ public:
     static Result<NonnullRefPtr<FileWatcher>, String> create(InodeWatcherFlags = InodeWatcherFlags::None);
     ~FileWatcher();
 
+    // If set, takes precedence over on_change and receives all events from a
+    // single read in one batch.
+    Function<void(Vector<FileWatcherEvent> const&)> on_batch;
     Function<void(FileWatcherEvent const&)> on_change;
 
 private:
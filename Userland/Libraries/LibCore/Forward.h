@@ -10,6 +10,7 @@ namespace Core {
 
 class AnonymousBuffer;
 class ArgsParser;
+class AsyncIORing;
 class ChildEvent;
 class ConfigFile;
 class CustomEvent;
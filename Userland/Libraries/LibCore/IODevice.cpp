@@ -32,9 +32,32 @@ const char* IODevice::error_string() const
 
 int IODevice::read(u8* buffer, int length)
 {
-    auto read_buffer = read(length);
-    memcpy(buffer, read_buffer.data(), length);
-    return read_buffer.size();
+    if (m_fd < 0 || length <= 0)
+        return 0;
+    // Read straight into the caller's buffer; this overload exists so hot
+    // paths can reuse one buffer instead of allocating a ByteBuffer per read.
+    size_t remaining_buffer_space = (size_t)length;
+    size_t taken_from_buffered = 0;
+    if (!m_buffered_data.is_empty()) {
+        taken_from_buffered = min(remaining_buffer_space, m_buffered_data.size());
+        memcpy(buffer, m_buffered_data.data(), taken_from_buffered);
+        Vector<u8> new_buffered_data;
+        new_buffered_data.append(m_buffered_data.data() + taken_from_buffered, m_buffered_data.size() - taken_from_buffered);
+        m_buffered_data = move(new_buffered_data);
+        remaining_buffer_space -= taken_from_buffered;
+    }
+    if (!remaining_buffer_space)
+        return (int)taken_from_buffered;
+    int nread = ::read(m_fd, buffer + taken_from_buffered, remaining_buffer_space);
+    if (nread < 0) {
+        if (taken_from_buffered)
+            return (int)taken_from_buffered;
+        set_error(errno);
+        return -1;
+    }
+    if (nread == 0)
+        set_eof(true);
+    return (int)(taken_from_buffered + nread);
 }
 
 ByteBuffer IODevice::read(size_t max_size)
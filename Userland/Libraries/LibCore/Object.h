@@ -154,6 +154,12 @@ public:
 
     virtual bool is_visible_for_timer_purposes() const;
 
+    // Kind-aware event coalescing: before enqueueing a new event, the event
+    // loop asks the receiver whether it supersedes the newest event still
+    // queued for the same receiver (e.g. two mouse moves). Returning true
+    // replaces the older event instead of letting redundant events pile up.
+    virtual bool should_coalesce_event(const Event&, const Event&) const { return false; }
+
     bool is_being_inspected() const { return m_inspector_count; }
 
     void increment_inspector_count(Badge<InspectorServerConnection>);
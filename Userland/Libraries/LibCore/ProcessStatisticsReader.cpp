@@ -5,9 +5,7 @@
  */
 
 #include <AK/ByteBuffer.h>
-#include <AK/JsonArray.h>
-#include <AK/JsonObject.h>
-#include <AK/JsonValue.h>
+#include <AK/JsonPullParser.h>
 #include <LibCore/File.h>
 #include <LibCore/ProcessStatisticsReader.h>
 #include <pwd.h>
@@ -34,67 +32,179 @@ Optional<Vector<Core::ProcessStatistics>> ProcessStatisticsReader::get_all(RefPt
 
     Vector<Core::ProcessStatistics> processes;
 
+    // /proc/all is written out by the kernel in one go and can get large, so
+    // walk it with the pull parser instead of materializing a JsonValue DOM.
     auto file_contents = proc_all_file->read_all();
-    auto json = JsonValue::from_string(file_contents);
-    if (!json.has_value())
-        return {};
-    json.value().as_array().for_each([&](auto& value) {
-        const JsonObject& process_object = value.as_object();
-        Core::ProcessStatistics process;
+    JsonPullParser parser { file_contents };
+    using Event = JsonPullParser::Event;
+
+    auto read_number = [&](auto& out) {
+        if (parser.next() != Event::Number)
+            return false;
+        auto value = parser.token_as_integer();
+        out = value.has_value() ? value.value() : 0;
+        return true;
+    };
+    auto read_string = [&](String& out) {
+        if (parser.next() != Event::String)
+            return false;
+        out = parser.decode_token();
+        return true;
+    };
+    auto read_bool = [&](bool& out) {
+        auto event = parser.next();
+        if (event != Event::True && event != Event::False)
+            return false;
+        out = event == Event::True;
+        return true;
+    };
 
-        // kernel data first
-        process.pid = process_object.get("pid").to_u32();
-        process.pgid = process_object.get("pgid").to_u32();
-        process.pgp = process_object.get("pgp").to_u32();
-        process.sid = process_object.get("sid").to_u32();
-        process.uid = process_object.get("uid").to_u32();
-        process.gid = process_object.get("gid").to_u32();
-        process.ppid = process_object.get("ppid").to_u32();
-        process.nfds = process_object.get("nfds").to_u32();
-        process.kernel = process_object.get("kernel").to_bool();
-        process.name = process_object.get("name").to_string();
-        process.executable = process_object.get("executable").to_string();
-        process.tty = process_object.get("tty").to_string();
-        process.pledge = process_object.get("pledge").to_string();
-        process.veil = process_object.get("veil").to_string();
-        process.amount_virtual = process_object.get("amount_virtual").to_u32();
-        process.amount_resident = process_object.get("amount_resident").to_u32();
-        process.amount_shared = process_object.get("amount_shared").to_u32();
-        process.amount_dirty_private = process_object.get("amount_dirty_private").to_u32();
-        process.amount_clean_inode = process_object.get("amount_clean_inode").to_u32();
-        process.amount_purgeable_volatile = process_object.get("amount_purgeable_volatile").to_u32();
-        process.amount_purgeable_nonvolatile = process_object.get("amount_purgeable_nonvolatile").to_u32();
+    auto read_thread = [&](Core::ThreadStatistics& thread) {
+        for (;;) {
+            auto event = parser.next();
+            if (event == Event::ObjectEnd)
+                return true;
+            if (event != Event::Key)
+                return false;
+            auto key = parser.token();
+            bool ok = false;
+            if (key == "tid")
+                ok = read_number(thread.tid);
+            else if (key == "times_scheduled")
+                ok = read_number(thread.times_scheduled);
+            else if (key == "name")
+                ok = read_string(thread.name);
+            else if (key == "state")
+                ok = read_string(thread.state);
+            else if (key == "ticks_user")
+                ok = read_number(thread.ticks_user);
+            else if (key == "ticks_kernel")
+                ok = read_number(thread.ticks_kernel);
+            else if (key == "cpu")
+                ok = read_number(thread.cpu);
+            else if (key == "priority")
+                ok = read_number(thread.priority);
+            else if (key == "priority_boost")
+                ok = read_number(thread.priority_boost);
+            else if (key == "syscall_count")
+                ok = read_number(thread.syscall_count);
+            else if (key == "inode_faults")
+                ok = read_number(thread.inode_faults);
+            else if (key == "zero_faults")
+                ok = read_number(thread.zero_faults);
+            else if (key == "cow_faults")
+                ok = read_number(thread.cow_faults);
+            else if (key == "unix_socket_read_bytes")
+                ok = read_number(thread.unix_socket_read_bytes);
+            else if (key == "unix_socket_write_bytes")
+                ok = read_number(thread.unix_socket_write_bytes);
+            else if (key == "ipv4_socket_read_bytes")
+                ok = read_number(thread.ipv4_socket_read_bytes);
+            else if (key == "ipv4_socket_write_bytes")
+                ok = read_number(thread.ipv4_socket_write_bytes);
+            else if (key == "file_read_bytes")
+                ok = read_number(thread.file_read_bytes);
+            else if (key == "file_write_bytes")
+                ok = read_number(thread.file_write_bytes);
+            else
+                ok = parser.skip_value();
+            if (!ok)
+                return false;
+        }
+    };
+
+    auto read_process = [&](Core::ProcessStatistics& process) {
+        for (;;) {
+            auto event = parser.next();
+            if (event == Event::ObjectEnd)
+                return true;
+            if (event != Event::Key)
+                return false;
+            auto key = parser.token();
+            bool ok = false;
+            if (key == "pid")
+                ok = read_number(process.pid);
+            else if (key == "pgid")
+                ok = read_number(process.pgid);
+            else if (key == "pgp")
+                ok = read_number(process.pgp);
+            else if (key == "sid")
+                ok = read_number(process.sid);
+            else if (key == "uid")
+                ok = read_number(process.uid);
+            else if (key == "gid")
+                ok = read_number(process.gid);
+            else if (key == "ppid")
+                ok = read_number(process.ppid);
+            else if (key == "nfds")
+                ok = read_number(process.nfds);
+            else if (key == "kernel")
+                ok = read_bool(process.kernel);
+            else if (key == "name")
+                ok = read_string(process.name);
+            else if (key == "executable")
+                ok = read_string(process.executable);
+            else if (key == "tty")
+                ok = read_string(process.tty);
+            else if (key == "pledge")
+                ok = read_string(process.pledge);
+            else if (key == "veil")
+                ok = read_string(process.veil);
+            else if (key == "amount_virtual")
+                ok = read_number(process.amount_virtual);
+            else if (key == "amount_resident")
+                ok = read_number(process.amount_resident);
+            else if (key == "amount_shared")
+                ok = read_number(process.amount_shared);
+            else if (key == "amount_dirty_private")
+                ok = read_number(process.amount_dirty_private);
+            else if (key == "amount_clean_inode")
+                ok = read_number(process.amount_clean_inode);
+            else if (key == "amount_purgeable_volatile")
+                ok = read_number(process.amount_purgeable_volatile);
+            else if (key == "amount_purgeable_nonvolatile")
+                ok = read_number(process.amount_purgeable_nonvolatile);
+            else if (key == "threads") {
+                if (parser.next() != Event::ArrayStart)
+                    return false;
+                for (;;) {
+                    auto thread_event = parser.next();
+                    if (thread_event == Event::ArrayEnd) {
+                        ok = true;
+                        break;
+                    }
+                    if (thread_event != Event::ObjectStart)
+                        return false;
+                    Core::ThreadStatistics thread {};
+                    if (!read_thread(thread))
+                        return false;
+                    process.threads.append(move(thread));
+                }
+            } else
+                ok = parser.skip_value();
+            if (!ok)
+                return false;
+        }
+    };
 
-        auto& thread_array = process_object.get_ptr("threads")->as_array();
-        process.threads.ensure_capacity(thread_array.size());
-        thread_array.for_each([&](auto& value) {
-            auto& thread_object = value.as_object();
-            Core::ThreadStatistics thread;
-            thread.tid = thread_object.get("tid").to_u32();
-            thread.times_scheduled = thread_object.get("times_scheduled").to_u32();
-            thread.name = thread_object.get("name").to_string();
-            thread.state = thread_object.get("state").to_string();
-            thread.ticks_user = thread_object.get("ticks_user").to_u32();
-            thread.ticks_kernel = thread_object.get("ticks_kernel").to_u32();
-            thread.cpu = thread_object.get("cpu").to_u32();
-            thread.priority = thread_object.get("priority").to_u32();
-            thread.syscall_count = thread_object.get("syscall_count").to_u32();
-            thread.inode_faults = thread_object.get("inode_faults").to_u32();
-            thread.zero_faults = thread_object.get("zero_faults").to_u32();
-            thread.cow_faults = thread_object.get("cow_faults").to_u32();
-            thread.unix_socket_read_bytes = thread_object.get("unix_socket_read_bytes").to_u32();
-            thread.unix_socket_write_bytes = thread_object.get("unix_socket_write_bytes").to_u32();
-            thread.ipv4_socket_read_bytes = thread_object.get("ipv4_socket_read_bytes").to_u32();
-            thread.ipv4_socket_write_bytes = thread_object.get("ipv4_socket_write_bytes").to_u32();
-            thread.file_read_bytes = thread_object.get("file_read_bytes").to_u32();
-            thread.file_write_bytes = thread_object.get("file_write_bytes").to_u32();
-            process.threads.append(move(thread));
-        });
+    if (parser.next() != Event::ArrayStart)
+        return {};
+    for (;;) {
+        auto event = parser.next();
+        if (event == Event::ArrayEnd)
+            break;
+        if (event != Event::ObjectStart)
+            return {};
+        Core::ProcessStatistics process {};
+        if (!read_process(process))
+            return {};
 
         // and synthetic data last
         process.username = username_from_uid(process.uid);
         processes.append(move(process));
-    });
+    }
+    if (parser.next() != Event::Eof)
+        return {};
 
     return processes;
 }
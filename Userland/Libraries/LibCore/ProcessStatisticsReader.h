@@ -30,6 +30,7 @@ struct ThreadStatistics {
     String state;
     u32 cpu;
     u32 priority;
+    u32 priority_boost;
     String name;
 };
 
@@ -38,6 +38,16 @@ TCPServer::~TCPServer()
     ::close(m_fd);
 }
 
+bool TCPServer::set_reuse_port(bool enabled)
+{
+    int option = enabled ? 1 : 0;
+    if (setsockopt(m_fd, SOL_SOCKET, SO_REUSEPORT, &option, sizeof(option)) < 0) {
+        perror("TCPServer::set_reuse_port: setsockopt");
+        return false;
+    }
+    return true;
+}
+
 bool TCPServer::listen(const IPv4Address& address, u16 port)
 {
     if (m_listening)
@@ -20,6 +20,11 @@ public:
     bool is_listening() const { return m_listening; }
     bool listen(const IPv4Address& address, u16 port);
 
+    // Allows several processes to listen on the same port and have the
+    // kernel distribute incoming connections between them. Must be enabled
+    // before calling listen().
+    bool set_reuse_port(bool);
+
     RefPtr<TCPSocket> accept();
 
     Optional<IPv4Address> local_address() const;
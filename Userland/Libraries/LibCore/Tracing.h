@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Types.h>
+#ifdef __serenity__
+#    include <serenity.h>
+#endif
+
+// Lightweight application-level trace spans, recorded into the same
+// performance event stream that the profiler samples land in (see
+// sys$perf_event). While nothing is profiling the process, a span is a
+// single syscall that bails out on the event mask check, so trace points
+// can stay in release builds; they can also be compiled out entirely by
+// defining CORE_TRACING_DISABLED.
+//
+// A span is identified by an application-defined "kind" (e.g. 1 = compose
+// frame); the begin/end pairing is done with an internal cookie, so spans
+// of the same kind may overlap. Typical usage:
+//
+//     void Compositor::compose()
+//     {
+//         CORE_TRACE_SCOPE(compose_span_kind);
+//         ...
+//     }
+//
+// or, for spans that don't follow scope (an in-flight request):
+//
+//     m_trace_cookie = CORE_TRACE_BEGIN(request_span_kind);
+//     ...
+//     CORE_TRACE_END(m_trace_cookie);
+
+namespace Core::Tracing {
+
+inline uintptr_t begin_span(uintptr_t kind)
+{
+#ifdef __serenity__
+    static Atomic<u32> s_next_cookie { 1 };
+    auto cookie = s_next_cookie.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+    perf_event(PERF_EVENT_SPAN_BEGIN, cookie, kind);
+    return cookie;
+#else
+    (void)kind;
+    return 0;
+#endif
+}
+
+inline void end_span(uintptr_t cookie)
+{
+#ifdef __serenity__
+    perf_event(PERF_EVENT_SPAN_END, cookie, 0);
+#else
+    (void)cookie;
+#endif
+}
+
+class ScopedSpan {
+public:
+    explicit ScopedSpan(uintptr_t kind)
+        : m_cookie(begin_span(kind))
+    {
+    }
+    ~ScopedSpan() { end_span(m_cookie); }
+
+private:
+    uintptr_t m_cookie { 0 };
+};
+
+}
+
+#ifndef CORE_TRACING_DISABLED
+#    define CORE_TRACE_CONCAT_IMPL(a, b) a##b
+#    define CORE_TRACE_CONCAT(a, b) CORE_TRACE_CONCAT_IMPL(a, b)
+#    define CORE_TRACE_SCOPE(kind) Core::Tracing::ScopedSpan CORE_TRACE_CONCAT(core_trace_span_, __COUNTER__)(kind)
+#    define CORE_TRACE_BEGIN(kind) Core::Tracing::begin_span(kind)
+#    define CORE_TRACE_END(cookie) Core::Tracing::end_span(cookie)
+#else
+#    define CORE_TRACE_SCOPE(kind)
+#    define CORE_TRACE_BEGIN(kind) ((uintptr_t)0)
+#    define CORE_TRACE_END(cookie) ((void)(cookie))
+#endif
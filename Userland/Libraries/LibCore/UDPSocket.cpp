@@ -38,4 +38,44 @@ UDPSocket::~UDPSocket()
 {
 }
 
+Vector<ByteBuffer> UDPSocket::receive_batch(size_t max_datagrams, size_t max_datagram_size)
+{
+    Vector<ByteBuffer> datagrams;
+    if (!max_datagrams || !max_datagram_size)
+        return datagrams;
+
+    Vector<ByteBuffer> buffers;
+    Vector<iovec> iovs;
+    Vector<mmsghdr> msgvec;
+    buffers.ensure_capacity(max_datagrams);
+    iovs.ensure_capacity(max_datagrams);
+    msgvec.ensure_capacity(max_datagrams);
+    for (size_t i = 0; i < max_datagrams; ++i) {
+        buffers.unchecked_append(ByteBuffer::create_uninitialized(max_datagram_size));
+        iovs.unchecked_append({ buffers[i].data(), buffers[i].size() });
+        mmsghdr mmsg {};
+        mmsg.msg_hdr.msg_iov = &iovs[i];
+        mmsg.msg_hdr.msg_iovlen = 1;
+        msgvec.unchecked_append(mmsg);
+    }
+
+#ifdef __serenity__
+    int received = recvmmsg(fd(), msgvec.data(), msgvec.size(), MSG_DONTWAIT);
+#else
+    // glibc's recvmmsg takes an additional timeout argument.
+    int received = recvmmsg(fd(), msgvec.data(), msgvec.size(), MSG_DONTWAIT, nullptr);
+#endif
+    if (received < 0) {
+        set_error(errno);
+        return datagrams;
+    }
+
+    datagrams.ensure_capacity(received);
+    for (int i = 0; i < received; ++i) {
+        buffers[i].trim(msgvec[i].msg_len);
+        datagrams.unchecked_append(move(buffers[i]));
+    }
+    return datagrams;
+}
+
 }
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
+#include <AK/Vector.h>
 #include <LibCore/Socket.h>
 
 namespace Core {
@@ -15,6 +17,11 @@ class UDPSocket final : public Socket {
 public:
     virtual ~UDPSocket() override;
 
+    // Receives every datagram already queued on the socket (up to
+    // max_datagrams) with a single recvmmsg() call. Each datagram is
+    // truncated to max_datagram_size.
+    Vector<ByteBuffer> receive_batch(size_t max_datagrams, size_t max_datagram_size);
+
 private:
     explicit UDPSocket(Object* parent = nullptr);
 };
@@ -7,6 +7,7 @@
 #include <AK/JsonObject.h>
 #include <AK/JsonValue.h>
 #include <LibCompress/Gzip.h>
+#include <LibCompress/Lz4.h>
 #include <LibCoreDump/Reader.h>
 #include <signal_numbers.h>
 #include <string.h>
@@ -39,12 +40,15 @@ Reader::Reader(ReadonlyBytes coredump_bytes)
 
 ByteBuffer Reader::decompress_coredump(const ReadonlyBytes& raw_coredump)
 {
-    if (!Compress::GzipDecompressor::is_likely_compressed(raw_coredump))
-        return ByteBuffer::copy(raw_coredump); // handle old format core dumps (uncompressed)
-    auto decompressed_coredump = Compress::GzipDecompressor::decompress_all(raw_coredump);
-    if (!decompressed_coredump.has_value())
-        return ByteBuffer::copy(raw_coredump); // if we didn't manage to decompress it, try and parse it as decompressed core dump
-    return decompressed_coredump.value();
+    if (Compress::Lz4::is_likely_compressed(raw_coredump)) {
+        if (auto decompressed_coredump = Compress::Lz4::decompress_all(raw_coredump); decompressed_coredump.has_value())
+            return decompressed_coredump.release_value();
+    }
+    if (Compress::GzipDecompressor::is_likely_compressed(raw_coredump)) { // handle old gzip-compressed core dumps
+        if (auto decompressed_coredump = Compress::GzipDecompressor::decompress_all(raw_coredump); decompressed_coredump.has_value())
+            return decompressed_coredump.value();
+    }
+    return ByteBuffer::copy(raw_coredump); // if we didn't manage to decompress it, try and parse it as decompressed core dump
 }
 
 Reader::~Reader()
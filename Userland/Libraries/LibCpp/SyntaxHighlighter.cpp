@@ -58,23 +58,42 @@ bool SyntaxHighlighter::is_navigatable(void* token) const
 void SyntaxHighlighter::rehighlight(const Palette& palette)
 {
     auto text = m_client->get_text();
-    Cpp::Lexer lexer(text);
-    auto tokens = lexer.lex();
-
-    Vector<GUI::TextDocumentSpan> spans;
-    for (auto& token : tokens) {
-        dbgln_if(SYNTAX_HIGHLIGHTING_DEBUG, "{} @ {}:{} - {}:{}", token.type_as_string(), token.start().line, token.start().column, token.end().line, token.end().column);
-        GUI::TextDocumentSpan span;
-        span.range.set_start({ token.start().line, token.start().column });
-        span.range.set_end({ token.end().line, token.end().column });
-        auto style = style_for_token_type(palette, token.type());
+
+    auto lex_range = [&](const StringView& source, size_t start_line) {
+        Cpp::Lexer lexer(source);
+        auto tokens = lexer.lex();
+
+        Vector<GUI::TextDocumentSpan> spans;
+        spans.ensure_capacity(tokens.size());
+        for (auto& token : tokens) {
+            dbgln_if(SYNTAX_HIGHLIGHTING_DEBUG, "{} @ {}:{} - {}:{}", token.type_as_string(), token.start().line + start_line, token.start().column, token.end().line + start_line, token.end().column);
+            GUI::TextDocumentSpan span;
+            span.range.set_start({ token.start().line + start_line, token.start().column });
+            span.range.set_end({ token.end().line + start_line, token.end().column });
+            auto style = style_for_token_type(palette, token.type());
+            span.attributes.color = style.color;
+            span.attributes.bold = style.bold;
+            span.is_skippable = token.type() == Cpp::Token::Type::Whitespace;
+            span.data = reinterpret_cast<void*>(token.type());
+            spans.unchecked_append(span);
+        }
+        return spans;
+    };
+
+    auto restyle_span = [&](GUI::TextDocumentSpan& span) {
+        auto style = style_for_token_type(palette, static_cast<Cpp::Token::Type>(reinterpret_cast<size_t>(span.data)));
+        span.attributes = {};
         span.attributes.color = style.color;
         span.attributes.bold = style.bold;
-        span.is_skippable = token.type() == Cpp::Token::Type::Whitespace;
-        span.data = reinterpret_cast<void*>(token.type());
-        spans.append(span);
-    }
-    m_client->do_set_spans(move(spans));
+    };
+
+    // Typing in a large document only re-lexes the damaged lines; the spans
+    // before and after the damage are reused as-is.
+    if (!rehighlight_incrementally(
+            text,
+            [&](const StringView& source, size_t start_line) { return lex_range(source, start_line); },
+            [&](GUI::TextDocumentSpan& span) { restyle_span(span); }))
+        m_client->do_set_spans(lex_range(text, 0));
 
     m_has_brace_buddies = false;
     highlight_matching_token_pair();
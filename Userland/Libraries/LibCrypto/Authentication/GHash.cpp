@@ -31,6 +31,60 @@ static void to_u8s(u8* b, const u32* w)
 namespace Crypto {
 namespace Authentication {
 
+void GHash::build_key_tables()
+{
+    // All 128 products of the key with a single set bit, i.e. the states
+    // the bit-by-bit multiply in galois_multiply() walks through.
+    u32 shifted[128][4];
+    for (auto j = 0; j < 4; ++j)
+        shifted[0][j] = m_key[j];
+    for (size_t i = 1; i < 128; ++i) {
+        auto& x = shifted[i];
+        auto& previous = shifted[i - 1];
+        auto a0 = previous[0] & 1;
+        auto a1 = previous[1] & 1;
+        auto a2 = previous[2] & 1;
+        auto a3 = previous[3] & 1;
+        x[0] = previous[0] >> 1;
+        x[1] = (previous[1] >> 1) | (a0 << 31);
+        x[2] = (previous[2] >> 1) | (a1 << 31);
+        x[3] = (previous[3] >> 1) | (a2 << 31);
+        if (a3)
+            x[0] ^= 0xe1000000;
+    }
+
+    // Since multiplication distributes over xor, the product for any
+    // nibble value is the xor of the products for its set bits.
+    for (size_t n = 0; n < 32; ++n) {
+        for (u32 v = 0; v < 16; ++v) {
+            auto& entry = m_key_table[n][v];
+            __builtin_memset(entry, 0, sizeof(entry));
+            for (size_t b = 0; b < 4; ++b) {
+                if (!((v >> b) & 1))
+                    continue;
+                auto& product = shifted[n * 4 + 3 - b];
+                for (auto j = 0; j < 4; ++j)
+                    entry[j] ^= product[j];
+            }
+        }
+    }
+}
+
+void GHash::multiply_by_key(u32 (&z)[4]) const
+{
+    u32 result[4] { 0, 0, 0, 0 };
+    for (size_t n = 0; n < 32; ++n) {
+        u32 v = (z[n >> 3] >> (28 - 4 * (n & 7))) & 0xf;
+        auto& entry = m_key_table[n][v];
+        result[0] ^= entry[0];
+        result[1] ^= entry[1];
+        result[2] ^= entry[2];
+        result[3] ^= entry[3];
+    }
+    for (auto j = 0; j < 4; ++j)
+        z[j] = result[j];
+}
+
 GHash::TagType GHash::process(ReadonlyBytes aad, ReadonlyBytes cipher)
 {
     u32 tag[4] { 0, 0, 0, 0 };
@@ -42,7 +96,7 @@ GHash::TagType GHash::process(ReadonlyBytes aad, ReadonlyBytes cipher)
                 for (auto j = 0; j < 4; ++j) {
                     tag[j] ^= to_u32(buf.offset(i + j * 4));
                 }
-                galois_multiply(tag, m_key, tag);
+                multiply_by_key(tag);
             }
         }
 
@@ -56,7 +110,7 @@ GHash::TagType GHash::process(ReadonlyBytes aad, ReadonlyBytes cipher)
             for (auto j = 0; j < 4; ++j) {
                 tag[j] ^= to_u32(buffer_bytes.offset(j * 4));
             }
-            galois_multiply(tag, m_key, tag);
+            multiply_by_key(tag);
         }
     };
 
@@ -82,7 +136,7 @@ GHash::TagType GHash::process(ReadonlyBytes aad, ReadonlyBytes cipher)
 
     dbgln_if(GHASH_PROCESS_DEBUG, "Tag bits: {} : {} : {} : {}", tag[0], tag[1], tag[2], tag[3]);
 
-    galois_multiply(tag, m_key, tag);
+    multiply_by_key(tag);
 
     TagType digest;
     to_u8s(digest.data, tag);
@@ -37,6 +37,7 @@ public:
     {
         for (size_t i = 0; i < 16; i += 4)
             m_key[i / 4] = AK::convert_between_host_and_big_endian(*(const u32*)(key.offset(i)));
+        build_key_tables();
     }
 
     constexpr static size_t digest_size() { return TagType::Size; }
@@ -48,7 +49,15 @@ public:
 private:
     inline void transform(ReadonlyBytes, ReadonlyBytes);
 
+    void build_key_tables();
+    void multiply_by_key(u32 (&z)[4]) const;
+
     u32 m_key[4];
+    // Precomputed multiples of the (fixed) hash key: entry [n][v] is the
+    // product of the key and a field element whose n-th nibble (counting
+    // from the most significant end) is v. A 128-bit multiplication is
+    // then 32 table lookups instead of 128 shift-and-reduce steps.
+    u32 m_key_table[32][16][4];
 };
 
 }
@@ -19,8 +19,13 @@ static constexpr auto ROTATE_LEFT(u32 value, size_t bits)
 inline void SHA1::transform(const u8* data)
 {
     u32 blocks[80];
-    for (size_t i = 0; i < 16; ++i)
-        blocks[i] = AK::convert_between_host_and_network_endian(((const u32*)data)[i]);
+    for (size_t i = 0; i < 16; ++i) {
+        // The data may come straight out of the caller's message, so it is
+        // not necessarily aligned for u32 access.
+        u32 word;
+        __builtin_memcpy(&word, data + i * sizeof(u32), sizeof(word));
+        blocks[i] = AK::convert_between_host_and_network_endian(word);
+    }
 
     // w[i] = (w[i-3] xor w[i-8] xor w[i-14] xor w[i-16]) leftrotate 1
     for (size_t i = 16; i < Rounds; ++i)
@@ -68,13 +73,30 @@ inline void SHA1::transform(const u8* data)
 
 void SHA1::update(const u8* message, size_t length)
 {
-    for (size_t i = 0; i < length; ++i) {
+    size_t offset = 0;
+
+    // Complete any partially filled block first.
+    if (m_data_length > 0) {
+        offset = min(length, BlockSize - m_data_length);
+        __builtin_memcpy(m_data_buffer + m_data_length, message, offset);
+        m_data_length += offset;
         if (m_data_length == BlockSize) {
             transform(m_data_buffer);
-            m_bit_length += 512;
+            m_bit_length += BlockSize * 8;
             m_data_length = 0;
         }
-        m_data_buffer[m_data_length++] = message[i];
+    }
+
+    // Hash whole blocks straight out of the message, skipping the copy
+    // through the staging buffer.
+    for (; offset + BlockSize <= length; offset += BlockSize) {
+        transform(message + offset);
+        m_bit_length += BlockSize * 8;
+    }
+
+    if (offset < length) {
+        __builtin_memcpy(m_data_buffer, message + offset, length - offset);
+        m_data_length = length - offset;
     }
 }
 
@@ -68,13 +68,30 @@ inline void SHA256::transform(const u8* data)
 
 void SHA256::update(const u8* message, size_t length)
 {
-    for (size_t i = 0; i < length; ++i) {
+    size_t offset = 0;
+
+    // Complete any partially filled block first.
+    if (m_data_length > 0) {
+        offset = min(length, BlockSize - m_data_length);
+        __builtin_memcpy(m_data_buffer + m_data_length, message, offset);
+        m_data_length += offset;
         if (m_data_length == BlockSize) {
             transform(m_data_buffer);
-            m_bit_length += 512;
+            m_bit_length += BlockSize * 8;
             m_data_length = 0;
         }
-        m_data_buffer[m_data_length++] = message[i];
+    }
+
+    // Hash whole blocks straight out of the message, skipping the copy
+    // through the staging buffer.
+    for (; offset + BlockSize <= length; offset += BlockSize) {
+        transform(message + offset);
+        m_bit_length += BlockSize * 8;
+    }
+
+    if (offset < length) {
+        __builtin_memcpy(m_data_buffer, message + offset, length - offset);
+        m_data_length = length - offset;
     }
 }
 
@@ -186,13 +203,27 @@ inline void SHA384::transform(const u8* data)
 
 void SHA384::update(const u8* message, size_t length)
 {
-    for (size_t i = 0; i < length; ++i) {
+    size_t offset = 0;
+
+    if (m_data_length > 0) {
+        offset = min(length, BlockSize - m_data_length);
+        __builtin_memcpy(m_data_buffer + m_data_length, message, offset);
+        m_data_length += offset;
         if (m_data_length == BlockSize) {
             transform(m_data_buffer);
-            m_bit_length += 1024;
+            m_bit_length += BlockSize * 8;
             m_data_length = 0;
         }
-        m_data_buffer[m_data_length++] = message[i];
+    }
+
+    for (; offset + BlockSize <= length; offset += BlockSize) {
+        transform(message + offset);
+        m_bit_length += BlockSize * 8;
+    }
+
+    if (offset < length) {
+        __builtin_memcpy(m_data_buffer, message + offset, length - offset);
+        m_data_length = length - offset;
     }
 }
 
@@ -301,13 +332,27 @@ inline void SHA512::transform(const u8* data)
 
 void SHA512::update(const u8* message, size_t length)
 {
-    for (size_t i = 0; i < length; ++i) {
+    size_t offset = 0;
+
+    if (m_data_length > 0) {
+        offset = min(length, BlockSize - m_data_length);
+        __builtin_memcpy(m_data_buffer + m_data_length, message, offset);
+        m_data_length += offset;
         if (m_data_length == BlockSize) {
             transform(m_data_buffer);
-            m_bit_length += 1024;
+            m_bit_length += BlockSize * 8;
             m_data_length = 0;
         }
-        m_data_buffer[m_data_length++] = message[i];
+    }
+
+    for (; offset + BlockSize <= length; offset += BlockSize) {
+        transform(message + offset);
+        m_bit_length += BlockSize * 8;
+    }
+
+    if (offset < length) {
+        __builtin_memcpy(m_data_buffer, message + offset, length - offset);
+        m_data_length = length - offset;
     }
 }
 
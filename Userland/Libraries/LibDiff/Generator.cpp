@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "Generator.h"
+#include <AK/String.h>
+
+namespace Diff {
+
+// A line with its hash precomputed, so the inner loops of the algorithm
+// can reject unequal lines without comparing their contents.
+struct Line {
+    StringView text;
+    unsigned hash { 0 };
+};
+
+static bool lines_equal(const Line& a, const Line& b)
+{
+    return a.hash == b.hash && a.text == b.text;
+}
+
+static Vector<Line> split_into_lines(const StringView& text)
+{
+    Vector<Line> lines;
+    if (text.is_empty())
+        return lines;
+    auto views = text.split_view('\n', true);
+    // A trailing newline terminates the last line; it doesn't start one.
+    if (text[text.length() - 1] == '\n')
+        views.take_last();
+    lines.ensure_capacity(views.size());
+    for (auto& view : views)
+        lines.unchecked_append({ view, view.hash() });
+    return lines;
+}
+
+class Generator {
+public:
+    Generator(Vector<Line> original, Vector<Line> target, Function<void(Hunk&&)> on_hunk)
+        : m_original(move(original))
+        , m_target(move(target))
+        , m_on_hunk(move(on_hunk))
+    {
+    }
+
+    void generate()
+    {
+        diff_range(0, static_cast<int>(m_original.size()), 0, static_cast<int>(m_target.size()));
+        flush_hunk();
+    }
+
+private:
+    struct Snake {
+        int original_start { 0 };
+        int target_start { 0 };
+        int original_end { 0 };
+        int target_end { 0 };
+    };
+
+    void diff_range(int original_lo, int original_hi, int target_lo, int target_hi)
+    {
+        // Walk off the common prefix; equal lines close any open hunk.
+        while (original_lo < original_hi && target_lo < target_hi && lines_equal(m_original[original_lo], m_target[target_lo])) {
+            emit_equal(1);
+            ++original_lo;
+            ++target_lo;
+        }
+
+        // The common suffix has to wait until the middle is emitted.
+        int common_suffix = 0;
+        while (original_lo < original_hi - common_suffix && target_lo < target_hi - common_suffix && lines_equal(m_original[original_hi - common_suffix - 1], m_target[target_hi - common_suffix - 1]))
+            ++common_suffix;
+        original_hi -= common_suffix;
+        target_hi -= common_suffix;
+
+        if (original_lo == original_hi) {
+            for (int i = target_lo; i < target_hi; ++i)
+                emit_insertion(m_target[i]);
+        } else if (target_lo == target_hi) {
+            for (int i = original_lo; i < original_hi; ++i)
+                emit_removal(m_original[i]);
+        } else {
+            auto snake = find_middle_snake(original_lo, original_hi, target_lo, target_hi);
+            diff_range(original_lo, snake.original_start, target_lo, snake.target_start);
+            emit_equal(snake.original_end - snake.original_start);
+            diff_range(snake.original_end, original_hi, snake.target_end, target_hi);
+        }
+
+        emit_equal(common_suffix);
+    }
+
+    // Finds the middle snake of a shortest edit path through the given
+    // subrange by running the O(ND) search from both ends at once, which
+    // only needs memory linear in the input (Myers 1986, section 4b).
+    Snake find_middle_snake(int original_lo, int original_hi, int target_lo, int target_hi)
+    {
+        int n = original_hi - original_lo;
+        int m = target_hi - target_lo;
+        int delta = n - m;
+        bool delta_is_odd = delta & 1;
+        int max_edits = (n + m + 1) / 2;
+
+        // The k-index into the furthest-reaching arrays is offset to keep
+        // it non-negative; entries just outside the searched band are read
+        // by the k == ±d cases and must start out at zero.
+        m_forward_furthest.clear();
+        m_forward_furthest.resize(2 * max_edits + 3);
+        m_backward_furthest.clear();
+        m_backward_furthest.resize(2 * max_edits + 3);
+        int offset = max_edits + 1;
+
+        for (int d = 0; d <= max_edits; ++d) {
+            for (int k = -d; k <= d; k += 2) {
+                int x;
+                if (k == -d || (k != d && m_forward_furthest[offset + k - 1] < m_forward_furthest[offset + k + 1]))
+                    x = m_forward_furthest[offset + k + 1];
+                else
+                    x = m_forward_furthest[offset + k - 1] + 1;
+                int y = x - k;
+                int snake_start_x = x;
+                int snake_start_y = y;
+                while (x < n && y < m && lines_equal(m_original[original_lo + x], m_target[target_lo + y])) {
+                    ++x;
+                    ++y;
+                }
+                m_forward_furthest[offset + k] = x;
+                if (delta_is_odd && k >= delta - (d - 1) && k <= delta + (d - 1)) {
+                    if (x + m_backward_furthest[offset + delta - k] >= n)
+                        return { original_lo + snake_start_x, target_lo + snake_start_y, original_lo + x, target_lo + y };
+                }
+            }
+            for (int k = -d; k <= d; k += 2) {
+                int x;
+                if (k == -d || (k != d && m_backward_furthest[offset + k - 1] < m_backward_furthest[offset + k + 1]))
+                    x = m_backward_furthest[offset + k + 1];
+                else
+                    x = m_backward_furthest[offset + k - 1] + 1;
+                int y = x - k;
+                int snake_start_x = x;
+                int snake_start_y = y;
+                while (x < n && y < m && lines_equal(m_original[original_hi - 1 - x], m_target[target_hi - 1 - y])) {
+                    ++x;
+                    ++y;
+                }
+                m_backward_furthest[offset + k] = x;
+                if (!delta_is_odd && delta - k >= -d && delta - k <= d) {
+                    if (x + m_forward_furthest[offset + delta - k] >= n)
+                        return { original_lo + n - x, target_lo + m - y, original_lo + n - snake_start_x, target_lo + m - snake_start_y };
+                }
+            }
+        }
+
+        VERIFY_NOT_REACHED();
+    }
+
+    void emit_equal(int count)
+    {
+        if (count == 0)
+            return;
+        flush_hunk();
+        m_original_line += count;
+        m_target_line += count;
+    }
+
+    void emit_removal(const Line& line)
+    {
+        open_hunk_if_needed();
+        m_current_hunk.removed_lines.append(line.text);
+        ++m_original_line;
+    }
+
+    void emit_insertion(const Line& line)
+    {
+        open_hunk_if_needed();
+        m_current_hunk.added_lines.append(line.text);
+        ++m_target_line;
+    }
+
+    void open_hunk_if_needed()
+    {
+        if (m_hunk_open)
+            return;
+        m_current_hunk = {};
+        m_current_hunk.original_start_line = m_original_line;
+        m_current_hunk.target_start_line = m_target_line;
+        m_hunk_open = true;
+    }
+
+    void flush_hunk()
+    {
+        if (!m_hunk_open)
+            return;
+        m_on_hunk(move(m_current_hunk));
+        m_current_hunk = {};
+        m_hunk_open = false;
+    }
+
+    Vector<Line> m_original;
+    Vector<Line> m_target;
+    Function<void(Hunk&&)> m_on_hunk;
+
+    Vector<int> m_forward_furthest;
+    Vector<int> m_backward_furthest;
+
+    size_t m_original_line { 0 };
+    size_t m_target_line { 0 };
+    Hunk m_current_hunk;
+    bool m_hunk_open { false };
+};
+
+void generate_hunks(const StringView& original_text, const StringView& target_text, Function<void(Hunk&&)> on_hunk)
+{
+    Generator generator(split_into_lines(original_text), split_into_lines(target_text), move(on_hunk));
+    generator.generate();
+}
+
+Vector<Hunk> from_text(const StringView& original_text, const StringView& target_text)
+{
+    Vector<Hunk> hunks;
+    generate_hunks(original_text, target_text, [&](Hunk&& hunk) {
+        hunks.append(move(hunk));
+    });
+    return hunks;
+}
+
+};
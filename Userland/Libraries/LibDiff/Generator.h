@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+#include <LibDiff/Hunks.h>
+
+namespace Diff {
+
+// Computes the line-by-line difference between two texts with the Myers
+// O(ND) algorithm, using the linear-space divide-and-conquer refinement,
+// and hands each hunk to the callback as soon as it is complete, so
+// callers never have to materialize the whole edit script.
+void generate_hunks(const StringView& original_text, const StringView& target_text, Function<void(Hunk&&)> on_hunk);
+
+Vector<Hunk> from_text(const StringView& original_text, const StringView& target_text);
+
+};
@@ -230,6 +230,9 @@ public:
     RelocationSection relocation_section() const;
     RelocationSection plt_relocation_section() const;
 
+    // DT_RELCOUNT: the number of relative relocations at the front of the relocation section.
+    size_t relative_relocation_count() const { return m_number_of_relocations; }
+
     bool should_process_origin() const { return m_dt_flags & DF_ORIGIN; }
     bool requires_symbolic_symbol_resolution() const { return m_dt_flags & DF_SYMBOLIC; }
     // Text relocations meaning: we need to edit the .text section which is normally mapped PROT_READ
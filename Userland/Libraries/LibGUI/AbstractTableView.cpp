@@ -97,6 +97,15 @@ void AbstractTableView::update_column_sizes()
     int column_count = model.column_count();
     int row_count = model.row_count();
 
+    // Measuring every cell in the model chokes on large models, and the rows
+    // that matter for sizing are the ones on screen. Only those are measured
+    // (again on scroll and resize); section sizes only ever grow, so a column
+    // may widen as wider rows scroll into view, but it never jumps back.
+    auto visible_rect = visible_content_rect();
+    int column_header_height = column_header().is_visible() ? column_header().height() : 0;
+    int first_visible_row = max(0, (visible_rect.top() - column_header_height) / row_height());
+    int last_visible_row = min(row_count - 1, first_visible_row + visible_rect.height() / row_height() + 1);
+
     for (int column = 0; column < column_count; ++column) {
         if (!column_header().is_section_visible(column))
             continue;
@@ -104,7 +113,7 @@ void AbstractTableView::update_column_sizes()
         if (column == m_key_column && model.is_column_sortable(column))
             header_width += font().width(" \xE2\xAC\x86"); // UPWARDS BLACK ARROW
         int column_width = header_width;
-        for (int row = 0; row < row_count; ++row) {
+        for (int row = first_visible_row; row <= last_visible_row; ++row) {
             auto cell_data = model.index(row, column).data();
             int cell_width = 0;
             if (cell_data.is_icon()) {
@@ -125,6 +134,9 @@ void AbstractTableView::update_row_sizes()
     if (!model())
         return;
 
+    if (!row_header().is_visible())
+        return;
+
     auto& model = *this->model();
     int row_count = model.row_count();
 
@@ -332,6 +344,7 @@ void AbstractTableView::model_did_update(unsigned flags)
 void AbstractTableView::resize_event(ResizeEvent& event)
 {
     AbstractView::resize_event(event);
+    update_column_sizes();
     layout_headers();
 }
 
@@ -365,6 +378,10 @@ void AbstractTableView::set_column_headers_visible(bool visible)
 void AbstractTableView::did_scroll()
 {
     AbstractView::did_scroll();
+    // Rows that just scrolled into view may be wider than anything measured
+    // so far. This is cheap now that only visible rows are measured, and
+    // HeaderView ignores section sizes that don't change.
+    update_column_sizes();
     layout_headers();
 }
 
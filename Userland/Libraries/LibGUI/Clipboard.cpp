@@ -8,6 +8,7 @@
 #include <Clipboard/ClipboardClientEndpoint.h>
 #include <Clipboard/ClipboardServerEndpoint.h>
 #include <LibGUI/Clipboard.h>
+#include <LibGfx/Bitmap.h>
 #include <LibIPC/ServerConnection.h>
 
 namespace GUI {
@@ -17,12 +18,44 @@ class ClipboardServerConnection final
     , public ClipboardClientEndpoint {
     C_OBJECT(ClipboardServerConnection);
 
+public:
+    // Delayed rendering: while the callback is set, this process owns the
+    // clipboard contents and hasn't handed them to the server yet.
+    void take_over_as_provider(Function<ByteBuffer()> callback, const String& mime_type, const HashMap<String, String>& metadata)
+    {
+        m_data_callback = move(callback);
+        m_callback_mime_type = mime_type;
+        m_callback_metadata = metadata;
+        ++m_pending_self_changes;
+        async_set_clipboard_provider(mime_type, metadata);
+    }
+
+    void did_set_clipboard_data()
+    {
+        m_data_callback = nullptr;
+        ++m_pending_self_changes;
+    }
+
+    bool is_provider() const { return !!m_data_callback; }
+
+    Clipboard::DataAndType render_local_clipping()
+    {
+        VERIFY(m_data_callback);
+        return { m_data_callback(), m_callback_mime_type, m_callback_metadata };
+    }
+
 private:
     ClipboardServerConnection()
         : IPC::ServerConnection<ClipboardClientEndpoint, ClipboardServerEndpoint>(*this, "/tmp/portal/clipboard")
     {
     }
     virtual void clipboard_data_changed(String const& mime_type) override;
+    virtual Messages::ClipboardClient::RenderClipboardDataResponse render_clipboard_data() override;
+
+    Function<ByteBuffer()> m_data_callback;
+    String m_callback_mime_type;
+    HashMap<String, String> m_callback_metadata;
+    int m_pending_self_changes { 0 };
 };
 
 Clipboard& Clipboard::the()
@@ -51,6 +84,12 @@ Clipboard::Clipboard()
 
 Clipboard::DataAndType Clipboard::data_and_type() const
 {
+    // A process pasting its own delayed-rendering clipping is answered from
+    // the local callback. Asking the server would have it render-request us
+    // right back while we're blocked waiting for the reply.
+    if (connection().is_provider())
+        return connection().render_local_clipping();
+
     auto response = connection().get_clipboard_data();
     if (!response.data().is_valid())
         return {};
@@ -70,21 +109,53 @@ void Clipboard::set_data(ReadonlyBytes data, const String& type, const HashMap<S
     if (!data.is_empty())
         memcpy(buffer.data<void>(), data.data(), data.size());
 
+    connection().did_set_clipboard_data();
     connection().async_set_clipboard_data(move(buffer), type, metadata);
 }
 
+void Clipboard::set_data_with_callback(Function<ByteBuffer()> callback, const String& type, const HashMap<String, String>& metadata)
+{
+    connection().take_over_as_provider(move(callback), type, metadata);
+}
+
 void Clipboard::clear()
 {
+    connection().did_set_clipboard_data();
     connection().async_set_clipboard_data({}, {}, {});
 }
 
 void ClipboardServerConnection::clipboard_data_changed(String const& mime_type)
 {
+    // Ignore the change notifications caused by our own sets; any other
+    // change means another program took over the clipboard, so a delayed
+    // rendering callback we still hold is stale.
+    if (m_pending_self_changes > 0)
+        --m_pending_self_changes;
+    else
+        m_data_callback = nullptr;
+
     auto& clipboard = Clipboard::the();
     if (clipboard.on_change)
         clipboard.on_change(mime_type);
 }
 
+Messages::ClipboardClient::RenderClipboardDataResponse ClipboardServerConnection::render_clipboard_data()
+{
+    if (!m_data_callback)
+        return Core::AnonymousBuffer();
+    auto data = m_data_callback();
+    // The server caches what we render, so the callback has done its job.
+    m_data_callback = nullptr;
+    auto buffer = Core::AnonymousBuffer::create_with_size(data.size());
+    if (!buffer.is_valid()) {
+        dbgln("GUI::Clipboard failed to create a buffer for delayed rendering");
+        return Core::AnonymousBuffer();
+    }
+    if (!data.is_empty())
+        memcpy(buffer.data<void>(), data.data(), data.size());
+    return buffer;
+}
+
 RefPtr<Gfx::Bitmap> Clipboard::bitmap() const
 {
     auto clipping = data_and_type();
@@ -133,7 +204,13 @@ void Clipboard::set_bitmap(const Gfx::Bitmap& bitmap)
     metadata.set("scale", String::number(bitmap.scale()));
     metadata.set("format", String::number((int)bitmap.format()));
     metadata.set("pitch", String::number(bitmap.pitch()));
-    set_data({ bitmap.scanline(0), bitmap.size_in_bytes() }, "image/x-serenityos", metadata);
+    // Bitmaps can be huge, so don't copy the pixels anywhere until somebody
+    // actually pastes them.
+    set_data_with_callback(
+        [bitmap = NonnullRefPtr<const Gfx::Bitmap>(bitmap)] {
+            return ByteBuffer::copy(bitmap->scanline(0), bitmap->size_in_bytes());
+        },
+        "image/x-serenityos", metadata);
 }
 
 }
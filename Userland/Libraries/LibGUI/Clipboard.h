@@ -22,6 +22,13 @@ public:
     ByteBuffer data() const { return data_and_type().data; }
     String mime_type() const { return data_and_type().mime_type; }
     void set_data(ReadonlyBytes, const String& mime_type = "text/plain", const HashMap<String, String>& metadata = {});
+
+    // Delayed rendering: announces the new clipboard contents without copying
+    // them anywhere, making the copy O(1) regardless of payload size. The
+    // callback is invoked when some program first pastes, and must produce
+    // the bytes that would otherwise have been passed to set_data().
+    void set_data_with_callback(Function<ByteBuffer()>, const String& mime_type = "text/plain", const HashMap<String, String>& metadata = {});
+
     void clear();
 
     void set_plain_text(const String& text)
@@ -5,9 +5,11 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ByteBuffer.h>
 #include <AK/LexicalPath.h>
 #include <AK/NumberFormat.h>
 #include <AK/QuickSort.h>
+#include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
 #include <LibCore/DirIterator.h>
 #include <LibCore/File.h>
@@ -17,6 +19,8 @@
 #include <LibGUI/Painter.h>
 #include <LibGfx/Bitmap.h>
 #include <LibThreading/BackgroundAction.h>
+#include <dirent.h>
+#include <fcntl.h>
 #include <grp.h>
 #include <pwd.h>
 #include <stdio.h>
@@ -90,34 +94,64 @@ void FileSystemModel::Node::traverse_if_needed()
     total_size = 0;
 
     auto full_path = this->full_path();
-    Core::DirIterator di(full_path, m_model.should_show_dotfiles() ? Core::DirIterator::SkipParentAndBaseDir : Core::DirIterator::SkipDots);
-    if (di.has_error()) {
-        m_error = di.error();
-        fprintf(stderr, "DirIterator: %s\n", di.error_string());
+
+    // Grab the names and types in a single readdir() pass; everything that
+    // needs a stat() happens on a background thread afterwards and trickles
+    // in via did_update(), so a directory with thousands of entries no
+    // longer freezes the UI. Core::DirIterator doesn't expose d_type, and
+    // without it the children can't even be grouped, so use readdir()
+    // directly here.
+    DIR* dirp = opendir(full_path.characters());
+    if (!dirp) {
+        m_error = errno;
+        perror("opendir");
         return;
     }
 
-    Vector<String> child_names;
-    while (di.has_next()) {
-        child_names.append(di.next_path());
+    struct DirectoryEntry {
+        String name;
+        unsigned char type { DT_UNKNOWN };
+    };
+    Vector<DirectoryEntry> entries;
+    while (auto* de = readdir(dirp)) {
+        StringView entry_name { de->d_name };
+        if (entry_name == "." || entry_name == "..")
+            continue;
+        if (!m_model.should_show_dotfiles() && entry_name.starts_with('.'))
+            continue;
+        entries.append({ entry_name, de->d_type });
     }
-    quick_sort(child_names);
+    closedir(dirp);
+
+    quick_sort(entries, [](auto& a, auto& b) { return a.name < b.name; });
 
     NonnullOwnPtrVector<Node> directory_children;
     NonnullOwnPtrVector<Node> file_children;
+    Vector<String> names_to_stat;
+    names_to_stat.ensure_capacity(entries.size());
 
-    for (auto& child_name : child_names) {
-        String child_path = String::formatted("{}/{}", full_path, child_name);
+    for (auto& entry : entries) {
         auto child = adopt_own(*new Node(m_model));
-        bool ok = child->fetch_data(child_path, false);
-        if (!ok)
-            continue;
-        if (m_model.m_mode == DirectoriesOnly && !S_ISDIR(child->mode))
+        bool needs_stat = true;
+        if (entry.type == DT_UNKNOWN) {
+            // The filesystem didn't hand us a type, and without one the
+            // entry can't even be grouped, so stat it synchronously.
+            if (!child->fetch_data(String::formatted("{}/{}", full_path, entry.name), false))
+                continue;
+            needs_stat = false;
+        } else if (entry.type == DT_DIR) {
+            // Let the node know it's a directory right away; the rest of
+            // the metadata arrives with the batch below.
+            child->mode = S_IFDIR;
+        }
+        if (m_model.m_mode == DirectoriesOnly && !child->is_directory())
             continue;
-        child->name = child_name;
+        child->name = entry.name;
         child->parent = this;
         total_size += child->size;
-        if (S_ISDIR(child->mode))
+        if (needs_stat)
+            names_to_stat.append(entry.name);
+        if (child->is_directory())
             directory_children.append(move(child));
         else
             file_children.append(move(child));
@@ -126,6 +160,37 @@ void FileSystemModel::Node::traverse_if_needed()
     children.append(move(directory_children));
     children.append(move(file_children));
 
+    if (!names_to_stat.is_empty()) {
+        auto* model = &m_model;
+        auto weak_model = m_model.make_weak_ptr();
+        Threading::BackgroundAction<Vector<BatchedStatResult>>::create(
+            [full_path, names = move(names_to_stat)] {
+                Vector<BatchedStatResult> results;
+                results.ensure_capacity(names.size());
+                for (auto& name : names) {
+                    BatchedStatResult result;
+                    result.name = name;
+                    auto path = String::formatted("{}/{}", full_path, name);
+                    if (lstat(path.characters(), &result.st) < 0) {
+                        result.error = errno;
+                    } else {
+                        if (S_ISLNK(result.st.st_mode))
+                            result.symlink_target = Core::File::read_link(path);
+                        if (S_ISDIR(result.st.st_mode))
+                            result.is_accessible_directory = access(path.characters(), R_OK | X_OK) == 0;
+                    }
+                    results.unchecked_append(move(result));
+                }
+                return results;
+            },
+            [model, weak_model, full_path](auto results) {
+                // The model was destroyed while the worker ran, nothing to apply to.
+                if (weak_model.is_null())
+                    return;
+                model->apply_batched_stats(full_path, results);
+            });
+    }
+
     if (!m_model.m_file_watcher->is_watching(full_path)) {
         // We are not already watching this file, watch it
         auto result = m_model.m_file_watcher->add_watch(full_path,
@@ -144,10 +209,47 @@ void FileSystemModel::Node::traverse_if_needed()
 
 void FileSystemModel::Node::reify_if_needed()
 {
+    if (mode == 0)
+        fetch_data(full_path(), parent == nullptr || parent->m_parent_of_root);
     traverse_if_needed();
-    if (mode != 0)
+}
+
+void FileSystemModel::apply_batched_stats(String const& parent_path, Vector<BatchedStatResult> const& results)
+{
+    // The parent may have been invalidated or re-traversed while the worker
+    // ran; match children by name and quietly drop whatever no longer exists.
+    auto* node = const_cast<Node*>(node_for_path(parent_path));
+    if (!node)
         return;
-    fetch_data(full_path(), parent == nullptr || parent->m_parent_of_root);
+
+    HashMap<String, Node*> children_by_name;
+    for (auto& child : node->children)
+        children_by_name.set(child.name, const_cast<Node*>(&child));
+
+    for (auto& result : results) {
+        auto it = children_by_name.get(result.name);
+        if (!it.has_value())
+            continue;
+        auto& child = *it.value();
+        if (result.error) {
+            child.m_error = result.error;
+            continue;
+        }
+        child.size = result.st.st_size;
+        child.mode = result.st.st_mode;
+        child.uid = result.st.st_uid;
+        child.gid = result.st.st_gid;
+        child.inode = result.st.st_ino;
+        child.mtime = result.st.st_mtime;
+        child.symlink_target = result.symlink_target;
+        child.is_accessible_directory = result.is_accessible_directory;
+    }
+
+    node->total_size = 0;
+    for (auto& child : node->children)
+        node->total_size += child.size;
+
+    did_update(UpdateFlag::DontInvalidateIndices);
 }
 
 bool FileSystemModel::Node::is_symlink_to_directory() const
@@ -533,6 +635,119 @@ Icon FileSystemModel::icon_for(const Node& node) const
 
 static HashMap<String, RefPtr<Gfx::Bitmap>> s_thumbnail_cache;
 
+// On-disk thumbnail cache: a single append-only file under ~/.cache holding
+// every 32x32 thumbnail we've ever rendered, keyed by path, mtime and size,
+// so re-opening a photo directory doesn't decode all the images again.
+// It's only ever touched from the BackgroundAction thread (a single serial
+// queue), so no locking is needed.
+// FIXME: Prune entries whose files are gone once the cache grows too big.
+static constexpr u32 thumbnail_cache_magic = 0x53544843; // 'STHC'
+static constexpr int thumbnail_side = 32;
+static constexpr size_t thumbnail_pixel_bytes = thumbnail_side * thumbnail_side * sizeof(Gfx::RGBA32);
+
+static HashMap<String, off_t> s_disk_thumbnail_index;
+static bool s_disk_thumbnail_index_loaded = false;
+
+static String thumbnail_cache_file_path()
+{
+    return String::formatted("{}/.cache/thumbnails.cache", Core::StandardPaths::home_directory());
+}
+
+static void ensure_disk_thumbnail_index()
+{
+    if (s_disk_thumbnail_index_loaded)
+        return;
+    s_disk_thumbnail_index_loaded = true;
+
+    auto cache_path = thumbnail_cache_file_path();
+    int fd = open(cache_path.characters(), O_RDONLY);
+    if (fd < 0)
+        return;
+    ScopeGuard close_guard = [fd] { close(fd); };
+
+    u32 magic = 0;
+    if (pread(fd, &magic, sizeof(magic), 0) != sizeof(magic) || magic != thumbnail_cache_magic) {
+        // Unknown or stale format; throw the file away and start fresh.
+        unlink(cache_path.characters());
+        return;
+    }
+
+    off_t offset = sizeof(magic);
+    for (;;) {
+        u32 key_length = 0;
+        if (pread(fd, &key_length, sizeof(key_length), offset) != sizeof(key_length))
+            break;
+        if (key_length == 0 || key_length > 4 * KiB)
+            break; // A nonsense length means a truncated or corrupt tail.
+        auto key_buffer = ByteBuffer::create_uninitialized(key_length);
+        if (pread(fd, key_buffer.data(), key_length, offset + sizeof(key_length)) != static_cast<ssize_t>(key_length))
+            break;
+        off_t pixels_offset = offset + sizeof(key_length) + key_length;
+        s_disk_thumbnail_index.set(String { reinterpret_cast<const char*>(key_buffer.data()), key_length }, pixels_offset);
+        offset = pixels_offset + thumbnail_pixel_bytes;
+    }
+}
+
+static RefPtr<Gfx::Bitmap> load_thumbnail_from_disk_cache(const String& key)
+{
+    ensure_disk_thumbnail_index();
+    auto pixels_offset = s_disk_thumbnail_index.get(key);
+    if (!pixels_offset.has_value())
+        return nullptr;
+
+    int fd = open(thumbnail_cache_file_path().characters(), O_RDONLY);
+    if (fd < 0)
+        return nullptr;
+    ScopeGuard close_guard = [fd] { close(fd); };
+
+    auto thumbnail = Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { thumbnail_side, thumbnail_side });
+    if (!thumbnail)
+        return nullptr;
+    size_t row_bytes = thumbnail_side * sizeof(Gfx::RGBA32);
+    for (int y = 0; y < thumbnail_side; ++y) {
+        if (pread(fd, thumbnail->scanline(y), row_bytes, pixels_offset.value() + y * row_bytes) != static_cast<ssize_t>(row_bytes))
+            return nullptr;
+    }
+    return thumbnail;
+}
+
+static void store_thumbnail_in_disk_cache(const String& key, Gfx::Bitmap& thumbnail)
+{
+    ensure_disk_thumbnail_index();
+
+    auto cache_path = thumbnail_cache_file_path();
+    auto cache_directory = String::formatted("{}/.cache", Core::StandardPaths::home_directory());
+    if (mkdir(cache_directory.characters(), 0700) < 0 && errno != EEXIST)
+        return;
+
+    int fd = open(cache_path.characters(), O_CREAT | O_WRONLY | O_APPEND, 0600);
+    if (fd < 0)
+        return;
+    ScopeGuard close_guard = [fd] { close(fd); };
+
+    struct stat st;
+    if (fstat(fd, &st) < 0)
+        return;
+    off_t offset = st.st_size;
+    if (offset == 0) {
+        if (write(fd, &thumbnail_cache_magic, sizeof(thumbnail_cache_magic)) != sizeof(thumbnail_cache_magic))
+            return;
+        offset = sizeof(thumbnail_cache_magic);
+    }
+
+    u32 key_length = key.length();
+    if (write(fd, &key_length, sizeof(key_length)) != sizeof(key_length))
+        return;
+    if (write(fd, key.characters(), key_length) != static_cast<ssize_t>(key_length))
+        return;
+    size_t row_bytes = thumbnail_side * sizeof(Gfx::RGBA32);
+    for (int y = 0; y < thumbnail_side; ++y) {
+        if (write(fd, thumbnail.scanline(y), row_bytes) != static_cast<ssize_t>(row_bytes))
+            return;
+    }
+    s_disk_thumbnail_index.set(key, offset + sizeof(key_length) + key_length);
+}
+
 static RefPtr<Gfx::Bitmap> render_thumbnail(const StringView& path)
 {
     auto png_bitmap = Gfx::Bitmap::load_from_file(path);
@@ -570,10 +785,16 @@ bool FileSystemModel::fetch_thumbnail_for(const Node& node)
     m_thumbnail_progress_total++;
 
     auto weak_this = make_weak_ptr();
+    auto cache_key = String::formatted("{}:{}:{}", path, node.mtime, node.size);
 
     Threading::BackgroundAction<RefPtr<Gfx::Bitmap>>::create(
-        [path] {
-            return render_thumbnail(path);
+        [path, cache_key] {
+            if (auto thumbnail = load_thumbnail_from_disk_cache(cache_key))
+                return thumbnail;
+            auto thumbnail = render_thumbnail(path);
+            if (thumbnail)
+                store_thumbnail_in_disk_cache(cache_key, *thumbnail);
+            return thumbnail;
         },
 
         [this, path, weak_this](auto thumbnail) {
@@ -148,6 +148,15 @@ private:
 
     Node const* node_for_path(String const&) const;
 
+    struct BatchedStatResult {
+        String name;
+        int error { 0 };
+        struct stat st { };
+        String symlink_target;
+        bool is_accessible_directory { false };
+    };
+    void apply_batched_stats(String const& parent_path, Vector<BatchedStatResult> const&);
+
     HashMap<uid_t, String> m_user_names;
     HashMap<gid_t, String> m_group_names;
 
@@ -4,13 +4,17 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BitCast.h>
+#include <AK/ByteBuffer.h>
 #include <AK/GenericLexer.h>
+#include <AK/JsonArray.h>
 #include <AK/JsonObject.h>
 #include <AK/JsonValue.h>
 #include <AK/Queue.h>
 #include <LibGUI/GMLLexer.h>
 #include <LibGUI/GMLParser.h>
 #include <ctype.h>
+#include <string.h>
 
 namespace GUI {
 
@@ -138,4 +142,262 @@ JsonValue parse_gml(const StringView& string)
     return root.release_value();
 }
 
+// A GML source file can never start with a DEL byte, so this prefix
+// unambiguously marks a compiled blob.
+static constexpr u8 compiled_gml_magic[] = { 0x7f, 'G', 'M', 'L' };
+
+enum class CompiledGMLValueType : u8 {
+    Null = 0,
+    BoolFalse,
+    BoolTrue,
+    Int32,
+    Int64,
+    UnsignedInt32,
+    UnsignedInt64,
+    Double,
+    String,
+    Array,
+    Object,
+};
+
+bool is_compiled_gml(const StringView& string)
+{
+    return string.length() >= sizeof(compiled_gml_magic)
+        && !memcmp(string.characters_without_null_termination(), compiled_gml_magic, sizeof(compiled_gml_magic));
+}
+
+static void encode_u32(ByteBuffer& buffer, u32 value)
+{
+    u8 bytes[] = {
+        (u8)(value & 0xff),
+        (u8)((value >> 8) & 0xff),
+        (u8)((value >> 16) & 0xff),
+        (u8)((value >> 24) & 0xff),
+    };
+    buffer.append(bytes, sizeof(bytes));
+}
+
+static void encode_u64(ByteBuffer& buffer, u64 value)
+{
+    encode_u32(buffer, (u32)(value & 0xffffffff));
+    encode_u32(buffer, (u32)(value >> 32));
+}
+
+static void encode_string(ByteBuffer& buffer, const StringView& string)
+{
+    encode_u32(buffer, string.length());
+    buffer.append(string.characters_without_null_termination(), string.length());
+}
+
+static void encode_value(ByteBuffer& buffer, const JsonValue& value)
+{
+    auto encode_type = [&](CompiledGMLValueType type) {
+        u8 byte = (u8)type;
+        buffer.append(&byte, 1);
+    };
+
+    switch (value.type()) {
+    case JsonValue::Type::Null:
+        encode_type(CompiledGMLValueType::Null);
+        break;
+    case JsonValue::Type::Bool:
+        encode_type(value.as_bool() ? CompiledGMLValueType::BoolTrue : CompiledGMLValueType::BoolFalse);
+        break;
+    case JsonValue::Type::Int32:
+        encode_type(CompiledGMLValueType::Int32);
+        encode_u32(buffer, (u32)value.as_i32());
+        break;
+    case JsonValue::Type::Int64:
+        encode_type(CompiledGMLValueType::Int64);
+        encode_u64(buffer, (u64)value.as_i64());
+        break;
+    case JsonValue::Type::UnsignedInt32:
+        encode_type(CompiledGMLValueType::UnsignedInt32);
+        encode_u32(buffer, value.as_u32());
+        break;
+    case JsonValue::Type::UnsignedInt64:
+        encode_type(CompiledGMLValueType::UnsignedInt64);
+        encode_u64(buffer, value.as_u64());
+        break;
+    case JsonValue::Type::Double:
+        encode_type(CompiledGMLValueType::Double);
+        encode_u64(buffer, bit_cast<u64>(value.as_double()));
+        break;
+    case JsonValue::Type::String:
+        encode_type(CompiledGMLValueType::String);
+        encode_string(buffer, value.as_string());
+        break;
+    case JsonValue::Type::Array:
+        encode_type(CompiledGMLValueType::Array);
+        encode_u32(buffer, value.as_array().size());
+        value.as_array().for_each([&](auto& element) {
+            encode_value(buffer, element);
+        });
+        break;
+    case JsonValue::Type::Object:
+        encode_type(CompiledGMLValueType::Object);
+        encode_u32(buffer, value.as_object().size());
+        value.as_object().for_each_member([&](auto& key, auto& member) {
+            encode_string(buffer, key);
+            encode_value(buffer, member);
+        });
+        break;
+    }
+}
+
+ByteBuffer compile_gml(const JsonValue& value)
+{
+    ByteBuffer buffer;
+    buffer.append(compiled_gml_magic, sizeof(compiled_gml_magic));
+    encode_value(buffer, value);
+    return buffer;
+}
+
+namespace {
+
+struct CompiledGMLReader {
+    const u8* data { nullptr };
+    size_t size { 0 };
+    size_t offset { 0 };
+
+    bool read_u8(u8& value)
+    {
+        if (size - offset < sizeof(u8))
+            return false;
+        value = data[offset++];
+        return true;
+    }
+
+    bool read_u32(u32& value)
+    {
+        if (size - offset < sizeof(u32))
+            return false;
+        value = (u32)data[offset] | ((u32)data[offset + 1] << 8) | ((u32)data[offset + 2] << 16) | ((u32)data[offset + 3] << 24);
+        offset += sizeof(u32);
+        return true;
+    }
+
+    bool read_u64(u64& value)
+    {
+        u32 low = 0, high = 0;
+        if (!read_u32(low) || !read_u32(high))
+            return false;
+        value = (u64)low | ((u64)high << 32);
+        return true;
+    }
+
+    bool read_string(String& string)
+    {
+        u32 length = 0;
+        if (!read_u32(length))
+            return false;
+        if (size - offset < length)
+            return false;
+        string = String((const char*)&data[offset], length);
+        offset += length;
+        return true;
+    }
+
+    Optional<JsonValue> read_value()
+    {
+        u8 type = 0;
+        if (!read_u8(type))
+            return {};
+        switch ((CompiledGMLValueType)type) {
+        case CompiledGMLValueType::Null:
+            return JsonValue();
+        case CompiledGMLValueType::BoolFalse:
+            return JsonValue(false);
+        case CompiledGMLValueType::BoolTrue:
+            return JsonValue(true);
+        case CompiledGMLValueType::Int32: {
+            u32 value = 0;
+            if (!read_u32(value))
+                return {};
+            return JsonValue((i32)value);
+        }
+        case CompiledGMLValueType::Int64: {
+            u64 value = 0;
+            if (!read_u64(value))
+                return {};
+            return JsonValue((i64)value);
+        }
+        case CompiledGMLValueType::UnsignedInt32: {
+            u32 value = 0;
+            if (!read_u32(value))
+                return {};
+            return JsonValue(value);
+        }
+        case CompiledGMLValueType::UnsignedInt64: {
+            u64 value = 0;
+            if (!read_u64(value))
+                return {};
+            return JsonValue(value);
+        }
+        case CompiledGMLValueType::Double: {
+            u64 value = 0;
+            if (!read_u64(value))
+                return {};
+            return JsonValue(bit_cast<double>(value));
+        }
+        case CompiledGMLValueType::String: {
+            String string;
+            if (!read_string(string))
+                return {};
+            return JsonValue(move(string));
+        }
+        case CompiledGMLValueType::Array: {
+            u32 count = 0;
+            if (!read_u32(count))
+                return {};
+            JsonArray array;
+            for (u32 i = 0; i < count; ++i) {
+                auto element = read_value();
+                if (!element.has_value())
+                    return {};
+                array.append(element.release_value());
+            }
+            return JsonValue(move(array));
+        }
+        case CompiledGMLValueType::Object: {
+            u32 count = 0;
+            if (!read_u32(count))
+                return {};
+            JsonObject object;
+            for (u32 i = 0; i < count; ++i) {
+                String key;
+                if (!read_string(key))
+                    return {};
+                auto member = read_value();
+                if (!member.has_value())
+                    return {};
+                object.set(key, member.release_value());
+            }
+            return JsonValue(move(object));
+        }
+        }
+        return {};
+    }
+};
+
+}
+
+JsonValue parse_compiled_gml(const StringView& string)
+{
+    if (!is_compiled_gml(string))
+        return JsonValue();
+
+    CompiledGMLReader reader {
+        (const u8*)string.characters_without_null_termination(),
+        string.length(),
+        sizeof(compiled_gml_magic),
+    };
+    auto value = reader.read_value();
+    if (!value.has_value() || reader.offset != reader.size) {
+        dbgln("Corrupt compiled GML blob");
+        return JsonValue();
+    }
+    return value.release_value();
+}
+
 }
@@ -12,4 +12,13 @@ namespace GUI {
 
 JsonValue parse_gml(const StringView&);
 
+// Compiled GML is the parsed object tree serialized into a compact binary
+// form at build time (see DevTools/GMLCompiler), so applications don't have
+// to lex and parse their layouts on every launch. The blob lives in the
+// binary's read-only data and is recognized by a magic prefix that can never
+// start a GML source file.
+bool is_compiled_gml(const StringView&);
+ByteBuffer compile_gml(const JsonValue&);
+JsonValue parse_compiled_gml(const StringView&);
+
 }
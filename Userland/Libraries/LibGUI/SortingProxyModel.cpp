@@ -162,8 +162,15 @@ ModelIndex SortingProxyModel::parent_index(const ModelIndex& proxy_index) const
 
 void SortingProxyModel::sort_mapping(Mapping& mapping, int column, SortOrder sort_order)
 {
+    int row_count = source().row_count(mapping.source_parent);
+    if (row_count != static_cast<int>(mapping.source_rows.size())) {
+        mapping.source_rows.resize(row_count);
+        mapping.proxy_rows.resize(row_count);
+        for (int i = 0; i < row_count; ++i)
+            mapping.source_rows[i] = i;
+    }
+
     if (column == -1) {
-        int row_count = source().row_count(mapping.source_parent);
         for (int i = 0; i < row_count; ++i) {
             mapping.source_rows[i] = i;
             mapping.proxy_rows[i] = i;
@@ -171,16 +178,31 @@ void SortingProxyModel::sort_mapping(Mapping& mapping, int column, SortOrder sor
         return;
     }
 
-    auto old_source_rows = mapping.source_rows;
-
-    int row_count = source().row_count(mapping.source_parent);
-    for (int i = 0; i < row_count; ++i)
-        mapping.source_rows[i] = i;
-
-    quick_sort(mapping.source_rows, [&](auto row1, auto row2) -> bool {
+    auto compare_rows = [&](int row1, int row2) -> bool {
         bool is_less_than = less_than(source().index(row1, column, mapping.source_parent), source().index(row2, column, mapping.source_parent));
         return sort_order == SortOrder::Ascending ? is_less_than : !is_less_than;
-    });
+    };
+
+    // A refresh that keeps indices valid (e.g. SystemMonitor's per-second
+    // update) rarely perturbs the order. If the previous permutation is
+    // still sorted, keep it: a single O(n) pass instead of a full re-sort,
+    // and the views' cursors and selections need no fixing up.
+    bool still_sorted = true;
+    for (int i = 1; i < row_count; ++i) {
+        if (compare_rows(mapping.source_rows[i], mapping.source_rows[i - 1])) {
+            still_sorted = false;
+            break;
+        }
+    }
+    if (still_sorted)
+        return;
+
+    auto old_source_rows = mapping.source_rows;
+
+    // Sorting the previous permutation (instead of resetting to source
+    // order first) means a mostly-sorted refresh stays mostly sorted, which
+    // is the cheap case for quick_sort.
+    quick_sort(mapping.source_rows, compare_rows);
 
     for (int i = 0; i < row_count; ++i)
         mapping.proxy_rows[mapping.source_rows[i]] = i;
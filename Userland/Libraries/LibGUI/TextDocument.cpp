@@ -173,7 +173,7 @@ void TextDocumentLine::clear(TextDocument& document)
     document.update_views({});
 }
 
-void TextDocumentLine::set_text(TextDocument& document, const Vector<u32> text)
+void TextDocumentLine::set_text(TextDocument& document, Vector<u32> text)
 {
     m_text = move(text);
     document.update_views({});
@@ -224,6 +224,19 @@ void TextDocumentLine::insert(TextDocument& document, size_t index, u32 code_poi
     document.update_views({});
 }
 
+void TextDocumentLine::insert(TextDocument& document, size_t index, const u32* code_points, size_t length)
+{
+    if (length == 0)
+        return;
+    Vector<u32> new_text;
+    new_text.ensure_capacity(m_text.size() + length);
+    new_text.append(m_text.data(), index);
+    new_text.append(code_points, length);
+    new_text.append(m_text.data() + index, m_text.size() - index);
+    m_text = move(new_text);
+    document.update_views({});
+}
+
 void TextDocumentLine::remove(TextDocument& document, size_t index)
 {
     if (index == length()) {
@@ -329,7 +342,9 @@ void TextDocument::set_all_cursors(const TextPosition& position)
 
 String TextDocument::text() const
 {
-    StringBuilder builder;
+    // Documents can be arbitrarily large, so assemble the text in chunks
+    // instead of repeatedly growing one contiguous buffer.
+    StringBuilder builder(StringBuilder::OutputMode::Chunked);
     for (size_t i = 0; i < line_count(); ++i) {
         auto& line = this->line(i);
         builder.append(line.view());
@@ -345,7 +360,7 @@ String TextDocument::text_in_range(const TextRange& a_range) const
     if (is_empty() || line_count() < range.end().line() - range.start().line())
         return String("");
 
-    StringBuilder builder;
+    StringBuilder builder(StringBuilder::OutputMode::Chunked);
     for (size_t i = range.start().line(); i <= range.end().line(); ++i) {
         auto& line = this->line(i);
         size_t selection_start_column_on_line = range.start().line() == i ? range.start().column() : 0;
@@ -838,13 +853,54 @@ void RemoveTextCommand::undo()
     m_document.set_all_cursors(new_cursor);
 }
 
-TextPosition TextDocument::insert_at(const TextPosition& position, const StringView& text, const Client* client)
+TextPosition TextDocument::insert_at(const TextPosition& position, const StringView& text, const Client*)
 {
-    TextPosition cursor = position;
+    if (text.is_empty())
+        return position;
+
+    // Decode the inserted text into its lines up front, so each affected
+    // document line gets spliced exactly once instead of shifting its tail
+    // around for every single code point.
+    Vector<Vector<u32>> text_lines;
+    text_lines.append(Vector<u32>());
     Utf8View utf8_view(text);
-    for (auto code_point : utf8_view)
-        cursor = insert_at(cursor, code_point, client);
-    return cursor;
+    for (auto code_point : utf8_view) {
+        if (code_point == '\n')
+            text_lines.append(Vector<u32>());
+        else
+            text_lines.last().append(code_point);
+    }
+
+    auto& first_line = line(position.line());
+
+    if (text_lines.size() == 1) {
+        first_line.insert(*this, position.column(), text_lines.first().data(), text_lines.first().size());
+        notify_did_change();
+        return { position.line(), position.column() + text_lines.first().size() };
+    }
+
+    // Everything after the insertion point moves to the end of the last
+    // inserted line.
+    auto& last_text_line = text_lines.last();
+    size_t last_text_line_length = last_text_line.size();
+    last_text_line.append(first_line.code_points() + position.column(), first_line.length() - position.column());
+
+    first_line.truncate(*this, position.column());
+    first_line.append(*this, text_lines.first().data(), text_lines.first().size());
+
+    for (size_t i = 1; i < text_lines.size(); ++i) {
+        auto new_line = make<TextDocumentLine>(*this);
+        new_line->set_text(*this, move(text_lines[i]));
+        lines().insert(position.line() + i, move(new_line));
+    }
+
+    if (m_client_notifications_enabled) {
+        for (auto* client : m_clients)
+            client->document_did_insert_lines(position.line() + 1, text_lines.size() - 1);
+    }
+
+    notify_did_change();
+    return { position.line() + text_lines.size() - 1, last_text_line_length };
 }
 
 TextPosition TextDocument::insert_at(const TextPosition& position, u32 code_point, const Client*)
@@ -870,10 +926,16 @@ void TextDocument::remove(const TextRange& unnormalized_range)
 
     auto range = unnormalized_range.normalized();
 
-    // First delete all the lines in between the first and last one.
-    for (size_t i = range.start().line() + 1; i < range.end().line();) {
-        remove_line(i);
-        range.end().set_line(range.end().line() - 1);
+    // First delete all the lines in between the first and last one, in one go.
+    size_t first_removed_line = range.start().line() + 1;
+    if (range.end().line() > first_removed_line) {
+        size_t removed_line_count = range.end().line() - first_removed_line;
+        lines().remove(first_removed_line, removed_line_count);
+        if (m_client_notifications_enabled) {
+            for (auto* client : m_clients)
+                client->document_did_remove_lines(first_removed_line, removed_line_count);
+        }
+        range.end().set_line(range.end().line() - removed_line_count);
     }
 
     if (range.start().line() == range.end().line()) {
@@ -42,7 +42,9 @@ public:
         virtual ~Client();
         virtual void document_did_append_line() = 0;
         virtual void document_did_insert_line(size_t) = 0;
+        virtual void document_did_insert_lines(size_t start_line, size_t count) = 0;
         virtual void document_did_remove_line(size_t) = 0;
+        virtual void document_did_remove_lines(size_t start_line, size_t count) = 0;
         virtual void document_did_remove_all_lines() = 0;
         virtual void document_did_change() = 0;
         virtual void document_did_set_text() = 0;
@@ -163,6 +165,7 @@ public:
     void append(TextDocument&, u32);
     void prepend(TextDocument&, u32);
     void insert(TextDocument&, size_t index, u32);
+    void insert(TextDocument&, size_t index, const u32*, size_t);
     void remove(TextDocument&, size_t index);
     void append(TextDocument&, const u32*, size_t);
     void truncate(TextDocument&, size_t length);
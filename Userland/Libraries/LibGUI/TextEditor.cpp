@@ -1634,6 +1634,13 @@ void TextEditor::document_did_remove_line(size_t line_index)
     update();
 }
 
+void TextEditor::document_did_remove_lines(size_t line_index, size_t count)
+{
+    m_line_visual_data.remove(line_index, count);
+    recompute_all_visual_lines();
+    update();
+}
+
 void TextEditor::document_did_remove_all_lines()
 {
     m_line_visual_data.clear();
@@ -1648,6 +1655,14 @@ void TextEditor::document_did_insert_line(size_t line_index)
     update();
 }
 
+void TextEditor::document_did_insert_lines(size_t line_index, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        m_line_visual_data.insert(line_index + i, make<LineVisualData>());
+    recompute_all_visual_lines();
+    update();
+}
+
 void TextEditor::document_did_change()
 {
     did_change();
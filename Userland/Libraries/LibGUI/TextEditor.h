@@ -219,7 +219,9 @@ private:
     // ^TextDocument::Client
     virtual void document_did_append_line() override;
     virtual void document_did_insert_line(size_t) override;
+    virtual void document_did_insert_lines(size_t, size_t) override;
     virtual void document_did_remove_line(size_t) override;
+    virtual void document_did_remove_lines(size_t, size_t) override;
     virtual void document_did_remove_all_lines() override;
     virtual void document_did_change() override;
     virtual void document_did_set_text() override;
@@ -318,6 +318,7 @@ void Widget::set_layout(NonnullRefPtr<Layout> layout)
     if (m_layout) {
         add_child(*m_layout);
         m_layout->notify_adopted({}, *this);
+        m_layout_dirty = true;
         do_layout();
     } else {
         update();
@@ -326,6 +327,10 @@ void Widget::set_layout(NonnullRefPtr<Layout> layout)
 
 void Widget::do_layout()
 {
+    if (!m_layout_dirty && size() == m_last_layout_size)
+        return;
+    m_layout_dirty = false;
+    m_last_layout_size = size();
     for_each_child_widget([&](auto& child) {
         child.do_layout();
         return IterationDecision::Continue;
@@ -713,6 +718,11 @@ void Widget::set_max_size(const Gfx::IntSize& size)
 
 void Widget::invalidate_layout()
 {
+    // A widget's layout inputs feed into every layout above it, so the whole
+    // ancestor chain has to run again. Subtrees that stay clean (and keep
+    // their size) are skipped by do_layout().
+    for (auto* ancestor = this; ancestor; ancestor = ancestor->parent_widget())
+        ancestor->m_layout_dirty = true;
     if (window())
         window()->schedule_relayout();
 }
@@ -973,7 +983,7 @@ bool Widget::load_from_gml(const StringView& gml_string)
 
 bool Widget::load_from_gml(const StringView& gml_string, RefPtr<Core::Object> (*unregistered_child_handler)(const String&))
 {
-    auto value = parse_gml(gml_string);
+    auto value = is_compiled_gml(gml_string) ? parse_compiled_gml(gml_string) : parse_gml(gml_string);
     if (!value.is_object())
         return false;
     return load_from_json(value.as_object(), unregistered_child_handler);
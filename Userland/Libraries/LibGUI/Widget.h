@@ -340,6 +340,8 @@ private:
 
     Window* m_window { nullptr };
     RefPtr<Layout> m_layout;
+    bool m_layout_dirty { true };
+    Gfx::IntSize m_last_layout_size;
 
     Gfx::IntRect m_relative_rect;
     Gfx::ColorRole m_background_role;
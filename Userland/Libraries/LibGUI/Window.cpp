@@ -531,6 +531,18 @@ void Window::handle_left_event()
     Application::the()->set_drag_hovered_widget({}, nullptr);
 }
 
+bool Window::should_coalesce_event(const Core::Event& newer, const Core::Event& older) const
+{
+    // A positional event still sitting in the queue is redundant once a newer
+    // one arrives: only the latest pointer position / window size matters.
+    // Clicks, wheel scrolls etc. must all be delivered.
+    if (newer.type() == Event::Resize && older.type() == Event::Resize)
+        return true;
+    if (m_mouse_move_event_coalescing_enabled && newer.type() == Event::MouseMove && older.type() == Event::MouseMove)
+        return true;
+    return false;
+}
+
 void Window::event(Core::Event& event)
 {
     ScopeGuard guard([&] {
@@ -610,6 +622,20 @@ void Window::update(const Gfx::IntRect& a_rect)
         }
     }
 
+    // Merge overlapping pending rects into the incoming one, so an update
+    // storm degenerates into a few large rects instead of a long list.
+    auto rect_to_add = a_rect;
+    for (size_t i = 0; i < m_pending_paint_event_rects.size();) {
+        auto& pending_rect = m_pending_paint_event_rects[i];
+        if (rect_to_add.intersects(pending_rect)) {
+            dbgln_if(UPDATE_COALESCING_DEBUG, "Merging pending rect {} into {}", pending_rect, rect_to_add);
+            rect_to_add = rect_to_add.united(pending_rect);
+            m_pending_paint_event_rects.remove(i);
+            continue;
+        }
+        ++i;
+    }
+
     if (m_pending_paint_event_rects.is_empty()) {
         deferred_invoke([this](auto&) {
             auto rects = move(m_pending_paint_event_rects);
@@ -618,7 +644,7 @@ void Window::update(const Gfx::IntRect& a_rect)
             WindowServerConnection::the().async_invalidate_rect(m_window_id, rects, false);
         });
     }
-    m_pending_paint_event_rects.append(a_rect);
+    m_pending_paint_event_rects.append(rect_to_add);
 }
 
 void Window::set_main_widget(Widget* widget)
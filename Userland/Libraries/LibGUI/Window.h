@@ -108,6 +108,12 @@ public:
     void center_within(const Window&);
 
     virtual void event(Core::Event&) override;
+    virtual bool should_coalesce_event(const Core::Event& newer, const Core::Event& older) const override;
+
+    // Mouse move coalescing keeps only the latest queued move per window.
+    // Disable it to get the full motion history (e.g. freehand drawing).
+    bool mouse_move_event_coalescing_enabled() const { return m_mouse_move_event_coalescing_enabled; }
+    void set_mouse_move_event_coalescing_enabled(bool enabled) { m_mouse_move_event_coalescing_enabled = enabled; }
 
     bool is_visible() const;
     bool is_active() const;
@@ -265,6 +271,7 @@ private:
     bool m_frameless { false };
     bool m_layout_pending { false };
     bool m_visible_for_timer_purposes { true };
+    bool m_mouse_move_event_coalescing_enabled { true };
     bool m_visible { false };
     bool m_accessory { false };
     bool m_moved_by_client { false };
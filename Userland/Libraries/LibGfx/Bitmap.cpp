@@ -587,6 +587,13 @@ Optional<BackingStore> Bitmap::allocate_backing_store(BitmapFormat format, const
     int map_flags = MAP_ANONYMOUS | MAP_PRIVATE;
     if (purgeable == Purgeable::Yes)
         map_flags |= MAP_NORESERVE;
+#ifdef __serenity__
+    // Ask the kernel to back large bitmaps with 2MiB pages; scanning a
+    // multi-megabyte bitmap otherwise chews through the TLB. Purgeable
+    // bitmaps stay on 4KiB pages so individual pages can be purged.
+    if (purgeable == Purgeable::No && data_size_in_bytes >= 4 * MiB)
+        map_flags |= MAP_HUGEPAGES;
+#endif
 #ifdef __serenity__
     void* data = mmap_with_name(nullptr, data_size_in_bytes, PROT_READ | PROT_WRITE, map_flags, 0, 0, String::formatted("GraphicsBitmap [{}]", size).characters());
 #else
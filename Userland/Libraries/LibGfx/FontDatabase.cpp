@@ -78,11 +78,23 @@ Font& FontDatabase::default_fixed_width_font()
 struct FontDatabase::Private {
     HashMap<String, RefPtr<Gfx::Font>> full_name_to_font_map;
     Vector<RefPtr<Typeface>> typefaces;
+    bool fonts_loaded { false };
 };
 
 FontDatabase::FontDatabase()
     : m_private(make<Private>())
 {
+}
+
+void FontDatabase::ensure_fonts_loaded()
+{
+    // Loading the fonts is deferred until somebody actually asks for one, so
+    // that processes which use LibGfx without ever rendering text don't pay
+    // for scanning and mapping every font on startup.
+    if (m_private->fonts_loaded)
+        return;
+    m_private->fonts_loaded = true;
+
     Core::DirIterator dir_iterator("/res/fonts", Core::DirIterator::SkipDots);
     if (dir_iterator.has_error()) {
         warnln("DirIterator: {}", dir_iterator.error_string());
@@ -113,6 +125,7 @@ FontDatabase::~FontDatabase()
 
 void FontDatabase::for_each_font(Function<void(const Gfx::Font&)> callback)
 {
+    ensure_fonts_loaded();
     Vector<RefPtr<Gfx::Font>> fonts;
     fonts.ensure_capacity(m_private->full_name_to_font_map.size());
     for (auto& it : m_private->full_name_to_font_map)
@@ -124,6 +137,7 @@ void FontDatabase::for_each_font(Function<void(const Gfx::Font&)> callback)
 
 void FontDatabase::for_each_fixed_width_font(Function<void(const Gfx::Font&)> callback)
 {
+    ensure_fonts_loaded();
     Vector<RefPtr<Gfx::Font>> fonts;
     fonts.ensure_capacity(m_private->full_name_to_font_map.size());
     for (auto& it : m_private->full_name_to_font_map) {
@@ -137,6 +151,7 @@ void FontDatabase::for_each_fixed_width_font(Function<void(const Gfx::Font&)> ca
 
 RefPtr<Gfx::Font> FontDatabase::get_by_name(const StringView& name)
 {
+    ensure_fonts_loaded();
     auto it = m_private->full_name_to_font_map.find(name);
     if (it == m_private->full_name_to_font_map.end()) {
         dbgln("Font lookup failed: '{}'", name);
@@ -147,6 +162,7 @@ RefPtr<Gfx::Font> FontDatabase::get_by_name(const StringView& name)
 
 RefPtr<Gfx::Font> FontDatabase::get(const String& family, unsigned size, unsigned weight)
 {
+    ensure_fonts_loaded();
     for (auto typeface : m_private->typefaces) {
         if (typeface->family() == family && typeface->weight() == weight)
             return typeface->get_font(size);
@@ -156,6 +172,7 @@ RefPtr<Gfx::Font> FontDatabase::get(const String& family, unsigned size, unsigne
 
 RefPtr<Gfx::Font> FontDatabase::get(const String& family, const String& variant, unsigned size)
 {
+    ensure_fonts_loaded();
     for (auto typeface : m_private->typefaces) {
         if (typeface->family() == family && typeface->variant() == variant)
             return typeface->get_font(size);
@@ -176,6 +193,7 @@ RefPtr<Typeface> FontDatabase::get_or_create_typeface(const String& family, cons
 
 void FontDatabase::for_each_typeface(Function<void(const Typeface&)> callback)
 {
+    ensure_fonts_loaded();
     for (auto typeface : m_private->typefaces) {
         callback(*typeface);
     }
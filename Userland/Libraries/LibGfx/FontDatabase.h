@@ -54,6 +54,7 @@ private:
     FontDatabase();
     ~FontDatabase();
 
+    void ensure_fonts_loaded();
     RefPtr<Typeface> get_or_create_typeface(const String& family, const String& variant);
 
     struct Private;
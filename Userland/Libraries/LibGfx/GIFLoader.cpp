@@ -82,6 +82,37 @@ struct GIFLoadingContext {
     RefPtr<Gfx::Bitmap> frame_buffer;
     size_t current_frame { 0 };
     RefPtr<Gfx::Bitmap> prev_frame_buffer;
+
+    // Composited frames we've already handed out, most recently used last.
+    // Animation ticks loop over the same frames forever, so a small cache
+    // makes every tick after the first loop a plain lookup instead of an
+    // LZW decode + composite + clone.
+    static constexpr size_t max_cached_frames = 16;
+    struct CachedFrame {
+        size_t index { 0 };
+        NonnullRefPtr<Gfx::Bitmap> bitmap;
+    };
+    Vector<CachedFrame, max_cached_frames> frame_cache;
+
+    RefPtr<Gfx::Bitmap> cached_frame(size_t index)
+    {
+        for (size_t i = 0; i < frame_cache.size(); ++i) {
+            if (frame_cache[i].index != index)
+                continue;
+            auto entry = frame_cache.take(i);
+            auto bitmap = entry.bitmap;
+            frame_cache.append(move(entry));
+            return bitmap;
+        }
+        return nullptr;
+    }
+
+    void add_frame_to_cache(size_t index, NonnullRefPtr<Gfx::Bitmap> bitmap)
+    {
+        if (frame_cache.size() >= max_cached_frames)
+            frame_cache.take_first();
+        frame_cache.append({ index, move(bitmap) });
+    }
 };
 
 RefPtr<Gfx::Bitmap> load_gif(String const& path)
@@ -729,6 +760,20 @@ ImageFrameDescriptor GIFImageDecoderPlugin::frame(size_t i)
         }
     }
 
+    if (i >= m_context->images.size())
+        return {};
+
+    ImageFrameDescriptor frame {};
+    frame.duration = m_context->images.at(i).duration * 10;
+    if (frame.duration <= 10) {
+        frame.duration = 100;
+    }
+
+    if (auto cached_bitmap = m_context->cached_frame(i)) {
+        frame.image = move(cached_bitmap);
+        return frame;
+    }
+
     if (m_context->error_state == GIFLoadingContext::ErrorState::NoError && !decode_frame(*m_context, i)) {
         if (m_context->state < GIFLoadingContext::State::FrameComplete || !decode_frame(*m_context, 0)) {
             m_context->error_state = GIFLoadingContext::ErrorState::FailedToDecodeAnyFrame;
@@ -737,14 +782,13 @@ ImageFrameDescriptor GIFImageDecoderPlugin::frame(size_t i)
         m_context->error_state = GIFLoadingContext::ErrorState::FailedToDecodeAllFrames;
     }
 
-    ImageFrameDescriptor frame {};
-    frame.image = m_context->frame_buffer->clone();
-    frame.duration = m_context->images.at(i).duration * 10;
-
-    if (frame.duration <= 10) {
-        frame.duration = 100;
-    }
-
+    auto image = m_context->frame_buffer->clone();
+    if (!image)
+        return {};
+    // Don't cache the stand-in frame we hand out after a partial decode failure.
+    if (m_context->error_state == GIFLoadingContext::ErrorState::NoError)
+        m_context->add_frame_to_cache(i, *image);
+    frame.image = move(image);
     return frame;
 }
 
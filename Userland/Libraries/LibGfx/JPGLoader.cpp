@@ -15,6 +15,7 @@
 #include <AK/Vector.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/JPGLoader.h>
+#include <LibThreading/ThreadPool.h>
 #include <math.h>
 
 #define JPG_INVALID 0X0000
@@ -838,9 +839,46 @@ static bool skip_marker_with_length(InputMemoryStream& stream)
     return !stream.handle_any_error();
 }
 
-static void dequantize(JPGLoadingContext& context, Vector<Macroblock>& macroblocks)
+// Runs process(vcursor_start, vcursor_end) over contiguous bands of macroblock
+// rows, one band per thread pool worker. The post-entropy stages below only
+// touch the macroblocks of the row they're on, so the bands are independent.
+// Small images stay on the caller's thread; waking the pool costs more than
+// it saves there.
+template<typename Process>
+static void for_each_macroblock_row_band(const JPGLoadingContext& context, Process process)
 {
-    for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.vsample_factor) {
+    const u32 vcount = context.mblock_meta.vcount;
+    const u32 row_count = vcount / context.vsample_factor;
+    auto& pool = Threading::ThreadPool::the();
+    const u32 band_count = min(static_cast<u32>(pool.worker_count()), row_count);
+
+    if (band_count <= 1 || row_count < 16) {
+        process(0u, vcount);
+        return;
+    }
+
+    const u32 rows_per_band = (row_count + band_count - 1) / band_count;
+    Vector<NonnullRefPtr<Threading::ThreadPool::Task>> tasks;
+    for (u32 band = 1; band < band_count; ++band) {
+        const u32 vcursor_start = band * rows_per_band * context.vsample_factor;
+        const u32 vcursor_end = min(vcursor_start + rows_per_band * context.vsample_factor, vcount);
+        if (vcursor_start >= vcursor_end)
+            break;
+        tasks.append(pool.submit([&process, vcursor_start, vcursor_end] {
+            process(vcursor_start, vcursor_end);
+        }));
+    }
+
+    // The first band is ours; no point sleeping while the workers do all the work.
+    process(0u, min(rows_per_band * context.vsample_factor, vcount));
+
+    for (auto& task : tasks)
+        task->wait();
+}
+
+static void dequantize(JPGLoadingContext& context, Vector<Macroblock>& macroblocks, u32 vcursor_start, u32 vcursor_end)
+{
+    for (u32 vcursor = vcursor_start; vcursor < vcursor_end; vcursor += context.vsample_factor) {
         for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.hsample_factor) {
             for (auto it = context.components.begin(); it != context.components.end(); ++it) {
                 auto& component = it->value;
@@ -859,7 +897,7 @@ static void dequantize(JPGLoadingContext& context, Vector<Macroblock>& macrobloc
     }
 }
 
-static void inverse_dct(const JPGLoadingContext& context, Vector<Macroblock>& macroblocks)
+static void inverse_dct(const JPGLoadingContext& context, Vector<Macroblock>& macroblocks, u32 vcursor_start, u32 vcursor_end)
 {
     static const float m0 = 2.0 * cos(1.0 / 16.0 * 2.0 * M_PI);
     static const float m1 = 2.0 * cos(2.0 / 16.0 * 2.0 * M_PI);
@@ -876,7 +914,7 @@ static void inverse_dct(const JPGLoadingContext& context, Vector<Macroblock>& ma
     static const float s6 = cos(6.0 / 16.0 * M_PI) / 2.0;
     static const float s7 = cos(7.0 / 16.0 * M_PI) / 2.0;
 
-    for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.vsample_factor) {
+    for (u32 vcursor = vcursor_start; vcursor < vcursor_end; vcursor += context.vsample_factor) {
         for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.hsample_factor) {
             for (auto it = context.components.begin(); it != context.components.end(); ++it) {
                 auto& component = it->value;
@@ -1026,9 +1064,9 @@ static void inverse_dct(const JPGLoadingContext& context, Vector<Macroblock>& ma
     }
 }
 
-static void ycbcr_to_rgb(const JPGLoadingContext& context, Vector<Macroblock>& macroblocks)
+static void ycbcr_to_rgb(const JPGLoadingContext& context, Vector<Macroblock>& macroblocks, u32 vcursor_start, u32 vcursor_end)
 {
-    for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.vsample_factor) {
+    for (u32 vcursor = vcursor_start; vcursor < vcursor_end; vcursor += context.vsample_factor) {
         for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.hsample_factor) {
             const u32 chroma_block_index = vcursor * context.mblock_meta.hpadded_count + hcursor;
             const Macroblock& chroma = macroblocks[chroma_block_index];
@@ -1210,9 +1248,13 @@ static bool decode_jpg(JPGLoadingContext& context)
     }
 
     auto macroblocks = result.release_value();
-    dequantize(context, macroblocks);
-    inverse_dct(context, macroblocks);
-    ycbcr_to_rgb(context, macroblocks);
+    // Running all three stages on one band before moving on keeps the band's
+    // macroblocks hot in cache, on top of the bands running concurrently.
+    for_each_macroblock_row_band(context, [&](u32 vcursor_start, u32 vcursor_end) {
+        dequantize(context, macroblocks, vcursor_start, vcursor_end);
+        inverse_dct(context, macroblocks, vcursor_start, vcursor_end);
+        ycbcr_to_rgb(context, macroblocks, vcursor_start, vcursor_end);
+    });
     if (!compose_bitmap(context, macroblocks))
         return false;
     return true;
@@ -10,6 +10,7 @@
 #include <AK/MappedFile.h>
 #include <LibCompress/Zlib.h>
 #include <LibGfx/PNGLoader.h>
+#include <LibThreading/ThreadPool.h>
 #include <fcntl.h>
 #include <math.h>
 #include <stdio.h>
@@ -667,9 +668,8 @@ static int adam7_startx[8] = { 0, 0, 4, 0, 2, 0, 1, 0 };
 static int adam7_stepy[8] = { 1, 8, 8, 8, 4, 4, 2, 2 };
 static int adam7_stepx[8] = { 1, 8, 8, 4, 4, 2, 2, 1 };
 
-static bool decode_adam7_pass(PNGLoadingContext& context, Streamer& streamer, int pass)
+static bool read_adam7_pass_scanlines(PNGLoadingContext& context, Streamer& streamer, int pass, PNGLoadingContext& subimage_context)
 {
-    PNGLoadingContext subimage_context;
     subimage_context.width = adam7_width(context, pass);
     subimage_context.height = adam7_height(context, pass);
     subimage_context.channels = context.channels;
@@ -709,6 +709,14 @@ static bool decode_adam7_pass(PNGLoadingContext& context, Streamer& streamer, in
         }
     }
 
+    return true;
+}
+
+static bool process_adam7_pass(PNGLoadingContext& context, PNGLoadingContext& subimage_context, int pass)
+{
+    if (!subimage_context.width || !subimage_context.height)
+        return true;
+
     subimage_context.bitmap = Bitmap::create(context.bitmap->format(), { subimage_context.width, subimage_context.height });
     if (!unfilter(subimage_context)) {
         subimage_context.bitmap = nullptr;
@@ -731,8 +739,37 @@ static bool decode_png_adam7(PNGLoadingContext& context)
     if (!context.bitmap)
         return false;
 
+    // The pass scanlines have to come out of the deflate stream in order, but
+    // unfiltering and blitting them is independent work: each pass writes a
+    // disjoint set of pixels in the output bitmap, so the seven passes can run
+    // concurrently once all the scanline data has been read.
+    PNGLoadingContext subimage_contexts[8];
+    for (int pass = 1; pass <= 7; ++pass) {
+        if (!read_adam7_pass_scanlines(context, streamer, pass, subimage_contexts[pass]))
+            return false;
+    }
+
+    auto& pool = Threading::ThreadPool::the();
+    if (pool.worker_count() <= 1) {
+        for (int pass = 1; pass <= 7; ++pass) {
+            if (!process_adam7_pass(context, subimage_contexts[pass], pass))
+                return false;
+        }
+        return true;
+    }
+
+    bool pass_succeeded[8] = {};
+    Vector<NonnullRefPtr<Threading::ThreadPool::Task>> tasks;
+    for (int pass = 1; pass <= 7; ++pass) {
+        tasks.append(pool.submit([&context, &subimage_contexts, &pass_succeeded, pass] {
+            pass_succeeded[pass] = process_adam7_pass(context, subimage_contexts[pass], pass);
+        }));
+    }
+    for (auto& task : tasks)
+        task->wait();
+
     for (int pass = 1; pass <= 7; ++pass) {
-        if (!decode_adam7_pass(context, streamer, pass))
+        if (!pass_succeeded[pass])
             return false;
     }
     return true;
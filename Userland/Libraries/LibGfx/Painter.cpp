@@ -16,11 +16,13 @@
 #include <AK/Function.h>
 #include <AK/Memory.h>
 #include <AK/Queue.h>
-#include <AK/QuickSort.h>
 #include <AK/StdLibExtras.h>
 #include <AK/StringBuilder.h>
 #include <AK/Utf32View.h>
 #include <AK/Utf8View.h>
+#include <AK/HashMap.h>
+#include <AK/SIMD.h>
+#include <AK/TemporaryChange.h>
 #include <LibGfx/CharacterBitmap.h>
 #include <LibGfx/Palette.h>
 #include <LibGfx/Path.h>
@@ -32,8 +34,158 @@
 #    pragma GCC optimize("O3")
 #endif
 
+#if defined(__i386__) || defined(__x86_64__)
+#    include <cpuid.h>
+#    define GFX_HAS_SSE2_BLEND_KERNELS
+#endif
+
+namespace Gfx {
+
+// Cache of prerendered single-line text runs, so repeated draw_text() calls
+// with the same string, font and color (title bars, menus, the Terminal status
+// line, ...) can blit a finished run instead of re-walking the string and
+// re-drawing every glyph. See Painter::draw_cached_text_run().
+struct TextRunKey {
+    const Font* font { nullptr };
+    String text;
+    u32 color { 0 };
+
+    bool operator==(const TextRunKey& other) const
+    {
+        return font == other.font && text == other.text && color == other.color;
+    }
+};
+
+struct TextRunCacheEntry {
+    // Pinning the font keeps the raw key pointer from aliasing a new font
+    // allocated at a recycled address.
+    NonnullRefPtr<const Font> font;
+    // Null for runs that turned out not to be cacheable, so we don't keep
+    // re-checking them every paint.
+    RefPtr<Gfx::Bitmap> bitmap;
+    u64 last_used { 0 };
+};
+
+}
+
+namespace AK {
+
+template<>
+struct Traits<Gfx::TextRunKey> : public GenericTraits<Gfx::TextRunKey> {
+    static unsigned hash(const Gfx::TextRunKey& key)
+    {
+        return pair_int_hash(ptr_hash(key.font), pair_int_hash(key.text.hash(), key.color));
+    }
+};
+
+}
+
 namespace Gfx {
 
+#ifdef GFX_HAS_SSE2_BLEND_KERNELS
+
+using AK::SIMD::u32x4;
+
+// The build targets a plain i686 baseline, so SSE2 cannot be assumed at
+// compile time. The blending kernels below are compiled for SSE2 explicitly
+// and only selected at runtime when the CPU advertises support; everything
+// else keeps taking the scalar loops.
+static bool detect_sse2()
+{
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return false;
+    return (edx & bit_SSE2) != 0;
+}
+
+static const bool g_cpu_has_sse2 = detect_sse2();
+
+// Source-over blend of a row onto an opaque destination. This is an exact
+// integer equivalent of Color::blend() when the destination alpha is 255:
+// out = (dst * (255 - alpha) + src * alpha) / 255, where (x + (x >> 8) + 1) >> 8
+// computes floor(x / 255) exactly for x <= 65025.
+//
+// When scale_source_alpha is set, each pixel's alpha comes from the source and
+// is scaled by 'opacity' in 8.8 fixed point; otherwise 'opacity' is the
+// constant alpha (0-255) applied to every pixel.
+__attribute__((target("sse2"))) static void blend_row_opaque_destination_sse2(RGBA32* dst, const RGBA32* src, int count, u32 opacity, bool scale_source_alpha)
+{
+    for (; count >= 4; count -= 4, dst += 4, src += 4) {
+        u32x4 s, d;
+        __builtin_memcpy(&s, src, sizeof(s));
+        __builtin_memcpy(&d, dst, sizeof(d));
+
+        u32x4 alpha;
+        if (scale_source_alpha)
+            alpha = ((s >> 24) * opacity) >> 8;
+        else
+            alpha = u32x4 { opacity, opacity, opacity, opacity };
+        u32x4 inverse_alpha = 255 - alpha;
+
+        u32x4 b = (d & 0xff) * inverse_alpha + (s & 0xff) * alpha;
+        u32x4 g = ((d >> 8) & 0xff) * inverse_alpha + ((s >> 8) & 0xff) * alpha;
+        u32x4 r = ((d >> 16) & 0xff) * inverse_alpha + ((s >> 16) & 0xff) * alpha;
+        b = (b + (b >> 8) + 1) >> 8;
+        g = (g + (g >> 8) + 1) >> 8;
+        r = (r + (r >> 8) + 1) >> 8;
+
+        u32x4 result = 0xff000000 | (r << 16) | (g << 8) | b;
+        __builtin_memcpy(dst, &result, sizeof(result));
+    }
+
+    for (; count > 0; --count, ++dst, ++src) {
+        u32 s = *src;
+        u32 d = *dst;
+        u32 alpha = scale_source_alpha ? (((s >> 24) * opacity) >> 8) : opacity;
+        u32 inverse_alpha = 255 - alpha;
+        u32 b = ((d & 0xff) * inverse_alpha + (s & 0xff) * alpha);
+        u32 g = (((d >> 8) & 0xff) * inverse_alpha + ((s >> 8) & 0xff) * alpha);
+        u32 r = (((d >> 16) & 0xff) * inverse_alpha + ((s >> 16) & 0xff) * alpha);
+        b = (b + (b >> 8) + 1) >> 8;
+        g = (g + (g >> 8) + 1) >> 8;
+        r = (r + (r >> 8) + 1) >> 8;
+        *dst = 0xff000000 | (r << 16) | (g << 8) | b;
+    }
+}
+
+// Same blend as above with a constant source color, for translucent fills.
+__attribute__((target("sse2"))) static void fill_row_opaque_destination_sse2(RGBA32* dst, int count, Color color)
+{
+    const u32 alpha = color.alpha();
+    const u32 inverse_alpha = 255 - alpha;
+    const u32 src_b = color.blue() * alpha;
+    const u32 src_g = color.green() * alpha;
+    const u32 src_r = color.red() * alpha;
+
+    for (; count >= 4; count -= 4, dst += 4) {
+        u32x4 d;
+        __builtin_memcpy(&d, dst, sizeof(d));
+
+        u32x4 b = (d & 0xff) * inverse_alpha + src_b;
+        u32x4 g = ((d >> 8) & 0xff) * inverse_alpha + src_g;
+        u32x4 r = ((d >> 16) & 0xff) * inverse_alpha + src_r;
+        b = (b + (b >> 8) + 1) >> 8;
+        g = (g + (g >> 8) + 1) >> 8;
+        r = (r + (r >> 8) + 1) >> 8;
+
+        u32x4 result = 0xff000000 | (r << 16) | (g << 8) | b;
+        __builtin_memcpy(dst, &result, sizeof(result));
+    }
+
+    for (; count > 0; --count, ++dst) {
+        u32 d = *dst;
+        u32 b = ((d & 0xff) * inverse_alpha + src_b);
+        u32 g = (((d >> 8) & 0xff) * inverse_alpha + src_g);
+        u32 r = (((d >> 16) & 0xff) * inverse_alpha + src_r);
+        b = (b + (b >> 8) + 1) >> 8;
+        g = (g + (g >> 8) + 1) >> 8;
+        r = (r + (r >> 8) + 1) >> 8;
+        *dst = 0xff000000 | (r << 16) | (g << 8) | b;
+    }
+}
+
+#endif
+
 template<BitmapFormat format = BitmapFormat::Invalid>
 ALWAYS_INLINE Color get_pixel(const Gfx::Bitmap& bitmap, int x, int y)
 {
@@ -112,6 +264,18 @@ void Painter::fill_physical_rect(const IntRect& physical_rect, Color color)
     RGBA32* dst = m_target->scanline(physical_rect.top()) + physical_rect.left();
     const size_t dst_skip = m_target->pitch() / sizeof(RGBA32);
 
+#ifdef GFX_HAS_SSE2_BLEND_KERNELS
+    // The SSE2 kernel composites against an opaque destination, so it only
+    // applies to targets without an alpha channel.
+    if (g_cpu_has_sse2 && !m_target->has_alpha_channel()) {
+        for (int i = physical_rect.height() - 1; i >= 0; --i) {
+            fill_row_opaque_destination_sse2(dst, physical_rect.width(), color);
+            dst += dst_skip;
+        }
+        return;
+    }
+#endif
+
     for (int i = physical_rect.height() - 1; i >= 0; --i) {
         for (int j = 0; j < physical_rect.width(); ++j)
             dst[j] = Color::from_rgba(dst[j]).blend(color).value();
@@ -713,6 +877,25 @@ struct BlitState {
 template<BlitState::AlphaState has_alpha>
 static void do_blit_with_opacity(BlitState& state)
 {
+#ifdef GFX_HAS_SSE2_BLEND_KERNELS
+    // Without destination alpha, Color::blend() reduces to a plain source-over
+    // against an opaque background, which the SSE2 kernel implements exactly.
+    if constexpr (!(has_alpha & BlitState::DstAlpha)) {
+        if (g_cpu_has_sse2) {
+            constexpr bool scale_source_alpha = has_alpha & BlitState::SrcAlpha;
+            u32 opacity = scale_source_alpha
+                ? min(static_cast<u32>(state.opacity * 256.0f), 256u)
+                : static_cast<u32>(state.opacity * 255.0f);
+            for (int row = 0; row < state.row_count; ++row) {
+                blend_row_opaque_destination_sse2(state.dst, state.src, state.column_count, opacity, scale_source_alpha);
+                state.dst += state.dst_pitch;
+                state.src += state.src_pitch;
+            }
+            return;
+        }
+    }
+#endif
+
     for (int row = 0; row < state.row_count; ++row) {
         for (int x = 0; x < state.column_count; ++x) {
             Color dest_color = (has_alpha & BlitState::DstAlpha) ? Color::from_rgba(state.dst[x]) : Color::from_rgb(state.dst[x]);
@@ -1538,6 +1721,130 @@ void do_draw_text(const IntRect& rect, const TextType& text, const Font& font, T
     }
 }
 
+static constexpr size_t text_run_cache_byte_limit = 1 * MiB;
+static constexpr size_t text_run_cache_entry_limit = 1024;
+
+struct TextRunCache {
+    HashMap<TextRunKey, TextRunCacheEntry> entries;
+    size_t bytes { 0 };
+    u64 next_sequence { 0 };
+};
+
+static TextRunCache s_text_run_cache;
+static bool s_rendering_into_text_run_cache = false;
+
+static bool is_text_run_cacheable(const StringView& text, const Font& font)
+{
+    for (char c : text) {
+        // Non-ASCII text can hit the BiDi and emoji machinery, whose layout
+        // isn't position-independent, so don't try to cache it.
+        if (c < 0x20 || c > 0x7e)
+            return false;
+        if (c == ' ')
+            continue;
+        // Antialiased glyphs are blended against the background and cannot be
+        // composited a second time without artifacts.
+        if (!font.contains_glyph(c) || !font.glyph(c).is_glyph_bitmap())
+            return false;
+    }
+    return true;
+}
+
+static void evict_text_runs_if_needed(TextRunCache& cache)
+{
+    while (cache.bytes > text_run_cache_byte_limit || cache.entries.size() > text_run_cache_entry_limit) {
+        auto least_recently_used = cache.entries.begin();
+        for (auto it = cache.entries.begin(); it != cache.entries.end(); ++it) {
+            if (it->value.last_used < least_recently_used->value.last_used)
+                least_recently_used = it;
+        }
+        if (least_recently_used == cache.entries.end())
+            break;
+        if (least_recently_used->value.bitmap)
+            cache.bytes -= least_recently_used->value.bitmap->size_in_bytes();
+        auto key = least_recently_used->key;
+        cache.entries.remove(key);
+    }
+}
+
+bool Painter::draw_cached_text_run(const IntRect& rect, const StringView& raw_text, const Font& font, TextAlignment alignment, Color color)
+{
+    if (s_rendering_into_text_run_cache)
+        return false;
+    if (scale() != 1 || color.alpha() != 255 || raw_text.is_empty())
+        return false;
+
+    int run_width = font.width(raw_text);
+    int run_height = font.glyph_height();
+    if (run_width > rect.width() || run_height > rect.height())
+        return false;
+
+    auto& cache = s_text_run_cache;
+    TextRunKey key { &font, raw_text, color.value() };
+    auto it = cache.entries.find(key);
+    if (it == cache.entries.end()) {
+        RefPtr<Gfx::Bitmap> bitmap;
+        if (is_text_run_cacheable(raw_text, font) && run_width > 0) {
+            bitmap = Bitmap::create(BitmapFormat::BGRA8888, { run_width, run_height });
+            if (bitmap) {
+                // The run is rendered with the same layout machinery it would
+                // normally go through, just against a transparent background.
+                TemporaryChange rendering_change(s_rendering_into_text_run_cache, true);
+                Painter painter(*bitmap);
+                painter.draw_text(bitmap->rect(), raw_text, font, TextAlignment::TopLeft, color, TextElision::None);
+            }
+        }
+        evict_text_runs_if_needed(cache);
+        if (bitmap)
+            cache.bytes += bitmap->size_in_bytes();
+        cache.entries.set(key, TextRunCacheEntry { font, move(bitmap), cache.next_sequence });
+        it = cache.entries.find(key);
+        VERIFY(it != cache.entries.end());
+    }
+
+    auto& entry = it->value;
+    entry.last_used = ++cache.next_sequence;
+    if (!entry.bitmap)
+        return false;
+
+    // Replicate do_draw_text()'s placement of a single line that fits the rect.
+    IntRect bounding_rect { 0, 0, run_width, run_height };
+    switch (alignment) {
+    case TextAlignment::TopLeft:
+        bounding_rect.set_location(rect.location());
+        break;
+    case TextAlignment::TopRight:
+        bounding_rect.set_location({ (rect.right() + 1) - bounding_rect.width(), rect.y() });
+        break;
+    case TextAlignment::CenterLeft:
+        bounding_rect.set_location({ rect.x(), rect.center().y() - (bounding_rect.height() / 2) });
+        break;
+    case TextAlignment::CenterRight:
+        bounding_rect.set_location({ (rect.right() + 1) - bounding_rect.width(), rect.center().y() - (bounding_rect.height() / 2) });
+        break;
+    case TextAlignment::Center:
+        bounding_rect.center_within(rect);
+        break;
+    case TextAlignment::BottomLeft:
+        bounding_rect.set_location({ rect.x(), (rect.bottom() + 1) - bounding_rect.height() });
+        break;
+    case TextAlignment::BottomRight:
+        bounding_rect.set_location({ (rect.right() + 1) - bounding_rect.width(), (rect.bottom() + 1) - bounding_rect.height() });
+        break;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+
+    auto point = bounding_rect.location();
+    if (is_vertically_centered_text_alignment(alignment)) {
+        int distance_from_baseline_to_bottom = (font.glyph_height() - 1) - font.baseline();
+        point.translate_by(0, distance_from_baseline_to_bottom / 2);
+    }
+
+    blit(point, *entry.bitmap, entry.bitmap->rect(), 1.0f, true);
+    return true;
+}
+
 void Painter::draw_text(const IntRect& rect, const StringView& text, TextAlignment alignment, Color color, TextElision elision)
 {
     draw_text(rect, text, font(), alignment, color, elision);
@@ -1550,6 +1857,9 @@ void Painter::draw_text(const IntRect& rect, const Utf32View& text, TextAlignmen
 
 void Painter::draw_text(const IntRect& rect, const StringView& raw_text, const Font& font, TextAlignment alignment, Color color, TextElision elision)
 {
+    if (draw_cached_text_run(rect, raw_text, font, alignment, color))
+        return;
+
     Utf8View text { raw_text };
     do_draw_text(rect, Utf8View(text), font, alignment, elision, [&](const IntRect& r, u32 code_point) {
         draw_glyph_or_emoji(r.location(), code_point, font, color);
@@ -2048,10 +2358,17 @@ void Painter::fill_path(Path& path, Color color, WindingRule winding_rule)
     while (scanline >= last_y) {
         Optional<IntPoint> previous_to;
         if (active_list.size()) {
-            // sort the active list by 'x' from right to left
-            quick_sort(active_list, [](const auto& line0, const auto& line1) {
-                return line1.x < line0.x;
-            });
+            // Sort the active list by 'x' from right to left. It is almost
+            // sorted already (each edge's x only moved by its inverse slope
+            // since the previous scanline), so an insertion pass beats
+            // re-sorting from scratch.
+            for (size_t i = 1; i < active_list.size(); ++i) {
+                auto segment = active_list[i];
+                size_t j = i;
+                for (; j > 0 && active_list[j - 1].x < segment.x; --j)
+                    active_list[j] = active_list[j - 1];
+                active_list[j] = move(segment);
+            }
             if constexpr (FILL_PATH_DEBUG) {
                 if ((int)scanline % 10 == 0) {
                     draw_text(IntRect(active_list.last().x - 20, scanline, 20, 10), String::number((int)scanline));
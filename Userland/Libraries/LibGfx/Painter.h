@@ -133,6 +133,7 @@ protected:
     void fill_rect_with_draw_op(const IntRect&, Color);
     void blit_with_opacity(const IntPoint&, const Gfx::Bitmap&, const IntRect& src_rect, float opacity, bool apply_alpha = true);
     void draw_physical_pixel(const IntPoint&, Color, int thickness = 1);
+    bool draw_cached_text_run(const IntRect&, const StringView&, const Font&, TextAlignment, Color);
 
     struct State {
         const Font* font;
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <LibHTTP/ConnectionPool.h>
+#include <LibTLS/TLSv12.h>
+
+namespace HTTP {
+
+static constexpr int idle_connection_timeout_ms = 15'000;
+static constexpr int sweep_interval_ms = 5'000;
+static constexpr size_t max_idle_connections_per_host = 4;
+
+ConnectionPool& ConnectionPool::the()
+{
+    static ConnectionPool* s_the;
+    if (!s_the)
+        s_the = new ConnectionPool;
+    return *s_the;
+}
+
+static String key_for(ConnectionPool::SocketType type, const String& host, u16 port)
+{
+    return String::formatted("{}://{}:{}", type == ConnectionPool::SocketType::HTTPS ? "https" : "http", host, port);
+}
+
+RefPtr<Core::Socket> ConnectionPool::take(SocketType type, const String& host, u16 port)
+{
+    auto it = m_idle_connections.find(key_for(type, host, port));
+    if (it == m_idle_connections.end())
+        return nullptr;
+    auto& connections = it->value;
+    while (!connections.is_empty()) {
+        auto connection = connections.take_last();
+        if (connection.dead)
+            continue;
+        connection.socket->on_ready_to_read = nullptr;
+        if (type == SocketType::HTTPS) {
+            auto& tls_socket = static_cast<TLS::TLSv12&>(*connection.socket);
+            tls_socket.on_tls_error = nullptr;
+            tls_socket.on_tls_finished = nullptr;
+            if (!tls_socket.is_established())
+                continue;
+        } else {
+            if (!connection.socket->is_connected() || connection.socket->eof())
+                continue;
+        }
+        dbgln_if(CHTTPJOB_DEBUG, "ConnectionPool: Reusing connection to {}:{}", host, port);
+        return connection.socket;
+    }
+    return nullptr;
+}
+
+void ConnectionPool::donate(SocketType type, const String& host, u16 port, Core::Socket& socket)
+{
+    auto key = key_for(type, host, port);
+    auto& connections = m_idle_connections.ensure(key);
+    if (connections.size() >= max_idle_connections_per_host)
+        return;
+
+    // NOTE: Dead connections are only marked here and pruned by the sweep
+    //       timer; destroying the socket from inside one of its own callbacks
+    //       would pull the rug out from under the running closure.
+    if (type == SocketType::HTTPS) {
+        auto& tls_socket = static_cast<TLS::TLSv12&>(socket);
+        tls_socket.on_tls_ready_to_read = nullptr;
+        tls_socket.on_tls_ready_to_write = nullptr;
+        tls_socket.on_tls_error = [this, key, &socket](auto) { mark_dead(key, socket); };
+        tls_socket.on_tls_finished = [this, key, &socket] { mark_dead(key, socket); };
+    } else {
+        // Anything arriving on an idle connection (including EOF) makes it useless.
+        socket.on_ready_to_read = [this, key, &socket] { mark_dead(key, socket); };
+    }
+
+    dbgln_if(CHTTPJOB_DEBUG, "ConnectionPool: Keeping connection to {}:{} alive", host, port);
+    Core::ElapsedTimer idle_timer;
+    idle_timer.start();
+    connections.append({ socket, idle_timer });
+
+    if (!m_sweep_timer)
+        m_sweep_timer = Core::Timer::create_repeating(sweep_interval_ms, [this] { sweep(); });
+    if (!m_sweep_timer->is_active())
+        m_sweep_timer->start();
+}
+
+void ConnectionPool::mark_dead(const String& key, Core::Socket& socket)
+{
+    auto it = m_idle_connections.find(key);
+    if (it == m_idle_connections.end())
+        return;
+    for (auto& connection : it->value) {
+        if (connection.socket.ptr() == &socket) {
+            if (!connection.dead && connection.socket->is_open())
+                connection.socket->close();
+            connection.dead = true;
+            break;
+        }
+    }
+}
+
+void ConnectionPool::sweep()
+{
+    Vector<String> empty_keys;
+    for (auto& it : m_idle_connections) {
+        it.value.remove_all_matching([&](auto& connection) {
+            return connection.dead || connection.idle_timer.elapsed() >= idle_connection_timeout_ms;
+        });
+        if (it.value.is_empty())
+            empty_keys.append(it.key);
+    }
+    for (auto& key : empty_keys)
+        m_idle_connections.remove(key);
+    if (m_idle_connections.is_empty())
+        m_sweep_timer->stop();
+}
+
+}
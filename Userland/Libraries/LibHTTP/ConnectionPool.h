@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <LibCore/ElapsedTimer.h>
+#include <LibCore/Socket.h>
+#include <LibCore/Timer.h>
+
+namespace HTTP {
+
+// A keep-alive cache of connected sockets, keyed by scheme, host and port.
+// Sockets only end up here after a properly delimited response (Content-Length
+// or chunked) on a connection the server didn't ask to close; idle sockets are
+// dropped after a timeout, or when the server closes its end.
+class ConnectionPool {
+public:
+    enum class SocketType {
+        HTTP,
+        HTTPS,
+    };
+
+    static ConnectionPool& the();
+
+    RefPtr<Core::Socket> take(SocketType, const String& host, u16 port);
+    void donate(SocketType, const String& host, u16 port, Core::Socket&);
+
+private:
+    struct IdleConnection {
+        NonnullRefPtr<Core::Socket> socket;
+        Core::ElapsedTimer idle_timer;
+        bool dead { false };
+    };
+
+    void mark_dead(const String& key, Core::Socket&);
+    void sweep();
+
+    HashMap<String, Vector<IdleConnection>> m_idle_connections;
+    RefPtr<Core::Timer> m_sweep_timer;
+};
+
+}
@@ -6,6 +6,7 @@
 
 #include <AK/Debug.h>
 #include <LibCore/TCPSocket.h>
+#include <LibHTTP/ConnectionPool.h>
 #include <LibHTTP/HttpJob.h>
 #include <LibHTTP/HttpResponse.h>
 #include <stdio.h>
@@ -15,6 +16,13 @@ namespace HTTP {
 void HttpJob::start()
 {
     VERIFY(!m_socket);
+    if (auto reused_socket = ConnectionPool::the().take(ConnectionPool::SocketType::HTTP, m_request.url().host(), m_request.url().port())) {
+        dbgln_if(CHTTPJOB_DEBUG, "HttpJob: Reusing keep-alive connection to {}:{}", m_request.url().host(), m_request.url().port());
+        m_socket = move(reused_socket);
+        add_child(*m_socket);
+        deferred_invoke([this](auto&) { on_socket_connected(); });
+        return;
+    }
     m_socket = Core::TCPSocket::construct(this);
     m_socket->on_connected = [this] {
         dbgln_if(CHTTPJOB_DEBUG, "HttpJob: on_connected callback");
@@ -35,6 +43,8 @@ void HttpJob::shutdown()
     m_socket->on_ready_to_read = nullptr;
     m_socket->on_connected = nullptr;
     remove_child(*m_socket);
+    if (can_reuse_connection())
+        ConnectionPool::the().donate(ConnectionPool::SocketType::HTTP, m_request.url().host(), m_request.url().port(), *m_socket);
     m_socket = nullptr;
 }
 
@@ -48,13 +48,17 @@ ByteBuffer HttpRequest::to_raw_request() const
     builder.append(" HTTP/1.1\r\nHost: ");
     builder.append(m_url.host());
     builder.append("\r\n");
+    bool has_connection_header = false;
     for (auto& header : m_headers) {
+        if (header.name.equals_ignoring_case("Connection"))
+            has_connection_header = true;
         builder.append(header.name);
         builder.append(": ");
         builder.append(header.value);
         builder.append("\r\n");
     }
-    builder.append("Connection: close\r\n");
+    if (!has_connection_header)
+        builder.append("Connection: keep-alive\r\n");
     if (!m_body.is_empty()) {
         builder.appendff("Content-Length: {}\r\n\r\n", m_body.size());
         builder.append((const char*)m_body.data(), m_body.size());
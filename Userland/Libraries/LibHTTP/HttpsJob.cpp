@@ -6,6 +6,7 @@
 
 #include <AK/Debug.h>
 #include <LibCore/EventLoop.h>
+#include <LibHTTP/ConnectionPool.h>
 #include <LibHTTP/HttpResponse.h>
 #include <LibHTTP/HttpsJob.h>
 #include <LibTLS/TLSv12.h>
@@ -14,11 +15,8 @@
 
 namespace HTTP {
 
-void HttpsJob::start()
+void HttpsJob::set_up_socket_callbacks()
 {
-    VERIFY(!m_socket);
-    m_socket = TLS::TLSv12::construct(this);
-    m_socket->set_root_certificates(m_override_ca_certificates ? *m_override_ca_certificates : DefaultRootCACertificates::the().certificates());
     m_socket->on_tls_connected = [this] {
         dbgln_if(HTTPSJOB_DEBUG, "HttpsJob: on_connected callback");
         on_socket_connected();
@@ -45,6 +43,22 @@ void HttpsJob::start()
         if (on_certificate_requested)
             on_certificate_requested(*this);
     };
+}
+
+void HttpsJob::start()
+{
+    VERIFY(!m_socket);
+    if (auto reused_socket = ConnectionPool::the().take(ConnectionPool::SocketType::HTTPS, m_request.url().host(), m_request.url().port())) {
+        dbgln_if(HTTPSJOB_DEBUG, "HttpsJob: Reusing keep-alive connection to {}:{}", m_request.url().host(), m_request.url().port());
+        m_socket = static_cast<TLS::TLSv12*>(reused_socket.ptr());
+        add_child(*m_socket);
+        set_up_socket_callbacks();
+        deferred_invoke([this](auto&) { on_socket_connected(); });
+        return;
+    }
+    m_socket = TLS::TLSv12::construct(this);
+    m_socket->set_root_certificates(m_override_ca_certificates ? *m_override_ca_certificates : DefaultRootCACertificates::the().certificates());
+    set_up_socket_callbacks();
     bool success = ((TLS::TLSv12&)*m_socket).connect(m_request.url().host(), m_request.url().port());
     if (!success) {
         deferred_invoke([this](auto&) {
@@ -58,8 +72,14 @@ void HttpsJob::shutdown()
     if (!m_socket)
         return;
     m_socket->on_tls_ready_to_read = nullptr;
+    m_socket->on_tls_ready_to_write = nullptr;
     m_socket->on_tls_connected = nullptr;
+    m_socket->on_tls_error = nullptr;
+    m_socket->on_tls_finished = nullptr;
+    m_socket->on_tls_certificate_request = nullptr;
     remove_child(*m_socket);
+    if (can_reuse_connection())
+        ConnectionPool::the().donate(ConnectionPool::SocketType::HTTPS, m_request.url().host(), m_request.url().port(), *m_socket);
     m_socket = nullptr;
 }
 
@@ -92,6 +112,11 @@ void HttpsJob::register_on_ready_to_write(Function<void()> callback)
     m_socket->on_tls_ready_to_write = [callback = move(callback)](auto&) {
         callback();
     };
+    // A reused connection is already established and won't produce a write
+    // notification until we send something, so poke the callback right away.
+    // (Sending twice is prevented by the m_sent_data check in the callback.)
+    if (m_socket->is_established())
+        m_socket->on_tls_ready_to_write(*m_socket);
 }
 
 bool HttpsJob::can_read_line() const
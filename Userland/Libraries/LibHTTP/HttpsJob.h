@@ -48,6 +48,8 @@ protected:
     virtual void read_while_data_available(Function<IterationDecision()>) override;
 
 private:
+    void set_up_socket_callbacks();
+
     RefPtr<TLS::TLSv12> m_socket;
     const Vector<Certificate>* m_override_ca_certificates { nullptr };
 };
@@ -6,7 +6,6 @@
 
 #include <AK/Debug.h>
 #include <LibCompress/Gzip.h>
-#include <LibCompress/Zlib.h>
 #include <LibCore/Event.h>
 #include <LibCore/TCPSocket.h>
 #include <LibHTTP/HttpResponse.h>
@@ -16,59 +15,24 @@
 
 namespace HTTP {
 
-static ByteBuffer handle_content_encoding(const ByteBuffer& buf, const String& content_encoding)
+static bool is_zlib_wrapped(ReadonlyBytes data)
 {
-    dbgln_if(JOB_DEBUG, "Job::handle_content_encoding: buf has content_encoding={}", content_encoding);
-
-    if (content_encoding == "gzip") {
-        if (!Compress::GzipDecompressor::is_likely_compressed(buf)) {
-            dbgln("Job::handle_content_encoding: buf is not gzip compressed!");
-        }
-
-        dbgln_if(JOB_DEBUG, "Job::handle_content_encoding: buf is gzip compressed!");
-
-        auto uncompressed = Compress::GzipDecompressor::decompress_all(buf);
-        if (!uncompressed.has_value()) {
-            dbgln("Job::handle_content_encoding: Gzip::decompress() failed. Returning original buffer.");
-            return buf;
-        }
-
-        if constexpr (JOB_DEBUG) {
-            dbgln("Job::handle_content_encoding: Gzip::decompress() successful.");
-            dbgln("  Input size: {}", buf.size());
-            dbgln("  Output size: {}", uncompressed.value().size());
-        }
-
-        return uncompressed.value();
-    } else if (content_encoding == "deflate") {
-        dbgln_if(JOB_DEBUG, "Job::handle_content_encoding: buf is deflate compressed!");
-
-        // Even though the content encoding is "deflate", it's actually deflate with the zlib wrapper.
-        // https://tools.ietf.org/html/rfc7230#section-4.2.2
-        auto uncompressed = Compress::Zlib::decompress_all(buf);
-        if (!uncompressed.has_value()) {
-            // From the RFC:
-            // "Note: Some non-conformant implementations send the "deflate"
-            //        compressed data without the zlib wrapper."
-            dbgln_if(JOB_DEBUG, "Job::handle_content_encoding: Zlib::decompress_all() failed. Trying DeflateDecompressor::decompress_all()");
-            uncompressed = Compress::DeflateDecompressor::decompress_all(buf);
-
-            if (!uncompressed.has_value()) {
-                dbgln("Job::handle_content_encoding: DeflateDecompressor::decompress_all() failed, returning original buffer.");
-                return buf;
-            }
-        }
-
-        if constexpr (JOB_DEBUG) {
-            dbgln("Job::handle_content_encoding: Deflate decompression successful.");
-            dbgln("  Input size: {}", buf.size());
-            dbgln("  Output size: {}", uncompressed.value().size());
-        }
-
-        return uncompressed.value();
+    // Even though the content encoding is "deflate", it's usually deflate with
+    // the zlib wrapper (https://tools.ietf.org/html/rfc7230#section-4.2.2).
+    // From the RFC:
+    // "Note: Some non-conformant implementations send the "deflate"
+    //        compressed data without the zlib wrapper."
+    if (data.size() < 2)
+        return false;
+    u8 compression_method_and_flags = data[0];
+    u8 flags = data[1];
+    if ((compression_method_and_flags & 0xf) != 8)
+        return false;
+    if (flags & 0x20) {
+        // Preset dictionaries are not supported.
+        return false;
     }
-
-    return buf;
+    return (compression_method_and_flags * 256 + flags) % 31 == 0;
 }
 
 Job::Job(const HttpRequest& request, OutputStream& output_stream)
@@ -305,6 +269,7 @@ void Job::on_socket_connected()
                     dbgln_if(JOB_DEBUG, "Job: Finished a chunk of {} bytes", m_current_chunk_total_size.value());
 
                     if (m_current_chunk_total_size.value() == 0) {
+                        m_received_entire_body = true;
                         m_state = State::Trailers;
                         return IterationDecision::Break;
                     }
@@ -336,6 +301,7 @@ void Job::on_socket_connected()
                 auto length = content_length.value();
                 if (m_received_size >= length) {
                     m_received_size = length;
+                    m_received_entire_body = true;
                     finish_up();
                     return IterationDecision::Break;
                 }
@@ -358,8 +324,89 @@ void Job::timer_event(Core::TimerEvent& event)
         stop_timer();
 }
 
+void Job::begin_content_decoding(ByteBuffer&& encoded_body, const String& content_encoding)
+{
+    dbgln_if(JOB_DEBUG, "Job: Decoding Content-Encoding '{}' body ({} bytes)", content_encoding, encoded_body.size());
+
+    auto state = make<ContentDecodingState>();
+    state->input = move(encoded_body);
+
+    if (content_encoding == "gzip") {
+        if (!Compress::GzipDecompressor::is_likely_compressed(state->input))
+            dbgln("Job: Response body is supposedly gzip compressed, but is likely not!");
+        state->input_stream = make<InputMemoryStream>(state->input.bytes());
+        state->decompressor = make<Compress::GzipDecompressor>(*state->input_stream);
+    } else if (content_encoding == "deflate") {
+        // Skip the two zlib header bytes if present; DeflateDecompressor stops
+        // at the final block, so the Adler-32 trailer is simply left unread.
+        size_t payload_offset = is_zlib_wrapped(state->input) ? 2 : 0;
+        state->input_stream = make<InputMemoryStream>(state->input.bytes().slice(payload_offset));
+        state->decompressor = make<Compress::DeflateDecompressor>(*state->input_stream);
+    }
+
+    if (!state->decompressor) {
+        // Unknown content encoding; deliver the body as-is, like we always have.
+        dbgln("Job: Unknown Content-Encoding '{}', delivering the original buffer.", content_encoding);
+        m_buffered_size = state->input.size();
+        m_received_buffers.append(move(state->input));
+        m_can_stream_response = true;
+        finish_up();
+        return;
+    }
+
+    m_content_decoding_state = move(state);
+    continue_content_decoding();
+}
+
+void Job::continue_content_decoding()
+{
+    VERIFY(m_content_decoding_state);
+    auto& state = *m_content_decoding_state;
+
+    // Decode one chunk per event loop iteration, so a large body doesn't
+    // starve the other jobs sharing this event loop.
+    auto buffer = ByteBuffer::create_uninitialized(64 * KiB);
+    auto nread = state.decompressor->read(buffer.bytes());
+
+    if (state.decompressor->handle_any_error()) {
+        dbgln("Job: Decoding response body failed, delivering the original buffer.");
+        m_buffered_size = state.input.size();
+        m_received_buffers.clear();
+        m_received_buffers.append(move(state.input));
+        m_can_stream_response = true;
+        m_content_decoding_state = nullptr;
+        finish_up();
+        return;
+    }
+
+    if (nread > 0) {
+        buffer.trim(nread);
+        state.output_size += nread;
+        state.output.append(move(buffer));
+        deferred_invoke([this](auto&) { continue_content_decoding(); });
+        return;
+    }
+
+    if constexpr (JOB_DEBUG) {
+        dbgln("Job: Content decoding successful.");
+        dbgln("  Input size: {}", state.input.size());
+        dbgln("  Output size: {}", state.output_size);
+    }
+
+    m_buffered_size = state.output_size;
+    m_received_buffers.append(move(state.output));
+    m_can_stream_response = true;
+    m_content_decoding_state = nullptr;
+    finish_up();
+}
+
 void Job::finish_up()
 {
+    if (m_content_decoding_state) {
+        // Still decoding the body; we get here again when it's done.
+        return;
+    }
+
     m_state = State::Finished;
     if (!m_can_stream_response) {
         auto flattened_buffer = ByteBuffer::create_uninitialized(m_received_size);
@@ -370,11 +417,13 @@ void Job::finish_up()
         }
         m_received_buffers.clear();
 
-        // For the time being, we cannot stream stuff with content-encoding set to _anything_.
-        // FIXME: LibCompress exposes a streaming interface, so this can be resolved
+        // We cannot stream bodies with content-encoding set to _anything_, but
+        // at least the decoding itself is spread over event loop iterations
+        // instead of happening in one big blocking decompress_all().
         auto content_encoding = m_headers.get("Content-Encoding");
         if (content_encoding.has_value()) {
-            flattened_buffer = handle_content_encoding(flattened_buffer, content_encoding.value());
+            begin_content_decoding(move(flattened_buffer), content_encoding.value());
+            return;
         }
 
         m_buffered_size = flattened_buffer.size();
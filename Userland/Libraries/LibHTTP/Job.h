@@ -8,7 +8,9 @@
 
 #include <AK/FileStream.h>
 #include <AK/HashMap.h>
+#include <AK/MemoryStream.h>
 #include <AK/Optional.h>
+#include <AK/OwnPtr.h>
 #include <LibCore/NetworkJob.h>
 #include <LibCore/TCPSocket.h>
 #include <LibHTTP/HttpRequest.h>
@@ -27,6 +29,8 @@ public:
     HttpResponse* response() { return static_cast<HttpResponse*>(Core::NetworkJob::response()); }
     const HttpResponse* response() const { return static_cast<const HttpResponse*>(Core::NetworkJob::response()); }
 
+    const HttpRequest& request() const { return m_request; }
+
 protected:
     void finish_up();
     void on_socket_connected();
@@ -44,6 +48,22 @@ protected:
     virtual void read_while_data_available(Function<IterationDecision()> read) { read(); };
     virtual void timer_event(Core::TimerEvent&) override;
 
+    void begin_content_decoding(ByteBuffer&& encoded_body, const String& content_encoding);
+    void continue_content_decoding();
+
+    // A connection can go back to the keep-alive pool if the response body was
+    // properly delimited (so nothing of the next response can leak into it)
+    // and the server didn't ask us to close.
+    bool can_reuse_connection() const
+    {
+        if (!m_received_entire_body)
+            return false;
+        auto connection = m_headers.get("Connection");
+        if (connection.has_value() && connection.value().trim_whitespace().equals_ignoring_case("close"))
+            return false;
+        return true;
+    }
+
     enum class State {
         InStatus,
         InHeaders,
@@ -52,6 +72,16 @@ protected:
         Finished,
     };
 
+    // In-progress decoding of a Content-Encoding'd body; one chunk is decoded
+    // per event loop iteration so other jobs keep making progress.
+    struct ContentDecodingState {
+        ByteBuffer input;
+        OwnPtr<InputMemoryStream> input_stream;
+        OwnPtr<InputStream> decompressor;
+        Vector<ByteBuffer, 2> output;
+        size_t output_size { 0 };
+    };
+
     HttpRequest m_request;
     State m_state { State::InStatus };
     int m_code { -1 };
@@ -64,6 +94,8 @@ protected:
     Optional<size_t> m_current_chunk_total_size;
     bool m_can_stream_response { true };
     bool m_should_read_chunk_ending_line { false };
+    bool m_received_entire_body { false };
+    OwnPtr<ContentDecodingState> m_content_decoding_state;
 };
 
 }
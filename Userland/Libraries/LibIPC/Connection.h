@@ -79,29 +79,50 @@ public:
             warnln("fd passing is not supported on this platform, sorry :(");
 #endif
 
+        // Coalesce outgoing messages: they pile up here and all go out in a
+        // single write() once the event loop comes back around (or sooner if
+        // the backlog grows large). Message storms like WindowServer paint
+        // floods then cost one syscall per flush instead of one per message.
+        if (m_outgoing_bytes.is_empty())
+            deferred_invoke([this](auto&) { flush_outgoing_messages(); });
+        m_outgoing_bytes.append(buffer.data.data(), buffer.data.size());
+
+        if (m_outgoing_bytes.size() >= max_unflushed_bytes)
+            flush_outgoing_messages();
+
+        m_responsiveness_timer->start();
+    }
+
+    void flush_outgoing_messages()
+    {
+        if (m_outgoing_bytes.is_empty())
+            return;
+        auto bytes = move(m_outgoing_bytes);
+
+        if (!m_socket->is_open())
+            return;
+
         size_t total_nwritten = 0;
-        while (total_nwritten < buffer.data.size()) {
-            auto nwritten = write(m_socket->fd(), buffer.data.data() + total_nwritten, buffer.data.size() - total_nwritten);
+        while (total_nwritten < bytes.size()) {
+            auto nwritten = write(m_socket->fd(), bytes.data() + total_nwritten, bytes.size() - total_nwritten);
             if (nwritten < 0) {
                 switch (errno) {
                 case EPIPE:
-                    dbgln("{}::post_message: Disconnected from peer", *this);
+                    dbgln("{}::flush_outgoing_messages: Disconnected from peer", *this);
                     shutdown();
                     return;
                 case EAGAIN:
-                    dbgln("{}::post_message: Peer buffer overflowed", *this);
+                    dbgln("{}::flush_outgoing_messages: Peer buffer overflowed", *this);
                     shutdown();
                     return;
                 default:
-                    perror("Connection::post_message write");
+                    perror("Connection::flush_outgoing_messages write");
                     shutdown();
                     return;
                 }
             }
             total_nwritten += nwritten;
         }
-
-        m_responsiveness_timer->start();
     }
 
     template<typename RequestType, typename... Args>
@@ -130,6 +151,12 @@ public:
         die();
     }
 
+    virtual ~Connection() override
+    {
+        // Don't let queued messages die with us.
+        flush_outgoing_messages();
+    }
+
     virtual void die() { }
 
 protected:
@@ -151,6 +178,11 @@ protected:
 
             if (!m_socket->is_open())
                 break;
+
+            // The message we're waiting on might still be sitting in our own
+            // outgoing queue; it has to hit the wire before we block.
+            flush_outgoing_messages();
+
             fd_set rfds;
             FD_ZERO(&rfds);
             FD_SET(m_socket->fd(), &rfds);
@@ -206,17 +238,23 @@ protected:
             did_become_responsive();
         }
 
+        // Hand the receive buffer over to refcounted backing storage. Decoded
+        // messages with borrowed parameters (StringView, ReadonlyBytes) take a
+        // ref to it, keeping their views valid past this function.
+        auto backing = MessageDataBuffer::create(move(bytes));
+        auto buffer_bytes = backing->bytes();
+
         size_t index = 0;
         u32 message_size = 0;
-        for (; index + sizeof(message_size) < bytes.size(); index += message_size) {
-            memcpy(&message_size, bytes.data() + index, sizeof(message_size));
-            if (message_size == 0 || bytes.size() - index - sizeof(uint32_t) < message_size)
+        for (; index + sizeof(message_size) < buffer_bytes.size(); index += message_size) {
+            memcpy(&message_size, buffer_bytes.data() + index, sizeof(message_size));
+            if (message_size == 0 || buffer_bytes.size() - index - sizeof(uint32_t) < message_size)
                 break;
             index += sizeof(message_size);
-            auto remaining_bytes = ReadonlyBytes { bytes.data() + index, bytes.size() - index };
-            if (auto message = LocalEndpoint::decode_message(remaining_bytes, m_socket->fd())) {
+            auto remaining_bytes = ReadonlyBytes { buffer_bytes.data() + index, buffer_bytes.size() - index };
+            if (auto message = LocalEndpoint::decode_message(remaining_bytes, backing, m_socket->fd())) {
                 m_unprocessed_messages.append(message.release_nonnull());
-            } else if (auto message = PeerEndpoint::decode_message(remaining_bytes, m_socket->fd())) {
+            } else if (auto message = PeerEndpoint::decode_message(remaining_bytes, backing, m_socket->fd())) {
                 m_unprocessed_messages.append(message.release_nonnull());
             } else {
                 dbgln("Failed to parse a message");
@@ -224,11 +262,11 @@ protected:
             }
         }
 
-        if (index < bytes.size()) {
+        if (index < buffer_bytes.size()) {
             // Sometimes we might receive a partial message. That's okay, just stash away
             // the unprocessed bytes and we'll prepend them to the next incoming message
             // in the next run of this function.
-            auto remaining_bytes = ByteBuffer::copy(bytes.data() + index, bytes.size() - index);
+            auto remaining_bytes = ByteBuffer::copy(buffer_bytes.data() + index, buffer_bytes.size() - index);
             if (!m_unprocessed_bytes.is_empty()) {
                 dbgln("{}::drain_messages_from_peer: Already have unprocessed bytes", *this);
                 shutdown();
@@ -263,6 +301,9 @@ protected:
     RefPtr<Core::Notifier> m_notifier;
     NonnullOwnPtrVector<Message> m_unprocessed_messages;
     ByteBuffer m_unprocessed_bytes;
+
+    static constexpr size_t max_unflushed_bytes = 64 * KiB;
+    Vector<u8> m_outgoing_bytes;
 };
 
 }
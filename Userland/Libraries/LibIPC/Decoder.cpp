@@ -11,6 +11,7 @@
 #include <LibIPC/Decoder.h>
 #include <LibIPC/Dictionary.h>
 #include <LibIPC/File.h>
+#include <LibIPC/WellKnownStrings.h>
 #include <errno.h>
 #include <fcntl.h>
 #include <string.h>
@@ -84,10 +85,23 @@ bool Decoder::decode(String& value)
     m_stream >> length;
     if (m_stream.handle_any_error())
         return false;
-    if (length < 0) {
+    if (length == -1) {
         value = {};
         return true;
     }
+    if (length == -2) {
+        u32 id = 0;
+        m_stream >> id;
+        if (m_stream.handle_any_error())
+            return false;
+        auto* string = well_known_string_from_id(id);
+        if (!string)
+            return false;
+        value = *string;
+        return true;
+    }
+    if (length < 0)
+        return false;
     if (length == 0) {
         value = String::empty();
         return true;
@@ -99,6 +113,39 @@ bool Decoder::decode(String& value)
     return !m_stream.handle_any_error();
 }
 
+// NOTE: This decodes a view into the stream's underlying buffer instead of
+//       copying the bytes out. The caller is responsible for keeping that
+//       buffer alive for as long as the view is used; generated message
+//       classes do this by retaining a ref to their MessageDataBuffer.
+bool Decoder::decode(StringView& value)
+{
+    i32 length = 0;
+    m_stream >> length;
+    if (m_stream.handle_any_error())
+        return false;
+    if (length == -1) {
+        value = {};
+        return true;
+    }
+    if (length == -2) {
+        u32 id = 0;
+        m_stream >> id;
+        if (m_stream.handle_any_error())
+            return false;
+        auto* string = well_known_string_from_id(id);
+        if (!string)
+            return false;
+        value = string->view();
+        return true;
+    }
+    if (length < 0)
+        return false;
+    if (m_stream.remaining() < static_cast<size_t>(length))
+        return false;
+    value = StringView { reinterpret_cast<const char*>(m_stream.bytes().data() + m_stream.offset()), static_cast<size_t>(length) };
+    return m_stream.discard_or_error(static_cast<size_t>(length));
+}
+
 bool Decoder::decode(ByteBuffer& value)
 {
     i32 length = 0;
@@ -118,6 +165,23 @@ bool Decoder::decode(ByteBuffer& value)
     return !m_stream.handle_any_error();
 }
 
+// NOTE: Like decode(StringView&), this borrows from the stream's buffer.
+bool Decoder::decode(ReadonlyBytes& value)
+{
+    i32 length = 0;
+    m_stream >> length;
+    if (m_stream.handle_any_error())
+        return false;
+    if (length < 0) {
+        value = {};
+        return true;
+    }
+    if (m_stream.remaining() < static_cast<size_t>(length))
+        return false;
+    value = m_stream.bytes().slice(m_stream.offset(), static_cast<size_t>(length));
+    return m_stream.discard_or_error(static_cast<size_t>(length));
+}
+
 bool Decoder::decode(URL& value)
 {
     String string;
@@ -41,7 +41,9 @@ public:
     bool decode(i64&);
     bool decode(float&);
     bool decode(String&);
+    bool decode(StringView&);
     bool decode(ByteBuffer&);
+    bool decode(ReadonlyBytes&);
     bool decode(URL&);
     bool decode(Dictionary&);
     bool decode(File&);
@@ -12,6 +12,7 @@
 #include <LibIPC/Dictionary.h>
 #include <LibIPC/Encoder.h>
 #include <LibIPC/File.h>
+#include <LibIPC/WellKnownStrings.h>
 
 namespace IPC {
 
@@ -113,25 +114,34 @@ Encoder& Encoder::operator<<(const char* value)
 
 Encoder& Encoder::operator<<(const StringView& value)
 {
+    if (value.is_null())
+        return *this << (i32)-1;
+    if (auto id = well_known_string_id(value); id.has_value()) {
+        *this << (i32)-2;
+        return *this << id.value();
+    }
+    *this << static_cast<i32>(value.length());
     m_buffer.data.append((const u8*)value.characters_without_null_termination(), value.length());
     return *this;
 }
 
 Encoder& Encoder::operator<<(const String& value)
 {
-    if (value.is_null())
-        return *this << (i32)-1;
-    *this << static_cast<i32>(value.length());
     return *this << value.view();
 }
 
-Encoder& Encoder::operator<<(const ByteBuffer& value)
+Encoder& Encoder::operator<<(ReadonlyBytes value)
 {
     *this << static_cast<i32>(value.size());
     m_buffer.data.append(value.data(), value.size());
     return *this;
 }
 
+Encoder& Encoder::operator<<(const ByteBuffer& value)
+{
+    return *this << value.bytes();
+}
+
 Encoder& Encoder::operator<<(const URL& value)
 {
     return *this << value.to_string();
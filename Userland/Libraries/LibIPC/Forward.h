@@ -12,6 +12,7 @@ class Decoder;
 class Dictionary;
 class Encoder;
 class Message;
+class MessageDataBuffer;
 class File;
 
 }
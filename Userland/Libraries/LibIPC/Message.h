@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/Function.h>
+#include <AK/NonnullRefPtr.h>
 #include <AK/RefCounted.h>
 #include <AK/RefPtr.h>
 #include <AK/Vector.h>
@@ -38,6 +39,27 @@ struct MessageBuffer {
     Vector<RefPtr<AutoCloseFileDescriptor>> fds;
 };
 
+// Shared backing storage for a batch of incoming message bytes. Messages whose
+// decoded parameters are views into the receive buffer (StringView, ReadonlyBytes)
+// keep a ref to this, so the views stay valid for as long as the message does.
+class MessageDataBuffer : public RefCounted<MessageDataBuffer> {
+public:
+    static NonnullRefPtr<MessageDataBuffer> create(Vector<u8>&& data)
+    {
+        return adopt_ref(*new MessageDataBuffer(move(data)));
+    }
+
+    ReadonlyBytes bytes() const { return m_data.span(); }
+
+private:
+    explicit MessageDataBuffer(Vector<u8>&& data)
+        : m_data(move(data))
+    {
+    }
+
+    Vector<u8> m_data;
+};
+
 enum class ErrorCode : u32 {
     PeerDisconnected
 };
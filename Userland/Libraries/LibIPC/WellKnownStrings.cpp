@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <LibIPC/WellKnownStrings.h>
+
+namespace IPC {
+
+// The id of an entry is its index, so only ever append to this list.
+static constexpr const char* s_well_known_strings[] = {
+    "text/plain",
+    "text/html",
+    "text/uri-list",
+    "image/png",
+    "image/gif",
+    "image/jpeg",
+    "image/x-serenityos",
+    "application/json",
+    "application/octet-stream",
+    "text/csv",
+    "text/x-spreadsheet-data",
+    "glyph/x-fonteditor",
+};
+
+static constexpr size_t s_well_known_string_count = sizeof(s_well_known_strings) / sizeof(s_well_known_strings[0]);
+
+static const Vector<String>& well_known_strings()
+{
+    static Vector<String> strings;
+    if (strings.is_empty()) {
+        strings.ensure_capacity(s_well_known_string_count);
+        for (auto* string : s_well_known_strings)
+            strings.unchecked_append(string);
+    }
+    return strings;
+}
+
+Optional<u32> well_known_string_id(const StringView& string)
+{
+    auto& strings = well_known_strings();
+    for (size_t i = 0; i < strings.size(); ++i) {
+        if (strings[i] == string)
+            return static_cast<u32>(i);
+    }
+    return {};
+}
+
+const String* well_known_string_from_id(u32 id)
+{
+    auto& strings = well_known_strings();
+    if (id >= strings.size())
+        return nullptr;
+    return &strings[id];
+}
+
+}
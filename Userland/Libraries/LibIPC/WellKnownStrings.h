@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/String.h>
+
+namespace IPC {
+
+// A table of strings that cross IPC boundaries often enough to be worth
+// interning (MIME types and friends). Both peers link the same LibIPC, so
+// an index into this table is a stable id for the lifetime of the system:
+// the encoder transmits the id instead of the characters, and the decoder
+// hands back a shared StringImpl instead of allocating a fresh copy per
+// message. Strings not in the table are transmitted inline as before.
+Optional<u32> well_known_string_id(const StringView&);
+const String* well_known_string_from_id(u32);
+
+}
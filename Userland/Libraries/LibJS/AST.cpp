@@ -1735,10 +1735,64 @@ Value MemberExpression::execute(Interpreter& interpreter, GlobalObject& global_o
 {
     InterpreterNodeScope node_scope { interpreter, *this };
 
-    auto reference = to_reference(interpreter, global_object);
+    if (m_computed) {
+        auto reference = to_reference(interpreter, global_object);
+        if (interpreter.exception())
+            return {};
+        return reference.get(global_object);
+    }
+
+    auto& vm = interpreter.vm();
+    auto object_value = m_object->execute(interpreter, global_object);
+    if (interpreter.exception())
+        return {};
+
+    auto& property_string = static_cast<const Identifier&>(*m_property).string();
+
+    // Non-computed accesses are monomorphic more often than not, so we cache
+    // the shape and storage offset from the last lookup at this site. As long
+    // as the base object still has that shape, the property is guaranteed to
+    // live at the same offset and we can skip the lookup entirely.
+    if (object_value.is_object()) {
+        auto& object = object_value.as_object();
+        if (m_cached_shape.ptr() == &object.shape()) {
+            auto value = object.get_direct(m_cached_offset);
+            // The slot may have been replaced by an accessor or native
+            // property without a shape change; those need the generic path.
+            if (!value.is_empty() && !value.is_accessor() && !value.is_native_property())
+                return value;
+        }
+    }
+
+    if (object_value.is_nullish()) {
+        vm.throw_exception<TypeError>(global_object, ErrorType::ReferenceNullishGetProperty, property_string, object_value.to_string_without_side_effects());
+        return {};
+    }
+
+    auto* object = object_value.to_object(global_object);
+    if (!object)
+        return {};
+
+    auto value = object->get(property_string).value_or(js_undefined());
     if (interpreter.exception())
         return {};
-    return reference.get(global_object);
+
+    // Only remember own, plain data properties of ordinary shapes: unique
+    // shapes mutate in place, so a matching shape pointer wouldn't guarantee
+    // a stable offset for them, and primitive bases get a fresh wrapper
+    // object on every access.
+    if (object_value.is_object() && !object->shape().is_unique()) {
+        auto metadata = object->shape().lookup(property_string);
+        if (metadata.has_value()) {
+            auto slot_value = object->get_direct(metadata.value().offset);
+            if (!slot_value.is_empty() && !slot_value.is_accessor() && !slot_value.is_native_property()) {
+                m_cached_shape = object->shape().make_weak_ptr();
+                m_cached_offset = metadata.value().offset;
+            }
+        }
+    }
+
+    return value;
 }
 
 void MetaProperty::dump(int indent) const
@@ -1970,8 +2024,8 @@ Value TryStatement::execute(Interpreter& interpreter, GlobalObject& global_objec
         if (m_handler) {
             interpreter.vm().clear_exception();
 
-            HashMap<FlyString, Variable> parameters;
-            parameters.set(m_handler->parameter(), Variable { exception->value(), DeclarationKind::Var });
+            Vector<LexicalEnvironment::Binding> parameters;
+            parameters.append({ m_handler->parameter(), Variable { exception->value(), DeclarationKind::Var } });
             auto* catch_scope = interpreter.heap().allocate<LexicalEnvironment>(global_object, move(parameters), interpreter.vm().call_frame().scope);
             TemporaryChange<ScopeObject*> scope_change(interpreter.vm().call_frame().scope, catch_scope);
             result = interpreter.execute_statement(global_object, m_handler->body());
@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/AST.h>
+#include <LibJS/Bytecode/Generator.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/Register.h>
+
+namespace JS {
+
+Optional<Bytecode::Register> ASTNode::generate_bytecode(Bytecode::Generator& generator) const
+{
+    generator.set_unsupported_node(class_name());
+    return {};
+}
+
+Optional<Bytecode::Register> ScopeNode::generate_bytecode(Bytecode::Generator& generator) const
+{
+    if (!functions().is_empty()) {
+        // Function declarations need hoisting and function object creation,
+        // which the bytecode tier doesn't do yet.
+        generator.set_unsupported_node("FunctionDeclaration");
+        return {};
+    }
+    Optional<Bytecode::Register> last_value_register;
+    for (auto& child : children()) {
+        auto child_register = child.generate_bytecode(generator);
+        if (child_register.has_value())
+            last_value_register = child_register;
+    }
+    return last_value_register;
+}
+
+Optional<Bytecode::Register> EmptyStatement::generate_bytecode(Bytecode::Generator&) const
+{
+    return {};
+}
+
+Optional<Bytecode::Register> ExpressionStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    return m_expression->generate_bytecode(generator);
+}
+
+Optional<Bytecode::Register> BinaryExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto lhs_register = m_lhs->generate_bytecode(generator);
+    auto rhs_register = m_rhs->generate_bytecode(generator);
+    if (!lhs_register.has_value() || !rhs_register.has_value())
+        return {};
+
+    auto dst_register = generator.allocate_register();
+    switch (m_op) {
+    case BinaryOp::Addition:
+        generator.emit<Bytecode::Op::Add>(dst_register, lhs_register.value(), rhs_register.value());
+        break;
+    case BinaryOp::Subtraction:
+        generator.emit<Bytecode::Op::Sub>(dst_register, lhs_register.value(), rhs_register.value());
+        break;
+    case BinaryOp::Multiplication:
+        generator.emit<Bytecode::Op::Mul>(dst_register, lhs_register.value(), rhs_register.value());
+        break;
+    case BinaryOp::Division:
+        generator.emit<Bytecode::Op::Div>(dst_register, lhs_register.value(), rhs_register.value());
+        break;
+    case BinaryOp::Modulo:
+        generator.emit<Bytecode::Op::Mod>(dst_register, lhs_register.value(), rhs_register.value());
+        break;
+    case BinaryOp::LessThan:
+        generator.emit<Bytecode::Op::LessThan>(dst_register, lhs_register.value(), rhs_register.value());
+        break;
+    case BinaryOp::LessThanEquals:
+        generator.emit<Bytecode::Op::LessThanEquals>(dst_register, lhs_register.value(), rhs_register.value());
+        break;
+    case BinaryOp::GreaterThan:
+        generator.emit<Bytecode::Op::GreaterThan>(dst_register, lhs_register.value(), rhs_register.value());
+        break;
+    case BinaryOp::GreaterThanEquals:
+        generator.emit<Bytecode::Op::GreaterThanEquals>(dst_register, lhs_register.value(), rhs_register.value());
+        break;
+    case BinaryOp::AbstractEquals:
+        generator.emit<Bytecode::Op::AbstractEquals>(dst_register, lhs_register.value(), rhs_register.value());
+        break;
+    case BinaryOp::AbstractInequals:
+        generator.emit<Bytecode::Op::AbstractInequals>(dst_register, lhs_register.value(), rhs_register.value());
+        break;
+    case BinaryOp::TypedEquals:
+        generator.emit<Bytecode::Op::TypedEquals>(dst_register, lhs_register.value(), rhs_register.value());
+        break;
+    case BinaryOp::TypedInequals:
+        generator.emit<Bytecode::Op::TypedInequals>(dst_register, lhs_register.value(), rhs_register.value());
+        break;
+    default:
+        generator.set_unsupported_node(class_name());
+        return {};
+    }
+    return dst_register;
+}
+
+Optional<Bytecode::Register> NumericLiteral::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto dst_register = generator.allocate_register();
+    generator.emit<Bytecode::Op::Load>(dst_register, m_value);
+    return dst_register;
+}
+
+Optional<Bytecode::Register> BooleanLiteral::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto dst_register = generator.allocate_register();
+    generator.emit<Bytecode::Op::Load>(dst_register, Value(m_value));
+    return dst_register;
+}
+
+Optional<Bytecode::Register> NullLiteral::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto dst_register = generator.allocate_register();
+    generator.emit<Bytecode::Op::Load>(dst_register, js_null());
+    return dst_register;
+}
+
+Optional<Bytecode::Register> StringLiteral::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto dst_register = generator.allocate_register();
+    generator.emit<Bytecode::Op::NewString>(dst_register, m_value);
+    return dst_register;
+}
+
+Optional<Bytecode::Register> Identifier::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto dst_register = generator.allocate_register();
+    generator.emit<Bytecode::Op::GetVariable>(dst_register, m_string);
+    return dst_register;
+}
+
+Optional<Bytecode::Register> AssignmentExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    if (!is<Identifier>(*m_lhs)) {
+        generator.set_unsupported_node(class_name());
+        return {};
+    }
+    auto& identifier = static_cast<const Identifier&>(*m_lhs);
+
+    if (m_op == AssignmentOp::Assignment) {
+        auto rhs_register = m_rhs->generate_bytecode(generator);
+        if (!rhs_register.has_value())
+            return {};
+        generator.emit<Bytecode::Op::SetVariable>(identifier.string(), rhs_register.value());
+        return rhs_register;
+    }
+
+    auto lhs_register = generator.allocate_register();
+    generator.emit<Bytecode::Op::GetVariable>(lhs_register, identifier.string());
+    auto rhs_register = m_rhs->generate_bytecode(generator);
+    if (!rhs_register.has_value())
+        return {};
+    auto dst_register = generator.allocate_register();
+    switch (m_op) {
+    case AssignmentOp::AdditionAssignment:
+        generator.emit<Bytecode::Op::Add>(dst_register, lhs_register, rhs_register.value());
+        break;
+    case AssignmentOp::SubtractionAssignment:
+        generator.emit<Bytecode::Op::Sub>(dst_register, lhs_register, rhs_register.value());
+        break;
+    case AssignmentOp::MultiplicationAssignment:
+        generator.emit<Bytecode::Op::Mul>(dst_register, lhs_register, rhs_register.value());
+        break;
+    case AssignmentOp::DivisionAssignment:
+        generator.emit<Bytecode::Op::Div>(dst_register, lhs_register, rhs_register.value());
+        break;
+    default:
+        generator.set_unsupported_node(class_name());
+        return {};
+    }
+    generator.emit<Bytecode::Op::SetVariable>(identifier.string(), dst_register);
+    return dst_register;
+}
+
+Optional<Bytecode::Register> UpdateExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    if (!is<Identifier>(*m_argument)) {
+        generator.set_unsupported_node(class_name());
+        return {};
+    }
+    auto& identifier = static_cast<const Identifier&>(*m_argument);
+
+    auto old_register = generator.allocate_register();
+    generator.emit<Bytecode::Op::GetVariable>(old_register, identifier.string());
+    auto one_register = generator.allocate_register();
+    generator.emit<Bytecode::Op::Load>(one_register, Value(1));
+    auto new_register = generator.allocate_register();
+    if (m_op == UpdateOp::Increment)
+        generator.emit<Bytecode::Op::Add>(new_register, old_register, one_register);
+    else
+        generator.emit<Bytecode::Op::Sub>(new_register, old_register, one_register);
+    generator.emit<Bytecode::Op::SetVariable>(identifier.string(), new_register);
+    return m_prefixed ? new_register : old_register;
+}
+
+Optional<Bytecode::Register> VariableDeclaration::generate_bytecode(Bytecode::Generator& generator) const
+{
+    if (m_declaration_kind != DeclarationKind::Var) {
+        // let/const need proper lexical environment bookkeeping.
+        generator.set_unsupported_node(class_name());
+        return {};
+    }
+    for (auto& declarator : m_declarations) {
+        if (!declarator.init())
+            continue;
+        auto init_register = declarator.init()->generate_bytecode(generator);
+        if (!init_register.has_value())
+            return {};
+        generator.emit<Bytecode::Op::SetVariable>(declarator.id().string(), init_register.value());
+    }
+    return {};
+}
+
+Optional<Bytecode::Register> IfStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto predicate_register = m_predicate->generate_bytecode(generator);
+    if (!predicate_register.has_value())
+        return {};
+    auto& alternate_jump = generator.emit<Bytecode::Op::JumpIfFalse>(predicate_register.value());
+    (void)m_consequent->generate_bytecode(generator);
+    if (m_alternate) {
+        auto& end_jump = generator.emit<Bytecode::Op::Jump>();
+        alternate_jump.set_target(generator.make_label());
+        (void)m_alternate->generate_bytecode(generator);
+        end_jump.set_target(generator.make_label());
+    } else {
+        alternate_jump.set_target(generator.make_label());
+    }
+    return {};
+}
+
+Optional<Bytecode::Register> WhileStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto test_label = generator.make_label();
+    auto test_register = m_test->generate_bytecode(generator);
+    if (!test_register.has_value())
+        return {};
+    auto& end_jump = generator.emit<Bytecode::Op::JumpIfFalse>(test_register.value());
+    (void)m_body->generate_bytecode(generator);
+    generator.emit<Bytecode::Op::Jump>(test_label);
+    end_jump.set_target(generator.make_label());
+    return {};
+}
+
+Optional<Bytecode::Register> DoWhileStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto body_label = generator.make_label();
+    (void)m_body->generate_bytecode(generator);
+    auto test_register = m_test->generate_bytecode(generator);
+    if (!test_register.has_value())
+        return {};
+    auto& repeat_jump = generator.emit<Bytecode::Op::JumpIfTrue>(test_register.value());
+    repeat_jump.set_target(body_label);
+    return {};
+}
+
+Optional<Bytecode::Register> ForStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    if (m_init)
+        (void)m_init->generate_bytecode(generator);
+    auto test_label = generator.make_label();
+    Bytecode::Op::JumpIfFalse* end_jump = nullptr;
+    if (m_test) {
+        auto test_register = m_test->generate_bytecode(generator);
+        if (!test_register.has_value())
+            return {};
+        end_jump = &generator.emit<Bytecode::Op::JumpIfFalse>(test_register.value());
+    }
+    (void)m_body->generate_bytecode(generator);
+    if (m_update)
+        (void)m_update->generate_bytecode(generator);
+    generator.emit<Bytecode::Op::Jump>(test_label);
+    if (end_jump)
+        end_jump->set_target(generator.make_label());
+    return {};
+}
+
+}
@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Format.h>
+#include <AK/String.h>
+#include <LibJS/Bytecode/Block.h>
+
+namespace JS::Bytecode {
+
+void Block::dump() const
+{
+    for (size_t i = 0; i < m_instructions.size(); ++i)
+        warnln("[{:3}] {}", i, m_instructions[i].to_string());
+}
+
+}
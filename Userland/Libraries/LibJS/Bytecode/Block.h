@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Badge.h>
+#include <AK/NonnullOwnPtrVector.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Forward.h>
+
+namespace JS::Bytecode {
+
+class Block {
+public:
+    Block() { }
+    ~Block() { }
+
+    const NonnullOwnPtrVector<Instruction>& instructions() const { return m_instructions; }
+    size_t register_count() const { return m_register_count; }
+
+    void append(Badge<Generator>, NonnullOwnPtr<Instruction> instruction) { m_instructions.append(move(instruction)); }
+    void set_register_count(Badge<Generator>, size_t count) { m_register_count = count; }
+
+    void dump() const;
+
+private:
+    NonnullOwnPtrVector<Instruction> m_instructions;
+    size_t m_register_count { 0 };
+};
+
+}
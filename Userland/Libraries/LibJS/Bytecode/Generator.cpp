@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/NumericLimits.h>
+#include <LibJS/AST.h>
+#include <LibJS/Bytecode/Generator.h>
+#include <LibJS/Bytecode/Op.h>
+
+namespace JS::Bytecode {
+
+Generator::Generator()
+    : m_block(make<Block>())
+{
+}
+
+Generator::~Generator()
+{
+}
+
+OwnPtr<Block> Generator::generate(const ASTNode& node)
+{
+    Generator generator;
+    // Register 0 holds the completion value of the program.
+    auto result_register = generator.allocate_register();
+    auto value_register = node.generate_bytecode(generator);
+    if (generator.m_unsupported)
+        return {};
+    if (value_register.has_value())
+        generator.emit<Op::Mov>(result_register, value_register.value());
+    generator.m_block->set_register_count({}, generator.m_next_register);
+    return move(generator.m_block);
+}
+
+Register Generator::allocate_register()
+{
+    VERIFY(m_next_register != NumericLimits<u32>::max());
+    return Register { m_next_register++ };
+}
+
+Label Generator::make_label() const
+{
+    return Label { m_block->instructions().size() };
+}
+
+void Generator::set_unsupported_node(const StringView& class_name)
+{
+    dbgln_if(JS_BYTECODE_DEBUG, "Bytecode::Generator: No codegen for {} yet, falling back to AST", class_name);
+    m_unsupported = true;
+}
+
+}
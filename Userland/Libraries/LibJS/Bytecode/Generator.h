@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NonnullOwnPtr.h>
+#include <AK/OwnPtr.h>
+#include <LibJS/Bytecode/Block.h>
+#include <LibJS/Bytecode/Label.h>
+#include <LibJS/Bytecode/Register.h>
+#include <LibJS/Forward.h>
+
+namespace JS::Bytecode {
+
+class Generator {
+public:
+    // Returns nullptr if the AST contains a node that has no bytecode
+    // equivalent yet; callers fall back to the AST interpreter in that case.
+    static OwnPtr<Block> generate(const ASTNode&);
+
+    Register allocate_register();
+
+    template<typename OpType, typename... Args>
+    OpType& emit(Args&&... args)
+    {
+        auto instruction = make<OpType>(forward<Args>(args)...);
+        auto* instruction_ptr = instruction.ptr();
+        m_block->append({}, move(instruction));
+        return *instruction_ptr;
+    }
+
+    Label make_label() const;
+
+    void set_unsupported_node(const StringView& class_name);
+
+private:
+    Generator();
+    ~Generator();
+
+    OwnPtr<Block> m_block;
+    u32 m_next_register { 0 };
+    bool m_unsupported { false };
+};
+
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Block.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Runtime/GlobalObject.h>
+
+namespace JS::Bytecode {
+
+Interpreter::Interpreter(GlobalObject& global_object)
+    : m_vm(global_object.vm())
+    , m_global_object(global_object)
+    , m_registers(global_object.heap())
+{
+}
+
+Interpreter::~Interpreter()
+{
+}
+
+Value Interpreter::run(const Block& block)
+{
+    m_registers.clear();
+    for (size_t i = 0; i < block.register_count(); ++i)
+        m_registers.append(js_undefined());
+    m_pending_jump = {};
+
+    auto& instructions = block.instructions();
+    size_t pc = 0;
+    while (pc < instructions.size()) {
+        instructions[pc].execute(*this);
+        if (m_vm.exception())
+            return {};
+        if (m_pending_jump.has_value()) {
+            pc = m_pending_jump.release_value();
+            continue;
+        }
+        ++pc;
+    }
+
+    // The generator stashes the program's completion value in register 0.
+    return m_registers[0];
+}
+
+}
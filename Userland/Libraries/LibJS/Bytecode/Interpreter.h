@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <LibJS/Bytecode/Label.h>
+#include <LibJS/Bytecode/Register.h>
+#include <LibJS/Forward.h>
+#include <LibJS/Heap/Cell.h>
+#include <LibJS/Runtime/MarkedValueList.h>
+#include <LibJS/Runtime/Value.h>
+
+namespace JS::Bytecode {
+
+class Interpreter {
+public:
+    explicit Interpreter(GlobalObject&);
+    ~Interpreter();
+
+    GlobalObject& global_object() { return m_global_object; }
+    VM& vm() { return m_vm; }
+
+    Value run(const Block&);
+
+    Value& reg(Register const& register_) { return m_registers[register_.index()]; }
+
+    void jump(Label const& label) { m_pending_jump = label.address(); }
+
+private:
+    VM& m_vm;
+    GlobalObject& m_global_object;
+    MarkedValueList m_registers;
+    Optional<size_t> m_pending_jump;
+};
+
+}
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Format.h>
+#include <AK/Types.h>
+
+namespace JS::Bytecode {
+
+class Label {
+public:
+    explicit Label(size_t address)
+        : m_address(address)
+    {
+    }
+
+    size_t address() const { return m_address; }
+
+private:
+    size_t m_address { 0 };
+};
+
+}
+
+template<>
+struct AK::Formatter<JS::Bytecode::Label> : AK::Formatter<FormatString> {
+    void format(FormatBuilder& builder, const JS::Bytecode::Label& value)
+    {
+        return AK::Formatter<FormatString>::format(builder, "@{}", value.address());
+    }
+};
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/String.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/PrimitiveString.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Runtime/Value.h>
+
+namespace JS::Bytecode::Op {
+
+void Load::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.reg(m_dst) = m_value;
+}
+
+String Load::to_string() const
+{
+    return String::formatted("Load {}, {}", m_dst, m_value.to_string_without_side_effects());
+}
+
+void NewString::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.reg(m_dst) = js_string(interpreter.vm(), m_string);
+}
+
+String NewString::to_string() const
+{
+    return String::formatted("NewString {}, \"{}\"", m_dst, m_string);
+}
+
+void Mov::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.reg(m_dst) = interpreter.reg(m_src);
+}
+
+String Mov::to_string() const
+{
+    return String::formatted("Mov {}, {}", m_dst, m_src);
+}
+
+void Add::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.reg(m_dst) = add(interpreter.global_object(), interpreter.reg(m_src1), interpreter.reg(m_src2));
+}
+
+void Sub::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.reg(m_dst) = sub(interpreter.global_object(), interpreter.reg(m_src1), interpreter.reg(m_src2));
+}
+
+void Mul::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.reg(m_dst) = mul(interpreter.global_object(), interpreter.reg(m_src1), interpreter.reg(m_src2));
+}
+
+void Div::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.reg(m_dst) = div(interpreter.global_object(), interpreter.reg(m_src1), interpreter.reg(m_src2));
+}
+
+void Mod::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.reg(m_dst) = mod(interpreter.global_object(), interpreter.reg(m_src1), interpreter.reg(m_src2));
+}
+
+void LessThan::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.reg(m_dst) = less_than(interpreter.global_object(), interpreter.reg(m_src1), interpreter.reg(m_src2));
+}
+
+void LessThanEquals::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.reg(m_dst) = less_than_equals(interpreter.global_object(), interpreter.reg(m_src1), interpreter.reg(m_src2));
+}
+
+void GreaterThan::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.reg(m_dst) = greater_than(interpreter.global_object(), interpreter.reg(m_src1), interpreter.reg(m_src2));
+}
+
+void GreaterThanEquals::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.reg(m_dst) = greater_than_equals(interpreter.global_object(), interpreter.reg(m_src1), interpreter.reg(m_src2));
+}
+
+void AbstractEquals::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.reg(m_dst) = Value(abstract_eq(interpreter.global_object(), interpreter.reg(m_src1), interpreter.reg(m_src2)));
+}
+
+void AbstractInequals::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.reg(m_dst) = Value(!abstract_eq(interpreter.global_object(), interpreter.reg(m_src1), interpreter.reg(m_src2)));
+}
+
+void TypedEquals::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.reg(m_dst) = Value(strict_eq(interpreter.reg(m_src1), interpreter.reg(m_src2)));
+}
+
+void TypedInequals::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.reg(m_dst) = Value(!strict_eq(interpreter.reg(m_src1), interpreter.reg(m_src2)));
+}
+
+#define __JS_DEFINE_BYTECODE_BINARY_OP_TO_STRING(OpName)                             \
+    String OpName::to_string() const                                                 \
+    {                                                                                \
+        return String::formatted(#OpName " {}, {}, {}", m_dst, m_src1, m_src2);      \
+    }
+
+JS_ENUMERATE_BYTECODE_BINARY_OPS(__JS_DEFINE_BYTECODE_BINARY_OP_TO_STRING)
+#undef __JS_DEFINE_BYTECODE_BINARY_OP_TO_STRING
+
+void GetVariable::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.reg(m_dst) = interpreter.vm().get_variable(m_identifier, interpreter.global_object());
+}
+
+String GetVariable::to_string() const
+{
+    return String::formatted("GetVariable {}, {}", m_dst, m_identifier);
+}
+
+void SetVariable::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.vm().set_variable(m_identifier, interpreter.reg(m_src), interpreter.global_object());
+}
+
+String SetVariable::to_string() const
+{
+    return String::formatted("SetVariable {}, {}", m_identifier, m_src);
+}
+
+void Jump::execute(Bytecode::Interpreter& interpreter) const
+{
+    VERIFY(m_target.has_value());
+    interpreter.jump(m_target.value());
+}
+
+String Jump::to_string() const
+{
+    VERIFY(m_target.has_value());
+    return String::formatted("Jump {}", m_target.value());
+}
+
+void JumpIfFalse::execute(Bytecode::Interpreter& interpreter) const
+{
+    VERIFY(m_target.has_value());
+    auto result = interpreter.reg(m_result);
+    if (!result.to_boolean())
+        interpreter.jump(m_target.value());
+}
+
+String JumpIfFalse::to_string() const
+{
+    if (m_target.has_value())
+        return String::formatted("JumpIfFalse {}, {}", m_result, m_target.value());
+    return String::formatted("JumpIfFalse {}, <empty>", m_result);
+}
+
+void JumpIfTrue::execute(Bytecode::Interpreter& interpreter) const
+{
+    VERIFY(m_target.has_value());
+    auto result = interpreter.reg(m_result);
+    if (result.to_boolean())
+        interpreter.jump(m_target.value());
+}
+
+String JumpIfTrue::to_string() const
+{
+    if (m_target.has_value())
+        return String::formatted("JumpIfTrue {}, {}", m_result, m_target.value());
+    return String::formatted("JumpIfTrue {}, <empty>", m_result);
+}
+
+}
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/FlyString.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Label.h>
+#include <LibJS/Bytecode/Register.h>
+#include <LibJS/Forward.h>
+#include <LibJS/Runtime/Value.h>
+
+namespace JS::Bytecode::Op {
+
+class Load final : public Instruction {
+public:
+    // NOTE: The stored value must not be a Cell, since instructions are not
+    // visited by the garbage collector. Strings go through NewString instead.
+    Load(Register dst, Value value)
+        : m_dst(dst)
+        , m_value(value)
+    {
+    }
+
+    virtual ~Load() override { }
+    virtual void execute(Bytecode::Interpreter&) const override;
+    virtual String to_string() const override;
+
+private:
+    Register m_dst;
+    Value m_value;
+};
+
+class NewString final : public Instruction {
+public:
+    NewString(Register dst, String string)
+        : m_dst(dst)
+        , m_string(move(string))
+    {
+    }
+
+    virtual ~NewString() override { }
+    virtual void execute(Bytecode::Interpreter&) const override;
+    virtual String to_string() const override;
+
+private:
+    Register m_dst;
+    String m_string;
+};
+
+class Mov final : public Instruction {
+public:
+    Mov(Register dst, Register src)
+        : m_dst(dst)
+        , m_src(src)
+    {
+    }
+
+    virtual ~Mov() override { }
+    virtual void execute(Bytecode::Interpreter&) const override;
+    virtual String to_string() const override;
+
+private:
+    Register m_dst;
+    Register m_src;
+};
+
+#define JS_ENUMERATE_BYTECODE_BINARY_OPS(O) \
+    O(Add)                                  \
+    O(Sub)                                  \
+    O(Mul)                                  \
+    O(Div)                                  \
+    O(Mod)                                  \
+    O(LessThan)                             \
+    O(LessThanEquals)                       \
+    O(GreaterThan)                          \
+    O(GreaterThanEquals)                    \
+    O(AbstractEquals)                       \
+    O(AbstractInequals)                     \
+    O(TypedEquals)                          \
+    O(TypedInequals)
+
+#define __JS_DECLARE_BYTECODE_BINARY_OP(OpName)          \
+    class OpName final : public Instruction {            \
+    public:                                              \
+        OpName(Register dst, Register src1, Register src2) \
+            : m_dst(dst)                                 \
+            , m_src1(src1)                               \
+            , m_src2(src2)                               \
+        {                                                \
+        }                                                \
+                                                         \
+        virtual ~OpName() override { }                   \
+        virtual void execute(Bytecode::Interpreter&) const override; \
+        virtual String to_string() const override;       \
+                                                         \
+    private:                                             \
+        Register m_dst;                                  \
+        Register m_src1;                                 \
+        Register m_src2;                                 \
+    };
+
+JS_ENUMERATE_BYTECODE_BINARY_OPS(__JS_DECLARE_BYTECODE_BINARY_OP)
+#undef __JS_DECLARE_BYTECODE_BINARY_OP
+
+class GetVariable final : public Instruction {
+public:
+    GetVariable(Register dst, FlyString identifier)
+        : m_dst(dst)
+        , m_identifier(move(identifier))
+    {
+    }
+
+    virtual ~GetVariable() override { }
+    virtual void execute(Bytecode::Interpreter&) const override;
+    virtual String to_string() const override;
+
+private:
+    Register m_dst;
+    FlyString m_identifier;
+};
+
+class SetVariable final : public Instruction {
+public:
+    SetVariable(FlyString identifier, Register src)
+        : m_identifier(move(identifier))
+        , m_src(src)
+    {
+    }
+
+    virtual ~SetVariable() override { }
+    virtual void execute(Bytecode::Interpreter&) const override;
+    virtual String to_string() const override;
+
+private:
+    FlyString m_identifier;
+    Register m_src;
+};
+
+class Jump final : public Instruction {
+public:
+    Jump() { }
+
+    explicit Jump(Label target)
+        : m_target(target)
+    {
+    }
+
+    void set_target(Label target) { m_target = target; }
+
+    virtual ~Jump() override { }
+    virtual void execute(Bytecode::Interpreter&) const override;
+    virtual String to_string() const override;
+
+private:
+    Optional<Label> m_target;
+};
+
+class JumpIfFalse final : public Instruction {
+public:
+    explicit JumpIfFalse(Register result)
+        : m_result(result)
+    {
+    }
+
+    void set_target(Label target) { m_target = target; }
+
+    virtual ~JumpIfFalse() override { }
+    virtual void execute(Bytecode::Interpreter&) const override;
+    virtual String to_string() const override;
+
+private:
+    Register m_result;
+    Optional<Label> m_target;
+};
+
+class JumpIfTrue final : public Instruction {
+public:
+    explicit JumpIfTrue(Register result)
+        : m_result(result)
+    {
+    }
+
+    void set_target(Label target) { m_target = target; }
+
+    virtual ~JumpIfTrue() override { }
+    virtual void execute(Bytecode::Interpreter&) const override;
+    virtual String to_string() const override;
+
+private:
+    Register m_result;
+    Optional<Label> m_target;
+};
+
+}
@@ -97,6 +97,17 @@
     __JS_ENUMERATE(unicode, unicode, u, Unicode)            \
     __JS_ENUMERATE(sticky, sticky, y, Sticky)
 
+namespace JS::Bytecode {
+
+class Block;
+class Generator;
+class Instruction;
+class Interpreter;
+class Label;
+class Register;
+
+}
+
 namespace JS {
 
 class ASTNode;
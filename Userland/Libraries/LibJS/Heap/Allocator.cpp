@@ -6,6 +6,7 @@
 
 #include <AK/Badge.h>
 #include <LibJS/Heap/Allocator.h>
+#include <LibJS/Heap/Heap.h>
 #include <LibJS/Heap/HeapBlock.h>
 
 namespace JS {
@@ -37,7 +38,11 @@ Cell* Allocator::allocate_cell(Heap& heap)
 void Allocator::block_did_become_empty(Badge<Heap>, HeapBlock& block)
 {
     block.m_list_node.remove();
-    delete &block;
+    // The backing memory goes back to the heap's block allocator rather
+    // than through operator delete.
+    auto& block_allocator = block.heap().block_allocator();
+    block.~HeapBlock();
+    block_allocator.deallocate_block(&block);
 }
 
 void Allocator::block_did_become_usable(Badge<Heap>, HeapBlock& block)
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Assertions.h>
+#include <LibJS/Heap/BlockAllocator.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+
+namespace JS {
+
+BlockAllocator::~BlockAllocator()
+{
+    for (auto& chunk : m_chunks)
+        release_chunk(chunk.base);
+}
+
+void BlockAllocator::release_chunk(u8* base)
+{
+#ifdef __serenity__
+    int rc = munmap(base, chunk_size);
+    VERIFY(rc == 0);
+#else
+    free(base);
+#endif
+}
+
+void* BlockAllocator::allocate_block()
+{
+    for (auto& chunk : m_chunks) {
+        if (chunk.freelist) {
+            auto* block = chunk.freelist;
+            chunk.freelist = block->next;
+            chunk.free_block_count--;
+            return block;
+        }
+        if (chunk.blocks_carved < blocks_per_chunk)
+            return chunk.base + chunk.blocks_carved++ * HeapBlock::block_size;
+    }
+
+#ifdef __serenity__
+    auto* base = (u8*)serenity_mmap(nullptr, chunk_size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE | MAP_RANDOMIZED | MAP_HUGEPAGES, 0, 0, chunk_size, "LibJS: HeapBlocks");
+    VERIFY(base != MAP_FAILED);
+#else
+    auto* base = (u8*)aligned_alloc(chunk_size, chunk_size);
+    VERIFY(base);
+#endif
+    m_chunks.append({ base, nullptr, 0, 1 });
+    return base;
+}
+
+void BlockAllocator::deallocate_block(void* ptr)
+{
+    for (size_t i = 0; i < m_chunks.size(); ++i) {
+        auto& chunk = m_chunks[i];
+        if (ptr < chunk.base || ptr >= chunk.base + chunk_size)
+            continue;
+        auto* block = (FreeBlock*)ptr;
+        block->next = chunk.freelist;
+        chunk.freelist = block;
+        chunk.free_block_count++;
+        if (chunk.free_block_count == chunk.blocks_carved) {
+            release_chunk(chunk.base);
+            m_chunks.remove(i);
+        }
+        return;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+}
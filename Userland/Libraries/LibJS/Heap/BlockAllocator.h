@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Vector.h>
+#include <LibJS/Heap/HeapBlock.h>
+
+namespace JS {
+
+// Carves HeapBlock-sized, HeapBlock-aligned allocations out of 2MiB chunks.
+// Backing the JS heap with a handful of huge-page mappings instead of
+// hundreds of individual 16KiB mmaps keeps GC marking from thrashing the
+// TLB. A chunk is handed back to the kernel once all of its blocks are free.
+class BlockAllocator {
+public:
+    BlockAllocator() = default;
+    ~BlockAllocator();
+
+    void* allocate_block();
+    void deallocate_block(void*);
+
+private:
+    static constexpr size_t chunk_size = 2 * MiB;
+    static constexpr size_t blocks_per_chunk = chunk_size / HeapBlock::block_size;
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct Chunk {
+        u8* base { nullptr };
+        FreeBlock* freelist { nullptr };
+        size_t free_block_count { 0 };
+        size_t blocks_carved { 0 };
+    };
+
+    static void release_chunk(u8*);
+
+    Vector<Chunk> m_chunks;
+};
+
+}
@@ -26,6 +26,11 @@ public:
     bool is_marked() const { return m_mark; }
     void set_marked(bool b) { m_mark = b; }
 
+    // Cells that survive a garbage collection are promoted to the old
+    // generation and only swept by major collections.
+    bool is_old() const { return m_old; }
+    void set_old(bool b) { m_old = b; }
+
     enum class State {
         Live,
         Dead,
@@ -60,7 +65,8 @@ protected:
 
 private:
     bool m_mark : 1 { false };
-    State m_state : 7 { State::Live };
+    bool m_old : 1 { false };
+    State m_state : 6 { State::Live };
 };
 
 }
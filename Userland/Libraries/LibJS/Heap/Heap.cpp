@@ -74,11 +74,19 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
             m_should_gc_when_deferral_ends = true;
             return;
         }
+        // Most collections are minor: they only mark and sweep the young
+        // generation, treating old cells as implicitly live. Garbage in the
+        // old generation is reclaimed by the periodic major collections.
+        bool minor_collection = ++m_collections_since_last_major_gc < m_collections_between_major_gc;
+        if (!minor_collection)
+            m_collections_since_last_major_gc = 0;
         HashTable<Cell*> roots;
         gather_roots(roots);
-        mark_live_cells(roots);
+        mark_live_cells(roots, minor_collection);
+        sweep_dead_cells(minor_collection, print_report, collection_measurement_timer);
+        return;
     }
-    sweep_dead_cells(print_report, collection_measurement_timer);
+    sweep_dead_cells(false, print_report, collection_measurement_timer);
 }
 
 void Heap::gather_roots(HashTable<Cell*>& roots)
@@ -153,27 +161,50 @@ __attribute__((no_sanitize("address"))) void Heap::gather_conservative_roots(Has
 
 class MarkingVisitor final : public Cell::Visitor {
 public:
-    MarkingVisitor() { }
+    explicit MarkingVisitor(bool minor_collection)
+        : m_minor_collection(minor_collection)
+    {
+    }
 
     virtual void visit_impl(Cell& cell)
     {
         if (cell.is_marked())
             return;
+        // In a minor collection, the old generation is implicitly live.
+        if (m_minor_collection && cell.is_old())
+            return;
         dbgln_if(HEAP_DEBUG, "  ! {}", &cell);
         cell.set_marked(true);
         cell.visit_edges(*this);
     }
+
+private:
+    bool m_minor_collection { false };
 };
 
-void Heap::mark_live_cells(const HashTable<Cell*>& roots)
+void Heap::mark_live_cells(const HashTable<Cell*>& roots, bool minor_collection)
 {
     dbgln_if(HEAP_DEBUG, "mark_live_cells:");
-    MarkingVisitor visitor;
+    MarkingVisitor visitor(minor_collection);
+    if (minor_collection) {
+        // The runtime has no write barriers that could maintain a precise
+        // remembered set, so a minor collection conservatively treats every
+        // live old cell as remembered: its edges are traced so that young
+        // cells it points to stay alive, but the cell itself is neither
+        // marked nor swept.
+        for_each_block([&](auto& block) {
+            block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+                if (cell->is_old())
+                    cell->visit_edges(visitor);
+            });
+            return IterationDecision::Continue;
+        });
+    }
     for (auto* root : roots)
         visitor.visit(root);
 }
 
-void Heap::sweep_dead_cells(bool print_report, const Core::ElapsedTimer& measurement_timer)
+void Heap::sweep_dead_cells(bool minor_collection, bool print_report, const Core::ElapsedTimer& measurement_timer)
 {
     dbgln_if(HEAP_DEBUG, "sweep_dead_cells:");
     Vector<HeapBlock*, 32> empty_blocks;
@@ -188,6 +219,12 @@ void Heap::sweep_dead_cells(bool print_report, const Core::ElapsedTimer& measure
         bool block_has_live_cells = false;
         bool block_was_full = block.is_full();
         block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+            if (minor_collection && cell->is_old()) {
+                block_has_live_cells = true;
+                ++live_cells;
+                live_cell_bytes += block.cell_size();
+                return;
+            }
             if (!cell->is_marked()) {
                 dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
                 block.deallocate(cell);
@@ -195,6 +232,9 @@ void Heap::sweep_dead_cells(bool print_report, const Core::ElapsedTimer& measure
                 collected_cell_bytes += block.cell_size();
             } else {
                 cell->set_marked(false);
+                // Surviving a collection promotes the cell to the old
+                // generation.
+                cell->set_old(true);
                 block_has_live_cells = true;
                 ++live_cells;
                 live_cell_bytes += block.cell_size();
@@ -235,6 +275,7 @@ void Heap::sweep_dead_cells(bool print_report, const Core::ElapsedTimer& measure
 
         dbgln("Garbage collection report");
         dbgln("=============================================");
+        dbgln("     Collection: {}", minor_collection ? "minor" : "major");
         dbgln("     Time spent: {} ms", time_spent);
         dbgln("     Live cells: {} ({} bytes)", live_cells, live_cell_bytes);
         dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
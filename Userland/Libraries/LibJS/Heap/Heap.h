@@ -14,6 +14,7 @@
 #include <LibCore/Forward.h>
 #include <LibJS/Forward.h>
 #include <LibJS/Heap/Allocator.h>
+#include <LibJS/Heap/BlockAllocator.h>
 #include <LibJS/Heap/Cell.h>
 #include <LibJS/Heap/Handle.h>
 #include <LibJS/Runtime/Object.h>
@@ -72,13 +73,15 @@ public:
     void defer_gc(Badge<DeferGC>);
     void undefer_gc(Badge<DeferGC>);
 
+    BlockAllocator& block_allocator() { return m_block_allocator; }
+
 private:
     Cell* allocate_cell(size_t);
 
     void gather_roots(HashTable<Cell*>&);
     void gather_conservative_roots(HashTable<Cell*>&);
-    void mark_live_cells(const HashTable<Cell*>& live_cells);
-    void sweep_dead_cells(bool print_report, const Core::ElapsedTimer&);
+    void mark_live_cells(const HashTable<Cell*>& live_cells, bool minor_collection);
+    void sweep_dead_cells(bool minor_collection, bool print_report, const Core::ElapsedTimer&);
 
     Allocator& allocator_for_size(size_t);
 
@@ -94,11 +97,15 @@ private:
     size_t m_max_allocations_between_gc { 10000 };
     size_t m_allocations_since_last_gc { 0 };
 
+    size_t m_collections_between_major_gc { 16 };
+    size_t m_collections_since_last_major_gc { 0 };
+
     bool m_should_collect_on_every_allocation { false };
 
     VM& m_vm;
 
     Vector<NonnullOwnPtr<Allocator>> m_allocators;
+    BlockAllocator m_block_allocator;
     HashTable<HandleImpl*> m_handles;
 
     HashTable<MarkedValueList*> m_marked_value_lists;
@@ -6,34 +6,23 @@
 
 #include <AK/Assertions.h>
 #include <AK/NonnullOwnPtr.h>
+#include <LibJS/Heap/Heap.h>
 #include <LibJS/Heap/HeapBlock.h>
-#include <stdio.h>
-#include <sys/mman.h>
 
 namespace JS {
 
 NonnullOwnPtr<HeapBlock> HeapBlock::create_with_cell_size(Heap& heap, size_t cell_size)
 {
-    char name[64];
-    snprintf(name, sizeof(name), "LibJS: HeapBlock(%zu)", cell_size);
-#ifdef __serenity__
-    auto* block = (HeapBlock*)serenity_mmap(nullptr, block_size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_RANDOMIZED | MAP_PRIVATE, 0, 0, block_size, name);
-#else
-    auto* block = (HeapBlock*)aligned_alloc(block_size, block_size);
-#endif
-    VERIFY(block != MAP_FAILED);
+    auto* block = (HeapBlock*)heap.block_allocator().allocate_block();
     new (block) HeapBlock(heap, cell_size);
     return NonnullOwnPtr<HeapBlock>(NonnullOwnPtr<HeapBlock>::Adopt, *block);
 }
 
-void HeapBlock::operator delete(void* ptr)
+void HeapBlock::operator delete(void*)
 {
-#ifdef __serenity__
-    int rc = munmap(ptr, block_size);
-    VERIFY(rc == 0);
-#else
-    free(ptr);
-#endif
+    // Blocks are owned by their heap's BlockAllocator; see
+    // Allocator::block_did_become_empty().
+    VERIFY_NOT_REACHED();
 }
 
 HeapBlock::HeapBlock(Heap& heap, size_t cell_size)
@@ -96,7 +96,7 @@ void Interpreter::enter_scope(const ScopeNode& scope_node, ScopeType scope_type,
         return;
     }
 
-    HashMap<FlyString, Variable> scope_variables_with_declaration_kind;
+    Vector<LexicalEnvironment::Binding> scope_variables_with_declaration_kind;
     scope_variables_with_declaration_kind.ensure_capacity(16);
 
     for (auto& declaration : scope_node.variables()) {
@@ -106,7 +106,11 @@ void Interpreter::enter_scope(const ScopeNode& scope_node, ScopeType scope_type,
                 if (exception())
                     return;
             } else {
-                scope_variables_with_declaration_kind.set(declarator.id().string(), { js_undefined(), declaration.declaration_kind() });
+                auto existing_binding = scope_variables_with_declaration_kind.find_if([&](auto& binding) { return binding.name == declarator.id().string(); });
+                if (existing_binding != scope_variables_with_declaration_kind.end())
+                    existing_binding->variable = { js_undefined(), declaration.declaration_kind() };
+                else
+                    scope_variables_with_declaration_kind.append({ declarator.id().string(), { js_undefined(), declaration.declaration_kind() } });
             }
         }
     }
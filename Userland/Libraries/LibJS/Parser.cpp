@@ -423,6 +423,11 @@ RefPtr<FunctionExpression> Parser::try_parse_arrow_function_expression(bool expe
 
 RefPtr<Statement> Parser::try_parse_labelled_statement()
 {
+    // Only an identifier directly followed by a colon can be a label; peeking
+    // at the next token rules that out without cloning the parser state.
+    if (!match(TokenType::Identifier) || next_token().type() != TokenType::Colon)
+        return {};
+
     save_state();
     auto rule_start = push_start();
     ArmedScopeGuard state_rollback_guard = [&] {
@@ -448,23 +453,19 @@ RefPtr<Statement> Parser::try_parse_labelled_statement()
 
 RefPtr<MetaProperty> Parser::try_parse_new_target_expression()
 {
-    save_state();
-    auto rule_start = push_start();
-    ArmedScopeGuard state_rollback_guard = [&] {
-        load_state();
-    };
-
-    consume(TokenType::New);
-    if (!match(TokenType::Period))
+    // `new.target` is fully decided by the two tokens after `new`, so the
+    // lookahead buffer lets us bail without touching the parser state.
+    if (next_token(1).type() != TokenType::Period)
         return {};
-    consume();
-    if (!match(TokenType::Identifier))
+    if (next_token(2).type() != TokenType::Identifier)
         return {};
-    if (consume().value() != "target")
+    if (next_token(2).value() != "target")
         return {};
 
-    state_rollback_guard.disarm();
-    discard_saved_state();
+    auto rule_start = push_start();
+    consume(TokenType::New);
+    consume(TokenType::Period);
+    consume(TokenType::Identifier);
     return create_ast_node<MetaProperty>({ m_parser_state.m_current_token.filename(), rule_start.position(), position() }, MetaProperty::Type::NewTarget);
 }
 
@@ -1977,10 +1978,23 @@ bool Parser::done() const
 Token Parser::consume()
 {
     auto old_token = m_parser_state.m_current_token;
-    m_parser_state.m_current_token = m_parser_state.m_lexer.next();
+    if (m_parser_state.m_lookahead_tokens.is_empty())
+        m_parser_state.m_current_token = m_parser_state.m_lexer.next();
+    else
+        m_parser_state.m_current_token = m_parser_state.m_lookahead_tokens.take_first();
     return old_token;
 }
 
+Token Parser::next_token(size_t steps)
+{
+    // Peek at a token after m_current_token without consuming anything;
+    // steps == 1 is the token that the next consume() would make current.
+    VERIFY(steps > 0);
+    while (m_parser_state.m_lookahead_tokens.size() < steps)
+        m_parser_state.m_lookahead_tokens.append(m_parser_state.m_lexer.next());
+    return m_parser_state.m_lookahead_tokens[steps - 1];
+}
+
 void Parser::consume_or_insert_semicolon()
 {
     // Semicolon was found and will be consumed
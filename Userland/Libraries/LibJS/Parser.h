@@ -149,6 +149,7 @@ private:
     void syntax_error(const String& message, Optional<Position> = {});
     Token consume();
     Token consume(TokenType type);
+    Token next_token(size_t steps = 1);
     Token consume_and_validate_numeric_literal();
     void consume_or_insert_semicolon();
     void save_state();
@@ -190,6 +191,10 @@ private:
     struct ParserState {
         Lexer m_lexer;
         Token m_current_token;
+        // Tokens that have been lexed ahead of m_current_token by
+        // next_token(), in source order. consume() drains this buffer
+        // before asking the lexer for more.
+        Vector<Token, 4> m_lookahead_tokens;
         Vector<Error> m_errors;
         Vector<NonnullRefPtrVector<VariableDeclaration>> m_var_scopes;
         Vector<NonnullRefPtrVector<VariableDeclaration>> m_let_scopes;
@@ -128,6 +128,44 @@ public:
     void put(Object* this_object, u32 index, Value value, PropertyAttributes attributes = default_attributes, bool evaluate_accessors = true);
     bool remove(u32 index);
 
+    // Fast path for reads from packed element storage, bypassing the virtual
+    // storage interface. Returns an empty Optional if the access has to take
+    // the generic path instead (sparse storage, out-of-bounds index, holes,
+    // accessors, native properties).
+    ALWAYS_INLINE Optional<Value> get_packed(u32 index) const
+    {
+        if (!m_storage->is_simple_storage())
+            return {};
+        auto& elements = static_cast<const SimpleIndexedPropertyStorage&>(*m_storage).elements();
+        if (index >= elements.size())
+            return {};
+        auto value = elements[index];
+        if (value.is_empty() || value.is_accessor() || value.is_native_property())
+            return {};
+        return value;
+    }
+
+    // Fast path for plain-value writes to packed element storage; returns
+    // false if the write has to take the generic path instead. Appends only
+    // cover the exact next index so the sparse hole threshold logic stays in
+    // put().
+    ALWAYS_INLINE bool put_packed(u32 index, Value value, bool allow_append)
+    {
+        if (!m_storage->is_simple_storage())
+            return false;
+        auto& storage = static_cast<SimpleIndexedPropertyStorage&>(*m_storage);
+        auto array_size = storage.array_like_size();
+        if (index < array_size) {
+            auto existing = storage.elements()[index];
+            if (existing.is_accessor() || existing.is_native_property())
+                return false;
+        } else if (index != array_size || !allow_append) {
+            return false;
+        }
+        storage.put(index, value);
+        return true;
+    }
+
     void insert(u32 index, Value value, PropertyAttributes attributes = default_attributes);
     ValueAndAttributes take_first(Object* this_object);
     ValueAndAttributes take_last(Object* this_object);
@@ -8,6 +8,7 @@
 #include <AK/JsonArray.h>
 #include <AK/JsonObject.h>
 #include <AK/JsonParser.h>
+#include <AK/JsonPullParser.h>
 #include <AK/StringBuilder.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/BigIntObject.h>
@@ -372,6 +373,61 @@ String JSONObject::quote_json_string(String string)
     return builder.to_string();
 }
 
+// Builds JS values straight from parser events instead of materializing an
+// intermediate JsonValue DOM, which matters for large JSON.parse payloads.
+static Value parse_json_event(GlobalObject& global_object, JsonPullParser& parser, JsonPullParser::Event event)
+{
+    using Event = JsonPullParser::Event;
+    switch (event) {
+    case Event::ObjectStart: {
+        auto* object = Object::create_empty(global_object);
+        for (;;) {
+            auto next = parser.next();
+            if (next == Event::ObjectEnd)
+                return object;
+            if (next != Event::Key)
+                return {};
+            auto key = parser.decode_token();
+            auto value = parse_json_event(global_object, parser, parser.next());
+            if (value.is_empty())
+                return {};
+            object->define_property(key, value);
+        }
+    }
+    case Event::ArrayStart: {
+        auto* array = Array::create(global_object);
+        size_t index = 0;
+        for (;;) {
+            auto next = parser.next();
+            if (next == Event::ArrayEnd)
+                return array;
+            auto value = parse_json_event(global_object, parser, next);
+            if (value.is_empty())
+                return {};
+            array->define_property(index++, value);
+        }
+    }
+    case Event::String:
+        return js_string(global_object.heap(), parser.decode_token());
+    case Event::Number: {
+        if (auto integer = parser.token_as_integer(); integer.has_value() && integer.value() == static_cast<i32>(integer.value()))
+            return Value(static_cast<i32>(integer.value()));
+        auto number = parser.token_as_double();
+        if (!number.has_value())
+            return {};
+        return Value(number.value());
+    }
+    case Event::True:
+        return Value(true);
+    case Event::False:
+        return Value(false);
+    case Event::Null:
+        return js_null();
+    default:
+        return {};
+    }
+}
+
 JS_DEFINE_NATIVE_FUNCTION(JSONObject::parse)
 {
     if (!vm.argument_count())
@@ -381,12 +437,12 @@ JS_DEFINE_NATIVE_FUNCTION(JSONObject::parse)
         return {};
     auto reviver = vm.argument(1);
 
-    auto json = JsonValue::from_string(string);
-    if (!json.has_value()) {
+    JsonPullParser parser { string };
+    Value result = parse_json_event(global_object, parser, parser.next());
+    if (result.is_empty() || parser.next() != JsonPullParser::Event::Eof) {
         vm.throw_exception<SyntaxError>(global_object, ErrorType::JsonMalformed);
         return {};
     }
-    Value result = parse_json_value(global_object, json.value());
     if (reviver.is_function()) {
         auto* holder_object = Object::create_empty(global_object);
         holder_object->define_property(String::empty(), result);
@@ -24,13 +24,13 @@ LexicalEnvironment::LexicalEnvironment(EnvironmentRecordType environment_record_
 {
 }
 
-LexicalEnvironment::LexicalEnvironment(HashMap<FlyString, Variable> variables, ScopeObject* parent_scope)
+LexicalEnvironment::LexicalEnvironment(Vector<Binding> variables, ScopeObject* parent_scope)
     : ScopeObject(parent_scope)
     , m_variables(move(variables))
 {
 }
 
-LexicalEnvironment::LexicalEnvironment(HashMap<FlyString, Variable> variables, ScopeObject* parent_scope, EnvironmentRecordType environment_record_type)
+LexicalEnvironment::LexicalEnvironment(Vector<Binding> variables, ScopeObject* parent_scope, EnvironmentRecordType environment_record_type)
     : ScopeObject(parent_scope)
     , m_environment_record_type(environment_record_type)
     , m_variables(move(variables))
@@ -48,18 +48,28 @@ void LexicalEnvironment::visit_edges(Visitor& visitor)
     visitor.visit(m_home_object);
     visitor.visit(m_new_target);
     visitor.visit(m_current_function);
-    for (auto& it : m_variables)
-        visitor.visit(it.value.value);
+    for (auto& binding : m_variables)
+        visitor.visit(binding.variable.value);
 }
 
 Optional<Variable> LexicalEnvironment::get_from_scope(const FlyString& name) const
 {
-    return m_variables.get(name);
+    for (auto& binding : m_variables) {
+        if (binding.name == name)
+            return binding.variable;
+    }
+    return {};
 }
 
 void LexicalEnvironment::put_to_scope(const FlyString& name, Variable variable)
 {
-    m_variables.set(name, variable);
+    for (auto& binding : m_variables) {
+        if (binding.name == name) {
+            binding.variable = variable;
+            return;
+        }
+    }
+    m_variables.append({ name, variable });
 }
 
 bool LexicalEnvironment::has_super_binding() const
@@ -7,7 +7,7 @@
 #pragma once
 
 #include <AK/FlyString.h>
-#include <AK/HashMap.h>
+#include <AK/Vector.h>
 #include <LibJS/Runtime/ScopeObject.h>
 #include <LibJS/Runtime/Value.h>
 
@@ -17,6 +17,11 @@ class LexicalEnvironment final : public ScopeObject {
     JS_OBJECT(LexicalEnvironment, ScopeObject);
 
 public:
+    struct Binding {
+        FlyString name;
+        Variable variable;
+    };
+
     enum class ThisBindingStatus {
         Lexical,
         Initialized,
@@ -32,8 +37,8 @@ public:
 
     LexicalEnvironment();
     LexicalEnvironment(EnvironmentRecordType);
-    LexicalEnvironment(HashMap<FlyString, Variable> variables, ScopeObject* parent_scope);
-    LexicalEnvironment(HashMap<FlyString, Variable> variables, ScopeObject* parent_scope, EnvironmentRecordType);
+    LexicalEnvironment(Vector<Binding> variables, ScopeObject* parent_scope);
+    LexicalEnvironment(Vector<Binding> variables, ScopeObject* parent_scope, EnvironmentRecordType);
     virtual ~LexicalEnvironment() override;
 
     // ^ScopeObject
@@ -44,7 +49,7 @@ public:
 
     void clear();
 
-    const HashMap<FlyString, Variable>& variables() const { return m_variables; }
+    const Vector<Binding>& variables() const { return m_variables; }
 
     void set_home_object(Value object) { m_home_object = object; }
     bool has_super_binding() const;
@@ -69,7 +74,10 @@ private:
 
     EnvironmentRecordType m_environment_record_type : 8 { EnvironmentRecordType::Declarative };
     ThisBindingStatus m_this_binding_status : 8 { ThisBindingStatus::Uninitialized };
-    HashMap<FlyString, Variable> m_variables;
+    // Environments are almost always tiny, so bindings live in a flat vector
+    // that is scanned with FlyString comparisons (i.e. pointer equality),
+    // which beats hashing the name once per environment on the scope chain.
+    Vector<Binding> m_variables;
     Value m_home_object;
     Value m_this_value;
     Value m_new_target;
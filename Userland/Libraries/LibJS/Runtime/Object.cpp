@@ -655,6 +655,15 @@ bool Object::put_own_property_by_index(u32 property_index, Value value, Property
 {
     VERIFY(!(mode == PutOwnPropertyMode::Put && value.is_accessor()));
 
+    // Fast path: writing a plain value to packed element storage. In-bounds
+    // writes overwrite writable default-attribute slots, and appends only
+    // need the extensibility check; everything else goes through the generic
+    // checks below.
+    if (mode == PutOwnPropertyMode::Put && attributes == default_attributes && !value.is_empty()) {
+        if (m_indexed_properties.put_packed(property_index, value, is_extensible()))
+            return true;
+    }
+
     auto existing_property = m_indexed_properties.get(nullptr, property_index, false);
     auto new_property = !existing_property.has_value();
 
@@ -743,12 +752,20 @@ Value Object::get_by_index(u32 property_index) const
             auto& string = static_cast<const StringObject&>(*object).primitive_string().string();
             if (property_index < string.length())
                 return js_string(heap(), string.substring(property_index, 1));
-        } else if (static_cast<size_t>(property_index) < object->m_indexed_properties.array_like_size()) {
-            auto result = object->m_indexed_properties.get(const_cast<Object*>(this), property_index);
-            if (vm().exception())
-                return {};
-            if (result.has_value() && !result.value().value.is_empty())
-                return result.value().value;
+        } else {
+            // Dense arrays keep their elements in packed storage; read
+            // straight out of the flat vector and leave holes, accessors and
+            // native properties to the generic path below.
+            auto packed_value = object->m_indexed_properties.get_packed(property_index);
+            if (packed_value.has_value())
+                return packed_value.value();
+            if (static_cast<size_t>(property_index) < object->m_indexed_properties.array_like_size()) {
+                auto result = object->m_indexed_properties.get(const_cast<Object*>(this), property_index);
+                if (vm().exception())
+                    return {};
+                if (result.has_value() && !result.value().value.is_empty())
+                    return result.value().value;
+            }
         }
         object = object->prototype();
         if (vm().exception())
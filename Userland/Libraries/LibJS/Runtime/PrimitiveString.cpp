@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/StringBuilder.h>
+#include <AK/Vector.h>
 #include <LibJS/Runtime/PrimitiveString.h>
 #include <LibJS/Runtime/VM.h>
 
@@ -14,10 +16,62 @@ PrimitiveString::PrimitiveString(String string)
 {
 }
 
+PrimitiveString::PrimitiveString(PrimitiveString& lhs, PrimitiveString& rhs)
+    : m_is_rope(true)
+    , m_lhs(&lhs)
+    , m_rhs(&rhs)
+{
+}
+
 PrimitiveString::~PrimitiveString()
 {
 }
 
+void PrimitiveString::visit_edges(Cell::Visitor& visitor)
+{
+    Cell::visit_edges(visitor);
+    if (!m_is_rope)
+        return;
+    visitor.visit(m_lhs);
+    visitor.visit(m_rhs);
+}
+
+void PrimitiveString::resolve_rope_if_needed() const
+{
+    if (!m_is_rope)
+        return;
+
+    // Repeated concatenation in a loop builds a deep left spine, so we
+    // collect the flat segments with an explicit stack instead of recursing.
+    Vector<const PrimitiveString*> segments;
+    Vector<const PrimitiveString*> stack;
+    stack.append(this);
+    while (!stack.is_empty()) {
+        auto* current = stack.take_last();
+        if (current->m_is_rope) {
+            stack.append(current->m_rhs);
+            stack.append(current->m_lhs);
+            continue;
+        }
+        segments.append(current);
+    }
+
+    StringBuilder builder;
+    for (auto* segment : segments)
+        builder.append(segment->m_string);
+
+    m_string = builder.to_string();
+    m_is_rope = false;
+    m_lhs = nullptr;
+    m_rhs = nullptr;
+}
+
+const String& PrimitiveString::string() const
+{
+    resolve_rope_if_needed();
+    return m_string;
+}
+
 PrimitiveString* js_string(Heap& heap, String string)
 {
     if (string.is_empty())
@@ -34,4 +88,14 @@ PrimitiveString* js_string(VM& vm, String string)
     return js_string(vm.heap(), move(string));
 }
 
+PrimitiveString* js_rope_string(VM& vm, PrimitiveString& lhs, PrimitiveString& rhs)
+{
+    // Concatenating with an empty string doesn't need a rope node.
+    if (!lhs.is_rope() && lhs.string().is_empty())
+        return &rhs;
+    if (!rhs.is_rope() && rhs.string().is_empty())
+        return &lhs;
+    return vm.heap().allocate_without_global_object<PrimitiveString>(lhs, rhs);
+}
+
 }
@@ -14,17 +14,29 @@ namespace JS {
 class PrimitiveString final : public Cell {
 public:
     explicit PrimitiveString(String);
+    PrimitiveString(PrimitiveString&, PrimitiveString&);
     virtual ~PrimitiveString();
 
-    const String& string() const { return m_string; }
+    // A rope is a lazy concatenation: it only holds its two sides and is
+    // flattened into a flat string on first character access.
+    bool is_rope() const { return m_is_rope; }
+
+    const String& string() const;
 
 private:
     virtual const char* class_name() const override { return "PrimitiveString"; }
+    virtual void visit_edges(Visitor&) override;
+
+    void resolve_rope_if_needed() const;
 
-    String m_string;
+    mutable bool m_is_rope { false };
+    mutable PrimitiveString* m_lhs { nullptr };
+    mutable PrimitiveString* m_rhs { nullptr };
+    mutable String m_string;
 };
 
 PrimitiveString* js_string(Heap&, String);
 PrimitiveString* js_string(VM&, String);
+PrimitiveString* js_rope_string(VM&, PrimitiveString&, PrimitiveString&);
 
 }
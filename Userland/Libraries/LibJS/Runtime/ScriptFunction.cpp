@@ -69,15 +69,25 @@ void ScriptFunction::visit_edges(Visitor& visitor)
 
 LexicalEnvironment* ScriptFunction::create_environment()
 {
-    HashMap<FlyString, Variable> variables;
+    Vector<LexicalEnvironment::Binding> variables;
+    auto add_variable = [&](const FlyString& name, Variable variable) {
+        for (auto& binding : variables) {
+            if (binding.name == name) {
+                binding.variable = variable;
+                return;
+            }
+        }
+        variables.append({ name, variable });
+    };
+
     for (auto& parameter : m_parameters) {
-        variables.set(parameter.name, { js_undefined(), DeclarationKind::Var });
+        add_variable(parameter.name, { js_undefined(), DeclarationKind::Var });
     }
 
     if (is<ScopeNode>(body())) {
         for (auto& declaration : static_cast<const ScopeNode&>(body()).variables()) {
             for (auto& declarator : declaration.declarations()) {
-                variables.set(declarator.id().string(), { js_undefined(), declaration.declaration_kind() });
+                add_variable(declarator.id().string(), { js_undefined(), declaration.declaration_kind() });
             }
         }
     }
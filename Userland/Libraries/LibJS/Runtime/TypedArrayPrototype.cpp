@@ -7,6 +7,7 @@
 #include <LibJS/Runtime/GlobalObject.h>
 #include <LibJS/Runtime/TypedArray.h>
 #include <LibJS/Runtime/TypedArrayPrototype.h>
+#include <string.h>
 
 namespace JS {
 
@@ -27,6 +28,9 @@ void TypedArrayPrototype::initialize(GlobalObject& object)
     define_native_property(vm.names.byteLength, byte_length_getter, nullptr, Attribute::Configurable);
     define_native_property(vm.names.byteOffset, byte_offset_getter, nullptr, Attribute::Configurable);
     define_native_function(vm.names.at, at, 1, attr);
+    define_native_function(vm.names.copyWithin, copy_within, 2, attr);
+    define_native_function(vm.names.fill, fill, 1, attr);
+    define_native_function(vm.names.set, set, 1, attr);
 }
 
 TypedArrayPrototype::~TypedArrayPrototype()
@@ -76,6 +80,199 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::at)
     return typed_array->get(index.value());
 }
 
+// https://tc39.es/ecma262/#sec-%typedarray%.prototype.copywithin
+JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::copy_within)
+{
+    auto typed_array = typed_array_from(vm, global_object);
+    if (!typed_array)
+        return {};
+
+    ssize_t length = typed_array->array_length();
+
+    ssize_t relative_target = vm.argument(0).to_i32(global_object);
+    if (vm.exception())
+        return {};
+
+    ssize_t relative_start = 0;
+    if (vm.argument_count() >= 2) {
+        relative_start = vm.argument(1).to_i32(global_object);
+        if (vm.exception())
+            return {};
+    }
+
+    ssize_t relative_end = length;
+    if (vm.argument_count() >= 3) {
+        relative_end = vm.argument(2).to_i32(global_object);
+        if (vm.exception())
+            return {};
+    }
+
+    size_t to, from, final;
+
+    if (relative_target < 0)
+        to = max(length + relative_target, 0L);
+    else
+        to = min(relative_target, length);
+
+    if (relative_start < 0)
+        from = max(length + relative_start, 0L);
+    else
+        from = min(relative_start, length);
+
+    if (relative_end < 0)
+        final = max(length + relative_end, 0L);
+    else
+        final = min(relative_end, length);
+
+    size_t count = final > from ? min(final - from, static_cast<size_t>(length) - to) : 0;
+    if (count > 0) {
+        // Source and destination are views of the same buffer with the same element type,
+        // so the copy is a single (possibly overlapping) byte move.
+        auto* data = typed_array->viewed_array_buffer()->buffer().data() + typed_array->byte_offset();
+        auto element_size = typed_array->element_size();
+        memmove(data + to * element_size, data + from * element_size, count * element_size);
+    }
+
+    return typed_array;
+}
+
+// https://tc39.es/ecma262/#sec-%typedarray%.prototype.fill
+JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::fill)
+{
+    auto typed_array = typed_array_from(vm, global_object);
+    if (!typed_array)
+        return {};
+
+    ssize_t length = typed_array->array_length();
+
+    auto value = vm.argument(0).to_number(global_object);
+    if (vm.exception())
+        return {};
+
+    ssize_t relative_start = 0;
+    if (vm.argument_count() >= 2) {
+        relative_start = vm.argument(1).to_i32(global_object);
+        if (vm.exception())
+            return {};
+    }
+
+    ssize_t relative_end = length;
+    if (vm.argument_count() >= 3) {
+        relative_end = vm.argument(2).to_i32(global_object);
+        if (vm.exception())
+            return {};
+    }
+
+    size_t from, to;
+
+    if (relative_start < 0)
+        from = max(length + relative_start, 0L);
+    else
+        from = min(relative_start, length);
+
+    if (relative_end < 0)
+        to = max(length + relative_end, 0L);
+    else
+        to = min(relative_end, length);
+
+    // The value only needs to be converted to the element type once - after that the
+    // fill is a plain typed store loop instead of a Value conversion per element.
+#define __JS_ENUMERATE(ClassName, snake_name, PrototypeName, ConstructorName, Type) \
+    if (is<ClassName>(*typed_array)) {                                              \
+        auto data = static_cast<ClassName&>(*typed_array).data();                   \
+        if constexpr (sizeof(Type) < 4) {                                           \
+            auto raw_value = value.to_i32(global_object);                           \
+            if (vm.exception())                                                     \
+                return {};                                                          \
+            for (size_t i = from; i < to; ++i)                                      \
+                data[i] = raw_value;                                                \
+        } else {                                                                    \
+            auto raw_value = value.to_double(global_object);                        \
+            if (vm.exception())                                                     \
+                return {};                                                          \
+            for (size_t i = from; i < to; ++i)                                      \
+                data[i] = raw_value;                                                \
+        }                                                                           \
+    }
+    JS_ENUMERATE_TYPED_ARRAYS
+#undef __JS_ENUMERATE
+
+    return typed_array;
+}
+
+// https://tc39.es/ecma262/#sec-%typedarray%.prototype.set
+JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::set)
+{
+    auto typed_array = typed_array_from(vm, global_object);
+    if (!typed_array)
+        return {};
+
+    auto target_offset = vm.argument(1).to_integer_or_infinity(global_object);
+    if (vm.exception())
+        return {};
+    if (target_offset < 0) {
+        vm.throw_exception<RangeError>(global_object, ErrorType::TypedArrayInvalidTargetOffset);
+        return {};
+    }
+
+    auto source_value = vm.argument(0);
+    if (source_value.is_object() && source_value.as_object().is_typed_array()) {
+        auto& source = static_cast<TypedArrayBase&>(source_value.as_object());
+
+        if (source.array_length() + target_offset > typed_array->array_length()) {
+            vm.throw_exception<RangeError>(global_object, ErrorType::TypedArraySourceTooLarge);
+            return {};
+        }
+
+        bool same_element_type = false;
+#define __JS_ENUMERATE(ClassName, snake_name, PrototypeName, ConstructorName, Type) \
+    if (is<ClassName>(*typed_array) && is<ClassName>(source))                       \
+        same_element_type = true;
+        JS_ENUMERATE_TYPED_ARRAYS
+#undef __JS_ENUMERATE
+
+        if (same_element_type) {
+            // Same element type, so the elements can be copied byte-for-byte. The two arrays
+            // may be views of the same buffer, hence memmove rather than memcpy.
+            auto* destination_data = typed_array->viewed_array_buffer()->buffer().data() + typed_array->byte_offset();
+            auto* source_data = source.viewed_array_buffer()->buffer().data() + source.byte_offset();
+            memmove(destination_data + static_cast<size_t>(target_offset) * typed_array->element_size(), source_data, source.byte_length());
+        } else {
+            // FIXME: If the arrays use the same buffer but have different element types, the
+            //        source should be copied before the element-wise conversion loop.
+            for (u32 i = 0; i < source.array_length(); ++i) {
+                typed_array->put(static_cast<u32>(target_offset) + i, source.get(i));
+                if (vm.exception())
+                    return {};
+            }
+        }
+    } else {
+        auto* source = source_value.to_object(global_object);
+        if (!source)
+            return {};
+
+        auto source_length = length_of_array_like(global_object, *source);
+        if (vm.exception())
+            return {};
+
+        if (source_length + target_offset > typed_array->array_length()) {
+            vm.throw_exception<RangeError>(global_object, ErrorType::TypedArraySourceTooLarge);
+            return {};
+        }
+
+        for (size_t i = 0; i < source_length; ++i) {
+            auto value = source->get(i).value_or(js_undefined());
+            if (vm.exception())
+                return {};
+            typed_array->put(static_cast<u32>(target_offset) + i, value);
+            if (vm.exception())
+                return {};
+        }
+    }
+
+    return js_undefined();
+}
+
 // https://tc39.es/ecma262/#sec-get-%typedarray%.prototype.buffer
 JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::buffer_getter)
 {
@@ -9,6 +9,7 @@
 #include <AK/FlyString.h>
 #include <AK/String.h>
 #include <AK/StringBuilder.h>
+#include <AK/StringUtils.h>
 #include <AK/Utf8View.h>
 #include <LibCrypto/BigInt/SignedBigInteger.h>
 #include <LibCrypto/NumberTheory/ModularFunctions.h>
@@ -73,6 +74,16 @@ static String double_to_string(double d)
     // https://tc39.es/ecma262/#sec-numeric-types-number-tostring
     if (isnan(d))
         return "NaN";
+
+    // Fast path: integers in the safe range are by far the dominant case
+    // and can be formatted with plain integer division instead of the
+    // digit-by-digit floating point juggling below.
+    if (d >= -9007199254740992.0 && d <= 9007199254740992.0) {
+        auto as_integer = static_cast<i64>(d);
+        if (static_cast<double>(as_integer) == d)
+            return String::number(as_integer);
+    }
+
     if (d == +0.0 || d == -0.0)
         return "0";
     if (d < +0.0) {
@@ -454,15 +465,20 @@ Value Value::to_number(GlobalObject& global_object) const
     case Type::Double:
         return *this;
     case Type::String: {
-        auto string = as_string().string().trim_whitespace();
+        auto string = AK::StringUtils::trim_whitespace(as_string().string().view(), TrimMode::Both);
         if (string.is_empty())
             return Value(0);
         if (string == "Infinity" || string == "+Infinity")
             return js_infinity();
         if (string == "-Infinity")
             return js_negative_infinity();
+        // Fast path: plain integers, without allocating a trimmed copy for
+        // strtod(). "-0" has to stay on the slow path to produce negative zero.
+        if (auto as_integer = string.to_int<i64>(); as_integer.has_value() && !(as_integer.value() == 0 && string.starts_with('-')))
+            return Value(static_cast<double>(as_integer.value()));
         char* endptr;
-        auto parsed_double = strtod(string.characters(), &endptr);
+        auto null_terminated_string = String { string };
+        auto parsed_double = strtod(null_terminated_string.characters(), &endptr);
         if (*endptr)
             return js_nan();
         return Value(parsed_double);
@@ -863,6 +879,9 @@ Value add(GlobalObject& global_object, Value lhs, Value rhs)
     if (vm.exception())
         return {};
 
+    if (lhs_primitive.is_string() && rhs_primitive.is_string())
+        return js_rope_string(vm, lhs_primitive.as_string(), rhs_primitive.as_string());
+
     if (lhs_primitive.is_string() || rhs_primitive.is_string()) {
         auto lhs_string = lhs_primitive.to_string(global_object);
         if (vm.exception())
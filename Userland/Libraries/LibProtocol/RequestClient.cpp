@@ -34,6 +34,11 @@ RefPtr<Request> RequestClient::start_request(const String& method, const String&
     return nullptr;
 }
 
+void RequestClient::prefetch_dns(const URL& url)
+{
+    async_prefetch_dns(url);
+}
+
 bool RequestClient::stop_request(Badge<Request>, Request& request)
 {
     if (!m_requests.contains(request.id()))
@@ -24,6 +24,8 @@ public:
     template<typename RequestHashMapTraits = Traits<String>>
     RefPtr<Request> start_request(const String& method, const String& url, const HashMap<String, String, RequestHashMapTraits>& request_headers = {}, ReadonlyBytes request_body = {});
 
+    void prefetch_dns(const URL&);
+
     bool stop_request(Badge<Request>, Request&);
     bool set_certificate(Badge<Request>, Request&, String, String);
 
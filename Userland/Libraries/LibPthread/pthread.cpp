@@ -19,6 +19,7 @@
 #include <signal.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/internals.h>
 #include <sys/mman.h>
 #include <syscall.h>
 #include <time.h>
@@ -77,6 +78,7 @@ static int create_thread(pthread_t* thread, void* (*entry)(void*), void* argumen
 [[noreturn]] static void exit_thread(void* code)
 {
     __pthread_key_destroy_for_current_thread();
+    __malloc_thread_cleanup();
     syscall(SC_exit_thread, code);
     VERIFY_NOT_REACHED();
 }
@@ -556,6 +558,22 @@ int pthread_getname_np(pthread_t thread, char* buffer, size_t buffer_size)
     __RETURN_PTHREAD_ERROR(rc);
 }
 
+// The affinity mask has one bit per processor; a thread only runs on
+// processors whose bit is set. Thread 0 means the calling thread.
+int pthread_setaffinity_np(pthread_t thread, uint32_t affinity_mask)
+{
+    int rc = syscall(SC_sched_setaffinity, thread, &affinity_mask);
+    __RETURN_PTHREAD_ERROR(rc);
+}
+
+int pthread_getaffinity_np(pthread_t thread, uint32_t* affinity_mask)
+{
+    if (!affinity_mask)
+        return EFAULT;
+    int rc = syscall(SC_sched_getaffinity, thread, affinity_mask);
+    __RETURN_PTHREAD_ERROR(rc);
+}
+
 int pthread_setcancelstate(int state, int* oldstate)
 {
     if (oldstate)
@@ -120,6 +120,8 @@ int pthread_mutexattr_destroy(pthread_mutexattr_t*);
 
 int pthread_setname_np(pthread_t, const char*);
 int pthread_getname_np(pthread_t, char*, size_t);
+int pthread_setaffinity_np(pthread_t, uint32_t);
+int pthread_getaffinity_np(pthread_t, uint32_t*);
 
 int pthread_equal(pthread_t t1, pthread_t t2);
 
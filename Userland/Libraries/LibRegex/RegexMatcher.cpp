@@ -11,6 +11,7 @@
 #include <AK/ScopedValueRollback.h>
 #include <AK/String.h>
 #include <AK/StringBuilder.h>
+#include <string.h>
 
 namespace regex {
 
@@ -18,6 +19,50 @@ namespace regex {
 static RegexDebug s_regex_dbg(stderr);
 #endif
 
+// Walk the bytecode up to the first fork or jump to figure out whether
+// every possible match has to start with one specific character.
+static Optional<u32> find_starting_char(const ByteCode& bytecode)
+{
+    for (size_t instruction_position = 0; instruction_position < bytecode.size();) {
+        switch ((OpCodeId)bytecode.at(instruction_position)) {
+        case OpCodeId::Compare: {
+            auto arguments_count = bytecode.at(instruction_position + 1);
+            if (arguments_count != 1)
+                return {};
+            auto compare_type = (CharacterCompareType)bytecode.at(instruction_position + 3);
+            if (compare_type == CharacterCompareType::Char)
+                return (u32)bytecode.at(instruction_position + 4);
+            if (compare_type == CharacterCompareType::String) {
+                auto length = bytecode.at(instruction_position + 4);
+                if (length == 0)
+                    return {};
+                // The VM truncates each stored character to a byte when it
+                // rebuilds the string to compare, so we have to as well;
+                // multi-byte characters are stored sign-extended.
+                return (u32)(u8)bytecode.at(instruction_position + 5);
+            }
+            return {};
+        }
+        // These don't consume input, the first character to be matched comes after them.
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::CheckBoundary:
+            instruction_position += 2;
+            continue;
+        case OpCodeId::SaveLeftNamedCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+            instruction_position += 3;
+            continue;
+        case OpCodeId::CheckBegin:
+            instruction_position += 1;
+            continue;
+        default:
+            return {};
+        }
+    }
+    return {};
+}
+
 template<class Parser>
 Regex<Parser>::Regex(StringView pattern, typename ParserTraits<Parser>::OptionsType regex_options)
 {
@@ -27,8 +72,10 @@ Regex<Parser>::Regex(StringView pattern, typename ParserTraits<Parser>::OptionsT
     Parser parser(lexer, regex_options);
     parser_result = parser.parse();
 
-    if (parser_result.error == regex::Error::NoError)
+    if (parser_result.error == regex::Error::NoError) {
+        starting_char = find_starting_char(parser_result.bytecode);
         matcher = make<Matcher<Parser>>(*this, regex_options);
+    }
 }
 
 template<class Parser>
@@ -130,6 +177,34 @@ RegexResult Matcher<Parser>::match(const Vector<RegexStringView> views, Optional
         }
     };
 
+    // If the pattern can only start by matching one specific character, skip
+    // ahead to its next occurrence instead of running the bytecode at every
+    // single position; a memchr() beats the VM's per-position setup by a mile.
+    auto& starting_char = m_pattern.starting_char;
+    bool insensitive = input.regex_options.has_flag_set(AllFlags::Insensitive);
+    auto advance_to_next_start_candidate = [&](size_t from) -> size_t {
+        auto ch = starting_char.value();
+        auto view_length = input.view.length();
+        if (insensitive) {
+            for (; from < view_length; ++from) {
+                if (tolower(input.view[from]) == tolower(ch))
+                    break;
+            }
+            return from;
+        }
+        if (input.view.is_u8_view() && ch <= 0xff) {
+            auto& view = input.view.u8view();
+            auto* characters = view.characters_without_null_termination();
+            auto* candidate = (const char*)memchr(characters + from, ch, view_length - from);
+            return candidate ? (size_t)(candidate - characters) : view_length;
+        }
+        for (; from < view_length; ++from) {
+            if (input.view[from] == ch)
+                break;
+        }
+        return from;
+    };
+
 #if REGEX_DEBUG
     s_regex_dbg.print_header();
 #endif
@@ -138,6 +213,12 @@ RegexResult Matcher<Parser>::match(const Vector<RegexStringView> views, Optional
     if (input.regex_options.has_flag_set(AllFlags::Internal_Stateful))
         continue_search = false;
 
+    // The prefilter is only valid when a failed attempt may retry at a later
+    // position; a plain match() is anchored to its start position and has to
+    // attempt (and fail) right there, e.g. for NOTBOL semantics.
+    bool use_start_candidates = starting_char.has_value()
+        && (continue_search || input.regex_options.has_flag_set(AllFlags::Internal_Stateful));
+
     for (auto& view : views) {
         if (lines_to_skip != 0) {
             ++input.line;
@@ -179,6 +260,11 @@ RegexResult Matcher<Parser>::match(const Vector<RegexStringView> views, Optional
         }
 
         for (; view_index < view_length; ++view_index) {
+            if (use_start_candidates) {
+                view_index = advance_to_next_start_candidate(view_index);
+                if (view_index >= view_length)
+                    break;
+            }
             auto& match_length_minimum = m_pattern.parser_result.match_length_minimum;
             // FIXME: More performant would be to know the remaining minimum string
             //        length needed to match from the current position onwards within
@@ -74,6 +74,10 @@ public:
     regex::Parser::Result parser_result;
     OwnPtr<Matcher<Parser>> matcher { nullptr };
     mutable size_t start_offset { 0 };
+    // If every possible match has to start with one specific character, it
+    // is noted here so the matcher can skip ahead to its next occurrence
+    // instead of running the bytecode at every single input position.
+    Optional<u32> starting_char;
 
     explicit Regex(StringView pattern, typename ParserTraits<Parser>::OptionsType regex_options = {});
     ~Regex() = default;
@@ -72,7 +72,8 @@ Token Lexer::next()
             consume();
         } while (is_identifier_middle());
 
-        if (auto it = s_keywords.find(m_source.substring_view(value_start - 1, m_position - value_start)); it != s_keywords.end()) {
+        auto value = m_source.substring_view(value_start - 1, m_position - value_start);
+        if (auto it = s_keywords.find(value.hash(), [&](auto& entry) { return entry.key == value; }); it != s_keywords.end()) {
             token_type = it->value;
         } else {
             token_type = TokenType::Identifier;
@@ -80,7 +81,8 @@ Token Lexer::next()
     } else {
         bool found_two_char_token = false;
         if (m_position < m_source.length()) {
-            if (auto it = s_two_char_tokens.find(m_source.substring_view(m_position - 1, 2)); it != s_two_char_tokens.end()) {
+            auto value = m_source.substring_view(m_position - 1, 2);
+            if (auto it = s_two_char_tokens.find(value.hash(), [&](auto& entry) { return entry.key == value; }); it != s_two_char_tokens.end()) {
                 found_two_char_token = true;
                 token_type = it->value;
                 consume();
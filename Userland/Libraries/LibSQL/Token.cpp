@@ -8,6 +8,7 @@
 #include <AK/Assertions.h>
 #include <AK/String.h>
 #include <stdlib.h>
+#include <string.h>
 
 namespace SQL {
 
@@ -40,14 +41,25 @@ TokenCategory Token::category(TokenType type)
 double Token::double_value() const
 {
     VERIFY(type() == TokenType::NumericLiteral);
-    String value(m_value);
 
-    if (value[0] == '0' && value.length() >= 2) {
-        if (value[1] == 'x' || value[1] == 'X')
-            return static_cast<double>(strtoul(value.characters() + 2, nullptr, 16));
+    auto convert = [](const char* characters, size_t length) -> double {
+        if (length >= 2 && characters[0] == '0' && (characters[1] == 'x' || characters[1] == 'X'))
+            return static_cast<double>(strtoul(characters + 2, nullptr, 16));
+        return strtod(characters, nullptr);
+    };
+
+    // The value is a view into the source text, but strto* want a null
+    // terminator; short literals (i.e. all of them in practice) convert on
+    // the stack instead of allocating a String.
+    char buffer[64];
+    if (m_value.length() < sizeof(buffer)) {
+        memcpy(buffer, m_value.characters_without_null_termination(), m_value.length());
+        buffer[m_value.length()] = '\0';
+        return convert(buffer, m_value.length());
     }
 
-    return strtod(value.characters(), nullptr);
+    String value(m_value);
+    return convert(value.characters(), value.length());
 }
 
 }
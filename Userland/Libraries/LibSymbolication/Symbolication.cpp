@@ -4,13 +4,21 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Demangle.h>
 #include <AK/JsonArray.h>
 #include <AK/JsonObject.h>
 #include <AK/JsonValue.h>
 #include <AK/MappedFile.h>
+#include <AK/QuickSort.h>
 #include <LibCore/File.h>
+#include <LibCore/StandardPaths.h>
 #include <LibDebug/DebugInfo.h>
 #include <LibSymbolication/Symbolication.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace Symbolication {
 
@@ -21,9 +29,229 @@ struct CachedELF {
 
 static HashMap<String, OwnPtr<CachedELF>> s_cache;
 
+// On-disk symbol cache: parsing the ELF symbol table and the DWARF line
+// programs of something like libweb.so takes seconds, and every process
+// that symbolicates used to pay that cost again. The first full parse of
+// a binary therefore persists its results in a flat file under
+// ~/.cache/symbols, keyed by the binary's mtime and size: a header, a
+// sorted address->name table, a sorted address->source-line table and a
+// string table. Later lookups (from any process) mmap that file and
+// binary-search it directly, without touching LibDebug at all.
+static constexpr u32 symbol_cache_magic = 0x53594d43; // 'SYMC'
+static constexpr u32 symbol_cache_version = 1;
+
+struct SymbolCacheHeader {
+    u32 magic;
+    u32 version;
+    u64 source_mtime;
+    u64 source_size;
+    u32 symbol_count;
+    u32 line_count;
+    u32 string_table_size;
+};
+
+struct SymbolCacheEntry {
+    u32 address;
+    u32 name_offset;
+};
+
+struct LineCacheEntry {
+    u32 address;
+    u32 file_offset;
+    u32 line;
+};
+
+struct MappedSymbolCache {
+    NonnullRefPtr<MappedFile> file;
+    const SymbolCacheHeader* header { nullptr };
+    const SymbolCacheEntry* symbols { nullptr };
+    const LineCacheEntry* lines { nullptr };
+    const char* strings { nullptr };
+};
+
+static HashMap<String, OwnPtr<MappedSymbolCache>> s_disk_cache;
+
+static String symbol_cache_directory()
+{
+    return String::formatted("{}/.cache/symbols", Core::StandardPaths::home_directory());
+}
+
+static String symbol_cache_path_for_binary(String const& path)
+{
+    auto escaped_path = path;
+    escaped_path.replace("/", "_", true);
+    return String::formatted("{}/{}.symc", symbol_cache_directory(), escaped_path);
+}
+
+static MappedSymbolCache* load_symbol_cache(String const& path)
+{
+    if (auto it = s_disk_cache.find(path); it != s_disk_cache.end())
+        return it->value.ptr();
+
+    struct stat binary_stat;
+    if (stat(path.characters(), &binary_stat) < 0)
+        return nullptr;
+
+    auto file_or_error = MappedFile::map(symbol_cache_path_for_binary(path));
+    if (file_or_error.is_error())
+        return nullptr;
+    auto bytes = file_or_error.value()->bytes();
+    if (bytes.size() < sizeof(SymbolCacheHeader))
+        return nullptr;
+
+    auto& header = *reinterpret_cast<const SymbolCacheHeader*>(bytes.data());
+    if (header.magic != symbol_cache_magic || header.version != symbol_cache_version)
+        return nullptr;
+    // A stale cache (the binary was rebuilt) is simply ignored; the full
+    // parse below will overwrite it.
+    if (header.source_mtime != (u64)binary_stat.st_mtime || header.source_size != (u64)binary_stat.st_size)
+        return nullptr;
+    size_t expected_size = sizeof(SymbolCacheHeader)
+        + header.symbol_count * sizeof(SymbolCacheEntry)
+        + header.line_count * sizeof(LineCacheEntry)
+        + header.string_table_size;
+    if (bytes.size() != expected_size)
+        return nullptr;
+    if (header.string_table_size != 0 && bytes[bytes.size() - 1] != '\0')
+        return nullptr;
+
+    auto cache = make<MappedSymbolCache>(MappedSymbolCache { file_or_error.release_value() });
+    cache->header = &header;
+    cache->symbols = reinterpret_cast<const SymbolCacheEntry*>(bytes.data() + sizeof(SymbolCacheHeader));
+    cache->lines = reinterpret_cast<const LineCacheEntry*>(cache->symbols + header.symbol_count);
+    cache->strings = reinterpret_cast<const char*>(cache->lines + header.line_count);
+    auto* pointer = cache.ptr();
+    s_disk_cache.set(path, move(cache));
+    return pointer;
+}
+
+static Optional<Symbol> symbolicate_from_cache(MappedSymbolCache const& cache, u32 address)
+{
+    auto& header = *cache.header;
+
+    auto string_at = [&](u32 offset) -> String {
+        if (offset >= header.string_table_size)
+            return {};
+        return cache.strings + offset;
+    };
+
+    // Find the last symbol at or below the address, like ELF::Image::symbolicate().
+    String name = "??";
+    u32 offset = 0;
+    if (header.symbol_count != 0 && address >= cache.symbols[0].address) {
+        size_t low = 0, high = header.symbol_count - 1;
+        while (low < high) {
+            size_t middle = low + (high - low + 1) / 2;
+            if (cache.symbols[middle].address <= address)
+                low = middle;
+            else
+                high = middle - 1;
+        }
+        name = string_at(cache.symbols[low].name_offset);
+        offset = address - cache.symbols[low].address;
+    }
+
+    // Find the line entry containing the address, like DebugInfo::get_source_position().
+    String filename;
+    u32 line_number = 0;
+    if (header.line_count != 0 && address >= cache.lines[0].address && address < cache.lines[header.line_count - 1].address) {
+        size_t low = 0, high = header.line_count - 1;
+        while (low < high) {
+            size_t middle = low + (high - low + 1) / 2;
+            if (cache.lines[middle].address <= address)
+                low = middle;
+            else
+                high = middle - 1;
+        }
+        filename = string_at(cache.lines[low].file_offset);
+        line_number = cache.lines[low].line;
+    }
+
+    return Symbol {
+        .address = address,
+        .name = move(name),
+        .offset = offset,
+        .filename = move(filename),
+        .line_number = line_number
+    };
+}
+
+static void write_symbol_cache(String const& path, CachedELF const& cached_elf)
+{
+    struct stat binary_stat;
+    if (stat(path.characters(), &binary_stat) < 0)
+        return;
+
+    Vector<SymbolCacheEntry> symbols;
+    Vector<LineCacheEntry> lines;
+    Vector<u8> string_table;
+    HashMap<String, u32> string_offsets;
+
+    auto intern_string = [&](String const& string) -> u32 {
+        if (auto it = string_offsets.find(string); it != string_offsets.end())
+            return it->value;
+        u32 offset = string_table.size();
+        string_table.append(reinterpret_cast<const u8*>(string.characters()), string.length() + 1);
+        string_offsets.set(string, offset);
+        return offset;
+    };
+
+    auto& elf = cached_elf.debug_info.elf();
+    symbols.ensure_capacity(elf.symbol_count());
+    elf.for_each_symbol([&](auto symbol) {
+        symbols.append({ (u32)symbol.value(), intern_string(demangle(symbol.name())) });
+        return IterationDecision::Continue;
+    });
+    quick_sort(symbols, [](auto& a, auto& b) { return a.address < b.address; });
+
+    cached_elf.debug_info.for_each_source_position([&](Debug::DebugInfo::SourcePosition const& position) {
+        lines.append({ position.address_of_first_statement.value(), intern_string(position.file_path), (u32)position.line_number });
+    });
+
+    if (mkdir(String::formatted("{}/.cache", Core::StandardPaths::home_directory()).characters(), 0700) < 0 && errno != EEXIST)
+        return;
+    if (mkdir(symbol_cache_directory().characters(), 0700) < 0 && errno != EEXIST)
+        return;
+
+    // Write to a temporary file and rename it into place, so a concurrent
+    // reader never sees a half-written cache.
+    auto cache_path = symbol_cache_path_for_binary(path);
+    auto temporary_path = String::formatted("{}.tmp", cache_path);
+    int fd = open(temporary_path.characters(), O_CREAT | O_WRONLY | O_TRUNC, 0600);
+    if (fd < 0)
+        return;
+
+    SymbolCacheHeader header {
+        .magic = symbol_cache_magic,
+        .version = symbol_cache_version,
+        .source_mtime = (u64)binary_stat.st_mtime,
+        .source_size = (u64)binary_stat.st_size,
+        .symbol_count = (u32)symbols.size(),
+        .line_count = (u32)lines.size(),
+        .string_table_size = (u32)string_table.size(),
+    };
+
+    auto write_fully = [&](const void* data, size_t size) {
+        return write(fd, data, size) == (ssize_t)size;
+    };
+    bool success = write_fully(&header, sizeof(header))
+        && write_fully(symbols.data(), symbols.size() * sizeof(SymbolCacheEntry))
+        && write_fully(lines.data(), lines.size() * sizeof(LineCacheEntry))
+        && write_fully(string_table.data(), string_table.size());
+    close(fd);
+
+    if (!success || rename(temporary_path.characters(), cache_path.characters()) < 0)
+        unlink(temporary_path.characters());
+}
+
 Optional<Symbol> symbolicate(String const& path, u32 address)
 {
     if (!s_cache.contains(path)) {
+        // Answer from the on-disk cache if we can; a full parse (and the
+        // in-memory CachedELF it feeds) is only needed on a cache miss.
+        if (auto* disk_cache = load_symbol_cache(path))
+            return symbolicate_from_cache(*disk_cache, address);
+
         auto mapped_file = MappedFile::map(path);
         if (mapped_file.is_error()) {
             dbgln("Failed to map {}: {}", path, mapped_file.error().string());
@@ -34,10 +262,11 @@ Optional<Symbol> symbolicate(String const& path, u32 address)
         if (!elf->is_valid()) {
             dbgln("ELF not valid: {}", path);
             s_cache.set(path, {});
-            {};
+            return {};
         }
         Debug::DebugInfo debug_info(move(elf));
         auto cached_elf = make<CachedELF>(mapped_file.release_value(), move(debug_info));
+        write_symbol_cache(path, *cached_elf);
         s_cache.set(path, move(cached_elf));
     }
 
@@ -105,10 +105,139 @@ void Highlighter::highlight_matching_token_pair()
     }
 }
 
+bool Highlighter::rehighlight_incrementally(const String& text, Function<Vector<GUI::TextDocumentSpan>(const StringView&, size_t)> lex_range, Function<void(GUI::TextDocumentSpan&)> restyle_span)
+{
+    if (!m_client)
+        return false;
+
+    auto previous_text = move(m_last_highlighted_text);
+    m_last_highlighted_text = text;
+    if (previous_text.is_null())
+        return false;
+
+    auto& previous_spans = m_client->spans();
+
+    if (text == previous_text) {
+        // Only the palette can have changed; restyle the spans in place.
+        for (size_t i = 0; i < previous_spans.size(); ++i) {
+            auto span = previous_spans[i];
+            restyle_span(span);
+            m_client->set_span_at_index(i, move(span));
+        }
+        return true;
+    }
+
+    if (previous_spans.is_empty())
+        return false;
+
+    auto old_lines = previous_text.view().split_view('\n', true);
+    auto new_lines = text.view().split_view('\n', true);
+
+    // The damaged range is whatever sits between the common line prefix and
+    // the common line suffix of the old and new text.
+    size_t common_prefix = 0;
+    while (common_prefix < old_lines.size() && common_prefix < new_lines.size() && old_lines[common_prefix] == new_lines[common_prefix])
+        ++common_prefix;
+    size_t common_suffix = 0;
+    while (common_suffix < min(old_lines.size(), new_lines.size()) - common_prefix
+        && old_lines[old_lines.size() - common_suffix - 1] == new_lines[new_lines.size() - common_suffix - 1])
+        ++common_suffix;
+
+    ssize_t line_delta = (ssize_t)new_lines.size() - (ssize_t)old_lines.size();
+
+    auto last_span_starting_before_line = [&](size_t line) -> const GUI::TextDocumentSpan* {
+        const GUI::TextDocumentSpan* result = nullptr;
+        size_t low = 0, high = previous_spans.size();
+        while (low < high) {
+            size_t middle = low + (high - low) / 2;
+            if (previous_spans[middle].range.start().line() < line) {
+                result = &previous_spans[middle];
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        return result;
+    };
+
+    // Start re-lexing at the start line of the first span that overlaps the
+    // damage, so the window never begins inside a multi-line token.
+    size_t relex_start_line = common_prefix;
+    for (;;) {
+        auto* span = last_span_starting_before_line(relex_start_line);
+        if (!span || span->range.end().line() < relex_start_line)
+            break;
+        relex_start_line = span->range.start().line();
+    }
+    if (relex_start_line >= new_lines.size())
+        return false;
+
+    // Symmetrically, the reusable tail may only begin on an old line that no
+    // old span crosses into.
+    auto resolve_tail_start = [&](size_t tail_start) {
+        for (;;) {
+            auto* span = last_span_starting_before_line(tail_start);
+            if (!span || span->range.end().line() < tail_start)
+                return tail_start;
+            tail_start = span->range.end().line() + 1;
+        }
+    };
+    size_t old_tail_start = resolve_tail_start(old_lines.size() - common_suffix);
+
+    Vector<size_t> new_line_offsets;
+    new_line_offsets.ensure_capacity(new_lines.size());
+    size_t offset = 0;
+    for (auto& line : new_lines) {
+        new_line_offsets.unchecked_append(offset);
+        offset += line.length() + 1;
+    }
+
+    Vector<GUI::TextDocumentSpan> middle_spans;
+    for (;;) {
+        size_t new_relex_end = min(new_lines.size(), (size_t)max((ssize_t)0, (ssize_t)old_tail_start + line_delta));
+        size_t substring_start = new_line_offsets[relex_start_line];
+        size_t substring_end = new_relex_end < new_lines.size() ? new_line_offsets[new_relex_end] : text.length();
+        middle_spans = lex_range(text.substring_view(substring_start, substring_end - substring_start), relex_start_line);
+
+        if (new_relex_end >= new_lines.size())
+            break;
+        // A window ending in whitespace (or containing nothing at all) is
+        // safe to cut at: no token can continue past it. Anything else means
+        // a multi-line token reaches the edge, so double the window.
+        if (middle_spans.is_empty() || middle_spans.last().is_skippable)
+            break;
+        old_tail_start = resolve_tail_start(old_tail_start + max((size_t)1, new_relex_end - relex_start_line));
+    }
+
+    Vector<GUI::TextDocumentSpan> spans;
+    spans.ensure_capacity(previous_spans.size() + middle_spans.size());
+    for (auto& span : previous_spans) {
+        if (span.range.end().line() >= relex_start_line)
+            break;
+        auto copy = span;
+        restyle_span(copy);
+        spans.unchecked_append(move(copy));
+    }
+    for (auto& span : middle_spans)
+        spans.append(move(span));
+    for (auto& span : previous_spans) {
+        if (span.range.start().line() < old_tail_start)
+            continue;
+        auto copy = span;
+        copy.range.set_start({ (size_t)((ssize_t)span.range.start().line() + line_delta), span.range.start().column() });
+        copy.range.set_end({ (size_t)((ssize_t)span.range.end().line() + line_delta), span.range.end().column() });
+        restyle_span(copy);
+        spans.append(move(copy));
+    }
+    m_client->do_set_spans(move(spans));
+    return true;
+}
+
 void Highlighter::attach(HighlighterClient& client)
 {
     VERIFY(!m_client);
     m_client = &client;
+    m_last_highlighted_text = {};
 }
 
 void Highlighter::detach()
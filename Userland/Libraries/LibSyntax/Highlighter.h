@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Function.h>
 #include <AK/Noncopyable.h>
 #include <AK/WeakPtr.h>
 #include <LibGUI/TextDocument.h>
@@ -51,8 +52,25 @@ public:
 protected:
     Highlighter() { }
 
+    // Incremental rehighlighting: diffs the new text against the text from
+    // the previous rehighlight at line granularity, reuses the client's
+    // existing spans outside the damaged line range, and only calls
+    // lex_range() on the damage (widening the window as needed so it never
+    // cuts a multi-line token in half). lex_range() receives a whole-line
+    // substring and the line number it starts at, and must mark pure
+    // whitespace spans as skippable -- that is how the window check knows a
+    // trailing token doesn't continue past the window. restyle_span()
+    // refreshes a reused span's attributes from its token type, so palette
+    // changes don't require any lexing. Returns false when there is nothing
+    // to reuse yet; the caller should then highlight from scratch.
+    bool rehighlight_incrementally(
+        const String& text,
+        Function<Vector<GUI::TextDocumentSpan>(const StringView&, size_t start_line)> lex_range,
+        Function<void(GUI::TextDocumentSpan&)> restyle_span);
+
     // FIXME: This should be WeakPtr somehow
     HighlighterClient* m_client { nullptr };
+    String m_last_highlighted_text;
 
     struct MatchingTokenPair {
         void* open;
@@ -188,17 +188,17 @@ ssize_t TLSv12::handle_handshake_finished(ReadonlyBytes buffer, WritePacketStage
 
     // TODO: Compare Hashes
     dbgln_if(TLS_DEBUG, "FIXME: handle_handshake_finished :: Check message validity");
-    m_context.connection_status = ConnectionStatus::Established;
 
-    if (m_handshake_timeout_timer) {
-        // Disable the handshake timeout timer as handshake has been established.
-        m_handshake_timeout_timer->stop();
-        m_handshake_timeout_timer->remove_from_parent();
-        m_handshake_timeout_timer = nullptr;
+    if (m_context.is_resuming) {
+        // In an abbreviated handshake the server finishes first, and we
+        // reply with our own ChangeCipherSpec and Finished once the
+        // server's Finished has been hashed into the transcript.
+        write_packets = WritePacketStage::Finished;
+        return index + size;
     }
 
-    if (on_tls_ready_to_write)
-        on_tls_ready_to_write(*this);
+    m_context.connection_status = ConnectionStatus::Established;
+    finalize_handshake();
 
     return index + size;
 }
@@ -517,7 +517,9 @@ ssize_t TLSv12::handle_handshake_payload(ReadonlyBytes vbuffer)
                 auto packet = build_handshake_finished();
                 write_packet(packet);
             }
+            m_context.is_resuming = false;
             m_context.connection_status = ConnectionStatus::Established;
+            finalize_handshake();
             break;
         }
         payload_size++;
@@ -55,7 +55,13 @@ ssize_t TLSv12::handle_server_hello(ReadonlyBytes buffer, WritePacketStage& writ
         return (i8)Error::NeedMoreData;
     }
 
+    bool session_resumed = false;
     if (session_length && session_length <= 32) {
+        // If the server echoed the session ID we offered, it has agreed to
+        // resume the cached session.
+        session_resumed = m_context.session_resumption_offered
+            && session_length == m_context.session_id_size
+            && memcmp(m_context.session_id, buffer.offset_pointer(res), session_length) == 0;
         memcpy(m_context.session_id, buffer.offset_pointer(res), session_length);
         m_context.session_id_size = session_length;
         if constexpr (TLS_DEBUG) {
@@ -91,7 +97,19 @@ ssize_t TLSv12::handle_server_hello(ReadonlyBytes buffer, WritePacketStage& writ
     if (compression != 0)
         return (i8)Error::CompressionNotSupported;
 
-    if (m_context.connection_status != ConnectionStatus::Renegotiating)
+    if (session_resumed) {
+        // Abbreviated handshake (RFC 5246 section 7.3): keys are derived
+        // from the cached master secret and the fresh randoms, the key
+        // exchange is skipped, and the server sends its ChangeCipherSpec
+        // and Finished next.
+        dbgln_if(TLS_DEBUG, "Session resumed, skipping key exchange");
+        m_context.is_resuming = true;
+        m_context.connection_status = ConnectionStatus::KeyExchange;
+        if (!expand_key()) {
+            dbgln("oh no, could not expand the cached master key");
+            return (i8)Error::BrokenPacket;
+        }
+    } else if (m_context.connection_status != ConnectionStatus::Renegotiating)
         m_context.connection_status = ConnectionStatus::Negotiating;
     if (m_context.is_server) {
         dbgln("unsupported: server mode");
@@ -74,6 +74,7 @@ bool TLSv12::write(ReadonlyBytes buffer)
 bool TLSv12::connect(const String& hostname, int port)
 {
     set_sni(hostname);
+    offer_cached_session(hostname);
     return Core::Socket::connect(hostname, port);
 }
 
@@ -6,6 +6,7 @@
 
 #include <AK/Debug.h>
 #include <AK/Endian.h>
+#include <AK/HashMap.h>
 #include <LibCore/ConfigFile.h>
 #include <LibCore/DateTime.h>
 #include <LibCore/File.h>
@@ -16,6 +17,7 @@
 #include <LibCrypto/PK/Code/EMSA_PSS.h>
 #include <LibTLS/TLSv12.h>
 #include <errno.h>
+#include <time.h>
 
 #ifndef SOCK_NONBLOCK
 #    include <sys/ioctl.h>
@@ -298,6 +300,72 @@ TLSv12::TLSv12(Core::Object* parent, Options options)
     }
 }
 
+struct CachedSession {
+    u8 session_id[32];
+    u8 session_id_size { 0 };
+    ByteBuffer master_key;
+    time_t timestamp { 0 };
+};
+
+// Established sessions we may offer for resumption, keyed by host name.
+// An entry is removed when it's offered and re-added when a handshake
+// completes, so a stale or rejected entry only ever costs one full
+// handshake.
+static HashMap<String, CachedSession>& session_cache()
+{
+    static HashMap<String, CachedSession> cache;
+    return cache;
+}
+
+// RFC 5246 recommends an upper limit of 24 hours on cached sessions;
+// we're a lot more modest than that.
+constexpr static time_t session_cache_lifetime_in_seconds = 60 * 60;
+
+void TLSv12::offer_cached_session(const String& host)
+{
+    m_context.session_cache_key = host;
+    auto it = session_cache().find(host);
+    if (it == session_cache().end())
+        return;
+    auto cached = move(it->value);
+    session_cache().remove(host);
+    if (time(nullptr) - cached.timestamp > session_cache_lifetime_in_seconds)
+        return;
+    memcpy(m_context.session_id, cached.session_id, cached.session_id_size);
+    m_context.session_id_size = cached.session_id_size;
+    m_context.master_key = move(cached.master_key);
+    m_context.session_resumption_offered = true;
+    dbgln_if(TLS_DEBUG, "Offering cached session for {}", host);
+}
+
+void TLSv12::cache_established_session()
+{
+    if (m_context.session_cache_key.is_empty() || !m_context.session_id_size || m_context.master_key.is_empty())
+        return;
+    CachedSession session;
+    memcpy(session.session_id, m_context.session_id, m_context.session_id_size);
+    session.session_id_size = m_context.session_id_size;
+    session.master_key = m_context.master_key;
+    session.timestamp = time(nullptr);
+    session_cache().set(m_context.session_cache_key, move(session));
+    dbgln_if(TLS_DEBUG, "Cached session for {}", m_context.session_cache_key);
+}
+
+void TLSv12::finalize_handshake()
+{
+    if (m_handshake_timeout_timer) {
+        // Disable the handshake timeout timer as handshake has been established.
+        m_handshake_timeout_timer->stop();
+        m_handshake_timeout_timer->remove_from_parent();
+        m_handshake_timeout_timer = nullptr;
+    }
+
+    cache_established_session();
+
+    if (on_tls_ready_to_write)
+        on_tls_ready_to_write(*this);
+}
+
 bool TLSv12::add_client_key(ReadonlyBytes certificate_pem_buffer, ReadonlyBytes rsa_key) // FIXME: This should not be bound to RSA
 {
     if (certificate_pem_buffer.is_empty() || rsa_key.is_empty()) {
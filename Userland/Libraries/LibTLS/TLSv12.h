@@ -249,6 +249,12 @@ struct Context {
     u8 local_random[32];
     u8 session_id[32];
     u8 session_id_size { 0 };
+    // Session resumption (RFC 5246 section 7.3): if we offered a cached
+    // session ID in our ClientHello and the server echoed it back, both
+    // sides reuse the cached master secret and skip the key exchange.
+    bool session_resumption_offered { false };
+    bool is_resuming { false };
+    String session_cache_key;
     CipherSuite cipher;
     bool is_server { false };
     Vector<Certificate> certificates;
@@ -481,6 +487,10 @@ private:
 
     bool compute_master_secret_from_pre_master_secret(size_t length);
 
+    void offer_cached_session(const String& host);
+    void cache_established_session();
+    void finalize_handshake();
+
     Optional<size_t> verify_chain_and_get_matching_certificate(const StringView& host) const;
 
     void try_disambiguate_error() const;
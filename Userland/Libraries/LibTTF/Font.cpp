@@ -207,21 +207,19 @@ GlyphHorizontalMetrics Hmtx::get_glyph_horizontal_metrics(u32 glyph_id) const
 
 RefPtr<Font> Font::load_from_file(String path, unsigned index)
 {
-    auto file_or_error = Core::File::open(move(path), Core::OpenMode::ReadOnly);
+    auto file_or_error = MappedFile::map(path);
     if (file_or_error.is_error()) {
-        dbgln("Could not open file: {}", file_or_error.error());
+        dbgln("Could not map file: {}", file_or_error.error());
         return nullptr;
     }
-    auto file = file_or_error.value();
-    if (!file->open(Core::OpenMode::ReadOnly)) {
-        dbgln("Could not open file");
+    auto font = load_from_memory(file_or_error.value()->bytes(), index);
+    if (!font)
         return nullptr;
-    }
-    auto buffer = file->read_all();
-    return load_from_memory(buffer, index);
+    font->m_mapped_file = file_or_error.release_value();
+    return font;
 }
 
-RefPtr<Font> Font::load_from_memory(ByteBuffer& buffer, unsigned index)
+RefPtr<Font> Font::load_from_memory(ReadonlyBytes buffer, unsigned index)
 {
     if (buffer.size() < 4) {
         dbgln("Font file too small");
@@ -235,7 +233,7 @@ RefPtr<Font> Font::load_from_memory(ByteBuffer& buffer, unsigned index)
             return nullptr;
         }
         u32 offset = be_u32(buffer.offset_pointer((u32)Sizes::TTCHeaderV1 + sizeof(u32) * index));
-        return load_from_offset(move(buffer), offset);
+        return load_from_offset(buffer, offset);
     }
     if (tag == tag_from_str("OTTO")) {
         dbgln("CFF fonts not supported yet");
@@ -245,11 +243,11 @@ RefPtr<Font> Font::load_from_memory(ByteBuffer& buffer, unsigned index)
         dbgln("Not a valid font");
         return nullptr;
     }
-    return load_from_offset(move(buffer), 0);
+    return load_from_offset(buffer, 0);
 }
 
 // FIXME: "loca" and "glyf" are not available for CFF fonts.
-RefPtr<Font> Font::load_from_offset(ByteBuffer&& buffer, u32 offset)
+RefPtr<Font> Font::load_from_offset(ReadonlyBytes buffer, u32 offset)
 {
     if (Checked<u32>::addition_would_overflow(offset, (u32)Sizes::OffsetTable)) {
         dbgln("Invalid offset in font header");
@@ -389,7 +387,7 @@ RefPtr<Font> Font::load_from_offset(ByteBuffer&& buffer, u32 offset)
         }
     }
 
-    return adopt_ref(*new Font(move(buffer), move(head), move(name), move(hhea), move(maxp), move(hmtx), move(cmap), move(loca), move(glyf)));
+    return adopt_ref(*new Font(move(head), move(name), move(hhea), move(maxp), move(hmtx), move(cmap), move(loca), move(glyf)));
 }
 
 ScaledFontMetrics Font::metrics(float x_scale, float y_scale) const
@@ -8,6 +8,7 @@
 
 #include <AK/ByteBuffer.h>
 #include <AK/HashMap.h>
+#include <AK/MappedFile.h>
 #include <AK/Noncopyable.h>
 #include <AK/RefCounted.h>
 #include <AK/StringView.h>
@@ -47,7 +48,7 @@ class Font : public RefCounted<Font> {
 
 public:
     static RefPtr<Font> load_from_file(String path, unsigned index = 0);
-    static RefPtr<Font> load_from_memory(ByteBuffer&, unsigned index = 0);
+    static RefPtr<Font> load_from_memory(ReadonlyBytes, unsigned index = 0);
 
     ScaledFontMetrics metrics(float x_scale, float y_scale) const;
     ScaledGlyphMetrics glyph_metrics(u32 glyph_id, float x_scale, float y_scale) const;
@@ -72,10 +73,9 @@ private:
         TableRecord = 16,
     };
 
-    static RefPtr<Font> load_from_offset(ByteBuffer&&, unsigned index = 0);
-    Font(ByteBuffer&& buffer, Head&& head, Name&& name, Hhea&& hhea, Maxp&& maxp, Hmtx&& hmtx, Cmap&& cmap, Loca&& loca, Glyf&& glyf)
-        : m_buffer(move(buffer))
-        , m_head(move(head))
+    static RefPtr<Font> load_from_offset(ReadonlyBytes, unsigned index = 0);
+    Font(Head&& head, Name&& name, Hhea&& hhea, Maxp&& maxp, Hmtx&& hmtx, Cmap&& cmap, Loca&& loca, Glyf&& glyf)
+        : m_head(move(head))
         , m_name(move(name))
         , m_hhea(move(hhea))
         , m_maxp(move(maxp))
@@ -86,8 +86,11 @@ private:
     {
     }
 
-    // This owns the font data
-    ByteBuffer m_buffer;
+    // Keeps the font file mapping alive for the slices below. The mapping is
+    // read-only and inode-backed, so every process using this font shares the
+    // same physical pages instead of each keeping a private heap copy.
+    // Null when the font was loaded from caller-owned memory.
+    RefPtr<MappedFile> m_mapped_file;
     // These are stateful wrappers around non-owning slices
     Head m_head;
     Name m_name;
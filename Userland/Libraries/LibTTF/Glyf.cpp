@@ -192,10 +192,8 @@ Optional<Glyf::Glyph::ComponentIterator::Item> Glyf::Glyph::ComponentIterator::n
 Rasterizer::Rasterizer(Gfx::IntSize size)
     : m_size(size)
 {
+    // resize() value-initializes, so the accumulation buffer starts zeroed.
     m_data.resize(m_size.width() * m_size.height());
-    for (int i = 0; i < m_size.width() * m_size.height(); i++) {
-        m_data[i] = 0.0f;
-    }
 }
 
 void Rasterizer::draw_path(Gfx::Path& path)
@@ -208,20 +206,22 @@ void Rasterizer::draw_path(Gfx::Path& path)
 RefPtr<Gfx::Bitmap> Rasterizer::accumulate()
 {
     auto bitmap = Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, m_size);
-    Color base_color = Color::from_rgb(0xffffff);
+    if (!bitmap)
+        return nullptr;
+    constexpr u32 base_color = 0x00ffffff;
     for (int y = 0; y < m_size.height(); y++) {
-        float accumulator = 0.0;
+        auto* scanline = bitmap->scanline(y);
+        const float* accumulation_row = &m_data[y * m_size.width()];
+        float accumulator = 0.0f;
+        // Writing the pixel words directly keeps this tight loop free of
+        // per-pixel calls, so the compiler can vectorize it.
         for (int x = 0; x < m_size.width(); x++) {
-            accumulator += m_data[y * m_size.width() + x];
-            float value = accumulator;
-            if (value < 0.0f) {
-                value = -value;
-            }
-            if (value > 1.0f) {
-                value = 1.0;
-            }
+            accumulator += accumulation_row[x];
+            float value = fabsf(accumulator);
+            if (value > 1.0f)
+                value = 1.0f;
             u8 alpha = value * 255.0f;
-            bitmap->set_pixel(x, y, base_color.with_alpha(alpha));
+            scanline[x] = (alpha << 24) | base_color;
         }
     }
     return bitmap;
@@ -7,7 +7,11 @@
 
 #include <LibTest/Macros.h> // intentionally first -- we redefine VERIFY and friends in here
 
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/NumericLimits.h>
 #include <LibCore/ArgsParser.h>
+#include <LibCore/File.h>
 #include <LibTest/TestSuite.h>
 #include <stdlib.h>
 #include <sys/time.h>
@@ -16,6 +20,11 @@ namespace Test {
 
 TestSuite* TestSuite::s_global = nullptr;
 
+// Fast benchmarks are repeated until they have run for this long in total,
+// so that the reported average is taken over a meaningful amount of work.
+static constexpr u64 benchmark_repetition_time_ms = 500;
+static constexpr size_t max_benchmark_repetitions = 100;
+
 class TestElapsedTimer {
 public:
     TestElapsedTimer() { restart(); }
@@ -63,6 +72,7 @@ int TestSuite::main(const String& suite_name, int argc, char** argv)
     args_parser.add_option(do_tests_only, "Only run tests.", "tests", 0);
     args_parser.add_option(do_benchmarks_only, "Only run benchmarks.", "bench", 0);
     args_parser.add_option(do_list_cases, "List available test cases.", "list", 0);
+    args_parser.add_option(m_benchmark_results_path, "Write benchmark results to the given file as JSON.", "bench-json", 0, "path");
     args_parser.add_positional_argument(search_string, "Only run matching cases.", "pattern", Core::ArgsParser::Required::No);
     args_parser.parse(argc, argv);
 
@@ -108,22 +118,53 @@ int TestSuite::run(const NonnullRefPtrVector<TestCase>& tests)
     size_t benchmark_count = 0;
     TestElapsedTimer global_timer;
 
+    JsonArray benchmark_results;
+
     for (const auto& t : tests) {
         const auto test_type = t.is_benchmark() ? "benchmark" : "test";
 
         warnln("Running {} '{}'.", test_type, t.name());
         m_current_test_case_passed = true;
 
-        TestElapsedTimer timer;
-        t.func()();
-        const auto time = timer.elapsed_milliseconds();
-
-        dbgln("{} {} '{}' in {}ms", m_current_test_case_passed ? "Completed" : "Failed", test_type, t.name(), time);
-
         if (t.is_benchmark()) {
-            m_benchtime += time;
+            u64 total_time = 0;
+            u64 fastest_run = NumericLimits<u64>::max();
+            u64 slowest_run = 0;
+            size_t repetitions = 0;
+
+            do {
+                TestElapsedTimer timer;
+                t.func()();
+                const auto time = timer.elapsed_milliseconds();
+
+                total_time += time;
+                fastest_run = min(fastest_run, time);
+                slowest_run = max(slowest_run, time);
+                ++repetitions;
+            } while (m_current_test_case_passed && total_time < benchmark_repetition_time_ms && repetitions < max_benchmark_repetitions);
+
+            dbgln("{} benchmark '{}' in {}ms over {} runs (min {}ms, max {}ms, avg {}ms)",
+                m_current_test_case_passed ? "Completed" : "Failed",
+                t.name(), total_time, repetitions, fastest_run, slowest_run, total_time / repetitions);
+
+            JsonObject result;
+            result.set("name", t.name());
+            result.set("repetitions", (u64)repetitions);
+            result.set("total_ms", total_time);
+            result.set("average_ms", total_time / repetitions);
+            result.set("min_ms", fastest_run);
+            result.set("max_ms", slowest_run);
+            benchmark_results.append(move(result));
+
+            m_benchtime += total_time;
             benchmark_count++;
         } else {
+            TestElapsedTimer timer;
+            t.func()();
+            const auto time = timer.elapsed_milliseconds();
+
+            dbgln("{} {} '{}' in {}ms", m_current_test_case_passed ? "Completed" : "Failed", test_type, t.name(), time);
+
             m_testtime += time;
             test_count++;
         }
@@ -133,6 +174,14 @@ int TestSuite::run(const NonnullRefPtrVector<TestCase>& tests)
         }
     }
 
+    if (!m_benchmark_results_path.is_empty()) {
+        auto file_or_error = Core::File::open(m_benchmark_results_path, (Core::OpenMode)(Core::OpenMode::WriteOnly | Core::OpenMode::Truncate));
+        if (file_or_error.is_error())
+            warnln("Failed to open {} for benchmark results: {}", m_benchmark_results_path, file_or_error.error());
+        else
+            file_or_error.value()->write(benchmark_results.to_string());
+    }
+
     dbgln("Finished {} tests and {} benchmarks in {}ms ({}ms tests, {}ms benchmarks, {}ms other).",
         test_count,
         benchmark_count,
@@ -49,6 +49,7 @@ private:
     u64 m_testtime = 0;
     u64 m_benchtime = 0;
     String m_suite_name;
+    String m_benchmark_results_path;
     bool m_current_test_case_passed = true;
 };
 
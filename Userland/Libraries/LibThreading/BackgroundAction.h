@@ -9,32 +9,15 @@
 #include <AK/Function.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/Optional.h>
-#include <AK/Queue.h>
 #include <LibCore/Event.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/Object.h>
-#include <LibThreading/Lock.h>
-#include <LibThreading/Thread.h>
+#include <LibThreading/ThreadPool.h>
 
 namespace Threading {
 
 template<typename Result>
-class BackgroundAction;
-
-class BackgroundActionBase {
-    template<typename Result>
-    friend class BackgroundAction;
-
-private:
-    BackgroundActionBase() { }
-
-    static Lockable<Queue<Function<void()>>>& all_actions();
-    static Thread& background_thread();
-};
-
-template<typename Result>
-class BackgroundAction final : public Core::Object
-    , private BackgroundActionBase {
+class BackgroundAction final : public Core::Object {
     C_OBJECT(BackgroundAction);
 
 public:
@@ -49,22 +32,19 @@ public:
 
 private:
     BackgroundAction(Function<Result()> action, Function<void(Result)> on_complete)
-        : Core::Object(&background_thread())
-        , m_action(move(action))
+        : m_action(move(action))
         , m_on_complete(move(on_complete))
     {
-        Locker locker(all_actions().lock());
-
-        all_actions().resource().enqueue([this] {
+        // The work item keeps us alive via 'protector'. If there's an
+        // on_complete handler, the ref migrates into the deferred invocation
+        // so we survive until the completion has run on the event loop.
+        ThreadPool::the().submit([this, protector = NonnullRefPtr<BackgroundAction>(*this)]() mutable {
             m_result = m_action();
             if (m_on_complete) {
-                Core::EventLoop::current().post_event(*this, make<Core::DeferredInvocationEvent>([this](auto&) {
+                Core::EventLoop::current().post_event(*this, make<Core::DeferredInvocationEvent>([this, protector = move(protector)](auto&) {
                     m_on_complete(m_result.release_value());
-                    this->remove_from_parent();
                 }));
                 Core::EventLoop::wake();
-            } else {
-                this->remove_from_parent();
             }
         });
     }
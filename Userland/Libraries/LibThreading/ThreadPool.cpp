@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibThreading/ThreadPool.h>
+#include <unistd.h>
+
+namespace Threading {
+
+ThreadPool& ThreadPool::the()
+{
+    static ThreadPool* s_the;
+    if (!s_the)
+        s_the = new ThreadPool;
+    return *s_the;
+}
+
+ThreadPool::ThreadPool(size_t worker_count)
+{
+    pthread_mutex_init(&m_wake_mutex, nullptr);
+    pthread_cond_init(&m_wake_condition, nullptr);
+
+    if (worker_count == 0) {
+        auto processor_count = sysconf(_SC_NPROCESSORS_ONLN);
+        worker_count = processor_count > 0 ? static_cast<size_t>(processor_count) : 1;
+    }
+
+    for (size_t i = 0; i < worker_count; ++i) {
+        auto worker = make<Worker>();
+        worker->index = i;
+        m_workers.append(move(worker));
+    }
+
+    // Only start the threads once every deque exists; workers inspect each
+    // other's deques when stealing.
+    for (size_t i = 0; i < worker_count; ++i) {
+        auto& worker = m_workers[i];
+        worker.thread = Thread::construct([this, &worker]() -> intptr_t { return worker_loop(worker); }, "ThreadPool");
+        worker.thread->start();
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    pthread_mutex_lock(&m_wake_mutex);
+    m_shutting_down = true;
+    pthread_cond_broadcast(&m_wake_condition);
+    pthread_mutex_unlock(&m_wake_mutex);
+
+    for (auto& worker : m_workers) {
+        if (worker.thread)
+            (void)worker.thread->join();
+    }
+
+    pthread_cond_destroy(&m_wake_condition);
+    pthread_mutex_destroy(&m_wake_mutex);
+}
+
+NonnullRefPtr<ThreadPool::Task> ThreadPool::submit(Function<void()> work)
+{
+    auto task = adopt_ref(*new Task(move(work)));
+
+    auto& worker = m_workers[m_next_worker.fetch_add(1, AK::memory_order_relaxed) % m_workers.size()];
+    {
+        Locker locker(worker.queue_lock);
+        worker.queue.append(task);
+    }
+
+    pthread_mutex_lock(&m_wake_mutex);
+    ++m_queued_task_count;
+    pthread_cond_signal(&m_wake_condition);
+    pthread_mutex_unlock(&m_wake_mutex);
+
+    return task;
+}
+
+RefPtr<ThreadPool::Task> ThreadPool::try_take_task(Worker& worker)
+{
+    RefPtr<Task> task;
+
+    {
+        Locker locker(worker.queue_lock);
+        if (!worker.queue.is_empty())
+            task = worker.queue.take_last();
+    }
+
+    if (!task) {
+        // Nothing of our own; go rob a neighbour of their oldest task.
+        for (size_t i = 1; i < m_workers.size() && !task; ++i) {
+            auto& victim = m_workers[(worker.index + i) % m_workers.size()];
+            Locker locker(victim.queue_lock);
+            if (!victim.queue.is_empty())
+                task = victim.queue.take_first();
+        }
+    }
+
+    if (task) {
+        pthread_mutex_lock(&m_wake_mutex);
+        VERIFY(m_queued_task_count > 0);
+        --m_queued_task_count;
+        pthread_mutex_unlock(&m_wake_mutex);
+    }
+    return task;
+}
+
+intptr_t ThreadPool::worker_loop(Worker& worker)
+{
+    for (;;) {
+        auto task = try_take_task(worker);
+        if (task) {
+            task->run();
+            continue;
+        }
+
+        pthread_mutex_lock(&m_wake_mutex);
+        while (m_queued_task_count == 0 && !m_shutting_down)
+            pthread_cond_wait(&m_wake_condition, &m_wake_mutex);
+        bool shutting_down = m_shutting_down;
+        pthread_mutex_unlock(&m_wake_mutex);
+
+        if (shutting_down) {
+            // Finish whatever is still queued before exiting.
+            while ((task = try_take_task(worker)))
+                task->run();
+            return 0;
+        }
+    }
+}
+
+ThreadPool::Task::Task(Function<void()> work)
+    : m_work(move(work))
+{
+    pthread_mutex_init(&m_mutex, nullptr);
+    pthread_cond_init(&m_condition, nullptr);
+}
+
+ThreadPool::Task::~Task()
+{
+    pthread_cond_destroy(&m_condition);
+    pthread_mutex_destroy(&m_mutex);
+}
+
+void ThreadPool::Task::run()
+{
+    m_work();
+
+    pthread_mutex_lock(&m_mutex);
+    m_finished.store(true, AK::memory_order_release);
+    pthread_cond_broadcast(&m_condition);
+    pthread_mutex_unlock(&m_mutex);
+}
+
+void ThreadPool::Task::wait()
+{
+    pthread_mutex_lock(&m_mutex);
+    while (!m_finished.load(AK::memory_order_acquire))
+        pthread_cond_wait(&m_condition, &m_mutex);
+    pthread_mutex_unlock(&m_mutex);
+}
+
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Function.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtrVector.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/RefCounted.h>
+#include <AK/RefPtr.h>
+#include <AK/Vector.h>
+#include <LibThreading/Lock.h>
+#include <LibThreading/Thread.h>
+#include <pthread.h>
+
+namespace Threading {
+
+// A fixed-size pool of worker threads with a task deque per worker.
+// submit() distributes tasks round-robin. A worker drains its own deque in
+// LIFO order (the most recently queued task is the cache-hottest) and, once
+// that runs dry, steals the oldest task from a busy neighbour before going
+// to sleep.
+class ThreadPool {
+    AK_MAKE_NONCOPYABLE(ThreadPool);
+    AK_MAKE_NONMOVABLE(ThreadPool);
+
+public:
+    // A handle to a submitted task. Stays valid after completion, so you can
+    // hang on to it and wait() or poll is_finished() whenever convenient.
+    class Task : public RefCounted<Task> {
+    public:
+        ~Task();
+
+        bool is_finished() const { return m_finished.load(AK::memory_order_acquire); }
+        void wait();
+
+    private:
+        friend class ThreadPool;
+
+        explicit Task(Function<void()> work);
+        void run();
+
+        Function<void()> m_work;
+        pthread_mutex_t m_mutex;
+        pthread_cond_t m_condition;
+        Atomic<bool> m_finished { false };
+    };
+
+    // The process-wide shared pool. Created on first use with one worker per
+    // online processor, and intentionally never destroyed.
+    static ThreadPool& the();
+
+    // Passing 0 creates one worker per online processor.
+    explicit ThreadPool(size_t worker_count = 0);
+    ~ThreadPool();
+
+    NonnullRefPtr<Task> submit(Function<void()>);
+
+    size_t worker_count() const { return m_workers.size(); }
+
+private:
+    struct Worker {
+        size_t index { 0 };
+        RefPtr<Thread> thread;
+        Lock queue_lock;
+        Vector<NonnullRefPtr<Task>> queue;
+    };
+
+    intptr_t worker_loop(Worker&);
+    RefPtr<Task> try_take_task(Worker&);
+
+    NonnullOwnPtrVector<Worker> m_workers;
+    pthread_mutex_t m_wake_mutex;
+    pthread_cond_t m_wake_condition;
+    size_t m_queued_task_count { 0 }; // Guarded by m_wake_mutex
+    bool m_shutting_down { false };   // Guarded by m_wake_mutex
+    Atomic<size_t> m_next_worker { 0 };
+};
+
+}
@@ -8,6 +8,15 @@
 
 namespace VT {
 
+static const Attribute s_default_attribute;
+
+const Attribute& Line::attribute_at(size_t index) const
+{
+    if (index >= m_cells.size())
+        return s_default_attribute;
+    return m_cells[index].attribute;
+}
+
 Line::Line(size_t length)
 {
     set_length(length);
@@ -40,6 +49,46 @@ void Line::clear(const Attribute& attribute)
     }
 }
 
+void Line::compact()
+{
+    size_t new_length = m_cells.size();
+    while (new_length > 0) {
+        auto& cell = m_cells[new_length - 1];
+        if (cell.code_point != ' ' || cell.attribute != s_default_attribute)
+            break;
+#ifndef KERNEL
+        if (!cell.attribute.href_id.is_null())
+            break;
+#endif
+        --new_length;
+    }
+    if (new_length == m_cells.size())
+        return;
+
+    // If the remaining cells share a single non-default background color,
+    // keep the blank tail: the paint code fills such rows edge to edge with
+    // that color, and trimming would change what the tail looks like.
+    if (new_length > 0) {
+        auto background_color = m_cells[0].attribute.effective_background_color();
+        bool has_uniform_background = true;
+        for (size_t i = 1; i < new_length; ++i) {
+            if (m_cells[i].attribute.effective_background_color() != background_color) {
+                has_uniform_background = false;
+                break;
+            }
+        }
+        if (has_uniform_background && background_color != Attribute::default_background_color)
+            return;
+    }
+
+    // Move into a right-sized vector so the memory is actually returned.
+    Vector<Cell> new_cells;
+    new_cells.ensure_capacity(new_length);
+    for (size_t i = 0; i < new_length; ++i)
+        new_cells.unchecked_append(move(m_cells[i]));
+    m_cells = move(new_cells);
+}
+
 bool Line::has_only_one_background_color() const
 {
     if (!length())
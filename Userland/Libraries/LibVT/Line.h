@@ -27,7 +27,10 @@ public:
         Attribute attribute;
     };
 
-    const Attribute& attribute_at(size_t index) const { return m_cells[index].attribute; }
+    // Reading past the end of a line is allowed and yields blank default
+    // cells; compacted history lines (and history lines from before a
+    // resize) may be shorter than the current terminal width.
+    const Attribute& attribute_at(size_t index) const;
     Attribute& attribute_at(size_t index) { return m_cells[index].attribute; }
 
     Cell& cell_at(size_t index) { return m_cells[index]; }
@@ -36,11 +39,17 @@ public:
     void clear(const Attribute&);
     bool has_only_one_background_color() const;
 
+    // Drops the trailing run of blank cells and returns their memory.
+    // Only safe on lines that will never be written to again (history).
+    void compact();
+
     size_t length() const { return m_cells.size(); }
     void set_length(size_t);
 
     u32 code_point(size_t index) const
     {
+        if (index >= m_cells.size())
+            return ' ';
         return m_cells[index].code_point;
     }
 
@@ -344,6 +344,10 @@ protected:
         if (max_history_size() == 0)
             return;
 
+        // History lines are never written to again, so keep them compact;
+        // most lines are mostly trailing blanks.
+        line->compact();
+
         if (m_history.size() < max_history_size()) {
             VERIFY(m_history_start == 0);
             m_history.append(move(line));
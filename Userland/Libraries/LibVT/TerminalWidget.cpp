@@ -70,6 +70,16 @@ void TerminalWidget::set_pty_master_fd(int fd)
         }
         for (ssize_t i = 0; i < nread; ++i)
             m_terminal.on_input(buffer[i]);
+
+        // When output is arriving at full tilt (think 'cat'-ing a large file),
+        // don't repaint for every chunk we read() - cap repaints at roughly 60
+        // per second and let dirty lines pile up in between.
+        constexpr int minimum_time_between_flushes_ms = 16;
+        if (m_last_flush_timer.is_valid() && m_last_flush_timer.elapsed() < minimum_time_between_flushes_ms) {
+            if (!m_flush_pending_timer->is_active())
+                m_flush_pending_timer->start(minimum_time_between_flushes_ms - m_last_flush_timer.elapsed());
+            return;
+        }
         flush_dirty_lines();
     };
 }
@@ -102,6 +112,12 @@ TerminalWidget::TerminalWidget(int ptm_fd, bool automatic_size_policy, RefPtr<Co
         update_cursor();
     };
 
+    m_flush_pending_timer = add<Core::Timer>();
+    m_flush_pending_timer->set_single_shot(true);
+    m_flush_pending_timer->on_timeout = [this] {
+        flush_dirty_lines();
+    };
+
     m_auto_scroll_timer->set_interval(50);
     m_auto_scroll_timer->on_timeout = [this] {
         if (m_auto_scroll_direction != AutoScrollDirection::None) {
@@ -293,7 +309,7 @@ void TerminalWidget::paint_event(GUI::PaintEvent& event)
     Vector<Gfx::IntRect> hovered_href_rects;
     if (!m_hovered_href_id.is_null()) {
         for (u16 visual_row = 0; visual_row < m_terminal.rows(); ++visual_row) {
-            auto& line = m_terminal.line(first_row_from_history + visual_row);
+            const auto& line = m_terminal.line(first_row_from_history + visual_row);
             for (size_t column = 0; column < line.length(); ++column) {
                 if (m_hovered_href_id == line.attribute_at(column).href_id) {
                     bool merged_with_existing_rect = false;
@@ -315,9 +331,9 @@ void TerminalWidget::paint_event(GUI::PaintEvent& event)
     // Pass: Paint background & text decorations.
     for (u16 visual_row = 0; visual_row < m_terminal.rows(); ++visual_row) {
         auto row_rect = this->row_rect(visual_row);
-        if (!event.rect().contains(row_rect))
+        if (!event.rect().intersects(row_rect))
             continue;
-        auto& line = m_terminal.line(first_row_from_history + visual_row);
+        const auto& line = m_terminal.line(first_row_from_history + visual_row);
         bool has_only_one_background_color = line.has_only_one_background_color();
         if (visual_beep_active)
             painter.clear_rect(row_rect, Color::Red);
@@ -387,9 +403,9 @@ void TerminalWidget::paint_event(GUI::PaintEvent& event)
     // Pass: Paint foreground (text).
     for (u16 visual_row = 0; visual_row < m_terminal.rows(); ++visual_row) {
         auto row_rect = this->row_rect(visual_row);
-        if (!event.rect().contains(row_rect))
+        if (!event.rect().intersects(row_rect))
             continue;
-        auto& line = m_terminal.line(first_row_from_history + visual_row);
+        const auto& line = m_terminal.line(first_row_from_history + visual_row);
         for (size_t column = 0; column < line.length(); ++column) {
             auto attribute = line.attribute_at(column);
             bool should_reverse_fill_for_cursor_or_selection = m_cursor_blink_state
@@ -420,7 +436,7 @@ void TerminalWidget::paint_event(GUI::PaintEvent& event)
 
     // Draw cursor.
     if (m_cursor_blink_state && row_with_cursor < m_terminal.rows()) {
-        auto& cursor_line = m_terminal.line(first_row_from_history + row_with_cursor);
+        const auto& cursor_line = m_terminal.line(first_row_from_history + row_with_cursor);
         if (m_terminal.cursor_row() >= (m_terminal.rows() - rows_from_history))
             return;
 
@@ -474,20 +490,31 @@ void TerminalWidget::invalidate_cursor()
 
 void TerminalWidget::flush_dirty_lines()
 {
+    m_flush_pending_timer->stop();
+    m_last_flush_timer.start();
+
     // FIXME: Update smarter when scrolled
     if (m_terminal.m_need_full_flush || m_scrollbar->value() != m_scrollbar->max()) {
         update();
         m_terminal.m_need_full_flush = false;
         return;
     }
-    Gfx::IntRect rect;
+    // Invalidate each contiguous run of dirty rows separately, so output on
+    // the bottom row doesn't drag every (unchanged) row between it and, say,
+    // a blinking cursor near the top into the repaint.
+    Gfx::IntRect dirty_rect;
     for (int i = 0; i < m_terminal.rows(); ++i) {
-        if (m_terminal.visible_line(i).is_dirty()) {
-            rect = rect.united(row_rect(i));
-            m_terminal.visible_line(i).set_dirty(false);
+        auto& line = m_terminal.visible_line(i);
+        if (line.is_dirty()) {
+            line.set_dirty(false);
+            dirty_rect = dirty_rect.united(row_rect(i));
+        } else if (!dirty_rect.is_empty()) {
+            update(dirty_rect);
+            dirty_rect = {};
         }
     }
-    update(rect);
+    if (!dirty_rect.is_empty())
+        update(dirty_rect);
 }
 
 void TerminalWidget::resize_event(GUI::ResizeEvent& event)
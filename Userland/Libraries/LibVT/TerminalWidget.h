@@ -189,6 +189,7 @@ private:
     RefPtr<Core::Timer> m_cursor_blink_timer;
     RefPtr<Core::Timer> m_visual_beep_timer;
     RefPtr<Core::Timer> m_auto_scroll_timer;
+    RefPtr<Core::Timer> m_flush_pending_timer;
     RefPtr<Core::ConfigFile> m_config;
 
     RefPtr<GUI::Scrollbar> m_scrollbar;
@@ -201,6 +202,7 @@ private:
     RefPtr<GUI::Menu> m_context_menu_for_hyperlink;
 
     Core::ElapsedTimer m_triple_click_timer;
+    Core::ElapsedTimer m_last_flush_timer;
 
     Gfx::IntPoint m_left_mousedown_position;
 };
@@ -412,8 +412,15 @@ private:
 
 class Stack {
 public:
-    using EntryType = Variant<NonnullOwnPtr<Value>, NonnullOwnPtr<Label>, NonnullOwnPtr<Frame>>;
-    Stack() = default;
+    // Values and labels are stored inline; boxing them would cost a heap
+    // allocation on every push, and the interpreter pushes on nearly every
+    // instruction. Frames are rare (one per call) and non-copyable, so they
+    // stay boxed.
+    using EntryType = Variant<Value, Label, NonnullOwnPtr<Frame>>;
+    Stack()
+    {
+        m_data.ensure_capacity(64);
+    }
 
     [[nodiscard]] bool is_empty() const { return m_data.is_empty(); }
     void push(EntryType entry) { m_data.append(move(entry)); }
@@ -24,7 +24,7 @@ public:
     {
         m_current_frame = frame.ptr();
         m_stack.push(move(frame));
-        m_stack.push(make<Label>(m_current_frame->arity(), m_current_frame->expression().instructions().size() - 1));
+        m_stack.push(Label(m_current_frame->arity(), m_current_frame->expression().instructions().size() - 1));
     }
     auto& frame() const { return m_current_frame; }
     auto& frame() { return m_current_frame; }
@@ -49,7 +49,7 @@ void Interpreter::branch_to_label(Configuration& configuration, LabelIndex index
 
     for (; !configuration.stack().is_empty();) {
         auto& entry = configuration.stack().peek();
-        if (entry.has<NonnullOwnPtr<Label>>()) {
+        if (entry.has<Label>()) {
             if (drop_count-- == 0)
                 break;
         }
@@ -58,7 +58,7 @@ void Interpreter::branch_to_label(Configuration& configuration, LabelIndex index
 
     // Push results in reverse
     for (size_t i = results.size(); i > 0; --i)
-        configuration.stack().push(move(static_cast<Vector<NonnullOwnPtr<Value>>&>(results)[i - 1]));
+        configuration.stack().push(move(results[i - 1]));
 
     configuration.ip() = label->continuation();
 }
@@ -72,15 +72,17 @@ ReadonlyBytes Interpreter::load_from_memory(Configuration& configuration, const
         return {};
     }
     auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
-    auto base = configuration.stack().pop().get<NonnullOwnPtr<Value>>()->to<i32>();
+    auto base = configuration.stack().pop().get<Value>().to<i32>();
     if (!base.has_value()) {
         m_do_trap = true;
         return {};
     }
-    auto instance_address = base.value() + static_cast<i64>(arg.offset);
-    if (instance_address < 0 || static_cast<u64>(instance_address + size) > memory->size()) {
+    // Addresses are unsigned in wasm, so a single unsigned comparison against
+    // the memory size covers both the negative and the past-the-end case.
+    auto instance_address = static_cast<u64>(bit_cast<u32>(base.value())) + arg.offset;
+    if (instance_address + size > memory->size()) {
         m_do_trap = true;
-        dbgln("LibWasm: Memory access out of bounds (expected 0 > {} and {} > {})", instance_address, instance_address + size, memory->size());
+        dbgln("LibWasm: Memory access out of bounds (expected {} + {} <= {})", instance_address, size, memory->size());
         return {};
     }
     dbgln_if(WASM_TRACE_DEBUG, "load({} : {}) -> stack", instance_address, size);
@@ -93,12 +95,12 @@ void Interpreter::store_to_memory(Configuration& configuration, const Instructio
     auto memory = configuration.store().get(address);
     TRAP_IF_NOT(memory);
     auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
-    auto base = configuration.stack().pop().get<NonnullOwnPtr<Value>>()->to<i32>();
+    auto base = configuration.stack().pop().get<Value>().to<i32>();
     TRAP_IF_NOT(base.has_value());
-    auto instance_address = base.value() + static_cast<i64>(arg.offset);
-    if (instance_address < 0 || static_cast<u64>(instance_address + data.size()) > memory->size()) {
+    auto instance_address = static_cast<u64>(bit_cast<u32>(base.value())) + arg.offset;
+    if (instance_address + data.size() > memory->size()) {
         m_do_trap = true;
-        dbgln("LibWasm: Memory access out of bounds (expected 0 > {} and {} > {})", instance_address, instance_address + data.size(), memory->size());
+        dbgln("LibWasm: Memory access out of bounds (expected {} + {} <= {})", instance_address, data.size(), memory->size());
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "tempoaray({}b) -> store({})", data.size(), instance_address);
@@ -115,7 +117,7 @@ void Interpreter::call_address(Configuration& configuration, FunctionAddress add
     Vector<Value> args;
     args.ensure_capacity(type->parameters().size());
     for (size_t i = 0; i < type->parameters().size(); ++i) {
-        args.prepend(move(*configuration.stack().pop().get<NonnullOwnPtr<Value>>()));
+        args.prepend(move(configuration.stack().pop().get<Value>()));
     }
     Configuration function_configuration { configuration.store() };
     function_configuration.depth() = configuration.depth() + 1;
@@ -125,26 +127,26 @@ void Interpreter::call_address(Configuration& configuration, FunctionAddress add
         return;
     }
     for (auto& entry : result.values())
-        configuration.stack().push(make<Value>(move(entry)));
+        configuration.stack().push(Value(move(entry)));
 }
 
 #define BINARY_NUMERIC_OPERATION(type, operator, cast, ...)                                       \
     do {                                                                                          \
-        auto rhs = configuration.stack().pop().get<NonnullOwnPtr<Value>>()->to<type>();           \
-        auto lhs = configuration.stack().pop().get<NonnullOwnPtr<Value>>()->to<type>();           \
+        auto rhs = configuration.stack().pop().get<Value>().to<type>();           \
+        auto lhs = configuration.stack().pop().get<Value>().to<type>();           \
         TRAP_IF_NOT(lhs.has_value());                                                             \
         TRAP_IF_NOT(rhs.has_value());                                                             \
         __VA_ARGS__;                                                                              \
         auto result = lhs.value() operator rhs.value();                                           \
         dbgln_if(WASM_TRACE_DEBUG, "{} {} {} = {}", lhs.value(), #operator, rhs.value(), result); \
-        configuration.stack().push(make<Value>(cast(result)));                                    \
+        configuration.stack().push(Value(cast(result)));                                    \
         return;                                                                                   \
     } while (false)
 
 #define OVF_CHECKED_BINARY_NUMERIC_OPERATION(type, operator, cast, ...)                            \
     do {                                                                                           \
-        auto rhs = configuration.stack().pop().get<NonnullOwnPtr<Value>>()->to<type>();            \
-        auto ulhs = configuration.stack().pop().get<NonnullOwnPtr<Value>>()->to<type>();           \
+        auto rhs = configuration.stack().pop().get<Value>().to<type>();            \
+        auto ulhs = configuration.stack().pop().get<Value>().to<type>();           \
         TRAP_IF_NOT(ulhs.has_value());                                                             \
         TRAP_IF_NOT(rhs.has_value());                                                              \
         dbgln_if(WASM_TRACE_DEBUG, "{} {} {} = ??", ulhs.value(), #operator, rhs.value());         \
@@ -154,29 +156,29 @@ void Interpreter::call_address(Configuration& configuration, FunctionAddress add
         TRAP_IF_NOT(!lhs.has_overflow());                                                          \
         auto result = lhs.value();                                                                 \
         dbgln_if(WASM_TRACE_DEBUG, "{} {} {} = {}", ulhs.value(), #operator, rhs.value(), result); \
-        configuration.stack().push(make<Value>(cast(result)));                                     \
+        configuration.stack().push(Value(cast(result)));                                     \
         return;                                                                                    \
     } while (false)
 
 #define BINARY_PREFIX_NUMERIC_OPERATION(type, operation, cast, ...)                                 \
     do {                                                                                            \
-        auto rhs = configuration.stack().pop().get<NonnullOwnPtr<Value>>()->to<type>();             \
-        auto lhs = configuration.stack().pop().get<NonnullOwnPtr<Value>>()->to<type>();             \
+        auto rhs = configuration.stack().pop().get<Value>().to<type>();             \
+        auto lhs = configuration.stack().pop().get<Value>().to<type>();             \
         TRAP_IF_NOT(lhs.has_value());                                                               \
         TRAP_IF_NOT(rhs.has_value());                                                               \
         auto result = operation(lhs.value(), rhs.value());                                          \
         dbgln_if(WASM_TRACE_DEBUG, "{}({} {}) = {}", #operation, lhs.value(), rhs.value(), result); \
-        configuration.stack().push(make<Value>(cast(result)));                                      \
+        configuration.stack().push(Value(cast(result)));                                      \
         return;                                                                                     \
     } while (false)
 
 #define UNARY_MAP(pop_type, operation, ...)                                                   \
     do {                                                                                      \
-        auto value = configuration.stack().pop().get<NonnullOwnPtr<Value>>()->to<pop_type>(); \
+        auto value = configuration.stack().pop().get<Value>().to<pop_type>(); \
         TRAP_IF_NOT(value.has_value());                                                       \
         auto result = operation(value.value());                                               \
         dbgln_if(WASM_TRACE_DEBUG, "map({}) {} = {}", #operation, value.value(), result);     \
-        configuration.stack().push(make<Value>(__VA_ARGS__(result)));                         \
+        configuration.stack().push(Value(__VA_ARGS__(result)));                         \
         return;                                                                               \
     } while (false)
 
@@ -188,15 +190,15 @@ void Interpreter::call_address(Configuration& configuration, FunctionAddress add
         auto slice = load_from_memory(configuration, instruction, sizeof(read_type));  \
         TRAP_IF_NOT(slice.size() == sizeof(read_type));                                \
         if constexpr (sizeof(read_type) == 1)                                          \
-            configuration.stack().push(make<Value>(static_cast<push_type>(slice[0]))); \
+            configuration.stack().push(Value(static_cast<push_type>(slice[0]))); \
         else                                                                           \
-            configuration.stack().push(make<Value>(read_value<push_type>(slice)));     \
+            configuration.stack().push(Value(read_value<push_type>(slice)));     \
         return;                                                                        \
     } while (false)
 
 #define POP_AND_STORE(pop_type, store_type)                                                                               \
     do {                                                                                                                  \
-        auto value = ConvertToRaw<pop_type> {}(*configuration.stack().pop().get<NonnullOwnPtr<Value>>()->to<pop_type>()); \
+        auto value = ConvertToRaw<pop_type> {}(*configuration.stack().pop().get<Value>().to<pop_type>()); \
         dbgln_if(WASM_TRACE_DEBUG, "stack({}) -> temporary({}b)", value, sizeof(store_type));                             \
         store_to_memory(configuration, instruction, { &value, sizeof(store_type) });                                      \
         return;                                                                                                           \
@@ -266,14 +268,15 @@ struct ConvertToRaw<double> {
     }
 };
 
-Vector<NonnullOwnPtr<Value>> Interpreter::pop_values(Configuration& configuration, size_t count)
+Vector<Value> Interpreter::pop_values(Configuration& configuration, size_t count)
 {
-    Vector<NonnullOwnPtr<Value>> results;
+    Vector<Value> results;
+    results.ensure_capacity(count);
     // Pop results in order
     for (size_t i = 0; i < count; ++i) {
         auto top_of_stack = configuration.stack().pop();
-        if (auto value = top_of_stack.get_pointer<NonnullOwnPtr<Value>>())
-            results.append(move(*value));
+        if (auto value = top_of_stack.get_pointer<Value>())
+            results.unchecked_append(move(*value));
         else
             trap_if_not(value);
     }
@@ -292,31 +295,31 @@ void Interpreter::interpret(Configuration& configuration, InstructionPointer& ip
     case Instructions::nop.value():
         return;
     case Instructions::local_get.value():
-        configuration.stack().push(make<Value>(configuration.frame()->locals()[instruction.arguments().get<LocalIndex>().value()]));
+        configuration.stack().push(Value(configuration.frame()->locals()[instruction.arguments().get<LocalIndex>().value()]));
         return;
     case Instructions::local_set.value(): {
         auto entry = configuration.stack().pop();
-        configuration.frame()->locals()[instruction.arguments().get<LocalIndex>().value()] = move(*entry.get<NonnullOwnPtr<Value>>());
+        configuration.frame()->locals()[instruction.arguments().get<LocalIndex>().value()] = move(entry.get<Value>());
         return;
     }
     case Instructions::i32_const.value():
-        configuration.stack().push(make<Value>(ValueType { ValueType::I32 }, static_cast<i64>(instruction.arguments().get<i32>())));
+        configuration.stack().push(Value(ValueType { ValueType::I32 }, static_cast<i64>(instruction.arguments().get<i32>())));
         return;
     case Instructions::i64_const.value():
-        configuration.stack().push(make<Value>(ValueType { ValueType::I64 }, instruction.arguments().get<i64>()));
+        configuration.stack().push(Value(ValueType { ValueType::I64 }, instruction.arguments().get<i64>()));
         return;
     case Instructions::f32_const.value():
-        configuration.stack().push(make<Value>(ValueType { ValueType::F32 }, static_cast<double>(instruction.arguments().get<float>())));
+        configuration.stack().push(Value(ValueType { ValueType::F32 }, static_cast<double>(instruction.arguments().get<float>())));
         return;
     case Instructions::f64_const.value():
-        configuration.stack().push(make<Value>(ValueType { ValueType::F64 }, instruction.arguments().get<double>()));
+        configuration.stack().push(Value(ValueType { ValueType::F64 }, instruction.arguments().get<double>()));
         return;
     case Instructions::block.value(): {
         size_t arity = 0;
         auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
         if (args.block_type.kind() != BlockType::Empty)
             arity = 1;
-        configuration.stack().push(make<Label>(arity, args.end_ip));
+        configuration.stack().push(Label(arity, args.end_ip));
         return;
     }
     case Instructions::loop.value(): {
@@ -324,7 +327,7 @@ void Interpreter::interpret(Configuration& configuration, InstructionPointer& ip
         auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
         if (args.block_type.kind() != BlockType::Empty)
             arity = 1;
-        configuration.stack().push(make<Label>(arity, ip.value()));
+        configuration.stack().push(Label(arity, ip.value()));
         return;
     }
     case Instructions::if_.value(): {
@@ -334,9 +337,9 @@ void Interpreter::interpret(Configuration& configuration, InstructionPointer& ip
             arity = 1;
 
         auto entry = configuration.stack().pop();
-        auto value = entry.get<NonnullOwnPtr<Value>>()->to<i32>();
+        auto value = entry.get<Value>().to<i32>();
         TRAP_IF_NOT(value.has_value());
-        configuration.stack().push(make<Label>(arity, args.end_ip));
+        configuration.stack().push(Label(arity, args.end_ip));
         if (value.value() == 0) {
             if (args.else_ip.has_value()) {
                 configuration.ip() = args.else_ip.value();
@@ -357,13 +360,13 @@ void Interpreter::interpret(Configuration& configuration, InstructionPointer& ip
         // drop all locals
         for (; !configuration.stack().is_empty();) {
             auto entry = configuration.stack().pop();
-            if (entry.has<NonnullOwnPtr<Label>>())
+            if (entry.has<Label>())
                 break;
         }
 
         // Push results in reverse
         for (size_t i = 1; i < results.size() + 1; ++i)
-            configuration.stack().push(move(static_cast<Vector<NonnullOwnPtr<Value>>&>(results)[results.size() - i]));
+            configuration.stack().push(move(results[results.size() - i]));
 
         if (instruction.opcode() == Instructions::structured_end)
             return;
@@ -379,22 +382,24 @@ void Interpreter::interpret(Configuration& configuration, InstructionPointer& ip
         for (size_t i = 0; i < frame.arity(); ++i)
             results.prepend(configuration.stack().pop());
         // drop all locals
-        OwnPtr<Label> last_label;
+        Label last_label { 0, 0 };
+        bool has_last_label = false;
         for (; !configuration.stack().is_empty();) {
             auto entry = configuration.stack().pop();
-            if (entry.has<NonnullOwnPtr<Label>>()) {
-                last_label = move(entry.get<NonnullOwnPtr<Label>>());
+            if (entry.has<Label>()) {
+                last_label = entry.get<Label>();
+                has_last_label = true;
                 continue;
             }
             if (entry.has<NonnullOwnPtr<Frame>>()) {
                 // Push the frame back
                 configuration.stack().push(move(entry));
                 // Push its label back (if there is one)
-                if (last_label)
-                    configuration.stack().push(last_label.release_nonnull());
+                if (has_last_label)
+                    configuration.stack().push(last_label);
                 break;
             }
-            last_label.clear();
+            has_last_label = false;
         }
         // Push the results back
         for (auto& result : results)
@@ -407,7 +412,7 @@ void Interpreter::interpret(Configuration& configuration, InstructionPointer& ip
     case Instructions::br.value():
         return branch_to_label(configuration, instruction.arguments().get<LabelIndex>());
     case Instructions::br_if.value(): {
-        if (configuration.stack().pop().get<NonnullOwnPtr<Value>>()->to<i32>().value_or(0) == 0)
+        if (configuration.stack().pop().get<Value>().to<i32>().value_or(0) == 0)
             return;
         return branch_to_label(configuration, instruction.arguments().get<LabelIndex>());
     }
@@ -424,7 +429,7 @@ void Interpreter::interpret(Configuration& configuration, InstructionPointer& ip
         auto& args = instruction.arguments().get<Instruction::IndirectCallArgs>();
         auto table_address = configuration.frame()->module().tables()[args.table.value()];
         auto table_instance = configuration.store().get(table_address);
-        auto index = configuration.stack().pop().get<NonnullOwnPtr<Value>>()->to<i32>();
+        auto index = configuration.stack().pop().get<Value>().to<i32>();
         TRAP_IF_NOT(index.has_value());
         if (index.value() < 0 || static_cast<size_t>(index.value()) >= table_instance->elements().size()) {
             dbgln("LibWasm: Element access out of bounds, expected {0} > 0 and {0} < {1}", index.value(), table_instance->elements().size());
@@ -489,7 +494,7 @@ void Interpreter::interpret(Configuration& configuration, InstructionPointer& ip
     case Instructions::i64_store32.value():
         POP_AND_STORE(i64, i32);
     case Instructions::local_tee.value(): {
-        auto value = *configuration.stack().peek().get<NonnullOwnPtr<Value>>();
+        auto value = configuration.stack().peek().get<Value>();
         auto local_index = instruction.arguments().get<LocalIndex>();
         TRAP_IF_NOT(configuration.frame()->locals().size() > local_index.value());
         dbgln_if(WASM_TRACE_DEBUG, "stack:peek -> locals({})", local_index.value());
@@ -502,14 +507,14 @@ void Interpreter::interpret(Configuration& configuration, InstructionPointer& ip
         auto address = configuration.frame()->module().globals()[global_index.value()];
         dbgln_if(WASM_TRACE_DEBUG, "global({}) -> stack", address.value());
         auto global = configuration.store().get(address);
-        configuration.stack().push(make<Value>(global->value()));
+        configuration.stack().push(Value(global->value()));
         return;
     }
     case Instructions::global_set.value(): {
         auto global_index = instruction.arguments().get<GlobalIndex>();
         TRAP_IF_NOT(configuration.frame()->module().globals().size() > global_index.value());
         auto address = configuration.frame()->module().globals()[global_index.value()];
-        auto value = *configuration.stack().pop().get<NonnullOwnPtr<Value>>();
+        auto value = configuration.stack().pop().get<Value>();
         dbgln_if(WASM_TRACE_DEBUG, "stack -> global({})", address.value());
         auto global = configuration.store().get(address);
         global->set_value(move(value));
@@ -520,20 +525,20 @@ void Interpreter::interpret(Configuration& configuration, InstructionPointer& ip
         auto instance = configuration.store().get(address);
         auto pages = instance->size() / Constants::page_size;
         dbgln_if(WASM_TRACE_DEBUG, "memory.size -> stack({})", pages);
-        configuration.stack().push(make<Value>((i32)pages));
+        configuration.stack().push(Value((i32)pages));
         return;
     }
     case Instructions::memory_grow.value(): {
         auto address = configuration.frame()->module().memories()[0];
         auto instance = configuration.store().get(address);
         i32 old_pages = instance->size() / Constants::page_size;
-        auto new_pages = configuration.stack().pop().get<NonnullOwnPtr<Value>>()->to<i32>();
+        auto new_pages = configuration.stack().pop().get<Value>().to<i32>();
         TRAP_IF_NOT(new_pages.has_value());
         dbgln_if(WASM_TRACE_DEBUG, "memory.grow({}), previously {} pages...", *new_pages, old_pages);
         if (instance->grow(new_pages.value() * Constants::page_size))
-            configuration.stack().push(make<Value>((i32)old_pages));
+            configuration.stack().push(Value((i32)old_pages));
         else
-            configuration.stack().push(make<Value>((i32)-1));
+            configuration.stack().push(Value((i32)-1));
         return;
     }
     case Instructions::table_get.value():
@@ -548,11 +553,11 @@ void Interpreter::interpret(Configuration& configuration, InstructionPointer& ip
     case Instructions::select.value():
     case Instructions::select_typed.value(): {
         // Note: The type seems to only be used for validation.
-        auto value = configuration.stack().pop().get<NonnullOwnPtr<Value>>()->to<i32>();
+        auto value = configuration.stack().pop().get<Value>().to<i32>();
         TRAP_IF_NOT(value.has_value());
         dbgln_if(WASM_TRACE_DEBUG, "select({})", value.value());
-        auto rhs = move(configuration.stack().pop().get<NonnullOwnPtr<Value>>());
-        auto lhs = move(configuration.stack().pop().get<NonnullOwnPtr<Value>>());
+        auto rhs = move(configuration.stack().pop().get<Value>());
+        auto lhs = move(configuration.stack().pop().get<Value>());
         configuration.stack().push(value.value() != 0 ? move(lhs) : move(rhs));
         return;
     }
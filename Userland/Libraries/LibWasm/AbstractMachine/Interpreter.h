@@ -20,7 +20,7 @@ private:
     ReadonlyBytes load_from_memory(Configuration&, const Instruction&, size_t);
     void store_to_memory(Configuration&, const Instruction&, ReadonlyBytes data);
     void call_address(Configuration&, FunctionAddress);
-    Vector<NonnullOwnPtr<Value>> pop_values(Configuration& configuration, size_t count);
+    Vector<Value> pop_values(Configuration& configuration, size_t count);
     bool trap_if_not(bool value)
     {
         if (!value)
@@ -14,6 +14,7 @@
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
 #include <LibWeb/Dump.h>
+#include <LibWeb/HTML/AttributeNames.h>
 #include <ctype.h>
 #include <stdio.h>
 
@@ -61,9 +62,43 @@ void StyleResolver::for_each_stylesheet(Callback callback) const
     }
 }
 
-Vector<MatchingRule> StyleResolver::collect_matching_rules(const DOM::Element& element) const
+static void add_to_ancestor_filter(u64& filter, u32 hash)
 {
-    Vector<MatchingRule> matching_rules;
+    filter |= 1ull << (hash % 64);
+    filter |= 1ull << ((hash >> 16) % 64);
+}
+
+static u64 required_ancestor_filter_for_selector(const Selector& selector)
+{
+    u64 filter = 0;
+    auto& complex_selectors = selector.complex_selectors();
+    for (size_t i = 1; i < complex_selectors.size(); ++i) {
+        auto relation = complex_selectors[i].relation;
+        if (relation != Selector::ComplexSelector::Relation::Descendant && relation != Selector::ComplexSelector::Relation::ImmediateChild)
+            continue;
+        // Compound selectors to the left of a descendant or child combinator
+        // have to match an ancestor of the element. (Sibling combinators only
+        // step sideways, so everything further left still sits on the
+        // ancestor chain.)
+        for (auto& simple_selector : complex_selectors[i - 1].compound_selector) {
+            switch (simple_selector.type) {
+            case Selector::SimpleSelector::Type::Id:
+            case Selector::SimpleSelector::Type::Class:
+            case Selector::SimpleSelector::Type::TagName:
+                add_to_ancestor_filter(filter, simple_selector.value.hash());
+                break;
+            default:
+                break;
+            }
+        }
+    }
+    return filter;
+}
+
+void StyleResolver::build_rule_cache() const
+{
+    m_rule_cache = make<RuleCache>();
+    m_rule_cache->generated_in_quirks_mode = document().in_quirks_mode();
 
     size_t style_sheet_index = 0;
     for_each_stylesheet([&](auto& sheet) {
@@ -73,16 +108,108 @@ Vector<MatchingRule> StyleResolver::collect_matching_rules(const DOM::Element& e
         static_cast<const CSSStyleSheet&>(sheet).for_each_effective_style_rule([&](auto& rule) {
             size_t selector_index = 0;
             for (auto& selector : rule.selectors()) {
-                if (SelectorEngine::matches(selector, element)) {
-                    matching_rules.append({ rule, style_sheet_index, rule_index, selector_index });
-                    break;
+                RuleCache::IndexedRule indexed_rule {
+                    { rule, style_sheet_index, rule_index, selector_index },
+                    required_ancestor_filter_for_selector(selector)
+                };
+
+                // Bucket by the most specific simple selector in the rightmost
+                // compound selector; anything unbucketable has to be checked
+                // against every element.
+                auto& rightmost_compound = selector.complex_selectors().last().compound_selector;
+                const Selector::SimpleSelector* bucket_selector = nullptr;
+                for (auto& simple_selector : rightmost_compound) {
+                    if (simple_selector.type == Selector::SimpleSelector::Type::Id) {
+                        bucket_selector = &simple_selector;
+                        break;
+                    }
+                    if (simple_selector.type == Selector::SimpleSelector::Type::Class) {
+                        if (!bucket_selector || bucket_selector->type == Selector::SimpleSelector::Type::TagName)
+                            bucket_selector = &simple_selector;
+                    } else if (simple_selector.type == Selector::SimpleSelector::Type::TagName) {
+                        if (!bucket_selector)
+                            bucket_selector = &simple_selector;
+                    }
                 }
+
+                if (!bucket_selector)
+                    m_rule_cache->other_rules.append(move(indexed_rule));
+                else if (bucket_selector->type == Selector::SimpleSelector::Type::Id)
+                    m_rule_cache->rules_by_id.ensure(bucket_selector->value).append(move(indexed_rule));
+                else if (bucket_selector->type == Selector::SimpleSelector::Type::Class)
+                    m_rule_cache->rules_by_class.ensure(bucket_selector->value).append(move(indexed_rule));
+                else
+                    m_rule_cache->rules_by_tag_name.ensure(bucket_selector->value).append(move(indexed_rule));
+
                 ++selector_index;
             }
             ++rule_index;
         });
         ++style_sheet_index;
     });
+}
+
+const StyleResolver::RuleCache& StyleResolver::rule_cache() const
+{
+    if (!m_rule_cache || m_rule_cache->generated_in_quirks_mode != document().in_quirks_mode())
+        build_rule_cache();
+    return *m_rule_cache;
+}
+
+void StyleResolver::invalidate_rule_cache()
+{
+    m_rule_cache = nullptr;
+}
+
+Vector<MatchingRule> StyleResolver::collect_matching_rules(const DOM::Element& element) const
+{
+    auto& rule_cache = this->rule_cache();
+
+    u64 ancestor_filter = 0;
+    for (auto* ancestor = element.parent_element(); ancestor; ancestor = ancestor->parent_element()) {
+        add_to_ancestor_filter(ancestor_filter, ancestor->local_name().hash());
+        auto ancestor_id = ancestor->attribute(HTML::AttributeNames::id);
+        if (!ancestor_id.is_null())
+            add_to_ancestor_filter(ancestor_filter, ancestor_id.hash());
+        for (auto& class_name : ancestor->class_names())
+            add_to_ancestor_filter(ancestor_filter, class_name.hash());
+    }
+
+    Vector<MatchingRule> matching_rules;
+    HashMap<u64, size_t> matching_rule_indices;
+
+    auto consider_rules = [&](const Vector<RuleCache::IndexedRule>& candidates) {
+        for (auto& candidate : candidates) {
+            if ((ancestor_filter & candidate.required_ancestor_filter) != candidate.required_ancestor_filter)
+                continue;
+            auto& selector = candidate.rule.rule->selectors()[candidate.rule.selector_index];
+            if (!SelectorEngine::matches(selector, element))
+                continue;
+            u64 rule_key = (static_cast<u64>(candidate.rule.style_sheet_index) << 32) | candidate.rule.rule_index;
+            if (auto existing_index = matching_rule_indices.get(rule_key); existing_index.has_value()) {
+                // Keep the earliest matching selector of each rule, like the
+                // unindexed loop over rule.selectors() did.
+                if (candidate.rule.selector_index < matching_rules[existing_index.value()].selector_index)
+                    matching_rules[existing_index.value()] = candidate.rule;
+            } else {
+                matching_rule_indices.set(rule_key, matching_rules.size());
+                matching_rules.append(candidate.rule);
+            }
+        }
+    };
+
+    auto id = element.attribute(HTML::AttributeNames::id);
+    if (!id.is_null()) {
+        if (auto it = rule_cache.rules_by_id.find(id); it != rule_cache.rules_by_id.end())
+            consider_rules(it->value);
+    }
+    for (auto& class_name : element.class_names()) {
+        if (auto it = rule_cache.rules_by_class.find(class_name); it != rule_cache.rules_by_class.end())
+            consider_rules(it->value);
+    }
+    if (auto it = rule_cache.rules_by_tag_name.find(element.local_name()); it != rule_cache.rules_by_tag_name.end())
+        consider_rules(it->value);
+    consider_rules(rule_cache.other_rules);
 
     return matching_rules;
 }
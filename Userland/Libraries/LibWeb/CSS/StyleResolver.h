@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/FlyString.h>
+#include <AK/HashMap.h>
 #include <AK/NonnullRefPtrVector.h>
 #include <AK/OwnPtr.h>
 #include <LibWeb/CSS/StyleProperties.h>
@@ -33,13 +35,37 @@ public:
     Vector<MatchingRule> collect_matching_rules(const DOM::Element&) const;
     void sort_matching_rules(Vector<MatchingRule>&) const;
 
+    void invalidate_rule_cache();
+
     static bool is_inherited_property(CSS::PropertyID);
 
 private:
     template<typename Callback>
     void for_each_stylesheet(Callback) const;
 
+    // Rules bucketed by the rightmost id/class/tag-name simple selector, so
+    // style resolution only has to consider rules that can possibly match a
+    // given element. See build_rule_cache().
+    struct RuleCache {
+        struct IndexedRule {
+            MatchingRule rule;
+            // Bloom-style filter bits for id/class/tag-name parts that some
+            // ancestor of a matching element has to carry; see
+            // collect_matching_rules().
+            u64 required_ancestor_filter { 0 };
+        };
+        HashMap<FlyString, Vector<IndexedRule>> rules_by_id;
+        HashMap<FlyString, Vector<IndexedRule>> rules_by_class;
+        HashMap<FlyString, Vector<IndexedRule>> rules_by_tag_name;
+        Vector<IndexedRule> other_rules;
+        bool generated_in_quirks_mode { false };
+    };
+
+    const RuleCache& rule_cache() const;
+    void build_rule_cache() const;
+
     DOM::Document& m_document;
+    mutable OwnPtr<RuleCache> m_rule_cache;
 };
 
 }
@@ -70,7 +70,12 @@ Document::Document(const URL& url)
     });
 
     m_forced_layout_timer = Core::Timer::create_single_shot(0, [this] {
-        force_layout();
+        if (m_needs_forced_layout) {
+            m_needs_forced_layout = false;
+            force_layout();
+        } else {
+            update_layout();
+        }
     });
 }
 
@@ -152,6 +157,16 @@ void Document::schedule_style_update()
 
 void Document::schedule_forced_layout()
 {
+    m_needs_forced_layout = true;
+    if (m_forced_layout_timer->is_active())
+        return;
+    m_forced_layout_timer->start();
+}
+
+void Document::schedule_relayout()
+{
+    // Unlike a forced layout, this keeps the existing layout tree and lets
+    // update_layout() reflow only the subtrees marked as needing it.
     if (m_forced_layout_timer->is_active())
         return;
     m_forced_layout_timer->start();
@@ -289,12 +304,18 @@ void Document::set_title(const String& title)
 void Document::attach_to_frame(Badge<Frame>, Frame& frame)
 {
     m_frame = frame;
+    if (m_window)
+        m_window->resume_timers();
     update_layout();
 }
 
 void Document::detach_from_frame(Badge<Frame>, Frame& frame)
 {
     VERIFY(&frame == m_frame);
+    // The document may live on in the frame's back/forward cache; it must
+    // not run timers while it's not the active document.
+    if (m_window)
+        m_window->pause_timers();
     tear_down_layout_tree();
     m_frame = nullptr;
 }
@@ -410,6 +431,12 @@ void Document::update_layout()
     Layout::BlockFormattingContext root_formatting_context(*m_layout_root, nullptr);
     root_formatting_context.run(*m_layout_root, Layout::LayoutMode::Default);
 
+    m_layout_root->for_each_in_inclusive_subtree([&](auto& node) {
+        node.set_needs_layout_update(false);
+        node.set_child_needs_layout_update(false);
+        return IterationDecision::Continue;
+    });
+
     m_layout_root->set_needs_display();
 
     if (frame()->is_main_frame()) {
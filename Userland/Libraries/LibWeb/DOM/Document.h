@@ -151,6 +151,7 @@ public:
 
     void schedule_style_update();
     void schedule_forced_layout();
+    void schedule_relayout();
 
     NonnullRefPtr<HTMLCollection> get_elements_by_name(String const&);
     NonnullRefPtr<HTMLCollection> get_elements_by_tag_name(FlyString const&);
@@ -310,6 +311,7 @@ private:
 
     RefPtr<Core::Timer> m_style_update_timer;
     RefPtr<Core::Timer> m_forced_layout_timer;
+    bool m_needs_forced_layout { false };
 
     String m_source;
 
@@ -216,7 +216,14 @@ void Element::recompute_style()
         return;
     layout_node()->apply_style(*new_specified_css_values);
     if (diff == StyleDifference::NeedsRelayout) {
-        document().schedule_forced_layout();
+        // Incremental relayout can move and resize boxes, but it cannot change
+        // the shape of the layout tree; 'display' changes need a full rebuild.
+        if (old_specified_css_values && old_specified_css_values->display() == new_specified_css_values->display()) {
+            layout_node()->set_needs_layout_update(true);
+            document().schedule_relayout();
+        } else {
+            document().schedule_forced_layout();
+        }
         return;
     }
     if (diff == StyleDifference::NeedsRepaint) {
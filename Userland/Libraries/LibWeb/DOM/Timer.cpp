@@ -37,4 +37,14 @@ Timer::~Timer()
     m_window.deallocate_timer_id({}, m_id);
 }
 
+void Timer::pause()
+{
+    m_timer->stop();
+}
+
+void Timer::resume()
+{
+    m_timer->start();
+}
+
 }
@@ -31,6 +31,9 @@ public:
 
     JS::Function& callback() { return *m_callback.cell(); }
 
+    void pause();
+    void resume();
+
 private:
     Timer(Window&, Type, int ms, JS::Function&);
 
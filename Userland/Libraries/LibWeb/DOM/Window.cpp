@@ -102,6 +102,18 @@ void Window::deallocate_timer_id(Badge<Timer>, i32 id)
     m_timer_id_allocator.deallocate(id);
 }
 
+void Window::pause_timers()
+{
+    for (auto& it : m_timers)
+        it.value->pause();
+}
+
+void Window::resume_timers()
+{
+    for (auto& it : m_timers)
+        it.value->resume();
+}
+
 void Window::clear_timeout(i32 timer_id)
 {
     m_timers.remove(timer_id);
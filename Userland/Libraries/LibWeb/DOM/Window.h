@@ -62,6 +62,10 @@ public:
     void deallocate_timer_id(Badge<Timer>, i32);
     void timer_did_fire(Badge<Timer>, Timer&);
 
+    // Used to freeze a document while it sits in the back/forward cache.
+    void pause_timers();
+    void resume_timers();
+
     HighResolutionTime::Performance& performance() { return *m_performance; }
 
     CSS::Screen& screen() { return *m_screen; }
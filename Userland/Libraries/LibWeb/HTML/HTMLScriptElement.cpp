@@ -6,6 +6,7 @@
 
 #include <AK/Debug.h>
 #include <AK/StringBuilder.h>
+#include <LibCore/EventLoop.h>
 #include <LibJS/Parser.h>
 #include <LibTextCodec/Decoder.h>
 #include <LibWeb/DOM/Document.h>
@@ -208,19 +209,38 @@ void HTMLScriptElement::prepare_script()
 
             // FIXME: This load should be made asynchronous and the parser should spin an event loop etc.
             m_script_filename = url.to_string();
-            ResourceLoader::the().load_sync(
-                request,
-                [this, url](auto data, auto&, auto) {
-                    if (data.is_null()) {
-                        dbgln("HTMLScriptElement: Failed to load {}", url);
-                        return;
-                    }
-                    m_script_source = String::copy(data);
+
+            // Fetch through the resource cache so that we pick up loads the
+            // speculative preload scanner has already started (and warm the
+            // cache for anyone fetching this URL after us). If the load is
+            // still in flight, spin a nested event loop until it finishes,
+            // like ResourceLoader::load_sync() would.
+            auto resource = ResourceLoader::the().load_resource(Resource::Type::Generic, request);
+            if (resource) {
+                if (!resource->is_loaded() && !resource->is_failed()) {
+                    // NOTE: SynchronousResourceWaiter quits the loop from its
+                    //       resource callbacks; wait() returns immediately if
+                    //       the resource has already finished.
+                    struct SynchronousResourceWaiter final : public ResourceClient {
+                        explicit SynchronousResourceWaiter(Resource& resource) { set_resource(&resource); }
+                        virtual void resource_did_load() override { loop.quit(0); }
+                        virtual void resource_did_fail() override { loop.quit(0); }
+                        Core::EventLoop loop;
+                    };
+                    SynchronousResourceWaiter waiter(*resource);
+                    if (!resource->is_loaded() && !resource->is_failed())
+                        waiter.loop.exec();
+                }
+                if (resource->is_loaded() && resource->has_encoded_data()) {
+                    m_script_source = String::copy(resource->encoded_data());
                     script_became_ready();
-                },
-                [this](auto&, auto) {
+                } else {
+                    dbgln("HTMLScriptElement: Failed to load {}", url);
                     m_failed_to_load = true;
-                });
+                }
+            } else {
+                m_failed_to_load = true;
+            }
         } else {
             TODO();
         }
@@ -24,6 +24,7 @@
 #include <LibWeb/HTML/Parser/HTMLDocumentParser.h>
 #include <LibWeb/HTML/Parser/HTMLEncodingDetection.h>
 #include <LibWeb/HTML/Parser/HTMLToken.h>
+#include <LibWeb/Loader/ResourceLoader.h>
 #include <LibWeb/Namespace.h>
 #include <LibWeb/SVG/TagNames.h>
 
@@ -115,11 +116,87 @@ HTMLDocumentParser::~HTMLDocumentParser()
     m_document->set_should_invalidate_styles_on_attribute_changes(true);
 }
 
+// The speculative preload scanner tokenizes the entire input before the tree
+// builder gets going and starts resource loads for the subresources it finds.
+// By the time the (synchronous) tree builder reaches an <img>, <script src>
+// or <link rel=stylesheet>, the fetch has usually been in flight for a while.
+// It only looks at tokens, so it cannot be confused by anything the tree
+// builder does, but it also cannot see URLs that scripts generate.
+static void speculatively_preload_resources(DOM::Document& document, const String& source, const String& encoding)
+{
+    HTMLTokenizer tokenizer(source, encoding);
+    for (;;) {
+        auto optional_token = tokenizer.next_token();
+        if (!optional_token.has_value() || optional_token.value().is_end_of_file())
+            break;
+        auto& token = optional_token.value();
+        if (!token.is_start_tag())
+            continue;
+
+        auto tag_name = token.tag_name();
+
+        // Move the tokenizer through raw text elements the way the tree
+        // builder would, so that the contents of <script> and <style> are not
+        // scanned as markup. (<noscript> is raw text since scripting is
+        // enabled; conveniently, this also skips its fallback content.)
+        if (tag_name.is_one_of(HTML::TagNames::title, HTML::TagNames::textarea))
+            tokenizer.switch_to(HTMLTokenizer::State::RCDATA);
+        else if (tag_name.is_one_of(HTML::TagNames::style, HTML::TagNames::xmp, HTML::TagNames::iframe, HTML::TagNames::noembed, HTML::TagNames::noframes, HTML::TagNames::noscript))
+            tokenizer.switch_to(HTMLTokenizer::State::RAWTEXT);
+        else if (tag_name == HTML::TagNames::script)
+            tokenizer.switch_to(HTMLTokenizer::State::ScriptData);
+
+        StringView url_attribute;
+        auto type = Resource::Type::Generic;
+        if (tag_name == HTML::TagNames::img) {
+            url_attribute = token.attribute(HTML::AttributeNames::src);
+            type = Resource::Type::Image;
+        } else if (tag_name == HTML::TagNames::script) {
+            url_attribute = token.attribute(HTML::AttributeNames::src);
+        } else if (tag_name == HTML::TagNames::link) {
+            // Mirror HTMLLinkElement: only non-alternate stylesheet links load their href.
+            bool is_stylesheet = false;
+            bool is_alternate = false;
+            bool is_dns_prefetch = false;
+            for (auto& part : token.attribute(HTML::AttributeNames::rel).split_view(' ')) {
+                if (part == "stylesheet")
+                    is_stylesheet = true;
+                else if (part == "alternate")
+                    is_alternate = true;
+                else if (part == "dns-prefetch" || part == "preconnect")
+                    is_dns_prefetch = true;
+            }
+            if (is_dns_prefetch) {
+                auto href = token.attribute(HTML::AttributeNames::href);
+                if (!href.is_empty())
+                    ResourceLoader::the().prefetch_dns(document.complete_url(href));
+                continue;
+            }
+            if (!is_stylesheet || is_alternate)
+                continue;
+            url_attribute = token.attribute(HTML::AttributeNames::href);
+        } else {
+            continue;
+        }
+
+        if (url_attribute.is_empty())
+            continue;
+        auto url = document.complete_url(url_attribute);
+        if (!url.is_valid() || url.protocol() == "data")
+            continue;
+
+        ResourceLoader::the().load_resource(type, LoadRequest::create_for_url_on_page(url, document.page()));
+    }
+}
+
 void HTMLDocumentParser::run(const URL& url)
 {
     m_document->set_url(url);
     m_document->set_source(m_tokenizer.source());
 
+    if (!m_parsing_fragment)
+        speculatively_preload_resources(*m_document, m_tokenizer.source(), "utf-8");
+
     for (;;) {
         auto optional_token = m_tokenizer.next_token();
         if (!optional_token.has_value())
@@ -334,10 +334,11 @@ void InProcessWebView::load_html(const StringView& html, const URL& url)
     page().main_frame().loader().load_html(html, url);
 }
 
-bool InProcessWebView::load(const URL& url)
+bool InProcessWebView::load(const URL& url, bool is_history_navigation)
 {
     set_override_cursor(Gfx::StandardCursor::None);
-    return page().main_frame().loader().load(url, FrameLoader::Type::Navigation);
+    auto type = is_history_navigation ? FrameLoader::Type::HistoryNavigation : FrameLoader::Type::Navigation;
+    return page().main_frame().loader().load(url, type);
 }
 
 const Layout::InitialContainingBlockBox* InProcessWebView::layout_root() const
@@ -36,7 +36,7 @@ public:
     Layout::InitialContainingBlockBox* layout_root();
 
     void reload();
-    bool load(const URL&);
+    bool load(const URL&, bool is_history_navigation = false);
 
     URL url() const;
 
@@ -374,6 +374,19 @@ void BlockFormattingContext::layout_inline_children(Box& box, LayoutMode layout_
     context.run(box, layout_mode);
 }
 
+static bool subtree_has_floating_boxes(Box& box)
+{
+    bool result = false;
+    box.for_each_in_inclusive_subtree_of_type<Box>([&](auto& descendant) {
+        if (descendant.is_floating()) {
+            result = true;
+            return IterationDecision::Break;
+        }
+        return IterationDecision::Continue;
+    });
+    return result;
+}
+
 void BlockFormattingContext::layout_block_level_children(Box& box, LayoutMode layout_mode)
 {
     float content_height = 0;
@@ -388,9 +401,35 @@ void BlockFormattingContext::layout_block_level_children(Box& box, LayoutMode la
             return IterationDecision::Continue;
         }
 
+        float old_width = child_box.width();
         compute_width(child_box);
-        layout_inside(child_box, layout_mode);
-        compute_height(child_box);
+
+        // If nothing in this subtree needs a layout update and the box is
+        // getting the same width as last time, its inner layout is still
+        // valid and we only have to place it at its (possibly shifted)
+        // position in the flow. Dependencies that reach across subtree
+        // boundaries disqualify the box: floats participate in this whole
+        // formatting context, percentage heights resolve against a possibly
+        // dirty containing block, and replaced/list-item boxes have layout
+        // side effects of their own.
+        bool can_reuse_inner_layout = layout_mode == LayoutMode::Default
+            && !box.needs_layout_update()
+            && !child_box.needs_layout_update()
+            && !child_box.child_needs_layout_update()
+            && child_box.width() == old_width
+            && !child_box.computed_values().height().is_percentage()
+            && !child_box.computed_values().min_height().is_percentage()
+            && !child_box.computed_values().max_height().is_percentage()
+            && m_left_floating_boxes.is_empty()
+            && m_right_floating_boxes.is_empty()
+            && !is<ReplacedBox>(child_box)
+            && !is<ListItemBox>(child_box)
+            && !subtree_has_floating_boxes(child_box);
+
+        if (!can_reuse_inner_layout) {
+            layout_inside(child_box, layout_mode);
+            compute_height(child_box);
+        }
 
         if (child_box.computed_values().position() == CSS::Position::Relative)
             compute_position(child_box);
@@ -67,6 +67,12 @@ bool FormattingContext::creates_block_formatting_context(const Box& box)
 
 void FormattingContext::layout_inside(Box& box, LayoutMode layout_mode)
 {
+    // Non-default modes are only used for measurement and leave intermediate
+    // geometry behind, so anything they touch has to be reflowed again on the
+    // next default pass instead of having its layout reused.
+    if (layout_mode != LayoutMode::Default)
+        box.set_needs_layout_update(true);
+
     if (creates_block_formatting_context(box)) {
         BlockFormattingContext context(box, this);
         context.run(box, layout_mode);
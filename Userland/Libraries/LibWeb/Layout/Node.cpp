@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BumpAllocator.h>
 #include <AK/Demangle.h>
 #include <LibGfx/FontDatabase.h>
 #include <LibGfx/Painter.h>
@@ -19,6 +20,43 @@
 
 namespace Web::Layout {
 
+// All layout nodes come from a process-wide arena with per-size free lists.
+// Layout trees get torn down and rebuilt wholesale, so freed nodes are almost
+// always recycled by the next (re)layout, and the arena itself is only
+// released when the process exits.
+struct FreeBlock {
+    FreeBlock* next { nullptr };
+};
+
+static constexpr size_t size_granularity = 16;
+static constexpr size_t free_list_count = 64;
+static FreeBlock* s_free_lists[free_list_count];
+
+void* Node::operator new(size_t size)
+{
+    static BumpAllocator allocator;
+    size_t bucket = (size + size_granularity - 1) / size_granularity;
+    if (bucket >= free_list_count)
+        return kmalloc(size);
+    if (auto* block = s_free_lists[bucket]) {
+        s_free_lists[bucket] = block->next;
+        return block;
+    }
+    return allocator.allocate(bucket * size_granularity);
+}
+
+void Node::operator delete(void* pointer, size_t size)
+{
+    size_t bucket = (size + size_granularity - 1) / size_granularity;
+    if (bucket >= free_list_count) {
+        kfree(pointer);
+        return;
+    }
+    auto* block = new (pointer) FreeBlock;
+    block->next = s_free_lists[bucket];
+    s_free_lists[bucket] = block;
+}
+
 Node::Node(DOM::Document& document, DOM::Node* node)
     : m_document(document)
     , m_dom_node(node)
@@ -33,6 +71,18 @@ Node::~Node()
         m_dom_node->set_layout_node({}, nullptr);
 }
 
+void Node::set_needs_layout_update(bool value)
+{
+    if (m_needs_layout_update == value)
+        return;
+    m_needs_layout_update = value;
+
+    if (m_needs_layout_update) {
+        for (auto* ancestor = parent(); ancestor; ancestor = ancestor->parent())
+            ancestor->m_child_needs_layout_update = true;
+    }
+}
+
 bool Node::can_contain_boxes_with_position_absolute() const
 {
     return computed_values().position() != CSS::Position::Static || is<InitialContainingBlockBox>(*this);
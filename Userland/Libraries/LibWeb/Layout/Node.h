@@ -56,6 +56,12 @@ class Node : public TreeNode<Node> {
 public:
     virtual ~Node();
 
+    // Layout nodes are created and destroyed in large batches whenever the
+    // layout tree is (re)built, so they all come from a shared arena instead
+    // of individual heap allocations.
+    void* operator new(size_t);
+    void operator delete(void*, size_t);
+
     virtual HitTestResult hit_test(const Gfx::IntPoint&, HitTestType) const;
 
     bool is_anonymous() const { return !m_dom_node; }
@@ -131,6 +137,15 @@ public:
     bool is_visible() const { return m_visible; }
     void set_visible(bool visible) { m_visible = visible; }
 
+    // Layout dirty bits, mirroring the DOM's style update bits: a node that
+    // needs a layout update gets reflowed on the next relayout, everything
+    // else may keep its last layout if its inputs haven't changed.
+    bool needs_layout_update() const { return m_needs_layout_update; }
+    void set_needs_layout_update(bool);
+
+    bool child_needs_layout_update() const { return m_child_needs_layout_update; }
+    void set_child_needs_layout_update(bool b) { m_child_needs_layout_update = b; }
+
     virtual void set_needs_display();
 
     bool children_are_inline() const { return m_children_are_inline; }
@@ -180,6 +195,8 @@ private:
     bool m_inline { false };
     bool m_has_style { false };
     bool m_visible { true };
+    bool m_needs_layout_update { true };
+    bool m_child_needs_layout_update { false };
     bool m_children_are_inline { false };
     SelectionState m_selection_state { SelectionState::None };
 };
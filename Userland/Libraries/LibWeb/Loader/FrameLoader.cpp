@@ -145,7 +145,7 @@ bool FrameLoader::load(const LoadRequest& request, Type type)
 
     set_resource(ResourceLoader::the().load_resource(Resource::Type::Generic, request));
 
-    if (type == Type::Navigation) {
+    if (type == Type::Navigation || type == Type::HistoryNavigation) {
         if (auto* page = frame().page())
             page->client().page_did_start_loading(url);
     }
@@ -188,6 +188,20 @@ bool FrameLoader::load(const URL& url, Type type)
         return false;
     }
 
+    if (type == Type::HistoryNavigation) {
+        if (auto document = frame().take_cached_document(url)) {
+            // Restoring from the back/forward cache: the document comes back
+            // with its DOM and script state intact and only needs a fresh
+            // layout, so skip the network and the parser entirely.
+            frame().set_document(document.ptr());
+            if (auto* page = frame().page()) {
+                page->client().page_did_start_loading(url);
+                page->client().page_did_finish_loading(url);
+            }
+            return true;
+        }
+    }
+
     auto request = LoadRequest::create_for_url_on_page(url, frame().page());
     return load(request, type);
 }
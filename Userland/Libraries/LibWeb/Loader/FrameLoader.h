@@ -19,6 +19,7 @@ class FrameLoader final
 public:
     enum class Type {
         Navigation,
+        HistoryNavigation,
         Reload,
         IFrame,
     };
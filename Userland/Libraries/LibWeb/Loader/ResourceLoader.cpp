@@ -198,6 +198,19 @@ void ResourceLoader::load(const URL& url, Function<void(ReadonlyBytes, const Has
     load(request, move(success_callback), move(error_callback));
 }
 
+void ResourceLoader::prefetch_dns(const URL& url)
+{
+    if (!url.is_valid() || url.host().is_empty())
+        return;
+    if (url.protocol() != "http" && url.protocol() != "https")
+        return;
+    // Each host only needs to be warmed up once; repeats would just be IPC noise.
+    if (m_prefetched_dns_hosts.contains(url.host()))
+        return;
+    m_prefetched_dns_hosts.set(url.host());
+    protocol_client().prefetch_dns(url);
+}
+
 bool ResourceLoader::is_port_blocked(int port)
 {
     int ports[] { 1, 7, 9, 11, 13, 15, 17, 19, 20, 21, 22, 23, 25, 37, 42,
@@ -74,10 +74,10 @@ void OutOfProcessWebView::create_client()
     client().async_update_screen_rect(GUI::Desktop::the().rect());
 }
 
-void OutOfProcessWebView::load(const URL& url)
+void OutOfProcessWebView::load(const URL& url, bool is_history_navigation)
 {
     m_url = url;
-    client().async_load_url(url);
+    client().async_load_url(url, is_history_navigation);
 }
 
 void OutOfProcessWebView::load_html(const StringView& html, const URL& url)
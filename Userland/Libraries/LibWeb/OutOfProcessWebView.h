@@ -24,7 +24,7 @@ public:
     virtual ~OutOfProcessWebView() override;
 
     URL url() const { return m_url; }
-    void load(const URL&);
+    void load(const URL&, bool is_history_navigation = false);
 
     void load_html(const StringView&, const URL&);
     void load_empty_document();
@@ -70,6 +70,18 @@ bool Frame::is_focused_frame() const
     return m_page && &m_page->focused_frame() == this;
 }
 
+RefPtr<DOM::Document> Frame::take_cached_document(const URL& url)
+{
+    for (size_t i = 0; i < m_cached_documents.size(); ++i) {
+        if (m_cached_documents[i].url == url) {
+            auto document = m_cached_documents[i].document;
+            m_cached_documents.remove(i);
+            return document;
+        }
+    }
+    return nullptr;
+}
+
 void Frame::set_document(DOM::Document* document)
 {
     if (m_document == document)
@@ -77,8 +89,15 @@ void Frame::set_document(DOM::Document* document)
 
     m_cursor_position = {};
 
-    if (m_document)
+    if (m_document) {
         m_document->detach_from_frame({}, *this);
+        if (m_document->url().is_valid()) {
+            m_cached_documents.remove_all_matching([&](auto& entry) { return entry.url == m_document->url(); });
+            if (m_cached_documents.size() >= max_cached_documents)
+                m_cached_documents.remove(0);
+            m_cached_documents.append({ m_document->url(), *m_document });
+        }
+    }
 
     m_document = document;
 
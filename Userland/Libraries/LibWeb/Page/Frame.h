@@ -43,6 +43,8 @@ public:
 
     void set_document(DOM::Document*);
 
+    RefPtr<DOM::Document> take_cached_document(const URL&);
+
     Page* page() { return m_page; }
     const Page* page() const { return m_page; }
 
@@ -105,6 +107,16 @@ private:
 
     WeakPtr<DOM::Element> m_host_element;
     RefPtr<DOM::Document> m_document;
+
+    // Documents we've navigated away from, kept alive (with their timers
+    // paused) so that history traversal can restore them without another
+    // network+parse cycle.
+    static constexpr size_t max_cached_documents = 3;
+    struct CachedDocument {
+        URL url;
+        NonnullRefPtr<DOM::Document> document;
+    };
+    Vector<CachedDocument> m_cached_documents;
     Gfx::IntSize m_size;
     Gfx::IntPoint m_viewport_scroll_offset;
 
@@ -7,6 +7,7 @@
 #include <AK/Array.h>
 #include <AK/MemoryStream.h>
 #include <AK/NumericLimits.h>
+#include <AK/SIMD.h>
 #include <AudioServer/ClientConnection.h>
 #include <AudioServer/Mixer.h>
 #include <pthread.h>
@@ -14,6 +15,23 @@
 
 namespace AudioServer {
 
+using AK::SIMD::f64x2;
+
+// An Audio::Frame is a pair of doubles, which is exactly one f64x2, so the
+// mix, volume and clip kernels below handle both channels of a frame in a
+// single vector operation each.
+ALWAYS_INLINE static f64x2 load_frame(const Audio::Frame& frame)
+{
+    f64x2 vector;
+    __builtin_memcpy(&vector, &frame, sizeof(vector));
+    return vector;
+}
+
+ALWAYS_INLINE static void store_frame(Audio::Frame& frame, f64x2 vector)
+{
+    __builtin_memcpy(&frame, &vector, sizeof(vector));
+}
+
 Mixer::Mixer()
     : m_device(Core::File::construct("/dev/audio", this))
     , m_sound_thread(Threading::Thread::construct(
@@ -31,8 +49,8 @@ Mixer::Mixer()
     pthread_mutex_init(&m_pending_mutex, nullptr);
     pthread_cond_init(&m_pending_cond, nullptr);
 
-    m_zero_filled_buffer = (u8*)malloc(4096);
-    bzero(m_zero_filled_buffer, 4096);
+    m_zero_filled_buffer = (u8*)malloc(mixer_bytes_per_period);
+    bzero(m_zero_filled_buffer, mixer_bytes_per_period);
     m_sound_thread->start();
 }
 
@@ -66,42 +84,33 @@ void Mixer::mix()
 
         active_mix_queues.remove_all_matching([&](auto& entry) { return !entry->client(); });
 
-        Audio::Frame mixed_buffer[1024];
-        auto mixed_buffer_length = (int)(sizeof(mixed_buffer) / sizeof(Audio::Frame));
+        Audio::Frame mixed_buffer[mixer_frames_per_period];
 
         // Mix the buffers together into the output
-        for (auto& queue : active_mix_queues) {
-            if (!queue->client()) {
-                queue->clear();
-                continue;
-            }
-
-            for (int i = 0; i < mixed_buffer_length; ++i) {
-                auto& mixed_sample = mixed_buffer[i];
-                Audio::Frame sample;
-                if (!queue->get_next_sample(sample))
-                    break;
-                mixed_sample += sample;
-            }
-        }
+        for (auto& queue : active_mix_queues)
+            queue->mix_into(mixed_buffer, mixer_frames_per_period);
 
-        if (m_muted) {
-            m_device->write(m_zero_filled_buffer, 4096);
+        if (is_muted()) {
+            m_device->write(m_zero_filled_buffer, mixer_bytes_per_period);
         } else {
-            Array<u8, 4096> buffer;
+            Array<u8, mixer_bytes_per_period> buffer;
             OutputMemoryStream stream { buffer };
 
-            for (int i = 0; i < mixed_buffer_length; ++i) {
-                auto& mixed_sample = mixed_buffer[i];
+            double volume_factor = main_volume() / 100.0;
+            f64x2 const volume = { volume_factor, volume_factor };
+            f64x2 const minimum = { -1.0, -1.0 };
+            f64x2 const maximum = { 1.0, 1.0 };
 
-                mixed_sample.scale(m_main_volume);
-                mixed_sample.clip();
+            for (int i = 0; i < mixer_frames_per_period; ++i) {
+                auto mixed_sample = load_frame(mixed_buffer[i]) * volume;
+                mixed_sample = mixed_sample < minimum ? minimum : mixed_sample;
+                mixed_sample = mixed_sample > maximum ? maximum : mixed_sample;
 
                 LittleEndian<i16> out_sample;
-                out_sample = mixed_sample.left * NumericLimits<i16>::max();
+                out_sample = mixed_sample[0] * NumericLimits<i16>::max();
                 stream << out_sample;
 
-                out_sample = mixed_sample.right * NumericLimits<i16>::max();
+                out_sample = mixed_sample[1] * NumericLimits<i16>::max();
                 stream << out_sample;
             }
 
@@ -115,21 +124,20 @@ void Mixer::mix()
 void Mixer::set_main_volume(int volume)
 {
     if (volume < 0)
-        m_main_volume = 0;
+        volume = 0;
     else if (volume > 200)
-        m_main_volume = 200;
-    else
-        m_main_volume = volume;
+        volume = 200;
+    m_main_volume.store(volume, AK::MemoryOrder::memory_order_relaxed);
     ClientConnection::for_each([&](ClientConnection& client) {
-        client.did_change_main_mix_volume({}, m_main_volume);
+        client.did_change_main_mix_volume({}, volume);
     });
 }
 
 void Mixer::set_muted(bool muted)
 {
-    if (m_muted == muted)
+    if (is_muted() == muted)
         return;
-    m_muted = muted;
+    m_muted.store(muted, AK::MemoryOrder::memory_order_relaxed);
     ClientConnection::for_each([muted](ClientConnection& client) {
         client.did_change_muted_state({}, muted);
     });
@@ -142,7 +150,68 @@ BufferQueue::BufferQueue(ClientConnection& client)
 
 void BufferQueue::enqueue(NonnullRefPtr<Audio::Buffer>&& buffer)
 {
-    m_remaining_samples += buffer->sample_count();
-    m_queue.enqueue(move(buffer));
+    m_remaining_samples.fetch_add(buffer->sample_count(), AK::MemoryOrder::memory_order_relaxed);
+    // The IPC thread is the only producer, and it checks is_full() before
+    // enqueueing, so there is guaranteed to be a free slot.
+    bool enqueued = m_queue.try_enqueue(move(buffer));
+    VERIFY(enqueued);
+}
+
+void BufferQueue::apply_clear_if_requested()
+{
+    if (!m_clear_requested.exchange(false, AK::MemoryOrder::memory_order_acquire))
+        return;
+
+    m_current = nullptr;
+    m_position = 0;
+    RefPtr<Audio::Buffer> dropped;
+    while (m_queue.try_dequeue(dropped))
+        dropped = nullptr;
+    m_remaining_samples.store(0, AK::MemoryOrder::memory_order_relaxed);
+    m_played_samples.store(0, AK::MemoryOrder::memory_order_relaxed);
+    m_playing_buffer_id.store(-1, AK::MemoryOrder::memory_order_relaxed);
+}
+
+bool BufferQueue::dequeue_next_buffer()
+{
+    RefPtr<Audio::Buffer> next;
+    if (!m_queue.try_dequeue(next))
+        return false;
+    m_current = move(next);
+    m_position = 0;
+    m_playing_buffer_id.store(m_current->id(), AK::MemoryOrder::memory_order_relaxed);
+    return true;
+}
+
+void BufferQueue::mix_into(Audio::Frame* mix_buffer, int frame_count)
+{
+    apply_clear_if_requested();
+
+    if (m_paused.load(AK::MemoryOrder::memory_order_relaxed))
+        return;
+
+    int mixed = 0;
+    while (mixed < frame_count) {
+        if (!m_current && !dequeue_next_buffer())
+            break;
+
+        // Mix as many contiguous frames from the current buffer as will fit.
+        auto const* samples = &m_current->samples()[m_position];
+        int run_length = min(frame_count - mixed, m_current->sample_count() - m_position);
+        for (int i = 0; i < run_length; ++i)
+            store_frame(mix_buffer[mixed + i], load_frame(mix_buffer[mixed + i]) + load_frame(samples[i]));
+
+        mixed += run_length;
+        m_position += run_length;
+        m_remaining_samples.fetch_sub(run_length, AK::MemoryOrder::memory_order_relaxed);
+        m_played_samples.fetch_add(run_length, AK::MemoryOrder::memory_order_relaxed);
+
+        if (m_position >= m_current->sample_count()) {
+            m_client->did_finish_playing_buffer({}, m_current->id());
+            m_current = nullptr;
+            m_position = 0;
+            m_playing_buffer_id.store(-1, AK::MemoryOrder::memory_order_relaxed);
+        }
+    }
 }
 }
@@ -11,8 +11,8 @@
 #include <AK/Badge.h>
 #include <AK/ByteBuffer.h>
 #include <AK/NonnullRefPtrVector.h>
-#include <AK/Queue.h>
 #include <AK/RefCounted.h>
+#include <AK/SPSCQueue.h>
 #include <AK/WeakPtr.h>
 #include <LibAudio/Buffer.h>
 #include <LibCore/File.h>
@@ -23,70 +23,66 @@ namespace AudioServer {
 
 class ClientConnection;
 
+// How many frames the mixer thread mixes and writes to the device in one go.
+// At 44.1kHz a period is ~23ms; lowering this makes the mixer react faster
+// at the cost of more wakeups per second.
+static constexpr int mixer_frames_per_period = 1024;
+static constexpr int mixer_bytes_per_period = mixer_frames_per_period * 2 * sizeof(i16);
+
+// A queue of pending buffers: the IPC (main) thread enqueues and the mixer
+// thread dequeues through an SPSCQueue, so neither side ever takes a lock or
+// blocks the other.
 class BufferQueue : public RefCounted<BufferQueue> {
 public:
     explicit BufferQueue(ClientConnection&);
     ~BufferQueue() { }
 
-    bool is_full() const { return m_queue.size() >= 3; }
-    void enqueue(NonnullRefPtr<Audio::Buffer>&&);
-
-    bool get_next_sample(Audio::Frame& sample)
-    {
-        if (m_paused)
-            return false;
+    bool is_full() const { return m_queue.is_full(); }
 
-        while (!m_current && !m_queue.is_empty())
-            m_current = m_queue.dequeue();
-
-        if (!m_current)
-            return false;
-
-        sample = m_current->samples()[m_position++];
-        --m_remaining_samples;
-        ++m_played_samples;
+    void enqueue(NonnullRefPtr<Audio::Buffer>&&);
 
-        if (m_position >= m_current->sample_count()) {
-            m_client->did_finish_playing_buffer({}, m_current->id());
-            m_current = nullptr;
-            m_position = 0;
-        }
-        return true;
-    }
+    // Mixes up to frame_count frames into mix_buffer. Only called on the
+    // mixer thread.
+    void mix_into(Audio::Frame* mix_buffer, int frame_count);
 
     ClientConnection* client() { return m_client.ptr(); }
 
+    // Queued buffers are dropped by the mixer thread the next time it looks
+    // at this queue, so the sample counters may lag behind by one period.
     void clear(bool paused = false)
     {
-        m_queue.clear();
-        m_position = 0;
-        m_remaining_samples = 0;
-        m_played_samples = 0;
-        m_current = nullptr;
-        m_paused = paused;
+        m_remaining_samples.store(0, AK::MemoryOrder::memory_order_relaxed);
+        m_played_samples.store(0, AK::MemoryOrder::memory_order_relaxed);
+        m_paused.store(paused, AK::MemoryOrder::memory_order_relaxed);
+        m_clear_requested.store(true, AK::MemoryOrder::memory_order_release);
     }
 
     void set_paused(bool paused)
     {
-        m_paused = paused;
+        m_paused.store(paused, AK::MemoryOrder::memory_order_relaxed);
     }
 
-    int get_remaining_samples() const { return m_remaining_samples; }
-    int get_played_samples() const { return m_played_samples; }
-    int get_playing_buffer() const
-    {
-        if (m_current)
-            return m_current->id();
-        return -1;
-    }
+    int get_remaining_samples() const { return m_remaining_samples.load(AK::MemoryOrder::memory_order_relaxed); }
+    int get_played_samples() const { return m_played_samples.load(AK::MemoryOrder::memory_order_relaxed); }
+    int get_playing_buffer() const { return m_playing_buffer_id.load(AK::MemoryOrder::memory_order_relaxed); }
 
 private:
+    bool dequeue_next_buffer();
+    void apply_clear_if_requested();
+
+    static constexpr size_t buffer_capacity = 4;
+
+    // Only the mixer thread touches the buffer being played.
     RefPtr<Audio::Buffer> m_current;
-    Queue<NonnullRefPtr<Audio::Buffer>> m_queue;
     int m_position { 0 };
-    int m_remaining_samples { 0 };
-    int m_played_samples { 0 };
-    bool m_paused { false };
+
+    SPSCQueue<RefPtr<Audio::Buffer>, buffer_capacity> m_queue;
+
+    Atomic<int> m_remaining_samples { 0 };
+    Atomic<int> m_played_samples { 0 };
+    Atomic<int> m_playing_buffer_id { -1 };
+    Atomic<bool> m_paused { false };
+    Atomic<bool> m_clear_requested { false };
     WeakPtr<ClientConnection> m_client;
 };
 
@@ -98,10 +94,10 @@ public:
 
     NonnullRefPtr<BufferQueue> create_queue(ClientConnection&);
 
-    int main_volume() const { return m_main_volume; }
+    int main_volume() const { return m_main_volume.load(AK::MemoryOrder::memory_order_relaxed); }
     void set_main_volume(int volume);
 
-    bool is_muted() const { return m_muted; }
+    bool is_muted() const { return m_muted.load(AK::MemoryOrder::memory_order_relaxed); }
     void set_muted(bool);
 
 private:
@@ -114,8 +110,8 @@ private:
 
     NonnullRefPtr<Threading::Thread> m_sound_thread;
 
-    bool m_muted { false };
-    int m_main_volume { 100 };
+    Atomic<bool> m_muted { false };
+    Atomic<int> m_main_volume { 100 };
 
     u8* m_zero_filled_buffer { nullptr };
 
@@ -5,10 +5,7 @@
  */
 
 #include "ChessEngine.h"
-#include "MCTSTree.h"
 #include <AK/Debug.h>
-#include <AK/Random.h>
-#include <LibCore/ElapsedTimer.h>
 
 using namespace Chess::UCI;
 
@@ -31,28 +28,12 @@ void ChessEngine::handle_position(const PositionCommand& command)
 
 void ChessEngine::handle_go(const GoCommand& command)
 {
-    // FIXME: A better algorithm than naive mcts.
     // FIXME: Add different ways to terminate search.
     VERIFY(command.movetime.has_value());
 
-    srand(get_random<u32>());
-
-    Core::ElapsedTimer elapsed_time;
-    elapsed_time.start();
-
-    MCTSTree mcts(m_board);
-
-    // FIXME: optimize simulations enough for use.
-    mcts.set_eval_method(MCTSTree::EvalMethod::Heuristic);
-
-    int rounds = 0;
-    while (elapsed_time.elapsed() <= command.movetime.value()) {
-        mcts.do_round();
-        ++rounds;
-    }
-    dbgln("MCTS finished {} rounds.", rounds);
-    dbgln("MCTS evaluation {}", mcts.expected_value());
-    auto best_move = mcts.best_move();
-    dbgln("MCTS best move {}", best_move.to_long_algebraic());
-    send_command(BestMoveCommand(best_move));
+    auto result = m_search.search(m_board, command.movetime.value());
+    u64 nps = result.time_ms > 0 ? result.nodes * 1000 / result.time_ms : result.nodes;
+    dbgln("Search reached depth {} with score {} ({} nodes, {} nodes/s)", result.depth, result.score, result.nodes, nps);
+    dbgln("Search best move {}", result.best_move.to_long_algebraic());
+    send_command(BestMoveCommand(result.best_move));
 }
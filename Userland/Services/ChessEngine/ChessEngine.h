@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "Search.h"
 #include <LibChess/Chess.h>
 #include <LibChess/UCIEndpoint.h>
 
@@ -26,4 +27,6 @@ public:
 
 private:
     Chess::Board m_board;
+    // Kept across moves so the transposition table carries over.
+    Search m_search;
 };
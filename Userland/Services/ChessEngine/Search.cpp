@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "Search.h"
+#include <AK/QuickSort.h>
+#include <AK/Random.h>
+#include <LibThreading/Thread.h>
+#include <stdlib.h>
+
+static u64 s_piece_keys[2][6][64];
+static u64 s_castle_keys[4];
+static u64 s_en_passant_file_keys[8];
+static u64 s_black_to_move_key;
+static bool s_zobrist_keys_initialized = false;
+
+static void ensure_zobrist_keys()
+{
+    if (s_zobrist_keys_initialized)
+        return;
+    for (size_t color = 0; color < 2; ++color) {
+        for (size_t type = 0; type < 6; ++type) {
+            for (size_t square = 0; square < 64; ++square)
+                s_piece_keys[color][type][square] = get_random<u64>();
+        }
+    }
+    for (size_t i = 0; i < 4; ++i)
+        s_castle_keys[i] = get_random<u64>();
+    for (size_t i = 0; i < 8; ++i)
+        s_en_passant_file_keys[i] = get_random<u64>();
+    s_black_to_move_key = get_random<u64>();
+    s_zobrist_keys_initialized = true;
+}
+
+Search::Search()
+{
+    ensure_zobrist_keys();
+    m_table.resize(table_entry_count);
+}
+
+u64 Search::zobrist_hash(const Chess::Board& board)
+{
+    u64 hash = 0;
+    Chess::Square::for_each([&](Chess::Square square) {
+        auto piece = board.get_piece(square);
+        if (piece.type != Chess::Type::None)
+            hash ^= s_piece_keys[piece.color == Chess::Color::White ? 0 : 1][static_cast<int>(piece.type)][square.rank * 8 + square.file];
+        return IterationDecision::Continue;
+    });
+
+    if (board.turn() == Chess::Color::Black)
+        hash ^= s_black_to_move_key;
+
+    if (board.white_can_castle_kingside())
+        hash ^= s_castle_keys[0];
+    if (board.white_can_castle_queenside())
+        hash ^= s_castle_keys[1];
+    if (board.black_can_castle_kingside())
+        hash ^= s_castle_keys[2];
+    if (board.black_can_castle_queenside())
+        hash ^= s_castle_keys[3];
+
+    // A pawn that just advanced two squares may be captured en passant, so
+    // such positions must not share a key with quiet ones.
+    if (board.last_move().has_value()) {
+        auto& last_move = board.last_move().value();
+        if (board.get_piece(last_move.to).type == Chess::Type::Pawn && abs(last_move.to.rank - last_move.from.rank) == 2)
+            hash ^= s_en_passant_file_keys[last_move.to.file];
+    }
+
+    return hash;
+}
+
+int Search::evaluate(const Chess::Board& board)
+{
+    int score = board.material_imbalance() * 100;
+    return board.turn() == Chess::Color::White ? score : -score;
+}
+
+int Search::negamax(const Chess::Board& board, int depth, int alpha, int beta, int ply, Chess::Move* best_move_out)
+{
+    if ((m_nodes.fetch_add(1, AK::memory_order_relaxed) & 0xff) == 0) {
+        if (m_timer.elapsed() >= m_movetime_ms)
+            m_stop.store(true, AK::memory_order_relaxed);
+    }
+    if (m_stop.load(AK::memory_order_relaxed))
+        return 0;
+
+    int alpha_original = alpha;
+
+    auto key = zobrist_hash(board);
+    auto& entry = m_table[key & (table_entry_count - 1)];
+    // Take a snapshot: another thread may overwrite the slot while we look
+    // at it, and the key check below rejects anything that isn't ours.
+    TableEntry cached = entry;
+    bool has_table_move = false;
+    Chess::Move table_move { Chess::Square { 0, 0 }, Chess::Square { 0, 0 } };
+    if (cached.used && cached.key == key) {
+        if (ply > 0 && cached.depth >= depth) {
+            if (cached.bound == Bound::Exact)
+                return cached.score;
+            if (cached.bound == Bound::Lower)
+                alpha = max(alpha, cached.score);
+            else
+                beta = min(beta, cached.score);
+            if (alpha >= beta)
+                return cached.score;
+        }
+        table_move = cached.best_move;
+        has_table_move = true;
+    }
+
+    if (depth == 0)
+        return evaluate(board);
+
+    Vector<Chess::Move> moves;
+    board.generate_moves([&](Chess::Move move) {
+        moves.append(move);
+        return IterationDecision::Continue;
+    });
+
+    if (moves.is_empty()) {
+        if (board.in_check(board.turn()))
+            return -(mate_score - ply);
+        return 0;
+    }
+
+    // Search the table move first, then captures (most valuable victim
+    // first), so the better part of the tree gets cut off early.
+    auto move_priority = [&](const Chess::Move& move) {
+        if (has_table_move && move == table_move)
+            return 1000;
+        switch (board.get_piece(move.to).type) {
+        case Chess::Type::Queen:
+            return 9;
+        case Chess::Type::Rook:
+            return 5;
+        case Chess::Type::Knight:
+        case Chess::Type::Bishop:
+            return 3;
+        case Chess::Type::Pawn:
+            return 1;
+        default:
+            return 0;
+        }
+    };
+    quick_sort(moves, [&](const Chess::Move& a, const Chess::Move& b) {
+        return move_priority(a) > move_priority(b);
+    });
+
+    int best_score = -infinite_score;
+    Chess::Move best_move = moves.first();
+
+    for (auto& move : moves) {
+        Chess::Board clone = board;
+        clone.apply_move(move);
+        int score = -negamax(clone, depth - 1, -beta, -alpha, ply + 1, nullptr);
+        if (m_stop.load(AK::memory_order_relaxed))
+            return 0;
+        if (score > best_score) {
+            best_score = score;
+            best_move = move;
+        }
+        alpha = max(alpha, score);
+        if (alpha >= beta)
+            break;
+    }
+
+    // Prefer deeper results when replacing someone else's entry.
+    if (!cached.used || cached.key == key || depth >= cached.depth) {
+        Bound bound = Bound::Exact;
+        if (best_score <= alpha_original)
+            bound = Bound::Upper;
+        else if (best_score >= beta)
+            bound = Bound::Lower;
+        entry = { key, best_score, best_move, static_cast<u8>(depth), bound, true };
+    }
+
+    if (best_move_out)
+        *best_move_out = best_move;
+    return best_score;
+}
+
+Search::Result Search::iterative_deepening(const Chess::Board& board)
+{
+    Result result;
+    int previous_score = 0;
+
+    for (int depth = 1; depth <= max_depth; ++depth) {
+        // Start with a window around the previous iteration's score, and
+        // re-search with a wider one whenever the score falls outside it.
+        int window = 50;
+        int alpha = depth >= 2 ? previous_score - window : -infinite_score;
+        int beta = depth >= 2 ? previous_score + window : infinite_score;
+
+        int score = 0;
+        Chess::Move best_move { Chess::Square { 0, 0 }, Chess::Square { 0, 0 } };
+        for (;;) {
+            score = negamax(board, depth, alpha, beta, 0, &best_move);
+            if (m_stop.load(AK::memory_order_relaxed))
+                break;
+            if (score <= alpha) {
+                window *= 2;
+                alpha = score - window;
+                continue;
+            }
+            if (score >= beta) {
+                window *= 2;
+                beta = score + window;
+                continue;
+            }
+            break;
+        }
+        if (m_stop.load(AK::memory_order_relaxed))
+            break;
+
+        result.best_move = best_move;
+        result.score = score;
+        result.depth = depth;
+        previous_score = score;
+
+        if (abs(score) >= mate_score - max_depth)
+            break;
+        if (m_timer.elapsed() >= m_movetime_ms)
+            break;
+    }
+
+    return result;
+}
+
+Search::Result Search::search(const Chess::Board& board, int movetime_ms, size_t thread_count)
+{
+    m_stop.store(false, AK::memory_order_relaxed);
+    m_nodes.store(0, AK::memory_order_relaxed);
+    m_movetime_ms = movetime_ms;
+    m_timer.start();
+
+    // Lazy SMP: the helpers run the same iterative deepening over the
+    // shared transposition table, so their results feed the main thread's
+    // move ordering and cutoffs; only the main thread's line is reported.
+    Vector<RefPtr<Threading::Thread>> helpers;
+    for (size_t i = 1; i < thread_count; ++i) {
+        auto helper = Threading::Thread::construct([this, board] {
+            iterative_deepening(board);
+            return static_cast<intptr_t>(0);
+        });
+        helper->start();
+        helpers.append(move(helper));
+    }
+
+    auto result = iterative_deepening(board);
+    m_stop.store(true, AK::memory_order_relaxed);
+    for (auto& helper : helpers)
+        [[maybe_unused]] auto rc = helper->join();
+
+    result.nodes = m_nodes.load(AK::memory_order_relaxed);
+    result.time_ms = m_timer.elapsed();
+    return result;
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Types.h>
+#include <AK/Vector.h>
+#include <LibChess/Chess.h>
+#include <LibCore/ElapsedTimer.h>
+
+class Search {
+public:
+    struct Result {
+        Chess::Move best_move { Chess::Square { 0, 0 }, Chess::Square { 0, 0 } };
+        int score { 0 };
+        int depth { 0 };
+        u64 nodes { 0 };
+        int time_ms { 0 };
+    };
+
+    Search();
+
+    // Searches the given position for at most movetime_ms milliseconds and
+    // returns the best move found, using iterative deepening with a shared
+    // transposition table across all search threads.
+    Result search(const Chess::Board&, int movetime_ms, size_t thread_count = 2);
+
+private:
+    static constexpr size_t table_entry_count = 1 << 16; // Must be a power of two.
+    static constexpr int infinite_score = 10'000'000;
+    static constexpr int mate_score = 1'000'000;
+    static constexpr int max_depth = 64;
+
+    enum class Bound : u8 {
+        Exact,
+        Lower,
+        Upper,
+    };
+
+    struct TableEntry {
+        u64 key { 0 };
+        int score { 0 };
+        Chess::Move best_move { Chess::Square { 0, 0 }, Chess::Square { 0, 0 } };
+        u8 depth { 0 };
+        Bound bound { Bound::Exact };
+        bool used { false };
+    };
+
+    static u64 zobrist_hash(const Chess::Board&);
+    static int evaluate(const Chess::Board&);
+
+    Result iterative_deepening(const Chess::Board&);
+    int negamax(const Chess::Board&, int depth, int alpha, int beta, int ply, Chess::Move* best_move_out);
+
+    // Shared between all search threads. Entries are written without
+    // locking, lazy-SMP style; readers validate the full hash key before
+    // trusting anything else in the entry.
+    Vector<TableEntry> m_table;
+
+    Atomic<bool> m_stop { false };
+    Atomic<u64> m_nodes { 0 };
+    Core::ElapsedTimer m_timer;
+    int m_movetime_ms { 0 };
+};
@@ -5,18 +5,37 @@
  */
 
 #include "ChessEngine.h"
+#include <AK/Format.h>
+#include <LibCore/ArgsParser.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/File.h>
 #include <unistd.h>
 
-int main()
+int main(int argc, char** argv)
 {
-    if (pledge("stdio recvfd sendfd unix rpath", nullptr) < 0) {
+    if (pledge("stdio thread recvfd sendfd unix rpath", nullptr) < 0) {
         perror("pledge");
         return 1;
     }
+
+    bool benchmark = false;
+    Core::ArgsParser args_parser;
+    args_parser.add_option(benchmark, "Run a fixed search from the start position and report nodes per second", "benchmark", 0);
+    args_parser.parse(argc, argv);
+
+    if (benchmark) {
+        Search search;
+        auto result = search.search(Chess::Board(), 10'000);
+        u64 nps = result.time_ms > 0 ? result.nodes * 1000 / result.time_ms : result.nodes;
+        outln("depth: {}", result.depth);
+        outln("nodes: {}", result.nodes);
+        outln("time: {} ms", result.time_ms);
+        outln("nodes/s: {}", nps);
+        return 0;
+    }
+
     Core::EventLoop loop;
-    if (pledge("stdio recvfd sendfd unix", nullptr) < 0) {
+    if (pledge("stdio thread recvfd sendfd unix", nullptr) < 0) {
         perror("pledge");
         return 1;
     }
@@ -33,6 +33,7 @@ ClientConnection::~ClientConnection()
 void ClientConnection::die()
 {
     s_connections.remove(client_id());
+    Storage::the().client_disconnected(client_id());
 }
 
 void ClientConnection::set_clipboard_data(Core::AnonymousBuffer const& data, String const& mime_type, IPC::Dictionary const& metadata)
@@ -40,9 +41,24 @@ void ClientConnection::set_clipboard_data(Core::AnonymousBuffer const& data, Str
     Storage::the().set_data(data, mime_type, metadata.entries());
 }
 
+void ClientConnection::set_clipboard_provider(String const& mime_type, IPC::Dictionary const& metadata)
+{
+    Storage::the().set_provider(client_id(), mime_type, metadata.entries());
+}
+
 Messages::ClipboardServer::GetClipboardDataResponse ClientConnection::get_clipboard_data()
 {
     auto& storage = Storage::the();
+    if (!storage.has_buffer() && storage.has_provider() && storage.provider_client_id() != client_id()) {
+        // Delayed rendering: the provider has kept the payload to itself until
+        // now. Ask it to render on this first paste and cache the result for
+        // subsequent pastes. We never render-request the client we're currently
+        // replying to - it's blocked waiting for this response, and LibGUI
+        // answers self-pastes from its local copy anyway.
+        auto provider = s_connections.get(storage.provider_client_id()).value_or(nullptr);
+        if (provider)
+            storage.set_rendered_data(provider->render_clipboard_data());
+    }
     return { storage.buffer(), storage.mime_type(), storage.metadata() };
 }
 
@@ -30,6 +30,7 @@ public:
 private:
     virtual Messages::ClipboardServer::GetClipboardDataResponse get_clipboard_data() override;
     virtual void set_clipboard_data(Core::AnonymousBuffer const&, String const&, IPC::Dictionary const&) override;
+    virtual void set_clipboard_provider(String const&, IPC::Dictionary const&) override;
 };
 
 }
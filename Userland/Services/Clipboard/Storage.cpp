@@ -27,9 +27,46 @@ Storage::~Storage()
 void Storage::set_data(Core::AnonymousBuffer data, const String& mime_type, const HashMap<String, String>& metadata)
 {
     m_buffer = move(data);
-    m_data_size = data.size();
+    m_data_size = m_buffer.size();
     m_mime_type = mime_type;
     m_metadata = metadata;
+    m_provider_client_id = -1;
+
+    if (on_content_change)
+        on_content_change();
+}
+
+void Storage::set_provider(int client_id, const String& mime_type, const HashMap<String, String>& metadata)
+{
+    m_buffer = {};
+    m_data_size = 0;
+    m_mime_type = mime_type;
+    m_metadata = metadata;
+    m_provider_client_id = client_id;
+
+    if (on_content_change)
+        on_content_change();
+}
+
+void Storage::set_rendered_data(Core::AnonymousBuffer data)
+{
+    m_buffer = move(data);
+    m_data_size = m_buffer.size();
+    m_provider_client_id = -1;
+    // No content-change notification here: these are still the same contents
+    // that were announced when the provider took over the clipboard.
+}
+
+void Storage::client_disconnected(int client_id)
+{
+    if (m_provider_client_id != client_id)
+        return;
+    // The provider went away before anyone pasted, taking the contents with it.
+    m_buffer = {};
+    m_data_size = 0;
+    m_mime_type = {};
+    m_metadata = {};
+    m_provider_client_id = -1;
 
     if (on_content_change)
         on_content_change();
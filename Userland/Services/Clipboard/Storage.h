@@ -18,7 +18,10 @@ public:
     static Storage& the();
     ~Storage();
 
-    bool has_data() const { return m_buffer.is_valid(); }
+    bool has_data() const { return m_buffer.is_valid() || has_provider(); }
+    bool has_buffer() const { return m_buffer.is_valid(); }
+    bool has_provider() const { return m_provider_client_id != -1; }
+    int provider_client_id() const { return m_provider_client_id; }
 
     const String& mime_type() const { return m_mime_type; }
     const HashMap<String, String>& metadata() const { return m_metadata; }
@@ -39,6 +42,13 @@ public:
 
     void set_data(Core::AnonymousBuffer, const String& mime_type, const HashMap<String, String>& metadata);
 
+    // Delayed rendering: remember who owns the clipboard contents without
+    // copying them anywhere. The provider is asked to render the payload
+    // when somebody first pastes.
+    void set_provider(int client_id, const String& mime_type, const HashMap<String, String>& metadata);
+    void set_rendered_data(Core::AnonymousBuffer);
+    void client_disconnected(int client_id);
+
     Function<void()> on_content_change;
 
     const Core::AnonymousBuffer& buffer() const { return m_buffer; }
@@ -49,6 +59,7 @@ private:
     String m_mime_type;
     Core::AnonymousBuffer m_buffer;
     size_t m_data_size { 0 };
+    int m_provider_client_id { -1 };
     HashMap<String, String> m_metadata;
 };
 
@@ -5,28 +5,61 @@
  */
 
 #include "Client.h"
+#include <AK/Vector.h>
+
+// Connections come and go quickly on a busy echo server, so client read
+// buffers are recycled through a small pool instead of being reallocated
+// for every connection (or worse, for every read).
+static constexpr size_t client_buffer_size = 16 * KiB;
+static constexpr size_t max_pooled_buffers = 64;
+
+static Vector<ByteBuffer>& buffer_pool()
+{
+    static Vector<ByteBuffer> pool;
+    return pool;
+}
+
+static ByteBuffer take_pooled_buffer()
+{
+    if (!buffer_pool().is_empty())
+        return buffer_pool().take_last();
+    return ByteBuffer::create_uninitialized(client_buffer_size);
+}
+
+static void return_pooled_buffer(ByteBuffer buffer)
+{
+    if (buffer_pool().size() < max_pooled_buffers)
+        buffer_pool().append(move(buffer));
+}
 
 Client::Client(int id, RefPtr<Core::TCPSocket> socket)
     : m_id(id)
     , m_socket(move(socket))
+    , m_buffer(take_pooled_buffer())
 {
     m_socket->on_ready_to_read = [this] { drain_socket(); };
 }
 
+Client::~Client()
+{
+    return_pooled_buffer(move(m_buffer));
+}
+
 void Client::drain_socket()
 {
     NonnullRefPtr<Client> protect(*this);
     while (m_socket->can_read()) {
-        auto buf = m_socket->read(1024);
-
-        dbgln("Read {} bytes.", buf.size());
+        auto nread = m_socket->read(m_buffer.data(), m_buffer.size());
 
         if (m_socket->eof()) {
             quit();
             break;
         }
 
-        m_socket->write(buf);
+        if (nread <= 0)
+            break;
+
+        m_socket->write(m_buffer.data(), nread);
     }
 }
 
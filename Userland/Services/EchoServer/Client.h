@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <LibCore/TCPSocket.h>
 
 class Client : public RefCounted<Client> {
@@ -14,6 +15,7 @@ public:
     {
         return adopt_ref(*new Client(id, move(socket)));
     }
+    ~Client();
 
     Function<void()> on_exit;
 
@@ -26,4 +28,5 @@ protected:
 private:
     int m_id { 0 };
     RefPtr<Core::TCPSocket> m_socket;
+    ByteBuffer m_buffer;
 };
@@ -4,13 +4,16 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ByteBuffer.h>
 #include <AK/Format.h>
 #include <AK/LexicalPath.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/DirIterator.h>
 #include <LibCore/File.h>
 #include <sched.h>
+#include <sys/sendfile.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 static int perform_copy(const String& source, const String& destination);
 static void report_error(String message);
@@ -140,17 +143,40 @@ int perform_copy(const String& source, const String& destination)
         auto& source_file = *source_file_or_error.value();
         auto& destination_file = *destination_file_or_error.value();
 
+        static constexpr size_t copy_chunk_size = 1 * MiB;
+        ByteBuffer copy_fallback_buffer;
+        bool use_sendfile = true;
+
         while (true) {
             print_progress();
-            auto buffer = source_file.read(65536);
-            if (buffer.is_empty())
-                break;
-            if (!destination_file.write(buffer)) {
-                report_warning(String::formatted("Failed to write to destination file: {}", destination_file.error_string()));
+            ssize_t nread = 0;
+            if (use_sendfile) {
+                // Copy a chunk inode-to-inode in the kernel; chunked so that
+                // progress still gets reported as the copy advances.
+                nread = sendfile(destination_file.fd(), source_file.fd(), nullptr, copy_chunk_size);
+                if (nread < 0 && item_done == 0 && (errno == EINVAL || errno == ENOSYS)) {
+                    // The kernel cannot copy this pair of files directly.
+                    use_sendfile = false;
+                    continue;
+                }
+            } else {
+                if (copy_fallback_buffer.is_empty())
+                    copy_fallback_buffer = ByteBuffer::create_uninitialized(copy_chunk_size);
+                nread = read(source_file.fd(), copy_fallback_buffer.data(), copy_fallback_buffer.size());
+                if (nread > 0 && !destination_file.write(copy_fallback_buffer.data(), nread)) {
+                    report_warning(String::formatted("Failed to write to destination file: {}", destination_file.error_string()));
+                    return 1;
+                }
+            }
+            if (nread < 0) {
+                auto original_errno = errno;
+                report_warning(String::formatted("Failed to copy {}: {}", item.source, strerror(original_errno)));
                 return 1;
             }
-            item_done += buffer.size();
-            bytes_copied_so_far += buffer.size();
+            if (nread == 0)
+                break;
+            item_done += nread;
+            bytes_copied_so_far += nread;
             print_progress();
             // FIXME: Remove this once the kernel is smart enough to schedule other threads
             //        while we're doing heavy I/O. Right now, copying a large file will totally
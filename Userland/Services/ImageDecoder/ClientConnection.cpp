@@ -5,6 +5,7 @@
  */
 
 #include <AK/Debug.h>
+#include <AK/StringHash.h>
 #include <ImageDecoder/ClientConnection.h>
 #include <ImageDecoder/ImageDecoderClientEndpoint.h>
 #include <LibGfx/Bitmap.h>
@@ -30,6 +31,20 @@ void ClientConnection::die()
     exit(0);
 }
 
+ClientConnection::CachedDecode const* ClientConnection::find_cached_decode(u32 content_hash, Core::AnonymousBuffer const& encoded_data)
+{
+    for (size_t i = 0; i < m_decode_cache.size(); ++i) {
+        auto& entry = m_decode_cache[i];
+        if (entry.content_hash != content_hash
+            || entry.encoded_data.size() != encoded_data.size()
+            || memcmp(entry.encoded_data.data<u8>(), encoded_data.data<u8>(), encoded_data.size()) != 0)
+            continue;
+        m_decode_cache.append(m_decode_cache.take(i));
+        return &m_decode_cache.last();
+    }
+    return nullptr;
+}
+
 Messages::ImageDecoderServer::DecodeImageResponse ClientConnection::decode_image(Core::AnonymousBuffer const& encoded_buffer)
 {
     if (!encoded_buffer.is_valid()) {
@@ -37,6 +52,12 @@ Messages::ImageDecoderServer::DecodeImageResponse ClientConnection::decode_image
         return nullptr;
     }
 
+    auto content_hash = string_hash(encoded_buffer.data<char>(), encoded_buffer.size());
+    if (auto* cached = find_cached_decode(content_hash, encoded_buffer)) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "Serving decoded image from cache");
+        return { cached->is_animated, cached->loop_count, cached->bitmaps, cached->durations };
+    }
+
     auto decoder = Gfx::ImageDecoder::create(encoded_buffer.data<u8>(), encoded_buffer.size());
 
     if (!decoder->frame_count()) {
@@ -62,6 +83,10 @@ Messages::ImageDecoderServer::DecodeImageResponse ClientConnection::decode_image
         durations.append(frame.duration);
     }
 
+    if (m_decode_cache.size() >= max_cached_decodes)
+        m_decode_cache.take_first();
+    m_decode_cache.append({ content_hash, encoded_buffer, decoder->is_animated(), static_cast<u32>(decoder->loop_count()), bitmaps, durations });
+
     return { decoder->is_animated(), static_cast<u32>(decoder->loop_count()), bitmaps, durations };
 }
 
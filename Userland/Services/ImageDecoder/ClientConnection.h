@@ -7,7 +7,10 @@
 #pragma once
 
 #include <AK/HashMap.h>
+#include <AK/Vector.h>
 #include <ImageDecoder/Forward.h>
+#include <LibCore/AnonymousBuffer.h>
+#include <LibGfx/ShareableBitmap.h>
 #include <ImageDecoder/ImageDecoderClientEndpoint.h>
 #include <ImageDecoder/ImageDecoderServerEndpoint.h>
 #include <LibIPC/ClientConnection.h>
@@ -27,6 +30,26 @@ public:
 
 private:
     virtual Messages::ImageDecoderServer::DecodeImageResponse decode_image(Core::AnonymousBuffer const&) override;
+
+    // Results of recent decodes, most recently used last. The browser
+    // re-requests the same encoded image whenever a page is revisited, so
+    // repeat requests are served from here without running the decoders.
+    // Keeping the encoded buffer alive lets us verify a hash match byte for
+    // byte, and the cached ShareableBitmaps re-share the same anonymous
+    // memory on every hit.
+    struct CachedDecode {
+        u32 content_hash { 0 };
+        Core::AnonymousBuffer encoded_data;
+        bool is_animated { false };
+        u32 loop_count { 0 };
+        Vector<Gfx::ShareableBitmap> bitmaps;
+        Vector<u32> durations;
+    };
+    static constexpr size_t max_cached_decodes = 8;
+
+    CachedDecode const* find_cached_decode(u32 content_hash, Core::AnonymousBuffer const& encoded_data);
+
+    Vector<CachedDecode> m_decode_cache;
 };
 
 }
@@ -55,4 +55,10 @@ Messages::LookupServer::LookupAddressResponse ClientConnection::lookup_address(S
         return { 1, String() };
     return { 0, answers[0].record_data() };
 }
+
+void ClientConnection::prefetch_name(String const& name)
+{
+    // Nobody is waiting for the answer; we only want to warm up the cache.
+    LookupServer::the().lookup(name, DNSRecordType::A);
+}
 }
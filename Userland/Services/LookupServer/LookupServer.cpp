@@ -11,13 +11,16 @@
 #include <AK/Debug.h>
 #include <AK/HashMap.h>
 #include <AK/Random.h>
+#include <AK/ScopeGuard.h>
 #include <AK/String.h>
 #include <AK/StringBuilder.h>
 #include <LibCore/ConfigFile.h>
+#include <LibCore/EventLoop.h>
 #include <LibCore/File.h>
 #include <LibCore/LocalServer.h>
 #include <LibCore/LocalSocket.h>
-#include <LibCore/UDPSocket.h>
+#include <LibCore/Timer.h>
+#include <LibCore/UDPServer.h>
 #include <stdio.h>
 #include <time.h>
 #include <unistd.h>
@@ -49,6 +52,15 @@ LookupServer::LookupServer()
     }
     m_mdns = MulticastDNS::construct(this);
 
+    // All upstream queries are sent over this one socket; responses are
+    // routed back to their queries by transaction ID, so any number of
+    // lookups can be outstanding at the same time.
+    m_upstream_socket = Core::UDPServer::construct(this);
+    m_upstream_socket->bind(IPv4Address(), 0);
+    m_upstream_socket->on_ready_to_receive = [this]() {
+        handle_upstream_response();
+    };
+
     m_local_server = Core::LocalServer::construct(this);
     m_local_server->on_ready_to_accept = [this]() {
         auto socket = m_local_server->accept();
@@ -140,19 +152,37 @@ Vector<DNSAnswer> LookupServer::lookup(const DNSName& name, DNSRecordType record
             return answers;
     }
 
-    // Second, try our cache.
-    if (auto cached_answers = m_lookup_cache.get(name); cached_answers.has_value()) {
-        for (auto& answer : cached_answers.value()) {
-            // TODO: Actually remove expired answers from the cache.
-            if (answer.type() == record_type && !answer.has_expired()) {
+    // Second, try our cache, evicting expired answers as we go.
+    if (auto it = m_lookup_cache.find(name); it != m_lookup_cache.end()) {
+        auto& cached_answers = it->value;
+        cached_answers.remove_all_matching([](const DNSAnswer& answer) { return answer.has_expired(); });
+        for (auto& answer : cached_answers) {
+            if (answer.type() == record_type) {
                 dbgln_if(LOOKUPSERVER_DEBUG, "Cache hit: {} -> {}", name.as_string(), answer.record_data());
                 add_answer(answer);
             }
         }
+        if (cached_answers.is_empty())
+            m_lookup_cache.remove(it);
         if (!answers.is_empty())
             return answers;
     }
 
+    // Third, check if this is a lookup that recently failed; if so, don't
+    // bother the nameservers with it again until the entry expires.
+    if (auto it = m_failed_lookup_cache.find(name); it != m_failed_lookup_cache.end()) {
+        auto& failed_lookups = it->value;
+        failed_lookups.remove_all_matching([](const FailedLookup& failed_lookup) { return failed_lookup.has_expired(); });
+        for (auto& failed_lookup : failed_lookups) {
+            if (failed_lookup.record_type == record_type) {
+                dbgln_if(LOOKUPSERVER_DEBUG, "Negative cache hit: {}", name.as_string());
+                return {};
+            }
+        }
+        if (failed_lookups.is_empty())
+            m_failed_lookup_cache.remove(it);
+    }
+
     // Look up .local names using mDNS instead of DNS nameservers.
     if (name.as_string().ends_with(".local")) {
         answers = m_mdns->lookup(name, record_type);
@@ -161,7 +191,8 @@ Vector<DNSAnswer> LookupServer::lookup(const DNSName& name, DNSRecordType record
         return answers;
     }
 
-    // Third, ask the upstream nameservers.
+    // Fourth, ask the upstream nameservers.
+    bool did_get_any_response = false;
     for (auto& nameserver : m_nameservers) {
         dbgln_if(LOOKUPSERVER_DEBUG, "Doing lookup using nameserver '{}'", nameserver);
         bool did_get_response = false;
@@ -172,6 +203,7 @@ Vector<DNSAnswer> LookupServer::lookup(const DNSName& name, DNSRecordType record
             if (did_get_response)
                 break;
         } while (--retries);
+        did_get_any_response |= did_get_response;
         if (!upstream_answers.is_empty()) {
             for (auto& answer : upstream_answers)
                 add_answer(answer);
@@ -184,7 +216,11 @@ Vector<DNSAnswer> LookupServer::lookup(const DNSName& name, DNSRecordType record
         }
     }
     if (answers.is_empty()) {
-        dbgln("Tried all nameservers but never got a response :(");
+        dbgln("Tried all nameservers but never got a result :(");
+        // If an upstream server did answer and the name simply has no records,
+        // remember that for a while so we don't keep asking.
+        if (did_get_any_response)
+            put_in_failed_cache(name, record_type);
         return {};
     }
 
@@ -195,7 +231,9 @@ Vector<DNSAnswer> LookupServer::lookup(const DNSName& name, const String& namese
 {
     DNSPacket request;
     request.set_is_query();
-    request.set_id(get_random_uniform(UINT16_MAX));
+    do {
+        request.set_id(get_random_uniform(UINT16_MAX));
+    } while (m_pending_lookups.contains(request.id()));
     DNSName name_in_question = name;
     if (should_randomize_case == ShouldRandomizeCase::Yes)
         name_in_question.randomize_case();
@@ -203,42 +241,45 @@ Vector<DNSAnswer> LookupServer::lookup(const DNSName& name, const String& namese
 
     auto buffer = request.to_byte_buffer();
 
-    auto udp_socket = Core::UDPSocket::construct();
-    udp_socket->set_blocking(true);
+    auto nameserver_address = IPv4Address::from_string(nameserver);
+    if (!nameserver_address.has_value()) {
+        dbgln("LookupServer: Invalid nameserver '{}'", nameserver);
+        return {};
+    }
 
-    struct timeval timeout {
-        1, 0
+    sockaddr_in destination {};
+    destination.sin_family = AF_INET;
+    destination.sin_port = htons(53);
+    destination.sin_addr.s_addr = nameserver_address.value().to_in_addr_t();
+
+    PendingLookup pending_lookup { request.id(), {}, nullptr };
+    m_pending_lookups.set(request.id(), &pending_lookup);
+    ScopeGuard unregister_pending_lookup = [&] {
+        m_pending_lookups.remove(request.id());
     };
 
-    int rc = setsockopt(udp_socket->fd(), SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    int rc = sendto(m_upstream_socket->fd(), buffer.data(), buffer.size(), 0, (const sockaddr*)&destination, sizeof(destination));
     if (rc < 0) {
-        perror("setsockopt(SOL_SOCKET, SO_RCVTIMEO)");
+        perror("sendto");
         return {};
     }
 
-    if (!udp_socket->connect(nameserver, 53))
-        return {};
-
-    if (!udp_socket->write(buffer))
-        return {};
-
-    u8 response_buffer[4096];
-    int nrecv = udp_socket->read(response_buffer, sizeof(response_buffer));
-    if (nrecv == 0)
+    // Wait for the response (or a timeout) in a nested event loop, so that
+    // other lookups can make progress while this one is outstanding.
+    Core::EventLoop wait_loop;
+    pending_lookup.wait_loop = &wait_loop;
+    auto timeout_timer = Core::Timer::create_single_shot(1000, [&] {
+        wait_loop.quit(0);
+    });
+    timeout_timer->start();
+    wait_loop.exec();
+
+    if (!pending_lookup.response.has_value())
         return {};
 
     did_get_response = true;
 
-    auto o_response = DNSPacket::from_raw_packet(response_buffer, nrecv);
-    if (!o_response.has_value())
-        return {};
-
-    auto& response = o_response.value();
-
-    if (response.id() != request.id()) {
-        dbgln("LookupServer: ID mismatch ({} vs {}) :(", response.id(), request.id());
-        return {};
-    }
+    auto& response = pending_lookup.response.value();
 
     if (response.code() == DNSPacket::Code::REFUSED) {
         if (should_randomize_case == ShouldRandomizeCase::Yes) {
@@ -316,4 +357,51 @@ void LookupServer::put_in_cache(const DNSAnswer& answer)
     }
 }
 
+void LookupServer::put_in_failed_cache(const DNSName& name, DNSRecordType record_type)
+{
+    // Prevent the failed lookup cache from growing too big.
+    if (m_failed_lookup_cache.size() >= 256)
+        m_failed_lookup_cache.remove(m_failed_lookup_cache.begin());
+
+    auto it = m_failed_lookup_cache.find(name);
+    if (it == m_failed_lookup_cache.end()) {
+        m_failed_lookup_cache.set(name, { { record_type, time(nullptr) } });
+        return;
+    }
+    it->value.remove_all_matching([&](const FailedLookup& failed_lookup) { return failed_lookup.record_type == record_type; });
+    it->value.append({ record_type, time(nullptr) });
+}
+
+bool LookupServer::FailedLookup::has_expired() const
+{
+    // How long to remember that a name has no records, in seconds.
+    static constexpr time_t negative_ttl = 60;
+    return time(nullptr) >= question_time + negative_ttl;
+}
+
+void LookupServer::handle_upstream_response()
+{
+    sockaddr_in nameserver_address;
+    auto buffer = m_upstream_socket->receive(4096, nameserver_address);
+    if (buffer.is_empty())
+        return;
+
+    auto optional_response = DNSPacket::from_raw_packet(buffer.data(), buffer.size());
+    if (!optional_response.has_value()) {
+        dbgln("LookupServer: Got an invalid response packet from upstream");
+        return;
+    }
+
+    auto it = m_pending_lookups.find(optional_response.value().id());
+    if (it == m_pending_lookups.end()) {
+        dbgln("LookupServer: Got a response for unknown ID {}, ignoring", optional_response.value().id());
+        return;
+    }
+
+    auto& pending_lookup = *it->value;
+    pending_lookup.response = optional_response.release_value();
+    if (pending_lookup.wait_loop)
+        pending_lookup.wait_loop->quit(0);
+}
+
 }
@@ -28,15 +28,35 @@ private:
 
     void load_etc_hosts();
     void put_in_cache(const DNSAnswer&);
+    void put_in_failed_cache(const DNSName&, DNSRecordType);
+    void handle_upstream_response();
+
+    // A lookup that's waiting for an upstream response. The transaction ID
+    // is used to route incoming responses back to the right waiter.
+    struct PendingLookup {
+        u16 id { 0 };
+        Optional<DNSPacket> response;
+        Core::EventLoop* wait_loop { nullptr };
+    };
+
+    // A lookup for which an upstream server answered, but had no results.
+    struct FailedLookup {
+        DNSRecordType record_type;
+        time_t question_time { 0 };
+        bool has_expired() const;
+    };
 
     Vector<DNSAnswer> lookup(const DNSName& hostname, const String& nameserver, bool& did_get_response, DNSRecordType record_type, ShouldRandomizeCase = ShouldRandomizeCase::Yes);
 
     RefPtr<Core::LocalServer> m_local_server;
     RefPtr<DNSServer> m_dns_server;
+    RefPtr<Core::UDPServer> m_upstream_socket;
     RefPtr<MulticastDNS> m_mdns;
     Vector<String> m_nameservers;
+    HashMap<u16, PendingLookup*> m_pending_lookups;
     HashMap<DNSName, Vector<DNSAnswer>, DNSName::Traits> m_etc_hosts;
     HashMap<DNSName, Vector<DNSAnswer>, DNSName::Traits> m_lookup_cache;
+    HashMap<DNSName, Vector<FailedLookup>, DNSName::Traits> m_failed_lookup_cache;
 };
 
 }
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <RequestServer/CachedRequest.h>
+#include <RequestServer/ClientConnection.h>
+
+namespace RequestServer {
+
+CachedRequest::CachedRequest(ClientConnection& client, NonnullRefPtr<HttpCache::Entry> entry, NonnullOwnPtr<OutputFileStream>&& output_stream)
+    : Request(client, move(output_stream))
+{
+    set_url(entry->url);
+    set_cache_entry(move(entry));
+    // Serve from the event loop so the client has the pipe fd and request id
+    // before any response events arrive. serve_cached_response() ends up
+    // destroying this request (and the timer along with it), which is safe
+    // because the event loop keeps the timer alive while it dispatches.
+    m_serve_timer = Core::Timer::create_single_shot(0, [this] {
+        serve_cached_response();
+    });
+    m_serve_timer->start();
+}
+
+CachedRequest::~CachedRequest()
+{
+}
+
+NonnullOwnPtr<CachedRequest> CachedRequest::create(ClientConnection& client, NonnullRefPtr<HttpCache::Entry> entry, NonnullOwnPtr<OutputFileStream>&& output_stream)
+{
+    return adopt_own(*new CachedRequest(client, move(entry), move(output_stream)));
+}
+
+}
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Badge.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/RefPtr.h>
+#include <LibCore/Timer.h>
+#include <RequestServer/HttpCache.h>
+#include <RequestServer/Request.h>
+
+namespace RequestServer {
+
+// A request that is satisfied entirely by a fresh HttpCache entry, without
+// starting a network job. The cached response is served on the next event
+// loop iteration, after the client has received the request id and pipe fd.
+class CachedRequest final : public Request {
+public:
+    virtual ~CachedRequest() override;
+
+    static NonnullOwnPtr<CachedRequest> create(ClientConnection&, NonnullRefPtr<HttpCache::Entry>, NonnullOwnPtr<OutputFileStream>&&);
+
+private:
+    explicit CachedRequest(ClientConnection&, NonnullRefPtr<HttpCache::Entry>, NonnullOwnPtr<OutputFileStream>&&);
+
+    RefPtr<Core::Timer> m_serve_timer;
+};
+
+}
@@ -5,6 +5,9 @@
  */
 
 #include <AK/Badge.h>
+#include <LibIPC/ServerConnection.h>
+#include <LookupServer/LookupClientEndpoint.h>
+#include <LookupServer/LookupServerEndpoint.h>
 #include <RequestServer/ClientConnection.h>
 #include <RequestServer/Protocol.h>
 #include <RequestServer/Request.h>
@@ -12,6 +15,28 @@
 
 namespace RequestServer {
 
+// A fire-and-forget connection to LookupServer, used to warm up its DNS
+// cache for hosts we expect to connect to soon.
+class LookupClient final
+    : public IPC::ServerConnection<LookupClientEndpoint, LookupServerEndpoint>
+    , public LookupClientEndpoint {
+    C_OBJECT(LookupClient);
+
+public:
+    virtual void die() override
+    {
+        dbgln("RequestServer: Lost connection to LookupServer");
+    }
+
+private:
+    LookupClient()
+        : IPC::ServerConnection<LookupClientEndpoint, LookupServerEndpoint>(*this, "/tmp/portal/lookup")
+    {
+    }
+
+    virtual void dummy() override { }
+};
+
 static HashMap<int, RefPtr<ClientConnection>> s_connections;
 
 ClientConnection::ClientConnection(NonnullRefPtr<Core::LocalSocket> socket, int client_id)
@@ -110,4 +135,12 @@ Messages::RequestServer::SetCertificateResponse ClientConnection::set_certificat
     return success;
 }
 
+void ClientConnection::prefetch_dns(URL const& url)
+{
+    if (!url.is_valid() || url.host().is_empty())
+        return;
+    static auto lookup_client = LookupClient::construct();
+    lookup_client->async_prefetch_name(url.host());
+}
+
 }
@@ -8,7 +8,9 @@
 
 namespace RequestServer {
 
+class CachedRequest;
 class ClientConnection;
+class HttpCache;
 class Request;
 class GeminiProtocol;
 class HttpRequest;
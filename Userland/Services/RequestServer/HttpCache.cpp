@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
+#include <LibCore/File.h>
+#include <LibCore/StandardPaths.h>
+#include <RequestServer/HttpCache.h>
+#include <sys/stat.h>
+#include <time.h>
+
+namespace RequestServer {
+
+HttpCache& HttpCache::the()
+{
+    static HttpCache cache;
+    return cache;
+}
+
+HttpCache::HttpCache()
+{
+    auto cache_base = String::formatted("{}/.cache", Core::StandardPaths::home_directory());
+    m_directory = String::formatted("{}/RequestServer", cache_base);
+    if (mkdir(cache_base.characters(), 0700) < 0 && errno != EEXIST)
+        return;
+    if (mkdir(m_directory.characters(), 0700) < 0 && errno != EEXIST)
+        return;
+    m_enabled = true;
+}
+
+bool HttpCache::Entry::is_fresh() const
+{
+    return expires_at > time(nullptr);
+}
+
+String HttpCache::meta_path_for_url(const URL& url) const
+{
+    return String::formatted("{}/{:08x}.meta", m_directory, url.to_string().hash());
+}
+
+String HttpCache::data_path_for_url(const URL& url) const
+{
+    return String::formatted("{}/{:08x}.data", m_directory, url.to_string().hash());
+}
+
+RefPtr<HttpCache::Entry> HttpCache::open(const URL& url)
+{
+    if (!m_enabled)
+        return {};
+
+    auto meta_file_or_error = Core::File::open(meta_path_for_url(url), Core::OpenMode::ReadOnly);
+    if (meta_file_or_error.is_error())
+        return {};
+    auto meta_json = JsonValue::from_string(meta_file_or_error.value()->read_all());
+    if (!meta_json.has_value() || !meta_json->is_object())
+        return {};
+    auto& meta = meta_json->as_object();
+
+    // The file name is only a hash of the URL, so make sure this entry is
+    // actually for the URL we were asked about.
+    if (meta.get("url").as_string_or({}) != url.to_string())
+        return {};
+
+    auto data_file_or_error = Core::File::open(data_path_for_url(url), Core::OpenMode::ReadOnly);
+    if (data_file_or_error.is_error())
+        return {};
+
+    auto headers = meta.get("headers");
+    if (!headers.is_object())
+        return {};
+
+    auto entry = adopt_ref(*new Entry);
+    entry->url = url;
+    entry->status_code = meta.get("status_code").to_u32();
+    entry->expires_at = meta.get("expires_at").to_i64();
+    headers.as_object().for_each_member([&](auto& key, auto& value) {
+        entry->response_headers.set(key, value.as_string_or({}));
+    });
+    entry->body = data_file_or_error.value()->read_all();
+    return entry;
+}
+
+bool HttpCache::is_cacheable(u32 status_code, const HashMap<String, String, CaseInsensitiveStringTraits>& response_headers)
+{
+    if (status_code != 200)
+        return false;
+    auto cache_control = response_headers.get("Cache-Control").value_or({});
+    if (cache_control.contains("no-store") || cache_control.contains("private"))
+        return false;
+    if (cache_control.contains("max-age="))
+        return true;
+    // Without an explicit lifetime we can still cache the response if it
+    // carries a validator we can revalidate it with.
+    return response_headers.contains("ETag") || response_headers.contains("Last-Modified");
+}
+
+static time_t compute_expiry(const HashMap<String, String, CaseInsensitiveStringTraits>& response_headers)
+{
+    auto cache_control = response_headers.get("Cache-Control").value_or({});
+    if (cache_control.contains("no-cache"))
+        return 0;
+    for (auto& directive : cache_control.split(',')) {
+        auto trimmed = directive.trim_whitespace();
+        if (!trimmed.starts_with("max-age="))
+            continue;
+        auto max_age = trimmed.substring_view(8).to_uint();
+        if (max_age.has_value())
+            return time(nullptr) + max_age.value();
+    }
+    return 0;
+}
+
+bool HttpCache::write_meta(const Entry& entry)
+{
+    JsonObject headers;
+    for (auto& it : entry.response_headers)
+        headers.set(it.key, it.value);
+
+    JsonObject meta;
+    meta.set("url", entry.url.to_string());
+    meta.set("status_code", entry.status_code);
+    meta.set("expires_at", (i64)entry.expires_at);
+    meta.set("headers", move(headers));
+
+    auto meta_file_or_error = Core::File::open(meta_path_for_url(entry.url), (Core::OpenMode)(Core::OpenMode::WriteOnly | Core::OpenMode::Truncate));
+    if (meta_file_or_error.is_error())
+        return false;
+    return meta_file_or_error.value()->write(meta.to_string());
+}
+
+void HttpCache::store(const URL& url, u32 status_code, const HashMap<String, String, CaseInsensitiveStringTraits>& response_headers, ReadonlyBytes body)
+{
+    if (!m_enabled)
+        return;
+    if (body.size() > max_cacheable_body_size)
+        return;
+
+    auto entry = adopt_ref(*new Entry);
+    entry->url = url;
+    entry->status_code = status_code;
+    entry->expires_at = compute_expiry(response_headers);
+    entry->response_headers = response_headers;
+
+    auto data_file_or_error = Core::File::open(data_path_for_url(url), (Core::OpenMode)(Core::OpenMode::WriteOnly | Core::OpenMode::Truncate));
+    if (data_file_or_error.is_error())
+        return;
+    if (!data_file_or_error.value()->write(body.data(), body.size()))
+        return;
+
+    // Written after the data so a crash in between leaves a stale data file
+    // that no metadata points at, rather than metadata for a torn body.
+    write_meta(*entry);
+}
+
+void HttpCache::refresh(Entry& entry, const HashMap<String, String, CaseInsensitiveStringTraits>& response_headers)
+{
+    if (!m_enabled)
+        return;
+    for (auto& it : response_headers)
+        entry.response_headers.set(it.key, it.value);
+    entry.expires_at = compute_expiry(entry.response_headers);
+    write_meta(entry);
+}
+
+}
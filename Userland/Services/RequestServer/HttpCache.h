@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/FileStream.h>
+#include <AK/HashMap.h>
+#include <AK/RefCounted.h>
+#include <AK/RefPtr.h>
+#include <AK/String.h>
+#include <AK/URL.h>
+
+namespace RequestServer {
+
+// A disk cache for HTTP responses, stored under ~/.cache/RequestServer.
+// Each cached response is a pair of files named after the URL's hash: a
+// ".meta" file (JSON: URL, status code, expiry, response headers) and a
+// ".data" file holding the raw body. The filesystem is the index; the
+// stored URL is checked on every hit so hash collisions degrade into
+// misses instead of serving the wrong resource.
+class HttpCache {
+public:
+    static HttpCache& the();
+
+    struct Entry : public RefCounted<Entry> {
+        URL url;
+        u32 status_code { 0 };
+        // 0 means the entry must be revalidated before use.
+        time_t expires_at { 0 };
+        HashMap<String, String, CaseInsensitiveStringTraits> response_headers;
+        ByteBuffer body;
+
+        bool is_fresh() const;
+        String etag() const { return response_headers.get("ETag").value_or({}); }
+        String last_modified() const { return response_headers.get("Last-Modified").value_or({}); }
+    };
+
+    // Bodies larger than this are never cached; they would also make
+    // serving a hit through the request pipe unreasonably bursty.
+    static constexpr size_t max_cacheable_body_size = 4 * MiB;
+
+    RefPtr<Entry> open(const URL&);
+    void store(const URL&, u32 status_code, const HashMap<String, String, CaseInsensitiveStringTraits>& response_headers, ReadonlyBytes body);
+    // Called after a 304: merges the revalidated headers into the entry and
+    // rewrites its metadata with the new expiry.
+    void refresh(Entry&, const HashMap<String, String, CaseInsensitiveStringTraits>& response_headers);
+
+    static bool is_cacheable(u32 status_code, const HashMap<String, String, CaseInsensitiveStringTraits>& response_headers);
+
+private:
+    HttpCache();
+
+    bool write_meta(const Entry&);
+    String meta_path_for_url(const URL&) const;
+    String data_path_for_url(const URL&) const;
+
+    String m_directory;
+    bool m_enabled { false };
+};
+
+// An OutputFileStream that additionally keeps a copy of everything written
+// through it, so a response streamed to the client pipe can be committed to
+// the cache once the job finishes. Collection stops (and the response
+// becomes uncacheable) once the body exceeds max_cacheable_body_size.
+class CachingOutputFileStream final : public OutputFileStream {
+public:
+    explicit CachingOutputFileStream(int fd)
+        : OutputFileStream(fd)
+    {
+    }
+
+    size_t write(ReadonlyBytes bytes) override
+    {
+        if (!m_overflowed) {
+            if (m_collected_body.size() + bytes.size() > HttpCache::max_cacheable_body_size) {
+                m_overflowed = true;
+                m_collected_body.clear();
+            } else {
+                m_collected_body.append(bytes.data(), bytes.size());
+            }
+        }
+        return OutputFileStream::write(bytes);
+    }
+
+    bool write_or_error(ReadonlyBytes bytes) override
+    {
+        auto nwritten = write(bytes);
+        if (nwritten < bytes.size()) {
+            set_recoverable_error();
+            return false;
+        }
+        return true;
+    }
+
+    bool collected_entire_body() const { return !m_overflowed; }
+    ReadonlyBytes collected_body() const { return m_collected_body; }
+
+private:
+    ByteBuffer m_collected_body;
+    bool m_overflowed { false };
+};
+
+}
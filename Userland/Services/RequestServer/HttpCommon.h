@@ -14,7 +14,9 @@
 #include <AK/String.h>
 #include <AK/Types.h>
 #include <LibHTTP/HttpRequest.h>
+#include <RequestServer/CachedRequest.h>
 #include <RequestServer/ClientConnection.h>
+#include <RequestServer/HttpCache.h>
 #include <RequestServer/Request.h>
 
 namespace RequestServer::Detail {
@@ -23,6 +25,10 @@ template<typename TSelf, typename TJob>
 void init(TSelf* self, TJob job)
 {
     job->on_headers_received = [self](auto& headers, auto response_code) {
+        // A 304 while revalidating means the cached body is still valid;
+        // hold the headers back and let on_finish() serve the cache entry.
+        if (self->cache_entry() && response_code.has_value() && response_code.value() == 304)
+            return;
         if (response_code.has_value())
             self->set_status_code(response_code.value());
         self->set_response_headers(headers);
@@ -30,9 +36,21 @@ void init(TSelf* self, TJob job)
 
     job->on_finish = [self](bool success) {
         if (auto* response = self->job().response()) {
+            if (success && response->code() == 304 && self->cache_entry()) {
+                HttpCache::the().refresh(*self->cache_entry(), response->headers());
+                self->serve_cached_response();
+                return;
+            }
             self->set_status_code(response->code());
             self->set_response_headers(response->headers());
             self->set_downloaded_size(self->output_stream().size());
+
+            if (success && self->job().request().method() == HTTP::HttpRequest::Method::GET) {
+                // GET requests always stream through a CachingOutputFileStream (see start_request() below).
+                auto& caching_stream = static_cast<const CachingOutputFileStream&>(self->output_stream());
+                if (caching_stream.collected_entire_body() && HttpCache::is_cacheable(response->code(), response->headers()))
+                    HttpCache::the().store(self->url(), response->code(), response->headers(), caching_stream.collected_body());
+            }
         }
 
         // if we didn't know the total size, pretend that the request finished successfully
@@ -68,14 +86,42 @@ OwnPtr<Request> start_request(TBadgedProtocol&& protocol, ClientConnection& clie
     else
         request.set_method(HTTP::HttpRequest::Method::GET);
     request.set_url(url);
-    request.set_headers(headers);
+
+    RefPtr<HttpCache::Entry> cache_entry;
+    if (request.method() == HTTP::HttpRequest::Method::GET)
+        cache_entry = HttpCache::the().open(url);
+
+    if (cache_entry && cache_entry->is_fresh()) {
+        auto output_stream = make<OutputFileStream>(pipe_result.value().write_fd);
+        output_stream->make_unbuffered();
+        auto protocol_request = CachedRequest::create(client, cache_entry.release_nonnull(), move(output_stream));
+        protocol_request->set_request_fd(pipe_result.value().read_fd);
+        return protocol_request;
+    }
+
+    auto request_headers = headers;
+    if (cache_entry) {
+        // The entry is stale; send its validators along so the server can
+        // answer with a 304 and we can serve the cached body.
+        if (auto etag = cache_entry->etag(); !etag.is_empty())
+            request_headers.set("If-None-Match", etag);
+        if (auto last_modified = cache_entry->last_modified(); !last_modified.is_empty())
+            request_headers.set("If-Modified-Since", last_modified);
+    }
+    request.set_headers(request_headers);
     request.set_body(body);
 
-    auto output_stream = make<OutputFileStream>(pipe_result.value().write_fd);
+    OwnPtr<OutputFileStream> output_stream;
+    if (request.method() == HTTP::HttpRequest::Method::GET)
+        output_stream = make<CachingOutputFileStream>(pipe_result.value().write_fd);
+    else
+        output_stream = make<OutputFileStream>(pipe_result.value().write_fd);
     output_stream->make_unbuffered();
     auto job = TJob::construct(request, *output_stream);
-    auto protocol_request = TRequest::create_with_job(forward<TBadgedProtocol>(protocol), client, (TJob&)*job, move(output_stream));
+    auto protocol_request = TRequest::create_with_job(forward<TBadgedProtocol>(protocol), client, (TJob&)*job, output_stream.release_nonnull());
     protocol_request->set_request_fd(pipe_result.value().read_fd);
+    protocol_request->set_url(url);
+    protocol_request->set_cache_entry(move(cache_entry));
     job->start();
     return protocol_request;
 }
@@ -5,6 +5,7 @@
  */
 
 #include <AK/Badge.h>
+#include <LibCore/Tracing.h>
 #include <RequestServer/ClientConnection.h>
 #include <RequestServer/Request.h>
 
@@ -13,15 +14,20 @@ namespace RequestServer {
 // FIXME: What about rollover?
 static i32 s_next_id = 1;
 
+// Trace span kinds are RequestServer-local; 1 covers a request's lifetime.
+static constexpr uintptr_t request_span_kind = 1;
+
 Request::Request(ClientConnection& client, NonnullOwnPtr<OutputFileStream>&& output_stream)
     : m_client(client)
     , m_id(s_next_id++)
     , m_output_stream(move(output_stream))
 {
+    m_trace_cookie = CORE_TRACE_BEGIN(request_span_kind);
 }
 
 Request::~Request()
 {
+    CORE_TRACE_END(m_trace_cookie);
 }
 
 void Request::stop()
@@ -56,4 +62,17 @@ void Request::did_request_certificates()
     m_client.did_request_certificates({}, *this);
 }
 
+void Request::serve_cached_response()
+{
+    VERIFY(m_cache_entry);
+    auto entry = m_cache_entry;
+
+    bool success = m_output_stream->write_or_error(entry->body);
+    set_status_code(entry->status_code);
+    set_response_headers(entry->response_headers);
+    did_progress(entry->body.size(), entry->body.size());
+    // Note: did_finish() may destroy this request.
+    did_finish(success);
+}
+
 }
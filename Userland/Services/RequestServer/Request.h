@@ -11,8 +11,10 @@
 #include <AK/NonnullOwnPtr.h>
 #include <AK/Optional.h>
 #include <AK/RefCounted.h>
+#include <AK/RefPtr.h>
 #include <AK/URL.h>
 #include <RequestServer/Forward.h>
+#include <RequestServer/HttpCache.h>
 
 namespace RequestServer {
 
@@ -35,6 +37,14 @@ public:
     void set_request_fd(int fd) { m_request_fd = fd; }
     int request_fd() const { return m_request_fd; }
 
+    void set_url(URL url) { m_url = move(url); }
+
+    // The cache entry backing this request: either a fresh entry being
+    // served directly, or a stale one whose validators are on the wire.
+    void set_cache_entry(RefPtr<HttpCache::Entry> entry) { m_cache_entry = move(entry); }
+    HttpCache::Entry* cache_entry() { return m_cache_entry.ptr(); }
+    void serve_cached_response();
+
     void did_finish(bool success);
     void did_progress(Optional<u32> total_size, u32 downloaded_size);
     void set_status_code(u32 status_code) { m_status_code = status_code; }
@@ -46,6 +56,8 @@ public:
 protected:
     explicit Request(ClientConnection&, NonnullOwnPtr<OutputFileStream>&&);
 
+    OutputFileStream& output_stream() { return *m_output_stream; }
+
 private:
     ClientConnection& m_client;
     i32 m_id { 0 };
@@ -54,8 +66,10 @@ private:
     Optional<u32> m_status_code;
     Optional<u32> m_total_size {};
     size_t m_downloaded_size { 0 };
+    uintptr_t m_trace_cookie { 0 };
     NonnullOwnPtr<OutputFileStream> m_output_stream;
     HashMap<String, String, CaseInsensitiveStringTraits> m_response_headers;
+    RefPtr<HttpCache::Entry> m_cache_entry;
 };
 
 }
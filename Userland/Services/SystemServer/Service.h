@@ -21,6 +21,8 @@ public:
     void activate();
     void did_exit(int exit_code);
 
+    int priority() const { return m_priority; }
+
     static Service* find_by_pid(pid_t);
 
     // FIXME: Port to Core::Property
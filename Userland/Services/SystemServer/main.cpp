@@ -8,6 +8,9 @@
 #include <AK/Assertions.h>
 #include <AK/ByteBuffer.h>
 #include <AK/Debug.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/QuickSort.h>
+#include <AK/Vector.h>
 #include <LibCore/ConfigFile.h>
 #include <LibCore/Event.h>
 #include <LibCore/EventLoop.h>
@@ -194,8 +197,11 @@ int main(int, char**)
     event_loop.register_signal(SIGCHLD, sigchld_handler);
 
     // Read our config and instantiate services.
-    // This takes care of setting up sockets.
-    NonnullRefPtrVector<Service> services;
+    // This takes care of setting up sockets, so by the time we start activating
+    // services below, every listening socket already exists and dependents can
+    // connect (and block in the kernel) before their provider has finished
+    // initializing.
+    Vector<NonnullRefPtr<Service>> services;
     auto config = Core::ConfigFile::get_for_system("SystemServer");
     for (auto name : config->groups()) {
         auto service = Service::construct(*config, name);
@@ -203,10 +209,13 @@ int main(int, char**)
             services.append(service);
     }
 
-    // After we've set them all up, activate them!
+    // After we've set them all up, activate them, highest priority first, so
+    // that the important servers (e.g. WindowServer) get scheduled first.
+    quick_sort(services, [](auto& a, auto& b) { return a->priority() > b->priority(); });
+
     dbgln("Activating {} services...", services.size());
     for (auto& service : services)
-        service.activate();
+        service->activate();
 
     return event_loop.exec();
 }
@@ -16,9 +16,34 @@
 #include <stdio.h>
 #include <unistd.h>
 
+// Read buffers are recycled through a small pool so that connection churn
+// doesn't cost an allocation per client.
+static constexpr size_t client_buffer_size = 4 * KiB;
+static constexpr size_t max_pooled_buffers = 16;
+
+static Vector<ByteBuffer>& buffer_pool()
+{
+    static Vector<ByteBuffer> pool;
+    return pool;
+}
+
+static ByteBuffer take_pooled_buffer()
+{
+    if (!buffer_pool().is_empty())
+        return buffer_pool().take_last();
+    return ByteBuffer::create_uninitialized(client_buffer_size);
+}
+
+static void return_pooled_buffer(ByteBuffer buffer)
+{
+    if (buffer_pool().size() < max_pooled_buffers)
+        buffer_pool().append(move(buffer));
+}
+
 Client::Client(int id, RefPtr<Core::TCPSocket> socket, int ptm_fd)
     : m_id(id)
     , m_socket(move(socket))
+    , m_buffer(take_pooled_buffer())
     , m_ptm_fd(ptm_fd)
     , m_ptm_notifier(Core::Notifier::construct(ptm_fd, Core::Notifier::Read))
 {
@@ -35,18 +60,27 @@ Client::Client(int id, RefPtr<Core::TCPSocket> socket, int ptm_fd)
     });
 }
 
+Client::~Client()
+{
+    return_pooled_buffer(move(m_buffer));
+}
+
 void Client::drain_socket()
 {
     NonnullRefPtr<Client> protect(*this);
     while (m_socket->can_read()) {
-        auto buf = m_socket->read(1024);
+        auto nread = m_socket->read(m_buffer.data(), m_buffer.size());
 
-        m_parser.write(buf);
+        if (nread > 0)
+            m_parser.write(StringView((const char*)m_buffer.data(), (size_t)nread));
 
         if (m_socket->eof()) {
             quit();
             break;
         }
+
+        if (nread <= 0)
+            break;
     }
 }
 
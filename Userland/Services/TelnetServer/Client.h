@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/String.h>
 #include <AK/StringView.h>
 #include <AK/Types.h>
@@ -21,6 +22,7 @@ public:
     {
         return adopt_ref(*new Client(id, move(socket), ptm_fd));
     }
+    ~Client();
 
     Function<void()> on_exit;
 
@@ -42,6 +44,7 @@ private:
     int m_id { 0 };
     // client resources
     RefPtr<Core::TCPSocket> m_socket;
+    ByteBuffer m_buffer;
     Parser m_parser;
     // pty resources
     int m_ptm_fd { -1 };
@@ -19,6 +19,7 @@
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/Dump.h>
 #include <LibWeb/Layout/InitialContainingBlockBox.h>
+#include <LibWeb/Loader/FrameLoader.h>
 #include <LibWeb/Loader/ResourceLoader.h>
 #include <LibWeb/Page/Frame.h>
 #include <WebContent/ClientConnection.h>
@@ -77,7 +78,7 @@ void ClientConnection::update_screen_rect(const Gfx::IntRect& rect)
     m_page_host->set_screen_rect(rect);
 }
 
-void ClientConnection::load_url(const URL& url)
+void ClientConnection::load_url(const URL& url, bool is_history_navigation)
 {
     dbgln_if(SPAM_DEBUG, "handle: WebContentServer::LoadURL: url={}", url);
 
@@ -89,7 +90,8 @@ void ClientConnection::load_url(const URL& url)
 
     pthread_setname_np(pthread_self(), process_name.characters());
 
-    page().load(url);
+    auto type = is_history_navigation ? Web::FrameLoader::Type::HistoryNavigation : Web::FrameLoader::Type::Navigation;
+    page().main_frame().loader().load(url, type);
 }
 
 void ClientConnection::load_html(const String& html, const URL& url)
@@ -44,6 +44,7 @@ Gfx::Palette PageHost::palette() const
 void PageHost::set_palette_impl(const Gfx::PaletteImpl& impl)
 {
     m_palette_impl = impl;
+    invalidate_paint_cache();
 }
 
 Web::Layout::InitialContainingBlockBox* PageHost::layout_root()
@@ -54,6 +55,23 @@ Web::Layout::InitialContainingBlockBox* PageHost::layout_root()
     return document->layout_node();
 }
 
+static constexpr size_t max_paint_cache_dirty_rects = 32;
+
+void PageHost::invalidate_paint_cache()
+{
+    m_paint_cache_valid = false;
+    m_last_painted_bitmap = nullptr;
+    m_paint_cache_dirty_rects.clear();
+}
+
+void PageHost::paint_into(Gfx::Painter& painter, const Gfx::IntRect& content_rect)
+{
+    Web::PaintContext context(painter, palette(), content_rect.top_left());
+    context.set_should_show_line_box_borders(m_should_show_line_box_borders);
+    context.set_viewport_rect(content_rect);
+    layout_root()->paint_all_phases(context);
+}
+
 void PageHost::paint(const Gfx::IntRect& content_rect, Gfx::Bitmap& target)
 {
     Gfx::Painter painter(target);
@@ -61,14 +79,46 @@ void PageHost::paint(const Gfx::IntRect& content_rect, Gfx::Bitmap& target)
 
     auto* layout_root = this->layout_root();
     if (!layout_root) {
+        invalidate_paint_cache();
         painter.fill_rect(bitmap_rect, Color::White);
         return;
     }
 
-    Web::PaintContext context(painter, palette(), content_rect.top_left());
-    context.set_should_show_line_box_borders(m_should_show_line_box_borders);
-    context.set_viewport_rect(content_rect);
-    layout_root->paint_all_phases(context);
+    // Repaints the whole layout tree, but with the painter clipped to the
+    // given content rect, so only pixels inside it are actually touched.
+    // (We keep the full viewport rect on the context so that viewport
+    // culling, e.g. image visibility tracking, is unaffected.)
+    auto repaint_content_rect = [&](const Gfx::IntRect& rect) {
+        painter.save();
+        painter.add_clip_rect(rect.translated(-content_rect.location()));
+        paint_into(painter, content_rect);
+        painter.restore();
+    };
+
+    // NOTE: Blitting within a single bitmap could clobber source rows before
+    //       they're copied, so the previous frame has to live in a different
+    //       backing store than the one we're painting into.
+    auto reusable_content_rect = m_paint_cache_valid && m_last_painted_bitmap && m_last_painted_bitmap.ptr() != &target && m_last_painted_content_rect.size() == content_rect.size()
+        ? content_rect.intersected(m_last_painted_content_rect)
+        : Gfx::IntRect {};
+
+    if (!reusable_content_rect.is_empty()) {
+        painter.blit(reusable_content_rect.location().translated(-content_rect.location()), *m_last_painted_bitmap, reusable_content_rect.translated(-m_last_painted_content_rect.location()));
+        for (auto& exposed_rect : content_rect.shatter(reusable_content_rect))
+            repaint_content_rect(exposed_rect);
+        for (auto& dirty_rect : m_paint_cache_dirty_rects) {
+            auto stale_rect = dirty_rect.intersected(reusable_content_rect);
+            if (!stale_rect.is_empty())
+                repaint_content_rect(stale_rect);
+        }
+    } else {
+        paint_into(painter, content_rect);
+    }
+
+    m_last_painted_bitmap = &target;
+    m_last_painted_content_rect = content_rect;
+    m_paint_cache_dirty_rects.clear();
+    m_paint_cache_valid = true;
 }
 
 void PageHost::set_viewport_rect(const Gfx::IntRect& rect)
@@ -78,11 +128,18 @@ void PageHost::set_viewport_rect(const Gfx::IntRect& rect)
 
 void PageHost::page_did_invalidate(const Gfx::IntRect& content_rect)
 {
+    if (m_paint_cache_dirty_rects.size() >= max_paint_cache_dirty_rects)
+        m_paint_cache_valid = false;
+    else
+        m_paint_cache_dirty_rects.append(content_rect);
     m_client.async_did_invalidate_content_rect(content_rect);
 }
 
 void PageHost::page_did_change_selection()
 {
+    // NOTE: Selection changes don't come with invalidation rects, so drop the
+    //       whole cached frame.
+    invalidate_paint_cache();
     m_client.async_did_change_selection();
 }
 
@@ -93,6 +150,7 @@ void PageHost::page_did_request_cursor_change(Gfx::StandardCursor cursor)
 
 void PageHost::page_did_layout()
 {
+    invalidate_paint_cache();
     auto* layout_root = this->layout_root();
     VERIFY(layout_root);
     auto content_size = enclosing_int_rect(layout_root->absolute_rect()).size();
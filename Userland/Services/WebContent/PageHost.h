@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <LibGfx/Forward.h>
 #include <LibGfx/Rect.h>
 #include <LibWeb/Page/Page.h>
 
@@ -30,7 +31,11 @@ public:
     void set_viewport_rect(const Gfx::IntRect&);
     void set_screen_rect(const Gfx::IntRect& rect) { m_screen_rect = rect; };
 
-    void set_should_show_line_box_borders(bool b) { m_should_show_line_box_borders = b; }
+    void set_should_show_line_box_borders(bool b)
+    {
+        m_should_show_line_box_borders = b;
+        invalidate_paint_cache();
+    }
 
 private:
     // ^PageClient
@@ -67,11 +72,25 @@ private:
     Web::Layout::InitialContainingBlockBox* layout_root();
     void setup_palette();
 
+    void paint_into(Gfx::Painter&, const Gfx::IntRect& content_rect);
+    void invalidate_paint_cache();
+
     ClientConnection& m_client;
     NonnullOwnPtr<Web::Page> m_page;
     RefPtr<Gfx::PaletteImpl> m_palette_impl;
     Gfx::IntRect m_screen_rect;
     bool m_should_show_line_box_borders { false };
+
+    // The shared backing store we last painted into, and the content rect it
+    // covers. Since the client double-buffers its (shared-memory) backing
+    // stores, the previous frame's pixels are still mapped right here in this
+    // process: when only the scroll position has changed, paint() blits the
+    // overlap straight from the old store and repaints just the newly exposed
+    // strips and any rects invalidated since.
+    RefPtr<Gfx::Bitmap> m_last_painted_bitmap;
+    Gfx::IntRect m_last_painted_content_rect;
+    Vector<Gfx::IntRect> m_paint_cache_dirty_rects;
+    bool m_paint_cache_valid { false };
 };
 
 }
@@ -6,6 +6,7 @@
 
 #include "Client.h"
 #include <AK/Base64.h>
+#include <AK/HashMap.h>
 #include <AK/LexicalPath.h>
 #include <AK/MappedFile.h>
 #include <AK/MemoryStream.h>
@@ -14,17 +15,76 @@
 #include <LibCore/DateTime.h>
 #include <LibCore/DirIterator.h>
 #include <LibCore/File.h>
-#include <LibCore/FileStream.h>
 #include <LibCore/MimeData.h>
 #include <LibHTTP/HttpRequest.h>
 #include <inttypes.h>
 #include <stdio.h>
+#include <sys/sendfile.h>
 #include <sys/stat.h>
 #include <time.h>
 #include <unistd.h>
 
 namespace WebServer {
 
+// Serving a static file only costs a stat() once it is cached: the open file
+// description, the file's size and the fully formatted response headers are
+// all reused until the file's mtime or size change.
+struct CachedFile : public RefCounted<CachedFile> {
+    CachedFile(NonnullRefPtr<Core::File> file, time_t mtime, off_t size, String response_headers)
+        : file(move(file))
+        , mtime(mtime)
+        , size(size)
+        , response_headers(move(response_headers))
+    {
+    }
+
+    NonnullRefPtr<Core::File> file;
+    time_t mtime { 0 };
+    off_t size { 0 };
+    String response_headers;
+};
+
+static constexpr size_t max_cached_files = 32;
+
+static HashMap<String, NonnullRefPtr<CachedFile>>& file_cache()
+{
+    static HashMap<String, NonnullRefPtr<CachedFile>> cache;
+    return cache;
+}
+
+static RefPtr<CachedFile> fetch_cached_file(const String& real_path)
+{
+    struct stat st;
+    if (stat(real_path.characters(), &st) < 0 || !S_ISREG(st.st_mode))
+        return {};
+
+    auto it = file_cache().find(real_path);
+    if (it != file_cache().end() && it->value->mtime == st.st_mtime && it->value->size == st.st_size)
+        return it->value;
+
+    auto file = Core::File::construct(real_path);
+    if (!file->open(Core::OpenMode::ReadOnly))
+        return {};
+
+    StringBuilder builder;
+    builder.append("HTTP/1.0 200 OK\r\n");
+    builder.append("Server: WebServer (SerenityOS)\r\n");
+    builder.append("X-Frame-Options: SAMEORIGIN\r\n");
+    builder.append("X-Content-Type-Options: nosniff\r\n");
+    builder.append("Pragma: no-cache\r\n");
+    builder.appendff("Content-Length: {}\r\n", st.st_size);
+    builder.append("Content-Type: ");
+    builder.append(Core::guess_mime_type_based_on_filename(real_path));
+    builder.append("\r\n");
+    builder.append("\r\n");
+
+    auto cached_file = adopt_ref(*new CachedFile(*file, st.st_mtime, st.st_size, builder.to_string()));
+    if (file_cache().size() >= max_cached_files)
+        file_cache().clear();
+    file_cache().set(real_path, *cached_file);
+    return cached_file;
+}
+
 Client::Client(NonnullRefPtr<Core::TCPSocket> socket, const String& root, Core::Object* parent)
     : Core::Object(parent)
     , m_socket(socket)
@@ -105,18 +165,16 @@ void Client::handle_request(ReadonlyBytes raw_request)
         real_path = index_html_path;
     }
 
-    auto file = Core::File::construct(real_path);
-    if (!file->open(Core::OpenMode::ReadOnly)) {
+    auto cached_file = fetch_cached_file(real_path);
+    if (!cached_file) {
         send_error_response(404, "Not found!", request);
         return;
     }
 
-    Core::InputFileStream stream { file };
-
-    send_response(stream, request, Core::guess_mime_type_based_on_filename(real_path));
+    send_file_response(*cached_file, request);
 }
 
-void Client::send_response(InputStream& response, const HTTP::HttpRequest& request, const String& content_type)
+void Client::send_response_headers(const HTTP::HttpRequest& request, const String& content_type)
 {
     StringBuilder builder;
     builder.append("HTTP/1.0 200 OK\r\n");
@@ -131,6 +189,11 @@ void Client::send_response(InputStream& response, const HTTP::HttpRequest& reque
 
     m_socket->write(builder.to_string());
     log_response(200, request);
+}
+
+void Client::send_response(InputStream& response, const HTTP::HttpRequest& request, const String& content_type)
+{
+    send_response_headers(request, content_type);
 
     char buffer[PAGE_SIZE];
     do {
@@ -142,6 +205,27 @@ void Client::send_response(InputStream& response, const HTTP::HttpRequest& reque
     } while (true);
 }
 
+void Client::send_file_response(CachedFile& cached_file, const HTTP::HttpRequest& request)
+{
+    m_socket->write(cached_file.response_headers);
+    log_response(200, request);
+
+    // Let the kernel stream the file straight into the socket instead of
+    // shuttling every page through this process. The explicit offset leaves
+    // the cached file description's own offset untouched, so every request
+    // can share the same description.
+    off_t offset = 0;
+    while (offset < cached_file.size) {
+        auto nsent = sendfile(m_socket->fd(), cached_file.file->fd(), &offset, cached_file.size - offset);
+        if (nsent < 0) {
+            perror("sendfile");
+            break;
+        }
+        if (nsent == 0)
+            break;
+    }
+}
+
 void Client::send_redirect(StringView redirect_path, const HTTP::HttpRequest& request)
 {
     StringBuilder builder;
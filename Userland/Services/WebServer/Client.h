@@ -6,12 +6,15 @@
 
 #pragma once
 
+#include <LibCore/Forward.h>
 #include <LibCore/Object.h>
 #include <LibCore/TCPSocket.h>
 #include <LibHTTP/Forward.h>
 
 namespace WebServer {
 
+struct CachedFile;
+
 class Client final : public Core::Object {
     C_OBJECT(Client);
 
@@ -23,6 +26,8 @@ private:
 
     void handle_request(ReadonlyBytes);
     void send_response(InputStream&, const HTTP::HttpRequest&, const String& content_type);
+    void send_file_response(CachedFile&, const HTTP::HttpRequest&);
+    void send_response_headers(const HTTP::HttpRequest&, const String& content_type);
     void send_redirect(StringView redirect, const HTTP::HttpRequest& request);
     void send_error_response(unsigned code, const StringView& message, const HTTP::HttpRequest&);
     void die();
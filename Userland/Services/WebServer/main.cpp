@@ -19,9 +19,11 @@ int main(int argc, char** argv)
     const char* root_path = "/www";
 
     int port = default_port;
+    int workers = 1;
 
     Core::ArgsParser args_parser;
     args_parser.add_option(port, "Port to listen on", "port", 'p', "port");
+    args_parser.add_option(workers, "Number of worker processes sharing the listen port", "workers", 'w', "count");
     args_parser.add_positional_argument(root_path, "Path to serve the contents of", "path", Core::ArgsParser::Required::No);
     args_parser.parse(argc, argv);
 
@@ -37,14 +39,35 @@ int main(int argc, char** argv)
         return 1;
     }
 
-    if (pledge("stdio accept rpath inet unix", nullptr) < 0) {
+    if (workers < 1)
+        workers = 1;
+
+    if (pledge("stdio proc accept rpath inet unix", nullptr) < 0) {
         perror("pledge");
         return 1;
     }
 
+    // Fork the extra workers before setting up the event loop. Every process
+    // gets its own listen socket, and the kernel spreads incoming
+    // connections over them via SO_REUSEPORT.
+    bool is_original_process = true;
+    for (int i = 1; i < workers; ++i) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            perror("fork");
+            return 1;
+        }
+        if (pid == 0) {
+            is_original_process = false;
+            break;
+        }
+    }
+
     Core::EventLoop loop;
 
     auto server = Core::TCPServer::construct();
+    if (workers > 1)
+        server->set_reuse_port(true);
 
     server->on_ready_to_accept = [&] {
         auto client_socket = server->accept();
@@ -58,7 +81,8 @@ int main(int argc, char** argv)
         return 1;
     }
 
-    outln("Listening on 0.0.0.0:{}", port);
+    if (is_original_process)
+        outln("Listening on 0.0.0.0:{} with {} worker{}", port, workers, workers == 1 ? "" : "s");
 
     if (unveil("/res/icons", "r") < 0) {
         perror("unveil");
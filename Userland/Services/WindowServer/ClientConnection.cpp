@@ -221,6 +221,9 @@ void ClientConnection::update_menu_item(i32 menu_id, i32 identifier, [[maybe_unu
     menu_item->set_default(is_default);
     if (checkable)
         menu_item->set_checked(checked);
+    // A text or shortcut change can affect the layout, so a pre-rasterized
+    // (but never shown) menu window has to be redone.
+    menu.invalidate_menu_window();
 }
 
 void ClientConnection::add_menu_separator(i32 menu_id)
@@ -302,7 +305,7 @@ Messages::WindowServer::SetResolutionResponse ClientConnection::set_resolution(G
     return { WindowManager::the().set_resolution(resolution.width(), resolution.height(), scale_factor), WindowManager::the().resolution(), WindowManager::the().scale_factor() };
 }
 
-void ClientConnection::set_window_title(i32 window_id, String const& title)
+void ClientConnection::set_window_title(i32 window_id, StringView const& title)
 {
     auto it = m_windows.find(window_id);
     if (it == m_windows.end()) {
@@ -450,7 +453,7 @@ Messages::WindowServer::CreateWindowResponse ClientConnection::create_window(Gfx
     bool auto_position, bool has_alpha_channel, bool modal, bool minimizable, bool resizable,
     bool fullscreen, bool frameless, bool accessory, float opacity, float alpha_hit_threshold,
     Gfx::IntSize const& base_size, Gfx::IntSize const& size_increment, Gfx::IntSize const& minimum_size,
-    Optional<Gfx::IntSize> const& resize_aspect_ratio, i32 type, String const& title, i32 parent_window_id)
+    Optional<Gfx::IntSize> const& resize_aspect_ratio, i32 type, StringView const& title, i32 parent_window_id)
 {
     Window* parent_window = nullptr;
     if (parent_window_id) {
@@ -537,10 +540,12 @@ Messages::WindowServer::DestroyWindowResponse ClientConnection::destroy_window(i
 
 void ClientConnection::post_paint_message(Window& window, bool ignore_occlusion)
 {
-    auto rect_set = window.take_pending_paint_rects();
+    // Hold on to the damage while the window can't be seen; it gets flushed
+    // in one paint message when the window is exposed again.
     if (window.is_minimized() || (!ignore_occlusion && window.is_occluded()))
         return;
 
+    auto rect_set = window.take_pending_paint_rects();
     async_paint(window.window_id(), window.size(), rect_set.rects());
 }
 
@@ -15,10 +15,13 @@
 #include <AK/Memory.h>
 #include <AK/ScopeGuard.h>
 #include <LibCore/Timer.h>
+#include <LibCore/Tracing.h>
 #include <LibGfx/Font.h>
 #include <LibGfx/Painter.h>
 #include <LibGfx/StylePainter.h>
 #include <LibThreading/BackgroundAction.h>
+#include <LibThreading/Thread.h>
+#include <unistd.h>
 
 namespace WindowServer {
 
@@ -98,8 +101,13 @@ void Compositor::did_construct_window_manager(Badge<WindowManager>)
     compose();
 }
 
+// Trace span kinds are WindowServer-local; 1 covers a full compose pass.
+static constexpr uintptr_t compose_span_kind = 1;
+
 void Compositor::compose()
 {
+    CORE_TRACE_SCOPE(compose_span_kind);
+
     auto& wm = WindowManager::the();
     auto& ws = Screen::the();
 
@@ -116,6 +124,29 @@ void Compositor::compose()
         return;
     }
 
+    // Fast path: only the cursor needs updating. Restoring what was behind
+    // the old cursor location and drawing it at the new one doesn't require
+    // re-composing any windows, so we can skip the whole window stack pass.
+    if (m_invalidated_cursor && !m_invalidated_window && m_dirty_screen_rects.is_empty()
+        && m_cursor_back_bitmap && !wm.dnd_client() && m_last_dnd_rect.is_empty()
+        && m_last_geometry_label_damage_rect.is_empty()) {
+        auto cursor_rect = current_cursor_rect();
+        auto previous_cursor_rect = m_last_cursor_rect;
+        restore_cursor_back();
+        draw_cursor(cursor_rect);
+
+        m_invalidated_any = false;
+        m_invalidated_cursor = false;
+
+        if (m_screen_can_set_buffer)
+            flip_buffers();
+
+        flush(cursor_rect);
+        if (previous_cursor_rect != cursor_rect)
+            flush(previous_cursor_rect);
+        return;
+    }
+
     if (m_occlusions_dirty) {
         m_occlusions_dirty = false;
         recompute_occlusions();
@@ -249,101 +280,19 @@ void Compositor::compose()
         return IterationDecision::Continue;
     });
 
+    struct OpaqueRenderJob {
+        Window* window;
+        Gfx::IntRect rect;
+    };
+    Vector<OpaqueRenderJob, 64> opaque_render_jobs;
+
     auto compose_window = [&](Window& window) -> IterationDecision {
         auto frame_rect = window.frame().render_rect();
         if (!frame_rect.intersects(ws.rect()))
             return IterationDecision::Continue;
-        auto window_rect = window.rect();
-        auto frame_rects = frame_rect.shatter(window_rect);
 
         dbgln_if(COMPOSE_DEBUG, "  window {} frame rect: {}", window.title(), frame_rect);
 
-        RefPtr<Gfx::Bitmap> backing_store = window.backing_store();
-        auto compose_window_rect = [&](Gfx::Painter& painter, const Gfx::IntRect& rect) {
-            if (!window.is_fullscreen()) {
-                rect.for_each_intersected(frame_rects, [&](const Gfx::IntRect& intersected_rect) {
-                    Gfx::PainterStateSaver saver(painter);
-                    painter.add_clip_rect(intersected_rect);
-                    dbgln_if(COMPOSE_DEBUG, "    render frame: {}", intersected_rect);
-                    window.frame().paint(painter, intersected_rect);
-                    return IterationDecision::Continue;
-                });
-            }
-
-            auto clear_window_rect = [&](const Gfx::IntRect& clear_rect) {
-                auto fill_color = wm.palette().window();
-                if (!window.is_opaque())
-                    fill_color.set_alpha(255 * window.opacity());
-                painter.fill_rect(clear_rect, fill_color);
-            };
-
-            if (!backing_store) {
-                clear_window_rect(window_rect.intersected(rect));
-                return;
-            }
-
-            // Decide where we would paint this window's backing store.
-            // This is subtly different from widow.rect(), because window
-            // size may be different from its backing store size. This
-            // happens when the window has been resized and the client
-            // has not yet attached a new backing store. In this case,
-            // we want to try to blit the backing store at the same place
-            // it was previously, and fill the rest of the window with its
-            // background color.
-            Gfx::IntRect backing_rect;
-            backing_rect.set_size(backing_store->size());
-            switch (WindowManager::the().resize_direction_of_window(window)) {
-            case ResizeDirection::None:
-            case ResizeDirection::Right:
-            case ResizeDirection::Down:
-            case ResizeDirection::DownRight:
-                backing_rect.set_location(window_rect.location());
-                break;
-            case ResizeDirection::Left:
-            case ResizeDirection::Up:
-            case ResizeDirection::UpLeft:
-                backing_rect.set_right_without_resize(window_rect.right());
-                backing_rect.set_bottom_without_resize(window_rect.bottom());
-                break;
-            case ResizeDirection::UpRight:
-                backing_rect.set_left(window.rect().left());
-                backing_rect.set_bottom_without_resize(window_rect.bottom());
-                break;
-            case ResizeDirection::DownLeft:
-                backing_rect.set_right_without_resize(window_rect.right());
-                backing_rect.set_top(window_rect.top());
-                break;
-            }
-
-            Gfx::IntRect dirty_rect_in_backing_coordinates = rect.intersected(window_rect)
-                                                                 .intersected(backing_rect)
-                                                                 .translated(-backing_rect.location());
-
-            if (!dirty_rect_in_backing_coordinates.is_empty()) {
-                auto dst = backing_rect.location().translated(dirty_rect_in_backing_coordinates.location());
-
-                if (window.client() && window.client()->is_unresponsive()) {
-                    if (window.is_opaque()) {
-                        painter.blit_filtered(dst, *backing_store, dirty_rect_in_backing_coordinates, [](Color src) {
-                            return src.to_grayscale().darkened(0.75f);
-                        });
-                    } else {
-                        u8 alpha = 255 * window.opacity();
-                        painter.blit_filtered(dst, *backing_store, dirty_rect_in_backing_coordinates, [&](Color src) {
-                            auto color = src.to_grayscale().darkened(0.75f);
-                            color.set_alpha(alpha);
-                            return color;
-                        });
-                    }
-                } else {
-                    painter.blit(dst, *backing_store, dirty_rect_in_backing_coordinates, window.opacity());
-                }
-            }
-
-            for (auto background_rect : window_rect.shatter(backing_rect))
-                clear_window_rect(background_rect);
-        };
-
         auto& dirty_rects = window.dirty_rects();
 
         if constexpr (COMPOSE_DEBUG) {
@@ -355,16 +304,16 @@ void Compositor::compose()
                 dbgln("    transparent: {}", r);
         }
 
-        // Render opaque portions directly to the back buffer
+        // Opaque portions render directly to the back buffer. They are
+        // deferred as jobs so that large updates can be split into bands
+        // composed by worker threads.
         auto& opaque_rects = window.opaque_rects();
         if (!opaque_rects.is_empty()) {
             opaque_rects.for_each_intersected(dirty_rects, [&](const Gfx::IntRect& render_rect) {
                 dbgln_if(COMPOSE_DEBUG, "    render opaque: {}", render_rect);
 
                 prepare_rect(render_rect);
-                Gfx::PainterStateSaver saver(back_painter);
-                back_painter.add_clip_rect(render_rect);
-                compose_window_rect(back_painter, render_rect);
+                opaque_render_jobs.append({ &window, render_rect });
                 return IterationDecision::Continue;
             });
         }
@@ -389,7 +338,7 @@ void Compositor::compose()
                 prepare_transparency_rect(render_rect);
                 Gfx::PainterStateSaver saver(temp_painter);
                 temp_painter.add_clip_rect(render_rect);
-                compose_window_rect(temp_painter, render_rect);
+                compose_window_rect(window, temp_painter, render_rect);
                 return IterationDecision::Continue;
             });
         }
@@ -409,6 +358,58 @@ void Compositor::compose()
             });
         }
 
+        // Paint the deferred opaque render jobs. Large updates are split into
+        // horizontal bands composed in parallel by worker threads; jobs that
+        // don't intersect a band are culled from it.
+        if (!opaque_render_jobs.is_empty()) {
+            size_t opaque_render_area = 0;
+            for (auto& job : opaque_render_jobs)
+                opaque_render_area += job.rect.size().area();
+
+            auto render_band = [&](const Gfx::IntRect& band) {
+                Gfx::Painter painter(*m_back_bitmap);
+                for (auto& job : opaque_render_jobs) {
+                    auto render_rect = job.rect.intersected(band);
+                    if (render_rect.is_empty())
+                        continue;
+                    Gfx::PainterStateSaver saver(painter);
+                    painter.add_clip_rect(render_rect);
+                    compose_window_rect(*job.window, painter, job.rect);
+                }
+            };
+
+            static int worker_count = max(static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN)), 1);
+            constexpr size_t parallel_composition_area_threshold = 256 * 1024;
+            if (worker_count > 1 && opaque_render_area >= parallel_composition_area_threshold) {
+                // WindowFrame::render_to_cache() shares a scratch bitmap, so
+                // render all involved frames before handing the jobs to the
+                // worker threads.
+                for (auto& job : opaque_render_jobs)
+                    job.window->frame().render_to_cache();
+
+                int band_height = (ws.height() + worker_count - 1) / worker_count;
+                Vector<NonnullRefPtr<Threading::Thread>, 8> workers;
+                for (int i = 1; i < worker_count; ++i) {
+                    Gfx::IntRect band { 0, i * band_height, ws.width(), band_height };
+                    auto worker = Threading::Thread::construct([&render_band, band]() -> intptr_t {
+                        render_band(band);
+                        return 0;
+                    }, "CompositorWorker");
+                    worker->start();
+                    workers.append(move(worker));
+                }
+                render_band({ 0, 0, ws.width(), band_height });
+                for (auto& worker : workers)
+                    (void)worker->join();
+            } else {
+                for (auto& job : opaque_render_jobs) {
+                    Gfx::PainterStateSaver saver(back_painter);
+                    back_painter.add_clip_rect(job.rect);
+                    compose_window_rect(*job.window, back_painter, job.rect);
+                }
+            }
+        }
+
         // Check that there are no overlapping transparent and opaque flush rectangles
         VERIFY(![&]() {
             for (auto& rect_transparent : flush_transparent_rects.rects()) {
@@ -498,6 +499,98 @@ void Compositor::compose()
         flush(rect);
 }
 
+void Compositor::compose_window_rect(Window& window, Gfx::Painter& painter, const Gfx::IntRect& rect)
+{
+    auto& wm = WindowManager::the();
+    auto frame_rect = window.frame().render_rect();
+    auto window_rect = window.rect();
+
+    if (!window.is_fullscreen()) {
+        auto frame_rects = frame_rect.shatter(window_rect);
+        rect.for_each_intersected(frame_rects, [&](const Gfx::IntRect& intersected_rect) {
+            Gfx::PainterStateSaver saver(painter);
+            painter.add_clip_rect(intersected_rect);
+            dbgln_if(COMPOSE_DEBUG, "    render frame: {}", intersected_rect);
+            window.frame().paint(painter, intersected_rect);
+            return IterationDecision::Continue;
+        });
+    }
+
+    auto clear_window_rect = [&](const Gfx::IntRect& clear_rect) {
+        auto fill_color = wm.palette().window();
+        if (!window.is_opaque())
+            fill_color.set_alpha(255 * window.opacity());
+        painter.fill_rect(clear_rect, fill_color);
+    };
+
+    RefPtr<Gfx::Bitmap> backing_store = window.backing_store();
+    if (!backing_store) {
+        clear_window_rect(window_rect.intersected(rect));
+        return;
+    }
+
+    // Decide where we would paint this window's backing store.
+    // This is subtly different from widow.rect(), because window
+    // size may be different from its backing store size. This
+    // happens when the window has been resized and the client
+    // has not yet attached a new backing store. In this case,
+    // we want to try to blit the backing store at the same place
+    // it was previously, and fill the rest of the window with its
+    // background color.
+    Gfx::IntRect backing_rect;
+    backing_rect.set_size(backing_store->size());
+    switch (WindowManager::the().resize_direction_of_window(window)) {
+    case ResizeDirection::None:
+    case ResizeDirection::Right:
+    case ResizeDirection::Down:
+    case ResizeDirection::DownRight:
+        backing_rect.set_location(window_rect.location());
+        break;
+    case ResizeDirection::Left:
+    case ResizeDirection::Up:
+    case ResizeDirection::UpLeft:
+        backing_rect.set_right_without_resize(window_rect.right());
+        backing_rect.set_bottom_without_resize(window_rect.bottom());
+        break;
+    case ResizeDirection::UpRight:
+        backing_rect.set_left(window.rect().left());
+        backing_rect.set_bottom_without_resize(window_rect.bottom());
+        break;
+    case ResizeDirection::DownLeft:
+        backing_rect.set_right_without_resize(window_rect.right());
+        backing_rect.set_top(window_rect.top());
+        break;
+    }
+
+    Gfx::IntRect dirty_rect_in_backing_coordinates = rect.intersected(window_rect)
+                                                         .intersected(backing_rect)
+                                                         .translated(-backing_rect.location());
+
+    if (!dirty_rect_in_backing_coordinates.is_empty()) {
+        auto dst = backing_rect.location().translated(dirty_rect_in_backing_coordinates.location());
+
+        if (window.client() && window.client()->is_unresponsive()) {
+            if (window.is_opaque()) {
+                painter.blit_filtered(dst, *backing_store, dirty_rect_in_backing_coordinates, [](Color src) {
+                    return src.to_grayscale().darkened(0.75f);
+                });
+            } else {
+                u8 alpha = 255 * window.opacity();
+                painter.blit_filtered(dst, *backing_store, dirty_rect_in_backing_coordinates, [&](Color src) {
+                    auto color = src.to_grayscale().darkened(0.75f);
+                    color.set_alpha(alpha);
+                    return color;
+                });
+            }
+        } else {
+            painter.blit(dst, *backing_store, dirty_rect_in_backing_coordinates, window.opacity());
+        }
+    }
+
+    for (auto background_rect : window_rect.shatter(backing_rect))
+        clear_window_rect(background_rect);
+}
+
 void Compositor::flush(const Gfx::IntRect& a_rect)
 {
     auto rect = Gfx::IntRect::intersection(a_rect, Screen::the().rect());
@@ -784,7 +877,7 @@ void Compositor::draw_cursor(const Gfx::IntRect& cursor_rect)
     }
 
     auto& current_cursor = m_current_cursor ? *m_current_cursor : wm.active_cursor();
-    m_cursor_back_painter->blit({ 0, 0 }, *m_back_bitmap, current_cursor.rect().translated(cursor_rect.location()).intersected(Screen::the().rect()));
+    m_cursor_back_painter->blit({ 0, 0 }, *m_back_bitmap, Gfx::IntRect(cursor_rect.location(), current_cursor.size()).intersected(Screen::the().rect()));
     m_back_painter->blit(cursor_rect.location(), current_cursor.bitmap(), current_cursor.source_rect(m_current_cursor_frame));
     m_last_cursor_rect = cursor_rect;
 }
@@ -68,6 +68,7 @@ private:
     void recompute_occlusions();
     bool any_opaque_window_above_this_one_contains_rect(const Window&, const Gfx::IntRect&);
     void change_cursor(const Cursor*);
+    void compose_window_rect(Window&, Gfx::Painter&, const Gfx::IntRect&);
     void draw_cursor(const Gfx::IntRect&);
     void restore_cursor_back();
     bool draw_geometry_label(Gfx::IntRect&);
@@ -80,10 +80,12 @@ CursorParams CursorParams::parse_from_filename(const StringView& cursor_path, co
     return params;
 }
 
-CursorParams CursorParams::constrained(const Gfx::Bitmap& bitmap) const
+CursorParams CursorParams::constrained(const Gfx::IntRect& cursor_rect) const
 {
     CursorParams params(*this);
-    auto rect = bitmap.rect();
+    // The hotspot is relative to a single frame, regardless of where the
+    // frame strip sits within its bitmap.
+    auto rect = Gfx::IntRect({}, cursor_rect.size());
     if (params.m_frames > 1) {
         if (rect.width() % params.m_frames == 0) {
             rect.set_width(rect.width() / (int)params.m_frames);
@@ -101,7 +103,7 @@ CursorParams CursorParams::constrained(const Gfx::Bitmap& bitmap) const
 
 Cursor::Cursor(NonnullRefPtr<Gfx::Bitmap>&& bitmap, const CursorParams& cursor_params)
     : m_bitmap(move(bitmap))
-    , m_params(cursor_params.constrained(*m_bitmap))
+    , m_params(cursor_params.constrained(m_bitmap->rect()))
     , m_rect(m_bitmap->rect())
 {
     if (m_params.frames() > 1) {
@@ -110,6 +112,17 @@ Cursor::Cursor(NonnullRefPtr<Gfx::Bitmap>&& bitmap, const CursorParams& cursor_p
     }
 }
 
+Cursor::Cursor(NonnullRefPtr<Gfx::Bitmap>&& bitmap, const Gfx::IntRect& rect, const CursorParams& cursor_params)
+    : m_bitmap(move(bitmap))
+    , m_params(cursor_params.constrained(rect))
+    , m_rect(rect)
+{
+    if (m_params.frames() > 1) {
+        VERIFY(m_rect.width() % m_params.frames() == 0);
+        m_rect.set_width(m_rect.width() / m_params.frames());
+    }
+}
+
 Cursor::~Cursor()
 {
 }
@@ -126,6 +139,12 @@ NonnullRefPtr<Cursor> Cursor::create(NonnullRefPtr<Gfx::Bitmap>&& bitmap, const
     return adopt_ref(*new Cursor(move(bitmap), CursorParams::parse_from_filename(filename, default_hotspot)));
 }
 
+NonnullRefPtr<Cursor> Cursor::create_from_atlas(NonnullRefPtr<Gfx::Bitmap> atlas, const Gfx::IntRect& rect, const StringView& filename)
+{
+    auto default_hotspot = Gfx::IntRect({}, rect.size()).center();
+    return adopt_ref(*new Cursor(move(atlas), rect, CursorParams::parse_from_filename(filename, default_hotspot)));
+}
+
 RefPtr<Cursor> Cursor::create(Gfx::StandardCursor standard_cursor)
 {
     switch (standard_cursor) {
@@ -18,7 +18,7 @@ public:
         : m_hotspot(hotspot)
     {
     }
-    CursorParams constrained(const Gfx::Bitmap&) const;
+    CursorParams constrained(const Gfx::IntRect&) const;
 
     const Gfx::IntPoint& hotspot() const { return m_hotspot; }
     unsigned frames() const { return m_frames; }
@@ -36,6 +36,9 @@ class Cursor : public RefCounted<Cursor> {
 public:
     static NonnullRefPtr<Cursor> create(NonnullRefPtr<Gfx::Bitmap>&&, const StringView&);
     static NonnullRefPtr<Cursor> create(NonnullRefPtr<Gfx::Bitmap>&&);
+    // Creates a cursor that references a sub-rect of a shared atlas bitmap
+    // rather than owning a bitmap of its own.
+    static NonnullRefPtr<Cursor> create_from_atlas(NonnullRefPtr<Gfx::Bitmap>, const Gfx::IntRect&, const StringView&);
     static RefPtr<Cursor> create(Gfx::StandardCursor);
     ~Cursor();
 
@@ -52,6 +55,7 @@ public:
 
 private:
     Cursor(NonnullRefPtr<Gfx::Bitmap>&&, const CursorParams&);
+    Cursor(NonnullRefPtr<Gfx::Bitmap>&&, const Gfx::IntRect&, const CursorParams&);
 
     RefPtr<Gfx::Bitmap> m_bitmap;
     CursorParams m_params;
@@ -118,6 +118,14 @@ void Menu::redraw()
     menu_window()->invalidate();
 }
 
+void Menu::redraw(MenuItem const& menu_item)
+{
+    if (!menu_window())
+        return;
+    draw(menu_item);
+    menu_window()->invalidate(menu_item.rect());
+}
+
 Window& Menu::ensure_menu_window()
 {
     if (m_menu_window)
@@ -174,17 +182,6 @@ void Menu::draw()
     Gfx::IntRect rect { {}, menu_window()->size() };
     painter.draw_rect(rect, Color::Black);
     painter.fill_rect(rect.shrunken(2, 2), palette.menu_base());
-    int width = this->content_width();
-
-    if (!s_checked_bitmap)
-        s_checked_bitmap = &Gfx::CharacterBitmap::create_from_ascii(s_checked_bitmap_data, s_checked_bitmap_width, s_checked_bitmap_height).leak_ref();
-
-    bool has_checkable_items = false;
-    bool has_items_with_icon = false;
-    for (auto& item : m_items) {
-        has_checkable_items = has_checkable_items | item.is_checkable();
-        has_items_with_icon = has_items_with_icon | !!item.icon();
-    }
 
     Gfx::IntRect stripe_rect { frame_thickness(), frame_thickness(), s_stripe_width, menu_window()->height() - frame_thickness() * 2 };
     painter.fill_rect(stripe_rect, palette.menu_stripe());
@@ -200,74 +197,95 @@ void Menu::draw()
         painter.draw_text(down_indicator_rect, "\xE2\xAC\x87", Gfx::TextAlignment::Center, can_go_down ? palette.menu_base_text() : palette.color(ColorRole::DisabledText));
     }
 
-    for (int i = 0; i < visible_item_count; ++i) {
-        auto& item = m_items.at(m_scroll_offset + i);
-        if (item.type() == MenuItem::Text) {
-            Color text_color = palette.menu_base_text();
-            if (&item == hovered_item() && item.is_enabled()) {
-                painter.fill_rect(item.rect(), palette.menu_selection());
-                painter.draw_rect(item.rect(), palette.menu_selection().darkened());
-                text_color = palette.menu_selection_text();
-            } else if (!item.is_enabled()) {
-                text_color = Color::MidGray;
-            }
-            Gfx::IntRect text_rect = item.rect().translated(stripe_rect.width() + 6, 0);
-            if (item.is_checkable()) {
-                if (item.is_exclusive()) {
-                    Gfx::IntRect radio_rect { item.rect().x() + 5, 0, 12, 12 };
-                    radio_rect.center_vertically_within(text_rect);
-                    Gfx::StylePainter::paint_radio_button(painter, radio_rect, palette, item.is_checked(), false);
-                } else {
-                    Gfx::IntRect checkmark_rect { item.rect().x() + 7, 0, s_checked_bitmap_width, s_checked_bitmap_height };
-                    checkmark_rect.center_vertically_within(text_rect);
-                    Gfx::IntRect checkbox_rect = checkmark_rect.inflated(4, 4);
-                    painter.fill_rect(checkbox_rect, palette.base());
-                    Gfx::StylePainter::paint_frame(painter, checkbox_rect, palette, Gfx::FrameShape::Container, Gfx::FrameShadow::Sunken, 2);
-                    if (item.is_checked()) {
-                        painter.draw_bitmap(checkmark_rect.location(), *s_checked_bitmap, palette.button_text());
-                    }
-                }
-            } else if (item.icon()) {
-                Gfx::IntRect icon_rect { item.rect().x() + 3, 0, s_item_icon_width, s_item_icon_width };
-                icon_rect.center_vertically_within(text_rect);
-
-                if (&item == hovered_item() && item.is_enabled()) {
-                    auto shadow_color = palette.menu_selection().darkened(0.7f);
-                    painter.blit_filtered(icon_rect.location().translated(1, 1), *item.icon(), item.icon()->rect(), [&shadow_color](auto) {
-                        return shadow_color;
-                    });
-                    icon_rect.translate_by(-1, -1);
+    for (int i = 0; i < visible_item_count; ++i)
+        draw(m_items.at(m_scroll_offset + i), true);
+
+    m_scroll_offset_at_last_draw = m_scroll_offset;
+}
+
+void Menu::draw(MenuItem const& item, bool is_drawing_all)
+{
+    auto palette = WindowManager::the().palette();
+    int width = this->content_width();
+    VERIFY(menu_window());
+    VERIFY(menu_window()->backing_store());
+    Gfx::Painter painter(*menu_window()->backing_store());
+
+    if (!s_checked_bitmap)
+        s_checked_bitmap = &Gfx::CharacterBitmap::create_from_ascii(s_checked_bitmap_data, s_checked_bitmap_width, s_checked_bitmap_height).leak_ref();
+
+    if (!is_drawing_all) {
+        // When repainting a single item, we have to repaint its slice of the
+        // menu background and stripe ourselves.
+        painter.fill_rect(item.rect(), palette.menu_base());
+        painter.fill_rect({ item.rect().location(), { s_stripe_width, item.rect().height() } }, palette.menu_stripe());
+    }
+
+    if (item.type() == MenuItem::Text) {
+        Color text_color = palette.menu_base_text();
+        if (&item == hovered_item() && item.is_enabled()) {
+            painter.fill_rect(item.rect(), palette.menu_selection());
+            painter.draw_rect(item.rect(), palette.menu_selection().darkened());
+            text_color = palette.menu_selection_text();
+        } else if (!item.is_enabled()) {
+            text_color = Color::MidGray;
+        }
+        Gfx::IntRect text_rect = item.rect().translated(s_stripe_width + 6, 0);
+        if (item.is_checkable()) {
+            if (item.is_exclusive()) {
+                Gfx::IntRect radio_rect { item.rect().x() + 5, 0, 12, 12 };
+                radio_rect.center_vertically_within(text_rect);
+                Gfx::StylePainter::paint_radio_button(painter, radio_rect, palette, item.is_checked(), false);
+            } else {
+                Gfx::IntRect checkmark_rect { item.rect().x() + 7, 0, s_checked_bitmap_width, s_checked_bitmap_height };
+                checkmark_rect.center_vertically_within(text_rect);
+                Gfx::IntRect checkbox_rect = checkmark_rect.inflated(4, 4);
+                painter.fill_rect(checkbox_rect, palette.base());
+                Gfx::StylePainter::paint_frame(painter, checkbox_rect, palette, Gfx::FrameShape::Container, Gfx::FrameShadow::Sunken, 2);
+                if (item.is_checked()) {
+                    painter.draw_bitmap(checkmark_rect.location(), *s_checked_bitmap, palette.button_text());
                 }
-                if (item.is_enabled())
-                    painter.blit(icon_rect.location(), *item.icon(), item.icon()->rect());
-                else
-                    painter.blit_disabled(icon_rect.location(), *item.icon(), item.icon()->rect(), palette);
             }
-            auto& previous_font = painter.font();
-            if (item.is_default())
-                painter.set_font(previous_font.bold_variant());
-            painter.draw_ui_text(text_rect, item.text(), painter.font(), Gfx::TextAlignment::CenterLeft, text_color);
-            if (!item.shortcut_text().is_empty()) {
-                painter.draw_text(item.rect().translated(-right_padding(), 0), item.shortcut_text(), Gfx::TextAlignment::CenterRight, text_color);
-            }
-            painter.set_font(previous_font);
-            if (item.is_submenu()) {
-                static auto& submenu_arrow_bitmap = Gfx::CharacterBitmap::create_from_ascii(s_submenu_arrow_bitmap_data, s_submenu_arrow_bitmap_width, s_submenu_arrow_bitmap_height).leak_ref();
-                Gfx::IntRect submenu_arrow_rect {
-                    item.rect().right() - s_submenu_arrow_bitmap_width - 2,
-                    0,
-                    s_submenu_arrow_bitmap_width,
-                    s_submenu_arrow_bitmap_height
-                };
-                submenu_arrow_rect.center_vertically_within(item.rect());
-                painter.draw_bitmap(submenu_arrow_rect.location(), submenu_arrow_bitmap, text_color);
+        } else if (item.icon()) {
+            Gfx::IntRect icon_rect { item.rect().x() + 3, 0, s_item_icon_width, s_item_icon_width };
+            icon_rect.center_vertically_within(text_rect);
+
+            if (&item == hovered_item() && item.is_enabled()) {
+                auto shadow_color = palette.menu_selection().darkened(0.7f);
+                painter.blit_filtered(icon_rect.location().translated(1, 1), *item.icon(), item.icon()->rect(), [&shadow_color](auto) {
+                    return shadow_color;
+                });
+                icon_rect.translate_by(-1, -1);
             }
-        } else if (item.type() == MenuItem::Separator) {
-            Gfx::IntPoint p1(item.rect().translated(stripe_rect.width() + 4, 0).x(), item.rect().center().y() - 1);
-            Gfx::IntPoint p2(width - 7, item.rect().center().y() - 1);
-            painter.draw_line(p1, p2, palette.threed_shadow1());
-            painter.draw_line(p1.translated(0, 1), p2.translated(0, 1), palette.threed_highlight());
+            if (item.is_enabled())
+                painter.blit(icon_rect.location(), *item.icon(), item.icon()->rect());
+            else
+                painter.blit_disabled(icon_rect.location(), *item.icon(), item.icon()->rect(), palette);
         }
+        auto& previous_font = painter.font();
+        if (item.is_default())
+            painter.set_font(previous_font.bold_variant());
+        painter.draw_ui_text(text_rect, item.text(), painter.font(), Gfx::TextAlignment::CenterLeft, text_color);
+        if (!item.shortcut_text().is_empty()) {
+            painter.draw_text(item.rect().translated(-right_padding(), 0), item.shortcut_text(), Gfx::TextAlignment::CenterRight, text_color);
+        }
+        painter.set_font(previous_font);
+        if (item.is_submenu()) {
+            static auto& submenu_arrow_bitmap = Gfx::CharacterBitmap::create_from_ascii(s_submenu_arrow_bitmap_data, s_submenu_arrow_bitmap_width, s_submenu_arrow_bitmap_height).leak_ref();
+            Gfx::IntRect submenu_arrow_rect {
+                item.rect().right() - s_submenu_arrow_bitmap_width - 2,
+                0,
+                s_submenu_arrow_bitmap_width,
+                s_submenu_arrow_bitmap_height
+            };
+            submenu_arrow_rect.center_vertically_within(item.rect());
+            painter.draw_bitmap(submenu_arrow_rect.location(), submenu_arrow_bitmap, text_color);
+        }
+    } else if (item.type() == MenuItem::Separator) {
+        Gfx::IntPoint p1(item.rect().translated(s_stripe_width + 4, 0).x(), item.rect().center().y() - 1);
+        Gfx::IntPoint p2(width - 7, item.rect().center().y() - 1);
+        painter.draw_line(p1, p2, palette.threed_shadow1());
+        painter.draw_line(p1.translated(0, 1), p2.translated(0, 1), palette.threed_highlight());
     }
 }
 
@@ -291,7 +309,6 @@ void Menu::update_for_new_hovered_item(bool make_input)
             set_visible(true);
         }
     }
-    redraw();
 }
 
 void Menu::open_hovered_item(bool leave_menu_open)
@@ -355,6 +372,8 @@ void Menu::event(Core::Event& event)
         auto& mouse_event = static_cast<const MouseEvent&>(event);
         m_scroll_offset += mouse_event.wheel_delta();
         m_scroll_offset = clamp(m_scroll_offset, 0, m_max_scroll_offset);
+        if (m_scroll_offset != m_scroll_offset_at_last_draw)
+            redraw();
 
         int index = item_index_at(mouse_event.position());
         set_hovered_index(index);
@@ -632,6 +651,34 @@ void Menu::add_item(NonnullOwnPtr<MenuItem> item)
         m_alt_shortcut_character_to_item_indices.ensure(tolower(alt_shortcut)).append(m_items.size());
     }
     m_items.append(move(item));
+    invalidate_menu_window();
+}
+
+void Menu::invalidate_menu_window()
+{
+    // A pre-rasterized backing store that nobody has seen yet is cheap to
+    // throw away and rebuild with the new contents; a visible menu keeps its
+    // window and repaints like before.
+    if (m_menu_window && !m_menu_window->is_visible())
+        m_menu_window = nullptr;
+    schedule_pre_rasterization();
+}
+
+void Menu::schedule_pre_rasterization()
+{
+    if (m_menu_window)
+        return;
+    // Lay out and paint the menu once the client has stopped mutating it for
+    // a moment, so the first open only has to blit the backing store instead
+    // of doing a full text-layout and paint pass.
+    if (!m_pre_rasterization_timer) {
+        m_pre_rasterization_timer = Core::Timer::create_single_shot(500, [this] {
+            if (!m_menu_window && !is_empty())
+                ensure_menu_window();
+        },
+            this);
+    }
+    m_pre_rasterization_timer->restart();
 }
 
 const Vector<size_t>* Menu::items_with_alt_shortcut(u32 alt_shortcut) const
@@ -646,12 +693,23 @@ void Menu::set_hovered_index(int index, bool make_input)
 {
     if (m_hovered_item_index == index)
         return;
-    if (auto* old_hovered_item = hovered_item()) {
-        if (client())
-            client()->async_menu_item_left(m_menu_id, old_hovered_item->identifier());
-    }
+    auto* old_hovered_item = hovered_item();
+    if (old_hovered_item && client())
+        client()->async_menu_item_left(m_menu_id, old_hovered_item->identifier());
     m_hovered_item_index = index;
     update_for_new_hovered_item(make_input);
+    if (menu_window()) {
+        if (m_scroll_offset != m_scroll_offset_at_last_draw) {
+            // Scrolling moved every item, so the whole thing needs repainting.
+            redraw();
+        } else {
+            // Otherwise only the items that changed hover state do.
+            if (old_hovered_item)
+                redraw(*old_hovered_item);
+            if (auto* new_hovered_item = hovered_item())
+                redraw(*new_hovered_item);
+        }
+    }
     if (auto* new_hovered_item = hovered_item()) {
         if (client())
             client()->async_menu_item_entered(m_menu_id, new_hovered_item->identifier());
@@ -10,6 +10,7 @@
 #include <AK/String.h>
 #include <AK/WeakPtr.h>
 #include <LibCore/Object.h>
+#include <LibCore/Timer.h>
 #include <LibGfx/Font.h>
 #include <LibGfx/FontDatabase.h>
 #include <LibGfx/Forward.h>
@@ -93,10 +94,16 @@ public:
     static constexpr int right_padding() { return 14; }
 
     void draw();
+    void draw(MenuItem const&, bool is_drawing_all = false);
     const Gfx::Font& font() const;
 
     MenuItem* item_with_identifier(unsigned);
     void redraw();
+    void redraw(MenuItem const&);
+
+    // Call this whenever the menu's contents change; it throws away a stale
+    // pre-rasterized window and schedules a fresh one.
+    void invalidate_menu_window();
 
     MenuItem* hovered_item() const;
 
@@ -137,6 +144,7 @@ private:
     void update_for_new_hovered_item(bool make_input = false);
 
     void start_activation_animation(MenuItem&);
+    void schedule_pre_rasterization();
 
     ClientConnection* m_client { nullptr };
     int m_menu_id { 0 };
@@ -154,8 +162,11 @@ private:
 
     bool m_scrollable { false };
     int m_scroll_offset { 0 };
+    int m_scroll_offset_at_last_draw { -1 };
     int m_max_scroll_offset { 0 };
 
+    RefPtr<Core::Timer> m_pre_rasterization_timer;
+
     HashMap<u32, Vector<size_t>> m_alt_shortcut_character_to_item_indices;
 };
 
@@ -253,6 +253,7 @@ public:
 
     void request_update(const Gfx::IntRect&, bool ignore_occlusion = false);
     Gfx::DisjointRectSet take_pending_paint_rects() { return move(m_pending_paint_rects); }
+    bool has_pending_paint_rects() const { return !m_pending_paint_rects.is_empty(); }
 
     bool has_taskbar_rect() const { return m_have_taskbar_rect; };
     bool in_minimize_animation() const { return m_minimize_animation_step != -1; }
@@ -57,14 +57,77 @@ WindowManager::~WindowManager()
 {
 }
 
-NonnullRefPtr<Cursor> WindowManager::get_cursor(const String& name)
+void WindowManager::reload_cursors()
 {
+    // All standard cursors are packed into a single atlas bitmap, so a cursor
+    // theme costs one bitmap allocation instead of one per cursor.
+    struct CursorSlot {
+        const char* name;
+        RefPtr<Cursor>* cursor;
+    };
+    const CursorSlot slots[] = {
+        { "Hidden", &m_hidden_cursor },
+        { "Arrow", &m_arrow_cursor },
+        { "Hand", &m_hand_cursor },
+        { "Help", &m_help_cursor },
+        { "ResizeH", &m_resize_horizontally_cursor },
+        { "ResizeV", &m_resize_vertically_cursor },
+        { "ResizeDTLBR", &m_resize_diagonally_tlbr_cursor },
+        { "ResizeDBLTR", &m_resize_diagonally_bltr_cursor },
+        { "ResizeColumn", &m_resize_column_cursor },
+        { "ResizeRow", &m_resize_row_cursor },
+        { "IBeam", &m_i_beam_cursor },
+        { "Disallowed", &m_disallowed_cursor },
+        { "Move", &m_move_cursor },
+        { "Drag", &m_drag_cursor },
+        { "Wait", &m_wait_cursor },
+        { "Crosshair", &m_crosshair_cursor },
+    };
+
     static const auto s_default_cursor_path = "/res/cursors/arrow.x2y2.png";
-    auto path = m_config->read_entry("Cursor", name, s_default_cursor_path);
-    auto gb = Gfx::Bitmap::load_from_file(path, compositor_icon_scale());
-    if (gb)
-        return Cursor::create(*gb, path);
-    return Cursor::create(*Gfx::Bitmap::load_from_file(s_default_cursor_path), s_default_cursor_path);
+
+    struct PendingCursor {
+        RefPtr<Gfx::Bitmap> bitmap;
+        String path;
+        RefPtr<Cursor>* cursor;
+    };
+    Vector<PendingCursor> atlas_cursors;
+    int atlas_width = 0;
+    int atlas_height = 0;
+    for (auto& slot : slots) {
+        auto path = m_config->read_entry("Cursor", slot.name, s_default_cursor_path);
+        auto bitmap = Gfx::Bitmap::load_from_file(path, compositor_icon_scale());
+        if (!bitmap) {
+            path = s_default_cursor_path;
+            bitmap = Gfx::Bitmap::load_from_file(path);
+        }
+        VERIFY(bitmap);
+        if (bitmap->scale() != compositor_icon_scale()) {
+            // The atlas is created at the compositor scale; a cursor that only
+            // exists at another scale keeps its own bitmap.
+            *slot.cursor = Cursor::create(bitmap.release_nonnull(), path);
+            continue;
+        }
+        atlas_width = max(atlas_width, bitmap->width());
+        atlas_height += bitmap->height();
+        atlas_cursors.append({ move(bitmap), move(path), slot.cursor });
+    }
+
+    auto atlas = atlas_width > 0 ? Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { atlas_width, atlas_height }, compositor_icon_scale()) : nullptr;
+    if (!atlas) {
+        for (auto& pending : atlas_cursors)
+            *pending.cursor = Cursor::create(pending.bitmap.release_nonnull(), pending.path);
+        return;
+    }
+
+    Gfx::Painter painter(*atlas);
+    int y = 0;
+    for (auto& pending : atlas_cursors) {
+        // Copy the pixels verbatim; blending would destroy the alpha channel.
+        painter.blit({ 0, y }, *pending.bitmap, pending.bitmap->rect(), 1.0f, false);
+        *pending.cursor = Cursor::create_from_atlas(*atlas, { 0, y, pending.bitmap->width(), pending.bitmap->height() }, pending.path);
+        y += pending.bitmap->height();
+    }
 }
 
 void WindowManager::reload_config()
@@ -72,22 +135,7 @@ void WindowManager::reload_config()
     m_config = Core::ConfigFile::open("/etc/WindowServer.ini");
 
     m_double_click_speed = m_config->read_num_entry("Input", "DoubleClickSpeed", 250);
-    m_hidden_cursor = get_cursor("Hidden");
-    m_arrow_cursor = get_cursor("Arrow");
-    m_hand_cursor = get_cursor("Hand");
-    m_help_cursor = get_cursor("Help");
-    m_resize_horizontally_cursor = get_cursor("ResizeH");
-    m_resize_vertically_cursor = get_cursor("ResizeV");
-    m_resize_diagonally_tlbr_cursor = get_cursor("ResizeDTLBR");
-    m_resize_diagonally_bltr_cursor = get_cursor("ResizeDBLTR");
-    m_resize_column_cursor = get_cursor("ResizeColumn");
-    m_resize_row_cursor = get_cursor("ResizeRow");
-    m_i_beam_cursor = get_cursor("IBeam");
-    m_disallowed_cursor = get_cursor("Disallowed");
-    m_move_cursor = get_cursor("Move");
-    m_drag_cursor = get_cursor("Drag");
-    m_wait_cursor = get_cursor("Wait");
-    m_crosshair_cursor = get_cursor("Crosshair");
+    reload_cursors();
 
     WindowFrame::reload_config();
 }
@@ -434,17 +482,27 @@ void WindowManager::notify_minimization_state_changed(Window& window)
 {
     tell_wms_window_state_changed(window);
 
-    if (window.client())
+    if (window.client()) {
         window.client()->async_window_state_changed(window.window_id(), window.is_minimized(), window.is_occluded());
 
+        // Flush any damage that accumulated while the window was hidden.
+        if (!window.is_minimized() && !window.is_occluded() && window.has_pending_paint_rects())
+            window.client()->post_paint_message(window);
+    }
+
     if (window.is_active() && window.is_minimized())
         pick_new_active_window(&window);
 }
 
 void WindowManager::notify_occlusion_state_changed(Window& window)
 {
-    if (window.client())
+    if (window.client()) {
         window.client()->async_window_state_changed(window.window_id(), window.is_minimized(), window.is_occluded());
+
+        // Flush any damage that accumulated while the window was occluded.
+        if (!window.is_minimized() && !window.is_occluded() && window.has_pending_paint_rects())
+            window.client()->post_paint_message(window);
+    }
 }
 
 void WindowManager::notify_progress_changed(Window& window)
@@ -233,7 +233,7 @@ public:
     Window* hovered_window() const { return m_hovered_window.ptr(); }
 
 private:
-    NonnullRefPtr<Cursor> get_cursor(const String& name);
+    void reload_cursors();
 
     void process_mouse_event(MouseEvent&, Window*& hovered_window);
     void process_event_for_doubleclick(Window& window, MouseEvent& event);
@@ -16,6 +16,8 @@
 #include <inttypes.h>
 #include <limits.h>
 #include <signal.h>
+#include <sys/select.h>
+#include <sys/stat.h>
 #include <sys/wait.h>
 #include <unistd.h>
 
@@ -67,6 +69,54 @@ int Shell::builtin_alias(int argc, const char** argv)
     return fail ? 1 : 0;
 }
 
+int Shell::builtin_basename(int argc, const char** argv)
+{
+    const char* path = nullptr;
+
+    Core::ArgsParser parser;
+    parser.add_positional_argument(path, "Path to get basename from", "path");
+
+    if (!parser.parse(argc, const_cast<char**>(argv), false))
+        return 1;
+
+    outln("{}", LexicalPath(path).basename());
+    return 0;
+}
+
+int Shell::builtin_dirname(int argc, const char** argv)
+{
+    const char* path = nullptr;
+
+    Core::ArgsParser parser;
+    parser.add_positional_argument(path, "Path to get dirname from", "path");
+
+    if (!parser.parse(argc, const_cast<char**>(argv), false))
+        return 1;
+
+    outln("{}", LexicalPath(path).dirname());
+    return 0;
+}
+
+int Shell::builtin_echo(int argc, const char** argv)
+{
+    Vector<const char*> values;
+    bool no_trailing_newline = false;
+
+    Core::ArgsParser parser;
+    parser.add_option(no_trailing_newline, "Do not output a trailing newline", nullptr, 'n');
+    parser.add_positional_argument(values, "Values to print out", "string", Core::ArgsParser::Required::No);
+
+    if (!parser.parse(argc, const_cast<char**>(argv), false))
+        return 1;
+
+    StringBuilder builder;
+    builder.join(' ', values);
+    if (!no_trailing_newline)
+        builder.append('\n');
+    fputs(builder.to_string().characters(), stdout);
+    return 0;
+}
+
 int Shell::builtin_bg(int argc, const char** argv)
 {
     int job_id = -1;
@@ -873,6 +923,177 @@ int Shell::builtin_source(int argc, const char** argv)
     return 0;
 }
 
+int Shell::builtin_test(int argc, const char** argv)
+{
+    // "[ expr ]" is the same as "test expr", plus a closing bracket.
+    if (StringView { argv[0] } == "[") {
+        if (argc < 2 || StringView { argv[argc - 1] } != "]") {
+            warnln("test: Expected ']' as the last argument");
+            return 2;
+        }
+        --argc;
+    }
+
+    Span<const char*> arguments { argv + 1, static_cast<size_t>(argc - 1) };
+    size_t position = 0;
+    bool syntax_error = false;
+
+    auto peek = [&]() -> StringView {
+        if (position >= arguments.size())
+            return {};
+        return arguments[position];
+    };
+    auto consume = [&]() -> StringView {
+        return arguments[position++];
+    };
+    auto is_binary_operator = [](StringView token) {
+        return token == "=" || token == "==" || token == "!="
+            || token == "-eq" || token == "-ne" || token == "-lt" || token == "-le" || token == "-gt" || token == "-ge";
+    };
+    auto file_test = [](char mode, StringView path) -> bool {
+        String path_string = path;
+        struct stat st { };
+        switch (mode) {
+        case 'b':
+            return stat(path_string.characters(), &st) == 0 && S_ISBLK(st.st_mode);
+        case 'c':
+            return stat(path_string.characters(), &st) == 0 && S_ISCHR(st.st_mode);
+        case 'd':
+            return stat(path_string.characters(), &st) == 0 && S_ISDIR(st.st_mode);
+        case 'e':
+            return stat(path_string.characters(), &st) == 0;
+        case 'f':
+            return stat(path_string.characters(), &st) == 0 && S_ISREG(st.st_mode);
+        case 'h':
+        case 'L':
+            return lstat(path_string.characters(), &st) == 0 && S_ISLNK(st.st_mode);
+        case 'p':
+            return stat(path_string.characters(), &st) == 0 && S_ISFIFO(st.st_mode);
+        case 'S':
+            return stat(path_string.characters(), &st) == 0 && S_ISSOCK(st.st_mode);
+        case 's':
+            return stat(path_string.characters(), &st) == 0 && st.st_size > 0;
+        case 'r':
+            return access(path_string.characters(), R_OK) == 0;
+        case 'w':
+            return access(path_string.characters(), W_OK) == 0;
+        case 'x':
+            return access(path_string.characters(), X_OK) == 0;
+        default:
+            VERIFY_NOT_REACHED();
+        }
+    };
+
+    Function<bool()> parse_or_expression;
+
+    Function<bool()> parse_primary = [&]() -> bool {
+        auto token = peek();
+        if (token.is_null()) {
+            syntax_error = true;
+            return false;
+        }
+        if (token == "!") {
+            consume();
+            return !parse_primary();
+        }
+        if (token == "(") {
+            consume();
+            auto value = parse_or_expression();
+            if (peek() != ")") {
+                syntax_error = true;
+                return false;
+            }
+            consume();
+            return value;
+        }
+        // A unary operator, unless it is the lhs of a binary operator
+        // ("test -e = -e" compares the two strings).
+        if (token.length() == 2 && token[0] == '-' && StringView("bcdefhLpSsrwxzn").contains(token[1])
+            && !(position + 1 < arguments.size() && is_binary_operator(arguments[position + 1]))) {
+            consume();
+            auto operand = peek();
+            if (operand.is_null()) {
+                syntax_error = true;
+                return false;
+            }
+            consume();
+            if (token[1] == 'z')
+                return operand.is_empty();
+            if (token[1] == 'n')
+                return !operand.is_empty();
+            return file_test(token[1], operand);
+        }
+        auto lhs = consume();
+        if (!is_binary_operator(peek()))
+            return !lhs.is_empty();
+
+        auto op = consume();
+        auto rhs = peek();
+        if (rhs.is_null()) {
+            syntax_error = true;
+            return false;
+        }
+        consume();
+
+        if (op == "=" || op == "==")
+            return lhs == rhs;
+        if (op == "!=")
+            return lhs != rhs;
+
+        auto lhs_number = lhs.to_int();
+        auto rhs_number = rhs.to_int();
+        if (!lhs_number.has_value() || !rhs_number.has_value()) {
+            warnln("test: Expected integer operands for '{}'", op);
+            syntax_error = true;
+            return false;
+        }
+        if (op == "-eq")
+            return lhs_number.value() == rhs_number.value();
+        if (op == "-ne")
+            return lhs_number.value() != rhs_number.value();
+        if (op == "-lt")
+            return lhs_number.value() < rhs_number.value();
+        if (op == "-le")
+            return lhs_number.value() <= rhs_number.value();
+        if (op == "-gt")
+            return lhs_number.value() > rhs_number.value();
+        return lhs_number.value() >= rhs_number.value();
+    };
+
+    Function<bool()> parse_and_expression = [&]() -> bool {
+        auto value = parse_primary();
+        while (peek() == "-a") {
+            consume();
+            // Note: Unlike `&&', `-a' does not short-circuit.
+            auto rhs = parse_primary();
+            value = value && rhs;
+        }
+        return value;
+    };
+
+    parse_or_expression = [&]() -> bool {
+        auto value = parse_and_expression();
+        while (peek() == "-o") {
+            consume();
+            auto rhs = parse_and_expression();
+            value = value || rhs;
+        }
+        return value;
+    };
+
+    if (arguments.is_empty())
+        return 1;
+
+    auto result = parse_or_expression();
+    if (position != arguments.size())
+        syntax_error = true;
+    if (syntax_error) {
+        warnln("test: Syntax error in expression");
+        return 2;
+    }
+    return result ? 0 : 1;
+}
+
 int Shell::builtin_time(int argc, const char** argv)
 {
     Vector<const char*> args;
@@ -1030,6 +1251,169 @@ int Shell::builtin_not(int argc, const char** argv)
     return exit_code == 0 ? 1 : 0;
 }
 
+int Shell::builtin_par(int argc, const char** argv)
+{
+    // FIXME: Use ArgsParser when it can stop at a literal `--'.
+    int max_jobs = static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN));
+    if (max_jobs < 1)
+        max_jobs = 1;
+
+    Vector<const char*> command;
+    Vector<const char*> items;
+    bool seen_separator = false;
+
+    int argument_index = 1;
+    if (argument_index < argc && StringView { argv[argument_index] } == "-j") {
+        if (argument_index + 1 >= argc) {
+            warnln("par: -j requires an argument");
+            return 2;
+        }
+        auto count = StringView { argv[argument_index + 1] }.to_int();
+        if (!count.has_value() || count.value() < 1) {
+            warnln("par: Invalid job count '{}'", argv[argument_index + 1]);
+            return 2;
+        }
+        max_jobs = count.value();
+        argument_index += 2;
+    }
+
+    for (; argument_index < argc; ++argument_index) {
+        if (!seen_separator && StringView { argv[argument_index] } == "--") {
+            seen_separator = true;
+            continue;
+        }
+        (seen_separator ? items : command).append(argv[argument_index]);
+    }
+
+    if (command.is_empty() || !seen_separator) {
+        warnln("usage: par [-j jobs] command... -- item...");
+        return 2;
+    }
+
+    if (items.is_empty())
+        return 0;
+
+    struct Task {
+        pid_t pid { -1 };
+        int fd { -1 };
+        StringBuilder output;
+        bool exited { false };
+        int exit_code { 0 };
+    };
+
+    Vector<Task> tasks;
+    tasks.resize(items.size());
+
+    auto spawn_task = [&](size_t index) -> bool {
+        auto& task = tasks[index];
+        int pipe_fds[2];
+        if (pipe(pipe_fds) < 0) {
+            perror("pipe");
+            task.exited = true;
+            task.exit_code = 126;
+            return false;
+        }
+        pid_t child = fork();
+        if (child < 0) {
+            perror("fork");
+            close(pipe_fds[0]);
+            close(pipe_fds[1]);
+            task.exited = true;
+            task.exit_code = 126;
+            return false;
+        }
+        if (child == 0) {
+            close(pipe_fds[0]);
+            if (dup2(pipe_fds[1], STDOUT_FILENO) < 0) {
+                perror("dup2");
+                _exit(126);
+            }
+            close(pipe_fds[1]);
+            Vector<const char*> child_argv = command;
+            child_argv.append(items[index]);
+            child_argv.append(nullptr);
+            execvp(child_argv[0], const_cast<char* const*>(child_argv.data()));
+            perror("execvp");
+            _exit(126);
+        }
+        close(pipe_fds[1]);
+        task.pid = child;
+        task.fd = pipe_fds[0];
+        return true;
+    };
+
+    size_t next_to_start = 0;
+    size_t next_to_flush = 0;
+    int running = 0;
+    int return_code = 0;
+    char buffer[4096];
+
+    while (next_to_flush < tasks.size()) {
+        while (running < max_jobs && next_to_start < tasks.size()) {
+            if (spawn_task(next_to_start))
+                ++running;
+            ++next_to_start;
+        }
+
+        fd_set read_fds;
+        FD_ZERO(&read_fds);
+        int max_fd = -1;
+        for (auto& task : tasks) {
+            if (task.fd >= 0) {
+                FD_SET(task.fd, &read_fds);
+                max_fd = max(max_fd, task.fd);
+            }
+        }
+
+        if (max_fd >= 0) {
+            if (select(max_fd + 1, &read_fds, nullptr, nullptr, nullptr) < 0) {
+                if (errno == EINTR)
+                    continue;
+                perror("select");
+                return 1;
+            }
+            for (auto& task : tasks) {
+                if (task.fd < 0 || !FD_ISSET(task.fd, &read_fds))
+                    continue;
+                auto nread = read(task.fd, buffer, sizeof(buffer));
+                if (nread > 0) {
+                    task.output.append(StringView { buffer, static_cast<size_t>(nread) });
+                    continue;
+                }
+                // EOF: the child is done writing, reap it.
+                close(task.fd);
+                task.fd = -1;
+                int wstatus = 0;
+                pid_t waited;
+                do {
+                    waited = waitpid(task.pid, &wstatus, 0);
+                } while (waited < 0 && errno == EINTR);
+                if (waited == task.pid && WIFEXITED(wstatus))
+                    task.exit_code = WEXITSTATUS(wstatus);
+                else
+                    task.exit_code = 126;
+                task.exited = true;
+                --running;
+            }
+        }
+
+        // Flush the output of finished iterations, strictly in input order.
+        while (next_to_flush < tasks.size() && tasks[next_to_flush].exited) {
+            auto& task = tasks[next_to_flush];
+            auto output = task.output.string_view();
+            if (!output.is_empty())
+                fwrite(output.characters_without_null_termination(), 1, output.length(), stdout);
+            task.output.clear();
+            if (task.exit_code != 0)
+                return_code = task.exit_code;
+            ++next_to_flush;
+        }
+    }
+
+    fflush(stdout);
+    return return_code;
+}
+
 int Shell::builtin_kill(int argc, const char** argv)
 {
     // Simply translate the arguments and pass them to `kill'
@@ -1083,6 +1467,11 @@ bool Shell::run_builtin(const AST::Command& command, const NonnullRefPtrVector<A
 
     StringView name = command.argv.first();
 
+    // `[' cannot go through the enumerator macro below, its name is not an
+    // identifier; it is just another spelling of `test'.
+    if (name == "[")
+        name = "test";
+
     SavedFileDescriptors fds { rewirings };
 
     for (auto& rewiring : rewirings) {
@@ -1114,6 +1503,9 @@ bool Shell::run_builtin(const AST::Command& command, const NonnullRefPtrVector<A
 
 bool Shell::has_builtin(const StringView& name) const
 {
+    if (name == "[")
+        return true;
+
 #define __ENUMERATE_SHELL_BUILTIN(builtin) \
     if (name == #builtin) {                \
         return true;                       \
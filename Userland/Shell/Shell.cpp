@@ -551,8 +551,13 @@ int Shell::run_command(const StringView& cmd, Optional<SourcePosition> source_po
         command->dump(0);
     }
 
-    if (command->is_syntax_error()) {
-        auto& error_node = command->syntax_error_node();
+    return run_parsed_tree(*command);
+}
+
+int Shell::run_parsed_tree(AST::Node& command)
+{
+    if (command.is_syntax_error()) {
+        auto& error_node = command.syntax_error_node();
         auto& position = error_node.position();
         raise_error(ShellError::EvaluatedSyntaxError, error_node.error_text(), position);
     }
@@ -565,7 +570,7 @@ int Shell::run_command(const StringView& cmd, Optional<SourcePosition> source_po
 
     tcgetattr(0, &termios);
 
-    command->run(*this);
+    command.run(*this);
 
     if (!has_error(ShellError::None)) {
         possibly_print_error();
@@ -1018,6 +1023,17 @@ bool Shell::run_file(const String& filename, bool explicitly_invoked)
     TemporaryChange interactive_change { m_is_interactive, false };
     TemporaryChange<Optional<SourcePosition>> source_change { m_source_position, SourcePosition { .source_file = filename, .literal_source_text = {}, .position = {} } };
 
+    // Reuse the previously parsed tree if the file has not changed since;
+    // sourcing the same script repeatedly then skips the parser entirely.
+    struct stat st { };
+    auto have_stat = stat(filename.characters(), &st) == 0;
+    if (have_stat) {
+        if (auto entry = m_cached_scripts.get(filename); entry.has_value() && entry->mtime == st.st_mtime) {
+            take_error();
+            return run_parsed_tree(*entry->ast) == 0;
+        }
+    }
+
     auto file_result = Core::File::open(filename, Core::OpenMode::ReadOnly);
     if (file_result.is_error()) {
         auto error = String::formatted("'{}': {}", escape_token_for_single_quotes(filename), file_result.error());
@@ -1029,7 +1045,17 @@ bool Shell::run_file(const String& filename, bool explicitly_invoked)
     }
     auto file = file_result.value();
     auto data = file->read_all();
-    return run_command(data) == 0;
+
+    take_error();
+
+    auto ast = Parser(data, m_is_interactive).parse();
+    if (!ast)
+        return true;
+
+    if (have_stat)
+        m_cached_scripts.set(filename, { st.st_mtime, *ast });
+
+    return run_parsed_tree(*ast) == 0;
 }
 
 bool Shell::is_allowed_to_modify_termios(const AST::Command& command) const
@@ -20,33 +20,38 @@
 #include <LibLine/Editor.h>
 #include <termios.h>
 
-#define ENUMERATE_SHELL_BUILTINS()     \
-    __ENUMERATE_SHELL_BUILTIN(alias)   \
-    __ENUMERATE_SHELL_BUILTIN(cd)      \
-    __ENUMERATE_SHELL_BUILTIN(cdh)     \
-    __ENUMERATE_SHELL_BUILTIN(pwd)     \
-    __ENUMERATE_SHELL_BUILTIN(type)    \
-    __ENUMERATE_SHELL_BUILTIN(exec)    \
-    __ENUMERATE_SHELL_BUILTIN(exit)    \
-    __ENUMERATE_SHELL_BUILTIN(export)  \
-    __ENUMERATE_SHELL_BUILTIN(glob)    \
-    __ENUMERATE_SHELL_BUILTIN(unset)   \
-    __ENUMERATE_SHELL_BUILTIN(history) \
-    __ENUMERATE_SHELL_BUILTIN(umask)   \
-    __ENUMERATE_SHELL_BUILTIN(not )    \
-    __ENUMERATE_SHELL_BUILTIN(dirs)    \
-    __ENUMERATE_SHELL_BUILTIN(pushd)   \
-    __ENUMERATE_SHELL_BUILTIN(popd)    \
-    __ENUMERATE_SHELL_BUILTIN(setopt)  \
-    __ENUMERATE_SHELL_BUILTIN(shift)   \
-    __ENUMERATE_SHELL_BUILTIN(source)  \
-    __ENUMERATE_SHELL_BUILTIN(time)    \
-    __ENUMERATE_SHELL_BUILTIN(jobs)    \
-    __ENUMERATE_SHELL_BUILTIN(disown)  \
-    __ENUMERATE_SHELL_BUILTIN(fg)      \
-    __ENUMERATE_SHELL_BUILTIN(bg)      \
-    __ENUMERATE_SHELL_BUILTIN(wait)    \
-    __ENUMERATE_SHELL_BUILTIN(dump)    \
+#define ENUMERATE_SHELL_BUILTINS()      \
+    __ENUMERATE_SHELL_BUILTIN(alias)    \
+    __ENUMERATE_SHELL_BUILTIN(basename) \
+    __ENUMERATE_SHELL_BUILTIN(cd)       \
+    __ENUMERATE_SHELL_BUILTIN(cdh)      \
+    __ENUMERATE_SHELL_BUILTIN(pwd)      \
+    __ENUMERATE_SHELL_BUILTIN(type)     \
+    __ENUMERATE_SHELL_BUILTIN(dirname)  \
+    __ENUMERATE_SHELL_BUILTIN(echo)     \
+    __ENUMERATE_SHELL_BUILTIN(exec)     \
+    __ENUMERATE_SHELL_BUILTIN(exit)     \
+    __ENUMERATE_SHELL_BUILTIN(export)   \
+    __ENUMERATE_SHELL_BUILTIN(glob)     \
+    __ENUMERATE_SHELL_BUILTIN(unset)    \
+    __ENUMERATE_SHELL_BUILTIN(history)  \
+    __ENUMERATE_SHELL_BUILTIN(umask)    \
+    __ENUMERATE_SHELL_BUILTIN(not )     \
+    __ENUMERATE_SHELL_BUILTIN(par)      \
+    __ENUMERATE_SHELL_BUILTIN(dirs)     \
+    __ENUMERATE_SHELL_BUILTIN(pushd)    \
+    __ENUMERATE_SHELL_BUILTIN(popd)     \
+    __ENUMERATE_SHELL_BUILTIN(setopt)   \
+    __ENUMERATE_SHELL_BUILTIN(shift)    \
+    __ENUMERATE_SHELL_BUILTIN(source)   \
+    __ENUMERATE_SHELL_BUILTIN(test)     \
+    __ENUMERATE_SHELL_BUILTIN(time)     \
+    __ENUMERATE_SHELL_BUILTIN(jobs)     \
+    __ENUMERATE_SHELL_BUILTIN(disown)   \
+    __ENUMERATE_SHELL_BUILTIN(fg)       \
+    __ENUMERATE_SHELL_BUILTIN(bg)       \
+    __ENUMERATE_SHELL_BUILTIN(wait)     \
+    __ENUMERATE_SHELL_BUILTIN(dump)     \
     __ENUMERATE_SHELL_BUILTIN(kill)
 
 #define ENUMERATE_SHELL_OPTIONS()                                                                                    \
@@ -85,6 +90,7 @@ public:
     };
 
     int run_command(const StringView&, Optional<SourcePosition> = {});
+    int run_parsed_tree(AST::Node&);
     bool is_runnable(const StringView&);
     RefPtr<Job> run_command(const AST::Command&);
     NonnullRefPtrVector<Job> run_commands(Vector<AST::Command>&);
@@ -335,7 +341,13 @@ private:
         RefPtr<AST::Node> body;
     };
 
+    struct CachedScript {
+        time_t mtime { 0 };
+        NonnullRefPtr<AST::Node> ast;
+    };
+
     HashMap<String, ShellFunction> m_functions;
+    HashMap<String, CachedScript> m_cached_scripts;
     NonnullOwnPtrVector<LocalFrame> m_local_frames;
     NonnullRefPtrVector<AST::Redirection> m_global_redirections;
 
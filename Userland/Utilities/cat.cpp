@@ -49,7 +49,26 @@ int main(int argc, char** argv)
     }
 
     for (auto& fd : fds) {
+        // When one end is a pipe (e.g. `cat file | gzip` or reading from
+        // stdin), splice() moves the data inside the kernel instead of
+        // copying it through our buffer. It refuses with EINVAL when neither
+        // end is a pipe, in which case we fall back to read()+write().
+        bool can_splice = true;
         for (;;) {
+            if (can_splice) {
+                ssize_t nspliced = splice(fd, 1, 32768);
+                if (nspliced > 0)
+                    continue;
+                if (nspliced == 0)
+                    break;
+                if (errno == EINTR)
+                    continue;
+                if (errno != EINVAL) {
+                    perror("splice");
+                    return 2;
+                }
+                can_splice = false;
+            }
             char buf[32768];
             ssize_t nread = read(fd, buf, sizeof(buf));
             if (nread == 0)
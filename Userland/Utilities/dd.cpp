@@ -8,6 +8,7 @@
 #include <AK/String.h>
 #include <AK/Vector.h>
 
+#include <errno.h>
 #include <fcntl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -195,7 +196,38 @@ int main(int argc, char** argv)
         }
     }
 
+    bool can_splice = true;
+
     while (1) {
+        // Once any skipped blocks have been consumed, try letting the kernel
+        // move each block directly with splice(); it refuses with EINVAL when
+        // neither end is a pipe, and then we fall back to read()+write().
+        if (can_splice && total_blocks_in + partial_blocks_in >= skip) {
+            ssize_t nspliced = splice(input_fd, output_fd, block_size);
+            if (nspliced > 0) {
+                if ((size_t)nspliced != block_size) {
+                    partial_blocks_in++;
+                    partial_blocks_out++;
+                } else {
+                    total_blocks_in++;
+                    total_blocks_out++;
+                }
+                total_bytes_copied += nspliced;
+                if (count > 0 && (partial_blocks_out + total_blocks_out) >= count)
+                    break;
+                continue;
+            }
+            if (nspliced == 0)
+                break;
+            if (errno == EINTR)
+                continue;
+            if (errno != EINVAL) {
+                fprintf(stderr, "Cannot splice from the input to the output.\n");
+                break;
+            }
+            can_splice = false;
+        }
+
         nread = read(input_fd, buffer, block_size);
         if (nread < 0) {
             fprintf(stderr, "Cannot read from the input.\n");
@@ -5,16 +5,23 @@
  */
 
 #include <AK/ByteBuffer.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/QuickSort.h>
+#include <AK/Random.h>
 #include <AK/ScopeGuard.h>
 #include <AK/String.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
+#include <LibCore/AsyncIORing.h>
 #include <LibCore/ElapsedTimer.h>
+#include <LibCore/EventLoop.h>
 #include <fcntl.h>
 #include <getopt.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <sys/stat.h>
+#include <sys/time.h>
 #include <unistd.h>
 
 struct Result {
@@ -22,6 +29,28 @@ struct Result {
     u64 read_bps {};
 };
 
+struct RandomPhaseResult {
+    u64 iops {};
+    u64 p50_us {};
+    u64 p90_us {};
+    u64 p99_us {};
+    u64 max_us {};
+};
+
+struct RandomResult {
+    RandomPhaseResult write {};
+    RandomPhaseResult read {};
+};
+
+static bool g_json_output = false;
+
+static u64 now_us()
+{
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    return (u64)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
 static Result average_result(const Vector<Result>& results)
 {
     Result average;
@@ -37,13 +66,38 @@ static Result average_result(const Vector<Result>& results)
     return average;
 }
 
+static u64 percentile(const Vector<u64>& sorted_latencies, int p)
+{
+    if (sorted_latencies.is_empty())
+        return 0;
+    size_t index = (sorted_latencies.size() * p) / 100;
+    if (index >= sorted_latencies.size())
+        index = sorted_latencies.size() - 1;
+    return sorted_latencies[index];
+}
+
+static RandomPhaseResult summarize_phase(Vector<u64>& latencies_us, u64 elapsed_us)
+{
+    RandomPhaseResult result;
+    if (latencies_us.is_empty() || !elapsed_us)
+        return result;
+    quick_sort(latencies_us);
+    result.iops = (u64)latencies_us.size() * 1000000 / elapsed_us;
+    result.p50_us = percentile(latencies_us, 50);
+    result.p90_us = percentile(latencies_us, 90);
+    result.p99_us = percentile(latencies_us, 99);
+    result.max_us = latencies_us.last();
+    return result;
+}
+
 static void exit_with_usage(int rc)
 {
-    warnln("Usage: disk_benchmark [-h] [-d directory] [-t time_per_benchmark] [-f file_size1,file_size2,...] [-b block_size1,block_size2,...]");
+    warnln("Usage: disk_benchmark [-h] [-c] [-j] [-d directory] [-t time_per_benchmark] [-f file_size1,file_size2,...] [-b block_size1,block_size2,...] [-q queue_depth1,queue_depth2,...]");
     exit(rc);
 }
 
 static Optional<Result> benchmark(const String& filename, int file_size, int block_size, ByteBuffer& buffer, bool allow_cache);
+static Optional<RandomResult> benchmark_random(const String& filename, int file_size, int block_size, int queue_depth, bool allow_cache, int seconds);
 
 int main(int argc, char** argv)
 {
@@ -51,10 +105,11 @@ int main(int argc, char** argv)
     int time_per_benchmark = 10;
     Vector<size_t> file_sizes;
     Vector<size_t> block_sizes;
+    Vector<size_t> queue_depths;
     bool allow_cache = false;
 
     int opt;
-    while ((opt = getopt(argc, argv, "chd:t:f:b:")) != -1) {
+    while ((opt = getopt(argc, argv, "chjd:t:f:b:q:")) != -1) {
         switch (opt) {
         case 'h':
             exit_with_usage(0);
@@ -62,6 +117,9 @@ int main(int argc, char** argv)
         case 'c':
             allow_cache = true;
             break;
+        case 'j':
+            g_json_output = true;
+            break;
         case 'd':
             directory = optarg;
             break;
@@ -76,6 +134,10 @@ int main(int argc, char** argv)
             for (const auto& size : String(optarg).split(','))
                 block_sizes.append(atoi(size.characters()));
             break;
+        case 'q':
+            for (const auto& depth : String(optarg).split(','))
+                queue_depths.append(atoi(depth.characters()));
+            break;
         }
     }
 
@@ -85,10 +147,17 @@ int main(int argc, char** argv)
     if (block_sizes.size() == 0) {
         block_sizes = { 8192, 32768, 65536 };
     }
+    if (queue_depths.size() == 0) {
+        queue_depths = { 1, 4, 16 };
+    }
 
     umask(0644);
 
+    // The async random benchmarks get their completions via the event loop.
+    Core::EventLoop event_loop;
+
     auto filename = String::formatted("{}/disk_benchmark.tmp", directory);
+    JsonArray json_results;
 
     for (auto file_size : file_sizes) {
         for (auto block_size : block_sizes) {
@@ -98,12 +167,15 @@ int main(int argc, char** argv)
             auto buffer = ByteBuffer::create_uninitialized(block_size);
             Vector<Result> results;
 
-            outln("Running: file_size={} block_size={}", file_size, block_size);
+            if (!g_json_output)
+                outln("Running: file_size={} block_size={}", file_size, block_size);
             Core::ElapsedTimer timer;
             timer.start();
             while (timer.elapsed() < time_per_benchmark * 1000) {
-                out(".");
-                fflush(stdout);
+                if (!g_json_output) {
+                    out(".");
+                    fflush(stdout);
+                }
                 auto result = benchmark(filename, file_size, block_size, buffer, allow_cache);
                 if (!result.has_value())
                     return 1;
@@ -111,12 +183,59 @@ int main(int argc, char** argv)
                 usleep(100);
             }
             auto average = average_result(results);
-            outln("Finished: runs={} time={}ms write_bps={} read_bps={}", results.size(), timer.elapsed(), average.write_bps, average.read_bps);
+            if (g_json_output) {
+                JsonObject object;
+                object.set("test", "sequential");
+                object.set("file_size", (u64)file_size);
+                object.set("block_size", (u64)block_size);
+                object.set("runs", (u64)results.size());
+                object.set("write_bps", average.write_bps);
+                object.set("read_bps", average.read_bps);
+                json_results.append(move(object));
+            } else {
+                outln("Finished: runs={} time={}ms write_bps={} read_bps={}", results.size(), timer.elapsed(), average.write_bps, average.read_bps);
+            }
 
             sleep(1);
+
+            for (auto queue_depth : queue_depths) {
+                if (!g_json_output)
+                    outln("Running: random file_size={} block_size={} queue_depth={}", file_size, block_size, queue_depth);
+                auto result = benchmark_random(filename, file_size, block_size, queue_depth, allow_cache, time_per_benchmark);
+                if (!result.has_value())
+                    return 1;
+                auto& random = result.value();
+                if (g_json_output) {
+                    JsonObject object;
+                    object.set("test", "random");
+                    object.set("file_size", (u64)file_size);
+                    object.set("block_size", (u64)block_size);
+                    object.set("queue_depth", (u64)queue_depth);
+                    object.set("write_iops", random.write.iops);
+                    object.set("write_p50_us", random.write.p50_us);
+                    object.set("write_p90_us", random.write.p90_us);
+                    object.set("write_p99_us", random.write.p99_us);
+                    object.set("write_max_us", random.write.max_us);
+                    object.set("read_iops", random.read.iops);
+                    object.set("read_p50_us", random.read.p50_us);
+                    object.set("read_p90_us", random.read.p90_us);
+                    object.set("read_p99_us", random.read.p99_us);
+                    object.set("read_max_us", random.read.max_us);
+                    json_results.append(move(object));
+                } else {
+                    outln("Finished: write_iops={} (p50={}us p99={}us) read_iops={} (p50={}us p99={}us)",
+                        random.write.iops, random.write.p50_us, random.write.p99_us,
+                        random.read.iops, random.read.p50_us, random.read.p99_us);
+                }
+
+                sleep(1);
+            }
         }
     }
 
+    if (g_json_output)
+        outln("{}", json_results.to_string());
+
     return 0;
 }
 
@@ -175,3 +294,122 @@ Optional<Result> benchmark(const String& filename, int file_size, int block_size
     result.read_bps = (u64)(timer.elapsed() ? (file_size / timer.elapsed()) : file_size) * 1000;
     return result;
 }
+
+static Optional<RandomPhaseResult> run_random_phase(int fd, int file_size, int block_size, int queue_depth, int seconds, bool is_write)
+{
+    u32 block_count = file_size / block_size;
+    Vector<ByteBuffer> buffers;
+    for (int i = 0; i < queue_depth; ++i)
+        buffers.append(ByteBuffer::create_uninitialized(block_size));
+
+    Vector<u64> latencies_us;
+    u64 phase_start = now_us();
+    u64 deadline = phase_start + (u64)seconds * 1000000;
+
+    auto random_offset = [&] {
+        return (u64)get_random_uniform(block_count) * block_size;
+    };
+
+    if (queue_depth == 1) {
+        auto& buffer = buffers[0];
+        while (now_us() < deadline) {
+            u64 op_start = now_us();
+            ssize_t rc = is_write
+                ? pwrite(fd, buffer.data(), block_size, random_offset())
+                : pread(fd, buffer.data(), block_size, random_offset());
+            if (rc < 0) {
+                perror(is_write ? "pwrite" : "pread");
+                return {};
+            }
+            latencies_us.append(now_us() - op_start);
+        }
+    } else {
+        // Keep queue_depth operations in flight: each completion records its
+        // latency and queues a replacement until the deadline passes, then
+        // the queue is left to drain.
+        auto ring = Core::AsyncIORing::construct();
+        int in_flight = 0;
+        bool failed = false;
+
+        Function<void(int)> start_operation = [&](int buffer_index) {
+            u64 op_start = now_us();
+            auto on_complete = [&, op_start, buffer_index](i64 result) {
+                --in_flight;
+                if (result < 0) {
+                    failed = true;
+                    return;
+                }
+                latencies_us.append(now_us() - op_start);
+                if (!failed && now_us() < deadline) {
+                    start_operation(buffer_index);
+                    ring->submit();
+                }
+            };
+            bool queued = is_write
+                ? ring->enqueue_write(fd, buffers[buffer_index].data(), block_size, random_offset(), move(on_complete))
+                : ring->enqueue_read(fd, buffers[buffer_index].data(), block_size, random_offset(), move(on_complete));
+            if (!queued)
+                failed = true;
+            else
+                ++in_flight;
+        };
+
+        for (int i = 0; i < queue_depth; ++i)
+            start_operation(i);
+        ring->submit();
+
+        while (in_flight > 0)
+            Core::EventLoop::current().pump();
+
+        if (failed) {
+            warnln("disk_benchmark: async {} failed", is_write ? "write" : "read");
+            return {};
+        }
+    }
+
+    return summarize_phase(latencies_us, now_us() - phase_start);
+}
+
+Optional<RandomResult> benchmark_random(const String& filename, int file_size, int block_size, int queue_depth, bool allow_cache, int seconds)
+{
+    int flags = O_CREAT | O_TRUNC | O_RDWR;
+    if (!allow_cache)
+        flags |= O_DIRECT;
+
+    int fd = open(filename.characters(), flags, 0644);
+    if (fd == -1) {
+        perror("open");
+        exit(1);
+    }
+
+    auto fd_cleanup = ScopeGuard([fd, filename] {
+        if (close(fd) < 0)
+            perror("close");
+        if (unlink(filename.characters()) < 0)
+            perror("unlink");
+    });
+
+    // Lay the file out up front so the random reads and in-place writes hit
+    // allocated blocks rather than growing the file.
+    auto buffer = ByteBuffer::create_uninitialized(block_size);
+    for (ssize_t j = 0; j < file_size; j += block_size) {
+        if (write(fd, buffer.data(), block_size) < 0) {
+            perror("write");
+            return {};
+        }
+    }
+
+    RandomResult result;
+
+    auto write_result = run_random_phase(fd, file_size, block_size, queue_depth, seconds, true);
+    if (!write_result.has_value())
+        return {};
+    result.write = write_result.release_value();
+
+    auto read_result = run_random_phase(fd, file_size, block_size, queue_depth, seconds, false);
+    if (!read_result.has_value())
+        return {};
+    result.read = read_result.release_value();
+
+    return result;
+}
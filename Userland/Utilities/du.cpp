@@ -11,7 +11,7 @@
 #include <AK/Vector.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/DateTime.h>
-#include <LibCore/DirIterator.h>
+#include <LibCore/DirectoryWalker.h>
 #include <LibCore/File.h>
 #include <LibCore/Object.h>
 #include <inttypes.h>
@@ -38,6 +38,7 @@ struct DuOption {
 };
 
 static int parse_args(int argc, char** argv, Vector<String>& files, DuOption& du_option, int& max_depth);
+static void print_entry(const String& path, off_t size, const DuOption& du_option);
 static int print_space_usage(const String& path, const DuOption& du_option, int max_depth);
 
 int main(int argc, char** argv)
@@ -125,43 +126,30 @@ int parse_args(int argc, char** argv, Vector<String>& files, DuOption& du_option
     return 0;
 }
 
-int print_space_usage(const String& path, const DuOption& du_option, int max_depth)
+void print_entry(const String& path, off_t size, const DuOption& du_option)
 {
-    struct stat path_stat;
-    if (lstat(path.characters(), &path_stat) < 0) {
-        perror("lstat");
-        return 1;
-    }
-
-    if (--max_depth >= 0 && S_ISDIR(path_stat.st_mode)) {
-        auto di = Core::DirIterator(path, Core::DirIterator::SkipParentAndBaseDir);
-        if (di.has_error()) {
-            fprintf(stderr, "DirIterator: %s\n", di.error_string());
-            return 1;
-        }
-        while (di.has_next()) {
-            const auto child_path = di.next_full_path();
-            if (du_option.all || Core::File::is_directory(child_path)) {
-                if (print_space_usage(child_path, du_option, max_depth))
-                    return 1;
-            }
-        }
-    }
-
     const auto basename = LexicalPath(path).basename();
     for (const auto& pattern : du_option.excluded_patterns) {
         if (basename.matches(pattern, CaseSensitivity::CaseSensitive))
-            return 0;
+            return;
     }
 
-    off_t size = path_stat.st_size;
-    if (du_option.apparent_size) {
-        const auto block_size = 512;
-        size = path_stat.st_blocks * block_size;
+    // The size usually comes straight from the directory stream; we only
+    // need a stat() when printing block counts or timestamps.
+    struct stat path_stat = {};
+    if (du_option.apparent_size || du_option.time_type != DuOption::TimeType::NotUsed) {
+        if (lstat(path.characters(), &path_stat) < 0) {
+            perror("lstat");
+            return;
+        }
+        if (du_option.apparent_size) {
+            const auto block_size = 512;
+            size = path_stat.st_blocks * block_size;
+        }
     }
 
     if ((du_option.threshold > 0 && size < du_option.threshold) || (du_option.threshold < 0 && size > -du_option.threshold))
-        return 0;
+        return;
 
     const long long block_size = 1024;
     size = size / block_size + (size % block_size != 0);
@@ -183,6 +171,46 @@ int print_space_usage(const String& path, const DuOption& du_option, int max_dep
         const auto formatted_time = Core::DateTime::from_timestamp(time).to_string();
         printf("%" PRIi64 "\t%s\t%s\n", size, formatted_time.characters(), path.characters());
     }
+}
 
-    return 0;
+int print_space_usage(const String& path, const DuOption& du_option, int max_depth)
+{
+    struct stat path_stat;
+    if (lstat(path.characters(), &path_stat) < 0) {
+        perror("lstat");
+        return 1;
+    }
+
+    int error = 0;
+    if (max_depth >= 1 && S_ISDIR(path_stat.st_mode)) {
+        Core::DirectoryWalker walker(path);
+
+        walker.on_error = [&](const String& error_path, int walker_error) {
+            fprintf(stderr, "%s: %s\n", error_path.characters(), strerror(walker_error));
+            error = 1;
+        };
+
+        // A directory is printed after its contents, so remember its size on
+        // the way down and print it when the walker leaves it again.
+        Vector<off_t> directory_sizes;
+        walker.on_directory_exit = [&](const String& exit_path, size_t) {
+            print_entry(exit_path, directory_sizes.take_last(), du_option);
+        };
+
+        for (auto entry = walker.next(); entry.has_value(); entry = walker.next()) {
+            if (entry->type == DT_DIR) {
+                if (static_cast<int>(entry->depth) + 2 > max_depth) {
+                    walker.skip_subtree();
+                    print_entry(entry->full_path, entry->size, du_option);
+                } else {
+                    directory_sizes.append(entry->size);
+                }
+            } else if (du_option.all) {
+                print_entry(entry->full_path, entry->size, du_option);
+            }
+        }
+    }
+
+    print_entry(path, path_stat.st_size, du_option);
+    return error;
 }
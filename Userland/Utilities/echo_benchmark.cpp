@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <AK/QuickSort.h>
+#include <AK/Vector.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/TCPSocket.h>
+#include <LibCore/Timer.h>
+#include <stdio.h>
+#include <time.h>
+
+// Opens a crowd of concurrent connections to an echo server (e.g. EchoServer
+// on port 7), sends a small payload on each, and reports how long the
+// round trips take. Useful for keeping an eye on how connection count
+// affects the event loop and the network stack.
+
+static u64 now_ns()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (u64)now.tv_sec * 1'000'000'000 + now.tv_nsec;
+}
+
+struct Connection {
+    RefPtr<Core::TCPSocket> socket;
+    u64 sent_at { 0 };
+    u64 latency { 0 };
+    size_t bytes_received { 0 };
+};
+
+int main(int argc, char** argv)
+{
+    const char* host = "127.0.0.1";
+    int port = 7;
+    int connection_count = 1000;
+    int payload_size = 16;
+
+    Core::ArgsParser args_parser;
+    args_parser.add_option(host, "Host to connect to", "host", 'h', "host");
+    args_parser.add_option(port, "Port of the echo server", "port", 'p', "port");
+    args_parser.add_option(connection_count, "Number of concurrent connections", "connections", 'c', "count");
+    args_parser.add_option(payload_size, "Payload size in bytes", "size", 's', "bytes");
+    args_parser.parse(argc, argv);
+
+    if (connection_count < 1 || payload_size < 1) {
+        warnln("Connection count and payload size must be positive");
+        return 1;
+    }
+
+    Core::EventLoop loop;
+
+    Vector<Connection> connections;
+    connections.resize(connection_count);
+
+    size_t connected = 0;
+    u64 connect_start = now_ns();
+    for (auto& connection : connections) {
+        connection.socket = Core::TCPSocket::construct();
+        connection.socket->on_connected = [&connected] { ++connected; };
+        if (!connection.socket->connect(host, port)) {
+            warnln("Failed to connect to {}:{}", host, port);
+            return 1;
+        }
+    }
+    while (connected < (size_t)connection_count)
+        loop.pump();
+    u64 connect_duration = now_ns() - connect_start;
+
+    auto payload = ByteBuffer::create_zeroed(payload_size);
+    memset(payload.data(), 'x', payload.size());
+
+    size_t completed = 0;
+    for (auto& connection : connections) {
+        connection.socket->on_ready_to_read = [&connection, &completed, &loop, payload_size, connection_count] {
+            u8 buffer[4096];
+            auto nread = connection.socket->read(buffer, min(sizeof(buffer), (size_t)payload_size - connection.bytes_received));
+            if (nread <= 0)
+                return;
+            connection.bytes_received += nread;
+            if (connection.bytes_received >= (size_t)payload_size && !connection.latency) {
+                connection.latency = now_ns() - connection.sent_at;
+                if (++completed == (size_t)connection_count)
+                    loop.quit(0);
+            }
+        };
+    }
+
+    u64 echo_start = now_ns();
+    for (auto& connection : connections) {
+        connection.sent_at = now_ns();
+        if (!connection.socket->send(payload.bytes())) {
+            warnln("Failed to send payload");
+            return 1;
+        }
+    }
+
+    auto timeout = Core::Timer::create_single_shot(30'000, [&] {
+        warnln("Timed out after completing {}/{} echoes", completed, connection_count);
+        loop.quit(1);
+    });
+    timeout->start();
+
+    if (loop.exec() != 0)
+        return 1;
+    u64 echo_duration = now_ns() - echo_start;
+
+    Vector<u64> latencies;
+    latencies.ensure_capacity(connections.size());
+    for (auto& connection : connections)
+        latencies.unchecked_append(connection.latency);
+    quick_sort(latencies);
+
+    u64 total_latency = 0;
+    for (auto latency : latencies)
+        total_latency += latency;
+
+    outln("{} connections to {}:{}, {} byte payload", connection_count, host, port, payload_size);
+    outln("connect: {} ms total ({} connections/s)",
+        connect_duration / 1'000'000,
+        connect_duration ? (u64)connection_count * 1'000'000'000 / connect_duration : 0);
+    outln("echo:    {} ms until all {} responses arrived", echo_duration / 1'000'000, connection_count);
+    outln("latency: min {} us, avg {} us, p50 {} us, p99 {} us, max {} us",
+        latencies.first() / 1'000,
+        total_latency / latencies.size() / 1'000,
+        latencies[latencies.size() / 2] / 1'000,
+        latencies[latencies.size() * 99 / 100] / 1'000,
+        latencies.last() / 1'000);
+    return 0;
+}
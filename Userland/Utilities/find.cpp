@@ -9,12 +9,13 @@
 #include <AK/NonnullOwnPtr.h>
 #include <AK/OwnPtr.h>
 #include <AK/Vector.h>
-#include <LibCore/DirIterator.h>
+#include <LibCore/DirectoryWalker.h>
 #include <errno.h>
 #include <getopt.h>
 #include <grp.h>
 #include <pwd.h>
 #include <stdio.h>
+#include <string.h>
 #include <sys/stat.h>
 #include <sys/wait.h>
 #include <unistd.h>
@@ -453,23 +454,18 @@ static void walk_tree(const char* root_path, Command& command)
 {
     command.evaluate(root_path);
 
-    Core::DirIterator dir_iterator(root_path, Core::DirIterator::SkipParentAndBaseDir);
-    if (dir_iterator.has_error() && dir_iterator.error() == ENOTDIR)
-        return;
-
-    while (dir_iterator.has_next()) {
-        auto path = dir_iterator.next_full_path();
-        struct stat stat;
-        if (g_follow_symlinks || ::lstat(path.characters(), &stat) < 0 || !S_ISLNK(stat.st_mode))
-            walk_tree(path.characters(), command);
-        else
-            command.evaluate(path.characters());
-    }
-
-    if (dir_iterator.has_error()) {
-        fprintf(stderr, "%s: %s\n", root_path, dir_iterator.error_string());
+    Core::DirectoryWalker walker(root_path, g_follow_symlinks);
+    walker.on_error = [&](const String& path, int error) {
+        // A root that isn't a directory has already been evaluated above;
+        // there's simply nothing to walk.
+        if (error == ENOTDIR)
+            return;
+        fprintf(stderr, "%s: %s\n", path.characters(), strerror(error));
         g_there_was_an_error = true;
-    }
+    };
+
+    for (auto entry = walker.next(); entry.has_value(); entry = walker.next())
+        command.evaluate(entry->full_path.characters());
 }
 
 int main(int argc, char* argv[])
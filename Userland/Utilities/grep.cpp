@@ -6,15 +6,22 @@
 
 #include <AK/Assertions.h>
 #include <AK/ByteBuffer.h>
+#include <AK/MappedFile.h>
+#include <AK/MemMem.h>
+#include <AK/NonnullRefPtrVector.h>
 #include <AK/ScopeGuard.h>
 #include <AK/String.h>
+#include <AK/StringBuilder.h>
 #include <AK/Utf8View.h>
 #include <AK/Vector.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/DirIterator.h>
 #include <LibCore/File.h>
 #include <LibRegex/Regex.h>
+#include <LibThreading/ThreadPool.h>
 #include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 enum class BinaryFileMode {
@@ -32,9 +39,60 @@ void fail(StringView format, Ts... args)
     abort();
 }
 
+// A pattern with none of these is a plain literal, and we can skip the regex
+// engine entirely in favor of memmem().
+static bool pattern_is_literal(StringView pattern)
+{
+    for (auto c : pattern) {
+        switch (c) {
+        case '.':
+        case '^':
+        case '$':
+        case '*':
+        case '+':
+        case '?':
+        case '(':
+        case ')':
+        case '[':
+        case ']':
+        case '{':
+        case '}':
+        case '|':
+        case '\\':
+            return false;
+        default:
+            break;
+        }
+    }
+    return true;
+}
+
+struct MatchSpan {
+    size_t offset { 0 };
+    size_t length { 0 };
+};
+
+static bool find_literal_matches(StringView line, StringView needle, Vector<MatchSpan>& spans)
+{
+    if (needle.is_empty()) {
+        // An empty pattern matches every line.
+        return true;
+    }
+    size_t start = 0;
+    while (start + needle.length() <= line.length()) {
+        auto* hit = AK::memmem(line.characters_without_null_termination() + start, line.length() - start, needle.characters_without_null_termination(), needle.length());
+        if (!hit)
+            break;
+        size_t offset = static_cast<const char*>(hit) - line.characters_without_null_termination();
+        spans.append({ offset, needle.length() });
+        start = offset + needle.length();
+    }
+    return !spans.is_empty();
+}
+
 int main(int argc, char** argv)
 {
-    if (pledge("stdio rpath", nullptr) < 0) {
+    if (pledge("stdio rpath thread", nullptr) < 0) {
         perror("pledge");
         return 1;
     }
@@ -104,67 +162,102 @@ int main(int argc, char** argv)
     if (case_insensitive)
         options |= PosixFlags::Insensitive;
 
+    // Case-insensitive literals still go through the regex engine; it already
+    // knows how to fold case.
+    bool use_literal_path = pattern_is_literal(pattern) && !case_insensitive;
+    StringView literal_needle { pattern };
+
     Regex<PosixExtended> re(pattern, options);
     if (re.parser_result.error != Error::NoError) {
         return 1;
     }
 
-    auto matches = [&](StringView str, StringView filename = "", bool print_filename = false, bool is_binary = false) {
-        size_t last_printed_char_pos { 0 };
+    // Collects the spans to highlight on this line, and returns whether the
+    // line matched at all.
+    auto line_matches = [&](Regex<PosixExtended>& regex, StringView line, Vector<MatchSpan>& spans) -> bool {
+        if (use_literal_path)
+            return find_literal_matches(line, literal_needle, spans);
+        auto result = regex.match(line, PosixFlags::Global);
+        if (!result.success)
+            return false;
+        for (auto& match : result.matches)
+            spans.append({ match.global_offset, match.view.length() });
+        return true;
+    };
+
+    // Scans a whole (mmap'd) buffer line by line, appending formatted output.
+    // Returns whether anything matched.
+    auto scan_buffer = [&](Regex<PosixExtended>& regex, StringView buffer, StringView filename, bool print_filename, StringBuilder& output) -> bool {
+        auto* data = buffer.characters_without_null_termination();
+        bool is_binary = buffer.length() && memchr(data, 0, buffer.length()) != nullptr;
         if (is_binary && binary_mode == BinaryFileMode::Skip)
             return false;
 
-        auto result = re.match(str, PosixFlags::Global);
-        if (result.success ^ invert_match) {
-            if (is_binary && binary_mode == BinaryFileMode::Binary) {
-                outln("binary file \x1B[34m{}\x1B[0m matches", filename);
-            } else {
-                if ((result.matches.size() || invert_match) && print_filename) {
-                    out("\x1B[34m{}:\x1B[0m", filename);
-                }
+        bool did_match = false;
+        Vector<MatchSpan> spans;
+        size_t offset = 0;
+        while (offset < buffer.length()) {
+            auto* newline = static_cast<const char*>(memchr(data + offset, '\n', buffer.length() - offset));
+            size_t line_length = newline ? static_cast<size_t>(newline - (data + offset)) : buffer.length() - offset;
+            StringView line { data + offset, line_length };
+            offset += line_length + 1;
 
-                for (auto& match : result.matches) {
+            spans.clear_with_capacity();
+            bool matched = line_matches(regex, line, spans);
+            if (!(matched ^ invert_match))
+                continue;
 
-                    out("{}\x1B[32m{}\x1B[0m",
-                        StringView(&str[last_printed_char_pos], match.global_offset - last_printed_char_pos),
-                        match.view.to_string());
-                    last_printed_char_pos = match.global_offset + match.view.length();
-                }
-                outln("{}", StringView(&str[last_printed_char_pos], str.length() - last_printed_char_pos));
+            did_match = true;
+            if (is_binary && binary_mode == BinaryFileMode::Binary) {
+                output.appendff("binary file \x1B[34m{}\x1B[0m matches\n", filename);
+                return true;
             }
 
-            return true;
+            if (print_filename)
+                output.appendff("\x1B[34m{}:\x1B[0m", filename);
+            size_t last_printed_char_pos = 0;
+            for (auto& span : spans) {
+                output.append(line.substring_view(last_printed_char_pos, span.offset - last_printed_char_pos));
+                output.appendff("\x1B[32m{}\x1B[0m", line.substring_view(span.offset, span.length));
+                last_printed_char_pos = span.offset + span.length;
+            }
+            output.append(line.substring_view(last_printed_char_pos, line.length() - last_printed_char_pos));
+            output.append('\n');
         }
-
-        return false;
+        return did_match;
     };
 
-    auto handle_file = [&matches, binary_mode](StringView filename, bool print_filename) -> bool {
-        auto file = Core::File::construct(filename);
-        if (!file->open(Core::OpenMode::ReadOnly)) {
-            warnln("Failed to open {}: {}", filename, file->error_string());
-            return false;
-        }
-
-        while (file->can_read_line()) {
-            auto line = file->read_line();
-            auto is_binary = memchr(line.characters(), 0, line.length()) != nullptr;
+    enum class FileResult {
+        NoMatch,
+        Matched,
+        Error,
+    };
 
-            if (matches(line, filename, print_filename, is_binary) && is_binary && binary_mode == BinaryFileMode::Binary)
-                return true;
+    auto handle_file = [&](Regex<PosixExtended>& regex, StringView filename, bool print_filename, StringBuilder& output) -> FileResult {
+        auto file_or_error = MappedFile::map(filename);
+        if (file_or_error.is_error()) {
+            // mmap() has nothing to map for an empty file; there's also
+            // nothing to search.
+            struct stat st;
+            if (stat(String(filename).characters(), &st) == 0 && st.st_size == 0)
+                return FileResult::NoMatch;
+            warnln("Failed to open {}: {}", filename, file_or_error.error());
+            return FileResult::Error;
         }
-        return true;
+        auto& file = *file_or_error.value();
+        StringView buffer { static_cast<const char*>(file.data()), file.size() };
+        return scan_buffer(regex, buffer, filename, print_filename, output) ? FileResult::Matched : FileResult::NoMatch;
     };
 
-    auto add_directory = [&handle_file](String base, Optional<String> recursive, auto handle_directory) -> void {
-        Core::DirIterator it(recursive.value_or(base), Core::DirIterator::Flags::SkipDots);
+    auto add_directory = [](String base, Optional<String> recursive_path, Vector<String>& paths, auto handle_directory) -> void {
+        Core::DirIterator it(recursive_path.value_or(base), Core::DirIterator::Flags::SkipDots);
         while (it.has_next()) {
             auto path = it.next_full_path();
             if (!Core::File::is_directory(path)) {
                 auto key = path.substring_view(base.length() + 1, path.length() - base.length() - 1);
-                handle_file(key, true);
+                paths.append(key);
             } else {
-                handle_directory(base, path, handle_directory);
+                handle_directory(base, path, paths, handle_directory);
             }
         }
     };
@@ -177,26 +270,84 @@ int main(int argc, char** argv)
         ScopeGuard free_line = [line] { free(line); };
         while ((nread = getline(&line, &line_len, stdin)) != -1) {
             VERIFY(nread > 0);
+            if (line[nread - 1] == '\n')
+                --nread;
             StringView line_view(line, nread);
             bool is_binary = line_view.contains(0);
 
             if (is_binary && binary_mode == BinaryFileMode::Skip)
                 return 1;
 
-            auto matched = matches(line_view, "stdin", false, is_binary);
-            did_match_something = did_match_something || matched;
-            if (matched && is_binary && binary_mode == BinaryFileMode::Binary)
-                return 0;
+            StringBuilder output;
+            Vector<MatchSpan> spans;
+            bool matched = line_matches(re, line_view, spans);
+            if (matched ^ invert_match) {
+                did_match_something = true;
+                if (is_binary && binary_mode == BinaryFileMode::Binary) {
+                    outln("binary file \x1B[34m{}\x1B[0m matches", "stdin");
+                    return 0;
+                }
+                size_t last_printed_char_pos = 0;
+                for (auto& span : spans) {
+                    out("{}\x1B[32m{}\x1B[0m",
+                        line_view.substring_view(last_printed_char_pos, span.offset - last_printed_char_pos),
+                        line_view.substring_view(span.offset, span.length));
+                    last_printed_char_pos = span.offset + span.length;
+                }
+                outln("{}", line_view.substring_view(last_printed_char_pos, line_view.length() - last_printed_char_pos));
+            }
         }
     } else {
         if (recursive) {
-            add_directory(".", {}, add_directory);
+            Vector<String> paths;
+            add_directory(".", {}, paths, add_directory);
 
+            // One task per file; workers buffer their output per file so the
+            // results can be printed without interleaving, in directory order.
+            auto& pool = Threading::ThreadPool::the();
+            Vector<String> outputs;
+            outputs.resize(paths.size());
+            Vector<FileResult> results;
+            results.resize(paths.size());
+            NonnullRefPtrVector<Threading::ThreadPool::Task> tasks;
+            tasks.ensure_capacity(paths.size());
+
+            for (size_t i = 0; i < paths.size(); ++i) {
+                tasks.append(pool.submit([&, i] {
+                    StringBuilder output;
+                    if (use_literal_path) {
+                        results[i] = handle_file(re, paths[i], true, output);
+                    } else {
+                        // The regex engine keeps per-match state, so each
+                        // worker compiles its own copy of the pattern.
+                        static thread_local OwnPtr<Regex<PosixExtended>> worker_re;
+                        if (!worker_re)
+                            worker_re = make<Regex<PosixExtended>>(pattern, options);
+                        results[i] = handle_file(*worker_re, paths[i], true, output);
+                    }
+                    outputs[i] = output.build();
+                }));
+            }
+
+            for (auto& task : tasks)
+                task.wait();
+
+            for (size_t i = 0; i < paths.size(); ++i) {
+                if (!outputs[i].is_empty())
+                    out("{}", outputs[i]);
+                if (results[i] == FileResult::Matched)
+                    did_match_something = true;
+            }
         } else {
             bool print_filename { files.size() > 1 };
             for (auto& filename : files) {
-                if (!handle_file(filename, print_filename))
+                StringBuilder output;
+                auto result = handle_file(re, filename, print_filename, output);
+                if (result == FileResult::Error)
                     return 1;
+                out("{}", output.to_string());
+                if (result == FileResult::Matched)
+                    did_match_something = true;
             }
         }
     }
@@ -15,16 +15,26 @@ int main(int argc, char** argv)
     Vector<String> filenames;
     bool keep_input_files { false };
     bool write_to_stdout { false };
+    bool fast { false };
+    bool best { false };
 
     Core::ArgsParser args_parser;
     args_parser.add_option(keep_input_files, "Keep (don't delete) input files", "keep", 'k');
     args_parser.add_option(write_to_stdout, "Write to stdout, keep original files unchanged", "stdout", 'c');
+    args_parser.add_option(fast, "Compress faster (worse compression)", "fast", '1');
+    args_parser.add_option(best, "Compress better (slower)", "best", '9');
     args_parser.add_positional_argument(filenames, "File to compress", "FILE");
     args_parser.parse(argc, argv);
 
     if (write_to_stdout)
         keep_input_files = true;
 
+    auto compression_level = Compress::DeflateCompressor::CompressionLevel::GOOD;
+    if (fast)
+        compression_level = Compress::DeflateCompressor::CompressionLevel::FAST;
+    else if (best)
+        compression_level = Compress::DeflateCompressor::CompressionLevel::BEST;
+
     for (auto const& input_filename : filenames) {
         auto output_filename = String::formatted("{}.gz", input_filename);
 
@@ -37,26 +47,29 @@ int main(int argc, char** argv)
         }
         auto file = file_or_error.value();
 
-        auto compressed_file = Compress::GzipCompressor::compress_all(file->bytes());
-        if (!compressed_file.has_value()) {
-            warnln("Failed gzip compressing input file");
-            return 1;
-        }
+        // Compress straight into the output stream so we never buffer the
+        // whole compressed file in memory.
+        auto compress_into = [&](OutputStream& output_stream) {
+            Compress::GzipCompressor gzip_stream { output_stream, compression_level };
+            auto success = gzip_stream.write_or_error(file->bytes());
+            gzip_stream.final_flush();
+            return success && !gzip_stream.handle_any_error();
+        };
 
         auto success = false;
         if (write_to_stdout) {
             auto stdout = Core::OutputFileStream { Core::File::standard_output() };
-            success = stdout.write_or_error(compressed_file.value());
+            success = compress_into(stdout);
         } else {
             auto output_stream_result = Core::OutputFileStream::open(output_filename);
             if (output_stream_result.is_error()) {
                 warnln("Failed opening output file for writing: {}", output_stream_result.error());
                 return 1;
             }
-            success = output_stream_result.value().write_or_error(compressed_file.value());
+            success = compress_into(output_stream_result.value());
         }
         if (!success) {
-            warnln("Failed writing compressed file to output");
+            warnln("Failed gzip compressing input file");
             return 1;
         }
 
@@ -14,6 +14,9 @@
 #include <LibCore/File.h>
 #include <LibCore/StandardPaths.h>
 #include <LibJS/AST.h>
+#include <LibJS/Bytecode/Block.h>
+#include <LibJS/Bytecode/Generator.h>
+#include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Console.h>
 #include <LibJS/Interpreter.h>
 #include <LibJS/Parser.h>
@@ -73,6 +76,8 @@ private:
 };
 
 static bool s_dump_ast = false;
+static bool s_dump_bytecode = false;
+static bool s_run_bytecode = false;
 static bool s_print_last_result = false;
 static RefPtr<Line::Editor> s_editor;
 static String s_history_path = String::formatted("{}/.js-history", Core::StandardPaths::home_directory());
@@ -496,7 +501,19 @@ static bool parse_and_run(JS::Interpreter& interpreter, const StringView& source
             outln("{}", hint);
         vm->throw_exception<JS::SyntaxError>(interpreter.global_object(), error.to_string());
     } else {
-        interpreter.run(interpreter.global_object(), *program);
+        OwnPtr<JS::Bytecode::Block> bytecode_block;
+        if (s_dump_bytecode || s_run_bytecode)
+            bytecode_block = JS::Bytecode::Generator::generate(*program);
+        if (bytecode_block && s_dump_bytecode)
+            bytecode_block->dump();
+        if (bytecode_block && s_run_bytecode) {
+            JS::Bytecode::Interpreter bytecode_interpreter(interpreter.global_object());
+            bytecode_interpreter.run(*bytecode_block);
+        } else {
+            // No bytecode generated for part of this program yet; use the
+            // AST interpreter.
+            interpreter.run(interpreter.global_object(), *program);
+        }
     }
 
     auto handle_exception = [&] {
@@ -744,6 +761,8 @@ int main(int argc, char** argv)
     Core::ArgsParser args_parser;
     args_parser.set_general_help("This is a JavaScript interpreter.");
     args_parser.add_option(s_dump_ast, "Dump the AST", "dump-ast", 'A');
+    args_parser.add_option(s_dump_bytecode, "Dump the bytecode", "dump-bytecode", 'd');
+    args_parser.add_option(s_run_bytecode, "Run the bytecode", "run-bytecode", 'b');
     args_parser.add_option(s_print_last_result, "Print last result", "print-last-result", 'l');
     args_parser.add_option(gc_on_every_allocation, "GC on every allocation", "gc-on-every-allocation", 'g');
     args_parser.add_option(disable_syntax_highlight, "Disable live syntax highlighting", "no-syntax-highlight", 's');
@@ -6,8 +6,10 @@
 
 #include <AK/Assertions.h>
 #include <AK/LexicalPath.h>
+#include <AK/MappedFile.h>
 #include <AK/Span.h>
 #include <AK/Vector.h>
+#include <LibArchive/TarReader.h>
 #include <LibArchive/TarStream.h>
 #include <LibCompress/Gzip.h>
 #include <LibCore/ArgsParser.h>
@@ -46,6 +48,75 @@ int main(int argc, char** argv)
     }
 
     if (list || extract) {
+        if (archive_file && !gzip) {
+            // An uncompressed archive on disk gets mapped and read in place
+            // instead of being pulled block by block through a stream.
+            auto maybe_mapped_file = MappedFile::map(archive_file);
+            if (maybe_mapped_file.is_error()) {
+                warnln("Failed to map {}: {}", archive_file, maybe_mapped_file.error());
+                return 1;
+            }
+            auto mapped_file = maybe_mapped_file.release_value();
+
+            Archive::TarReader reader { mapped_file->bytes() };
+            if (!reader.valid()) {
+                warnln("the provided file is not a well-formatted ustar file");
+                return 1;
+            }
+            for (; !reader.finished(); reader.advance()) {
+                const Archive::TarFileHeader& header = reader.header();
+                if (list || verbose)
+                    outln("{}", header.filename());
+
+                if (!extract)
+                    continue;
+
+                switch (header.type_flag()) {
+                case Archive::TarFileType::NormalFile:
+                case Archive::TarFileType::AlternateNormalFile: {
+                    int fd = open(String(header.filename()).characters(), O_CREAT | O_WRONLY, header.mode());
+                    if (fd < 0) {
+                        perror("open");
+                        return 1;
+                    }
+
+                    auto contents = reader.contents();
+                    size_t offset = 0;
+                    while (offset < contents.size()) {
+                        auto nwritten = write(fd, contents.data() + offset, contents.size() - offset);
+                        if (nwritten < 0) {
+                            perror("write");
+                            return 1;
+                        }
+                        offset += nwritten;
+                    }
+                    close(fd);
+                    break;
+                }
+                case Archive::TarFileType::Directory: {
+                    if (mkdir(String(header.filename()).characters(), header.mode())) {
+                        perror("mkdir");
+                        return 1;
+                    }
+                    break;
+                }
+                case Archive::TarFileType::GlobalExtendedHeader: {
+                    dbgln("ignoring global extended header: {}", header.filename());
+                    break;
+                }
+                case Archive::TarFileType::ExtendedHeader: {
+                    dbgln("ignoring extended header: {}", header.filename());
+                    break;
+                }
+                default:
+                    // FIXME: Implement other file types
+                    warnln("file type '{}' of {} is not yet supported", (char)header.type_flag(), header.filename());
+                    VERIFY_NOT_REACHED();
+                }
+            }
+            return 0;
+        }
+
         auto file = Core::File::standard_input();
 
         if (archive_file) {
@@ -139,11 +210,11 @@ int main(int argc, char** argv)
         }
 
         Core::OutputFileStream file_stream(file);
-        Compress::GzipCompressor gzip_stream(file_stream);
+        OwnPtr<Compress::GzipCompressor> gzip_stream;
+        if (gzip)
+            gzip_stream = make<Compress::GzipCompressor>(file_stream);
 
-        OutputStream& file_output_stream = file_stream;
-        OutputStream& gzip_output_stream = gzip_stream;
-        Archive::TarOutputStream tar_stream((gzip) ? gzip_output_stream : file_output_stream);
+        Archive::TarOutputStream tar_stream(gzip ? static_cast<OutputStream&>(*gzip_stream) : static_cast<OutputStream&>(file_stream));
 
         auto add_file = [&](String path) {
             auto file = Core::File::construct(path);
@@ -194,6 +265,8 @@ int main(int argc, char** argv)
         }
 
         tar_stream.finish();
+        if (gzip)
+            gzip_stream->final_flush();
 
         return 0;
     }
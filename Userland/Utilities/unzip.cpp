@@ -5,65 +5,65 @@
  */
 
 #include <AK/Assertions.h>
+#include <AK/Atomic.h>
 #include <AK/MappedFile.h>
 #include <AK/NumberFormat.h>
+#include <AK/ScopeGuard.h>
 #include <LibArchive/Zip.h>
 #include <LibCompress/Deflate.h>
 #include <LibCore/ArgsParser.h>
-#include <LibCore/File.h>
+#include <LibThreading/ThreadPool.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
-static bool unpack_zip_member(Archive::ZipMember zip_member)
+// Runs on a worker thread, so only thread-safe facilities: raw file
+// descriptors instead of Core::File.
+static bool unpack_file_member(const Archive::ZipMember& zip_member)
 {
-    if (zip_member.is_directory) {
-        if (mkdir(zip_member.name.characters(), 0755) < 0) {
-            perror("mkdir");
-            return false;
-        }
-        outln(" extracting: {}", zip_member.name);
-        return true;
-    }
-    auto new_file = Core::File::construct(zip_member.name);
-    if (!new_file->open(Core::OpenMode::WriteOnly)) {
-        warnln("Can't write file {}: {}", zip_member.name, new_file->error_string());
+    int fd = open(zip_member.name.characters(), O_CREAT | O_WRONLY | O_TRUNC, 0644);
+    if (fd < 0) {
+        warnln("Can't write file {}: {}", zip_member.name, strerror(errno));
         return false;
     }
+    ScopeGuard close_guard = [fd] { close(fd); };
 
-    outln(" extracting: {}", zip_member.name);
+    // Preallocate, so the writes below never have to extend the file.
+    if (zip_member.uncompressed_size > 0 && ftruncate(fd, zip_member.uncompressed_size) < 0) {
+        warnln("Can't preallocate file {}: {}", zip_member.name, strerror(errno));
+        return false;
+    }
 
     // TODO: verify CRC32s match!
+    ReadonlyBytes data;
+    Optional<ByteBuffer> decompressed_data;
     switch (zip_member.compression_method) {
-    case Archive::ZipCompressionMethod::Store: {
-        if (!new_file->write(zip_member.compressed_data.data(), zip_member.compressed_data.size())) {
-            warnln("Can't write file contents in {}: {}", zip_member.name, new_file->error_string());
-            return false;
-        }
+    case Archive::ZipCompressionMethod::Store:
+        data = zip_member.compressed_data;
         break;
-    }
     case Archive::ZipCompressionMethod::Deflate: {
-        auto decompressed_data = Compress::DeflateDecompressor::decompress_all(zip_member.compressed_data);
-        if (!decompressed_data.has_value()) {
-            warnln("Failed decompressing file {}", zip_member.name);
-            return false;
-        }
-        if (decompressed_data.value().size() != zip_member.uncompressed_size) {
+        decompressed_data = Compress::DeflateDecompressor::decompress_all(zip_member.compressed_data);
+        if (!decompressed_data.has_value() || decompressed_data.value().size() != zip_member.uncompressed_size) {
             warnln("Failed decompressing file {}", zip_member.name);
             return false;
         }
-        if (!new_file->write(decompressed_data.value().data(), decompressed_data.value().size())) {
-            warnln("Can't write file contents in {}: {}", zip_member.name, new_file->error_string());
-            return false;
-        }
+        data = decompressed_data.value().bytes();
         break;
     }
     default:
         VERIFY_NOT_REACHED();
     }
 
-    if (!new_file->close()) {
-        warnln("Can't close file {}: {}", zip_member.name, new_file->error_string());
-        return false;
+    size_t offset = 0;
+    while (offset < data.size()) {
+        auto nwritten = write(fd, data.data() + offset, data.size() - offset);
+        if (nwritten < 0) {
+            warnln("Can't write file contents in {}: {}", zip_member.name, strerror(errno));
+            return false;
+        }
+        offset += nwritten;
     }
 
     return true;
@@ -129,9 +129,38 @@ int main(int argc, char** argv)
         }
     }
 
-    auto success = zip_file->for_each_member([&](auto zip_member) {
-        return unpack_zip_member(zip_member) ? IterationDecision::Continue : IterationDecision::Break;
+    // Directories have to exist before the files inside them, so they are
+    // created first, in archive order.
+    bool success = true;
+    zip_file->for_each_member([&](auto& zip_member) {
+        if (!zip_member.is_directory)
+            return IterationDecision::Continue;
+        outln(" extracting: {}", zip_member.name);
+        if (mkdir(zip_member.name.characters(), 0755) < 0 && errno != EEXIST) {
+            perror("mkdir");
+            success = false;
+            return IterationDecision::Break;
+        }
+        return IterationDecision::Continue;
+    });
+    if (!success)
+        return 1;
+
+    // Files are independent of each other, so they inflate in parallel.
+    Atomic<bool> all_members_ok { true };
+    Vector<NonnullRefPtr<Threading::ThreadPool::Task>> tasks;
+    zip_file->for_each_member([&](auto& zip_member) {
+        if (zip_member.is_directory)
+            return IterationDecision::Continue;
+        outln(" extracting: {}", zip_member.name);
+        tasks.append(Threading::ThreadPool::the().submit([zip_member, &all_members_ok] {
+            if (!unpack_file_member(zip_member))
+                all_members_ok.store(false, AK::memory_order_release);
+        }));
+        return IterationDecision::Continue;
     });
+    for (auto& task : tasks)
+        task->wait();
 
-    return success ? 0 : 1;
+    return all_members_ok.load(AK::memory_order_acquire) ? 0 : 1;
 }